@@ -0,0 +1,187 @@
+// =================================================================
+// include/Camus/AdaptiveConcurrencyLimiter.hpp
+// =================================================================
+// Per-backend concurrency limit discovered from observed latency.
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace Camus {
+
+/**
+ * @brief Adaptive limiter configuration
+ */
+struct AdaptiveLimiterConfig {
+    double initial_limit = 4.0;             ///< Starting concurrency
+    double min_limit = 1.0;                 ///< Never go below this
+    double max_limit = 64.0;                ///< Never go above this (the static ceiling)
+    double rtt_tolerance = 1.5;             ///< Latency growth tolerated before shrinking
+    double smoothing = 0.2;                 ///< Weight of each new limit estimate
+    double backoff_ratio = 0.9;             ///< Multiplicative decrease on errors and timeouts
+    size_t long_window = 100;               ///< Samples in the baseline latency average
+    size_t max_queue = 0;                   ///< Waiting requests before rejecting (0 = unlimited)
+};
+
+/**
+ * @brief Limiter counters
+ */
+struct AdaptiveLimiterStats {
+    size_t limit = 0;                       ///< Current concurrency limit
+    size_t in_flight = 0;                   ///< Requests holding a permit
+    size_t queued = 0;                      ///< Requests waiting for a permit
+    size_t successes = 0;                   ///< Samples that completed normally
+    size_t drops = 0;                       ///< Errors and timeouts
+    size_t rejections = 0;                  ///< Acquires that timed out or found the queue full
+    double short_rtt_ms = 0.0;              ///< Latency of the last sample
+    double long_rtt_ms = 0.0;               ///< Baseline latency average
+};
+
+/**
+ * @brief Gradient concurrency limiter with AIMD on failures
+ *
+ * Finds the throughput knee of one backend instead of relying on a fixed
+ * concurrency setting. Each completed request is a latency sample. While
+ * latency stays near its long-term baseline, the limit grows by about
+ * sqrt(limit) per sample. Once queueing inside the backend makes latency
+ * rise, the limit shrinks in proportion (gradient = tolerance * baseline /
+ * latency, clamped to [0.5, 1]). Errors and timeouts cut it
+ * multiplicatively. The limit does not grow while less than half of it is
+ * in use, since such samples say nothing about capacity.
+ *
+ * Requests over the limit wait in acquire() rather than reaching the
+ * backend, so it keeps running at its best throughput without latency
+ * blowing up.
+ */
+class AdaptiveConcurrencyLimiter {
+public:
+    /**
+     * @brief Right to run one request; records its outcome when finished
+     *
+     * Call success() or dropped(). A permit destroyed without either is
+     * released without recording a sample.
+     */
+    class Permit {
+    public:
+        Permit() = default;
+        Permit(Permit&& other) noexcept { *this = std::move(other); }
+        Permit& operator=(Permit&& other) noexcept;
+        Permit(const Permit&) = delete;
+        Permit& operator=(const Permit&) = delete;
+        ~Permit() { release(Outcome::IGNORED); }
+
+        explicit operator bool() const { return m_limiter != nullptr; }
+
+        void success() { release(Outcome::SUCCESS); }
+        void dropped() { release(Outcome::DROPPED); }
+
+    private:
+        friend class AdaptiveConcurrencyLimiter;
+        enum class Outcome { SUCCESS, DROPPED, IGNORED };
+
+        Permit(AdaptiveConcurrencyLimiter* limiter, size_t in_flight)
+            : m_limiter(limiter), m_in_flight(in_flight), m_start(std::chrono::steady_clock::now()) {}
+
+        void release(Outcome outcome);
+
+        AdaptiveConcurrencyLimiter* m_limiter = nullptr;
+        size_t m_in_flight = 0;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    explicit AdaptiveConcurrencyLimiter(const AdaptiveLimiterConfig& config = AdaptiveLimiterConfig());
+
+    AdaptiveConcurrencyLimiter(const AdaptiveConcurrencyLimiter&) = delete;
+    AdaptiveConcurrencyLimiter& operator=(const AdaptiveConcurrencyLimiter&) = delete;
+
+    /**
+     * @brief Limiter shared by every caller of one backend
+     * @param backend_key Backend endpoint (LlmInteraction::getBackendEndpoint())
+     */
+    static AdaptiveConcurrencyLimiter& forBackend(const std::string& backend_key);
+
+    /**
+     * @brief Replace a backend's configuration (resets its limit)
+     */
+    static void configureBackend(const std::string& backend_key, const AdaptiveLimiterConfig& config);
+
+    /**
+     * @brief Wait for a permit
+     * @param timeout Maximum time to queue
+     * @return A permit, or an empty one on timeout or when the queue is full
+     */
+    Permit acquire(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Run a call under a permit, recording its latency or failure
+     * @param call Function performing the request
+     * @param queue_timeout Maximum time to wait for a permit
+     * @param request_timeout Calls slower than this count as timeouts (0 = none)
+     * @throws std::runtime_error if no permit was granted; rethrows call's exceptions
+     */
+    template <typename Fn>
+    auto run(Fn&& call, std::chrono::milliseconds queue_timeout,
+             std::chrono::milliseconds request_timeout = std::chrono::milliseconds(0)) -> decltype(call()) {
+        Permit permit = acquire(queue_timeout);
+        if (!permit) {
+            throw std::runtime_error("Backend concurrency limit reached; request not admitted");
+        }
+        auto start = std::chrono::steady_clock::now();
+        try {
+            auto result = call();
+            bool timed_out = request_timeout.count() > 0 &&
+                             std::chrono::steady_clock::now() - start > request_timeout;
+            if (timed_out) {
+                permit.dropped();
+            } else {
+                permit.success();
+            }
+            return result;
+        } catch (...) {
+            permit.dropped();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Feed one observation into the limit
+     * @param latency Request latency
+     * @param in_flight Requests in flight when it started, itself included
+     * @param dropped Whether it failed or timed out
+     */
+    void recordSample(std::chrono::microseconds latency, size_t in_flight, bool dropped);
+
+    /**
+     * @brief Current concurrency limit
+     */
+    size_t getLimit() const;
+
+    AdaptiveLimiterStats getStats() const;
+
+private:
+    AdaptiveLimiterConfig m_config;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_available;
+
+    double m_limit;
+    size_t m_in_flight = 0;
+    size_t m_queued = 0;
+    double m_long_rtt_us = 0.0;
+    double m_short_rtt_us = 0.0;
+    size_t m_samples = 0;
+    size_t m_successes = 0;
+    size_t m_drops = 0;
+    size_t m_rejections = 0;
+
+    size_t effectiveLimit() const;  // caller holds m_mutex
+    void release(std::chrono::microseconds latency, size_t in_flight, Permit::Outcome outcome);
+    void updateLimit(std::chrono::microseconds latency, size_t in_flight, bool dropped);  // caller holds m_mutex
+};
+
+} // namespace Camus
@@ -33,6 +33,35 @@ struct AmodifyConfig {
     bool dry_run = false;
     size_t max_modification_size = 10 * 1024 * 1024; // 10MB total
     
+    // Generation settings
+    bool constrained_output = false; // Enforce the FILE block format while decoding
+    size_t max_output_tokens = 8000; // Tokens one answer may generate; kept out of the prompt's max_tokens
+    std::string edit_format = "auto"; // whole_file, search_replace, or auto (the model's edit_format attribute)
+    
+    // Execution settings
+    std::string execution_mode = "single"; // single (one prompt for the project) or fanout (one prompt per file cluster)
+    size_t fanout_files_per_task = 4;       // Files edited by one fan-out task
+    size_t fanout_task_tokens = 32000;      // Context limit of one fan-out prompt
+    size_t fanout_concurrency = 4;          // Fan-out tasks in flight at once
+    std::string fanout_models;              // Comma-separated models.yml names; empty = every configured model
+    size_t fanout_timeout_seconds = 600;    // Per-task generation timeout
+    
+    // Retrieval settings
+    bool retrieval = false;                 // Rank files by embedding similarity to the request
+    std::string embedding_model_path;       // GGUF embedding model (e.g. bge-small, nomic-embed)
+    std::string retrieval_index_dir = ".camus/embeddings";
+    size_t retrieval_top_k = 40;            // Chunks retrieved per request
+    size_t retrieval_max_files = 0;         // Keep only the best-ranked files (0 = rank all, drop none)
+    
+    // Deduplication settings
+    bool deduplicate_files = true;          // Send byte-identical files once, listing their other paths
+    double near_duplicate_threshold = 0.0;  // Send files this similar (0-1) as a diff against their twin (0 = off)
+    bool minify_context = false;            // Strip license headers, boilerplate comments and whitespace from prompts
+    
+    // Session settings
+    bool context_session = false;           // Follow-up requests continue the conversation and send only changed files
+    size_t session_ttl_minutes = 60;        // Sessions idle for longer start over
+    
     /**
      * @brief Load configuration from ConfigParser
      * @param config ConfigParser instance
@@ -0,0 +1,78 @@
+// =================================================================
+// include/Camus/AmodifyFanout.hpp
+// =================================================================
+// Splits an amodify request into per-file-cluster edit tasks and merges
+// their results.
+
+#pragma once
+
+#include "Camus/ResponseParser.hpp"
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace Camus {
+
+/**
+ * @brief One unit of fan-out work: a cluster of files edited by one generation
+ */
+struct EditTask {
+    std::string task_id;                ///< "task-1", "task-2", ... in plan order
+    std::vector<std::string> files;     ///< Files this task owns and may rewrite
+    size_t estimated_tokens = 0;        ///< Token estimate of their content
+};
+
+/**
+ * @brief Plans and merges per-file-cluster amodify tasks
+ *
+ * A project-wide request normally goes to one model as a single prompt, so
+ * one long generation runs while every other model instance idles. Fan-out
+ * gives each task a shared summary of the project plus only its own files,
+ * runs the tasks concurrently and merges what they return. Files that
+ * belong together (a header and its source, which share a stem) are kept in
+ * the same task so their edits stay consistent.
+ */
+class AmodifyFanout {
+public:
+    /**
+     * @brief Group files into tasks
+     *
+     * Files with the same stem form a cluster. Clusters are packed in the
+     * order given (most relevant first) into tasks of at most
+     * max_files_per_task files and max_task_tokens tokens; a cluster that
+     * exceeds either limit on its own gets a task to itself.
+     * @param files Relative path and token estimate of each file, in priority order
+     * @param max_files_per_task File limit per task (0 = no limit)
+     * @param max_task_tokens Token limit per task (0 = no limit)
+     * @return Tasks in plan order; empty if files is empty
+     */
+    static std::vector<EditTask> planTasks(const std::vector<std::pair<std::string, size_t>>& files,
+                                           size_t max_files_per_task, size_t max_task_tokens);
+
+    /**
+     * @brief Merge the modifications returned by each task
+     *
+     * A task may rewrite the files it owns and create files that do not
+     * exist yet. Changes to a file owned by another task, and rewrites of
+     * existing files nobody owns (seen only in the outline, or left out of
+     * every task), are dropped; a new file created by more than one task
+     * keeps the first version. Each drop is reported.
+     * @param tasks Tasks from planTasks()
+     * @param task_modifications Parsed modifications, one entry per task (same order)
+     * @param conflicts Receives one message per dropped modification
+     * @param root_path Project root the paths are relative to
+     * @return The merged set, in task order
+     */
+    static std::vector<FileModification> mergeResults(
+        const std::vector<EditTask>& tasks,
+        const std::vector<std::vector<FileModification>>& task_modifications,
+        std::vector<std::string>& conflicts,
+        const std::string& root_path = ".");
+
+    /**
+     * @brief Cluster key of a path: its file name without extension
+     */
+    static std::string clusterKey(const std::string& path);
+};
+
+} // namespace Camus
@@ -0,0 +1,195 @@
+// =================================================================
+// include/Camus/ApiRequestQueue.hpp
+// =================================================================
+// Bounded work queue with per-client admission limits for requests
+// served over the HTTP API.
+
+#pragma once
+
+#include "Camus/ModelOrchestrator.hpp"
+#include <string>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+namespace Camus {
+
+/**
+ * @brief Request queue configuration
+ */
+struct ApiQueueConfig {
+    size_t worker_threads = 2;              ///< Requests executed concurrently
+    size_t max_queue_size = 64;             ///< Requests waiting for a worker; more are rejected
+    size_t max_requests_per_client = 4;     ///< Queued plus running requests per client (0 = unlimited)
+};
+
+/**
+ * @brief Outcome of submitting a request
+ */
+enum class AdmissionResult {
+    ACCEPTED,           ///< Queued for execution
+    QUEUE_FULL,         ///< Global queue limit reached
+    CLIENT_LIMIT,       ///< Client already has its maximum number of requests
+    SHUTTING_DOWN       ///< Queue no longer accepts work
+};
+
+/**
+ * @brief Result of waiting for output from a job
+ */
+enum class ChunkStatus {
+    DATA,               ///< New text was returned
+    TIMEOUT,            ///< Nothing new before the timeout
+    FINISHED            ///< Job finished and all output has been taken
+};
+
+/**
+ * @brief Queue statistics
+ */
+struct ApiQueueStats {
+    size_t queued = 0;                      ///< Requests waiting for a worker
+    size_t running = 0;                     ///< Requests being executed
+    size_t completed = 0;                   ///< Requests executed
+    size_t cancelled = 0;                   ///< Requests dropped before execution
+    size_t rejected_queue_full = 0;         ///< Rejections due to the queue limit
+    size_t rejected_client_limit = 0;       ///< Rejections due to the per-client limit
+    std::chrono::milliseconds total_queue_wait{0}; ///< Time executed requests spent queued
+};
+
+/**
+ * @brief A submitted request and the channel its output streams through
+ *
+ * The worker publishes generated text as it arrives; the HTTP handler
+ * drains it with nextChunk() for streaming responses or waits for the
+ * whole response. A response that was never streamed (a cache hit, or a
+ * backend without incremental output) is delivered as a single chunk.
+ */
+class ApiJob {
+public:
+    ApiJob(PipelineRequest request, std::string client_id);
+
+    const PipelineRequest& getRequest() const { return m_request; }
+    const std::string& getClientId() const { return m_client_id; }
+
+    /**
+     * @brief Wait for new output
+     * @param text Receives the text produced since the previous call
+     * @param timeout Maximum time to wait
+     */
+    ChunkStatus nextChunk(std::string& text, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Wait for the job to finish
+     * @return False if the timeout expired first
+     */
+    bool waitUntilDone(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Get the final response (valid once finished)
+     */
+    PipelineResponse getResponse() const;
+
+    /**
+     * @brief Mark the job as abandoned by its client
+     *
+     * A job that has not started is skipped; one already running
+     * completes, but its output is discarded.
+     */
+    void cancel();
+    bool isCancelled() const { return m_cancelled; }
+
+    /**
+     * @brief Time spent waiting for a worker
+     */
+    std::chrono::milliseconds getQueueWait() const { return m_queue_wait; }
+
+private:
+    friend class ApiRequestQueue;
+
+    PipelineRequest m_request;
+    std::string m_client_id;
+    std::chrono::steady_clock::time_point m_enqueued_at;
+    std::chrono::milliseconds m_queue_wait{0};
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::string m_pending;
+    bool m_streamed = false;
+    bool m_done = false;
+    std::atomic<bool> m_cancelled{false};
+    PipelineResponse m_response;
+
+    void publish(const std::string& text);
+    void complete(PipelineResponse response);
+};
+
+/**
+ * @brief Fixed pool of workers draining a bounded FIFO of ApiJobs
+ *
+ * Admission is decided up front: when the queue is full or a client
+ * already has max_requests_per_client requests in flight, submit()
+ * rejects immediately so the caller can answer 429 instead of letting
+ * requests pile up behind a slow model.
+ */
+class ApiRequestQueue {
+public:
+    using Executor = std::function<PipelineResponse(const PipelineRequest&)>;
+
+    /**
+     * @brief Start the worker threads
+     * @param executor Runs a request (normally ModelOrchestrator::processRequest)
+     * @param config Queue configuration
+     */
+    explicit ApiRequestQueue(Executor executor, const ApiQueueConfig& config = ApiQueueConfig());
+
+    /**
+     * @brief Stops accepting work and joins the workers after the queue drains
+     */
+    ~ApiRequestQueue();
+
+    ApiRequestQueue(const ApiRequestQueue&) = delete;
+    ApiRequestQueue& operator=(const ApiRequestQueue&) = delete;
+
+    /**
+     * @brief Submit a job for execution
+     */
+    AdmissionResult submit(const std::shared_ptr<ApiJob>& job);
+
+    /**
+     * @brief Stop accepting work; queued jobs still run
+     */
+    void shutdown();
+
+    /**
+     * @brief Get queue statistics
+     */
+    ApiQueueStats getStats() const;
+
+    /**
+     * @brief Number of queued plus running requests for a client
+     */
+    size_t getClientLoad(const std::string& client_id) const;
+
+private:
+    Executor m_executor;
+    ApiQueueConfig m_config;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::shared_ptr<ApiJob>> m_queue;
+    std::unordered_map<std::string, size_t> m_client_load;
+    bool m_shutting_down = false;
+    ApiQueueStats m_stats;
+    std::vector<std::thread> m_workers;
+
+    void workerLoop();
+    void releaseClient(const std::string& client_id);
+};
+
+} // namespace Camus
@@ -0,0 +1,132 @@
+// =================================================================
+// include/Camus/CamusDaemon.hpp
+// =================================================================
+// Long-running `camus serve` process that keeps the model resident and
+// answers CLI invocations over a Unix domain socket.
+
+#pragma once
+
+#include "Camus/DaemonProtocol.hpp"
+#include "Camus/LlmInteraction.hpp"
+#include <string>
+#include <memory>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace Camus {
+
+class ModelRegistry;
+
+/**
+ * @brief Daemon configuration
+ */
+struct DaemonConfig {
+    std::string socket_path = DEFAULT_DAEMON_SOCKET;    ///< Listening socket
+    std::string models_config_path = ".camus/models.yml"; ///< Registry configuration for `model` requests
+    size_t max_clients = 16;                            ///< Concurrent connections accepted
+    std::chrono::milliseconds poll_interval{250};       ///< How often the accept loop checks for stop requests
+};
+
+/**
+ * @brief Daemon activity counters
+ */
+struct DaemonStats {
+    size_t connections = 0;                 ///< Connections accepted
+    size_t requests = 0;                    ///< Messages handled
+    size_t completions = 0;                 ///< Completions served
+    size_t tokens_generated = 0;            ///< Tokens generated across completions
+    size_t errors = 0;                      ///< Requests that failed
+    std::chrono::seconds uptime{0};         ///< Time since the daemon started listening
+};
+
+/**
+ * @brief Serves a resident LLM backend to camus CLI processes
+ *
+ * Loading a GGUF model takes seconds and, with a cold page cache, reads
+ * gigabytes from disk. The daemon pays that cost once: CLI invocations
+ * connect to its socket and send completion requests, and generated
+ * text is streamed back as it is produced. A model registry for `model`
+ * subcommands is created on first use and kept for the daemon's lifetime.
+ *
+ * Each connection is served by its own thread. Completions are
+ * serialized on the backend, which is not safe for concurrent use.
+ */
+class CamusDaemon {
+public:
+    /**
+     * @brief Construct a daemon around an already-loaded backend
+     * @param backend Backend kept resident; must outlive the daemon
+     * @param config Daemon configuration
+     */
+    explicit CamusDaemon(LlmInteraction& backend, const DaemonConfig& config = DaemonConfig());
+
+    ~CamusDaemon();
+
+    CamusDaemon(const CamusDaemon&) = delete;
+    CamusDaemon& operator=(const CamusDaemon&) = delete;
+
+    /**
+     * @brief Bind and listen on the socket
+     *
+     * A stale socket left by a crashed daemon is replaced; a live one is not.
+     * @throws std::runtime_error if another daemon is listening or binding fails
+     */
+    void start();
+
+    /**
+     * @brief Serve clients until stop() is called, a client requests
+     * shutdown, or SIGINT/SIGTERM is received
+     * @return Process exit code
+     */
+    int run();
+
+    /**
+     * @brief Ask the accept loop to finish; safe to call from any thread
+     */
+    void stop();
+
+    /**
+     * @brief Get activity counters
+     */
+    DaemonStats getStats() const;
+
+private:
+    struct ClientSession {
+        std::shared_ptr<MessageChannel> channel;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+    };
+
+    LlmInteraction& m_backend;
+    DaemonConfig m_config;
+    int m_listen_fd = -1;
+    std::atomic<bool> m_stop{false};
+    std::chrono::steady_clock::time_point m_started;
+
+    ModelMetadata m_metadata;
+    std::string m_model_id;
+    std::mutex m_backend_mutex;
+    std::unique_ptr<ModelRegistry> m_registry;
+    std::mutex m_registry_mutex;
+
+    std::list<std::unique_ptr<ClientSession>> m_sessions;
+    std::mutex m_sessions_mutex;
+
+    std::atomic<size_t> m_connections{0};
+    std::atomic<size_t> m_requests{0};
+    std::atomic<size_t> m_completions{0};
+    std::atomic<size_t> m_tokens_generated{0};
+    std::atomic<size_t> m_errors{0};
+
+    void serveClient(ClientSession& session);
+    std::string handleMessage(const std::string& message, MessageChannel& channel);
+    std::string handleCompletion(InferenceRequest request, bool stream, MessageChannel& channel);
+    std::string handleModelCommand(const std::string& subcommand, const std::string& model_name);
+    void reapSessions(bool wait_for_all);
+    void closeListener();
+};
+
+} // namespace Camus
@@ -26,13 +26,27 @@ struct Commands {
     size_t max_tokens = 128000;
     std::string include_pattern;
     std::string exclude_pattern;
+    std::string batch_file;        // One request per line, run against a shared context
+    bool amodify_fanout = false;   // Split the request into concurrent per-file-cluster tasks
+    std::string embedding_model_path; // Rank files by embedding similarity using this GGUF model
 
     // Options for 'build' and 'test'
     std::vector<std::string> passthrough_args;
     
     // Options for 'model' command
-    std::string model_subcommand;  // list, test, info, reload
-    std::string model_name;        // For test and info subcommands
+    std::string model_subcommand;  // list, test, info, reload, unload
+    std::string model_name;        // For test, info and unload subcommands
+
+    // Options for 'serve' command
+    bool serve_stop = false;       // Stop a running daemon
+    bool serve_status = false;     // Report on a running daemon
+
+    // Options for 'serve-api' command
+    std::string api_host = "127.0.0.1";
+    int api_port = 8080;
+    size_t api_workers = 2;        // Requests executed concurrently
+    size_t api_queue = 64;         // Requests allowed to wait for a worker
+    size_t api_per_client = 4;     // Concurrent requests per client (0 = unlimited)
 };
 
 class CliParser {
@@ -61,6 +75,8 @@ private:
     void setupCommitCommand(CLI::App& app);
     void setupPushCommand(CLI::App& app);
     void setupModelCommand(CLI::App& app);
+    void setupServeCommand(CLI::App& app);
+    void setupServeApiCommand(CLI::App& app);
 
     std::shared_ptr<CLI::App> m_app;
     Commands m_commands;
@@ -0,0 +1,109 @@
+// =================================================================
+// include/Camus/CompiledTemplate.hpp
+// =================================================================
+// Prompt templates parsed once into literal spans and variable slots.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+namespace Camus {
+
+/**
+ * @brief Placeholder notation recognised when compiling a template
+ */
+enum class PlaceholderSyntax {
+    TRIPLE_BRACE,       ///< {{{name}}} (pipeline step templates)
+    SINGLE_BRACE        ///< {name} (model prompt formats)
+};
+
+/**
+ * @brief A template compiled into a segment list
+ *
+ * Parsing happens once; rendering walks the segments, sizes the output
+ * exactly and fills it with a single allocation. Substituted values are
+ * inserted verbatim and never re-scanned for placeholders. Token
+ * estimates of the literal segments are computed at compile time, so a
+ * prompt's budget can be checked from the variable lengths alone.
+ *
+ * Placeholder names are word characters ([A-Za-z0-9_]); braces around
+ * anything else are kept as literal text. Unknown {{{name}}} variables
+ * render empty; unknown {name} placeholders are kept as written, since
+ * prompt formats may contain braces meant for the model.
+ */
+class CompiledTemplate {
+public:
+    /**
+     * @brief Looks up a variable; returns nullptr when it is not defined
+     */
+    using Resolver = std::function<const std::string*(const std::string& name)>;
+
+    struct Segment {
+        bool is_variable = false;           ///< Variable slot rather than literal text
+        std::string text;                   ///< Literal text, or the variable name
+        std::string fallback;               ///< Rendered for a variable that is not defined
+        size_t token_estimate = 0;          ///< Estimated tokens of a literal segment
+    };
+
+    CompiledTemplate() = default;
+
+    /**
+     * @brief Compile a template
+     * @param source Template text
+     * @param syntax Placeholder notation
+     */
+    explicit CompiledTemplate(const std::string& source,
+                              PlaceholderSyntax syntax = PlaceholderSyntax::TRIPLE_BRACE);
+
+    /**
+     * @brief Render with variables supplied by a resolver
+     */
+    std::string render(const Resolver& resolve) const;
+
+    /**
+     * @brief Render with variables from a map
+     */
+    std::string render(const std::unordered_map<std::string, std::string>& variables) const;
+
+    /**
+     * @brief Append the rendering to an existing buffer
+     *
+     * Callers assembling several templates can reserve renderedLength()
+     * of each up front and append them without reallocating.
+     */
+    void appendTo(std::string& out, const Resolver& resolve) const;
+
+    /**
+     * @brief Exact length of the rendering
+     */
+    size_t renderedLength(const Resolver& resolve) const;
+
+    /**
+     * @brief Estimated tokens of the rendering, without rendering it
+     */
+    size_t estimateTokens(const Resolver& resolve) const;
+
+    /**
+     * @brief Token estimate used for literal segments and variable values
+     */
+    static size_t estimateTokenCount(size_t length) { return (length + 3) / 4; }
+
+    const std::vector<Segment>& getSegments() const { return m_segments; }
+    size_t getStaticLength() const { return m_static_length; }
+    size_t getStaticTokens() const { return m_static_tokens; }
+    bool hasVariables() const { return m_variable_count > 0; }
+    bool empty() const { return m_segments.empty(); }
+
+private:
+    std::vector<Segment> m_segments;
+    size_t m_static_length = 0;
+    size_t m_static_tokens = 0;
+    size_t m_variable_count = 0;
+
+    void addLiteral(const std::string& source, size_t begin, size_t end);
+};
+
+} // namespace Camus
@@ -20,11 +20,17 @@ public:
 
     /**
      * @brief Retrieves a string value for a given key.
-     * @param key The configuration key (e.g., "model_path").
+     * @param key The configuration key (e.g., "model_path"); keys inside a
+     *            section are prefixed with it (e.g., "amodify.max_files").
      * @return The corresponding value, or an empty string if not found.
      */
     std::string getStringValue(const std::string& key) const;
 
+    /**
+     * @brief The config.yml written by `camus init`.
+     */
+    static const std::string& defaultConfig();
+
 private:
     std::map<std::string, std::string> m_config_values;
 };
@@ -5,9 +5,14 @@
 
 #pragma once
 
+#include "Camus/EditApplier.hpp"
+#include "Camus/AmodifyFanout.hpp"
+#include "Camus/SourceMinifier.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <utility>
+#include <cstdint>
 #include <filesystem>
 
 namespace Camus {
@@ -21,11 +26,79 @@ struct FileInfo {
     size_t file_size;
     std::filesystem::file_time_type last_modified;
     int priority_score;
+    std::vector<std::string> aliases;   ///< Other paths with byte-identical content, folded into this entry
+    std::vector<std::pair<std::string, std::string>> variants; ///< Near-duplicate paths and their diff against this file
+    std::vector<FileInfo> variant_files; ///< The near duplicates as loaded, packed whole if this file is truncated
     
     FileInfo(const std::string& path, const std::string& file_content) 
         : relative_path(path), content(file_content), file_size(file_content.size()), priority_score(0) {}
 };
 
+/**
+ * @brief Context for a batch of requests sharing one project prefix
+ *
+ * Every prompt is shared_prefix + suffixes[i]. The prefix holds the system
+ * prompt and the project files and is byte-identical across requests, so a
+ * backend with prefix caching prefills it once and only decodes the short
+ * per-request suffix afterwards.
+ */
+struct BatchContext {
+    std::string shared_prefix;              ///< System prompt and project files
+    std::vector<std::string> suffixes;      ///< Per-request tail, one per request
+    std::vector<std::string> file_order;    ///< Files in the prefix, most widely relevant first
+
+    /**
+     * @brief Assemble the complete prompt for one request
+     */
+    std::string prompt(size_t index) const { return shared_prefix + suffixes.at(index); }
+};
+
+/**
+ * @brief Context for one request fanned out over per-file-cluster tasks
+ *
+ * Every prompt is shared_prefix + suffixes[i]. The prefix holds the system
+ * prompt, the request and an outline of the whole project, so each task
+ * sees the names it has to stay consistent with; the suffix holds only the
+ * files task i owns.
+ */
+struct FanoutContext {
+    std::string shared_prefix;              ///< System prompt, request and project outline
+    std::vector<EditTask> tasks;            ///< Planned tasks, most relevant first
+    std::vector<std::string> suffixes;      ///< Per-task files and instructions, one per task
+
+    /**
+     * @brief Assemble the complete prompt for one task
+     */
+    std::string prompt(size_t index) const { return shared_prefix + suffixes.at(index); }
+};
+
+/**
+ * @brief What a model has been shown of the project, by content hash
+ *
+ * Hashes are of the content as it appeared in the prompt (after
+ * minification), so a file counts as changed exactly when the model's
+ * copy of it is out of date.
+ */
+struct ContextSnapshot {
+    std::unordered_map<std::string, uint64_t> sent;     ///< Files in the prompt
+    std::unordered_map<std::string, uint64_t> withheld; ///< Files loaded but left out for space
+};
+
+/**
+ * @brief A follow-up turn of a session: only what changed since a snapshot
+ *
+ * The turn is appended to the conversation so far (the previous prompts
+ * and answers, verbatim), so a backend that reuses the KV cache of a
+ * matching prefix, or continues from Ollama's context tokens, only
+ * processes the turn itself.
+ */
+struct DeltaContext {
+    std::string turn;                       ///< User turn with the changed files, the request and the assistant header
+    std::vector<std::string> changed;       ///< Files sent because they are new or differ from the model's copy
+    std::vector<std::string> removed;       ///< Files the model saw that no longer exist
+    bool fits = true;                       ///< False if the history leaves no room for the changes
+};
+
 /**
  * @brief Builds context prompts for LLM with intelligent content management
  * 
@@ -51,6 +124,67 @@ public:
                            const std::string& user_request,
                            const std::string& root_path = ".");
 
+    /**
+     * @brief Build a follow-up turn that carries only what changed
+     *
+     * Files whose content matches the snapshot are not sent again; new and
+     * changed files are packed, most important first, into the budget the
+     * history leaves. getLastSnapshot() then describes the model's view
+     * after this turn.
+     * @param file_paths Vector of relative file paths in the project
+     * @param user_request The user's modification request
+     * @param previous Snapshot after the previous turn
+     * @param history_tokens Tokens of the conversation so far
+     * @param root_path Root directory path for reading files
+     * @return The turn; fits is false if changed files had no room at all
+     */
+    DeltaContext buildDeltaContext(const std::vector<std::string>& file_paths,
+                                   const std::string& user_request,
+                                   const ContextSnapshot& previous,
+                                   size_t history_tokens,
+                                   const std::string& root_path = ".");
+
+    /**
+     * @brief Build one shared context prefix for several requests
+     *
+     * Files are loaded and formatted once. They are ordered by how many of
+     * the requests they are relevant to (keyword matches), then by the usual
+     * priority, so the files common to the batch come first and survive
+     * truncation. The token budget leaves room for the longest request.
+     * @param file_paths Vector of relative file paths to include
+     * @param user_requests The modification requests of the batch
+     * @param root_path Root directory path for reading files
+     * @return Shared prefix and per-request suffixes
+     */
+    BatchContext buildBatchContext(const std::vector<std::string>& file_paths,
+                                   const std::vector<std::string>& user_requests,
+                                   const std::string& root_path = ".");
+
+    /**
+     * @brief Split one request into per-file-cluster task prompts
+     *
+     * Only files relevant to the request (keyword matches or retrieval
+     * hits) get a task when any are; every file still appears in the
+     * outline. Duplicates are folded into the task that owns their kept
+     * copy. Each task prompt, prefix included, stays within max_tokens.
+     * @param file_paths Vector of relative file paths to consider
+     * @param user_request The user's modification request
+     * @param max_files_per_task File limit per task (0 = no limit)
+     * @param root_path Root directory path for reading files
+     * @return Shared prefix, tasks and per-task suffixes
+     */
+    FanoutContext buildFanoutContext(const std::vector<std::string>& file_paths,
+                                     const std::string& user_request,
+                                     size_t max_files_per_task,
+                                     const std::string& root_path = ".");
+
+    /**
+     * @brief Extract relevance keywords from a request (words longer than 3 chars)
+     * @param user_request The user's modification request
+     * @return Keywords for setRelevanceKeywords()
+     */
+    static std::vector<std::string> extractKeywords(const std::string& user_request);
+
     /**
      * @brief Set maximum token limit
      * @param max_tokens New token limit
@@ -82,12 +216,84 @@ public:
      */
     void setRelevanceKeywords(const std::vector<std::string>& keywords);
 
+    /**
+     * @brief Set semantic retrieval scores that boost file relevance
+     *
+     * Files retrieved for the request rank above files with no keyword or
+     * retrieval evidence, and count as relevant when fan-out decides which
+     * files get a task.
+     * @param scores Best chunk similarity (0..1) per relative path, from EmbeddingIndex::fileScores()
+     */
+    void setRetrievalScores(const std::unordered_map<std::string, double>& scores);
+
+    /**
+     * @brief Collapse files with identical content into one entry (default: on)
+     *
+     * Vendored copies, generated stubs and per-platform duplicates are
+     * emitted once with the list of their other paths, which loses nothing.
+     * @param enabled Whether buildContext, buildBatchContext and buildFanoutContext deduplicate
+     */
+    void setDeduplication(bool enabled);
+
+    /**
+     * @brief Also fold near-duplicate files into the file they resemble
+     *
+     * A file whose line shingles overlap another's by at least threshold
+     * (MinHash estimate of Jaccard similarity) is emitted as an exact diff
+     * against it, when that diff is less than half the file's size.
+     * @param threshold Similarity from 0 to 1; 0 disables (default)
+     */
+    void setNearDuplicateThreshold(double threshold);
+
+    /**
+     * @brief Send files through SourceMinifier before packing (default: off)
+     *
+     * Responses then refer to the minified text; pass getMinifiedFiles() to
+     * ResponseParser::setMinifiedSources() so edits land in the real files.
+     * @param enabled Whether every build minifies the files it loads
+     */
+    void setMinification(bool enabled);
+
+    /**
+     * @brief Files the last build sent minified, with line maps and token counts
+     *
+     * Only files that minification made smaller are listed.
+     */
+    const std::unordered_map<std::string, MinifiedSource>& getMinifiedFiles() const;
+
+    /**
+     * @brief Choose the response format the system prompt asks for
+     * @param format Whole files (default) or search/replace edits
+     */
+    void setEditFormat(EditFormat format);
+
     /**
      * @brief Get statistics from last context build
      * @return Map of statistics (files_included, tokens_used, files_truncated, etc.)
      */
     std::unordered_map<std::string, size_t> getLastBuildStats() const;
 
+    /**
+     * @brief Files the model has seen after the last buildContext or buildDeltaContext
+     */
+    const ContextSnapshot& getLastSnapshot() const;
+
+    /**
+     * @brief Account for the model's own edits in a snapshot
+     *
+     * The model knows what it wrote, so an edit that is now on disk counts
+     * as sent and is not resent next turn. An edit that was declined or
+     * failed is dropped from the snapshot, so the file is resent and the
+     * model sees it was not applied.
+     * @param snapshot Snapshot of the turn that produced the edits
+     * @param edits Path and full new content of each file the model changed
+     * @param root_path Root directory path for reading files
+     * @return The snapshot after the edits
+     */
+    ContextSnapshot snapshotAfterEdits(ContextSnapshot snapshot,
+                                       const std::vector<std::pair<std::string, std::string>>& edits,
+                                       const std::string& root_path = ".") const;
+
 private:
     size_t m_max_tokens;
     size_t m_reserved_tokens;
@@ -95,6 +301,13 @@ private:
     std::unordered_map<std::string, size_t> m_last_stats;
     bool m_git_prioritization_enabled;
     std::vector<std::string> m_relevance_keywords;
+    std::unordered_map<std::string, double> m_retrieval_scores;
+    EditFormat m_edit_format = EditFormat::WHOLE_FILE;
+    bool m_deduplicate = true;
+    double m_near_duplicate_threshold = 0.0;
+    bool m_minify = false;
+    std::unordered_map<std::string, MinifiedSource> m_minified;
+    ContextSnapshot m_last_snapshot;
 
     /**
      * @brief Estimate token count for text (rough approximation: 4 chars ≈ 1 token)
@@ -119,6 +332,31 @@ private:
      */
     int calculateFilePriority(const FileInfo& file_info) const;
 
+    /**
+     * @brief Fold duplicate and near-duplicate files into the first copy
+     *
+     * Files are visited in order, so the first (highest-priority) copy is
+     * the one kept; it inherits the aliases and variants. Adds
+     * duplicates_collapsed, near_duplicates and dedup_tokens_saved to the
+     * build statistics.
+     * @param files Files in inclusion order; duplicates are removed
+     */
+    void deduplicateFiles(std::vector<FileInfo>& files);
+
+    /**
+     * @brief Replace file contents with their minified form where it is smaller
+     *
+     * Records each file in m_minified and adds files_minified and
+     * minify_tokens_saved to the build statistics.
+     * @param files Loaded files; priorities are left as computed on the originals
+     */
+    void minifyFiles(std::vector<FileInfo>& files);
+
+    /**
+     * @brief Snapshot hash of a file: of the text it is sent as, minified when minifyFiles() would
+     */
+    uint64_t snapshotHash(const std::string& file_path, const std::string& content) const;
+
     /**
      * @brief Prioritize files based on various factors
      * @param files Vector of file information
@@ -126,8 +364,41 @@ private:
      */
     std::vector<FileInfo> prioritizeFiles(std::vector<FileInfo> files) const;
 
+    /**
+     * @brief Choose which files, whole or truncated, fill the token budget
+     *
+     * Solves a multiple-choice knapsack over the files: each may be left
+     * out, included whole or truncated to a quarter, half or three quarters,
+     * valued by priority (truncated content at a discount) and costed
+     * exactly. Leftover budget then goes to extending the most important
+     * truncated file. A truncated file cannot carry its near duplicates as
+     * diffs, so they are packed as whole files when the budget allows and
+     * counted as skipped otherwise. Adds files_skipped, budget_tokens,
+     * packed_tokens and budget_utilization_pct to the build statistics.
+     * @param files Files in inclusion order
+     * @param available_tokens Token budget for file content
+     * @param included Receives the paths of the files that were included
+     * @return Formatted file contents, in the order given
+     */
+    std::string packFiles(const std::vector<FileInfo>& files, size_t available_tokens,
+                          std::vector<std::string>* included = nullptr);
+
+    /**
+     * @brief Format a truncated file block costing at most max_tokens
+     * @return The block, or an empty string if not even the header fits
+     */
+    std::string formatTruncatedFile(const FileInfo& file_info, size_t max_tokens) const;
+
+    /**
+     * @brief Tokens left for file content once fixed prompt parts are reserved
+     */
+    size_t availableFileTokens(size_t fixed_tokens) const;
+
     /**
      * @brief Format file content for inclusion in prompt
+     *
+     * Aliases are listed under the header; variants follow as diffs unless
+     * the content is truncated, since their line numbers would not resolve.
      * @param file_info File information
      * @param truncated Whether content was truncated
      * @return Formatted file content with markers
@@ -148,6 +419,12 @@ private:
      */
     std::string buildSystemPrompt() const;
 
+    /**
+     * @brief System prompt asking for search/replace edits instead of whole files
+     * @return System prompt string
+     */
+    std::string buildEditSystemPrompt() const;
+
     /**
      * @brief Build user prompt with request and context
      * @param user_request User's modification request
@@ -157,6 +434,39 @@ private:
     std::string buildUserPrompt(const std::string& user_request, 
                                const std::string& formatted_files) const;
 
+    /**
+     * @brief Build the per-request tail of a batch prompt
+     * @param user_request User's modification request
+     * @return Request and assistant header, appended after the shared prefix
+     */
+    std::string buildBatchSuffix(const std::string& user_request) const;
+
+    /**
+     * @brief Build the user turn of a session follow-up
+     * @param user_request User's modification request
+     * @param changed_files Formatted contents of the changed files
+     * @param removed Paths of files that no longer exist
+     * @return Turn text, from the user header to the assistant header
+     */
+    std::string buildDeltaTurn(const std::string& user_request, const std::string& changed_files,
+                               const std::vector<std::string>& removed) const;
+
+    /**
+     * @brief Outline of the project: every path with its top-level declarations
+     * @param files Files in priority order
+     * @param max_tokens Budget for the outline; later files are listed without declarations
+     * @return Outline text
+     */
+    std::string buildProjectOutline(const std::vector<FileInfo>& files, size_t max_tokens) const;
+
+    /**
+     * @brief Build the per-task tail of a fan-out prompt
+     * @param task_files Formatted contents of the files the task owns
+     * @param owned Paths of those files
+     * @return Files, ownership instructions and assistant header
+     */
+    std::string buildFanoutSuffix(const std::string& task_files, const std::vector<std::string>& owned) const;
+
     /**
      * @brief Initialize default file type priorities
      */
@@ -189,6 +499,15 @@ private:
      * @return Relevance score
      */
     int calculateRelevanceScore(const std::string& content) const;
+
+    /**
+     * @brief Check whether lowercased content mentions any of the keywords
+     * @param lower_content File content in lowercase
+     * @param keywords Keywords to look for
+     * @return true if at least one keyword occurs
+     */
+    static bool mentionsAnyKeyword(const std::string& lower_content,
+                                   const std::vector<std::string>& keywords);
 };
 
 } // namespace Camus
\ No newline at end of file
@@ -0,0 +1,90 @@
+// =================================================================
+// include/Camus/ContextSession.hpp
+// =================================================================
+// Conversation state of amodify requests to one model, kept under .camus/
+// so a follow-up request only sends what changed.
+
+#pragma once
+
+#include "Camus/ContextBuilder.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Camus {
+
+/**
+ * @brief The conversation a model instance has had about the project
+ *
+ * Holds every prompt and answer so far, verbatim, plus the snapshot of
+ * the files the model has seen. A follow-up prompt is the history plus a
+ * DeltaContext turn, which backends with prefix reuse (llama.cpp behind
+ * the daemon) only prefill from the turn on. When the backend returns its
+ * own conversation state (Ollama's context tokens) only the turn is sent.
+ *
+ * Sessions are keyed by model, stored as JSON and expire after a period
+ * of inactivity.
+ */
+class ContextSession {
+public:
+    /**
+     * @param session_dir Directory holding session files
+     * @param model_key Identity of the model instance (provider, path, name)
+     */
+    ContextSession(const std::string& session_dir, const std::string& model_key);
+
+    /**
+     * @brief Load the model's session if it exists and is recent
+     * @param max_age Sessions idle for longer are discarded
+     * @return True if a session was loaded
+     */
+    bool load(std::chrono::minutes max_age);
+
+    /**
+     * @brief Write the session atomically
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save() const;
+
+    /**
+     * @brief Forget the session, on disk too
+     */
+    void reset();
+
+    /**
+     * @brief Append a turn: the text sent in addition to the history, and the answer
+     * @param turn Full prompt of a first request, or a DeltaContext turn
+     * @param answer The model's answer
+     * @param snapshot Files the model has seen after the turn
+     * @param backend_context Conversation state the backend returned (empty if none)
+     */
+    void recordTurn(const std::string& turn, const std::string& answer, const ContextSnapshot& snapshot,
+                    std::vector<int64_t> backend_context);
+
+    bool active() const { return m_turns > 0; }
+    size_t turns() const { return m_turns; }
+    const std::string& history() const { return m_history; }
+    size_t historyTokens() const { return (m_history.size() + 3) / 4; }
+    const ContextSnapshot& snapshot() const { return m_snapshot; }
+
+    /**
+     * @brief Backend conversation state to continue from; empty if the backend keeps none
+     */
+    const std::vector<int64_t>& backendContext() const { return m_backend_context; }
+
+private:
+    std::string m_session_dir;
+    std::string m_model_key;
+    std::string m_history;
+    ContextSnapshot m_snapshot;
+    std::vector<int64_t> m_backend_context;
+    size_t m_turns = 0;
+
+    /**
+     * @brief Session file of this model: a hash of the key, so any key is a valid file name
+     */
+    std::string filePath() const;
+};
+
+} // namespace Camus
@@ -6,14 +6,25 @@
 #pragma once
 
 #include "Camus/CliParser.hpp"
+#include "Camus/SourceMinifier.hpp"
 #include <memory>
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <iosfwd>
 
 // Forward declarations to reduce header dependencies
 namespace Camus {
     class ConfigParser;
     class LlmInteraction;
     class SysInteraction;
+    class DaemonClient;
+    class ModelRegistry;
+    class ProjectScanner;
+    class ContextBuilder;
+    struct AmodifyConfig;
+    struct FileModification;
+    enum class EditFormat;
 }
 
 namespace Camus {
@@ -38,22 +49,148 @@ public:
      */
     int run();
 
+    /**
+     * @brief Executes a `model` subcommand against a registry.
+     * Shared by the CLI and the daemon, which keeps its registry resident.
+     * @param registry The registry to operate on.
+     * @param subcommand One of list, test, info, reload.
+     * @param model_name Model for test and info (may be empty for test).
+     * @param out Stream receiving the command's output.
+     * @return An integer exit code (0 for success).
+     */
+    static int runModelCommand(ModelRegistry& registry, const std::string& subcommand,
+                               const std::string& model_name, std::ostream& out);
+
 private:
     // Command Handlers
     int handleInit();
     int handleModify();
     int handleAmodify();
+    int handleAmodifyBatch();
     int handleRefactor();
     int handleBuild();
     int handleTest();
     int handleCommit();
     int handlePush();
     int handleModel();
+    int handleServe();
+    int handleServeApi();
+
+    /**
+     * @brief Scans the project for files amodify may read and change.
+     * @param amod_config Extensions, ignore patterns and file limit to apply.
+     * @return Relative paths, capped at the configured maximum; most similar to
+     *         the request first when retrieval is enabled.
+     */
+    std::vector<std::string> scanAmodifyFiles(const AmodifyConfig& amod_config);
+
+    /**
+     * @brief Scans through the embedding index and ranks files by similarity to the request.
+     * The index under retrieval_index_dir is updated for changed files first.
+     * Sets m_retrieval_scores; falls back to a plain scan if the embedding model fails.
+     * @param scanner Configured project scanner.
+     * @param amod_config Embedding model, index location and retrieval limits.
+     * @return Relative paths, most similar first.
+     */
+    std::vector<std::string> retrieveAmodifyFiles(ProjectScanner& scanner, const AmodifyConfig& amod_config);
+
+    /**
+     * @brief Picks whole-file or search/replace output for the current model.
+     * @param amod_config The configured edit_format; "auto" defers to the model's
+     *        edit_format attribute in models.yml.
+     * @return The format the prompt should request.
+     */
+    EditFormat selectEditFormat(const AmodifyConfig& amod_config) const;
+
+    /**
+     * @brief Applies the amodify context settings shared by the single, batch and fan-out paths.
+     * @param builder The builder to configure.
+     * @param amod_config Deduplication and minification settings.
+     * @param edit_format Output format the prompt should request.
+     */
+    void configureContextBuilder(ContextBuilder& builder, const AmodifyConfig& amod_config,
+                                 EditFormat edit_format) const;
+
+    /**
+     * @brief Sends an amodify prompt, with constrained decoding when configured.
+     * @param prompt Full prompt.
+     * @param amod_config Decides whether the FILE block format is enforced.
+     * @param constrained Set to true if the backend reports it enforced the format.
+     * @param backend_context If set, conversation state to continue from; replaced by the state
+     *                        the backend returns (left empty by backends that keep none).
+     * @return The model output.
+     */
+    std::string requestAmodifyCompletion(const std::string& prompt, const AmodifyConfig& amod_config,
+                                         bool& constrained, std::vector<int64_t>* backend_context = nullptr);
+
+    /**
+     * @brief Parses an amodify response, reporting why if nothing usable came back.
+     * @param llm_response Raw model output in the multi-file format.
+     * @param constrained True if the output was produced under the FILE block grammar.
+     * @param changed_since_sent If set, receives minified files that were rejected because
+     *                           they changed on disk after the prompt was built.
+     * @return The modifications; empty if none could be parsed.
+     */
+    std::vector<FileModification> parseAmodifyResponse(const std::string& llm_response, bool constrained,
+                                                       std::vector<std::string>* changed_since_sent = nullptr);
+
+    /**
+     * @brief Parses an amodify response, runs safety checks, confirms and applies it.
+     * @param llm_response Raw model output in the multi-file format.
+     * @param amod_config Backup and interaction settings.
+     * @param constrained True if the output was produced under the FILE block grammar.
+     * @param edits If set, receives the path and new content of every parsed modification.
+     * @return An integer exit code (0 if every modification was applied).
+     */
+    int applyAmodifyResponse(const std::string& llm_response, const AmodifyConfig& amod_config,
+                             bool constrained = false,
+                             std::vector<std::pair<std::string, std::string>>* edits = nullptr);
+
+    /**
+     * @brief Runs safety checks, backups and confirmation, then writes the modifications.
+     * @param modifications Parsed changes.
+     * @param amod_config Backup and interaction settings.
+     * @return An integer exit code (0 if every modification was applied).
+     */
+    int applyAmodifyModifications(std::vector<FileModification> modifications,
+                                  const AmodifyConfig& amod_config);
+
+    /**
+     * @brief Fans an amodify request out as one task per cluster of related files.
+     * Tasks run concurrently across the models loaded from .camus/models.yml
+     * (or one after another on the configured backend) and their results are
+     * merged into one change set.
+     * @param discovered_files Files found by scanAmodifyFiles().
+     * @param amod_config Fan-out limits and apply settings.
+     * @return An integer exit code (0 if every task ran and its changes were applied).
+     */
+    int runAmodifyFanout(const std::vector<std::string>& discovered_files, const AmodifyConfig& amod_config);
+
+    /**
+     * @brief Loads the backend configured in .camus/config.yml.
+     * @return The backend, or nullptr if it is misconfigured or fails to load.
+     */
+    std::unique_ptr<LlmInteraction> createBackend();
+
+    /**
+     * @brief Path of the llama.cpp model file named in .camus/config.yml.
+     * @return The path, or an empty string for the Ollama backend or missing settings.
+     */
+    std::string directModelPath() const;
+
+    /**
+     * @brief Endpoint key of the configured backend, computed without loading it.
+     * @return The key createBackend()'s backend will report, or empty if unconfigured.
+     */
+    std::string configuredBackendEndpoint() const;
 
     const Commands& m_commands;
     std::unique_ptr<ConfigParser> m_config;
     std::unique_ptr<LlmInteraction> m_llm;
     std::unique_ptr<SysInteraction> m_sys;
+    DaemonClient* m_daemon = nullptr; // Set when m_llm is served by a running daemon
+    std::unordered_map<std::string, double> m_retrieval_scores; // File similarity to the amodify request
+    std::unordered_map<std::string, MinifiedSource> m_minified_sources; // Files the amodify prompt shows minified
 };
 
 } // namespace Camus
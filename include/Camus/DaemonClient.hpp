@@ -0,0 +1,94 @@
+// =================================================================
+// include/Camus/DaemonClient.hpp
+// =================================================================
+// LlmInteraction that forwards requests to a running camus daemon.
+
+#pragma once
+
+#include "Camus/LlmInteraction.hpp"
+#include "Camus/DaemonProtocol.hpp"
+#include <string>
+#include <memory>
+#include <utility>
+#include <atomic>
+#include <mutex>
+
+namespace Camus {
+
+/**
+ * @brief Thin client for the model kept resident by `camus serve`
+ *
+ * Behaves like the in-process backend it stands in for: generated text
+ * is echoed to stdout as it streams in unless the request supplies its
+ * own on_token observer. A lost connection surfaces as a
+ * std::runtime_error from the completion methods.
+ *
+ * One connection carries one request at a time. Threads sharing a client,
+ * such as amodify fan-out workers, take turns; the daemon serializes
+ * generation on its backend anyway.
+ */
+class DaemonClient : public LlmInteraction {
+public:
+    /**
+     * @brief Connect to a daemon and perform the handshake
+     * @param socket_path Daemon socket
+     * @return Connected client, or nullptr if no compatible daemon is running
+     */
+    static std::unique_ptr<DaemonClient> connect(const std::string& socket_path = DEFAULT_DAEMON_SOCKET);
+
+    ~DaemonClient() override;
+
+    // LlmInteraction interface implementation
+    std::string getCompletion(const std::string& prompt) override;
+    InferenceResponse getCompletionWithMetadata(const InferenceRequest& request) override;
+    ModelMetadata getModelMetadata() const override;
+    bool isHealthy() const override;
+    bool performHealthCheck() override;
+    ModelPerformance getCurrentPerformance() const override;
+    std::string getModelId() const override;
+
+    /**
+     * @brief Run a `camus model` subcommand against the daemon's resident registry
+     * @return Command output and exit code
+     */
+    std::pair<std::string, int> runModelCommand(const std::string& subcommand, const std::string& model_name);
+
+    /**
+     * @brief Get a human-readable summary of the daemon's state
+     */
+    std::string getStatus();
+
+    /**
+     * @brief Ask the daemon to exit once in-flight requests finish
+     * @return True if the daemon acknowledged
+     */
+    bool requestShutdown();
+
+    /**
+     * @brief Process id of the daemon
+     */
+    long getDaemonPid() const { return m_daemon_pid; }
+
+private:
+    explicit DaemonClient(int fd);
+
+    MessageChannel m_channel;
+    std::atomic<bool> m_connected{true};
+    long m_daemon_pid = 0;
+    std::string m_model_id;
+    ModelMetadata m_metadata;
+    ModelPerformance m_performance;
+    
+    // Held from sending a request until its reply has been read, so
+    // concurrent callers cannot interleave on the socket
+    std::mutex m_request_mutex;
+    mutable std::mutex m_performance_mutex;
+
+    /**
+     * @brief Send a request and wait for the daemon's reply
+     * @throws std::runtime_error if the connection is lost
+     */
+    std::string roundTrip(const std::string& message);
+};
+
+} // namespace Camus
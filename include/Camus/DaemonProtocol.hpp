@@ -0,0 +1,83 @@
+// =================================================================
+// include/Camus/DaemonProtocol.hpp
+// =================================================================
+// Framing and socket helpers shared by the camus daemon and its clients.
+//
+// Messages are single-line JSON objects terminated by '\n', exchanged
+// over a Unix domain socket. Every message carries a "type" field:
+//
+//   client -> daemon: hello, ping, status, complete, model, shutdown
+//   daemon -> client: hello, pong, status, token, done, result, error
+
+#pragma once
+
+#include <string>
+#include <mutex>
+
+namespace Camus {
+
+/// Default daemon socket, relative to the project root
+constexpr const char* DEFAULT_DAEMON_SOCKET = ".camus/camus.sock";
+
+/// Protocol version, bumped on incompatible message changes
+constexpr int DAEMON_PROTOCOL_VERSION = 2;
+
+/**
+ * @brief Newline-delimited message channel over a connected socket
+ *
+ * Sends are serialized so a streaming producer and a control reply can
+ * share one connection. Receives must come from a single thread.
+ */
+class MessageChannel {
+public:
+    /**
+     * @brief Take ownership of a connected socket
+     */
+    explicit MessageChannel(int fd);
+    ~MessageChannel();
+
+    MessageChannel(const MessageChannel&) = delete;
+    MessageChannel& operator=(const MessageChannel&) = delete;
+
+    /**
+     * @brief Send one message; a trailing newline is added
+     * @return False if the peer has gone away
+     */
+    bool send(const std::string& message);
+
+    /**
+     * @brief Block until a complete message arrives
+     * @param message Receives the message without its newline
+     * @return False on end of stream or error
+     */
+    bool receive(std::string& message);
+
+    /**
+     * @brief Shut the socket down, waking a blocked receive() in another thread
+     */
+    void shutdown();
+
+    int fd() const { return m_fd; }
+
+private:
+    int m_fd;
+    std::string m_buffer;
+    size_t m_scanned = 0;
+    std::mutex m_send_mutex;
+};
+
+/**
+ * @brief Connect to a daemon socket
+ * @return Connected socket, or -1 if no daemon is listening
+ */
+int connectDaemonSocket(const std::string& socket_path);
+
+/**
+ * @brief Length of the longest prefix of text that ends on a UTF-8 character boundary
+ *
+ * Generated pieces can split multi-byte characters; the remainder is held
+ * back until the next piece completes it.
+ */
+size_t completeUtf8Length(const std::string& text);
+
+} // namespace Camus
@@ -0,0 +1,116 @@
+// =================================================================
+// include/Camus/EditApplier.hpp
+// =================================================================
+// Parses search/replace and unified-diff hunks and applies them to file
+// content with fuzzy matching.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Camus {
+
+/**
+ * @brief How a model is asked to return its changes
+ */
+enum class EditFormat {
+    WHOLE_FILE,         ///< "--- FILE: path ---" followed by the complete new content
+    SEARCH_REPLACE      ///< "--- EDIT: path ---" followed by search/replace or unified-diff hunks
+};
+
+/**
+ * @brief One replacement: the lines to find and what they become
+ */
+struct EditHunk {
+    std::string search;         ///< Existing text; empty appends (or creates the file)
+    std::string replace;        ///< Replacement text
+};
+
+/**
+ * @brief Outcome of applying the hunks of one file
+ */
+struct EditApplyResult {
+    bool success = false;               ///< True if every hunk was applied
+    std::string content;                ///< Content after the applied hunks
+    size_t hunks_applied = 0;           ///< Hunks that found their target
+    size_t fuzzy_matches = 0;           ///< Of those, hunks that needed whitespace or similarity matching
+    std::vector<std::string> errors;    ///< One message per hunk that could not be placed
+};
+
+/**
+ * @brief Applies edit hunks to file content
+ *
+ * Each hunk is located by, in order: an exact match of whole lines; a line
+ * match ignoring trailing whitespace; a line match ignoring indentation,
+ * with the replacement re-indented to the file; and finally the window of
+ * lines most similar to the search text, if it scores at least
+ * min_similarity and no other window ties with it. Searching starts after
+ * the previous hunk, since models emit hunks in file order, and wraps to
+ * the top of the file.
+ */
+class EditApplier {
+public:
+    /**
+     * @param min_similarity Average per-line similarity (0-1) a fuzzy window needs
+     */
+    explicit EditApplier(double min_similarity = 0.85);
+
+    /**
+     * @brief Parse the body of an EDIT block
+     *
+     * Accepts search/replace blocks
+     *
+     *     <<<<<<< SEARCH
+     *     old lines
+     *     =======
+     *     new lines
+     *     >>>>>>> REPLACE
+     *
+     * and unified-diff hunks starting with "@@", where context and "-" lines
+     * form the search text and context and "+" lines the replacement.
+     * @param block_text Text between the EDIT marker and the next block
+     * @return Hunks in the order they appear
+     */
+    static std::vector<EditHunk> parseHunks(const std::string& block_text);
+
+    /**
+     * @brief Apply hunks in order
+     * @param original Current file content
+     * @param hunks Hunks from parseHunks()
+     * @return Result; content holds every hunk that could be applied
+     */
+    EditApplyResult apply(const std::string& original, const std::vector<EditHunk>& hunks) const;
+
+    /**
+     * @brief Parse a format name ("whole_file" or "search_replace")
+     * @param name Name from configuration
+     * @param fallback Returned for an empty or unknown name
+     */
+    static EditFormat parseFormat(const std::string& name, EditFormat fallback = EditFormat::WHOLE_FILE);
+
+    /**
+     * @brief Configuration name of a format
+     */
+    static std::string formatName(EditFormat format);
+
+private:
+    double m_min_similarity;
+
+    /**
+     * @brief Place one hunk in the lines of the file
+     * @param lines File lines, replaced in place on success
+     * @param cursor Line index where the search starts; moved past the replacement
+     * @param hunk Hunk to apply
+     * @param fuzzy Set if anything looser than a trailing-whitespace match was needed
+     * @return False if no acceptable location was found
+     */
+    bool applyToLines(std::vector<std::string>& lines, size_t& cursor, const EditHunk& hunk, bool& fuzzy) const;
+
+    /**
+     * @brief Similarity of two lines ignoring surrounding whitespace (bigram Dice coefficient)
+     */
+    static double lineSimilarity(const std::string& a, const std::string& b);
+};
+
+} // namespace Camus
@@ -0,0 +1,176 @@
+// =================================================================
+// include/Camus/EmbeddingIndex.hpp
+// =================================================================
+// Semantic retrieval of source chunks: structural chunking, an embedding
+// model interface and a persistent HNSW index kept under .camus/.
+
+#pragma once
+
+#include "Camus/HnswIndex.hpp"
+#include "Camus/ProjectScanner.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+
+namespace Camus {
+
+/**
+ * @brief Turns text into a fixed-length embedding vector
+ */
+class TextEmbedder {
+public:
+    virtual ~TextEmbedder() = default;
+
+    /**
+     * @brief Embed one text
+     * @return Vector of dimensions() floats
+     * @throws std::runtime_error if the model fails
+     */
+    virtual std::vector<float> embed(const std::string& text) = 0;
+
+    virtual size_t dimensions() const = 0;
+
+    /**
+     * @brief Identifies the model; an index built with another model is discarded
+     */
+    virtual std::string modelId() const = 0;
+};
+
+/**
+ * @brief A contiguous range of lines of one file
+ */
+struct CodeChunk {
+    std::string file_path;      ///< Relative path
+    size_t start_line = 0;      ///< First line, 1-based
+    size_t end_line = 0;        ///< Last line, inclusive
+    std::string text;           ///< The lines themselves (not persisted)
+};
+
+/**
+ * @brief Retrieval result
+ */
+struct ChunkHit {
+    CodeChunk chunk;            ///< Location of the chunk; text is empty
+    float score = 0.0f;         ///< Cosine similarity to the query
+};
+
+/**
+ * @brief Chunking and index settings
+ */
+struct EmbeddingIndexConfig {
+    size_t max_chunk_lines = 60;    ///< Longest chunk
+    size_t min_chunk_lines = 8;     ///< Shorter declarations merge with their successors
+    size_t max_chunk_chars = 2400;  ///< Keeps a chunk within a small embedding model's context
+    HnswConfig hnsw;                ///< Graph settings
+};
+
+/**
+ * @brief Splits source files at top-level declaration boundaries
+ *
+ * A boundary is an unindented line that follows a blank line or a closing
+ * brace, which in most languages starts a function, class or comment block
+ * preceding one. Small neighbouring declarations are merged and long ones
+ * are split, preferably at blank lines, so chunks stay within the limits.
+ */
+class CodeChunker {
+public:
+    static std::vector<CodeChunk> chunk(const std::string& file_path, const std::string& content,
+                                        const EmbeddingIndexConfig& config = EmbeddingIndexConfig());
+};
+
+/**
+ * @brief Counters from one EmbeddingIndex::update()
+ */
+struct IndexUpdateStats {
+    size_t files_embedded = 0;      ///< New or changed files (re)chunked and embedded
+    size_t files_removed = 0;       ///< Files dropped from the index
+    size_t chunks_embedded = 0;
+    size_t chunks_removed = 0;
+    bool compacted = false;         ///< The graph was rebuilt to drop deleted chunks
+};
+
+/**
+ * @brief Persistent semantic index over the project's source chunks
+ *
+ * Keyword scoring misses files whose names and identifiers do not appear
+ * in the request. The index embeds every chunk once and keeps the vectors
+ * in an HNSW graph on disk, so a query costs one embedding plus a
+ * millisecond graph search. update() takes the scanner's changed-file list
+ * and only re-embeds those files; chunks of changed and removed files are
+ * deleted from the graph, which is compacted once they dominate it.
+ *
+ * On disk (index_dir): hnsw.bin holds the graph, chunks.json the chunk
+ * locations and the stamp of each indexed file.
+ */
+class EmbeddingIndex {
+public:
+    /**
+     * @param index_dir Directory for the index files (created on save)
+     * @param embedder Model used for chunks and queries; must outlive the index
+     * @param config Chunking and graph settings
+     */
+    EmbeddingIndex(const std::string& index_dir, TextEmbedder& embedder,
+                   const EmbeddingIndexConfig& config = EmbeddingIndexConfig());
+
+    /**
+     * @brief Load the index from index_dir
+     * @return false if there is none, it is unreadable or it was built with
+     *         another model; the index is then empty and update() rebuilds it
+     */
+    bool load();
+
+    /**
+     * @brief Write the index to index_dir
+     * @throws std::runtime_error if the files cannot be written
+     */
+    void save() const;
+
+    /**
+     * @brief Bring the index in line with a scan
+     * @param delta Result of ProjectScanner::scanChanges(knownFiles())
+     * @param root_path Directory the scanned paths are relative to
+     * @return What was re-embedded and removed
+     */
+    IndexUpdateStats update(const ScanDelta& delta, const std::string& root_path = ".");
+
+    /**
+     * @brief Chunks most similar to a query
+     * @param text Query, usually the user's request
+     * @param k Number of chunks
+     * @return Hits, most similar first
+     */
+    std::vector<ChunkHit> query(const std::string& text, size_t k);
+
+    /**
+     * @brief Best chunk score of each file among hits
+     */
+    static std::unordered_map<std::string, double> fileScores(const std::vector<ChunkHit>& hits);
+
+    /**
+     * @brief Stamps of the indexed files, for ProjectScanner::scanChanges()
+     */
+    const std::unordered_map<std::string, FileStamp>& knownFiles() const { return m_file_stamps; }
+
+    size_t chunkCount() const { return m_graph ? m_graph->size() : 0; }
+
+private:
+    std::string m_index_dir;
+    TextEmbedder& m_embedder;
+    EmbeddingIndexConfig m_config;
+    std::unique_ptr<HnswIndex> m_graph;
+    std::unordered_map<uint32_t, CodeChunk> m_chunks;                       ///< Live chunks by graph id
+    std::unordered_map<std::string, std::vector<uint32_t>> m_file_chunks;   ///< Graph ids of each file's chunks
+    std::unordered_map<std::string, FileStamp> m_file_stamps;
+
+    void reset();
+    void removeFile(const std::string& file_path, IndexUpdateStats& stats);
+    void compact();
+
+    /**
+     * @brief Text embedded for a chunk: its path followed by its lines
+     */
+    static std::string embeddingText(const CodeChunk& chunk);
+};
+
+} // namespace Camus
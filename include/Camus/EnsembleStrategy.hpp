@@ -37,6 +37,7 @@ struct ModelResponse {
     std::string model_name;                       ///< Model that generated response
     std::string response_text;                    ///< Generated response
     double confidence_score = 0.0;                ///< Model's confidence (0-1)
+    bool token_confidence = false;                ///< confidence_score is the geometric-mean token probability
     double quality_score = 0.0;                   ///< Response quality score (0-1)
     std::chrono::milliseconds execution_time{0}; ///< Time to generate response
     size_t tokens_generated = 0;                  ///< Number of tokens generated
@@ -64,7 +65,7 @@ struct EnsembleRequest {
     size_t max_consensus_iterations = 3;          ///< Max iterations for consensus building
     std::unordered_map<std::string, std::string> metadata; ///< Additional metadata
     bool enable_parallel_execution = true;        ///< Execute models in parallel
-    bool enable_early_stopping = false;           ///< Stop early if confidence threshold met
+    bool enable_early_stopping = false;           ///< Sequential execution: stop once a model's token confidence meets the threshold
     double early_stopping_threshold = 0.9;       ///< Confidence threshold for early stopping
 };
 
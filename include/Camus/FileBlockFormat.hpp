@@ -0,0 +1,77 @@
+// =================================================================
+// include/Camus/FileBlockFormat.hpp
+// =================================================================
+// Grammar and JSON schema for the "--- FILE: path ---" response format.
+
+#pragma once
+
+#include <string>
+
+namespace Camus {
+
+/**
+ * @brief Describes the amodify output format to constrained decoders
+ *
+ * A response is one or more blocks, each a marker line followed by the
+ * complete file content:
+ *
+ *     --- FILE: src/main.cpp ---
+ *     ...
+ *
+ * or the single line "NO CHANGES" when nothing needs to change (an empty
+ * "files" array in JSON).
+ *
+ * llama.cpp enforces the GBNF grammar token by token. Ollama only accepts
+ * a JSON schema, so its output is {"files": [{"path", "content"}]} and is
+ * converted back into blocks with fromJson(). Either way the text handed
+ * to ResponseParser is well formed.
+ */
+class FileBlockFormat {
+public:
+    /// Value of InferenceResponse::metadata["constraint"] when the format was enforced
+    static constexpr const char* CONSTRAINT_NAME = "file_blocks";
+
+    /// Whole response of a model that has nothing to change
+    static constexpr const char* NO_CHANGES = "NO CHANGES";
+
+    /**
+     * @brief GBNF grammar for the block format
+     *
+     * Paths may not contain whitespace. Content lines may not begin with
+     * "--- FILE:", so a marker can only start a new block, and every
+     * line, the last included, ends with a newline.
+     */
+    static const std::string& grammar();
+
+    /**
+     * @brief JSON schema for Ollama's "format" option
+     */
+    static const std::string& jsonSchema();
+
+    /**
+     * @brief Convert a JSON response that follows jsonSchema() into blocks
+     * @param json_text Model output
+     * @return Block-format text; entries with an empty or multi-line path are dropped
+     * @throws std::runtime_error if the text is not an object with a "files" array
+     */
+    static std::string fromJson(const std::string& json_text);
+
+    /**
+     * @brief Render one block
+     */
+    static std::string formatBlock(const std::string& path, const std::string& content);
+
+    /**
+     * @brief Check whether a response is NO_CHANGES, ignoring surrounding whitespace
+     */
+    static bool isNoChanges(const std::string& response);
+
+    /**
+     * @brief Recognize a marker line as the grammar produces it
+     * @param line Line without its newline
+     * @param path Receives the path if the line is a marker; may be nullptr
+     */
+    static bool parseMarker(const std::string& line, std::string* path);
+};
+
+} // namespace Camus
@@ -0,0 +1,135 @@
+// =================================================================
+// include/Camus/HnswIndex.hpp
+// =================================================================
+// Approximate nearest-neighbour search over unit vectors with a
+// hierarchical navigable small world graph.
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+#include <random>
+#include <utility>
+
+namespace Camus {
+
+/**
+ * @brief Graph construction and search settings
+ */
+struct HnswConfig {
+    size_t max_links = 16;          ///< Links per node on upper layers (layer 0 keeps twice as many)
+    size_t ef_construction = 100;   ///< Candidate list size while inserting
+    size_t ef_search = 64;          ///< Candidate list size while querying (raised to k if smaller)
+};
+
+/**
+ * @brief HNSW index with cosine similarity
+ *
+ * Vectors are normalised on insertion, so similarity is a dot product.
+ * Each node lives on layer 0 and, with exponentially decreasing
+ * probability, on layers above it; a search descends greedily through the
+ * sparse upper layers and then explores layer 0 with a bounded candidate
+ * list, which visits a small fraction of the nodes.
+ *
+ * Removal marks a node deleted: it still routes searches but is never
+ * returned. Once deleted nodes outnumber live ones, compacted() rebuilds
+ * the graph from the live vectors.
+ */
+class HnswIndex {
+public:
+    /**
+     * @param dimensions Length of every vector
+     * @param config Graph settings
+     */
+    explicit HnswIndex(size_t dimensions, const HnswConfig& config = HnswConfig());
+
+    /**
+     * @brief Insert a vector
+     * @param vector Vector of dimensions() floats; need not be normalised
+     * @return Id of the new node (ids are assigned consecutively from 0)
+     * @throws std::runtime_error if the length does not match
+     */
+    uint32_t add(const std::vector<float>& vector);
+
+    /**
+     * @brief Exclude a node from future results
+     */
+    void remove(uint32_t id);
+
+    /**
+     * @brief Nearest live nodes to a query
+     * @param query Vector of dimensions() floats
+     * @param k Number of results
+     * @return Node id and cosine similarity, most similar first
+     */
+    std::vector<std::pair<uint32_t, float>> search(const std::vector<float>& query, size_t k) const;
+
+    /**
+     * @brief Rebuild the graph from the live nodes only
+     * @param new_ids Receives the new id of every old id (UINT32_MAX for deleted nodes)
+     * @return The rebuilt index
+     */
+    HnswIndex compacted(std::vector<uint32_t>& new_ids) const;
+
+    size_t dimensions() const { return m_dimensions; }
+    size_t size() const { return m_levels.size() - m_deleted_count; }     ///< Live nodes
+    size_t deletedCount() const { return m_deleted_count; }
+    bool isDeleted(uint32_t id) const { return id < m_deleted.size() && m_deleted[id]; }
+
+    /**
+     * @brief Whether deleted nodes make up most of the graph
+     */
+    bool needsCompaction() const { return m_deleted_count > 0 && m_deleted_count >= size(); }
+
+    /**
+     * @brief Write the index in a binary format
+     */
+    void save(std::ostream& out) const;
+
+    /**
+     * @brief Read an index written by save()
+     * @throws std::runtime_error if the data is not a valid index
+     */
+    static HnswIndex load(std::istream& in);
+
+private:
+    size_t m_dimensions;
+    HnswConfig m_config;
+    std::vector<float> m_vectors;                               ///< Node vectors, dimensions() floats each
+    std::vector<int> m_levels;                                  ///< Top layer of each node
+    std::vector<std::vector<std::vector<uint32_t>>> m_links;    ///< Links per node, per layer
+    std::vector<bool> m_deleted;
+    size_t m_deleted_count = 0;
+    uint32_t m_entry_point = 0;
+    int m_max_level = -1;                                       ///< Top layer of the graph; -1 when empty
+    std::mt19937 m_rng{0x5eed};                                 ///< Fixed seed: identical input builds an identical graph
+
+    const float* vectorAt(uint32_t id) const { return m_vectors.data() + static_cast<size_t>(id) * m_dimensions; }
+    float similarity(const float* a, const float* b) const;
+    size_t maxLinks(int level) const { return level == 0 ? 2 * m_config.max_links : m_config.max_links; }
+    int randomLevel();
+
+    /**
+     * @brief Best-first search of one layer
+     * @return Up to ef nodes with their similarity to query, most similar first
+     */
+    std::vector<std::pair<float, uint32_t>> searchLayer(const float* query, uint32_t entry,
+                                                        size_t ef, int level) const;
+
+    /**
+     * @brief Pick diverse links from candidates (most similar first)
+     *
+     * A candidate is kept only if it is closer to the base node than to any
+     * link already kept, so links spread in different directions instead of
+     * clustering.
+     */
+    std::vector<uint32_t> selectLinks(const std::vector<std::pair<float, uint32_t>>& candidates,
+                                      size_t max_count) const;
+
+    void connect(uint32_t from, uint32_t to, int level);
+};
+
+} // namespace Camus
@@ -0,0 +1,139 @@
+// =================================================================
+// include/Camus/HttpApiServer.hpp
+// =================================================================
+// OpenAI-compatible HTTP front-end for the model orchestrator.
+
+#pragma once
+
+#include "Camus/ApiRequestQueue.hpp"
+#include "Camus/ModelOrchestrator.hpp"
+#include "Camus/ModelRegistry.hpp"
+#include <string>
+#include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+// Forward declare cpp-httplib types to keep the header clean
+namespace httplib {
+    class Server;
+    struct Request;
+    struct Response;
+}
+
+namespace Camus {
+
+/**
+ * @brief HTTP API server configuration
+ */
+struct ApiServerConfig {
+    std::string host = "127.0.0.1";         ///< Address to bind
+    int port = 8080;                        ///< Port to bind (0 = any free port)
+    ApiQueueConfig queue;                   ///< Execution queue limits
+    size_t http_threads = 16;               ///< Connection handler threads
+    std::chrono::seconds request_timeout{300}; ///< Longest a client waits for a response
+    std::vector<std::string> api_keys;      ///< Accepted bearer tokens (empty = no authentication)
+    std::string served_model_name = "camus"; ///< Model id meaning "let the orchestrator choose"
+    size_t max_body_bytes = 8 * 1024 * 1024; ///< Largest accepted request body
+};
+
+/**
+ * @brief HTTP API server counters
+ */
+struct ApiServerMetrics {
+    std::map<std::string, size_t> responses;  ///< Responses by "endpoint status"
+    size_t streamed_responses = 0;          ///< Responses sent as server-sent events
+    size_t unauthorized = 0;                ///< Requests rejected for a missing/invalid key
+    size_t tokens_generated = 0;            ///< Completion tokens served
+    size_t completions = 0;                 ///< Successful completions
+    std::chrono::milliseconds total_latency{0}; ///< Summed request latency of completions
+    ApiQueueStats queue;                    ///< Execution queue statistics
+};
+
+/**
+ * @brief Serves /v1/completions and /v1/chat/completions over HTTP
+ *
+ * Requests are translated to PipelineRequests and executed by a
+ * ModelOrchestrator, so HTTP clients get the same classification, model
+ * selection, caching and load balancing as the CLI. Responses follow
+ * the OpenAI wire format, including server-sent-event streaming, so
+ * existing editor plugins and SDKs can point at a shared Camus instance.
+ *
+ * Execution goes through an ApiRequestQueue: requests beyond the queue
+ * or per-client limits are answered with 429 immediately. Clients are
+ * identified by their bearer token, or by address when authentication
+ * is off. Counters are exposed in Prometheus text format on /metrics.
+ */
+class HttpApiServer {
+public:
+    /**
+     * @brief Construct the server
+     * @param orchestrator Orchestrator executing requests; must outlive the server
+     * @param registry Registry listing the models exposed on /v1/models
+     * @param config Server configuration
+     */
+    HttpApiServer(ModelOrchestrator& orchestrator, ModelRegistry& registry,
+                  const ApiServerConfig& config = ApiServerConfig());
+
+    ~HttpApiServer();
+
+    HttpApiServer(const HttpApiServer&) = delete;
+    HttpApiServer& operator=(const HttpApiServer&) = delete;
+
+    /**
+     * @brief Bind and start serving on a background thread
+     * @return The bound port
+     * @throws std::runtime_error if the address cannot be bound
+     */
+    int start();
+
+    /**
+     * @brief Start and block until stop() or SIGINT/SIGTERM
+     * @return Process exit code
+     */
+    int run();
+
+    /**
+     * @brief Stop serving; in-flight requests are abandoned
+     */
+    void stop();
+
+    bool isRunning() const;
+    int getPort() const { return m_port; }
+
+    /**
+     * @brief Get server counters
+     */
+    ApiServerMetrics getMetrics() const;
+
+    /**
+     * @brief Render counters in Prometheus text exposition format
+     */
+    std::string renderMetrics() const;
+
+private:
+    ModelOrchestrator& m_orchestrator;
+    ModelRegistry& m_registry;
+    ApiServerConfig m_config;
+    std::unique_ptr<httplib::Server> m_server;
+    std::unique_ptr<ApiRequestQueue> m_queue;
+    std::thread m_listener;
+    int m_port = 0;
+    std::atomic<bool> m_stopping{false};
+
+    mutable std::mutex m_metrics_mutex;
+    ApiServerMetrics m_metrics;
+    std::atomic<size_t> m_next_request_id{1};
+
+    void setupRoutes();
+    void handleCompletion(const httplib::Request& req, httplib::Response& res, bool chat);
+    void handleModels(httplib::Response& res);
+    bool authorize(const httplib::Request& req, httplib::Response& res, std::string& client_id);
+    void recordResponse(const std::string& endpoint, int status);
+    void recordCompletion(const PipelineResponse& response, std::chrono::milliseconds latency);
+};
+
+} // namespace Camus
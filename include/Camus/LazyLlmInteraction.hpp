@@ -0,0 +1,86 @@
+// =================================================================
+// include/Camus/LazyLlmInteraction.hpp
+// =================================================================
+// LlmInteraction handle that constructs its backend on first use.
+
+#pragma once
+
+#include "Camus/LlmInteraction.hpp"
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+namespace Camus {
+
+/**
+ * @brief Defers loading a backend until a request actually needs it
+ *
+ * Commands such as `build` and `test` only consult the model when
+ * something fails, so paying for llama_backend_init and a multi-gigabyte
+ * model load up front is wasted on the common, successful run. This handle
+ * runs the factory the first time a completion, health check or metadata
+ * query needs the real backend. Until then, getModelId() and isHealthy()
+ * answer without loading anything.
+ *
+ * Given a model file, it also has the ModelPrefetcher warm the page cache
+ * while the caller works, so a load that does happen reads from memory
+ * instead of disk.
+ */
+class LazyLlmInteraction : public LlmInteraction {
+public:
+    using Factory = std::function<std::unique_ptr<LlmInteraction>()>;
+
+    /**
+     * @brief Construct the handle; nothing is loaded yet
+     * @param factory Creates the backend; returning nullptr marks it unavailable
+     * @param model_id Identifier reported before the backend is loaded
+     * @param prefetch_path Model file to warm in the page cache (empty = none)
+     * @param backend_endpoint Endpoint the backend will report, so the
+     *        concurrency limiter key does not change on load (empty = the
+     *        model ID until loaded, then the backend's own endpoint)
+     */
+    LazyLlmInteraction(Factory factory, std::string model_id, std::string prefetch_path = "",
+                       std::string backend_endpoint = "");
+
+    ~LazyLlmInteraction() override;
+
+    /**
+     * @brief Whether the backend has been constructed
+     */
+    bool isLoaded() const { return m_loaded.load(); }
+
+    /**
+     * @brief Construct the backend now if it has not been yet
+     * @return The backend
+     * @throws std::runtime_error if the factory fails
+     */
+    LlmInteraction& backend() const;
+
+    // LlmInteraction interface implementation
+    std::string getCompletion(const std::string& prompt) override;
+    InferenceResponse getCompletionWithMetadata(const InferenceRequest& request) override;
+    ModelMetadata getModelMetadata() const override;
+    bool isHealthy() const override;
+    bool performHealthCheck() override;
+    ModelPerformance getCurrentPerformance() const override;
+    bool warmUp() override;
+    void cleanup() override;
+    std::string getModelId() const override;
+    std::string getBackendEndpoint() const override;
+
+private:
+    Factory m_factory;
+    std::string m_model_id;
+
+    mutable std::mutex m_load_mutex;
+    mutable std::unique_ptr<LlmInteraction> m_backend;
+    mutable std::atomic<bool> m_loaded{false};
+    mutable bool m_load_failed = false;
+
+    std::string m_prefetch_path;
+    std::string m_backend_endpoint;
+};
+
+} // namespace Camus
@@ -0,0 +1,58 @@
+// =================================================================
+// include/Camus/LlamaCppEmbedder.hpp
+// =================================================================
+// TextEmbedder backed by a local GGUF embedding model through llama.cpp.
+
+#pragma once
+
+#include "Camus/EmbeddingIndex.hpp"
+#include <string>
+#include <vector>
+#include <mutex>
+
+// Forward declare llama.cpp structs to keep the header clean
+struct llama_model;
+struct llama_context;
+
+namespace Camus {
+
+/**
+ * @brief Embeds text with a GGUF model in llama.cpp's embedding mode
+ *
+ * Meant for small encoder models (bge, nomic-embed, all-MiniLM): the model
+ * file's pooling type is used, and models without pooling fall back to the
+ * last token's hidden state. Input longer than the context is truncated.
+ * Vectors are L2-normalised.
+ */
+class LlamaCppEmbedder : public TextEmbedder {
+public:
+    /**
+     * @param model_path Path to the GGUF embedding model
+     * @param n_ctx Tokens per embedded text
+     * @throws std::runtime_error if the model cannot be loaded
+     */
+    explicit LlamaCppEmbedder(const std::string& model_path, size_t n_ctx = 512);
+    ~LlamaCppEmbedder() override;
+
+    LlamaCppEmbedder(const LlamaCppEmbedder&) = delete;
+    LlamaCppEmbedder& operator=(const LlamaCppEmbedder&) = delete;
+
+    std::vector<float> embed(const std::string& text) override;
+    size_t dimensions() const override { return m_dimensions; }
+
+    /**
+     * @brief File name and size of the model
+     */
+    std::string modelId() const override { return m_model_id; }
+
+private:
+    std::string m_model_path;
+    std::string m_model_id;
+    llama_model* m_model = nullptr;
+    llama_context* m_context = nullptr;
+    size_t m_n_ctx;
+    size_t m_dimensions = 0;
+    std::mutex m_mutex;     ///< One decode at a time per context
+};
+
+} // namespace Camus
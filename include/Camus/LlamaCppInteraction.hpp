@@ -6,8 +6,14 @@
 #pragma once
 
 #include "Camus/LlmInteraction.hpp"
+#include "Camus/PromptLookupDrafter.hpp"
+#include "Camus/MemoryGovernor.hpp"
 #include <string>
+#include <vector>
 #include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <atomic>
 
 // Forward declare llama.cpp structs to keep the header clean
 struct llama_model;
@@ -48,15 +54,81 @@ public:
     bool warmUp() override;
     void cleanup() override;
     std::string getModelId() const override;
+    std::string getBackendEndpoint() const override;
+
+    /**
+     * @brief Endpoint key of a model file, known without loading it
+     * @param model_path Full path to the GGUF model file
+     */
+    static std::string endpointFor(const std::string& model_path);
+
+    /**
+     * @brief Prompt-lookup acceptance counters over every generation so far
+     */
+    SpeculativeStats getSpeculativeStats();
 
 private:
     llama_model* m_model = nullptr;
     llama_context* m_context = nullptr;
     ModelMetadata m_metadata;
+    mutable std::mutex m_metadata_mutex;      ///< Guards m_metadata writes after construction against getModelMetadata()
     mutable ModelPerformance m_performance;
     std::chrono::system_clock::time_point m_last_health_check;
     mutable bool m_is_healthy = false;
     std::string m_model_path;
+    std::vector<int32_t> m_cached_tokens;     ///< llama_token ids whose KV entries are resident, in order
+    std::string m_memory_key;                 ///< Name this model is budgeted under by the MemoryGovernor
+    uint32_t m_n_ctx = 4096;                  ///< Context size, kept for reloads
+    std::mutex m_state_mutex;                 ///< Serializes generation against eviction
+    std::atomic<bool> m_evicted{false};       ///< Weights released by the governor; reload on next use
+    PromptLookupConfig m_prompt_lookup;       ///< Draft-free speculative decoding settings
+    SpeculativeStats m_speculative_stats;     ///< Cumulative acceptance, guarded by m_state_mutex
+
+    static constexpr float DEFAULT_TEMPERATURE = 0.4f; ///< Used by getCompletion()
+    static constexpr size_t DEFAULT_MAX_NEW_TOKENS = 4096; ///< Used by getCompletion()
+
+    /**
+     * @brief Per-call results of generate(), returned to the caller rather
+     *        than kept on the instance so concurrent requests cannot mix them
+     */
+    struct GenerationStats {
+        size_t tokens_generated = 0;          ///< Tokens produced
+        size_t reused_prompt_tokens = 0;      ///< Prompt tokens served from the KV cache
+        SpeculativeStats speculative;         ///< Prompt-lookup acceptance of this generation
+        std::vector<float> logprobs;          ///< Log-probability of each generated token
+    };
+    
+    /**
+     * @brief Run generation for a prompt
+     * @param prompt Prompt text
+     * @param on_token Receives each generated piece; when empty, pieces are echoed to stdout
+     * @param stats Filled with the statistics of this generation
+     * @param temperature Sampling temperature; 0 or below selects greedy decoding
+     * @param constraint Format to enforce with a grammar; the output is then returned uncleaned
+     * @param max_new_tokens Generation limit; the time limit grows with it
+     */
+    std::string generate(const std::string& prompt, const TokenCallback& on_token, GenerationStats& stats,
+                         float temperature = DEFAULT_TEMPERATURE,
+                         ResponseConstraint constraint = ResponseConstraint::NONE,
+                         size_t max_new_tokens = DEFAULT_MAX_NEW_TOKENS);
+    
+    /**
+     * @brief Load the weights and context within the memory budget
+     * @return Lease taken before the load is committed, so the governor
+     *         cannot evict the model before the caller has used it
+     * @throws std::runtime_error if the governor refuses the load or llama.cpp fails
+     */
+    MemoryGovernor::Lease loadWeights();
+    
+    /**
+     * @brief Free the weights and context; called by the MemoryGovernor on eviction
+     */
+    void unloadWeights();
+    
+    /**
+     * @brief Read prompt_lookup, prompt_lookup_ngram and prompt_lookup_max_draft from custom attributes
+     */
+    void configurePromptLookup();
     
     /**
      * @brief Initialize default metadata based on model characteristics
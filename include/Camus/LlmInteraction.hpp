@@ -9,9 +9,27 @@
 #include <string>
 #include <memory>
 #include <chrono>
+#include <functional>
+#include <cstdint>
+#include <vector>
+#include <cmath>
+#include <algorithm>
 
 namespace Camus {
 
+/**
+ * @brief Receives generated text incrementally as the model produces it
+ */
+using TokenCallback = std::function<void(const std::string&)>;
+
+/**
+ * @brief Structure the backend must force the generated text into
+ */
+enum class ResponseConstraint {
+    NONE,           ///< Free-form text
+    FILE_BLOCKS     ///< One or more "--- FILE: path ---" blocks (see FileBlockFormat)
+};
+
 /**
  * @brief Request configuration for model inference
  */
@@ -23,6 +41,9 @@ struct InferenceRequest {
     std::vector<std::string> stop_sequences; ///< Stop generation at these sequences
     bool stream = false;                    ///< Whether to stream the response
     std::chrono::milliseconds timeout{30000}; ///< Request timeout
+    TokenCallback on_token;                 ///< Optional observer for generated text as it arrives
+    ResponseConstraint constraint = ResponseConstraint::NONE; ///< Constrained decoding, if the backend supports it
+    std::vector<int64_t> context_tokens;    ///< Conversation state from a previous response; the prompt continues it
 };
 
 /**
@@ -35,7 +56,37 @@ struct InferenceResponse {
     bool was_truncated = false;            ///< Whether response was truncated
     std::string finish_reason;             ///< Reason for completion (stop, length, error)
     double confidence_score = 0.0;         ///< Model's confidence in response (0.0-1.0)
-    std::unordered_map<std::string, std::string> metadata; ///< Additional metadata
+    std::unordered_map<std::string, std::string> metadata; ///< Additional metadata; "constraint" names an enforced format
+    std::vector<float> token_logprobs;     ///< Natural-log probability of each generated token; empty if the backend cannot report them
+    double mean_logprob = 0.0;             ///< Mean of token_logprobs
+    double min_logprob = 0.0;              ///< Log-probability of the least likely generated token
+    double perplexity = 0.0;               ///< exp(-mean_logprob); 0 when token_logprobs is empty
+    std::vector<int64_t> context_tokens;   ///< Conversation state to continue from (Ollama's "context"); empty if the backend keeps none
+
+    bool hasLogprobs() const { return !token_logprobs.empty(); }
+
+    /**
+     * @brief Derive the aggregates and confidence_score from token_logprobs
+     *
+     * confidence_score becomes the geometric-mean token probability,
+     * exp(mean_logprob): free to compute, and low when the model was unsure
+     * over much of the output. Does nothing if there are no logprobs.
+     */
+    void summarizeLogprobs() {
+        if (token_logprobs.empty()) {
+            return;
+        }
+        double sum = 0.0;
+        float lowest = 0.0f;
+        for (float logprob : token_logprobs) {
+            sum += logprob;
+            lowest = std::min(lowest, logprob);
+        }
+        mean_logprob = sum / static_cast<double>(token_logprobs.size());
+        min_logprob = lowest;
+        perplexity = std::exp(-mean_logprob);
+        confidence_score = std::clamp(std::exp(mean_logprob), 0.0, 1.0);
+    }
 };
 
 /**
@@ -63,6 +114,9 @@ public:
         
         InferenceResponse response;
         response.text = getCompletion(request.prompt);
+        if (request.on_token) {
+            request.on_token(response.text);
+        }
         
         auto end_time = std::chrono::steady_clock::now();
         response.response_time = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -117,6 +171,17 @@ public:
      * @return Unique model instance ID
      */
     virtual std::string getModelId() const = 0;
+    
+    /**
+     * @brief Identify the server or process that runs this model
+     *
+     * Models with the same endpoint compete for the same compute, so they
+     * share one adaptive concurrency limit.
+     * @return Endpoint key; defaults to the model ID
+     */
+    virtual std::string getBackendEndpoint() const {
+        return getModelId();
+    }
 };
 
 } // namespace Camus
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "Camus/ModelRegistry.hpp"
 #include "Camus/LlmInteraction.hpp"
+#include "Camus/ResourceMonitor.hpp"
 #include <string>
 #include <memory>
 #include <vector>
@@ -26,6 +27,8 @@ namespace Camus {
 struct ModelInstance {
     std::string instance_id;                      ///< Unique instance identifier
     std::string model_name;                       ///< Name of the model
+    InternedId id = INVALID_INTERNED_ID;          ///< Interned instance_id
+    InternedId model_id = INVALID_INTERNED_ID;    ///< Interned model_name
     std::shared_ptr<LlmInteraction> model;        ///< Model implementation
     std::atomic<bool> is_healthy{true};           ///< Health status
     std::atomic<size_t> active_requests{0};       ///< Current active requests
@@ -67,6 +70,7 @@ struct RequestContext {
  */
 struct LoadBalancingResult {
     std::string selected_instance_id;            ///< Selected instance ID
+    InternedId selected_instance = INVALID_INTERNED_ID; ///< Interned selected_instance_id
     std::shared_ptr<LlmInteraction> model;       ///< Selected model instance
     std::string selection_reason;                ///< Reason for selection
     std::chrono::milliseconds selection_time{0}; ///< Time taken for selection
@@ -81,14 +85,16 @@ struct LoadBalancerConfig {
     LoadBalancingStrategy default_strategy = LoadBalancingStrategy::LEAST_LOADED;
     size_t max_instances_per_model = 3;          ///< Maximum instances per model
     size_t max_requests_per_instance = 10;       ///< Maximum concurrent requests per instance
+    bool adaptive_concurrency = true;            ///< Cap instances at the backend's discovered concurrency limit
     std::chrono::minutes health_check_interval{2}; ///< Health check frequency
     std::chrono::seconds instance_timeout{300};  ///< Instance inactivity timeout
     std::chrono::seconds request_timeout{30};    ///< Default request timeout
     bool auto_scale = true;                       ///< Enable automatic scaling
     bool enable_fallback = true;                  ///< Enable fallback instances
-    double memory_usage_threshold = 0.8;         ///< Memory usage threshold for scaling
+    double memory_usage_threshold = 0.8;         ///< System memory fraction above which no instances are added
     double response_time_threshold = 5000.0;     ///< Response time threshold in ms
     std::unordered_map<std::string, double> instance_weights; ///< Instance weights for weighted round-robin
+    ResourceMonitor* resource_monitor = nullptr;  ///< Monitor consulted before scaling up (nullptr = shared instance)
 };
 
 /**
@@ -109,6 +115,29 @@ public:
         const std::vector<ModelInstance*>& instances
     ) = 0;
     
+    /**
+     * @brief Select best instance for request, returning the instance itself
+     *
+     * The load balancer calls this on every request. The default maps the
+     * ID from selectInstance() back to its instance; built-in strategies
+     * override it and skip the ID round trip.
+     * @param context Request context
+     * @param instances Available instances
+     * @return Selected instance or nullptr if none available
+     */
+    virtual ModelInstance* pickInstance(
+        const RequestContext& context,
+        const std::vector<ModelInstance*>& instances
+    ) {
+        std::string selected_id = selectInstance(context, instances);
+        for (auto* instance : instances) {
+            if (instance->instance_id == selected_id) {
+                return instance;
+            }
+        }
+        return nullptr;
+    }
+    
     /**
      * @brief Get strategy name
      * @return Strategy identifier
@@ -149,6 +178,14 @@ public:
      */
     virtual LoadBalancingResult selectInstance(const std::string& model_name, const RequestContext& context);
     
+    /**
+     * @brief Select best model instance for request by interned model id
+     * @param model_id Model id assigned by the registry
+     * @param context Request context
+     * @return Load balancing result
+     */
+    virtual LoadBalancingResult selectInstance(InternedId model_id, const RequestContext& context);
+    
     /**
      * @brief Create new model instance
      * @param model_name Model name
@@ -177,6 +214,13 @@ public:
      */
     virtual ModelInstance* getInstance(const std::string& instance_id);
     
+    /**
+     * @brief Get instance by interned ID
+     * @param instance_id Interned instance identifier
+     * @return Instance pointer or nullptr if not found
+     */
+    virtual ModelInstance* getInstance(InternedId instance_id);
+    
     /**
      * @brief Register load balancing strategy
      * @param strategy Strategy type
@@ -203,6 +247,13 @@ public:
      */
     virtual void recordRequestStart(const std::string& instance_id, const std::string& request_id);
     
+    /**
+     * @brief Record request start by interned instance ID
+     * @param instance_id Interned instance identifier
+     * @param request_id Request identifier
+     */
+    virtual void recordRequestStart(InternedId instance_id, const std::string& request_id);
+    
     /**
      * @brief Record request completion
      * @param instance_id Instance that handled the request
@@ -213,6 +264,16 @@ public:
     virtual void recordRequestEnd(const std::string& instance_id, const std::string& request_id, 
                                 double response_time, bool success);
     
+    /**
+     * @brief Record request completion by interned instance ID
+     * @param instance_id Interned instance identifier
+     * @param request_id Request identifier
+     * @param response_time Response time in milliseconds
+     * @param success Whether request succeeded
+     */
+    virtual void recordRequestEnd(InternedId instance_id, const std::string& request_id,
+                                double response_time, bool success);
+    
     /**
      * @brief Perform health checks on all instances
      * @return Number of healthy instances
@@ -270,7 +331,11 @@ public:
 
 protected:
     /**
-     * @brief Generate unique instance ID
+     * @brief Generate unique instance ID (caller holds m_instances_mutex)
+     *
+     * Uses the model's lowest free slot, so a replacement instance reuses
+     * the interned id of the one it replaces and the interner and the
+     * id-indexed tables stay bounded under autoscaling churn.
      * @param model_name Model name
      * @return Unique instance identifier
      */
@@ -297,25 +362,45 @@ protected:
      * @brief Health check thread function
      */
     void healthCheckLoop();
+    
+    /**
+     * @brief Instances of a model (caller holds m_instances_mutex)
+     * @param model_id Interned model name
+     * @return Vector of instance pointers
+     */
+    std::vector<ModelInstance*> instancesForModel(InternedId model_id) const;
+    
+    /**
+     * @brief Whether measured memory usage leaves room for another instance
+     * @return False when usage is at or above memory_usage_threshold
+     */
+    bool hasMemoryHeadroom() const;
+
+    /**
+     * @brief Concurrent requests one instance of a model should take
+     * @param instances Instances of the model
+     * @return max_requests_per_instance, lowered to the adaptive limit of
+     *         the model's backend endpoint when enabled
+     */
+    size_t requestLimit(const std::vector<ModelInstance*>& instances) const;
 
 private:
     ModelRegistry& m_registry;
     LoadBalancerConfig m_config;
     LoadBalancingStrategy m_current_strategy;
+    ResourceMonitor* m_monitor;
     
-    std::unordered_map<std::string, std::unique_ptr<ModelInstance>> m_instances;
-    std::unordered_map<std::string, std::vector<std::string>> m_model_instances;
+    // Flat tables indexed by interned ids; empty slots are null / empty
+    std::vector<std::unique_ptr<ModelInstance>> m_instances;      // instance id -> instance
+    std::vector<std::vector<InternedId>> m_model_instances;       // model id -> instance ids
+    size_t m_instance_count = 0;
     std::unordered_map<LoadBalancingStrategy, std::shared_ptr<BalancingStrategy>> m_strategies;
-    std::unordered_map<std::string, std::string> m_active_requests; // request_id -> instance_id
     
     mutable std::mutex m_instances_mutex;
-    mutable std::mutex m_requests_mutex;
     
     std::unique_ptr<std::thread> m_health_check_thread;
     std::atomic<bool> m_stop_health_checks{false};
     
-    std::atomic<size_t> m_next_instance_id{1};
-    
     // Built-in strategy classes
     class RoundRobinStrategy;
     class LeastLoadedStrategy;
@@ -0,0 +1,184 @@
+// =================================================================
+// include/Camus/LogReducer.hpp
+// =================================================================
+// Streaming reduction of build and test logs to the diagnostics that
+// matter, for inclusion in LLM prompts.
+
+#pragma once
+
+#include "Camus/ProcessRunner.hpp"
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+namespace Camus {
+
+/**
+ * @brief Severity of a compiler/tool diagnostic
+ */
+enum class DiagnosticSeverity {
+    FATAL,      ///< Fatal error, compilation stopped
+    ERROR,      ///< Error
+    WARNING     ///< Warning
+};
+
+/**
+ * @brief A single diagnostic extracted from a build log
+ */
+struct LogDiagnostic {
+    std::string file;                       ///< Referenced file (empty for tool/linker errors)
+    size_t line = 0;                        ///< Line number (0 if unknown)
+    size_t column = 0;                      ///< Column number (0 if unknown)
+    DiagnosticSeverity severity = DiagnosticSeverity::ERROR;
+    std::string header;                     ///< The diagnostic line as printed
+    std::vector<std::string> notes;         ///< Include chain and instantiation context leading to it
+    std::vector<std::string> context;       ///< Following lines (source excerpt, caret, notes)
+    size_t suppressed_notes = 0;            ///< Notes dropped as template/include noise
+    size_t occurrences = 1;                 ///< How often the same diagnostic was reported
+};
+
+/**
+ * @brief A failing test and the output associated with it
+ */
+struct TestFailureBlock {
+    std::string framework;                  ///< "gtest", "ctest" or "pytest"
+    std::string test_name;                  ///< Test identifier
+    std::vector<std::string> lines;         ///< Relevant output lines
+    size_t omitted_lines = 0;               ///< Lines dropped from the middle of the block
+};
+
+/**
+ * @brief Log reducer configuration
+ */
+struct LogReducerConfig {
+    size_t max_output_bytes = 8 * 1024;     ///< Hard limit on the reduced log size
+    size_t max_diagnostics = 40;            ///< Unique diagnostics retained
+    size_t max_context_lines = 8;           ///< Lines (excerpt and notes) kept after a diagnostic header
+    size_t max_notes_per_diagnostic = 4;    ///< Leading notes kept per diagnostic (first ones plus the last)
+    size_t max_failures = 20;               ///< Test failure blocks retained
+    size_t max_failure_lines = 40;          ///< Lines kept per test failure block
+    size_t tail_lines = 30;                 ///< Trailing log lines kept as a fallback
+    size_t max_line_length = 400;           ///< Longer lines are cut
+    bool include_warnings = true;           ///< Include warnings after errors if space remains
+    bool include_source_snippets = true;    ///< Include source around referenced locations
+    size_t snippet_radius = 3;              ///< Lines of source either side of a location
+    size_t max_snippets = 8;                ///< Maximum number of source snippets
+    std::string project_root = ".";         ///< Root used to resolve relative file paths
+};
+
+/**
+ * @brief Statistics about a reduction
+ */
+struct LogReducerStats {
+    size_t input_bytes = 0;                 ///< Bytes fed to the reducer
+    size_t input_lines = 0;                 ///< Lines fed to the reducer
+    size_t errors = 0;                      ///< Unique errors found
+    size_t warnings = 0;                    ///< Unique warnings found
+    size_t duplicates_collapsed = 0;        ///< Repeated diagnostics merged into one
+    size_t notes_suppressed = 0;            ///< Template/include notes dropped
+    size_t diagnostics_dropped = 0;         ///< Diagnostics beyond max_diagnostics
+    size_t test_failures = 0;               ///< Failing tests found
+    size_t snippets = 0;                    ///< Source snippets included
+    size_t output_bytes = 0;                ///< Size of the reduced log
+};
+
+/**
+ * @brief Reduces build/test output to a bounded, error-focused summary
+ *
+ * Output is fed incrementally (it can be attached to a ProcessRunner
+ * output callback), so memory use is bounded by the configured limits
+ * rather than by the size of the log. Recognises GCC/Clang and MSVC
+ * diagnostics, CMake and linker errors, and gtest, ctest and pytest
+ * failures. Repeated diagnostics (the same header error reported from
+ * every translation unit) are collapsed, and long template-instantiation
+ * and include chains are trimmed to their first and last notes.
+ */
+class LogReducer {
+public:
+    /**
+     * @brief Construct a new LogReducer
+     * @param config Reducer configuration
+     */
+    explicit LogReducer(const LogReducerConfig& config = LogReducerConfig());
+
+    /**
+     * @brief Feed a chunk of output
+     * @param data Output bytes (need not end on a line boundary)
+     * @param length Number of bytes
+     * @param stream Stream the bytes came from; partial lines are kept per stream
+     */
+    void feed(const char* data, size_t length, OutputStream stream = OutputStream::STDOUT);
+
+    /**
+     * @brief Feed a complete block of text
+     */
+    void feed(const std::string& text);
+
+    /**
+     * @brief Flush pending input and render the reduced log
+     * @return Reduced log, at most max_output_bytes long
+     */
+    std::string finish();
+
+    /**
+     * @brief Get the diagnostics found so far
+     */
+    const std::vector<LogDiagnostic>& getDiagnostics() const { return m_diagnostics; }
+
+    /**
+     * @brief Get the test failures found so far
+     */
+    const std::vector<TestFailureBlock>& getTestFailures() const { return m_failures; }
+
+    /**
+     * @brief Get reduction statistics
+     */
+    LogReducerStats getStats() const { return m_stats; }
+
+    /**
+     * @brief Convenience wrapper reducing a complete log in one call
+     */
+    static std::string reduce(const std::string& log, const LogReducerConfig& config = LogReducerConfig());
+
+private:
+    enum class BlockKind { NONE, GTEST, CTEST, PYTEST };
+
+    LogReducerConfig m_config;
+    LogReducerStats m_stats;
+    std::string m_partial[2];
+    std::vector<LogDiagnostic> m_diagnostics;
+    std::unordered_map<std::string, size_t> m_diagnostic_index;
+    std::vector<TestFailureBlock> m_failures;
+    std::deque<std::string> m_tail;
+    std::vector<std::string> m_pending_notes;
+    size_t m_pending_suppressed = 0;
+    size_t m_current_diagnostic;
+    bool m_skip_current = false;
+    BlockKind m_block = BlockKind::NONE;
+    std::string m_block_name;
+    std::vector<std::string> m_block_lines;
+    std::deque<std::string> m_block_tail;
+    size_t m_block_omitted = 0;
+    size_t m_ctest_failure = 0;
+    bool m_in_ctest_summary = false;
+
+    void processLine(std::string line);
+    bool handleTestLine(const std::string& line);
+    bool handleDiagnosticLine(const std::string& line);
+    bool parseDiagnostic(const std::string& line, LogDiagnostic& diagnostic) const;
+    void addDiagnostic(LogDiagnostic diagnostic);
+    void addNote(const std::string& line);
+    void startBlock(BlockKind kind, const std::string& name);
+    void appendBlockLine(const std::string& line);
+    void closeBlock(bool failed);
+    TestFailureBlock* findFailure(const std::string& name);
+    void addFailure(const std::string& framework, const std::string& name, const std::string& line);
+
+    std::string render();
+    std::string renderDiagnostic(const LogDiagnostic& diagnostic, bool compact) const;
+    std::string renderFailure(const TestFailureBlock& failure) const;
+    std::string renderSnippet(const std::string& file, size_t line) const;
+};
+
+} // namespace Camus
@@ -0,0 +1,188 @@
+// =================================================================
+// include/Camus/MemoryGovernor.hpp
+// =================================================================
+// Process-wide memory budget for resident models with cost-aware eviction.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+namespace Camus {
+
+class ResourceMonitor;
+
+/**
+ * @brief Memory governor configuration
+ */
+struct MemoryGovernorConfig {
+    uint64_t budget_bytes = 0;              ///< Memory for resident models (0 = budget_fraction of the limit)
+    double budget_fraction = 0.8;           ///< Share of the cgroup/host memory limit when budget_bytes is 0
+    std::chrono::seconds min_idle_time{30}; ///< Models used more recently are never evicted
+    std::chrono::milliseconds admission_timeout{120000}; ///< How long a load may queue for memory
+    ResourceMonitor* resource_monitor = nullptr; ///< Source of the memory limit (nullptr = shared instance)
+};
+
+/**
+ * @brief Governor counters
+ */
+struct MemoryGovernorStats {
+    uint64_t budget_bytes = 0;              ///< Effective budget
+    uint64_t resident_bytes = 0;            ///< Footprint of loaded models
+    uint64_t reserved_bytes = 0;            ///< Admitted loads still in progress
+    size_t resident_models = 0;             ///< Loaded models
+    size_t queued_loads = 0;                ///< Loads waiting for memory
+    size_t evictions = 0;                   ///< Models unloaded to make room
+    size_t rejected_loads = 0;              ///< Loads refused or timed out
+};
+
+/**
+ * @brief Enforces a memory budget across every in-process model
+ *
+ * Each load asks admit() for its estimated footprint first. If that would
+ * exceed the budget, idle models are evicted until it fits. A model is
+ * idle when no request holds a use() lease and it has not been used for
+ * min_idle_time. Among idle models the governor evicts the one with the
+ * highest idle time x footprint / reload time: large, long-idle models that
+ * reload quickly go first, and models that are slow to bring back stay
+ * resident. When nothing can be evicted the load waits, up to
+ * admission_timeout, for memory to be released. A load that could never
+ * fit is refused at once.
+ *
+ * After loading, commit() records the measured footprint (RSS growth plus
+ * KV cache) and the callback that unloads the model. Eviction callbacks
+ * run without the governor's lock held.
+ */
+class MemoryGovernor {
+public:
+    using EvictCallback = std::function<void()>;
+
+    /**
+     * @brief Marks a model as serving a request while alive
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept : m_governor(other.m_governor), m_model(std::move(other.m_model)) {
+            other.m_governor = nullptr;
+        }
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+    private:
+        friend class MemoryGovernor;
+        Lease(MemoryGovernor* governor, std::string model) : m_governor(governor), m_model(std::move(model)) {}
+
+        MemoryGovernor* m_governor = nullptr;
+        std::string m_model;
+    };
+
+    explicit MemoryGovernor(const MemoryGovernorConfig& config = MemoryGovernorConfig());
+
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+
+    /**
+     * @brief Process-wide governor
+     */
+    static MemoryGovernor& getInstance();
+
+    /**
+     * @brief Reserve memory for a load, evicting or queueing as needed
+     *
+     * A reload of a model whose eviction is still running waits for it to
+     * finish first.
+     * @param model Model key
+     * @param estimated_bytes Expected footprint
+     * @return True if the load may proceed; false if refused or timed out
+     */
+    bool admit(const std::string& model, uint64_t estimated_bytes);
+
+    /**
+     * @brief admit() with an explicit queueing timeout
+     */
+    bool admit(const std::string& model, uint64_t estimated_bytes, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Turn an admitted reservation into a resident model
+     * @param model Model key
+     * @param actual_bytes Measured footprint
+     * @param load_time How long the load took (the cost of reloading it)
+     * @param evict Unloads the model; called at most once
+     */
+    void commit(const std::string& model, uint64_t actual_bytes,
+                std::chrono::milliseconds load_time, EvictCallback evict);
+
+    /**
+     * @brief Drop a reservation whose load failed
+     */
+    void abort(const std::string& model);
+
+    /**
+     * @brief Forget a model that was unloaded by its owner
+     *
+     * Waits for a running eviction of the model to finish, so must not be
+     * called from anything an eviction callback blocks on.
+     */
+    void release(const std::string& model);
+
+    /**
+     * @brief Mark a model busy for the lifetime of the lease
+     */
+    Lease use(const std::string& model);
+
+    /**
+     * @brief Footprint recorded for a resident model, 0 if unknown
+     */
+    uint64_t getFootprint(const std::string& model) const;
+
+    uint64_t getBudget() const;
+
+    MemoryGovernorStats getStats() const;
+
+    /**
+     * @brief Resident set size of this process from /proc/self/statm
+     */
+    static uint64_t processRssBytes();
+
+private:
+    struct ResidentModel {
+        uint64_t bytes = 0;
+        bool reserved = true;               ///< Admitted but not yet committed
+        bool evicting = false;
+        size_t in_use = 0;
+        std::chrono::steady_clock::time_point last_used;
+        std::chrono::milliseconds reload_cost{0};
+        EvictCallback evict;
+    };
+
+    MemoryGovernorConfig m_config;
+    ResourceMonitor* m_monitor;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_released;
+    std::unordered_map<std::string, ResidentModel> m_models;
+    size_t m_queued = 0;
+    size_t m_evictions = 0;
+    size_t m_rejections = 0;
+
+    uint64_t committedBytes() const;        // caller holds m_mutex
+    uint64_t budgetLocked() const;          // caller holds m_mutex
+
+    /**
+     * @brief Idle model that frees the most memory for the least reload cost
+     * @return Its key, or empty if no model may be evicted
+     */
+    std::string pickVictim(std::chrono::steady_clock::time_point now) const;
+
+    void endUse(const std::string& model);
+};
+
+} // namespace Camus
@@ -59,6 +59,7 @@ struct ModelMetadata {
     bool is_healthy = false;                ///< Whether model is functioning properly
     std::chrono::system_clock::time_point last_health_check; ///< Last health check time
     std::string health_status_message;      ///< Human-readable health status
+    double page_cache_residency = -1.0;     ///< Fraction of the model file in the page cache (-1 = unknown)
 };
 
 /**
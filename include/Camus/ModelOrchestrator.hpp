@@ -9,6 +9,7 @@
 #include "Camus/ModelSelector.hpp"
 #include "Camus/LoadBalancer.hpp"
 #include "Camus/ModelRegistry.hpp"
+#include "Camus/RequestArena.hpp"
 #include <string>
 #include <memory>
 #include <vector>
@@ -37,17 +38,23 @@ struct PipelineRequest {
     std::unordered_map<std::string, std::string> metadata; ///< Additional metadata
     std::vector<std::string> preferred_models;    ///< Preferred model order
     std::vector<std::string> excluded_models;     ///< Models to exclude
+    TokenCallback on_token;                       ///< Optional observer for generated text as it arrives
 };
 
 /**
  * @brief Pipeline response structure
+ *
+ * The step list and debug map are allocated from the request's arena when
+ * one is given; the response keeps that arena alive until it is destroyed.
  */
 struct PipelineResponse {
+    ArenaHandle arena;                            ///< Arena backing the pmr containers (declared first)
     std::string request_id;                       ///< Original request ID
     std::string response_text;                    ///< Generated response
     bool success = false;                         ///< Whether request succeeded
     std::string error_message;                    ///< Error message if failed
     std::string selected_model;                   ///< Model that generated response
+    InternedId selected_model_id = INVALID_INTERNED_ID; ///< Interned selected_model when chosen by the selector
     std::string selected_instance;               ///< Instance that handled request
     TaskType classified_task;                     ///< Classified task type
     double classification_confidence = 0.0;       ///< Classification confidence
@@ -60,8 +67,18 @@ struct PipelineResponse {
     bool cache_hit = false;                       ///< Whether response came from cache
     bool fallback_used = false;                   ///< Whether fallback was triggered
     double quality_score = 0.0;                   ///< Response quality score (0-1)
-    std::vector<std::string> pipeline_steps;      ///< Steps taken in pipeline
-    std::unordered_map<std::string, std::string> debug_info; ///< Debug information
+    bool has_token_confidence = false;            ///< Backend reported token log-probabilities
+    double token_confidence = 0.0;                ///< Geometric-mean token probability (0-1)
+    double perplexity = 0.0;                      ///< exp(-mean token logprob)
+    std::pmr::vector<std::pmr::string> pipeline_steps; ///< Steps taken in pipeline
+    std::pmr::unordered_map<std::pmr::string, std::pmr::string> debug_info; ///< Debug information
+
+    PipelineResponse() = default;
+
+    explicit PipelineResponse(std::shared_ptr<RequestArena> request_arena)
+        : arena(std::move(request_arena)),
+          pipeline_steps(arena.resource()),
+          debug_info(arena.resource()) {}
 };
 
 /**
@@ -99,6 +116,7 @@ struct OrchestratorConfig {
     double min_quality_score = 0.3;               ///< Minimum acceptable quality
     double min_classification_confidence = 0.5;   ///< Minimum classification confidence
     double min_selection_confidence = 0.3;        ///< Minimum selection confidence
+    double token_confidence_weight = 0.5;         ///< Share of the quality score taken from token log-probabilities, when reported
     
     // Fallback settings
     std::string fallback_model = "";              ///< Default fallback model
@@ -110,6 +128,8 @@ struct OrchestratorConfig {
     bool cache_negative_responses = false;        ///< Cache failed responses
     size_t min_prompt_length_for_cache = 10;      ///< Minimum prompt length to cache
     double cache_similarity_threshold = 0.95;     ///< Similarity threshold for cache hits
+    bool enable_request_coalescing = true;        ///< Share one generation among identical in-flight greedy requests
+    size_t request_arena_size = RequestArena::DEFAULT_INITIAL_SIZE; ///< First arena block per request (0 = heap allocation)
 };
 
 /**
@@ -265,11 +285,13 @@ protected:
      * @brief Select model instance for load balancing
      * @param request Pipeline request
      * @param model_name Selected model name
+     * @param model_id Interned model name (INVALID_INTERNED_ID to look it up)
      * @param response Pipeline response (to update)
      * @return Load balancing result
      */
     virtual LoadBalancingResult selectInstance(const PipelineRequest& request,
                                              const std::string& model_name,
+                                             InternedId model_id,
                                              PipelineResponse& response);
     
     /**
@@ -352,6 +374,7 @@ private:
     
     std::unordered_map<std::string, CacheEntry> m_cache;
     PipelineStatistics m_statistics;
+    std::vector<size_t> m_model_usage;            // model id -> requests, copied into model_usage on read
     
     mutable std::mutex m_cache_mutex;
     mutable std::mutex m_stats_mutex;
@@ -0,0 +1,145 @@
+// =================================================================
+// include/Camus/ModelPrefetcher.hpp
+// =================================================================
+// Warms model files in the page cache and reports how much is resident.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <sys/types.h>
+
+namespace Camus {
+
+/**
+ * @brief Prefetcher configuration
+ */
+struct ModelPrefetcherConfig {
+    size_t worker_threads = 4;                      ///< Chunks read ahead concurrently
+    size_t chunk_bytes = 64 * 1024 * 1024;          ///< Bytes per readahead request
+    std::chrono::milliseconds residency_ttl{5000};  ///< How long a residency measurement is reused
+};
+
+/**
+ * @brief Prefetch counters
+ */
+struct ModelPrefetcherStats {
+    size_t chunks_issued = 0;                       ///< Read-ahead requests sent to the kernel
+    size_t chunks_skipped = 0;                      ///< Queued chunks dropped by cancel()
+};
+
+/**
+ * @brief Reads model files into the page cache ahead of a load
+ *
+ * Loading a multi-gigabyte GGUF is dominated by cold page-cache reads, and
+ * llama.cpp maps the file, so even a loaded model can stall on first use
+ * if the kernel evicted its pages. prefetch() splits a file into chunks
+ * and a small worker pool issues readahead() for them in parallel (or
+ * posix_fadvise(WILLNEED) where readahead is unavailable). The caller
+ * does not wait.
+ *
+ * residency() reports the fraction of a file currently in the page cache,
+ * measured with mincore() over a read-only mapping and cached briefly, so
+ * selection can prefer models that are already hot.
+ */
+class ModelPrefetcher {
+public:
+    explicit ModelPrefetcher(const ModelPrefetcherConfig& config = ModelPrefetcherConfig());
+
+    ~ModelPrefetcher();
+
+    ModelPrefetcher(const ModelPrefetcher&) = delete;
+    ModelPrefetcher& operator=(const ModelPrefetcher&) = delete;
+
+    /**
+     * @brief Process-wide prefetcher
+     */
+    static ModelPrefetcher& getInstance();
+
+    /**
+     * @brief Queue a file for read-ahead
+     * @param path Model file
+     * @return True if queued or already in progress, false if it cannot be opened
+     */
+    bool prefetch(const std::string& path);
+
+    /**
+     * @brief Drop a file's chunks that have not been issued yet
+     *
+     * A later prefetch() of the same file queues it again from the start.
+     */
+    void cancel(const std::string& path);
+
+    /**
+     * @brief Whether a file still has chunks queued or in flight
+     */
+    bool isPending(const std::string& path) const;
+
+    /**
+     * @brief Block until every queued chunk has been issued
+     */
+    void waitIdle();
+
+    /**
+     * @brief Cached fraction of a file in the page cache
+     * @return 0.0-1.0, or -1.0 if it cannot be measured
+     */
+    double residency(const std::string& path);
+
+    /**
+     * @brief Measure the fraction of a file in the page cache now
+     * @return 0.0-1.0, or -1.0 if it cannot be measured
+     */
+    static double measureResidency(const std::string& path);
+
+    ModelPrefetcherStats getStats() const;
+
+private:
+    struct PrefetchFile {
+        std::string path;
+        int fd = -1;
+        size_t pending_chunks = 0;                  ///< Guarded by m_mutex
+        bool cancelled = false;                     ///< Guarded by m_mutex
+        ~PrefetchFile();
+    };
+
+    struct Chunk {
+        std::shared_ptr<PrefetchFile> file;
+        off_t offset = 0;
+        size_t length = 0;
+    };
+
+    struct CachedResidency {
+        double fraction = -1.0;
+        std::chrono::steady_clock::time_point measured;
+    };
+
+    ModelPrefetcherConfig m_config;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_work;
+    std::condition_variable m_idle;
+    std::deque<Chunk> m_queue;
+    std::unordered_map<std::string, std::shared_ptr<PrefetchFile>> m_active;
+    std::vector<std::thread> m_workers;
+    size_t m_busy = 0;
+    bool m_stopping = false;
+    ModelPrefetcherStats m_stats;
+
+    std::mutex m_residency_mutex;
+    std::unordered_map<std::string, CachedResidency> m_residency;
+
+    void workerLoop();
+    void startWorkers();  // caller holds m_mutex
+    void finishChunk(const Chunk& chunk);
+};
+
+} // namespace Camus
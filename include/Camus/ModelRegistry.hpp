@@ -8,6 +8,7 @@
 #include "Camus/ModelPool.hpp"
 #include "Camus/ModelCapabilities.hpp"
 #include "Camus/LlmInteraction.hpp"
+#include "Camus/StringInterner.hpp"
 #include <string>
 #include <memory>
 #include <unordered_map>
@@ -38,6 +39,7 @@ struct ModelConfig {
     double expected_tokens_per_second = 0.0; ///< Expected performance
     double expected_latency_ms = 0.0;      ///< Expected latency
     std::unordered_map<std::string, std::string> custom_attributes; ///< Custom config
+    InternedId id = INVALID_INTERNED_ID;   ///< Dense model id, assigned when the registry loads the config
 };
 
 /**
@@ -50,6 +52,7 @@ struct RegistryConfig {
     bool enable_health_checks = true;      ///< Enable periodic health checks
     std::chrono::minutes health_check_interval{5}; ///< Health check interval
     bool warmup_on_load = false;           ///< Warm up models on load
+    bool prefetch_on_load = true;          ///< Read local model files into the page cache before loading, as far as available memory allows
     size_t max_load_retries = 3;           ///< Max retries for model loading
     std::chrono::seconds retry_delay{5};   ///< Delay between retries
 };
@@ -187,6 +190,22 @@ public:
      * @return Formatted model information
      */
     virtual std::string getModelInfo(const std::string& model_name) const;
+
+    /**
+     * @brief Start reading a model's file into the page cache
+     *
+     * Called when a model is expected to be needed soon; returns at once.
+     * @param model_name Configured model name
+     * @return True if read-ahead was queued (local model files only)
+     */
+    virtual bool prefetchModel(const std::string& model_name);
+
+    /**
+     * @brief Fraction of a model's file in the page cache
+     * @param model_name Configured model name
+     * @return 0.0-1.0, or -1.0 for remote models and unreadable files
+     */
+    virtual double getPageCacheResidency(const std::string& model_name) const;
     
     /**
      * @brief Get all models info as formatted string (for CLI)
@@ -194,6 +213,19 @@ public:
      */
     virtual std::string getAllModelsInfo() const;
     
+    /**
+     * @brief Serve a configured model from an instance the caller already holds
+     *
+     * Models loaded afterwards whose type and location match use this
+     * instance instead of loading a second copy. The registry never cleans
+     * the instance up; the caller keeps it alive while the registry lives.
+     * @param model_type Model type (llama_cpp, ollama)
+     * @param location Model file for llama_cpp, "server_url|model_name" for ollama
+     * @param instance The loaded model
+     */
+    virtual void shareInstance(const std::string& model_type, const std::string& location,
+                               std::shared_ptr<LlmInteraction> instance);
+    
     /**
      * @brief Set the registry configuration
      * @param config New configuration
@@ -246,6 +278,7 @@ private:
     std::unique_ptr<ConcreteModelPool> m_model_pool;
     std::unordered_map<std::string, ModelFactory> m_factories;
     std::unordered_map<std::string, ModelConfig> m_model_configs;
+    std::unordered_map<std::string, std::shared_ptr<LlmInteraction>> m_shared_instances; ///< By modelLocation()
     RegistryStatus m_status;
     
     // Health check thread management
@@ -263,6 +296,11 @@ private:
      */
     void updateStatus();
     
+    /**
+     * @brief Key of a model in m_shared_instances: type and normalized location
+     */
+    static std::string modelLocation(const std::string& model_type, const std::string& location);
+    
     /**
      * @brief Parse memory string (e.g., "8GB") to bytes
      */
@@ -14,6 +14,7 @@
 #include <unordered_map>
 #include <chrono>
 #include <functional>
+#include <memory_resource>
 
 namespace Camus {
 
@@ -29,17 +30,28 @@ struct SelectionCriteria {
     bool require_code_capability = false;         ///< Require code specialization
     std::vector<std::string> required_capabilities; ///< Required model capabilities
     std::unordered_map<std::string, double> custom_weights; ///< Custom scoring weights
+    std::pmr::memory_resource* memory_resource = nullptr; ///< Resource for the result's containers (nullptr = default heap)
 };
 
 /**
  * @brief Result of model selection
+ *
+ * Alternatives use the criteria's memory resource, which must outlive the
+ * result. Copies (e.g. the selection history) allocate from the default
+ * resource.
  */
 struct SelectionResult {
     std::string selected_model;                   ///< Selected model identifier
     double confidence_score = 0.0;                ///< Confidence in selection (0-1)
     std::string selection_reason;                 ///< Human-readable reason
-    std::vector<std::pair<std::string, double>> alternatives; ///< Alternative models with scores
+    InternedId selected_model_id = INVALID_INTERNED_ID; ///< Interned id of selected_model
+    std::pmr::vector<std::pair<std::pmr::string, double>> alternatives; ///< Alternative models with scores
     std::chrono::milliseconds selection_time{0}; ///< Time taken to select
+
+    SelectionResult() = default;
+
+    explicit SelectionResult(std::pmr::memory_resource* resource)
+        : alternatives(resource ? resource : std::pmr::get_default_resource()) {}
 };
 
 /**
@@ -53,6 +65,55 @@ struct ModelStatistics {
     double average_quality_score = 0.0;           ///< Average quality score (0-1)
     std::chrono::system_clock::time_point last_used; ///< Last usage time
     std::unordered_map<std::string, double> task_performance; ///< Performance by task type
+    double page_cache_residency = -1.0;           ///< Fraction of the model file in the page cache (-1 = unknown)
+};
+
+/**
+ * @brief Per-model statistics stored in a flat array indexed by model id
+ *
+ * Selection reads the statistics of every candidate on every request;
+ * indexing by the id the registry assigned avoids hashing model names.
+ */
+class ModelStatisticsTable {
+public:
+    /**
+     * @brief Statistics for a model id, or nullptr if none were recorded
+     */
+    const ModelStatistics* find(InternedId model_id) const;
+
+    /**
+     * @brief Statistics for a configured model
+     *
+     * Uses the config's id; configs built outside the registry carry no id
+     * and are looked up by name instead.
+     */
+    const ModelStatistics* find(const ModelConfig& model) const;
+
+    /**
+     * @brief Statistics for a model id, created empty on first use
+     */
+    ModelStatistics& get(InternedId model_id);
+
+    void erase(InternedId model_id);
+    void clear();
+    size_t size() const { return m_count; }
+
+    /**
+     * @brief Visit every recorded entry as (model name, statistics)
+     */
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (size_t id = 0; id < m_stats.size(); ++id) {
+            if (m_present[id]) {
+                visit(StringInterner::models().name(static_cast<InternedId>(id)), m_stats[id]);
+            }
+        }
+    }
+
+private:
+    std::vector<ModelStatistics> m_stats;
+    std::vector<bool> m_present;
+    size_t m_count = 0;
 };
 
 /**
@@ -66,13 +127,13 @@ public:
      * @brief Select a model based on criteria
      * @param criteria Selection criteria
      * @param available_models Available models with their configs
-     * @param model_stats Current model statistics
+     * @param model_stats Current model statistics, indexed by model id
      * @return Selection result
      */
     virtual SelectionResult selectModel(
         const SelectionCriteria& criteria,
         const std::vector<ModelConfig>& available_models,
-        const std::unordered_map<std::string, ModelStatistics>& model_stats
+        const ModelStatisticsTable& model_stats
     ) = 0;
     
     /**
@@ -93,6 +154,8 @@ struct ModelSelectorConfig {
     size_t performance_history_size = 100;        ///< Number of requests to track
     std::chrono::minutes stats_retention{60};     ///< How long to retain statistics
     std::unordered_map<std::string, double> default_weights; ///< Default scoring weights
+    bool prefer_resident_models = true;           ///< Score models whose files are in the page cache higher
+    bool prefetch_predicted_models = true;        ///< Warm the selected model's file when it is cold
 };
 
 /**
@@ -248,7 +311,7 @@ private:
     ModelSelectorConfig m_config;
     std::unordered_map<std::string, std::shared_ptr<SelectionStrategy>> m_strategies;
     std::string m_active_strategy;
-    std::unordered_map<std::string, ModelStatistics> m_model_stats;
+    ModelStatisticsTable m_model_stats;
     std::vector<SelectionResult> m_selection_history;
     mutable std::mutex m_stats_mutex;
     
@@ -7,9 +7,36 @@
 
 #include "Camus/LlmInteraction.hpp"
 #include <chrono>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
 
 namespace Camus {
 
+/**
+ * @brief Per-model runtime settings sent with every Ollama request
+ *
+ * Ollama reloads a model whenever num_ctx, num_batch or num_gpu change, so
+ * the same values are sent on every call, preload included. Values come
+ * from the model's custom_attributes in models.yml; the llama.cpp names
+ * threads, batch_size and gpu_layers are accepted as aliases.
+ */
+struct OllamaRuntimeOptions {
+    std::string keep_alive = "30m";     ///< Residency after each request ("-1" pins, "0" unloads)
+    int num_ctx = 0;                    ///< Context window (0 = server default)
+    int num_thread = 0;                 ///< CPU threads (0 = server default)
+    int num_batch = 0;                  ///< Prompt batch size (0 = server default)
+    int num_gpu = -1;                   ///< Layers offloaded to GPU (-1 = server default)
+    size_t max_in_flight = 0;           ///< Concurrent requests from this client (0 = unlimited)
+
+    /**
+     * @brief Read options from model custom attributes
+     * @param attributes Attributes such as keep_alive, num_ctx, num_thread, num_batch, num_gpu, num_parallel
+     */
+    static OllamaRuntimeOptions fromAttributes(const std::unordered_map<std::string, std::string>& attributes);
+};
+
 class OllamaInteraction : public LlmInteraction {
 public:
     /**
@@ -37,15 +64,38 @@ public:
     bool warmUp() override;
     void cleanup() override;
     std::string getModelId() const override;
+    std::string getBackendEndpoint() const override;
+
+    /**
+     * @brief Endpoint key of a server, known without constructing a client
+     * @param server_url The base URL of the Ollama server
+     */
+    static std::string endpointFor(const std::string& server_url);
+    
+    /**
+     * @brief Ask the server to evict the model now instead of after keep_alive
+     *
+     * The model is shared by every client of the server, so this is only
+     * done on explicit request (`camus model unload`), never on cleanup.
+     * @return true if the server acknowledged the unload
+     */
+    bool unloadFromServer();
 
 private:
     std::string m_server_url;
     std::string m_model_name;
     ModelMetadata m_metadata;
+    OllamaRuntimeOptions m_options;
     mutable ModelPerformance m_performance;
     std::chrono::system_clock::time_point m_last_health_check;
     mutable bool m_is_healthy = false;
     
+    // Requests beyond max_in_flight wait here instead of queueing inside
+    // Ollama, where they would count against our read timeout
+    std::mutex m_flight_mutex;
+    std::condition_variable m_flight_cv;
+    size_t m_in_flight = 0;
+    
     /**
      * @brief Initialize default metadata based on model characteristics
      */
@@ -61,6 +111,21 @@ private:
      */
     std::string generateModelId() const;
     
+    /**
+     * @brief Run /api/generate for a prompt
+     * @param prompt Prompt text
+     * @param request Sampling parameters to send as options; nullptr uses the server defaults
+     * @param response Receives token counts and Ollama's timing fields; may be nullptr
+     */
+    std::string generate(const std::string& prompt, const InferenceRequest* request,
+                         InferenceResponse* response = nullptr);
+    
+    /**
+     * @brief Ask Ollama to load the model without generating
+     * @return true if the server acknowledged the load
+     */
+    bool preload();
+    
     /**
      * @brief Make HTTP request to Ollama server
      */
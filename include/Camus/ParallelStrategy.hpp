@@ -9,6 +9,7 @@
 #include "Camus/TaskClassifier.hpp"
 #include "Camus/ModelCapabilities.hpp"
 #include "Camus/LlmInteraction.hpp"
+#include "Camus/ResourceMonitor.hpp"
 #include <string>
 #include <memory>
 #include <vector>
@@ -44,6 +45,9 @@ struct ParallelSubtask {
     bool is_critical = false;                     ///< Whether failure fails entire request
     std::chrono::milliseconds timeout{30000};     ///< Subtask-specific timeout
     double weight = 1.0;                          ///< Weight for result aggregation
+    double temperature = 0.7;                     ///< Sampling temperature (0 = greedy, coalesced when identical)
+    ResponseConstraint constraint = ResponseConstraint::NONE; ///< Constrained decoding, if the backend supports it
+    size_t max_tokens = 0;                        ///< Generation limit (0 = backend default)
     std::vector<std::string> dependencies;        ///< Other subtask IDs this depends on
     std::string aggregation_group;                ///< Group for result aggregation
 };
@@ -59,7 +63,7 @@ struct SubtaskResult {
     std::string error_message;                    ///< Error if failed
     std::chrono::milliseconds execution_time{0};  ///< Time to execute
     double quality_score = 0.0;                   ///< Quality of result
-    std::unordered_map<std::string, std::string> metadata; ///< Additional metadata
+    std::unordered_map<std::string, std::string> metadata; ///< Additional metadata; "constraint" names an enforced format
 };
 
 /**
@@ -147,6 +151,8 @@ struct ParallelStrategyConfig {
     
     double max_cpu_usage_percent = 80.0;          ///< Maximum CPU usage threshold
     double max_memory_usage_percent = 70.0;       ///< Maximum memory usage threshold
+    double max_memory_pressure = 25.0;            ///< Memory PSI "some" avg10 ceiling in percent (0 = ignore)
+    ResourceMonitor* resource_monitor = nullptr;  ///< Monitor to admit against (nullptr = shared instance)
     
     std::chrono::milliseconds default_subtask_timeout{30000}; ///< Default timeout per subtask
     std::chrono::milliseconds max_total_time{300000}; ///< Maximum total execution time
@@ -346,7 +352,7 @@ protected:
     virtual bool waitForResources(std::chrono::milliseconds timeout);
     
     /**
-     * @brief Update resource usage statistics
+     * @brief Refresh cached resource usage from the resource monitor
      * @param subtask_count Number of active subtasks
      */
     virtual void updateResourceUsage(size_t subtask_count);
@@ -378,6 +384,7 @@ private:
     std::unique_ptr<ThreadPool> m_thread_pool;
     
     // Resource monitoring
+    ResourceMonitor* m_monitor;
     std::atomic<double> m_current_cpu_usage{0.0};
     std::atomic<double> m_current_memory_usage{0.0};
     std::atomic<size_t> m_active_executions{0};
@@ -402,9 +409,17 @@ private:
     void initializeDefaultAggregators();
     
     /**
-     * @brief Monitor system resources
+     * @brief Whether a resource snapshot leaves room for more work
+     * @param snapshot Current resource usage
+     * @return True if CPU, memory, pressure and concurrency are under their limits
+     */
+    bool admits(const SystemResourceSnapshot& snapshot) const;
+    
+    /**
+     * @brief Block until fewer than a given number of subtasks are running
+     * @param limit Maximum concurrent subtasks
      */
-    void monitorResources();
+    void waitForExecutionSlot(size_t limit);
     
     /**
      * @brief Resolve subtask dependencies
@@ -0,0 +1,144 @@
+// =================================================================
+// include/Camus/ProcessRunner.hpp
+// =================================================================
+// Native process runner with streaming output, bounded capture,
+// timeouts and process-group termination.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+namespace Camus {
+
+/**
+ * @brief Identifies which stream a chunk of child output came from
+ */
+enum class OutputStream {
+    STDOUT,     ///< Child's standard output
+    STDERR      ///< Child's standard error
+};
+
+/**
+ * @brief Options controlling how a child process is run
+ */
+struct ProcessOptions {
+    bool tee_output = false;                        ///< Mirror child output to our stdout/stderr as it arrives
+    bool merge_stderr = true;                       ///< Interleave stderr into ProcessResult::output
+    size_t max_capture_bytes = 4 * 1024 * 1024;     ///< Capture limit; the most recent bytes are kept
+    size_t read_buffer_size = 64 * 1024;            ///< Size of each read() from the child pipes
+    std::chrono::milliseconds timeout{0};           ///< Wall-clock limit (0 = no limit)
+    std::chrono::milliseconds kill_grace_period{2000}; ///< Delay between SIGTERM and SIGKILL on timeout
+    std::function<void(OutputStream, const char*, size_t)> output_callback; ///< Optional per-chunk observer
+};
+
+/**
+ * @brief Result of running a child process
+ */
+struct ProcessResult {
+    int exit_code = -1;                             ///< Exit code, or -1 if the process did not exit normally
+    int term_signal = 0;                            ///< Signal that terminated the process (0 if none)
+    bool timed_out = false;                         ///< Whether the timeout fired and the group was killed
+    bool output_truncated = false;                  ///< Whether the capture limit dropped older output
+    std::string output;                             ///< Captured stdout (+stderr if merged), in arrival order
+    std::string error_output;                       ///< Captured stderr only
+    size_t total_output_bytes = 0;                  ///< Bytes produced by the child, including dropped ones
+    std::chrono::milliseconds duration{0};          ///< Wall-clock run time
+};
+
+/**
+ * @brief Fixed-capacity byte buffer that keeps the most recent data
+ *
+ * Build logs put the interesting errors at the end, so once the capacity
+ * is reached the oldest bytes are overwritten. Memory use is bounded by
+ * the capacity regardless of how much the child prints.
+ */
+class OutputRingBuffer {
+public:
+    explicit OutputRingBuffer(size_t capacity);
+
+    /**
+     * @brief Append bytes, overwriting the oldest data when full
+     */
+    void append(const char* data, size_t length);
+
+    /**
+     * @brief Get the buffered bytes in order, oldest first
+     */
+    std::string str() const;
+
+    /**
+     * @brief Whether any data has been overwritten
+     */
+    bool wrapped() const { return m_dropped > 0; }
+
+    size_t size() const { return m_size; }
+    size_t dropped() const { return m_dropped; }
+
+private:
+    std::vector<char> m_buffer;
+    size_t m_capacity;
+    size_t m_start = 0;
+    size_t m_size = 0;
+    size_t m_dropped = 0;
+};
+
+/**
+ * @brief Runs external commands without going through a shell
+ *
+ * On POSIX systems the child is started with posix_spawnp() in its own
+ * process group. Its stdout and stderr are separate non-blocking pipes
+ * that are multiplexed with poll(), so output can be streamed to the
+ * terminal while it is captured, and a timeout can kill the whole group
+ * (including grandchildren such as compiler processes spawned by make).
+ */
+class ProcessRunner {
+public:
+    /**
+     * @brief Run a command and wait for it to finish
+     * @param command Executable name (looked up in PATH) or path
+     * @param args Arguments, passed verbatim without shell interpretation
+     * @param options Run options
+     * @return Process result. Throws std::runtime_error if the process cannot be started.
+     */
+    static ProcessResult run(const std::string& command,
+                             const std::vector<std::string>& args,
+                             const ProcessOptions& options = ProcessOptions());
+
+    /**
+     * @brief Split a configured command line into executable and arguments
+     *
+     * Whitespace separates arguments; single or double quotes group words.
+     * A value quoted as a whole (as YAML config scalars often are) is
+     * unwrapped first.
+     * @param command_line Command line such as "cmake --build './my build'"
+     * @return Tokens, the first being the executable. Empty if none.
+     */
+    static std::vector<std::string> splitCommandLine(const std::string& command_line);
+
+    /**
+     * @brief Whether a configured command line uses shell syntax
+     *
+     * True for operators and redirects (&&, |, ;, >), globs, variable or
+     * command substitution, and leading VAR=value assignments.
+     */
+    static bool needsShell(const std::string& command_line);
+
+    /**
+     * @brief Turn a configured command line into the argv to run
+     *
+     * Plain commands are split with splitCommandLine() and started
+     * directly. Commands that need a shell become /bin/sh -c with the line
+     * as the script; extra arguments then reach it as "$@", appended to
+     * the end of the line.
+     * @param command_line Command line from the configuration
+     * @param extra_args Arguments to append, passed without interpretation
+     * @return Tokens, the first being the executable. Empty if none.
+     */
+    static std::vector<std::string> commandArgv(const std::string& command_line,
+                                                const std::vector<std::string>& extra_args = {});
+};
+
+} // namespace Camus
@@ -8,11 +8,36 @@
 #include <string>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 #include <filesystem>
+#include <cstdint>
 #include "IgnorePattern.hpp"
 
 namespace Camus {
 
+/**
+ * @brief Size and modification time of a scanned file
+ */
+struct FileStamp {
+    uintmax_t size = 0;             ///< File size in bytes
+    int64_t modified = 0;           ///< Last write time in filesystem clock ticks
+
+    bool operator==(const FileStamp& other) const {
+        return size == other.size && modified == other.modified;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Result of a scan compared with a previous one
+ */
+struct ScanDelta {
+    std::vector<std::string> files;                         ///< Every file found, sorted
+    std::vector<std::string> changed;                       ///< New or modified since the previous scan
+    std::vector<std::string> removed;                       ///< Known before but no longer found
+    std::unordered_map<std::string, FileStamp> stamps;      ///< Stamp of every file found
+};
+
 /**
  * @brief Scans project directories to discover relevant source files
  * 
@@ -34,6 +59,17 @@ public:
      */
     std::vector<std::string> scanFiles();
 
+    /**
+     * @brief Scan the project and report what changed since a previous scan
+     *
+     * A file counts as changed when its size or modification time differs
+     * from the known stamp, so callers that keep derived data per file (such
+     * as an embedding index) only reprocess those files.
+     * @param known Stamps from the previous scan (ScanDelta::stamps)
+     * @return Current files and the difference from known
+     */
+    ScanDelta scanChanges(const std::unordered_map<std::string, FileStamp>& known);
+
     /**
      * @brief Add a custom ignore pattern
      * @param pattern Gitignore-style pattern to ignore
@@ -0,0 +1,97 @@
+// =================================================================
+// include/Camus/PromptLookupDrafter.hpp
+// =================================================================
+// Draft-free speculative decoding: proposes continuations by matching the
+// most recent tokens against the prompt.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Camus {
+
+/**
+ * @brief Prompt-lookup settings
+ */
+struct PromptLookupConfig {
+    bool enabled = true;            ///< Propose drafts at all
+    size_t max_ngram = 3;           ///< Longest suffix of the output matched against the prompt
+    size_t min_ngram = 2;           ///< Shortest suffix worth matching
+    size_t max_draft = 16;          ///< Tokens proposed per verification batch
+};
+
+/**
+ * @brief Acceptance counters
+ */
+struct SpeculativeStats {
+    size_t draft_rounds = 0;        ///< Verification batches that carried a draft
+    size_t drafted_tokens = 0;      ///< Tokens proposed
+    size_t accepted_tokens = 0;     ///< Proposed tokens the model agreed with
+
+    double acceptanceRate() const {
+        return drafted_tokens > 0 ? static_cast<double>(accepted_tokens) / static_cast<double>(drafted_tokens) : 0.0;
+    }
+
+    SpeculativeStats& operator+=(const SpeculativeStats& other) {
+        draft_rounds += other.draft_rounds;
+        drafted_tokens += other.drafted_tokens;
+        accepted_tokens += other.accepted_tokens;
+        return *this;
+    }
+};
+
+/**
+ * @brief Proposes draft tokens copied from the prompt
+ *
+ * When a model rewrites a file it mostly reproduces text that is already in
+ * the prompt. After each generated token the drafter looks for the last
+ * max_ngram..min_ngram output tokens in the prompt and proposes the tokens
+ * that followed them there. The caller decodes the draft in one batch and
+ * keeps the prefix the model itself would have sampled, so output is
+ * unchanged and every accepted token saves a forward pass.
+ *
+ * While a copy run keeps being accepted the drafter continues from where
+ * the previous draft ended instead of searching again; otherwise it takes
+ * the most recent occurrence in the prompt.
+ */
+class PromptLookupDrafter {
+public:
+    /**
+     * @param source Prompt tokens to copy from; must outlive the drafter
+     * @param config Lookup settings
+     */
+    PromptLookupDrafter(const std::vector<int32_t>& source, const PromptLookupConfig& config = PromptLookupConfig());
+
+    /**
+     * @brief Propose a continuation of history
+     * @param history Prompt and generated tokens so far
+     * @param max_tokens Upper bound on the draft length (room left in the context or output budget)
+     * @return Draft tokens; empty if nothing matched
+     */
+    std::vector<int32_t> propose(const std::vector<int32_t>& history, size_t max_tokens);
+
+    /**
+     * @brief Report how much of the last proposal the model accepted
+     * @param accepted Leading draft tokens that matched the model's own choice
+     */
+    void accept(size_t accepted);
+
+    const SpeculativeStats& getStats() const { return m_stats; }
+
+private:
+    const std::vector<int32_t>& m_source;
+    PromptLookupConfig m_config;
+    SpeculativeStats m_stats;
+    size_t m_draft_start = 0;       ///< Source index of the last proposal
+    size_t m_draft_length = 0;      ///< Length of the last proposal
+    size_t m_continue_at = 0;       ///< Source index to continue from; 0 when there is no run to follow
+
+    /**
+     * @brief Whether source[end - n, end) equals the last n tokens of history
+     */
+    bool suffixMatches(const std::vector<int32_t>& history, size_t end, size_t n) const;
+};
+
+} // namespace Camus
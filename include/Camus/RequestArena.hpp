@@ -0,0 +1,80 @@
+// =================================================================
+// include/Camus/RequestArena.hpp
+// =================================================================
+// Per-request monotonic arena for short-lived pipeline state.
+
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <cstddef>
+
+namespace Camus {
+
+/**
+ * @brief Monotonic arena that backs the containers of one pipeline request
+ *
+ * Steps, debug entries, classification scores and selection alternatives
+ * are allocated by bumping a pointer inside one upstream block and are
+ * released all at once when the last owner drops the arena, instead of
+ * going through the global allocator node by node.
+ */
+class RequestArena {
+public:
+    static constexpr size_t DEFAULT_INITIAL_SIZE = 8192;
+
+    /**
+     * @brief Create an arena
+     * @param initial_size Size of the first upstream block; the arena grows
+     *        geometrically if a request outgrows it
+     */
+    explicit RequestArena(size_t initial_size = DEFAULT_INITIAL_SIZE);
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    /**
+     * @brief Memory resource to construct pmr containers with
+     */
+    std::pmr::memory_resource* resource() { return &m_resource; }
+
+    size_t getInitialSize() const { return m_initial_size; }
+
+private:
+    size_t m_initial_size;
+    std::pmr::monotonic_buffer_resource m_resource;
+};
+
+/**
+ * @brief Keeps a struct's arena alive with the same rules pmr containers use
+ *
+ * Declare it before the pmr members it backs. Moving a struct moves the
+ * containers together with their allocator, so the handle follows. Copies
+ * allocate from the default resource and assignments keep the target's
+ * resource, so in both cases the handle stays as it was and an arena is
+ * never released while containers still point into it.
+ */
+class ArenaHandle {
+public:
+    ArenaHandle() = default;
+    explicit ArenaHandle(std::shared_ptr<RequestArena> arena) : m_arena(std::move(arena)) {}
+
+    ArenaHandle(const ArenaHandle&) {}
+    ArenaHandle(ArenaHandle&&) noexcept = default;
+    ArenaHandle& operator=(const ArenaHandle&) { return *this; }
+    ArenaHandle& operator=(ArenaHandle&&) noexcept { return *this; }
+
+    /**
+     * @brief Resource for the owning struct's containers (default heap without an arena)
+     */
+    std::pmr::memory_resource* resource() const {
+        return m_arena ? m_arena->resource() : std::pmr::get_default_resource();
+    }
+
+    const std::shared_ptr<RequestArena>& get() const { return m_arena; }
+
+private:
+    std::shared_ptr<RequestArena> m_arena;
+};
+
+} // namespace Camus
@@ -0,0 +1,122 @@
+// =================================================================
+// include/Camus/RequestCoalescer.hpp
+// =================================================================
+// Single-flight deduplication of identical concurrent generations.
+
+#pragma once
+
+#include "Camus/LlmInteraction.hpp"
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+
+namespace Camus {
+
+/**
+ * @brief Coalescing counters
+ */
+struct CoalescingStats {
+    size_t executed = 0;                    ///< Generations actually run by a backend
+    size_t coalesced = 0;                   ///< Requests served by attaching to one in flight
+    size_t bypassed = 0;                    ///< Non-deterministic requests passed straight through
+};
+
+/**
+ * @brief Attaches identical concurrent requests to one in-flight generation
+ *
+ * Strategies and batches often send the same templated prompt to the same
+ * model at the same time. The response cache only helps once the first
+ * finishes; until then every copy runs a full generation. Requests are
+ * keyed by model, prompt and sampling parameters: the first becomes the
+ * leader and runs, later ones wait for it, receive the text streamed so
+ * far, then the rest as it is generated.
+ *
+ * Only deterministic (greedy, temperature <= 0) requests are coalesced.
+ * Sampled requests are expected to differ, so they always run on their own.
+ */
+class RequestCoalescer {
+public:
+    RequestCoalescer() = default;
+
+    RequestCoalescer(const RequestCoalescer&) = delete;
+    RequestCoalescer& operator=(const RequestCoalescer&) = delete;
+
+    /**
+     * @brief Process-wide instance shared by the orchestrator and strategies
+     */
+    static RequestCoalescer& getInstance();
+
+    /**
+     * @brief Whether a request's output is fully determined by its inputs
+     */
+    static bool isDeterministic(const InferenceRequest& request);
+
+    /**
+     * @brief Build the key identifying equivalent requests
+     * @param model_id Model the request runs on
+     * @param request Inference request
+     */
+    static std::string makeKey(const std::string& model_id, const InferenceRequest& request);
+
+    /**
+     * @brief Run a request, sharing the generation with identical ones in flight
+     * @param model_id Model identifier used for keying
+     * @param model Backend that runs the generation if no identical request is in flight
+     * @param request Inference request; its on_token sees the full output either way
+     * @return The response; metadata["coalesced"] is "true" for attached requests
+     * @throws Whatever the backend threw, for the leader and every attached request
+     */
+    InferenceResponse execute(const std::string& model_id, LlmInteraction& model,
+                              const InferenceRequest& request);
+
+    /**
+     * @brief Backend call run by the leader (or by an uncoalesced request)
+     */
+    using BackendCall = std::function<InferenceResponse(const InferenceRequest&)>;
+
+    /**
+     * @brief Run a request through a caller-supplied backend call
+     *
+     * Only the request that actually generates invokes @p backend, so a
+     * concurrency limit applied inside it is never held by attached requests.
+     *
+     * @param model_id Model identifier used for keying
+     * @param request Inference request; its on_token sees the full output either way
+     * @param backend Performs the generation
+     */
+    InferenceResponse execute(const std::string& model_id, const InferenceRequest& request,
+                              const BackendCall& backend);
+
+    /**
+     * @brief Number of generations currently in flight
+     */
+    size_t getInFlightCount() const;
+
+    CoalescingStats getStats() const;
+
+private:
+    struct Flight {
+        std::string prompt;
+        std::vector<int64_t> context_tokens;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::string text;                   ///< Output streamed so far
+        std::vector<TokenCallback> subscribers;
+        bool done = false;
+        InferenceResponse response;
+        std::exception_ptr error;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> m_flights;
+    CoalescingStats m_stats;
+
+    InferenceResponse follow(Flight& flight, const InferenceRequest& request);
+};
+
+} // namespace Camus
@@ -0,0 +1,162 @@
+// =================================================================
+// include/Camus/ResourceMonitor.hpp
+// =================================================================
+// Samples host and cgroup resource usage and gates work on it.
+
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+namespace Camus {
+
+/**
+ * @brief Pressure stall information (PSI) for one resource
+ */
+struct PressureStall {
+    double some_avg10 = 0.0;                ///< % of time at least one task stalled (10s window)
+    double full_avg10 = 0.0;                ///< % of time all tasks stalled (10s window)
+};
+
+/**
+ * @brief One sample of system resource usage
+ *
+ * When the process runs in a cgroup v2 with limits, CPU and memory are
+ * reported against the cgroup's limits rather than the whole machine.
+ */
+struct SystemResourceSnapshot {
+    double cpu_usage_percent = 0.0;         ///< Busy share of available CPU capacity
+    double cpu_limit_cores = 0.0;           ///< CPUs available (cgroup quota or online CPUs)
+    double memory_usage_percent = 0.0;      ///< Used share of the memory limit
+    uint64_t memory_used_bytes = 0;         ///< Working set (cgroup) or MemTotal - MemAvailable
+    uint64_t memory_limit_bytes = 0;        ///< cgroup memory.max or MemTotal
+    PressureStall cpu_pressure;             ///< CPU pressure
+    PressureStall memory_pressure;          ///< Memory pressure
+    PressureStall io_pressure;              ///< IO pressure
+    bool cgroup_limited = false;            ///< Whether cgroup limits were applied
+    bool pressure_available = false;        ///< Whether PSI files could be read
+    std::chrono::steady_clock::time_point timestamp; ///< When the sample was taken
+};
+
+/**
+ * @brief Resource monitor configuration
+ */
+struct ResourceMonitorConfig {
+    std::chrono::milliseconds sample_interval{250}; ///< Background sampling period
+    std::string proc_root = "/proc";                ///< procfs mount
+    std::string cgroup_root = "/sys/fs/cgroup";     ///< cgroup v2 mount
+    std::string cgroup_path;                        ///< Own cgroup below cgroup_root (empty = from /proc/self/cgroup)
+};
+
+/**
+ * @brief Reads /proc, cgroup v2 and PSI files and admits work against them
+ *
+ * A background thread samples a handful of small files each interval and
+ * publishes a snapshot. Callers that need capacity block in waitUntil(),
+ * which re-evaluates their admission predicate after every sample and
+ * whenever notifyWaiters() reports that work finished, instead of
+ * sleep-polling. One shared instance serves every strategy and the load
+ * balancer so the files are read once per interval per process.
+ */
+class ResourceMonitor {
+public:
+    using AdmissionPredicate = std::function<bool(const SystemResourceSnapshot&)>;
+
+    /**
+     * @brief Construct a monitor; sampling starts with start()
+     * @param config Monitor configuration
+     */
+    explicit ResourceMonitor(const ResourceMonitorConfig& config = ResourceMonitorConfig());
+
+    ~ResourceMonitor();
+
+    ResourceMonitor(const ResourceMonitor&) = delete;
+    ResourceMonitor& operator=(const ResourceMonitor&) = delete;
+
+    /**
+     * @brief Process-wide monitor, sampling in the background
+     */
+    static ResourceMonitor& getInstance();
+
+    /**
+     * @brief Start background sampling (takes one sample synchronously)
+     */
+    void start();
+
+    /**
+     * @brief Stop background sampling and wake all waiters
+     */
+    void stop();
+
+    /**
+     * @brief Whether the background sampler is running
+     */
+    bool isRunning() const { return m_running.load(); }
+
+    /**
+     * @brief Take a sample now and publish it
+     * @return The new snapshot
+     */
+    SystemResourceSnapshot sample();
+
+    /**
+     * @brief Latest published snapshot
+     */
+    SystemResourceSnapshot getSnapshot() const;
+
+    /**
+     * @brief Block until the predicate admits work or the timeout expires
+     *
+     * The predicate runs with the monitor's lock held and receives the
+     * latest snapshot; it must not call back into the monitor.
+     * @param admit Admission predicate
+     * @param timeout Maximum time to wait
+     * @return true if admitted, false on timeout
+     */
+    bool waitUntil(const AdmissionPredicate& admit, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Re-evaluate waiting predicates (call after releasing capacity)
+     */
+    void notifyWaiters();
+
+private:
+    ResourceMonitorConfig m_config;
+    std::string m_cgroup_dir;               ///< Resolved cgroup directory, empty if none
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    SystemResourceSnapshot m_snapshot;
+    std::mutex m_sample_mutex;              ///< Serializes sample() and its rate counters
+
+    std::thread m_sampler;
+    std::atomic<bool> m_running{false};
+    std::mutex m_sampler_mutex;
+    std::condition_variable m_sampler_cv;
+
+    // Counters from the previous sample, for rate calculations
+    uint64_t m_prev_cpu_busy = 0;
+    uint64_t m_prev_cpu_total = 0;
+    uint64_t m_prev_cgroup_usage_usec = 0;
+    std::chrono::steady_clock::time_point m_prev_sample_time;
+    bool m_has_prev_sample = false;
+
+    void samplerLoop();
+
+    /**
+     * @brief Locate this process's cgroup v2 directory
+     */
+    std::string resolveCgroupDir() const;
+
+    void readCpu(SystemResourceSnapshot& snapshot, std::chrono::steady_clock::time_point now);
+    void readMemory(SystemResourceSnapshot& snapshot) const;
+    void readPressure(SystemResourceSnapshot& snapshot) const;
+};
+
+} // namespace Camus
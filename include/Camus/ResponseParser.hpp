@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "Camus/SourceMinifier.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -36,10 +37,15 @@ struct ParseStats {
     size_t new_files_created;      ///< Number of new files to be created
     size_t existing_files_modified; ///< Number of existing files to be modified
     size_t parsing_errors;         ///< Number of parsing errors encountered
+    size_t edit_blocks_applied;    ///< EDIT blocks whose hunks all applied
+    size_t fuzzy_hunks;            ///< Hunks placed by whitespace-insensitive or similarity matching
+    size_t minified_restored;      ///< Files edited in minified form and mapped back to the originals
+    std::vector<std::string> changed_since_sent; ///< Minified files rejected because they changed on disk
     std::vector<std::string> error_messages; ///< Detailed error messages
     
     ParseStats() : total_files_found(0), valid_files_parsed(0), new_files_created(0), 
-                   existing_files_modified(0), parsing_errors(0) {}
+                   existing_files_modified(0), parsing_errors(0), edit_blocks_applied(0),
+                   fuzzy_hunks(0), minified_restored(0) {}
 };
 
 /**
@@ -47,6 +53,9 @@ struct ParseStats {
  * 
  * The ResponseParser handles the complex task of extracting file modifications
  * from LLM responses that follow the expected format with file markers.
+ * "--- FILE: path ---" blocks carry complete content; "--- EDIT: path ---"
+ * blocks carry hunks that EditApplier applies to the file on disk, so both
+ * produce the same FileModification with the full new content.
  */
 class ResponseParser {
 public:
@@ -93,6 +102,29 @@ public:
      */
     void setStrictValidation(bool strict_validation);
 
+    /**
+     * @brief Declare that responses were produced under FileBlockFormat constraints
+     *
+     * Block extraction then becomes a single linear scan for exact marker
+     * lines, and the refusal heuristics, which would reject code that merely
+     * mentions "Error:", are skipped. A response that does not start with a
+     * marker still goes through the heuristic parser.
+     * @param constrained True if the backend enforced the format
+     */
+    void setConstrainedFormat(bool constrained);
+
+    /**
+     * @brief Declare which files the prompt showed minified
+     *
+     * FILE blocks for these paths are taken as new versions of the minified
+     * text and EDIT hunks are applied to it; SourceMinifier::restore() then
+     * carries the change over to the file on disk. A file that changed
+     * since it was minified is rejected rather than guessed at and listed
+     * in ParseStats::changed_since_sent.
+     * @param sources ContextBuilder::getMinifiedFiles() of the prompt's build
+     */
+    void setMinifiedSources(const std::unordered_map<std::string, MinifiedSource>& sources);
+
     /**
      * @brief Validate entire response before parsing individual files
      * @param llm_response Raw LLM response
@@ -114,13 +146,48 @@ private:
     size_t m_max_file_size;
     std::unordered_set<std::string> m_allowed_extensions;
     bool m_strict_validation;
+    bool m_constrained_format;
+    std::unordered_map<std::string, MinifiedSource> m_minified_sources;
 
     /**
      * @brief Extract file markers and content from response
      * @param response LLM response text
+     * @param edit_blocks Receives the bodies of EDIT blocks by path; may be nullptr
+     * @return Map of file paths to content
+     */
+    std::unordered_map<std::string, std::string> extractFileBlocks(
+        const std::string& response,
+        std::unordered_map<std::string, std::string>* edit_blocks = nullptr);
+
+    /**
+     * @brief Apply EDIT blocks to the files on disk
+     * @param edit_blocks Hunk text by path
+     * @param file_blocks Receives the resulting complete content by path
+     */
+    void applyEditBlocks(const std::unordered_map<std::string, std::string>& edit_blocks,
+                         std::unordered_map<std::string, std::string>& file_blocks);
+
+    /**
+     * @brief Map content written against a minified file back onto the original
+     * @param file_path Normalized path
+     * @param content Response content; replaced by the restored file on success
+     * @return False (with an error recorded) if the file changed since it was minified
+     */
+    bool restoreMinified(const std::string& file_path, std::string& content);
+
+    /**
+     * @brief Read a project file
+     * @param file_path Relative file path
+     * @return Content, or an empty string if the file cannot be read
+     */
+    std::string readProjectFile(const std::string& file_path) const;
+
+    /**
+     * @brief Split a well-formed constrained response on its marker lines
+     * @param response Response that starts with a marker line
      * @return Map of file paths to content
      */
-    std::unordered_map<std::string, std::string> extractFileBlocks(const std::string& response);
+    std::unordered_map<std::string, std::string> extractConstrainedBlocks(const std::string& response) const;
 
     /**
      * @brief Validate a file path for safety and correctness
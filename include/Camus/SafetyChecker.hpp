@@ -156,10 +156,12 @@ private:
 
     /**
      * @brief Execute system command and get output
-     * @param command Command to execute
-     * @return Pair of output and exit code
+     * @param command Executable to run
+     * @param args Arguments passed to the executable
+     * @return Pair of stdout and exit code
      */
-    std::pair<std::string, int> executeCommand(const std::string& command);
+    std::pair<std::string, int> executeCommand(const std::string& command,
+                                               const std::vector<std::string>& args);
 
     /**
      * @brief Check if path is writable
@@ -9,6 +9,7 @@
 #include "Camus/TaskClassifier.hpp"
 #include "Camus/ModelCapabilities.hpp"
 #include "Camus/LlmInteraction.hpp"
+#include "Camus/CompiledTemplate.hpp"
 #include <string>
 #include <memory>
 #include <vector>
@@ -373,10 +374,12 @@ private:
     SequentialStatistics m_statistics;
     
     std::unordered_map<std::string, CachedResult> m_cache;
+    std::unordered_map<std::string, std::shared_ptr<const CompiledTemplate>> m_compiled_templates;
     
     mutable std::mutex m_stats_mutex;
     mutable std::mutex m_config_mutex;
     mutable std::mutex m_cache_mutex;
+    mutable std::mutex m_template_mutex;
     
     /**
      * @brief Initialize default pattern templates
@@ -413,6 +416,13 @@ private:
     std::string applyTemplate(const std::string& template_str, 
                              const std::unordered_map<std::string, std::string>& variables);
     
+    /**
+     * @brief Get the compiled form of a template, compiling it on first use
+     * @param template_str Template string
+     * @return Compiled template shared by all steps using the same text
+     */
+    std::shared_ptr<const CompiledTemplate> getCompiledTemplate(const std::string& template_str);
+    
     /**
      * @brief Calculate overall pipeline quality
      * @param state Pipeline state
@@ -9,6 +9,7 @@
 #include "Camus/TaskClassifier.hpp"
 #include "Camus/ModelCapabilities.hpp"
 #include "Camus/LlmInteraction.hpp"
+#include "Camus/CompiledTemplate.hpp"
 #include <string>
 #include <memory>
 #include <vector>
@@ -48,6 +49,8 @@ struct StrategyResponse {
     std::string model_used;                       ///< Model that generated response
     std::string optimized_prompt;                 ///< Optimized prompt used
     double quality_score = 0.0;                   ///< Response quality score (0-1)
+    double confidence_score = 0.0;                ///< Geometric-mean token probability (0 when the backend reports no logprobs)
+    double perplexity = 0.0;                      ///< exp(-mean token logprob); 0 when unknown
     std::chrono::milliseconds execution_time{0}; ///< Model execution time
     std::chrono::milliseconds optimization_time{0}; ///< Prompt optimization time
     std::chrono::milliseconds validation_time{0}; ///< Response validation time
@@ -73,6 +76,19 @@ struct PromptTemplate {
     int max_tokens_adjustment = 0;                ///< Max tokens adjustment
 };
 
+/**
+ * @brief PromptTemplate with its formats compiled once for rendering
+ */
+struct CompiledPromptTemplate {
+    std::string template_name;                    ///< Template identifier
+    std::string system_prefix;                    ///< System prompt plus separator (empty if none)
+    CompiledTemplate user_format;                 ///< Compiled user_prompt_format ({prompt})
+    CompiledTemplate context_format;              ///< Compiled context_format ({context})
+    
+    CompiledPromptTemplate() = default;
+    explicit CompiledPromptTemplate(const PromptTemplate& source);
+};
+
 /**
  * @brief Context window management configuration
  */
@@ -115,6 +131,7 @@ struct SingleModelStrategyConfig {
     std::unordered_map<TaskType, PromptTemplate> task_templates;     ///< Task-specific templates
     
     double min_quality_threshold = 0.3;          ///< Minimum acceptable quality
+    double token_confidence_weight = 0.5;        ///< Share of the quality score taken from token log-probabilities, when reported
     size_t max_optimization_attempts = 3;        ///< Maximum optimization retries
     std::chrono::milliseconds optimization_timeout{5000}; ///< Optimization timeout
 };
@@ -250,11 +267,13 @@ protected:
      * @param request Original request
      * @param response Generated response
      * @param model_metadata Model metadata
+     * @param token_confidence Geometric-mean token probability, or a negative value if unknown
      * @return Quality score (0-1)
      */
     virtual double validateResponse(const StrategyRequest& request,
                                    const std::string& response,
-                                   const ModelMetadata& model_metadata);
+                                   const ModelMetadata& model_metadata,
+                                   double token_confidence = -1.0);
     
     /**
      * @brief Apply model-specific optimizations
@@ -298,8 +317,9 @@ private:
     SingleModelStrategyConfig m_config;
     SingleModelStatistics m_statistics;
     
-    std::unordered_map<std::string, PromptTemplate> m_model_templates;
-    std::unordered_map<TaskType, PromptTemplate> m_task_templates;
+    std::unordered_map<std::string, CompiledPromptTemplate> m_model_templates;
+    std::unordered_map<TaskType, CompiledPromptTemplate> m_task_templates;
+    CompiledPromptTemplate m_default_template;
     std::function<double(const std::string&, const std::string&)> m_quality_scorer;
     
     mutable std::mutex m_stats_mutex;
@@ -319,10 +339,10 @@ private:
      * @brief Get prompt template for model and task
      * @param model_metadata Model metadata
      * @param task_type Task type
-     * @return Prompt template
+     * @return Compiled prompt template
      */
-    PromptTemplate getPromptTemplate(const ModelMetadata& model_metadata, 
-                                    TaskType task_type);
+    const CompiledPromptTemplate& getPromptTemplate(const ModelMetadata& model_metadata, 
+                                                    TaskType task_type);
     
     /**
      * @brief Apply prompt template formatting
@@ -331,7 +351,7 @@ private:
      * @param context Additional context
      * @return Formatted prompt
      */
-    std::string applyPromptTemplate(const PromptTemplate& template_obj,
+    std::string applyPromptTemplate(const CompiledPromptTemplate& template_obj,
                                    const std::string& prompt,
                                    const std::string& context);
     
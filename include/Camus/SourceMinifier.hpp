@@ -0,0 +1,66 @@
+// =================================================================
+// include/Camus/SourceMinifier.hpp
+// =================================================================
+// Token-saving rewrite of source files for prompts, with the line map
+// needed to carry edits of the rewritten text back to the real file.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Camus {
+
+/**
+ * @brief A file as sent to the model, and where its lines came from
+ */
+struct MinifiedSource {
+    std::string content;                ///< Minified text
+    std::vector<size_t> line_map;       ///< Original line (1-based) of each minified line
+    std::string indent_unit;            ///< Original indentation one leading space stands for; empty if unchanged
+    bool crlf = false;                  ///< Original lines end in "\r\n"
+    size_t original_tokens = 0;         ///< Tokens of the file before minification
+    size_t minified_tokens = 0;         ///< Tokens of content
+};
+
+/**
+ * @brief Removes what a model does not need from source files
+ *
+ * Minification only drops information that carries no meaning for the
+ * code: a leading license header, divider comments such as banner rules,
+ * comment lines that merely repeat the file's path, empty comment lines,
+ * trailing whitespace and runs of blank lines. In languages where
+ * indentation is not significant, each level of indentation becomes a
+ * single space. Other comments and all code are kept as written.
+ *
+ * Edits the model makes to the minified text are mapped back with
+ * restore(): unchanged lines come from the original file verbatim, so
+ * dropped comments and the original formatting survive.
+ */
+class SourceMinifier {
+public:
+    /**
+     * @brief Minify a file; the language is taken from its extension
+     * @param file_path Path relative to the project root
+     * @param content File content
+     * @return Minified content and line map; token counts are left at zero
+     */
+    static MinifiedSource minify(const std::string& file_path, const std::string& content);
+
+    /**
+     * @brief Apply the changes made to a minified file to the original
+     *
+     * Lines the edit kept are copied from the original, lines it added are
+     * re-indented to the original's indentation, and lines dropped by
+     * minification stay where they were unless the edit replaced the lines
+     * around them.
+     * @param original Content minify() was given
+     * @param minified Result of minify()
+     * @param edited New version of minified.content
+     * @return New content of the original file
+     */
+    static std::string restore(const std::string& original, const MinifiedSource& minified,
+                               const std::string& edited);
+};
+
+} // namespace Camus
@@ -0,0 +1,80 @@
+// =================================================================
+// include/Camus/StringInterner.hpp
+// =================================================================
+// Dense integer ids for model and instance names.
+
+#pragma once
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <cstdint>
+#include <limits>
+
+namespace Camus {
+
+/**
+ * @brief Dense identifier handed out by a StringInterner
+ */
+using InternedId = uint32_t;
+
+/**
+ * @brief Marker for "no id assigned"
+ */
+constexpr InternedId INVALID_INTERNED_ID = std::numeric_limits<InternedId>::max();
+
+/**
+ * @brief Maps names to dense ids, assigned in first-seen order
+ *
+ * Names are interned once (registry load, instance creation) and the hot
+ * path then carries ids, indexes flat arrays with them, and compares
+ * integers instead of hashing strings. Ids are never reused, so they stay
+ * valid for the life of the process.
+ */
+class StringInterner {
+public:
+    StringInterner() = default;
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /**
+     * @brief Interner for model names
+     */
+    static StringInterner& models();
+
+    /**
+     * @brief Interner for load balancer instance ids
+     */
+    static StringInterner& instances();
+
+    /**
+     * @brief Get the id of a name, assigning the next id if it is new
+     */
+    InternedId intern(const std::string& name);
+
+    /**
+     * @brief Get the id of a name without assigning one
+     * @return Id, or INVALID_INTERNED_ID if the name was never interned
+     */
+    InternedId find(const std::string& name) const;
+
+    /**
+     * @brief Name for an id
+     * @return Stable reference; empty string for unknown ids
+     */
+    const std::string& name(InternedId id) const;
+
+    /**
+     * @brief Number of ids assigned so far (every id is below this)
+     */
+    size_t size() const;
+
+private:
+    mutable std::shared_mutex m_mutex;
+    std::deque<std::string> m_names;    // deque keeps references stable as it grows
+    std::unordered_map<std::string, InternedId> m_ids;
+};
+
+} // namespace Camus
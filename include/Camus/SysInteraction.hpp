@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "Camus/ProcessRunner.hpp"
 #include <string>
 #include <vector>
 #include <utility> // For std::pair
@@ -49,9 +50,19 @@ public:
      * @brief Executes an external command and captures its output.
      * @param command The command to execute.
      * @param args A vector of arguments for the command.
-     * @return A pair containing the stdout and the exit code.
+     * @return A pair containing the combined stdout/stderr and the exit code.
      */
     std::pair<std::string, int> executeCommand(const std::string& command, const std::vector<std::string>& args);
+
+    /**
+     * @brief Runs an external command with streaming, capture and timeout options.
+     * @param command The command to execute.
+     * @param args A vector of arguments for the command.
+     * @param options Process run options (tee, capture limit, timeout).
+     * @return The full process result. Throws std::runtime_error if the command cannot be started.
+     */
+    ProcessResult runCommand(const std::string& command, const std::vector<std::string>& args,
+                             const ProcessOptions& options);
 };
 
 } // namespace Camus
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <memory_resource>
 #include <regex>
 #include <chrono>
 
@@ -29,16 +30,26 @@ enum class TaskType {
 
 /**
  * @brief Classification result with confidence metrics
+ *
+ * The containers use the resource given at construction (a request arena
+ * in the orchestrator), which must outlive the result. Copies allocate
+ * from the default resource.
  */
 struct ClassificationResult {
     TaskType primary_type;              ///< Most likely task type
     double confidence;                  ///< Confidence score (0.0 to 1.0)
-    std::vector<TaskType> alternatives; ///< Alternative classifications
-    std::unordered_map<std::string, double> keyword_scores; ///< Keyword analysis scores
+    std::pmr::vector<TaskType> alternatives; ///< Alternative classifications
+    std::pmr::unordered_map<std::pmr::string, double> keyword_scores; ///< Keyword analysis scores
     long classification_time_ms;        ///< Time taken for classification
     
     ClassificationResult() 
         : primary_type(TaskType::UNKNOWN), confidence(0.0), classification_time_ms(0) {}
+
+    explicit ClassificationResult(std::pmr::memory_resource* resource)
+        : primary_type(TaskType::UNKNOWN), confidence(0.0),
+          alternatives(resource ? resource : std::pmr::get_default_resource()),
+          keyword_scores(resource ? resource : std::pmr::get_default_resource()),
+          classification_time_ms(0) {}
 };
 
 /**
@@ -74,21 +85,25 @@ public:
      * @brief Classify a user prompt to determine task type
      * @param prompt User's natural language request
      * @param context Optional context information (file contents, etc.)
+     * @param resource Memory resource for the result's containers (nullptr = default heap)
      * @return Classification result with confidence metrics
      */
     ClassificationResult classify(const std::string& prompt, 
-                                 const std::string& context = "");
+                                 const std::string& context = "",
+                                 std::pmr::memory_resource* resource = nullptr);
 
     /**
      * @brief Classify with additional file context
      * @param prompt User's natural language request
      * @param file_paths List of files being modified
      * @param file_extensions File extensions for context
+     * @param resource Memory resource for the result's containers (nullptr = default heap)
      * @return Classification result with enhanced context analysis
      */
     ClassificationResult classifyWithContext(const std::string& prompt,
                                             const std::vector<std::string>& file_paths,
-                                            const std::vector<std::string>& file_extensions = {});
+                                            const std::vector<std::string>& file_extensions = {},
+                                            std::pmr::memory_resource* resource = nullptr);
 
     /**
      * @brief Update classification configuration
@@ -187,11 +202,13 @@ private:
      * @param keyword_scores Keyword analysis results
      * @param pattern_scores Pattern analysis results
      * @param context_scores Context analysis results
+     * @param resource Memory resource for the result's containers
      * @return Combined classification result
      */
     ClassificationResult combineAnalysis(const std::unordered_map<TaskType, double>& keyword_scores,
                                         const std::unordered_map<TaskType, double>& pattern_scores,
-                                        const std::unordered_map<TaskType, double>& context_scores);
+                                        const std::unordered_map<TaskType, double>& context_scores,
+                                        std::pmr::memory_resource* resource = nullptr);
 
     /**
      * @brief Normalize text for analysis (lowercase, remove punctuation, etc.)
@@ -0,0 +1,192 @@
+// =================================================================
+// src/Camus/AdaptiveConcurrencyLimiter.cpp
+// =================================================================
+// Implementation of the gradient/AIMD per-backend concurrency limiter.
+
+#include "Camus/AdaptiveConcurrencyLimiter.hpp"
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+
+namespace Camus {
+
+namespace {
+
+struct LimiterRegistry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<AdaptiveConcurrencyLimiter>> limiters;
+};
+
+LimiterRegistry& registry() {
+    static LimiterRegistry instance;
+    return instance;
+}
+
+} // anonymous namespace
+
+AdaptiveConcurrencyLimiter::Permit&
+AdaptiveConcurrencyLimiter::Permit::operator=(Permit&& other) noexcept {
+    if (this != &other) {
+        release(Outcome::IGNORED);
+        m_limiter = other.m_limiter;
+        m_in_flight = other.m_in_flight;
+        m_start = other.m_start;
+        other.m_limiter = nullptr;
+    }
+    return *this;
+}
+
+void AdaptiveConcurrencyLimiter::Permit::release(Outcome outcome) {
+    if (!m_limiter) {
+        return;
+    }
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - m_start);
+    AdaptiveConcurrencyLimiter* limiter = m_limiter;
+    m_limiter = nullptr;
+    limiter->release(latency, m_in_flight, outcome);
+}
+
+AdaptiveConcurrencyLimiter::AdaptiveConcurrencyLimiter(const AdaptiveLimiterConfig& config)
+    : m_config(config) {
+    m_config.min_limit = std::max(1.0, m_config.min_limit);
+    m_config.max_limit = std::max(m_config.min_limit, m_config.max_limit);
+    m_config.long_window = std::max<size_t>(1, m_config.long_window);
+    m_limit = std::clamp(m_config.initial_limit, m_config.min_limit, m_config.max_limit);
+}
+
+AdaptiveConcurrencyLimiter& AdaptiveConcurrencyLimiter::forBackend(const std::string& backend_key) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto& limiter = reg.limiters[backend_key];
+    if (!limiter) {
+        limiter = std::make_unique<AdaptiveConcurrencyLimiter>();
+    }
+    return *limiter;
+}
+
+void AdaptiveConcurrencyLimiter::configureBackend(const std::string& backend_key,
+                                                  const AdaptiveLimiterConfig& config) {
+    AdaptiveConcurrencyLimiter& limiter = forBackend(backend_key);
+    AdaptiveConcurrencyLimiter fresh(config);
+    {
+        // Permits already handed out stay valid; only the tuning changes
+        std::lock_guard<std::mutex> lock(limiter.m_mutex);
+        limiter.m_config = fresh.m_config;
+        limiter.m_limit = fresh.m_limit;
+        limiter.m_long_rtt_us = 0.0;
+        limiter.m_short_rtt_us = 0.0;
+        limiter.m_samples = 0;
+    }
+    limiter.m_available.notify_all();
+}
+
+AdaptiveConcurrencyLimiter::Permit AdaptiveConcurrencyLimiter::acquire(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_in_flight >= effectiveLimit()) {
+        if (m_config.max_queue > 0 && m_queued >= m_config.max_queue) {
+            m_rejections++;
+            return Permit();
+        }
+        m_queued++;
+        bool admitted = m_available.wait_for(lock, timeout, [this] {
+            return m_in_flight < effectiveLimit();
+        });
+        m_queued--;
+        if (!admitted) {
+            m_rejections++;
+            return Permit();
+        }
+    }
+
+    m_in_flight++;
+    return Permit(this, m_in_flight);
+}
+
+void AdaptiveConcurrencyLimiter::release(std::chrono::microseconds latency, size_t in_flight,
+                                         Permit::Outcome outcome) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_in_flight--;
+        if (outcome != Permit::Outcome::IGNORED) {
+            updateLimit(latency, in_flight, outcome == Permit::Outcome::DROPPED);
+        }
+    }
+    // The limit may have grown by more than the one slot just freed
+    m_available.notify_all();
+}
+
+void AdaptiveConcurrencyLimiter::recordSample(std::chrono::microseconds latency, size_t in_flight,
+                                              bool dropped) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        updateLimit(latency, in_flight, dropped);
+    }
+    m_available.notify_all();
+}
+
+void AdaptiveConcurrencyLimiter::updateLimit(std::chrono::microseconds latency, size_t in_flight,
+                                             bool dropped) {
+    if (dropped) {
+        m_drops++;
+        m_limit = std::max(m_config.min_limit, m_limit * m_config.backoff_ratio);
+        return;
+    }
+
+    m_successes++;
+    double rtt = std::max(1.0, static_cast<double>(latency.count()));
+    m_short_rtt_us = rtt;
+
+    if (m_samples == 0) {
+        m_long_rtt_us = rtt;
+    } else {
+        double window = static_cast<double>(std::min(m_samples + 1, m_config.long_window));
+        m_long_rtt_us += (rtt - m_long_rtt_us) / window;
+    }
+    m_samples++;
+
+    // After a stretch of overload the baseline itself is inflated; let it
+    // drift back down faster so the limit can recover
+    if (m_long_rtt_us / m_short_rtt_us > 2.0) {
+        m_long_rtt_us *= 0.95;
+    }
+
+    double gradient = std::clamp(m_config.rtt_tolerance * m_long_rtt_us / m_short_rtt_us, 0.5, 1.0);
+    double queue_allowance = std::sqrt(m_limit);
+    double estimate = m_limit * gradient + queue_allowance;
+
+    // A sample taken at low utilisation does not show whether more
+    // concurrency would help
+    if (static_cast<double>(in_flight) < m_limit / 2.0) {
+        estimate = std::min(estimate, m_limit);
+    }
+
+    double smoothed = m_limit * (1.0 - m_config.smoothing) + estimate * m_config.smoothing;
+    m_limit = std::clamp(smoothed, m_config.min_limit, m_config.max_limit);
+}
+
+size_t AdaptiveConcurrencyLimiter::effectiveLimit() const {
+    return std::max<size_t>(1, static_cast<size_t>(m_limit));
+}
+
+size_t AdaptiveConcurrencyLimiter::getLimit() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return effectiveLimit();
+}
+
+AdaptiveLimiterStats AdaptiveConcurrencyLimiter::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AdaptiveLimiterStats stats;
+    stats.limit = effectiveLimit();
+    stats.in_flight = m_in_flight;
+    stats.queued = m_queued;
+    stats.successes = m_successes;
+    stats.drops = m_drops;
+    stats.rejections = m_rejections;
+    stats.short_rtt_ms = m_short_rtt_us / 1000.0;
+    stats.long_rtt_ms = m_long_rtt_us / 1000.0;
+    return stats;
+}
+
+} // namespace Camus
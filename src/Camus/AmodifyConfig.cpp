@@ -9,6 +9,7 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <utility>
 
 namespace Camus {
 
@@ -56,6 +57,115 @@ void AmodifyConfig::loadFromConfig(const ConfigParser& config) {
         git_check = (git_check_str == "true" || git_check_str == "1");
     }
     
+    std::string edit_format_str = config.getStringValue("amodify.edit_format");
+    if (!edit_format_str.empty()) {
+        edit_format = edit_format_str;
+    }
+    
+    std::string constrained_output_str = config.getStringValue("amodify.constrained_output");
+    if (!constrained_output_str.empty()) {
+        constrained_output = (constrained_output_str == "true" || constrained_output_str == "1");
+    }
+    
+    std::string max_output_tokens_str = config.getStringValue("amodify.max_output_tokens");
+    if (!max_output_tokens_str.empty()) {
+        try {
+            max_output_tokens = std::stoul(max_output_tokens_str);
+        } catch (...) {
+            std::cerr << "[WARN] Invalid amodify.max_output_tokens value, using default" << std::endl;
+        }
+    }
+    
+    std::string execution_mode_str = config.getStringValue("amodify.execution_mode");
+    if (!execution_mode_str.empty()) {
+        execution_mode = execution_mode_str;
+    }
+    
+    const std::pair<const char*, size_t*> fanout_limits[] = {
+        {"amodify.fanout_files_per_task", &fanout_files_per_task},
+        {"amodify.fanout_task_tokens", &fanout_task_tokens},
+        {"amodify.fanout_concurrency", &fanout_concurrency},
+        {"amodify.fanout_timeout_seconds", &fanout_timeout_seconds},
+    };
+    for (const auto& limit : fanout_limits) {
+        std::string value = config.getStringValue(limit.first);
+        if (!value.empty()) {
+            try {
+                *limit.second = std::stoul(value);
+            } catch (...) {
+                std::cerr << "[WARN] Invalid " << limit.first << " value, using default" << std::endl;
+            }
+        }
+    }
+    
+    std::string fanout_models_str = config.getStringValue("amodify.fanout_models");
+    if (!fanout_models_str.empty()) {
+        fanout_models = fanout_models_str;
+    }
+    
+    std::string retrieval_str = config.getStringValue("amodify.retrieval");
+    if (!retrieval_str.empty()) {
+        retrieval = (retrieval_str == "true" || retrieval_str == "1");
+    }
+    
+    std::string embedding_model_str = config.getStringValue("amodify.embedding_model_path");
+    if (!embedding_model_str.empty()) {
+        embedding_model_path = embedding_model_str;
+    }
+    
+    std::string index_dir_str = config.getStringValue("amodify.retrieval_index_dir");
+    if (!index_dir_str.empty()) {
+        retrieval_index_dir = index_dir_str;
+    }
+    
+    const std::pair<const char*, size_t*> retrieval_limits[] = {
+        {"amodify.retrieval_top_k", &retrieval_top_k},
+        {"amodify.retrieval_max_files", &retrieval_max_files},
+    };
+    for (const auto& limit : retrieval_limits) {
+        std::string value = config.getStringValue(limit.first);
+        if (!value.empty()) {
+            try {
+                *limit.second = std::stoul(value);
+            } catch (...) {
+                std::cerr << "[WARN] Invalid " << limit.first << " value, using default" << std::endl;
+            }
+        }
+    }
+    
+    std::string deduplicate_str = config.getStringValue("amodify.deduplicate_files");
+    if (!deduplicate_str.empty()) {
+        deduplicate_files = (deduplicate_str == "true" || deduplicate_str == "1");
+    }
+    
+    std::string minify_str = config.getStringValue("amodify.minify_context");
+    if (!minify_str.empty()) {
+        minify_context = (minify_str == "true" || minify_str == "1");
+    }
+    
+    std::string session_str = config.getStringValue("amodify.context_session");
+    if (!session_str.empty()) {
+        context_session = (session_str == "true" || session_str == "1");
+    }
+    
+    std::string session_ttl_str = config.getStringValue("amodify.session_ttl_minutes");
+    if (!session_ttl_str.empty()) {
+        try {
+            session_ttl_minutes = std::stoul(session_ttl_str);
+        } catch (...) {
+            std::cerr << "[WARN] Invalid amodify.session_ttl_minutes value, using default" << std::endl;
+        }
+    }
+    
+    std::string near_duplicate_str = config.getStringValue("amodify.near_duplicate_threshold");
+    if (!near_duplicate_str.empty()) {
+        try {
+            near_duplicate_threshold = std::stod(near_duplicate_str);
+        } catch (...) {
+            std::cerr << "[WARN] Invalid amodify.near_duplicate_threshold value, using default" << std::endl;
+        }
+    }
+    
     // For arrays, we'll need to parse them manually from the config
     // Since the current ConfigParser doesn't support arrays, we'll use defaults
     // In a full implementation, we'd enhance ConfigParser to support YAML arrays
@@ -80,6 +190,15 @@ void AmodifyConfig::applyCommandOverrides(const Commands& commands) {
         max_tokens = commands.max_tokens;
     }
     
+    if (commands.amodify_fanout) {
+        execution_mode = "fanout";
+    }
+    
+    if (!commands.embedding_model_path.empty()) {
+        retrieval = true;
+        embedding_model_path = commands.embedding_model_path;
+    }
+    
     // Note: include_pattern and exclude_pattern from commands would need
     // special handling to merge with configured patterns
 }
@@ -128,11 +247,41 @@ bool AmodifyConfig::validate() const {
         valid = false;
     }
     
+    if (max_output_tokens == 0 || max_output_tokens >= max_tokens) {
+        std::cerr << "[ERROR] max_output_tokens must be greater than 0 and less than max_tokens" << std::endl;
+        valid = false;
+    }
+    
     if (backup_dir.empty()) {
         std::cerr << "[ERROR] backup_dir cannot be empty" << std::endl;
         valid = false;
     }
     
+    if (execution_mode != "single" && execution_mode != "fanout") {
+        std::cerr << "[ERROR] execution_mode must be 'single' or 'fanout'" << std::endl;
+        valid = false;
+    }
+    
+    if (execution_mode == "fanout" && (fanout_task_tokens < 1000 || fanout_concurrency == 0)) {
+        std::cerr << "[ERROR] fanout_task_tokens must be at least 1000 and fanout_concurrency greater than 0" << std::endl;
+        valid = false;
+    }
+    
+    if (retrieval && (embedding_model_path.empty() || retrieval_top_k == 0)) {
+        std::cerr << "[ERROR] retrieval needs embedding_model_path and a retrieval_top_k greater than 0" << std::endl;
+        valid = false;
+    }
+    
+    if (near_duplicate_threshold < 0.0 || near_duplicate_threshold > 1.0) {
+        std::cerr << "[ERROR] near_duplicate_threshold must be between 0 and 1" << std::endl;
+        valid = false;
+    }
+    
+    if (context_session && session_ttl_minutes == 0) {
+        std::cerr << "[ERROR] session_ttl_minutes must be greater than 0" << std::endl;
+        valid = false;
+    }
+    
     if (max_modification_size == 0) {
         std::cerr << "[ERROR] max_modification_size must be greater than 0" << std::endl;
         valid = false;
@@ -0,0 +1,117 @@
+// =================================================================
+// src/Camus/AmodifyFanout.cpp
+// =================================================================
+// Implementation of amodify fan-out planning and merging.
+
+#include "Camus/AmodifyFanout.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+
+namespace Camus {
+
+std::string AmodifyFanout::clusterKey(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find('.', 1); // Keep dotfiles such as ".env" whole
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+std::vector<EditTask> AmodifyFanout::planTasks(const std::vector<std::pair<std::string, size_t>>& files,
+                                               size_t max_files_per_task, size_t max_task_tokens) {
+    // Clusters in order of their first (most relevant) file
+    std::vector<std::vector<const std::pair<std::string, size_t>*>> clusters;
+    std::unordered_map<std::string, size_t> cluster_index;
+    for (const auto& file : files) {
+        auto inserted = cluster_index.emplace(clusterKey(file.first), clusters.size());
+        if (inserted.second) {
+            clusters.emplace_back();
+        }
+        clusters[inserted.first->second].push_back(&file);
+    }
+
+    std::vector<EditTask> tasks;
+    EditTask current;
+    auto flush = [&]() {
+        if (!current.files.empty()) {
+            current.task_id = "task-" + std::to_string(tasks.size() + 1);
+            tasks.push_back(std::move(current));
+            current = EditTask();
+        }
+    };
+
+    for (const auto& cluster : clusters) {
+        size_t cluster_tokens = 0;
+        for (const auto* file : cluster) {
+            cluster_tokens += file->second;
+        }
+        bool too_many_files = max_files_per_task > 0 &&
+                              current.files.size() + cluster.size() > max_files_per_task;
+        bool too_many_tokens = max_task_tokens > 0 &&
+                               current.estimated_tokens + cluster_tokens > max_task_tokens;
+        if (too_many_files || too_many_tokens) {
+            flush();
+        }
+        for (const auto* file : cluster) {
+            current.files.push_back(file->first);
+        }
+        current.estimated_tokens += cluster_tokens;
+    }
+    flush();
+
+    return tasks;
+}
+
+std::vector<FileModification> AmodifyFanout::mergeResults(
+    const std::vector<EditTask>& tasks,
+    const std::vector<std::vector<FileModification>>& task_modifications,
+    std::vector<std::string>& conflicts,
+    const std::string& root_path) {
+
+    std::unordered_map<std::string, size_t> owner;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        for (const auto& file : tasks[i].files) {
+            owner.emplace(file, i);
+        }
+    }
+
+    std::vector<FileModification> merged;
+    std::unordered_map<std::string, size_t> created_by; // New file -> task that created it
+    for (size_t i = 0; i < task_modifications.size() && i < tasks.size(); ++i) {
+        std::unordered_set<std::string> seen_in_task;
+        for (const auto& modification : task_modifications[i]) {
+            const std::string& path = modification.file_path;
+            if (!seen_in_task.insert(path).second) {
+                conflicts.push_back(tasks[i].task_id + " returned " + path + " twice; kept the first");
+                continue;
+            }
+
+            auto owner_it = owner.find(path);
+            if (owner_it != owner.end()) {
+                if (owner_it->second != i) {
+                    conflicts.push_back(tasks[i].task_id + " changed " + path + ", which belongs to " +
+                                        tasks[owner_it->second].task_id + "; ignored");
+                    continue;
+                }
+            } else {
+                std::error_code ec;
+                if (!modification.is_new_file || std::filesystem::exists(std::filesystem::path(root_path) / path, ec)) {
+                    conflicts.push_back(tasks[i].task_id + " changed " + path +
+                                        ", which no task was given to edit; ignored");
+                    continue;
+                }
+                auto created = created_by.emplace(path, i);
+                if (!created.second) {
+                    conflicts.push_back(tasks[i].task_id + " also created " + path + "; kept the version from " +
+                                        tasks[created.first->second].task_id);
+                    continue;
+                }
+            }
+            merged.push_back(modification);
+        }
+    }
+
+    return merged;
+}
+
+} // namespace Camus
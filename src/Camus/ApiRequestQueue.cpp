@@ -0,0 +1,200 @@
+// =================================================================
+// src/Camus/ApiRequestQueue.cpp
+// =================================================================
+// Implementation of the HTTP API request queue.
+
+#include "Camus/ApiRequestQueue.hpp"
+#include <algorithm>
+
+namespace Camus {
+
+// =================================================================
+// ApiJob
+// =================================================================
+
+ApiJob::ApiJob(PipelineRequest request, std::string client_id)
+    : m_request(std::move(request)), m_client_id(std::move(client_id)) {
+}
+
+ChunkStatus ApiJob::nextChunk(std::string& text, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait_for(lock, timeout, [this]() { return !m_pending.empty() || m_done; });
+
+    if (!m_pending.empty()) {
+        text.swap(m_pending);
+        m_pending.clear();
+        return ChunkStatus::DATA;
+    }
+    return m_done ? ChunkStatus::FINISHED : ChunkStatus::TIMEOUT;
+}
+
+bool ApiJob::waitUntilDone(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_cv.wait_for(lock, timeout, [this]() { return m_done; });
+}
+
+PipelineResponse ApiJob::getResponse() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_response;
+}
+
+void ApiJob::cancel() {
+    m_cancelled = true;
+}
+
+void ApiJob::publish(const std::string& text) {
+    if (text.empty() || m_cancelled) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending += text;
+        m_streamed = true;
+    }
+    m_cv.notify_all();
+}
+
+void ApiJob::complete(PipelineResponse response) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_streamed && response.success) {
+            m_pending += response.response_text;
+        }
+        m_response = std::move(response);
+        m_done = true;
+    }
+    m_cv.notify_all();
+}
+
+// =================================================================
+// ApiRequestQueue
+// =================================================================
+
+ApiRequestQueue::ApiRequestQueue(Executor executor, const ApiQueueConfig& config)
+    : m_executor(std::move(executor)), m_config(config) {
+    size_t workers = std::max<size_t>(m_config.worker_threads, 1);
+    m_workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        m_workers.emplace_back(&ApiRequestQueue::workerLoop, this);
+    }
+}
+
+ApiRequestQueue::~ApiRequestQueue() {
+    shutdown();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+AdmissionResult ApiRequestQueue::submit(const std::shared_ptr<ApiJob>& job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shutting_down) {
+            return AdmissionResult::SHUTTING_DOWN;
+        }
+        if (m_queue.size() >= m_config.max_queue_size) {
+            m_stats.rejected_queue_full++;
+            return AdmissionResult::QUEUE_FULL;
+        }
+        size_t& load = m_client_load[job->getClientId()];
+        if (m_config.max_requests_per_client > 0 && load >= m_config.max_requests_per_client) {
+            m_stats.rejected_client_limit++;
+            return AdmissionResult::CLIENT_LIMIT;
+        }
+
+        load++;
+        job->m_enqueued_at = std::chrono::steady_clock::now();
+        m_queue.push_back(job);
+        m_stats.queued = m_queue.size();
+    }
+    m_cv.notify_one();
+    return AdmissionResult::ACCEPTED;
+}
+
+void ApiRequestQueue::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutting_down = true;
+    }
+    m_cv.notify_all();
+}
+
+ApiQueueStats ApiRequestQueue::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+size_t ApiRequestQueue::getClientLoad(const std::string& client_id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_client_load.find(client_id);
+    return it == m_client_load.end() ? 0 : it->second;
+}
+
+void ApiRequestQueue::workerLoop() {
+    while (true) {
+        std::shared_ptr<ApiJob> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_shutting_down || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;  // Shutting down and drained
+            }
+            job = m_queue.front();
+            m_queue.pop_front();
+            m_stats.queued = m_queue.size();
+
+            if (job->isCancelled()) {
+                m_stats.cancelled++;
+            } else {
+                m_stats.running++;
+            }
+        }
+
+        if (job->isCancelled()) {
+            PipelineResponse response;
+            response.request_id = job->getRequest().request_id;
+            response.error_message = "Request cancelled before execution";
+            job->complete(std::move(response));
+            releaseClient(job->getClientId());
+            continue;
+        }
+
+        auto queue_wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - job->m_enqueued_at);
+        job->m_queue_wait = queue_wait;
+
+        PipelineRequest request = job->getRequest();
+        ApiJob* raw_job = job.get();
+        request.on_token = [raw_job](const std::string& text) { raw_job->publish(text); };
+
+        PipelineResponse response;
+        try {
+            response = m_executor(request);
+        } catch (const std::exception& e) {
+            response.request_id = request.request_id;
+            response.success = false;
+            response.error_message = e.what();
+        }
+        job->complete(std::move(response));
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.running--;
+            m_stats.completed++;
+            m_stats.total_queue_wait += queue_wait;
+        }
+        releaseClient(job->getClientId());
+    }
+}
+
+void ApiRequestQueue::releaseClient(const std::string& client_id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_client_load.find(client_id);
+    if (it != m_client_load.end() && --it->second == 0) {
+        m_client_load.erase(it);
+    }
+}
+
+} // namespace Camus
@@ -0,0 +1,434 @@
+// =================================================================
+// src/Camus/CamusDaemon.cpp
+// =================================================================
+// Implementation of the camus daemon.
+
+#include "Camus/CamusDaemon.hpp"
+#include "Camus/Core.hpp"
+#include "Camus/ModelRegistry.hpp"
+#include "Camus/FileBlockFormat.hpp"
+#include "nlohmann/json.hpp"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Camus {
+
+namespace {
+
+volatile std::sig_atomic_t g_stop_requested = 0;
+
+void handleStopSignal(int) {
+    g_stop_requested = 1;
+}
+
+// Generated text is not guaranteed to be valid UTF-8; never let that
+// abort a reply.
+std::string encode(const nlohmann::json& message) {
+    return message.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+std::string errorMessage(const std::string& text) {
+    return encode({{"type", "error"}, {"message", text}});
+}
+
+// Rebuilds the constraint a client asked for. The grammar and schema must
+// be the ones this build enforces, or the client would parse the output in
+// a format the backend never produced.
+ResponseConstraint readConstraint(const nlohmann::json& constraint) {
+    std::string kind = constraint.value("kind", "");
+    if (kind != FileBlockFormat::CONSTRAINT_NAME) {
+        throw std::runtime_error("Unknown response constraint: " + kind);
+    }
+    if (constraint.value("grammar", "") != FileBlockFormat::grammar() ||
+        constraint.value("schema", "") != FileBlockFormat::jsonSchema()) {
+        throw std::runtime_error("Response format differs from the daemon's; restart camus serve");
+    }
+    return ResponseConstraint::FILE_BLOCKS;
+}
+
+long processId() {
+#if defined(_WIN32)
+    return 0;
+#else
+    return static_cast<long>(getpid());
+#endif
+}
+
+} // anonymous namespace
+
+CamusDaemon::CamusDaemon(LlmInteraction& backend, const DaemonConfig& config)
+    : m_backend(backend), m_config(config) {
+}
+
+CamusDaemon::~CamusDaemon() {
+    stop();
+    reapSessions(true);
+    closeListener();
+}
+
+void CamusDaemon::start() {
+#if defined(_WIN32)
+    throw std::runtime_error("camus serve requires Unix domain sockets, which are not supported on this platform");
+#else
+    if (m_listen_fd >= 0) {
+        return;
+    }
+
+    const std::string& path = m_config.socket_path;
+    sockaddr_un address{};
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Invalid daemon socket path: " + path);
+    }
+
+    // Refuse to take over from a live daemon, but clean up after a dead one
+    int probe = connectDaemonSocket(path);
+    if (probe >= 0) {
+        close(probe);
+        throw std::runtime_error("A camus daemon is already listening on " + path);
+    }
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+
+    // The socket hands out model access; keep it private to the user. The
+    // umask makes bind() create it that way, so it is never reachable by
+    // others, even between bind() and chmod()
+    mode_t old_mask = umask(S_IRWXG | S_IRWXO);
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::string error = std::strerror(errno);
+        umask(old_mask);
+        throw std::runtime_error("Failed to create daemon socket: " + error);
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    int bound = bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    int bind_errno = errno;
+    umask(old_mask);
+    if (bound != 0 || listen(fd, static_cast<int>(m_config.max_clients)) != 0) {
+        std::string error = std::strerror(bound != 0 ? bind_errno : errno);
+        close(fd);
+        if (bound == 0) {
+            unlink(path.c_str());
+        }
+        throw std::runtime_error("Failed to listen on " + path + ": " + error);
+    }
+    if (chmod(path.c_str(), S_IRUSR | S_IWUSR) != 0) {
+        std::string error = std::strerror(errno);
+        close(fd);
+        unlink(path.c_str());
+        throw std::runtime_error("Failed to restrict access to " + path + ": " + error);
+    }
+
+    m_listen_fd = fd;
+    m_stop = false;
+    m_started = std::chrono::steady_clock::now();
+    m_metadata = m_backend.getModelMetadata();
+    m_model_id = m_backend.getModelId();
+#endif
+}
+
+int CamusDaemon::run() {
+#if defined(_WIN32)
+    start();
+    return 1;
+#else
+    start();
+
+    struct sigaction stop_action{};
+    stop_action.sa_handler = handleStopSignal;
+    sigemptyset(&stop_action.sa_mask);
+    struct sigaction ignore_action{};
+    ignore_action.sa_handler = SIG_IGN;
+    sigemptyset(&ignore_action.sa_mask);
+
+    struct sigaction old_int{}, old_term{}, old_pipe{};
+    g_stop_requested = 0;
+    sigaction(SIGINT, &stop_action, &old_int);
+    sigaction(SIGTERM, &stop_action, &old_term);
+    sigaction(SIGPIPE, &ignore_action, &old_pipe);
+
+    std::cout << "[INFO] camus daemon serving " << m_model_id
+              << " on " << m_config.socket_path << " (pid " << processId() << ")" << std::endl;
+
+    int wait_ms = static_cast<int>(std::max<long long>(m_config.poll_interval.count(), 10));
+    while (!m_stop && !g_stop_requested) {
+        pollfd listener{m_listen_fd, POLLIN, 0};
+        int ready = poll(&listener, 1, wait_ms);
+        reapSessions(false);
+        if (ready <= 0) {
+            continue;
+        }
+
+        int client_fd = accept(m_listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            continue;
+        }
+        fcntl(client_fd, F_SETFD, FD_CLOEXEC);
+        auto channel = std::make_shared<MessageChannel>(client_fd);
+
+        std::lock_guard<std::mutex> lock(m_sessions_mutex);
+        if (m_sessions.size() >= m_config.max_clients) {
+            channel->send(errorMessage("camus daemon is busy (" +
+                                       std::to_string(m_config.max_clients) + " clients connected)"));
+            continue;
+        }
+
+        m_connections++;
+        auto session = std::make_unique<ClientSession>();
+        session->channel = channel;
+        ClientSession* raw_session = session.get();
+        session->thread = std::thread([this, raw_session]() { serveClient(*raw_session); });
+        m_sessions.push_back(std::move(session));
+    }
+
+    closeListener();
+    reapSessions(true);
+
+    sigaction(SIGINT, &old_int, nullptr);
+    sigaction(SIGTERM, &old_term, nullptr);
+    sigaction(SIGPIPE, &old_pipe, nullptr);
+
+    std::cout << "[INFO] camus daemon stopped after " << m_completions.load()
+              << " completions" << std::endl;
+    return 0;
+#endif
+}
+
+void CamusDaemon::stop() {
+    m_stop = true;
+}
+
+DaemonStats CamusDaemon::getStats() const {
+    DaemonStats stats;
+    stats.connections = m_connections;
+    stats.requests = m_requests;
+    stats.completions = m_completions;
+    stats.tokens_generated = m_tokens_generated;
+    stats.errors = m_errors;
+    if (m_started != std::chrono::steady_clock::time_point()) {
+        stats.uptime = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - m_started);
+    }
+    return stats;
+}
+
+void CamusDaemon::serveClient(ClientSession& session) {
+    MessageChannel& channel = *session.channel;
+    std::string message;
+
+    while (!m_stop && channel.receive(message)) {
+        m_requests++;
+        std::string reply;
+        try {
+            reply = handleMessage(message, channel);
+        } catch (const std::exception& e) {
+            m_errors++;
+            reply = errorMessage(e.what());
+        }
+        if (!channel.send(reply)) {
+            break;
+        }
+    }
+
+    session.finished = true;
+}
+
+std::string CamusDaemon::handleMessage(const std::string& message, MessageChannel& channel) {
+    auto request = nlohmann::json::parse(message);
+    std::string type = request.value("type", "");
+
+    if (type == "hello") {
+        return encode({
+            {"type", "hello"},
+            {"version", DAEMON_PROTOCOL_VERSION},
+            {"pid", processId()},
+            {"model_id", m_model_id},
+            {"name", m_metadata.name},
+            {"description", m_metadata.description},
+            {"version_string", m_metadata.version},
+            {"provider", m_metadata.provider},
+            {"model_path", m_metadata.model_path},
+            {"max_context_tokens", m_metadata.performance.max_context_tokens},
+            {"max_output_tokens", m_metadata.performance.max_output_tokens}
+        });
+    }
+
+    if (type == "ping") {
+        return encode({{"type", "pong"}});
+    }
+
+    if (type == "status") {
+        DaemonStats stats = getStats();
+        size_t clients = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_sessions_mutex);
+            clients = m_sessions.size();
+        }
+        bool registry_loaded = false;
+        {
+            std::lock_guard<std::mutex> lock(m_registry_mutex);
+            registry_loaded = m_registry != nullptr;
+        }
+        return encode({
+            {"type", "status"},
+            {"pid", processId()},
+            {"model_id", m_model_id},
+            {"uptime_seconds", stats.uptime.count()},
+            {"clients", clients},
+            {"connections", stats.connections},
+            {"requests", stats.requests},
+            {"completions", stats.completions},
+            {"tokens_generated", stats.tokens_generated},
+            {"errors", stats.errors},
+            {"registry_loaded", registry_loaded}
+        });
+    }
+
+    if (type == "complete") {
+        InferenceRequest inference;
+        inference.prompt = request.value("prompt", "");
+        inference.max_tokens = request.value("max_tokens", inference.max_tokens);
+        inference.temperature = request.value("temperature", inference.temperature);
+        inference.top_p = request.value("top_p", inference.top_p);
+        inference.stop_sequences = request.value("stop", std::vector<std::string>());
+        inference.context_tokens = request.value("context", std::vector<int64_t>());
+        if (request.contains("constraint")) {
+            inference.constraint = readConstraint(request["constraint"]);
+        }
+        return handleCompletion(std::move(inference), request.value("stream", true), channel);
+    }
+
+    if (type == "model") {
+        return handleModelCommand(request.value("subcommand", ""), request.value("model", ""));
+    }
+
+    if (type == "shutdown") {
+        stop();
+        return encode({{"type", "result"}, {"output", "camus daemon shutting down"}, {"exit_code", 0}});
+    }
+
+    m_errors++;
+    return errorMessage("Unknown request type: " + type);
+}
+
+std::string CamusDaemon::handleCompletion(InferenceRequest request, bool stream, MessageChannel& channel) {
+    std::string pending;
+    bool client_connected = true;
+
+    if (stream) {
+        request.on_token = [&](const std::string& piece) {
+            if (!client_connected) {
+                return;
+            }
+            pending += piece;
+            size_t complete = completeUtf8Length(pending);
+            if (complete == 0) {
+                return;
+            }
+            client_connected = channel.send(encode({{"type", "token"}, {"text", pending.substr(0, complete)}}));
+            pending.erase(0, complete);
+        };
+    }
+
+    InferenceResponse response;
+    {
+        std::lock_guard<std::mutex> lock(m_backend_mutex);
+        response = m_backend.getCompletionWithMetadata(request);
+    }
+    if (!pending.empty() && client_connected) {
+        channel.send(encode({{"type", "token"}, {"text", pending}}));
+    }
+
+    m_completions++;
+    m_tokens_generated += response.tokens_generated;
+
+    return encode({
+        {"type", "done"},
+        {"text", response.text},
+        {"tokens_generated", response.tokens_generated},
+        {"response_time_ms", response.response_time.count()},
+        {"was_truncated", response.was_truncated},
+        {"finish_reason", response.finish_reason},
+        {"confidence_score", response.confidence_score},
+        {"token_logprobs", response.token_logprobs},
+        {"context", response.context_tokens},
+        {"metadata", response.metadata}
+    });
+}
+
+std::string CamusDaemon::handleModelCommand(const std::string& subcommand, const std::string& model_name) {
+    std::lock_guard<std::mutex> lock(m_registry_mutex);
+
+    // Loaded on first use, then kept: later requests skip discovery and loading
+    if (!m_registry) {
+        RegistryConfig registry_config;
+        registry_config.config_file_path = m_config.models_config_path;
+        registry_config.auto_discover = true;
+        registry_config.validate_on_load = true;
+        registry_config.enable_health_checks = true;
+        m_registry = std::make_unique<ModelRegistry>(registry_config);
+    }
+
+    std::ostringstream output;
+    int exit_code = Core::runModelCommand(*m_registry, subcommand, model_name, output);
+    return encode({{"type", "result"}, {"output", output.str()}, {"exit_code", exit_code}});
+}
+
+void CamusDaemon::reapSessions(bool wait_for_all) {
+    std::list<std::unique_ptr<ClientSession>> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_sessions_mutex);
+        for (auto it = m_sessions.begin(); it != m_sessions.end();) {
+            if (wait_for_all) {
+                // Wake threads blocked waiting for their client's next message
+                (*it)->channel->shutdown();
+            }
+            if (wait_for_all || (*it)->finished) {
+                finished.push_back(std::move(*it));
+                it = m_sessions.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& session : finished) {
+        if (session->thread.joinable()) {
+            session->thread.join();
+        }
+    }
+}
+
+void CamusDaemon::closeListener() {
+#if !defined(_WIN32)
+    if (m_listen_fd >= 0) {
+        close(m_listen_fd);
+        m_listen_fd = -1;
+        std::error_code ec;
+        std::filesystem::remove(m_config.socket_path, ec);
+    }
+#endif
+}
+
+} // namespace Camus
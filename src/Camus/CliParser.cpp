@@ -30,6 +30,8 @@ std::shared_ptr<CLI::App> CliParser::setupCli() {
     setupCommitCommand(*m_app);
     setupPushCommand(*m_app);
     setupModelCommand(*m_app);
+    setupServeCommand(*m_app);
+    setupServeApiCommand(*m_app);
 
     return m_app;
 }
@@ -50,7 +52,10 @@ void CliParser::setupModifyCommand(CLI::App& app) {
 
 void CliParser::setupAmodifyCommand(CLI::App& app) {
     auto* sub = app.add_subcommand("amodify", "Modifies multiple files across the project based on a high-level request.");
-    sub->add_option("prompt", m_commands.prompt, "The high-level request (e.g., 'add user authentication system').")->required();
+    sub->add_option("prompt", m_commands.prompt, "The high-level request (e.g., 'add user authentication system').");
+    sub->add_option("--batch", m_commands.batch_file, "File with one request per line, run against one shared project context")->check(CLI::ExistingFile);
+    sub->add_flag("--fanout", m_commands.amodify_fanout, "Edit each cluster of related files in its own request, run concurrently across the configured models");
+    sub->add_option("--embedding-model", m_commands.embedding_model_path, "Rank files by similarity to the request using this GGUF embedding model (enables retrieval)")->check(CLI::ExistingFile);
     sub->add_option("--max-files", m_commands.max_files, "Maximum number of files to include in context (default: 100)");
     sub->add_option("--max-tokens", m_commands.max_tokens, "Maximum tokens for LLM context (default: 128000)");
     sub->add_option("--include", m_commands.include_pattern, "Include only files matching this pattern (e.g., 'src/**/*.cpp')");
@@ -102,10 +107,31 @@ void CliParser::setupModelCommand(CLI::App& app) {
     auto* reload_cmd = model_cmd->add_subcommand("reload", "Reload model configuration from file");
     reload_cmd->callback([this]() { m_commands.model_subcommand = "reload"; });
     
+    // Unload subcommand
+    auto* unload_cmd = model_cmd->add_subcommand("unload", "Evict an Ollama model from the server's memory now");
+    unload_cmd->add_option("model", m_commands.model_name, "Model name to unload")->required();
+    unload_cmd->callback([this]() { m_commands.model_subcommand = "unload"; });
+    
     // Make model command trigger active_command
     model_cmd->callback([this]() { m_commands.active_command = "model"; });
 }
 
+void CliParser::setupServeCommand(CLI::App& app) {
+    auto* sub = app.add_subcommand("serve", "Runs a daemon that keeps the model loaded for other camus commands.");
+    sub->add_flag("--stop", m_commands.serve_stop, "Stop the running daemon");
+    sub->add_flag("--status", m_commands.serve_status, "Show the running daemon's status");
+}
+
+void CliParser::setupServeApiCommand(CLI::App& app) {
+    auto* sub = app.add_subcommand("serve-api", "Serves the configured models over an OpenAI-compatible HTTP API.");
+    sub->add_option("--host", m_commands.api_host, "Address to listen on (default: 127.0.0.1)");
+    sub->add_option("--port", m_commands.api_port, "Port to listen on (default: 8080)");
+    sub->add_option("--workers", m_commands.api_workers, "Requests executed concurrently (default: 2)");
+    sub->add_option("--queue", m_commands.api_queue, "Requests allowed to wait for a worker (default: 64)");
+    sub->add_option("--per-client", m_commands.api_per_client,
+                    "Concurrent requests per client, 0 = unlimited (default: 4)");
+}
+
 } // namespace Camus
 
 
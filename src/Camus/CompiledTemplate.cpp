@@ -0,0 +1,127 @@
+// =================================================================
+// src/Camus/CompiledTemplate.cpp
+// =================================================================
+// Implementation of compiled prompt templates.
+
+#include "Camus/CompiledTemplate.hpp"
+#include <cctype>
+
+namespace Camus {
+
+namespace {
+
+bool isNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+} // anonymous namespace
+
+CompiledTemplate::CompiledTemplate(const std::string& source, PlaceholderSyntax syntax) {
+    const size_t braces = syntax == PlaceholderSyntax::TRIPLE_BRACE ? 3 : 1;
+    const std::string open(braces, '{');
+    const std::string close(braces, '}');
+
+    size_t literal_start = 0;
+    size_t pos = source.find(open);
+    while (pos != std::string::npos) {
+        size_t name_start = pos + braces;
+        size_t name_end = name_start;
+        while (name_end < source.size() && isNameChar(source[name_end])) {
+            ++name_end;
+        }
+
+        if (name_end > name_start && source.compare(name_end, braces, close) == 0) {
+            addLiteral(source, literal_start, pos);
+            Segment slot;
+            slot.is_variable = true;
+            slot.text = source.substr(name_start, name_end - name_start);
+            if (syntax == PlaceholderSyntax::SINGLE_BRACE) {
+                slot.fallback = source.substr(pos, name_end + braces - pos);
+            }
+            m_segments.push_back(std::move(slot));
+            m_variable_count++;
+
+            literal_start = name_end + braces;
+            pos = source.find(open, literal_start);
+        } else {
+            // Not a placeholder; keep scanning after this brace
+            pos = source.find(open, pos + 1);
+        }
+    }
+    addLiteral(source, literal_start, source.size());
+}
+
+void CompiledTemplate::addLiteral(const std::string& source, size_t begin, size_t end) {
+    if (end <= begin) {
+        return;
+    }
+    // Merge with a preceding literal so rendering touches fewer segments
+    if (!m_segments.empty() && !m_segments.back().is_variable) {
+        Segment& last = m_segments.back();
+        m_static_tokens -= last.token_estimate;
+        last.text.append(source, begin, end - begin);
+        last.token_estimate = estimateTokenCount(last.text.size());
+        m_static_tokens += last.token_estimate;
+    } else {
+        Segment literal;
+        literal.text = source.substr(begin, end - begin);
+        literal.token_estimate = estimateTokenCount(literal.text.size());
+        m_static_tokens += literal.token_estimate;
+        m_segments.push_back(std::move(literal));
+    }
+    m_static_length += end - begin;
+}
+
+size_t CompiledTemplate::renderedLength(const Resolver& resolve) const {
+    size_t length = m_static_length;
+    if (m_variable_count > 0) {
+        for (const auto& segment : m_segments) {
+            if (segment.is_variable) {
+                const std::string* value = resolve(segment.text);
+                length += value ? value->size() : segment.fallback.size();
+            }
+        }
+    }
+    return length;
+}
+
+size_t CompiledTemplate::estimateTokens(const Resolver& resolve) const {
+    size_t tokens = m_static_tokens;
+    if (m_variable_count > 0) {
+        for (const auto& segment : m_segments) {
+            if (segment.is_variable) {
+                const std::string* value = resolve(segment.text);
+                tokens += estimateTokenCount(value ? value->size() : segment.fallback.size());
+            }
+        }
+    }
+    return tokens;
+}
+
+void CompiledTemplate::appendTo(std::string& out, const Resolver& resolve) const {
+    for (const auto& segment : m_segments) {
+        if (!segment.is_variable) {
+            out += segment.text;
+        } else if (const std::string* value = resolve(segment.text)) {
+            out += *value;
+        } else {
+            out += segment.fallback;
+        }
+    }
+}
+
+std::string CompiledTemplate::render(const Resolver& resolve) const {
+    std::string out;
+    out.reserve(renderedLength(resolve));
+    appendTo(out, resolve);
+    return out;
+}
+
+std::string CompiledTemplate::render(const std::unordered_map<std::string, std::string>& variables) const {
+    return render([&variables](const std::string& name) -> const std::string* {
+        auto it = variables.find(name);
+        return it == variables.end() ? nullptr : &it->second;
+    });
+}
+
+} // namespace Camus
@@ -4,41 +4,41 @@
 // Implementation for the simple YAML configuration parser.
 
 #include "Camus/ConfigParser.hpp"
-#include <fstream>
+#include <yaml-cpp/yaml.h>
 #include <iostream>
 
 namespace Camus {
 
-// Helper function to trim whitespace from both ends of a string.
-static std::string trim(const std::string& s) {
-    size_t first = s.find_first_not_of(" \t\n\r");
-    if (std::string::npos == first) {
-        return s;
+// Record every scalar under its dotted path; lists are not flattened.
+static void flatten(const YAML::Node& node, const std::string& prefix,
+                    std::map<std::string, std::string>& values) {
+    for (const auto& entry : node) {
+        std::string key = prefix + entry.first.as<std::string>();
+        const YAML::Node& value = entry.second;
+        if (value.IsMap()) {
+            flatten(value, key + ".", values);
+        } else if (value.IsScalar()) {
+            values[key] = value.as<std::string>();
+        } else if (value.IsNull()) {
+            values[key] = "";
+        }
     }
-    size_t last = s.find_last_not_of(" \t\n\r");
-    return s.substr(first, (last - first + 1));
 }
 
 ConfigParser::ConfigParser(const std::string& config_path) {
-    std::ifstream config_file(config_path);
-    if (!config_file.is_open()) {
+    YAML::Node root;
+    try {
+        root = YAML::LoadFile(config_path);
+    } catch (const YAML::BadFile&) {
         // It's okay if the file doesn't exist, e.g., before `init` is run.
         return;
+    } catch (const YAML::Exception& e) {
+        std::cerr << "[WARN] Ignoring malformed configuration " << config_path << ": " << e.what() << std::endl;
+        return;
     }
 
-    std::string line;
-    while (std::getline(config_file, line)) {
-        // Ignore comments and empty lines
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
-
-        size_t delimiter_pos = line.find(':');
-        if (delimiter_pos != std::string::npos) {
-            std::string key = line.substr(0, delimiter_pos);
-            std::string value = line.substr(delimiter_pos + 1);
-            m_config_values[trim(key)] = trim(value);
-        }
+    if (root.IsMap()) {
+        flatten(root, "", m_config_values);
     }
 }
 
@@ -50,4 +50,69 @@ std::string ConfigParser::getStringValue(const std::string& key) const {
     return ""; // Return empty string if key not found
 }
 
+const std::string& ConfigParser::defaultConfig() {
+    static const std::string content = R"(# Camus Configuration v1.0
+# Backend configuration: 'direct' for llama.cpp or 'ollama' for Ollama server
+backend: direct
+
+# Direct backend settings (when backend: direct)
+model_path: /path/to/your/models/
+default_model: Llama-3-8B-Instruct.Q4_K_M.gguf
+
+# Ollama backend settings (when backend: ollama)
+ollama_url: http://localhost:11434
+
+# Build and test commands
+build_command: 'cmake --build ./build'
+test_command: 'ctest --test-dir ./build'
+build_timeout: 0  # Seconds before the build is killed (0 = no limit)
+test_timeout: 0   # Seconds before the tests are killed (0 = no limit)
+prefetch_model: false  # Warm the model file in the page cache while build/test run
+
+# Project scanning settings for 'amodify' command
+amodify:
+  max_files: 100
+  max_tokens: 128000
+  include_extensions:
+    - '.cpp'
+    - '.hpp'
+    - '.h'
+    - '.c'
+    - '.py'
+    - '.js'
+    - '.ts'
+  default_ignore_patterns:
+    - '.git/'
+    - 'build/'
+    - 'node_modules/'
+    - '__pycache__/'
+    - '*.o'
+    - '*.pyc'
+  create_backups: true
+  backup_dir: '.camus/backups'
+  interactive_threshold: 5  # Use interactive mode for >5 files
+  git_check: true          # Check for clean git working directory
+  constrained_output: false  # Force the FILE block format with a grammar (llama.cpp) or JSON schema (Ollama)
+  max_output_tokens: 8000    # Tokens one answer may generate; reserved out of max_tokens
+  edit_format: auto          # whole_file, search_replace, or auto (per-model edit_format attribute)
+  execution_mode: single     # single, or fanout: one concurrent request per cluster of related files
+  fanout_files_per_task: 4
+  fanout_task_tokens: 32000
+  fanout_concurrency: 4
+  fanout_timeout_seconds: 600  # Per-task generation limit
+  fanout_models: ''          # Comma-separated models.yml names (empty = all)
+  retrieval: false           # Rank files by embedding similarity (needs embedding_model_path)
+  embedding_model_path: ''   # Small GGUF embedding model, e.g. bge-small-en-v1.5.Q8_0.gguf
+  retrieval_index_dir: '.camus/embeddings'
+  retrieval_top_k: 40        # Chunks retrieved per request
+  retrieval_max_files: 0     # Send only the best-ranked files (0 = rank all)
+  deduplicate_files: true    # Send identical files once, listing their other paths
+  near_duplicate_threshold: 0  # Send files this similar (e.g. 0.8) as a diff against their twin (0 = off)
+  minify_context: false      # Drop license headers, banner comments and extra whitespace from the prompt
+  context_session: false     # Follow-up requests send only files changed since the last answer
+  session_ttl_minutes: 60    # Start a new session after this long without requests
+)";
+    return content;
+}
+
 } // namespace Camus
@@ -4,6 +4,7 @@
 // Implementation for building large context prompts with smart truncation.
 
 #include "Camus/ContextBuilder.hpp"
+#include "Camus/DiffGenerator.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -11,6 +12,9 @@
 #include <chrono>
 #include <iomanip>
 #include <unordered_set>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
 
 namespace Camus {
 
@@ -35,62 +39,35 @@ std::string ContextBuilder::buildContext(const std::vector<std::string>& file_pa
     // Load and prioritize files
     auto file_infos = loadFileInfo(file_paths, root_path);
     auto prioritized_files = prioritizeFiles(std::move(file_infos));
+    minifyFiles(prioritized_files);
+    std::unordered_map<std::string, uint64_t> hashes;
+    for (const auto& file : prioritized_files) {
+        hashes[file.relative_path] = std::hash<std::string>{}(file.content);
+    }
+    if (m_deduplicate) {
+        deduplicateFiles(prioritized_files);
+    }
     
     // Build system prompt
     std::string system_prompt = buildSystemPrompt();
     size_t system_tokens = estimateTokens(system_prompt);
     
-    // Reserve tokens for user request and response
-    size_t available_tokens = m_max_tokens - m_reserved_tokens - system_tokens;
-    size_t user_request_tokens = estimateTokens(user_request);
-    available_tokens = available_tokens > user_request_tokens ? 
-                      available_tokens - user_request_tokens : 0;
+    // Reserve tokens for system prompt, user request (with its framing) and response
+    size_t available_tokens = availableFileTokens(system_tokens + estimateTokens(buildUserPrompt(user_request, "")));
     
     std::cout << "[INFO] Available tokens for file content: " << available_tokens << std::endl;
     
     // Build file content within token limits
-    std::ostringstream files_content;
-    size_t used_tokens = 0;
-    
-    for (const auto& file_info : prioritized_files) {
-        size_t file_tokens = estimateTokens(file_info.content);
-        bool needs_truncation = false;
-        std::string content_to_use = file_info.content;
-        
-        // Check if we need to truncate or skip this file
-        if (used_tokens + file_tokens > available_tokens) {
-            size_t remaining_tokens = available_tokens - used_tokens;
-            
-            if (remaining_tokens < 100) {
-                // Not enough tokens left, skip remaining files
-                std::cout << "[WARN] Token limit reached, skipping " 
-                         << (prioritized_files.size() - m_last_stats["files_included"]) 
-                         << " remaining files" << std::endl;
-                break;
-            }
-            
-            // Truncate the file content
-            content_to_use = intelligentTruncate(file_info.content, remaining_tokens - 50); // Reserve 50 tokens for formatting
-            file_tokens = estimateTokens(content_to_use);
-            needs_truncation = true;
-            m_last_stats["files_truncated"]++;
-        }
-        
-        // Create FileInfo with potentially truncated content
-        FileInfo display_info = file_info;
-        display_info.content = content_to_use;
-        
-        files_content << formatFileContent(display_info, needs_truncation);
-        used_tokens += file_tokens + 20; // Add some padding for formatting
-        m_last_stats["files_included"]++;
-        
-        if (needs_truncation) {
-            break; // Stop after truncating a file to avoid further complications
-        }
+    std::vector<std::string> included;
+    std::string formatted_files = packFiles(prioritized_files, available_tokens, &included);
+    m_last_snapshot = ContextSnapshot();
+    for (const auto& path : included) {
+        m_last_snapshot.sent[path] = hashes[path];
+        hashes.erase(path);
     }
+    m_last_snapshot.withheld = std::move(hashes);
     
     // Build complete prompt
-    std::string formatted_files = files_content.str();
     std::string user_prompt = buildUserPrompt(user_request, formatted_files);
     std::string complete_prompt = system_prompt + user_prompt;
     
@@ -102,6 +79,290 @@ std::string ContextBuilder::buildContext(const std::vector<std::string>& file_pa
     return complete_prompt;
 }
 
+DeltaContext ContextBuilder::buildDeltaContext(const std::vector<std::string>& file_paths,
+                                              const std::string& user_request,
+                                              const ContextSnapshot& previous,
+                                              size_t history_tokens,
+                                              const std::string& root_path) {
+    m_last_stats.clear();
+    m_last_stats["files_total"] = file_paths.size();
+    m_last_stats["files_included"] = 0;
+    m_last_stats["files_truncated"] = 0;
+    m_last_stats["tokens_used"] = 0;
+    m_last_stats["history_tokens"] = history_tokens;
+    
+    std::cout << "[INFO] Building follow-up context from " << file_paths.size() << " files..." << std::endl;
+    
+    auto files = prioritizeFiles(loadFileInfo(file_paths, root_path));
+    minifyFiles(files);
+    
+    // Files the model already has an up-to-date copy of (or was never
+    // shown, and still has not changed) carry over; the rest are candidates
+    DeltaContext delta;
+    ContextSnapshot snapshot;
+    std::vector<FileInfo> changed_files;
+    std::unordered_map<std::string, uint64_t> hashes;
+    for (auto& file : files) {
+        uint64_t hash = std::hash<std::string>{}(file.content);
+        auto sent = previous.sent.find(file.relative_path);
+        auto withheld = previous.withheld.find(file.relative_path);
+        if (sent != previous.sent.end() && sent->second == hash) {
+            snapshot.sent[file.relative_path] = hash;
+        } else if (withheld != previous.withheld.end() && withheld->second == hash) {
+            snapshot.withheld[file.relative_path] = hash;
+        } else {
+            hashes[file.relative_path] = hash;
+            changed_files.push_back(std::move(file));
+        }
+    }
+    std::unordered_set<std::string> loaded(file_paths.begin(), file_paths.end());
+    for (const auto& entry : previous.sent) {
+        if (!loaded.count(entry.first) && !std::filesystem::exists(std::filesystem::path(root_path) / entry.first)) {
+            delta.removed.push_back(entry.first);
+        }
+    }
+    std::sort(delta.removed.begin(), delta.removed.end());
+    
+    size_t fixed_tokens = history_tokens + estimateTokens(buildDeltaTurn(user_request, "", delta.removed));
+    size_t available_tokens = availableFileTokens(fixed_tokens);
+    if (!changed_files.empty() && available_tokens < 100) {
+        std::cout << "[INFO] Session history leaves no room for " << changed_files.size() 
+                  << " changed files" << std::endl;
+        delta.fits = false;
+        return delta;
+    }
+    
+    std::string formatted_files = changed_files.empty() ? std::string()
+                                                        : packFiles(changed_files, available_tokens, &delta.changed);
+    for (const auto& path : delta.changed) {
+        snapshot.sent[path] = hashes[path];
+        hashes.erase(path);
+    }
+    for (const auto& entry : hashes) {
+        // A stale copy the model still holds stays a candidate until it is resent
+        if (!previous.sent.count(entry.first)) {
+            snapshot.withheld.insert(entry);
+        }
+    }
+    m_last_snapshot = std::move(snapshot);
+    
+    delta.turn = buildDeltaTurn(user_request, formatted_files, delta.removed);
+    m_last_stats["files_changed"] = changed_files.size();
+    m_last_stats["tokens_used"] = estimateTokens(delta.turn);
+    
+    std::cout << "[INFO] Follow-up context built: " << delta.changed.size() << " changed files, ~" 
+              << m_last_stats["tokens_used"] << " new tokens on top of ~" << history_tokens << std::endl;
+    
+    return delta;
+}
+
+BatchContext ContextBuilder::buildBatchContext(const std::vector<std::string>& file_paths,
+                                              const std::vector<std::string>& user_requests,
+                                              const std::string& root_path) {
+    m_last_stats.clear();
+    m_last_stats["files_total"] = file_paths.size();
+    m_last_stats["files_included"] = 0;
+    m_last_stats["files_truncated"] = 0;
+    m_last_stats["tokens_used"] = 0;
+    m_last_stats["requests"] = user_requests.size();
+    
+    std::cout << "[INFO] Building shared context from " << file_paths.size() 
+              << " files for " << user_requests.size() << " requests..." << std::endl;
+    
+    BatchContext batch;
+    batch.suffixes.reserve(user_requests.size());
+    size_t longest_suffix_tokens = 0;
+    std::vector<std::vector<std::string>> request_keywords;
+    request_keywords.reserve(user_requests.size());
+    for (const auto& request : user_requests) {
+        batch.suffixes.push_back(buildBatchSuffix(request));
+        longest_suffix_tokens = std::max(longest_suffix_tokens, estimateTokens(batch.suffixes.back()));
+        request_keywords.push_back(extractKeywords(request));
+    }
+    
+    // Count how many requests each file is relevant to; files shared by the
+    // whole batch lead the prefix, request-specific ones follow
+    auto file_infos = loadFileInfo(file_paths, root_path);
+    std::vector<std::pair<size_t, size_t>> order; // (requests hit, index)
+    order.reserve(file_infos.size());
+    for (size_t i = 0; i < file_infos.size(); ++i) {
+        std::string lower_content = file_infos[i].content;
+        std::transform(lower_content.begin(), lower_content.end(), 
+                       lower_content.begin(), ::tolower);
+        size_t hits = 0;
+        for (const auto& keywords : request_keywords) {
+            if (mentionsAnyKeyword(lower_content, keywords)) {
+                hits++;
+            }
+        }
+        order.emplace_back(hits, i);
+        // Weigh files shared by more requests higher when packing the budget
+        file_infos[i].priority_score += static_cast<int>(hits) * 50;
+    }
+    std::sort(order.begin(), order.end(), [&file_infos](const auto& a, const auto& b) {
+        if (a.first != b.first) {
+            return a.first > b.first;
+        }
+        const FileInfo& fa = file_infos[a.second];
+        const FileInfo& fb = file_infos[b.second];
+        if (fa.priority_score != fb.priority_score) {
+            return fa.priority_score > fb.priority_score;
+        }
+        if (fa.last_modified != fb.last_modified) {
+            return fa.last_modified > fb.last_modified;
+        }
+        return fa.relative_path < fb.relative_path; // Keep the prefix stable across runs
+    });
+    
+    std::vector<FileInfo> ordered_files;
+    ordered_files.reserve(order.size());
+    for (const auto& entry : order) {
+        ordered_files.push_back(std::move(file_infos[entry.second]));
+    }
+    minifyFiles(ordered_files);
+    if (m_deduplicate) {
+        deduplicateFiles(ordered_files);
+    }
+    
+    const std::string context_header = "Here is the full project context:\n";
+    const std::string context_footer = "\n--- END OF PROJECT CONTEXT ---\n\n";
+    std::string system_prompt = buildSystemPrompt();
+    size_t fixed_tokens = estimateTokens(system_prompt) + estimateTokens(context_header) +
+                          estimateTokens(context_footer) + longest_suffix_tokens;
+    size_t available_tokens = availableFileTokens(fixed_tokens);
+    
+    std::string formatted_files = packFiles(ordered_files, available_tokens, &batch.file_order);
+    
+    batch.shared_prefix.reserve(system_prompt.size() + context_header.size() +
+                                formatted_files.size() + context_footer.size());
+    batch.shared_prefix += system_prompt;
+    batch.shared_prefix += context_header;
+    batch.shared_prefix += formatted_files;
+    batch.shared_prefix += context_footer;
+    
+    m_last_stats["shared_prefix_tokens"] = estimateTokens(batch.shared_prefix);
+    m_last_stats["tokens_used"] = m_last_stats["shared_prefix_tokens"] + longest_suffix_tokens;
+    
+    std::cout << "[INFO] Shared context built: " << m_last_stats["files_included"] 
+              << " files, ~" << m_last_stats["shared_prefix_tokens"] << " prefix tokens" << std::endl;
+    
+    return batch;
+}
+
+FanoutContext ContextBuilder::buildFanoutContext(const std::vector<std::string>& file_paths,
+                                                const std::string& user_request,
+                                                size_t max_files_per_task,
+                                                const std::string& root_path) {
+    m_last_stats.clear();
+    m_last_stats["files_total"] = file_paths.size();
+    m_last_stats["files_included"] = 0;
+    m_last_stats["files_truncated"] = 0;
+    m_last_stats["tokens_used"] = 0;
+    m_last_stats["tasks"] = 0;
+    
+    std::cout << "[INFO] Planning fan-out tasks over " << file_paths.size() << " files..." << std::endl;
+    
+    auto files = prioritizeFiles(loadFileInfo(file_paths, root_path));
+    minifyFiles(files);
+    
+    // The outline lists every file; duplicates are folded only in task content
+    std::string outline = buildProjectOutline(files, m_max_tokens / 8);
+    if (m_deduplicate) {
+        deduplicateFiles(files);
+    }
+    
+    // A task costs a generation, so only files the request mentions get one
+    // when any do; the rest are still visible in the outline
+    std::vector<std::string> keywords = m_relevance_keywords.empty() ? extractKeywords(user_request)
+                                                                     : m_relevance_keywords;
+    std::vector<const FileInfo*> candidates;
+    for (const auto& file : files) {
+        std::string lower_content = file.content;
+        std::transform(lower_content.begin(), lower_content.end(), 
+                       lower_content.begin(), ::tolower);
+        if (mentionsAnyKeyword(lower_content, keywords) ||
+            m_retrieval_scores.count(file.relative_path) > 0) {
+            candidates.push_back(&file);
+        }
+    }
+    if (candidates.empty()) {
+        for (const auto& file : files) {
+            candidates.push_back(&file);
+        }
+    }
+    
+    FanoutContext context;
+    std::ostringstream prefix;
+    prefix << buildSystemPrompt();
+    prefix << "Implement the following request: " << user_request << "\n\n";
+    prefix << "Project outline (every file with its top-level declarations; the files you may change follow in full):\n";
+    prefix << outline;
+    prefix << "--- END OF PROJECT OUTLINE ---\n\n";
+    context.shared_prefix = prefix.str();
+    m_last_stats["shared_prefix_tokens"] = estimateTokens(context.shared_prefix);
+    
+    size_t task_tokens = availableFileTokens(m_last_stats["shared_prefix_tokens"] +
+                                             estimateTokens(buildFanoutSuffix("", {})));
+    if (task_tokens < 100) {
+        std::cerr << "[WARN] No room for file content after the project outline; raise the task token limit" << std::endl;
+        return context;
+    }
+    
+    // Formatting overhead per file: marker, padding and the ownership list
+    std::vector<std::pair<std::string, size_t>> sized;
+    std::unordered_map<std::string, const FileInfo*> by_path;
+    sized.reserve(candidates.size());
+    for (const auto* file : candidates) {
+        size_t tokens = estimateTokens(file->content) + 20 + 2 * estimateTokens(file->relative_path);
+        // Folded copies ride along with the file that stands for them
+        for (const auto& alias : file->aliases) {
+            tokens += 2 * estimateTokens(alias);
+        }
+        for (const auto& variant : file->variants) {
+            tokens += estimateTokens(variant.second) + 20 + 2 * estimateTokens(variant.first);
+        }
+        sized.emplace_back(file->relative_path, tokens);
+        by_path[file->relative_path] = file;
+    }
+    context.tasks = AmodifyFanout::planTasks(sized, max_files_per_task, task_tokens);
+    
+    size_t longest_suffix_tokens = 0;
+    context.suffixes.reserve(context.tasks.size());
+    for (auto& task : context.tasks) {
+        std::vector<FileInfo> task_files;
+        task_files.reserve(task.files.size());
+        for (const auto& path : task.files) {
+            task_files.push_back(*by_path.at(path));
+        }
+        std::vector<std::string> included;
+        std::string formatted_files = packFiles(task_files, task_tokens, &included);
+        task.files = included; // A file that did not fit is not owned by anyone
+        context.suffixes.push_back(buildFanoutSuffix(formatted_files, task.files));
+        longest_suffix_tokens = std::max(longest_suffix_tokens, estimateTokens(context.suffixes.back()));
+    }
+    
+    m_last_stats["tasks"] = context.tasks.size();
+    m_last_stats["tokens_used"] = m_last_stats["shared_prefix_tokens"] + longest_suffix_tokens;
+    
+    std::cout << "[INFO] Fan-out planned: " << context.tasks.size() << " tasks over " 
+              << m_last_stats["files_included"] << " files, ~" << m_last_stats["shared_prefix_tokens"] 
+              << " shared prefix tokens" << std::endl;
+    
+    return context;
+}
+
+std::vector<std::string> ContextBuilder::extractKeywords(const std::string& user_request) {
+    std::vector<std::string> keywords;
+    std::istringstream iss(user_request);
+    std::string word;
+    while (iss >> word) {
+        if (word.length() > 3) { // Only consider words longer than 3 chars
+            keywords.push_back(word);
+        }
+    }
+    return keywords;
+}
+
 void ContextBuilder::setMaxTokens(size_t max_tokens) {
     m_max_tokens = max_tokens;
 }
@@ -122,6 +383,51 @@ void ContextBuilder::setRelevanceKeywords(const std::vector<std::string>& keywor
     m_relevance_keywords = keywords;
 }
 
+void ContextBuilder::setDeduplication(bool enabled) {
+    m_deduplicate = enabled;
+}
+
+void ContextBuilder::setNearDuplicateThreshold(double threshold) {
+    m_near_duplicate_threshold = std::clamp(threshold, 0.0, 1.0);
+}
+
+void ContextBuilder::setMinification(bool enabled) {
+    m_minify = enabled;
+}
+
+const std::unordered_map<std::string, MinifiedSource>& ContextBuilder::getMinifiedFiles() const {
+    return m_minified;
+}
+
+void ContextBuilder::setRetrievalScores(const std::unordered_map<std::string, double>& scores) {
+    m_retrieval_scores = scores;
+}
+
+const ContextSnapshot& ContextBuilder::getLastSnapshot() const {
+    return m_last_snapshot;
+}
+
+ContextSnapshot ContextBuilder::snapshotAfterEdits(ContextSnapshot snapshot,
+                                                   const std::vector<std::pair<std::string, std::string>>& edits,
+                                                   const std::string& root_path) const {
+    for (const auto& edit : edits) {
+        const std::string& path = edit.first;
+        snapshot.withheld.erase(path);
+        
+        std::ifstream file(std::filesystem::path(root_path) / path, std::ios::binary);
+        std::ostringstream on_disk;
+        if (file) {
+            on_disk << file.rdbuf();
+        }
+        if (file && on_disk.str() == edit.second) {
+            snapshot.sent[path] = snapshotHash(path, edit.second);
+        } else {
+            snapshot.sent.erase(path);
+        }
+    }
+    return snapshot;
+}
+
 std::unordered_map<std::string, size_t> ContextBuilder::getLastBuildStats() const {
     return m_last_stats;
 }
@@ -132,6 +438,224 @@ size_t ContextBuilder::estimateTokens(const std::string& text) const {
     return (text.length() + 3) / 4;
 }
 
+size_t ContextBuilder::availableFileTokens(size_t fixed_tokens) const {
+    size_t reserved = m_reserved_tokens + fixed_tokens;
+    return m_max_tokens > reserved ? m_max_tokens - reserved : 0;
+}
+
+std::string ContextBuilder::packFiles(const std::vector<FileInfo>& files, size_t available_tokens,
+                                      std::vector<std::string>* included) {
+    // Each file is one class of a multiple-choice knapsack: leave it out,
+    // include it whole, or include a truncated prefix. Truncated content is
+    // worth less than its share of the file because the model cannot edit
+    // what it cannot see, so whole files win whenever they fit.
+    struct Option {
+        std::string block;      // Formatted text
+        size_t cost;            // Exact token cost of block
+        double value;
+        bool truncated;
+    };
+    static const double kTruncationFractions[] = {0.25, 0.5, 0.75};
+    static const double kTruncatedValue = 0.8;
+    static const size_t kMinTruncatedTokens = 100;
+    
+    std::vector<std::vector<Option>> options(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        const FileInfo& file_info = files[i];
+        double weight = static_cast<double>(std::max(1, file_info.priority_score));
+        
+        std::string block = formatFileContent(file_info, false);
+        size_t cost = estimateTokens(block);
+        if (cost <= available_tokens) {
+            options[i].push_back({std::move(block), cost, weight, false});
+        }
+        
+        size_t content_tokens = estimateTokens(file_info.content);
+        if (!shouldTruncateFileType(getFileExtension(file_info.relative_path))) {
+            continue;
+        }
+        for (double fraction : kTruncationFractions) {
+            size_t target = static_cast<size_t>(static_cast<double>(content_tokens) * fraction);
+            if (target < kMinTruncatedTokens || target > available_tokens) {
+                continue;
+            }
+            std::string truncated = formatTruncatedFile(file_info, target);
+            if (!truncated.empty()) {
+                size_t truncated_cost = estimateTokens(truncated);
+                options[i].push_back({std::move(truncated), truncated_cost, weight * fraction * kTruncatedValue, true});
+            }
+        }
+    }
+    
+    // Dynamic programming over the budget in at most kGranules steps, so the
+    // work is linear in the number of files; costs round up to whole steps,
+    // which keeps every solution within the budget
+    static const size_t kGranules = 4096;
+    size_t unit = std::max<size_t>(1, (available_tokens + kGranules - 1) / kGranules);
+    size_t capacity = available_tokens / unit;
+    std::vector<double> best(capacity + 1, 0.0);
+    std::vector<double> next(capacity + 1, 0.0);
+    std::vector<std::vector<uint8_t>> choice(files.size(), std::vector<uint8_t>(capacity + 1, 0)); // 0 = left out, k = option k-1
+    for (size_t i = 0; i < files.size(); ++i) {
+        next = best;
+        for (size_t k = 0; k < options[i].size(); ++k) {
+            size_t units = (options[i][k].cost + unit - 1) / unit;
+            for (size_t w = units; w <= capacity; ++w) {
+                double candidate = best[w - units] + options[i][k].value;
+                if (candidate > next[w]) {
+                    next[w] = candidate;
+                    choice[i][w] = static_cast<uint8_t>(k + 1);
+                }
+            }
+        }
+        best.swap(next);
+    }
+    
+    std::vector<int> selected(files.size(), -1);
+    size_t w = capacity;
+    for (size_t i = files.size(); i-- > 0;) {
+        if (choice[i][w] > 0) {
+            selected[i] = choice[i][w] - 1;
+            w -= (options[i][selected[i]].cost + unit - 1) / unit;
+        }
+    }
+    
+    size_t used_tokens = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (selected[i] >= 0) {
+            used_tokens += options[i][selected[i]].cost;
+        }
+    }
+    
+    // Spend what rounding and the fixed truncation steps left over: first on
+    // whole files that now fit, then by extending the most important
+    // truncated (or missing) file to exactly the remaining budget
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (selected[i] < 0 && !options[i].empty() && !options[i][0].truncated &&
+            used_tokens + options[i][0].cost <= available_tokens) {
+            selected[i] = 0;
+            used_tokens += options[i][0].cost;
+        }
+    }
+    
+    // Near duplicates of a truncated file are shown as whole files of their
+    // own where they fit, ahead of extending any truncation
+    std::vector<std::string> variant_blocks(files.size());
+    std::vector<std::vector<bool>> variant_packed(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        variant_packed[i].assign(files[i].variant_files.size(), false);
+        if (selected[i] < 0 || !options[i][selected[i]].truncated) {
+            continue;
+        }
+        for (size_t v = 0; v < files[i].variant_files.size(); ++v) {
+            std::string block = formatFileContent(files[i].variant_files[v], false);
+            size_t cost = estimateTokens(block);
+            if (used_tokens + cost <= available_tokens) {
+                variant_blocks[i] += block;
+                variant_packed[i][v] = true;
+                used_tokens += cost;
+            }
+        }
+    }
+    
+    for (size_t i = 0; i < files.size() && used_tokens < available_tokens; ++i) {
+        bool whole = selected[i] >= 0 && !options[i][selected[i]].truncated;
+        if (whole || !shouldTruncateFileType(getFileExtension(files[i].relative_path))) {
+            continue;
+        }
+        size_t current = selected[i] >= 0 ? options[i][selected[i]].cost : 0;
+        size_t limit = current + (available_tokens - used_tokens);
+        if (limit < kMinTruncatedTokens) {
+            continue;
+        }
+        std::string extended = formatTruncatedFile(files[i], limit);
+        size_t extended_cost = estimateTokens(extended);
+        if (extended.empty() || extended_cost <= current || extended_cost > limit) {
+            continue;
+        }
+        options[i].push_back({std::move(extended), extended_cost, 0.0, true});
+        selected[i] = static_cast<int>(options[i].size() - 1);
+        used_tokens += extended_cost - current;
+    }
+    
+    // Emit in the given order so callers' ordering (and prefix stability) holds
+    std::string files_content;
+    size_t skipped = 0;
+    std::vector<std::string> skipped_variants;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (selected[i] < 0) {
+            skipped++;
+            continue;
+        }
+        const Option& option = options[i][selected[i]];
+        files_content += option.block;
+        files_content += variant_blocks[i];
+        m_last_stats["files_included"]++;
+        if (option.truncated) {
+            m_last_stats["files_truncated"]++;
+        }
+        if (included) {
+            included->push_back(files[i].relative_path);
+            included->insert(included->end(), files[i].aliases.begin(), files[i].aliases.end());
+        }
+        for (size_t v = 0; v < files[i].variant_files.size(); ++v) {
+            const FileInfo& variant = files[i].variant_files[v];
+            if (option.truncated && !variant_packed[i][v]) {
+                skipped_variants.push_back(variant.relative_path);
+                continue;
+            }
+            if (included) {
+                included->push_back(variant.relative_path);
+                included->insert(included->end(), variant.aliases.begin(), variant.aliases.end());
+            }
+        }
+    }
+    
+    if (skipped > 0) {
+        std::cout << "[WARN] Token limit reached, skipping " << skipped << " files" << std::endl;
+    }
+    if (!skipped_variants.empty()) {
+        std::cout << "[WARN] Skipping " << skipped_variants.size() << " near duplicates of truncated files:";
+        for (const auto& path : skipped_variants) {
+            std::cout << " " << path;
+        }
+        std::cout << std::endl;
+        skipped += skipped_variants.size();
+    }
+    m_last_stats["files_skipped"] += skipped;
+    m_last_stats["budget_tokens"] += available_tokens;
+    m_last_stats["packed_tokens"] += used_tokens;
+    m_last_stats["budget_utilization_pct"] = m_last_stats["budget_tokens"] > 0
+        ? m_last_stats["packed_tokens"] * 100 / m_last_stats["budget_tokens"] : 0;
+    
+    return files_content;
+}
+
+std::string ContextBuilder::formatTruncatedFile(const FileInfo& file_info, size_t max_tokens) const {
+    // Variants are not shown under a truncated file, so they are not copied
+    FileInfo display_info(file_info.relative_path, "");
+    display_info.aliases = file_info.aliases;
+    size_t overhead = estimateTokens(formatFileContent(display_info, true)) + 1;
+    if (max_tokens <= overhead) {
+        return "";
+    }
+    
+    // The truncation marker and line-boundary cuts make the first guess
+    // approximate; shrink by the overshoot until the block fits
+    size_t target = max_tokens - overhead;
+    for (int attempt = 0; attempt < 4 && target > 0; ++attempt) {
+        display_info.content = intelligentTruncate(file_info.content, target);
+        std::string block = formatFileContent(display_info, true);
+        size_t cost = estimateTokens(block);
+        if (cost <= max_tokens) {
+            return block;
+        }
+        size_t overshoot = cost - max_tokens;
+        target = target > overshoot ? target - overshoot : 0;
+    }
+    return "";
+}
+
 std::vector<FileInfo> ContextBuilder::loadFileInfo(const std::vector<std::string>& file_paths, 
                                                   const std::string& root_path) const {
     std::vector<FileInfo> file_infos;
@@ -204,9 +728,242 @@ int ContextBuilder::calculateFilePriority(const FileInfo& file_info) const {
         priority += calculateRelevanceScore(file_info.content);
     }
     
+    // Retrieval-based priority (semantic similarity), on the keyword scale
+    auto retrieval_it = m_retrieval_scores.find(file_info.relative_path);
+    if (retrieval_it != m_retrieval_scores.end()) {
+        priority += static_cast<int>(std::lround(std::clamp(retrieval_it->second, 0.0, 1.0) * 50.0));
+    }
+    
     return priority;
 }
 
+namespace {
+
+uint64_t mix64(uint64_t value) {
+    // splitmix64 finalizer
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief MinHash signature over shingles of consecutive whitespace-trimmed lines
+ */
+std::vector<uint64_t> minHashSignature(const std::string& content, size_t permutations) {
+    static const size_t kShingleLines = 3;
+    std::vector<size_t> line_hashes;
+    std::istringstream stream(content);
+    for (std::string line; std::getline(stream, line);) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) {
+            continue;
+        }
+        size_t last = line.find_last_not_of(" \t\r");
+        line_hashes.push_back(std::hash<std::string>{}(line.substr(first, last - first + 1)));
+    }
+    
+    std::vector<uint64_t> signature(permutations, UINT64_MAX);
+    if (line_hashes.empty()) {
+        return signature;
+    }
+    size_t shingles = line_hashes.size() >= kShingleLines ? line_hashes.size() - kShingleLines + 1 : 1;
+    for (size_t i = 0; i < shingles; ++i) {
+        uint64_t shingle = 0;
+        for (size_t j = i; j < std::min(i + kShingleLines, line_hashes.size()); ++j) {
+            shingle = mix64(shingle ^ line_hashes[j]);
+        }
+        for (size_t p = 0; p < permutations; ++p) {
+            signature[p] = std::min(signature[p], mix64(shingle ^ (0x5851f42d4c957f2dULL * (p + 1))));
+        }
+    }
+    return signature;
+}
+
+/**
+ * @brief Zero-context unified diff turning original into modified
+ */
+std::string renderDelta(const std::string& original, const std::string& modified) {
+    std::ostringstream delta;
+    auto lines = DiffGenerator(original, modified).getDiff();
+    size_t original_pos = 0;
+    size_t modified_pos = 0;
+    for (size_t i = 0; i < lines.size();) {
+        if (lines[i].type == DiffLineType::UNCHANGED) {
+            original_pos++;
+            modified_pos++;
+            i++;
+            continue;
+        }
+        size_t end = i;
+        size_t removed = 0;
+        size_t added = 0;
+        while (end < lines.size() && lines[end].type != DiffLineType::UNCHANGED) {
+            (lines[end].type == DiffLineType::REMOVED ? removed : added)++;
+            end++;
+        }
+        // As in unified diffs, an empty side names the line before the change
+        delta << "@@ -" << (removed > 0 ? original_pos + 1 : original_pos) << "," << removed
+              << " +" << (added > 0 ? modified_pos + 1 : modified_pos) << "," << added << " @@\n";
+        for (size_t j = i; j < end; ++j) {
+            if (lines[j].type == DiffLineType::REMOVED) {
+                delta << "-" << lines[j].text << "\n";
+            }
+        }
+        for (size_t j = i; j < end; ++j) {
+            if (lines[j].type == DiffLineType::ADDED) {
+                delta << "+" << lines[j].text << "\n";
+            }
+        }
+        original_pos += removed;
+        modified_pos += added;
+        i = end;
+    }
+    return delta.str();
+}
+
+} // namespace
+
+void ContextBuilder::deduplicateFiles(std::vector<FileInfo>& files) {
+    size_t collapsed = 0;
+    size_t near_duplicates = 0;
+    size_t tokens_saved = 0;
+    std::vector<bool> folded(files.size(), false);
+    
+    // Exact duplicates: equal hashes are confirmed byte for byte, so
+    // distinct files are never merged
+    std::unordered_map<size_t, std::vector<size_t>> by_hash;
+    for (size_t i = 0; i < files.size(); ++i) {
+        auto& bucket = by_hash[std::hash<std::string>{}(files[i].content)];
+        auto original = std::find_if(bucket.begin(), bucket.end(), [&](size_t kept) {
+            return files[kept].content == files[i].content;
+        });
+        if (original == bucket.end()) {
+            bucket.push_back(i);
+            continue;
+        }
+        files[*original].aliases.push_back(files[i].relative_path);
+        folded[i] = true;
+        collapsed++;
+        tokens_saved += estimateTokens(files[i].content);
+    }
+    
+    // Near duplicates: MinHash signatures split into bands; files sharing a
+    // band are candidates, so only likely pairs are diffed
+    if (m_near_duplicate_threshold > 0.0) {
+        static const size_t kBands = 8;
+        static const size_t kRows = 4;
+        std::vector<std::vector<uint64_t>> signatures(files.size());
+        std::vector<std::unordered_map<uint64_t, std::vector<size_t>>> bands(kBands);
+        
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (folded[i] || files[i].content.empty()) {
+                continue;
+            }
+            signatures[i] = minHashSignature(files[i].content, kBands * kRows);
+            
+            std::unordered_set<size_t> candidates;
+            std::vector<uint64_t> band_keys(kBands);
+            for (size_t b = 0; b < kBands; ++b) {
+                uint64_t key = b;
+                for (size_t r = 0; r < kRows; ++r) {
+                    key = mix64(key ^ signatures[i][b * kRows + r]);
+                }
+                band_keys[b] = key;
+                auto it = bands[b].find(key);
+                if (it != bands[b].end()) {
+                    candidates.insert(it->second.begin(), it->second.end());
+                }
+            }
+            
+            // The earliest sufficiently similar file that is not itself a variant
+            size_t best = files.size();
+            for (size_t candidate : candidates) {
+                if (folded[candidate] || candidate >= best) {
+                    continue;
+                }
+                size_t agree = 0;
+                for (size_t p = 0; p < signatures[i].size(); ++p) {
+                    agree += signatures[i][p] == signatures[candidate][p] ? 1 : 0;
+                }
+                if (static_cast<double>(agree) / signatures[i].size() >= m_near_duplicate_threshold) {
+                    best = candidate;
+                }
+            }
+            
+            if (best < files.size()) {
+                std::string delta = renderDelta(files[best].content, files[i].content);
+                size_t file_tokens = estimateTokens(files[i].content);
+                size_t delta_tokens = estimateTokens(delta);
+                if (delta_tokens * 2 < file_tokens) {
+                    files[best].variants.emplace_back(files[i].relative_path, std::move(delta));
+                    files[best].variant_files.push_back(std::move(files[i]));
+                    folded[i] = true;
+                    near_duplicates++;
+                    tokens_saved += file_tokens - delta_tokens;
+                    continue;
+                }
+            }
+            for (size_t b = 0; b < kBands; ++b) {
+                bands[b][band_keys[b]].push_back(i);
+            }
+        }
+    }
+    
+    if (collapsed + near_duplicates > 0) {
+        // The kept copy stands for all of them; it has the highest priority
+        // among them already, so the order is unchanged
+        std::vector<FileInfo> kept;
+        kept.reserve(files.size() - collapsed - near_duplicates);
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (!folded[i]) {
+                kept.push_back(std::move(files[i]));
+            }
+        }
+        files = std::move(kept);
+        std::cout << "[INFO] Folded " << collapsed << " duplicate and " << near_duplicates
+                  << " near-duplicate files (~" << tokens_saved << " tokens saved)" << std::endl;
+    }
+    m_last_stats["duplicates_collapsed"] = collapsed;
+    m_last_stats["near_duplicates"] = near_duplicates;
+    m_last_stats["dedup_tokens_saved"] = tokens_saved;
+}
+
+void ContextBuilder::minifyFiles(std::vector<FileInfo>& files) {
+    m_minified.clear();
+    if (!m_minify) {
+        return;
+    }
+    
+    size_t tokens_saved = 0;
+    for (auto& file : files) {
+        MinifiedSource minified = SourceMinifier::minify(file.relative_path, file.content);
+        minified.original_tokens = estimateTokens(file.content);
+        minified.minified_tokens = estimateTokens(minified.content);
+        if (minified.minified_tokens >= minified.original_tokens) {
+            continue;
+        }
+        tokens_saved += minified.original_tokens - minified.minified_tokens;
+        file.content = minified.content;
+        m_minified.emplace(file.relative_path, std::move(minified));
+    }
+    
+    std::cout << "[INFO] Minified " << m_minified.size() << " files (~" << tokens_saved 
+              << " tokens saved)" << std::endl;
+    m_last_stats["files_minified"] = m_minified.size();
+    m_last_stats["minify_tokens_saved"] = tokens_saved;
+}
+
+uint64_t ContextBuilder::snapshotHash(const std::string& file_path, const std::string& content) const {
+    if (m_minify) {
+        MinifiedSource minified = SourceMinifier::minify(file_path, content);
+        if (estimateTokens(minified.content) < estimateTokens(content)) {
+            return std::hash<std::string>{}(minified.content);
+        }
+    }
+    return std::hash<std::string>{}(content);
+}
+
 std::vector<FileInfo> ContextBuilder::prioritizeFiles(std::vector<FileInfo> files) const {
     // Sort by priority score (highest first), then by modification time (newest first)
     std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) {
@@ -224,6 +981,14 @@ std::string ContextBuilder::formatFileContent(const FileInfo& file_info, bool tr
     
     formatted << "\n--- FILE: " << file_info.relative_path << " ---\n";
     
+    if (!file_info.aliases.empty()) {
+        formatted << "// [IDENTICAL COPIES - Same content at:";
+        for (const auto& alias : file_info.aliases) {
+            formatted << " " << alias;
+        }
+        formatted << "]\n";
+    }
+    
     if (truncated) {
         formatted << "// [TRUNCATED - Content exceeds token limit]\n";
     }
@@ -235,6 +1000,23 @@ std::string ContextBuilder::formatFileContent(const FileInfo& file_info, bool tr
         formatted << '\n';
     }
     
+    if (!truncated) {
+        for (size_t v = 0; v < file_info.variants.size(); ++v) {
+            const auto& variant = file_info.variants[v];
+            formatted << "\n--- FILE: " << variant.first << " ---\n";
+            if (v < file_info.variant_files.size() && !file_info.variant_files[v].aliases.empty()) {
+                formatted << "// [IDENTICAL COPIES - Same content at:";
+                for (const auto& alias : file_info.variant_files[v].aliases) {
+                    formatted << " " << alias;
+                }
+                formatted << "]\n";
+            }
+            formatted << "// [NEAR DUPLICATE - " << file_info.relative_path
+                      << " with this diff applied]\n";
+            formatted << variant.second;
+        }
+    }
+    
     return formatted.str();
 }
 
@@ -244,8 +1026,11 @@ std::string ContextBuilder::intelligentTruncate(const std::string& content, size
         return content;
     }
     
-    // Calculate approximate character limit
-    size_t char_limit = max_tokens * 3; // Conservative estimate
+    // Character limit matching estimateTokens(), less the marker, so the
+    // packer's budget accounting is exact; m_reserved_tokens absorbs the
+    // estimate's error against the real tokenizer
+    static const std::string marker = "\n\n// [CONTENT TRUNCATED - File continues beyond token limit]\n";
+    size_t char_limit = max_tokens * 4 > marker.size() ? max_tokens * 4 - marker.size() : 0;
     
     if (content.length() <= char_limit) {
         return content;
@@ -260,12 +1045,16 @@ std::string ContextBuilder::intelligentTruncate(const std::string& content, size
         truncated = truncated.substr(0, last_newline + 1);
     }
     
-    truncated += "\n\n// [CONTENT TRUNCATED - File continues beyond token limit]\n";
+    truncated += marker;
     
     return truncated;
 }
 
 std::string ContextBuilder::buildSystemPrompt() const {
+    if (m_edit_format == EditFormat::SEARCH_REPLACE) {
+        return buildEditSystemPrompt();
+    }
+    
     return R"(<|begin_of_text|><|start_header_id|>system<|end_header_id|>
 
 You are an expert software engineer assistant capable of analyzing entire codebases and making comprehensive modifications across multiple files. Your task is to understand the user's high-level request and determine which files need to be modified and how.
@@ -298,6 +1087,48 @@ IMPORTANT NOTES:
 )";
 }
 
+std::string ContextBuilder::buildEditSystemPrompt() const {
+    return R"(<|begin_of_text|><|start_header_id|>system<|end_header_id|>
+
+You are an expert software engineer assistant capable of analyzing entire codebases and making comprehensive modifications across multiple files. Your task is to understand the user's high-level request and determine which files need to be modified and how.
+
+CRITICAL INSTRUCTIONS:
+1. Analyze the entire project context provided below
+2. Understand the codebase architecture, patterns, and conventions
+3. Determine which files need to be modified to fulfill the user's request
+4. Respond with ONLY edits in the specified format
+5. Output only the lines that change, with a few lines of unchanged context
+6. Do NOT include explanations, reasoning, or conversational text
+7. Follow existing code style, patterns, and architectural decisions
+8. Ensure all modifications work together cohesively
+
+RESPONSE FORMAT:
+For each file you want to modify, use this exact format:
+
+--- EDIT: path/to/file.ext ---
+<<<<<<< SEARCH
+[existing lines, copied exactly from the file]
+=======
+[the lines that replace them]
+>>>>>>> REPLACE
+
+IMPORTANT NOTES:
+- A file may have several SEARCH/REPLACE blocks; list them in file order
+- The SEARCH text must match the current file and identify a unique location
+- Keep SEARCH blocks short: the changed lines plus 2-3 lines of context
+- To delete lines, leave the REPLACE section empty
+- To create a new file, use an empty SEARCH section
+- Ensure your changes are syntactically correct and compile properly
+
+<|eot_id|><|start_header_id|>user<|end_header_id|>
+
+)";
+}
+
+void ContextBuilder::setEditFormat(EditFormat format) {
+    m_edit_format = format;
+}
+
 std::string ContextBuilder::buildUserPrompt(const std::string& user_request, 
                                           const std::string& formatted_files) const {
     std::ostringstream prompt;
@@ -311,6 +1142,103 @@ std::string ContextBuilder::buildUserPrompt(const std::string& user_request,
     return prompt.str();
 }
 
+std::string ContextBuilder::buildBatchSuffix(const std::string& user_request) const {
+    std::ostringstream suffix;
+    
+    suffix << "Implement the following request using the project context above: " << user_request << "\n\n";
+    suffix << "<|eot_id|><|start_header_id|>assistant<|end_header_id|>\n\n";
+    
+    return suffix.str();
+}
+
+std::string ContextBuilder::buildDeltaTurn(const std::string& user_request, const std::string& changed_files,
+                                          const std::vector<std::string>& removed) const {
+    std::ostringstream turn;
+    
+    turn << "<|eot_id|><|start_header_id|>user<|end_header_id|>\n\n";
+    if (changed_files.empty() && removed.empty()) {
+        turn << "No project files changed since your last answer.\n\n";
+    } else {
+        turn << "Project files that changed since your last answer follow; they replace the versions above. "
+             << "Files not listed are unchanged, so a change you proposed is only in effect where it appears here.\n";
+        turn << changed_files;
+        if (!removed.empty()) {
+            turn << "\nRemoved files:";
+            for (const auto& path : removed) {
+                turn << " " << path;
+            }
+            turn << "\n";
+        }
+        turn << "\n--- END OF CHANGES ---\n\n";
+    }
+    turn << "Implement the following request: " << user_request << "\n\n";
+    turn << "<|eot_id|><|start_header_id|>assistant<|end_header_id|>\n\n";
+    
+    return turn.str();
+}
+
+std::string ContextBuilder::buildProjectOutline(const std::vector<FileInfo>& files, size_t max_tokens) const {
+    const size_t max_lines_per_file = 12;
+    const size_t max_line_length = 160;
+    
+    std::ostringstream outline;
+    size_t used_tokens = 0;
+    for (const auto& file : files) {
+        std::string entry = file.relative_path + "\n";
+        
+        // Unindented lines are, in most languages, the declarations a
+        // neighbouring file can refer to
+        std::istringstream lines(file.content);
+        std::string line;
+        size_t listed = 0;
+        while (listed < max_lines_per_file && std::getline(lines, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || std::isspace(static_cast<unsigned char>(line[0])) ||
+                line[0] == '}' || line[0] == '{' || line[0] == '*' || line[0] == ')' ||
+                line.compare(0, 2, "//") == 0 || line.compare(0, 2, "/*") == 0 ||
+                (line[0] == '#' && line.compare(0, 8, "#include") != 0)) {
+                continue;
+            }
+            if (line.size() > max_line_length) {
+                line = line.substr(0, max_line_length) + "...";
+            }
+            entry += "    " + line + "\n";
+            listed++;
+        }
+        
+        // Past the budget files are still listed, just without declarations
+        size_t entry_tokens = estimateTokens(entry);
+        if (used_tokens + entry_tokens > max_tokens) {
+            entry = file.relative_path + "\n";
+            entry_tokens = estimateTokens(entry);
+        }
+        outline << entry;
+        used_tokens += entry_tokens;
+    }
+    
+    return outline.str();
+}
+
+std::string ContextBuilder::buildFanoutSuffix(const std::string& task_files,
+                                            const std::vector<std::string>& owned) const {
+    std::ostringstream suffix;
+    
+    suffix << "Files assigned to you:\n";
+    suffix << task_files;
+    suffix << "\n--- END OF ASSIGNED FILES ---\n\n";
+    suffix << "Other engineers are updating the remaining files in parallel. Only return blocks for the assigned files";
+    for (size_t i = 0; i < owned.size(); ++i) {
+        suffix << (i == 0 ? " (" : ", ") << owned[i] << (i + 1 == owned.size() ? ")" : "");
+    }
+    suffix << " or for new files this part of the change needs, and keep names and signatures consistent with the project outline. "
+           << "If none of the assigned files need to change, reply with NO CHANGES.\n\n";
+    suffix << "<|eot_id|><|start_header_id|>assistant<|end_header_id|>\n\n";
+    
+    return suffix.str();
+}
+
 void ContextBuilder::initializeDefaultPriorities() {
     // Header files - highest priority for understanding interfaces
     m_file_type_priorities[".hpp"] = 100;
@@ -422,4 +1350,17 @@ int ContextBuilder::calculateRelevanceScore(const std::string& content) const {
     return std::min(score, 50); // Cap relevance score at 50
 }
 
+bool ContextBuilder::mentionsAnyKeyword(const std::string& lower_content,
+                                        const std::vector<std::string>& keywords) {
+    for (const auto& keyword : keywords) {
+        std::string lower_keyword = keyword;
+        std::transform(lower_keyword.begin(), lower_keyword.end(), 
+                       lower_keyword.begin(), ::tolower);
+        if (lower_content.find(lower_keyword) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace Camus
\ No newline at end of file
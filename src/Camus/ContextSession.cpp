@@ -0,0 +1,126 @@
+// =================================================================
+// src/Camus/ContextSession.cpp
+// =================================================================
+// Implementation of persistent amodify sessions.
+
+#include "Camus/ContextSession.hpp"
+#include "nlohmann/json.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Camus {
+
+namespace {
+
+nlohmann::json hashesToJson(const std::unordered_map<std::string, uint64_t>& hashes) {
+    nlohmann::json object = nlohmann::json::object();
+    for (const auto& entry : hashes) {
+        object[entry.first] = entry.second;
+    }
+    return object;
+}
+
+std::unordered_map<std::string, uint64_t> hashesFromJson(const nlohmann::json& object) {
+    std::unordered_map<std::string, uint64_t> hashes;
+    for (const auto& entry : object.items()) {
+        hashes[entry.key()] = entry.value().get<uint64_t>();
+    }
+    return hashes;
+}
+
+int64_t nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+ContextSession::ContextSession(const std::string& session_dir, const std::string& model_key)
+    : m_session_dir(session_dir), m_model_key(model_key) {
+}
+
+bool ContextSession::load(std::chrono::minutes max_age) {
+    std::ifstream in(filePath());
+    if (!in) {
+        return false;
+    }
+
+    try {
+        nlohmann::json data = nlohmann::json::parse(in);
+        // A different key hashing to the same file is a different model
+        if (data.value("model_key", "") != m_model_key) {
+            return false;
+        }
+        int64_t idle = nowSeconds() - data.value("updated", static_cast<int64_t>(0));
+        if (idle > std::chrono::duration_cast<std::chrono::seconds>(max_age).count()) {
+            std::cout << "[INFO] Previous session expired; starting a new one" << std::endl;
+            reset();
+            return false;
+        }
+
+        m_history = data.at("history").get<std::string>();
+        m_snapshot.sent = hashesFromJson(data.at("sent"));
+        m_snapshot.withheld = hashesFromJson(data.at("withheld"));
+        m_backend_context = data.value("backend_context", std::vector<int64_t>());
+        m_turns = data.at("turns").get<size_t>();
+        return m_turns > 0;
+    } catch (const std::exception& e) {
+        std::cerr << "[WARN] Discarding unreadable session " << filePath() << ": " << e.what() << std::endl;
+        reset();
+        return false;
+    }
+}
+
+void ContextSession::save() const {
+    std::filesystem::create_directories(m_session_dir);
+
+    nlohmann::json data;
+    data["model_key"] = m_model_key;
+    data["updated"] = nowSeconds();
+    data["turns"] = m_turns;
+    data["history"] = m_history;
+    data["sent"] = hashesToJson(m_snapshot.sent);
+    data["withheld"] = hashesToJson(m_snapshot.withheld);
+    data["backend_context"] = m_backend_context;
+
+    // Through a temporary file so an interrupted write never leaves half a session
+    std::string path = filePath();
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        if (!out || !(out << data.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace))) {
+            throw std::runtime_error("Cannot write session file " + temp);
+        }
+    }
+    std::filesystem::rename(temp, path);
+}
+
+void ContextSession::reset() {
+    m_history.clear();
+    m_snapshot = ContextSnapshot();
+    m_backend_context.clear();
+    m_turns = 0;
+    std::error_code ec;
+    std::filesystem::remove(filePath(), ec);
+}
+
+void ContextSession::recordTurn(const std::string& turn, const std::string& answer,
+                                const ContextSnapshot& snapshot, std::vector<int64_t> backend_context) {
+    m_history += turn;
+    m_history += answer;
+    m_snapshot = snapshot;
+    m_backend_context = std::move(backend_context);
+    m_turns++;
+}
+
+std::string ContextSession::filePath() const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>{}(m_model_key) << ".json";
+    return (std::filesystem::path(m_session_dir) / name.str()).string();
+}
+
+} // namespace Camus
@@ -8,10 +8,16 @@
 #include "Camus/LlmInteraction.hpp"
 #include "Camus/LlamaCppInteraction.hpp"
 #include "Camus/OllamaInteraction.hpp"
+#include "Camus/LazyLlmInteraction.hpp"
 #include "Camus/SysInteraction.hpp"
+#include "Camus/ProcessRunner.hpp"
+#include "Camus/LogReducer.hpp"
 #include "Camus/ProjectScanner.hpp"
 #include "Camus/ContextBuilder.hpp"
+#include "Camus/ContextSession.hpp"
 #include "Camus/ResponseParser.hpp"
+#include "Camus/FileBlockFormat.hpp"
+#include "Camus/EditApplier.hpp"
 #include "Camus/MultiFileDiff.hpp"
 #include "Camus/InteractiveConfirmation.hpp"
 #include "Camus/BackupManager.hpp"
@@ -19,14 +25,25 @@
 #include "Camus/SafetyChecker.hpp"
 #include "Camus/Logger.hpp"
 #include "Camus/ModelRegistry.hpp"
+#include "Camus/ParallelStrategy.hpp"
+#include "Camus/AmodifyFanout.hpp"
+#include "Camus/EmbeddingIndex.hpp"
+#include "Camus/LlamaCppEmbedder.hpp"
+#include "Camus/CamusDaemon.hpp"
+#include "Camus/DaemonClient.hpp"
+#include "Camus/ModelOrchestrator.hpp"
+#include "Camus/HttpApiServer.hpp"
 #include "dtl/dtl.hpp" // Include the new diff library header
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
+#include <fstream>
 #include <vector>
 #include <algorithm>
 #include <filesystem>
 #include <chrono>
+#include <iomanip>
+#include <unordered_set>
 
 namespace Camus {
 
@@ -41,69 +58,194 @@ static std::vector<std::string> to_lines(const std::string& text) {
     return lines;
 }
 
+// Build process options for a configured build/test command. Output is
+// streamed to the terminal; analysis uses a LogReducer fed from the stream,
+// so only a small tail needs to be captured.
+static ProcessOptions makeCommandOptions(const ConfigParser& config, const std::string& timeout_key) {
+    ProcessOptions options;
+    options.tee_output = true;
+    options.max_capture_bytes = 256 * 1024;
+    
+    std::string timeout_value = config.getStringValue(timeout_key);
+    if (!timeout_value.empty()) {
+        try {
+            options.timeout = std::chrono::seconds(std::stol(timeout_value));
+        } catch (const std::exception&) {
+            std::cerr << "[WARN] Ignoring invalid " << timeout_key << ": " << timeout_value << std::endl;
+        }
+    }
+    return options;
+}
+
+// Location of the daemon socket, overridable with `daemon_socket` in config.yml
+static std::string daemonSocketPath(const ConfigParser& config) {
+    std::string socket_path = config.getStringValue("daemon_socket");
+    return socket_path.empty() ? DEFAULT_DAEMON_SOCKET : socket_path;
+}
+
+// Whether a project file now holds exactly this content
+static bool fileHasContent(const std::string& path, const std::string& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream on_disk;
+    on_disk << file.rdbuf();
+    return on_disk.str() == content;
+}
+
+// Per-file token savings of minification, largest first
+static void reportMinifiedFiles(const std::unordered_map<std::string, MinifiedSource>& minified) {
+    if (minified.empty()) {
+        return;
+    }
+    std::vector<std::pair<size_t, std::string>> savings;
+    size_t original_total = 0;
+    size_t saved_total = 0;
+    for (const auto& [path, source] : minified) {
+        savings.emplace_back(source.original_tokens - source.minified_tokens, path);
+        original_total += source.original_tokens;
+        saved_total += source.original_tokens - source.minified_tokens;
+    }
+    std::sort(savings.begin(), savings.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    std::cout << "Minified " << minified.size() << " files, saving ~" << saved_total << " of "
+              << original_total << " tokens:" << std::endl;
+    for (const auto& [saved, path] : savings) {
+        const MinifiedSource& source = minified.at(path);
+        std::cout << "  " << path << ": " << source.original_tokens << " -> " << source.minified_tokens
+                  << " tokens (-" << saved * 100 / source.original_tokens << "%)" << std::endl;
+    }
+}
+
 Core::Core(const Commands& commands) 
     : m_commands(commands),
       m_config(std::make_unique<ConfigParser>(".camus/config.yml")),
       m_sys(std::make_unique<SysInteraction>())
 {
-    // Only initialize the LLM for commands that need it.
-    if (m_commands.active_command != "init" && !m_commands.active_command.empty()) {
-        // Read the backend configuration
-        std::string backend = m_config->getStringValue("backend");
-        if (backend.empty()) {
-            backend = "direct"; // Default to direct if not specified
+    // Only initialize the LLM for commands that need it. serve-api loads
+    // its models through the registry instead.
+    if (m_commands.active_command == "init" || m_commands.active_command == "serve-api" ||
+        m_commands.active_command.empty()) {
+        return;
+    }
+
+    if (m_commands.active_command == "serve") {
+        // --stop and --status only talk to a running daemon; the daemon
+        // itself must always load the model in-process.
+        if (!m_commands.serve_stop && !m_commands.serve_status) {
+            m_llm = createBackend();
         }
-        
-        try {
-            if (backend == "ollama") {
-                // Ollama backend configuration
-                std::string ollama_url = m_config->getStringValue("ollama_url");
-                std::string model_name = m_config->getStringValue("default_model");
-                
-                if (ollama_url.empty() || model_name.empty()) {
-                    std::cerr << "[FATAL] `ollama_url` or `default_model` not set in .camus/config.yml" << std::endl;
-                    std::cerr << "Please run 'camus init' and edit the configuration file." << std::endl;
-                    m_llm = nullptr;
-                    return;
-                }
-                
-                std::cout << "[INFO] Using Ollama backend" << std::endl;
-                m_llm = std::make_unique<OllamaInteraction>(ollama_url, model_name);
-                
-            } else {
-                // Direct backend configuration (llama.cpp)
-                std::string model_dir = m_config->getStringValue("model_path");
-                std::string model_name = m_config->getStringValue("default_model");
-
-                if (model_dir.empty() || model_name.empty()) {
-                    std::cerr << "[FATAL] `model_path` or `default_model` not set in .camus/config.yml" << std::endl;
-                    std::cerr << "Please run 'camus init' and edit the configuration file." << std::endl;
-                    m_llm = nullptr;
-                    return;
-                }
+        return;
+    }
 
-                if (!model_dir.empty() && model_dir.back() != '/' && model_dir.back() != '\\') {
-                    model_dir += '/';
-                }
-                
-                std::string full_model_path = model_dir + model_name;
-                
-                std::cout << "[INFO] Using direct backend (llama.cpp)" << std::endl;
-                m_llm = std::make_unique<LlamaCppInteraction>(full_model_path);
+    // push never consults the model
+    if (m_commands.active_command == "push") {
+        return;
+    }
+
+    // Prefer a running daemon: its model is already loaded
+    auto client = DaemonClient::connect(daemonSocketPath(*m_config));
+    if (client) {
+        std::cout << "[INFO] Using camus daemon (pid " << client->getDaemonPid() << ")" << std::endl;
+        m_daemon = client.get();
+        m_llm = std::move(client);
+        return;
+    }
+
+    // build and test only need the model to analyze a failure; a passing
+    // run should not pay for loading it
+    if (m_commands.active_command == "build" || m_commands.active_command == "test") {
+        std::string prefetch_path;
+        std::string prefetch = m_config->getStringValue("prefetch_model");
+        if (prefetch == "true" || prefetch == "yes" || prefetch == "1") {
+            prefetch_path = directModelPath();
+        }
+        m_llm = std::make_unique<LazyLlmInteraction>([this]() { return createBackend(); },
+                                                     m_config->getStringValue("default_model"),
+                                                     prefetch_path,
+                                                     configuredBackendEndpoint());
+        return;
+    }
+
+    m_llm = createBackend();
+}
+
+std::string Core::directModelPath() const {
+    std::string backend = m_config->getStringValue("backend");
+    if (backend == "ollama") {
+        return "";
+    }
+    std::string model_dir = m_config->getStringValue("model_path");
+    std::string model_name = m_config->getStringValue("default_model");
+    if (model_dir.empty() || model_name.empty()) {
+        return "";
+    }
+    if (model_dir.back() != '/' && model_dir.back() != '\\') {
+        model_dir += '/';
+    }
+    return model_dir + model_name;
+}
+
+std::string Core::configuredBackendEndpoint() const {
+    if (m_config->getStringValue("backend") == "ollama") {
+        std::string ollama_url = m_config->getStringValue("ollama_url");
+        return ollama_url.empty() ? "" : OllamaInteraction::endpointFor(ollama_url);
+    }
+    std::string full_model_path = directModelPath();
+    return full_model_path.empty() ? "" : LlamaCppInteraction::endpointFor(full_model_path);
+}
+
+std::unique_ptr<LlmInteraction> Core::createBackend() {
+    // Read the backend configuration
+    std::string backend = m_config->getStringValue("backend");
+    if (backend.empty()) {
+        backend = "direct"; // Default to direct if not specified
+    }
+    
+    try {
+        if (backend == "ollama") {
+            // Ollama backend configuration
+            std::string ollama_url = m_config->getStringValue("ollama_url");
+            std::string model_name = m_config->getStringValue("default_model");
+            
+            if (ollama_url.empty() || model_name.empty()) {
+                std::cerr << "[FATAL] `ollama_url` or `default_model` not set in .camus/config.yml" << std::endl;
+                std::cerr << "Please run 'camus init' and edit the configuration file." << std::endl;
+                return nullptr;
             }
-        } catch (const std::exception& e) {
-            std::cerr << "[FATAL] Failed to initialize LLM backend: " << backend << "\n"
-                      << "Error: " << e.what() << std::endl;
-            m_llm = nullptr;
+            
+            std::cout << "[INFO] Using Ollama backend" << std::endl;
+            return std::make_unique<OllamaInteraction>(ollama_url, model_name);
+            
+        } else {
+            // Direct backend configuration (llama.cpp)
+            std::string full_model_path = directModelPath();
+            if (full_model_path.empty()) {
+                std::cerr << "[FATAL] `model_path` or `default_model` not set in .camus/config.yml" << std::endl;
+                std::cerr << "Please run 'camus init' and edit the configuration file." << std::endl;
+                return nullptr;
+            }
+            
+            std::cout << "[INFO] Using direct backend (llama.cpp)" << std::endl;
+            return std::make_unique<LlamaCppInteraction>(full_model_path);
         }
+    } catch (const std::exception& e) {
+        std::cerr << "[FATAL] Failed to initialize LLM backend: " << backend << "\n"
+                  << "Error: " << e.what() << std::endl;
+        return nullptr;
     }
 }
 
 Core::~Core() = default;
 
 int Core::run() {
+    bool daemon_control = m_commands.active_command == "serve" &&
+                          (m_commands.serve_stop || m_commands.serve_status);
     if (m_commands.active_command != "init" && m_commands.active_command != "model" && 
-        !m_commands.active_command.empty() && m_llm == nullptr) {
+        m_commands.active_command != "serve-api" && m_commands.active_command != "push" &&
+        !m_commands.active_command.empty() && !daemon_control && m_llm == nullptr) {
         std::cerr << "LLM not available. Cannot proceed." << std::endl;
         return 1;
     }
@@ -126,6 +268,10 @@ int Core::run() {
         return handlePush();
     } else if (m_commands.active_command == "model") {
         return handleModel();
+    } else if (m_commands.active_command == "serve") {
+        return handleServe();
+    } else if (m_commands.active_command == "serve-api") {
+        return handleServeApi();
     } else if (m_commands.active_command.empty()){
         return 0;
     }
@@ -137,45 +283,7 @@ int Core::run() {
 int Core::handleInit() {
     std::cout << "Initializing Camus configuration..." << std::endl;
     
-    const std::string defaultConfig = R"(# Camus Configuration v1.0
-# Backend configuration: 'direct' for llama.cpp or 'ollama' for Ollama server
-backend: direct
-
-# Direct backend settings (when backend: direct)
-model_path: /path/to/your/models/
-default_model: Llama-3-8B-Instruct.Q4_K_M.gguf
-
-# Ollama backend settings (when backend: ollama)
-ollama_url: http://localhost:11434
-
-# Build and test commands
-build_command: 'cmake --build ./build'
-test_command: 'ctest --test-dir ./build'
-
-# Project scanning settings for 'amodify' command
-amodify:
-  max_files: 100
-  max_tokens: 128000
-  include_extensions:
-    - '.cpp'
-    - '.hpp'
-    - '.h'
-    - '.c'
-    - '.py'
-    - '.js'
-    - '.ts'
-  default_ignore_patterns:
-    - '.git/'
-    - 'build/'
-    - 'node_modules/'
-    - '__pycache__/'
-    - '*.o'
-    - '*.pyc'
-  create_backups: true
-  backup_dir: '.camus/backups'
-  interactive_threshold: 5  # Use interactive mode for >5 files
-  git_check: true          # Check for clean git working directory
-)";
+    const std::string& defaultConfig = ConfigParser::defaultConfig();
 
     const std::string configDir = ".camus";
     const std::string configFile = configDir + "/config.yml";
@@ -283,6 +391,14 @@ int Core::handleModify() {
 }
 
 int Core::handleAmodify() {
+    if (!m_commands.batch_file.empty()) {
+        return handleAmodifyBatch();
+    }
+    if (m_commands.prompt.empty()) {
+        std::cerr << "[ERROR] amodify needs a request, or --batch with a file of requests" << std::endl;
+        return 1;
+    }
+    
     auto start_time = std::chrono::steady_clock::now();
     
     // Initialize logging
@@ -304,36 +420,8 @@ int Core::handleAmodify() {
     }
     
     // Step 1: Scan project files
-    std::cout << "[1/6] Scanning project files..." << std::endl;
-    ProjectScanner scanner(".");
-    
-    // Apply configured extensions and patterns
-    auto extensions = amod_config.getMergedExtensions();
-    for (const auto& ext : extensions) {
-        scanner.addIncludeExtension(ext);
-    }
-    
-    auto ignore_patterns = amod_config.getMergedIgnorePatterns();
-    for (const auto& pattern : ignore_patterns) {
-        scanner.addIgnorePattern(pattern);
-    }
-    
-    // Apply command-line include/exclude patterns if provided
-    if (!m_commands.include_pattern.empty()) {
-        scanner.addIncludeExtension(m_commands.include_pattern);
-    }
-    if (!m_commands.exclude_pattern.empty()) {
-        scanner.addIgnorePattern(m_commands.exclude_pattern);
-    }
-    
-    // Set max file limit from config
-    scanner.setMaxFileSize(100 * 1024); // 100KB per file limit
-    
-    auto discovered_files = scanner.scanFiles();
-    
-    // Log file discovery
-    std::vector<std::string> all_discovered; // In a full implementation, scanner would provide this
-    logger.logFileDiscovery(all_discovered, discovered_files);
+    std::cout << "[1/7] Scanning project files..." << std::endl;
+    auto discovered_files = scanAmodifyFiles(amod_config);
     
     if (discovered_files.empty()) {
         std::cerr << "No relevant files found in the project." << std::endl;
@@ -345,33 +433,70 @@ int Core::handleAmodify() {
         return 1;
     }
     
-    // Limit files if needed
-    if (discovered_files.size() > amod_config.max_files) {
-        std::cout << "[WARN] Found " << discovered_files.size() 
-                  << " files, limiting to " << amod_config.max_files << std::endl;
-        discovered_files.resize(amod_config.max_files);
+    if (amod_config.execution_mode == "fanout") {
+        int exit_code = runAmodifyFanout(discovered_files, amod_config);
+        
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        logger.logSessionEnd("amodify", exit_code, duration.count());
+        logger.flush();
+        return exit_code;
     }
     
     // Step 2: Build context
-    std::cout << "[2/6] Building context from " << discovered_files.size() << " files..." << std::endl;
+    std::cout << "[2/7] Building context from " << discovered_files.size() << " files..." << std::endl;
     ContextBuilder context_builder(amod_config.max_tokens);
+    configureContextBuilder(context_builder, amod_config, selectEditFormat(amod_config));
     
     // Extract keywords from the user request for relevance scoring
-    std::vector<std::string> keywords;
-    std::istringstream iss(m_commands.prompt);
-    std::string word;
-    while (iss >> word) {
-        if (word.length() > 3) { // Only consider words longer than 3 chars
-            keywords.push_back(word);
+    context_builder.setRelevanceKeywords(ContextBuilder::extractKeywords(m_commands.prompt));
+    context_builder.setRetrievalScores(m_retrieval_scores);
+    
+    // In a session the model already holds the earlier turns; only files
+    // that changed since its last answer are sent again
+    std::unique_ptr<ContextSession> session;
+    std::vector<int64_t> backend_context;
+    std::string context; // Prompt sent to the backend
+    std::string turn;    // What this request adds to the conversation
+    if (amod_config.context_session) {
+        ModelMetadata metadata = m_llm->getModelMetadata();
+        session = std::make_unique<ContextSession>(
+            ".camus/sessions", metadata.provider + ":" + metadata.model_path + ":" + metadata.name);
+        session->load(std::chrono::minutes(amod_config.session_ttl_minutes));
+    }
+    bool delta_mode = false;
+    if (session && session->active()) {
+        DeltaContext delta = context_builder.buildDeltaContext(discovered_files, m_commands.prompt,
+                                                               session->snapshot(), session->historyTokens());
+        if (delta.fits) {
+            delta_mode = true;
+            turn = delta.turn;
+            backend_context = session->backendContext();
+            // A backend that returned its own state continues from it; otherwise the
+            // history is resent and prefix caching skips re-reading it
+            context = backend_context.empty() ? session->history() + turn : turn;
+        } else {
+            std::cout << "[INFO] Session history leaves no room for the changes; starting a new session" << std::endl;
+            session->reset();
         }
     }
-    context_builder.setRelevanceKeywords(keywords);
-    
-    std::string context = context_builder.buildContext(discovered_files, m_commands.prompt);
+    if (!delta_mode) {
+        context = context_builder.buildContext(discovered_files, m_commands.prompt);
+        turn = context;
+    }
+    m_minified_sources = context_builder.getMinifiedFiles();
+    reportMinifiedFiles(m_minified_sources);
     
     auto build_stats = context_builder.getLastBuildStats();
-    std::cout << "Context built with " << build_stats["files_included"] 
-              << " files (~" << build_stats["tokens_used"] << " tokens)" << std::endl;
+    if (delta_mode) {
+        std::cout << "Session turn " << session->turns() + 1 << ": resending " << build_stats["files_changed"]
+                  << " changed files (~" << build_stats["tokens_used"] << " new tokens on top of ~"
+                  << build_stats["history_tokens"] << " tokens of history)" << std::endl;
+    } else {
+        std::cout << "Context built with " << build_stats["files_included"] 
+                  << " files (~" << build_stats["tokens_used"] << " tokens, "
+                  << build_stats["budget_utilization_pct"] << "% of the file budget)" << std::endl;
+    }
     
     // Log context building
     logger.logContextBuilding(discovered_files.size(), build_stats["files_included"],
@@ -383,11 +508,13 @@ int Core::handleAmodify() {
     }
     
     // Step 3: Send to LLM
-    std::cout << "[3/6] Sending request to LLM... (this may take a while)" << std::endl;
+    std::cout << "[3/7] Sending request to LLM... (this may take a while)" << std::endl;
     std::string llm_response;
+    bool constrained = false;
     auto llm_start = std::chrono::steady_clock::now();
     try {
-        llm_response = m_llm->getCompletion(context);
+        llm_response = requestAmodifyCompletion(context, amod_config, constrained,
+                                                session ? &backend_context : nullptr);
         auto llm_end = std::chrono::steady_clock::now();
         auto llm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(llm_end - llm_start);
         
@@ -409,13 +536,551 @@ int Core::handleAmodify() {
         return 1;
     }
     
+    std::vector<std::pair<std::string, std::string>> edits;
+    int exit_code = applyAmodifyResponse(llm_response, amod_config, constrained, &edits);
+    
+    if (session) {
+        // Recorded after applying, so the model's own edits are not resent as changes
+        ContextSnapshot seen = context_builder.snapshotAfterEdits(context_builder.getLastSnapshot(), edits);
+        session->recordTurn(turn, llm_response, seen, std::move(backend_context));
+        try {
+            session->save();
+        } catch (const std::exception& e) {
+            std::cerr << "[WARN] Could not save the session: " << e.what() << std::endl;
+        }
+    }
+    
+    // Log session end
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    logger.logSessionEnd("amodify", exit_code, duration.count());
+    logger.flush();
+    
+    return exit_code;
+}
+
+int Core::handleAmodifyBatch() {
+    auto start_time = std::chrono::steady_clock::now();
+    
+    Logger& logger = Logger::getInstance();
+    logger.initialize();
+    logger.logSessionStart("amodify-batch", m_commands.batch_file);
+    
+    // One request per line; blank lines and '#' comments are skipped
+    std::vector<std::string> requests;
+    if (!m_commands.prompt.empty()) {
+        requests.push_back(m_commands.prompt);
+    }
+    std::ifstream batch_stream(m_commands.batch_file);
+    if (!batch_stream.is_open()) {
+        std::cerr << "[ERROR] Could not open batch file: " << m_commands.batch_file << std::endl;
+        return 1;
+    }
+    std::string line;
+    while (std::getline(batch_stream, line)) {
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (!line.empty() && line[0] != '#') {
+            requests.push_back(line);
+        }
+    }
+    if (requests.empty()) {
+        std::cerr << "[ERROR] Batch file contains no requests: " << m_commands.batch_file << std::endl;
+        return 1;
+    }
+    
+    std::cout << "Starting batch project-wide modification (" << requests.size() << " requests)..." << std::endl;
+    
+    AmodifyConfig amod_config;
+    amod_config.loadFromConfig(*m_config);
+    amod_config.applyCommandOverrides(m_commands);
+    
+    if (!amod_config.validate()) {
+        std::cerr << "[ERROR] Invalid amodify configuration" << std::endl;
+        return 1;
+    }
+    
+    std::cout << "[1/7] Scanning project files..." << std::endl;
+    auto discovered_files = scanAmodifyFiles(amod_config);
+    if (discovered_files.empty()) {
+        std::cerr << "No relevant files found in the project." << std::endl;
+        logger.error("ProjectScanner", "No relevant files found in project");
+        
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        logger.logSessionEnd("amodify-batch", 1, duration.count());
+        return 1;
+    }
+    
+    // The project context is scanned, loaded and formatted once; every
+    // request reuses it as a byte-identical prompt prefix so a backend with
+    // prefix caching only prefills it for the first request
+    std::cout << "[2/7] Building shared context from " << discovered_files.size() << " files..." << std::endl;
+    const EditFormat edit_format = selectEditFormat(amod_config);
+    ContextBuilder context_builder(amod_config.max_tokens);
+    configureContextBuilder(context_builder, amod_config, edit_format);
+    BatchContext batch = context_builder.buildBatchContext(discovered_files, requests);
+    const auto batch_minified = context_builder.getMinifiedFiles();
+    m_minified_sources = batch_minified;
+    reportMinifiedFiles(m_minified_sources);
+    
+    auto build_stats = context_builder.getLastBuildStats();
+    std::cout << "Shared context built with " << build_stats["files_included"] 
+              << " files (~" << build_stats["shared_prefix_tokens"] << " tokens)" << std::endl;
+    logger.logContextBuilding(discovered_files.size(), build_stats["files_included"],
+                             build_stats["tokens_used"], build_stats["files_truncated"]);
+    
+    std::cout << "[3/7] Running " << requests.size() << " requests against the shared context..." << std::endl;
+    auto complete = [this, &amod_config, &logger](const std::string& prompt, bool& constrained, std::string& response) {
+        size_t prompt_tokens = (prompt.size() + 3) / 4;
+        auto llm_start = std::chrono::steady_clock::now();
+        try {
+            response = requestAmodifyCompletion(prompt, amod_config, constrained);
+            auto llm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - llm_start);
+            logger.logLlmInteraction(prompt_tokens, response.size(), llm_duration.count(), true);
+            return true;
+        } catch (const std::exception& e) {
+            auto llm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - llm_start);
+            logger.logLlmInteraction(prompt_tokens, 0, llm_duration.count(), false);
+            logger.error("LLM", "Request failed", e.what());
+            std::cerr << "[ERROR] LLM request failed: " << e.what() << std::endl;
+            return false;
+        }
+    };
+    
+    // Files written by earlier requests; the shared context still shows their old content
+    std::unordered_set<std::string> changed_files;
+    size_t failed = 0;
+    size_t rerun = 0;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        std::cout << "\n=== Request " << (i + 1) << "/" << requests.size() << ": " 
+                  << requests[i] << " ===" << std::endl;
+        
+        std::string llm_response;
+        bool constrained = false;
+        if (!complete(batch.prompt(i), constrained, llm_response)) {
+            failed++;
+            continue;
+        }
+        // Minified files changed by an earlier request are rejected by the
+        // parser before they show up as modifications; they are stale too
+        std::vector<std::string> stale;
+        auto modifications = parseAmodifyResponse(llm_response, constrained, &stale);
+        
+        // Whole files written from the old content would silently revert the
+        // earlier edit, so such a request runs again on the files as they are now
+        for (const auto& modification : modifications) {
+            if (changed_files.count(modification.file_path)) {
+                stale.push_back(modification.file_path);
+            }
+        }
+        if (!stale.empty()) {
+            std::cout << "[INFO] Request " << (i + 1) << " edits " << stale.size() 
+                      << " files an earlier request changed (" << stale.front() 
+                      << (stale.size() > 1 ? ", ..." : "") << "); re-running it against their current content" << std::endl;
+            rerun++;
+            ContextBuilder fresh_builder(amod_config.max_tokens);
+            configureContextBuilder(fresh_builder, amod_config, edit_format);
+            fresh_builder.setRelevanceKeywords(ContextBuilder::extractKeywords(requests[i]));
+            std::string fresh_prompt = fresh_builder.buildContext(discovered_files, requests[i]);
+            m_minified_sources = fresh_builder.getMinifiedFiles();
+            modifications.clear();
+            if (complete(fresh_prompt, constrained, llm_response)) {
+                modifications = parseAmodifyResponse(llm_response, constrained);
+            }
+            m_minified_sources = batch_minified;
+        }
+        if (modifications.empty()) {
+            failed++;
+            continue;
+        }
+        
+        std::vector<std::pair<std::string, std::string>> edits;
+        for (const auto& modification : modifications) {
+            edits.emplace_back(modification.file_path, modification.new_content);
+        }
+        if (applyAmodifyModifications(std::move(modifications), amod_config) != 0) {
+            failed++;
+        }
+        for (const auto& edit : edits) {
+            if (fileHasContent(edit.first, edit.second)) {
+                changed_files.insert(edit.first);
+            }
+        }
+    }
+    
+    if (rerun > 0) {
+        std::cout << "\n" << rerun << " requests were re-run because an earlier request had changed their files." << std::endl;
+    }
+    
+    std::cout << "\nBatch finished: " << (requests.size() - failed) << " of " 
+              << requests.size() << " requests succeeded." << std::endl;
+    
+    int exit_code = failed == 0 ? 0 : 1;
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    logger.logSessionEnd("amodify-batch", exit_code, duration.count());
+    logger.flush();
+    
+    return exit_code;
+}
+
+int Core::runAmodifyFanout(const std::vector<std::string>& discovered_files, const AmodifyConfig& amod_config) {
+    Logger& logger = Logger::getInstance();
+    
+    // Step 2: Plan tasks; each prompt is the shared outline plus its own files
+    std::cout << "[2/7] Planning per-file tasks over " << discovered_files.size() << " files..." << std::endl;
+    ContextBuilder context_builder(amod_config.fanout_task_tokens);
+    configureContextBuilder(context_builder, amod_config, selectEditFormat(amod_config));
+    context_builder.setRelevanceKeywords(ContextBuilder::extractKeywords(m_commands.prompt));
+    context_builder.setRetrievalScores(m_retrieval_scores);
+    FanoutContext fanout = context_builder.buildFanoutContext(discovered_files, m_commands.prompt,
+                                                              amod_config.fanout_files_per_task);
+    reportMinifiedFiles(context_builder.getMinifiedFiles());
+    
+    auto build_stats = context_builder.getLastBuildStats();
+    logger.logContextBuilding(discovered_files.size(), build_stats["files_included"],
+                             build_stats["tokens_used"], build_stats["files_truncated"]);
+    if (fanout.tasks.empty()) {
+        std::cerr << "[ERROR] No fan-out tasks could be planned" << std::endl;
+        return 1;
+    }
+    std::cout << "Planned " << fanout.tasks.size() << " tasks over " << build_stats["files_included"] 
+              << " files (~" << build_stats["shared_prefix_tokens"] << " shared tokens each)" << std::endl;
+    
+    // Step 3: Run the tasks concurrently across the models in models.yml
+    RegistryConfig registry_config;
+    registry_config.config_file_path = ".camus/models.yml";
+    registry_config.enable_health_checks = false;
+    registry_config.auto_discover = false;
+    ModelRegistry registry(registry_config);
+    
+    // The configured backend is already loaded; models.yml entries for the same
+    // model use it rather than a second copy of the weights
+    if (m_llm) {
+        std::shared_ptr<LlmInteraction> configured(std::shared_ptr<LlmInteraction>(), m_llm.get()); // Not owned
+        if (m_config->getStringValue("backend") == "ollama") {
+            registry.shareInstance("ollama", m_config->getStringValue("ollama_url") + "|" +
+                                   m_config->getStringValue("default_model"), configured);
+        } else if (!directModelPath().empty()) {
+            registry.shareInstance("llama_cpp", directModelPath(), configured);
+        }
+    }
+    if (m_sys->fileExists(registry_config.config_file_path)) {
+        registry.loadFromConfig(registry_config.config_file_path);
+    }
+    
+    std::vector<std::string> models;
+    auto loaded = registry.getLoadedModels();
+    std::istringstream wanted(amod_config.fanout_models);
+    std::string name;
+    while (std::getline(wanted, name, ',')) {
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t") + 1);
+        if (name.empty()) {
+            continue;
+        }
+        if (std::find(loaded.begin(), loaded.end(), name) != loaded.end()) {
+            models.push_back(name);
+        } else {
+            std::cerr << "[WARN] Fan-out model not loaded: " << name << std::endl;
+        }
+    }
+    if (amod_config.fanout_models.empty()) {
+        models = loaded;
+    }
+    std::sort(models.begin(), models.end()); // Stable task placement across runs
+    
+    std::vector<std::string> responses(fanout.tasks.size());
+    std::vector<bool> succeeded(fanout.tasks.size(), false);
+    std::vector<bool> constrained(fanout.tasks.size(), false); // Backend enforced the FILE block format
+    auto llm_start = std::chrono::steady_clock::now();
+    
+    if (models.empty()) {
+        // Without models.yml the configured backend is the only instance
+        std::cout << "[3/7] Running " << fanout.tasks.size() 
+                  << " tasks on the configured backend (add models to .camus/models.yml to run them concurrently)..." << std::endl;
+        for (size_t i = 0; i < fanout.tasks.size(); ++i) {
+            try {
+                bool enforced = false;
+                responses[i] = requestAmodifyCompletion(fanout.prompt(i), amod_config, enforced);
+                constrained[i] = enforced;
+                succeeded[i] = true;
+            } catch (const std::exception& e) {
+                std::cerr << "[ERROR] " << fanout.tasks[i].task_id << " failed: " << e.what() << std::endl;
+            }
+        }
+    } else {
+        std::cout << "[3/7] Running " << fanout.tasks.size() << " tasks across " << models.size() 
+                  << " models..." << std::endl;
+        
+        ParallelStrategyConfig strategy_config;
+        strategy_config.max_concurrent_executions = amod_config.fanout_concurrency;
+        strategy_config.thread_pool_size = amod_config.fanout_concurrency;
+        strategy_config.enable_dependency_resolution = false;
+        ParallelStrategy strategy(registry, strategy_config);
+        
+        ParallelRequest request;
+        request.request_id = "amodify-fanout";
+        request.prompt = m_commands.prompt;
+        request.pattern = ParallelPattern::FILE_ANALYSIS;
+        request.aggregation_method = AggregationMethod::CONCATENATE;
+        request.max_concurrent_tasks = amod_config.fanout_concurrency;
+        request.min_success_ratio = 0.0; // Partial results are merged; failures are reported below
+        request.timeout = std::chrono::seconds(amod_config.fanout_timeout_seconds);
+        for (size_t i = 0; i < fanout.tasks.size(); ++i) {
+            ParallelSubtask subtask;
+            subtask.subtask_id = fanout.tasks[i].task_id;
+            subtask.model_name = models[i % models.size()];
+            subtask.description = "Edit " + std::to_string(fanout.tasks[i].files.size()) + " files";
+            subtask.prompt = fanout.prompt(i);
+            subtask.timeout = std::chrono::seconds(amod_config.fanout_timeout_seconds);
+            if (amod_config.constrained_output) {
+                // As in the single path: whole files come back, so the default limit would truncate them
+                subtask.constraint = ResponseConstraint::FILE_BLOCKS;
+                subtask.max_tokens = amod_config.max_output_tokens;
+            }
+            request.subtasks.push_back(std::move(subtask));
+        }
+        
+        ParallelResponse parallel = strategy.execute(request);
+        for (const auto& result : parallel.subtask_results) {
+            for (size_t i = 0; i < fanout.tasks.size(); ++i) {
+                if (fanout.tasks[i].task_id != result.subtask_id) {
+                    continue;
+                }
+                if (result.success) {
+                    responses[i] = result.result_text;
+                    succeeded[i] = true;
+                    auto constraint = result.metadata.find("constraint");
+                    constrained[i] = constraint != result.metadata.end() &&
+                                     constraint->second == FileBlockFormat::CONSTRAINT_NAME;
+                } else {
+                    std::cerr << "[ERROR] " << result.subtask_id << " failed on " << result.model_used 
+                              << ": " << result.error_message << std::endl;
+                }
+            }
+        }
+        if (parallel.speedup_factor > 1.0) {
+            std::cout << "Tasks ran " << std::fixed << std::setprecision(1) << parallel.speedup_factor 
+                      << "x faster than one after another" << std::endl;
+        }
+    }
+    
+    auto llm_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - llm_start);
+    size_t response_size = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < responses.size(); ++i) {
+        response_size += responses[i].size();
+        failed += succeeded[i] ? 0 : 1;
+    }
+    logger.logLlmInteraction(build_stats["tokens_used"], response_size, llm_duration.count(), failed == 0);
+    
+    // Step 4: Parse each task's answer and merge them into one change set
+    std::cout << "[4/7] Merging task results..." << std::endl;
+    std::vector<std::vector<FileModification>> task_modifications(fanout.tasks.size());
+    for (size_t i = 0; i < fanout.tasks.size(); ++i) {
+        if (!succeeded[i] || responses[i].find("--- ") == std::string::npos) {
+            continue; // Failed, or nothing to change in this task
+        }
+        ResponseParser parser(".");
+        parser.setStrictValidation(true);
+        parser.setConstrainedFormat(constrained[i]);
+        parser.setMinifiedSources(context_builder.getMinifiedFiles());
+        task_modifications[i] = parser.parseResponse(responses[i]);
+        for (const auto& error : parser.getLastParseStats().error_messages) {
+            std::cerr << "[WARN] " << fanout.tasks[i].task_id << ": " << error << std::endl;
+        }
+    }
+    
+    std::vector<std::string> conflicts;
+    auto modifications = AmodifyFanout::mergeResults(fanout.tasks, task_modifications, conflicts);
+    for (const auto& conflict : conflicts) {
+        std::cerr << "[WARN] " << conflict << std::endl;
+    }
+    if (failed > 0) {
+        std::cerr << "[WARN] " << failed << " of " << fanout.tasks.size() 
+                  << " tasks failed; their files are left unchanged" << std::endl;
+    }
+    if (modifications.empty()) {
+        std::cout << "No task proposed any changes." << std::endl;
+        return failed == 0 ? 0 : 1;
+    }
+    std::cout << "Merged " << modifications.size() << " file modifications from " 
+              << (fanout.tasks.size() - failed) << " tasks" << std::endl;
+    
+    int exit_code = applyAmodifyModifications(std::move(modifications), amod_config);
+    return exit_code == 0 && failed > 0 ? 1 : exit_code;
+}
+
+std::vector<std::string> Core::scanAmodifyFiles(const AmodifyConfig& amod_config) {
+    Logger& logger = Logger::getInstance();
+    ProjectScanner scanner(".");
+    
+    // Apply configured extensions and patterns
+    auto extensions = amod_config.getMergedExtensions();
+    for (const auto& ext : extensions) {
+        scanner.addIncludeExtension(ext);
+    }
+    
+    auto ignore_patterns = amod_config.getMergedIgnorePatterns();
+    for (const auto& pattern : ignore_patterns) {
+        scanner.addIgnorePattern(pattern);
+    }
+    
+    // Apply command-line include/exclude patterns if provided
+    if (!m_commands.include_pattern.empty()) {
+        scanner.addIncludeExtension(m_commands.include_pattern);
+    }
+    if (!m_commands.exclude_pattern.empty()) {
+        scanner.addIgnorePattern(m_commands.exclude_pattern);
+    }
+    
+    // Set max file limit from config
+    scanner.setMaxFileSize(100 * 1024); // 100KB per file limit
+    
+    m_retrieval_scores.clear();
+    auto discovered_files = amod_config.retrieval && !m_commands.prompt.empty()
+                                ? retrieveAmodifyFiles(scanner, amod_config)
+                                : scanner.scanFiles();
+    
+    // Log file discovery
+    std::vector<std::string> all_discovered; // In a full implementation, scanner would provide this
+    logger.logFileDiscovery(all_discovered, discovered_files);
+    
+    if (discovered_files.empty()) {
+        return discovered_files;
+    }
+    
+    // Limit files if needed
+    if (discovered_files.size() > amod_config.max_files) {
+        std::cout << "[WARN] Found " << discovered_files.size() 
+                  << " files, limiting to " << amod_config.max_files << std::endl;
+        discovered_files.resize(amod_config.max_files);
+    }
+    
+    return discovered_files;
+}
+
+std::vector<std::string> Core::retrieveAmodifyFiles(ProjectScanner& scanner, const AmodifyConfig& amod_config) {
+    Logger& logger = Logger::getInstance();
+    ScanDelta delta;
+    try {
+        LlamaCppEmbedder embedder(amod_config.embedding_model_path);
+        EmbeddingIndex index(amod_config.retrieval_index_dir, embedder);
+        index.load();
+        
+        // Only files that changed since the last run are embedded again
+        delta = scanner.scanChanges(index.knownFiles());
+        if (!delta.changed.empty() || !delta.removed.empty()) {
+            std::cout << "[INFO] Updating retrieval index: " << delta.changed.size() << " changed, "
+                      << delta.removed.size() << " removed files" << std::endl;
+            auto stats = index.update(delta);
+            index.save();
+            logger.info("Retrieval", "Index updated", std::to_string(stats.chunks_embedded) + " chunks embedded, " +
+                        std::to_string(stats.chunks_removed) + " removed");
+        }
+        
+        auto query_start = std::chrono::steady_clock::now();
+        auto hits = index.query(m_commands.prompt, amod_config.retrieval_top_k);
+        auto query_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - query_start).count();
+        m_retrieval_scores = EmbeddingIndex::fileScores(hits);
+        std::cout << "[INFO] Retrieved " << hits.size() << " chunks from " << m_retrieval_scores.size()
+                  << " files in " << query_ms << " ms" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "[WARN] Retrieval unavailable, using keyword ranking: " << e.what() << std::endl;
+        logger.warning("Retrieval", "Retrieval unavailable", e.what());
+        m_retrieval_scores.clear();
+        if (delta.files.empty()) {
+            return scanner.scanFiles();
+        }
+    }
+    
+    // Most similar first; the rest keep their alphabetical order
+    std::vector<std::string> files = delta.files;
+    auto score_of = [this](const std::string& path) {
+        auto it = m_retrieval_scores.find(path);
+        return it != m_retrieval_scores.end() ? it->second : -1.0;
+    };
+    std::stable_sort(files.begin(), files.end(), [&](const std::string& a, const std::string& b) {
+        return score_of(a) > score_of(b);
+    });
+    if (amod_config.retrieval_max_files > 0 && !m_retrieval_scores.empty() &&
+        files.size() > amod_config.retrieval_max_files) {
+        files.resize(amod_config.retrieval_max_files);
+    }
+    return files;
+}
+
+EditFormat Core::selectEditFormat(const AmodifyConfig& amod_config) const {
+    // The grammar only describes FILE blocks
+    if (amod_config.constrained_output) {
+        return EditFormat::WHOLE_FILE;
+    }
+    if (amod_config.edit_format != "auto") {
+        return EditApplier::parseFormat(amod_config.edit_format);
+    }
+    const auto attributes = m_llm->getModelMetadata().custom_attributes;
+    auto it = attributes.find("edit_format");
+    return it != attributes.end() ? EditApplier::parseFormat(it->second) : EditFormat::WHOLE_FILE;
+}
+
+void Core::configureContextBuilder(ContextBuilder& builder, const AmodifyConfig& amod_config,
+                                   EditFormat edit_format) const {
+    builder.setEditFormat(edit_format);
+    builder.setReservedTokens(amod_config.max_output_tokens);
+    builder.setDeduplication(amod_config.deduplicate_files);
+    builder.setNearDuplicateThreshold(amod_config.near_duplicate_threshold);
+    builder.setMinification(amod_config.minify_context);
+}
+
+std::string Core::requestAmodifyCompletion(const std::string& prompt, const AmodifyConfig& amod_config,
+                                           bool& constrained, std::vector<int64_t>* backend_context) {
+    constrained = false;
+    if (!amod_config.constrained_output && !backend_context) {
+        return m_llm->getCompletion(prompt);
+    }
+    
+    // Backends without constrained decoding ignore the field; the
+    // response metadata says whether the format was really enforced
+    InferenceRequest request;
+    request.prompt = prompt;
+    if (amod_config.constrained_output) {
+        request.constraint = ResponseConstraint::FILE_BLOCKS;
+    }
+    request.max_tokens = amod_config.max_output_tokens; // Whole files come back; the default would truncate them
+    request.temperature = 0.4; // As getCompletion() samples; code edits want low variance
+    if (backend_context) {
+        request.context_tokens = *backend_context;
+    }
+    InferenceResponse response = m_llm->getCompletionWithMetadata(request);
+    
+    auto it = response.metadata.find("constraint");
+    constrained = it != response.metadata.end() && it->second == FileBlockFormat::CONSTRAINT_NAME;
+    if (backend_context) {
+        *backend_context = std::move(response.context_tokens);
+    }
+    return response.text;
+}
+
+std::vector<FileModification> Core::parseAmodifyResponse(const std::string& llm_response, bool constrained,
+                                                         std::vector<std::string>* changed_since_sent) {
     // Step 4: Parse response
-    std::cout << "[4/6] Parsing LLM response..." << std::endl;
+    std::cout << "[4/7] Parsing LLM response..." << std::endl;
     ResponseParser parser(".");
     parser.setStrictValidation(true);
+    parser.setConstrainedFormat(constrained);
+    parser.setMinifiedSources(m_minified_sources);
     
     auto modifications = parser.parseResponse(llm_response);
     auto parse_stats = parser.getLastParseStats();
+    if (changed_since_sent) {
+        *changed_since_sent = parse_stats.changed_since_sent;
+    }
     
     if (modifications.empty()) {
         std::cerr << "[ERROR] No valid file modifications found in LLM response." << std::endl;
@@ -425,10 +1090,31 @@ int Core::handleAmodify() {
                 std::cerr << "  - " << error << std::endl;
             }
         }
-        return 1;
+        return modifications;
     }
     
     std::cout << "Parsed " << modifications.size() << " file modifications" << std::endl;
+    return modifications;
+}
+
+int Core::applyAmodifyResponse(const std::string& llm_response, const AmodifyConfig& amod_config,
+                               bool constrained, std::vector<std::pair<std::string, std::string>>* edits) {
+    auto modifications = parseAmodifyResponse(llm_response, constrained);
+    if (modifications.empty()) {
+        return 1;
+    }
+    if (edits) {
+        for (const auto& modification : modifications) {
+            edits->emplace_back(modification.file_path, modification.new_content);
+        }
+    }
+    
+    return applyAmodifyModifications(std::move(modifications), amod_config);
+}
+
+int Core::applyAmodifyModifications(std::vector<FileModification> modifications,
+                                    const AmodifyConfig& amod_config) {
+    Logger& logger = Logger::getInstance();
     
     // Step 5: Safety checks
     std::cout << "[5/7] Performing safety checks..." << std::endl;
@@ -580,12 +1266,6 @@ int Core::handleAmodify() {
         }
     }
     
-    // Log session end
-    auto end_time = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    logger.logSessionEnd("amodify", exit_code, duration.count());
-    logger.flush();
-    
     return exit_code;
 }
 
@@ -606,28 +1286,9 @@ int Core::handleBuild() {
         return 1;
     }
     
-    // Parse the build command into executable and arguments
-    std::vector<std::string> command_parts;
-    std::stringstream ss(build_command);
-    std::string part;
-    bool in_quotes = false;
-    std::string current_part;
-    
-    for (char c : build_command) {
-        if (c == '\'' || c == '"') {
-            in_quotes = !in_quotes;
-        } else if (c == ' ' && !in_quotes) {
-            if (!current_part.empty()) {
-                command_parts.push_back(current_part);
-                current_part.clear();
-            }
-        } else {
-            current_part += c;
-        }
-    }
-    if (!current_part.empty()) {
-        command_parts.push_back(current_part);
-    }
+    // Parse the build command into executable and arguments, appending any
+    // passthrough arguments from the user. Shell syntax runs under /bin/sh
+    std::vector<std::string> command_parts = ProcessRunner::commandArgv(build_command, m_commands.passthrough_args);
     
     if (command_parts.empty()) {
         std::cerr << "Error: Invalid build command format" << std::endl;
@@ -638,20 +1299,35 @@ int Core::handleBuild() {
     std::string cmd = command_parts[0];
     std::vector<std::string> args(command_parts.begin() + 1, command_parts.end());
     
-    // Add any passthrough arguments from the user
-    args.insert(args.end(), m_commands.passthrough_args.begin(), m_commands.passthrough_args.end());
-    
     std::cout << "Running: " << cmd;
     for (const auto& arg : args) {
         std::cout << " " << arg;
     }
     std::cout << std::endl;
     
-    // Execute the build command
-    auto [output, exit_code] = m_sys->executeCommand(cmd, args);
+    // Execute the build command, streaming its output as it runs
+    ProcessOptions options = makeCommandOptions(*m_config, "build_timeout");
+    
+    // Reduce the output as it streams so only the relevant diagnostics
+    // are sent to the LLM, however large the log grows
+    LogReducer reducer;
+    options.output_callback = [&reducer](OutputStream stream, const char* data, size_t length) {
+        reducer.feed(data, length, stream);
+    };
+    
+    ProcessResult result;
+    try {
+        result = m_sys->runCommand(cmd, args, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
     
-    // Display the output
-    std::cout << output << std::endl;
+    int exit_code = result.exit_code;
+    
+    if (result.timed_out) {
+        std::cerr << "Build timed out after " << options.timeout.count() / 1000 << "s and was terminated" << std::endl;
+    }
     
     if (exit_code == 0) {
         std::cout << "Build completed successfully!" << std::endl;
@@ -661,12 +1337,16 @@ int Core::handleBuild() {
         // If build failed, use LLM to analyze the error
         std::cout << "\nAnalyzing build errors..." << std::endl;
         
+        std::string reduced_output = reducer.finish();
+        std::cout << "[INFO] Reduced " << result.total_output_bytes << " bytes of output to "
+                  << reduced_output.size() << " bytes for analysis" << std::endl;
+        
         std::stringstream prompt_stream;
         prompt_stream << "The following build command failed. Analyze the error output and suggest a fix. "
                       << "Be specific about what caused the error and how to fix it.\n\n"
                       << "Build Command: " << build_command << "\n\n"
-                      << "Error Output:\n"
-                      << output;
+                      << "Error Output (reduced to the relevant diagnostics):\n"
+                      << reduced_output;
         
         std::string analysis = m_llm->getCompletion(prompt_stream.str());
         
@@ -692,28 +1372,9 @@ int Core::handleTest() {
         return 1;
     }
     
-    // Parse the test command into executable and arguments
-    std::vector<std::string> command_parts;
-    std::stringstream ss(test_command);
-    std::string part;
-    bool in_quotes = false;
-    std::string current_part;
-    
-    for (char c : test_command) {
-        if (c == '\'' || c == '"') {
-            in_quotes = !in_quotes;
-        } else if (c == ' ' && !in_quotes) {
-            if (!current_part.empty()) {
-                command_parts.push_back(current_part);
-                current_part.clear();
-            }
-        } else {
-            current_part += c;
-        }
-    }
-    if (!current_part.empty()) {
-        command_parts.push_back(current_part);
-    }
+    // Parse the test command into executable and arguments, appending any
+    // passthrough arguments from the user. Shell syntax runs under /bin/sh
+    std::vector<std::string> command_parts = ProcessRunner::commandArgv(test_command, m_commands.passthrough_args);
     
     if (command_parts.empty()) {
         std::cerr << "Error: Invalid test command format" << std::endl;
@@ -724,20 +1385,35 @@ int Core::handleTest() {
     std::string cmd = command_parts[0];
     std::vector<std::string> args(command_parts.begin() + 1, command_parts.end());
     
-    // Add any passthrough arguments from the user
-    args.insert(args.end(), m_commands.passthrough_args.begin(), m_commands.passthrough_args.end());
-    
     std::cout << "Running: " << cmd;
     for (const auto& arg : args) {
         std::cout << " " << arg;
     }
     std::cout << std::endl;
     
-    // Execute the test command
-    auto [output, exit_code] = m_sys->executeCommand(cmd, args);
+    // Execute the test command, streaming its output as it runs
+    ProcessOptions options = makeCommandOptions(*m_config, "test_timeout");
     
-    // Display the output
-    std::cout << output << std::endl;
+    // Reduce the output as it streams so only the relevant diagnostics
+    // are sent to the LLM, however large the log grows
+    LogReducer reducer;
+    options.output_callback = [&reducer](OutputStream stream, const char* data, size_t length) {
+        reducer.feed(data, length, stream);
+    };
+    
+    ProcessResult result;
+    try {
+        result = m_sys->runCommand(cmd, args, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    int exit_code = result.exit_code;
+    
+    if (result.timed_out) {
+        std::cerr << "Test timed out after " << options.timeout.count() / 1000 << "s and was terminated" << std::endl;
+    }
     
     if (exit_code == 0) {
         std::cout << "All tests passed!" << std::endl;
@@ -747,12 +1423,16 @@ int Core::handleTest() {
         // If tests failed, use LLM to analyze the failure
         std::cout << "\nAnalyzing test failures..." << std::endl;
         
+        std::string reduced_output = reducer.finish();
+        std::cout << "[INFO] Reduced " << result.total_output_bytes << " bytes of output to "
+                  << reduced_output.size() << " bytes for analysis" << std::endl;
+        
         std::stringstream prompt_stream;
         prompt_stream << "The following test command failed. Analyze the test output and suggest fixes for the failing tests. "
                       << "Be specific about what tests failed, why they failed, and how to fix them.\n\n"
                       << "Test Command: " << test_command << "\n\n"
-                      << "Test Output:\n"
-                      << output;
+                      << "Test Output (reduced to the relevant diagnostics):\n"
+                      << reduced_output;
         
         std::string analysis = m_llm->getCompletion(prompt_stream.str());
         
@@ -840,6 +1520,13 @@ int Core::handlePush() {
 }
 
 int Core::handleModel() {
+    // A running daemon keeps its registry loaded between invocations
+    if (m_daemon) {
+        auto [output, exit_code] = m_daemon->runModelCommand(m_commands.model_subcommand, m_commands.model_name);
+        std::cout << output;
+        return exit_code;
+    }
+
     // Create model registry with configuration
     RegistryConfig registry_config;
     registry_config.config_file_path = ".camus/models.yml";
@@ -849,82 +1536,171 @@ int Core::handleModel() {
     
     ModelRegistry registry(registry_config);
     
-    if (m_commands.model_subcommand == "list") {
+    return runModelCommand(registry, m_commands.model_subcommand, m_commands.model_name, std::cout);
+}
+
+int Core::runModelCommand(ModelRegistry& registry, const std::string& subcommand,
+                          const std::string& model_name, std::ostream& out) {
+    if (subcommand == "list") {
         // List all models
-        std::cout << registry.getAllModelsInfo() << std::endl;
+        out << registry.getAllModelsInfo() << std::endl;
         return 0;
         
-    } else if (m_commands.model_subcommand == "test") {
+    } else if (subcommand == "test") {
         // Test model(s)
-        if (m_commands.model_name.empty()) {
+        if (model_name.empty()) {
             // Test all models
             auto model_ids = registry.getLoadedModels();
             if (model_ids.empty()) {
-                std::cout << "No models loaded to test." << std::endl;
+                out << "No models loaded to test." << std::endl;
                 return 1;
             }
             
-            std::cout << "Testing all " << model_ids.size() << " loaded models...\n" << std::endl;
+            out << "Testing all " << model_ids.size() << " loaded models...\n" << std::endl;
             
             bool all_passed = true;
             for (const auto& model_id : model_ids) {
-                std::cout << "Testing model: " << model_id << "..." << std::endl;
+                out << "Testing model: " << model_id << "..." << std::endl;
                 auto [success, duration] = registry.testModel(model_id);
                 
                 if (success) {
-                    std::cout << "✓ " << model_id << " test passed (" 
-                              << duration.count() << "ms)" << std::endl;
+                    out << "✓ " << model_id << " test passed (" 
+                        << duration.count() << "ms)" << std::endl;
                 } else {
-                    std::cout << "✗ " << model_id << " test failed" << std::endl;
+                    out << "✗ " << model_id << " test failed" << std::endl;
                     all_passed = false;
                 }
-                std::cout << std::endl;
+                out << std::endl;
             }
             
             return all_passed ? 0 : 1;
         } else {
             // Test specific model
-            std::cout << "Testing model: " << m_commands.model_name << "..." << std::endl;
-            auto [success, duration] = registry.testModel(m_commands.model_name);
+            out << "Testing model: " << model_name << "..." << std::endl;
+            auto [success, duration] = registry.testModel(model_name);
             
             if (success) {
-                std::cout << "✓ Test passed (" << duration.count() << "ms)" << std::endl;
+                out << "✓ Test passed (" << duration.count() << "ms)" << std::endl;
                 return 0;
             } else {
-                std::cout << "✗ Test failed" << std::endl;
+                out << "✗ Test failed" << std::endl;
                 return 1;
             }
         }
         
-    } else if (m_commands.model_subcommand == "info") {
+    } else if (subcommand == "info") {
         // Get model info
-        std::cout << registry.getModelInfo(m_commands.model_name) << std::endl;
+        out << registry.getModelInfo(model_name) << std::endl;
         return 0;
         
-    } else if (m_commands.model_subcommand == "reload") {
+    } else if (subcommand == "reload") {
         // Reload configuration
-        std::cout << "Reloading model configuration..." << std::endl;
+        out << "Reloading model configuration..." << std::endl;
         auto status = registry.reloadConfiguration();
         
-        std::cout << "\nReload complete:" << std::endl;
-        std::cout << "  Total configured: " << status.total_configured << std::endl;
-        std::cout << "  Successfully loaded: " << status.successfully_loaded << std::endl;
-        std::cout << "  Failed to load: " << status.failed_to_load << std::endl;
+        out << "\nReload complete:" << std::endl;
+        out << "  Total configured: " << status.total_configured << std::endl;
+        out << "  Successfully loaded: " << status.successfully_loaded << std::endl;
+        out << "  Failed to load: " << status.failed_to_load << std::endl;
         
         if (status.failed_to_load > 0) {
-            std::cout << "\nFailed models:" << std::endl;
+            out << "\nFailed models:" << std::endl;
             for (const auto& result : status.load_results) {
                 if (!result.success) {
-                    std::cout << "  - " << result.model_id << ": " 
-                              << result.error_message << std::endl;
+                    out << "  - " << result.model_id << ": " 
+                        << result.error_message << std::endl;
                 }
             }
         }
         
         return status.failed_to_load > 0 ? 1 : 0;
         
+    } else if (subcommand == "unload") {
+        // Only Ollama keeps models resident outside our own processes
+        auto ollama = std::dynamic_pointer_cast<OllamaInteraction>(registry.getModel(model_name));
+        if (!ollama) {
+            out << "Not an Ollama model: " << model_name << std::endl;
+            return 1;
+        }
+        if (!ollama->unloadFromServer()) {
+            out << "✗ The Ollama server did not unload " << model_name << std::endl;
+            return 1;
+        }
+        out << "✓ Unloaded " << model_name << std::endl;
+        return 0;
+        
     } else {
-        std::cerr << "Unknown model subcommand: " << m_commands.model_subcommand << std::endl;
+        out << "Unknown model subcommand: " << subcommand << std::endl;
+        return 1;
+    }
+}
+
+int Core::handleServe() {
+    std::string socket_path = daemonSocketPath(*m_config);
+
+    if (m_commands.serve_stop || m_commands.serve_status) {
+        auto client = DaemonClient::connect(socket_path);
+        if (!client) {
+            std::cout << "No camus daemon is running on " << socket_path << std::endl;
+            return 1;
+        }
+        if (m_commands.serve_status) {
+            std::cout << client->getStatus() << std::endl;
+            return 0;
+        }
+        if (!client->requestShutdown()) {
+            std::cerr << "[ERROR] camus daemon did not acknowledge the shutdown request." << std::endl;
+            return 1;
+        }
+        std::cout << "[INFO] camus daemon (pid " << client->getDaemonPid() << ") is shutting down." << std::endl;
+        return 0;
+    }
+
+    DaemonConfig daemon_config;
+    daemon_config.socket_path = socket_path;
+    try {
+        CamusDaemon daemon(*m_llm, daemon_config);
+        return daemon.run();
+    } catch (const std::exception& e) {
+        std::cerr << "[FATAL] " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int Core::handleServeApi() {
+    RegistryConfig registry_config;
+    registry_config.config_file_path = ".camus/models.yml";
+    registry_config.auto_discover = true;
+    registry_config.validate_on_load = true;
+    registry_config.enable_health_checks = true; // Long-running: keep model health current
+
+    ApiServerConfig server_config;
+    server_config.host = m_commands.api_host;
+    server_config.port = m_commands.api_port;
+    server_config.queue.worker_threads = m_commands.api_workers;
+    server_config.queue.max_queue_size = m_commands.api_queue;
+    server_config.queue.max_requests_per_client = m_commands.api_per_client;
+
+    // Optional bearer token from config.yml
+    std::string api_key = m_config->getStringValue("api_key");
+    if (!api_key.empty()) {
+        server_config.api_keys.push_back(api_key);
+    } else if (server_config.host != "127.0.0.1" && server_config.host != "localhost") {
+        std::cerr << "[WARN] Serving on " << server_config.host
+                  << " without authentication; set `api_key` in .camus/config.yml" << std::endl;
+    }
+
+    try {
+        ModelRegistry registry(registry_config);
+        if (registry.getLoadedModels().empty()) {
+            std::cerr << "[FATAL] No models could be loaded from .camus/models.yml" << std::endl;
+            return 1;
+        }
+        ModelOrchestrator orchestrator(registry);
+        HttpApiServer server(orchestrator, registry, server_config);
+        return server.run();
+    } catch (const std::exception& e) {
+        std::cerr << "[FATAL] " << e.what() << std::endl;
         return 1;
     }
 }
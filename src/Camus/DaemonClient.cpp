@@ -0,0 +1,224 @@
+// =================================================================
+// src/Camus/DaemonClient.cpp
+// =================================================================
+// Implementation of the camus daemon client.
+
+#include "Camus/DaemonClient.hpp"
+#include "Camus/FileBlockFormat.hpp"
+#include "nlohmann/json.hpp"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Camus {
+
+std::unique_ptr<DaemonClient> DaemonClient::connect(const std::string& socket_path) {
+    int fd = connectDaemonSocket(socket_path);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    std::unique_ptr<DaemonClient> client(new DaemonClient(fd));
+    try {
+        auto hello = nlohmann::json::parse(client->roundTrip(nlohmann::json{{"type", "hello"}}.dump()));
+        if (hello.value("type", "") != "hello" ||
+            hello.value("version", 0) != DAEMON_PROTOCOL_VERSION) {
+            return nullptr;
+        }
+
+        client->m_daemon_pid = hello.value("pid", 0L);
+        client->m_model_id = hello.value("model_id", "");
+
+        ModelMetadata& metadata = client->m_metadata;
+        metadata.name = hello.value("name", "");
+        metadata.description = hello.value("description", "");
+        metadata.version = hello.value("version_string", "");
+        metadata.provider = hello.value("provider", "");
+        metadata.model_path = hello.value("model_path", "");
+        metadata.performance.max_context_tokens = hello.value("max_context_tokens", size_t(0));
+        metadata.performance.max_output_tokens = hello.value("max_output_tokens", size_t(0));
+        metadata.is_available = true;
+        metadata.is_healthy = true;
+        metadata.health_status_message = "Served by camus daemon (pid " +
+                                         std::to_string(client->m_daemon_pid) + ")";
+    } catch (const std::exception&) {
+        // A daemon that cannot complete the handshake is treated as absent
+        return nullptr;
+    }
+    return client;
+}
+
+DaemonClient::DaemonClient(int fd) : m_channel(fd) {
+}
+
+DaemonClient::~DaemonClient() = default;
+
+std::string DaemonClient::getCompletion(const std::string& prompt) {
+    InferenceRequest request;
+    request.prompt = prompt;
+    return getCompletionWithMetadata(request).text;
+}
+
+InferenceResponse DaemonClient::getCompletionWithMetadata(const InferenceRequest& request) {
+    nlohmann::json message = {
+        {"type", "complete"},
+        {"prompt", request.prompt},
+        {"max_tokens", request.max_tokens},
+        {"temperature", request.temperature},
+        {"top_p", request.top_p},
+        {"stop", request.stop_sequences},
+        {"stream", true}
+    };
+    if (!request.context_tokens.empty()) {
+        message["context"] = request.context_tokens;
+    }
+    if (request.constraint == ResponseConstraint::FILE_BLOCKS) {
+        // Sent in full so a daemon enforcing a different format refuses
+        // instead of returning output this client would misparse
+        message["constraint"] = {
+            {"kind", FileBlockFormat::CONSTRAINT_NAME},
+            {"grammar", FileBlockFormat::grammar()},
+            {"schema", FileBlockFormat::jsonSchema()}
+        };
+    }
+    std::lock_guard<std::mutex> lock(m_request_mutex);
+    if (!m_connected || !m_channel.send(message.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace))) {
+        m_connected = false;
+        throw std::runtime_error("Lost connection to camus daemon");
+    }
+
+    // Token messages stream in until the final reply arrives
+    bool echoed = false;
+    std::string line;
+    while (true) {
+        if (!m_channel.receive(line)) {
+            m_connected = false;
+            throw std::runtime_error("Lost connection to camus daemon");
+        }
+        auto reply = nlohmann::json::parse(line);
+        std::string type = reply.value("type", "");
+
+        if (type == "token") {
+            std::string piece = reply.value("text", "");
+            if (request.on_token) {
+                request.on_token(piece);
+            } else {
+                std::cout << piece << std::flush;
+                echoed = true;
+            }
+            continue;
+        }
+        if (echoed) {
+            std::cout << std::endl;
+        }
+        if (type == "error") {
+            throw std::runtime_error("camus daemon: " + reply.value("message", "unknown error"));
+        }
+
+        InferenceResponse response;
+        response.text = reply.value("text", "");
+        response.tokens_generated = reply.value("tokens_generated", size_t(0));
+        response.response_time = std::chrono::milliseconds(reply.value("response_time_ms", 0LL));
+        response.was_truncated = reply.value("was_truncated", false);
+        response.finish_reason = reply.value("finish_reason", "");
+        response.confidence_score = reply.value("confidence_score", 0.0);
+        if (reply.contains("token_logprobs") && reply["token_logprobs"].is_array()) {
+            response.token_logprobs = reply["token_logprobs"].get<std::vector<float>>();
+            response.summarizeLogprobs();
+        }
+        if (reply.contains("context") && reply["context"].is_array()) {
+            response.context_tokens = reply["context"].get<std::vector<int64_t>>();
+        }
+        if (reply.contains("metadata") && reply["metadata"].is_object()) {
+            for (const auto& [key, value] : reply["metadata"].items()) {
+                if (value.is_string()) {
+                    response.metadata[key] = value.get<std::string>();
+                }
+            }
+        }
+        response.metadata["served_by"] = "daemon";
+
+        {
+            std::lock_guard<std::mutex> performance_lock(m_performance_mutex);
+            m_performance.avg_latency = response.response_time;
+            if (response.tokens_generated > 0 && response.response_time.count() > 0) {
+                m_performance.tokens_per_second =
+                    response.tokens_generated * 1000.0 / response.response_time.count();
+            }
+        }
+        return response;
+    }
+}
+
+ModelMetadata DaemonClient::getModelMetadata() const {
+    return m_metadata;
+}
+
+bool DaemonClient::isHealthy() const {
+    return m_connected;
+}
+
+bool DaemonClient::performHealthCheck() {
+    try {
+        auto reply = nlohmann::json::parse(roundTrip(nlohmann::json{{"type", "ping"}}.dump()));
+        return reply.value("type", "") == "pong";
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+ModelPerformance DaemonClient::getCurrentPerformance() const {
+    std::lock_guard<std::mutex> lock(m_performance_mutex);
+    return m_performance;
+}
+
+std::string DaemonClient::getModelId() const {
+    return m_model_id;
+}
+
+std::pair<std::string, int> DaemonClient::runModelCommand(const std::string& subcommand,
+                                                          const std::string& model_name) {
+    auto reply = nlohmann::json::parse(roundTrip(
+        nlohmann::json{{"type", "model"}, {"subcommand", subcommand}, {"model", model_name}}.dump()));
+    if (reply.value("type", "") == "error") {
+        return {reply.value("message", "unknown error") + "\n", 1};
+    }
+    return {reply.value("output", ""), reply.value("exit_code", 1)};
+}
+
+std::string DaemonClient::getStatus() {
+    auto reply = nlohmann::json::parse(roundTrip(nlohmann::json{{"type", "status"}}.dump()));
+
+    std::ostringstream status;
+    status << "camus daemon (pid " << reply.value("pid", 0L) << ")\n"
+           << "  Model:            " << reply.value("model_id", "") << "\n"
+           << "  Uptime:           " << reply.value("uptime_seconds", 0LL) << "s\n"
+           << "  Clients:          " << reply.value("clients", size_t(0)) << "\n"
+           << "  Requests:         " << reply.value("requests", size_t(0)) << "\n"
+           << "  Completions:      " << reply.value("completions", size_t(0)) << "\n"
+           << "  Tokens generated: " << reply.value("tokens_generated", size_t(0)) << "\n"
+           << "  Errors:           " << reply.value("errors", size_t(0)) << "\n"
+           << "  Model registry:   " << (reply.value("registry_loaded", false) ? "resident" : "not loaded");
+    return status.str();
+}
+
+bool DaemonClient::requestShutdown() {
+    try {
+        auto reply = nlohmann::json::parse(roundTrip(nlohmann::json{{"type", "shutdown"}}.dump()));
+        return reply.value("exit_code", 1) == 0;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+std::string DaemonClient::roundTrip(const std::string& message) {
+    std::lock_guard<std::mutex> lock(m_request_mutex);
+    std::string reply;
+    if (!m_connected || !m_channel.send(message) || !m_channel.receive(reply)) {
+        m_connected = false;
+        throw std::runtime_error("Lost connection to camus daemon");
+    }
+    return reply;
+}
+
+} // namespace Camus
@@ -0,0 +1,136 @@
+// =================================================================
+// src/Camus/DaemonProtocol.cpp
+// =================================================================
+// Implementation of the daemon message framing and socket helpers.
+
+#include "Camus/DaemonProtocol.hpp"
+#include <cstring>
+#include <cerrno>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Camus {
+
+MessageChannel::MessageChannel(int fd) : m_fd(fd) {
+}
+
+MessageChannel::~MessageChannel() {
+#if !defined(_WIN32)
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+#endif
+}
+
+bool MessageChannel::send(const std::string& message) {
+#if defined(_WIN32)
+    (void)message;
+    return false;
+#else
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    std::string frame = message;
+    frame += '\n';
+
+    // A peer that disconnected must not kill us with SIGPIPE
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    flags = MSG_NOSIGNAL;
+#endif
+
+    size_t sent = 0;
+    while (sent < frame.size()) {
+        ssize_t n = ::send(m_fd, frame.data() + sent, frame.size() - sent, flags);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+#endif
+}
+
+bool MessageChannel::receive(std::string& message) {
+#if defined(_WIN32)
+    (void)message;
+    return false;
+#else
+    char chunk[16 * 1024];
+    while (true) {
+        size_t newline = m_buffer.find('\n', m_scanned);
+        if (newline != std::string::npos) {
+            message.assign(m_buffer, 0, newline);
+            m_buffer.erase(0, newline + 1);
+            m_scanned = 0;
+            return true;
+        }
+        m_scanned = m_buffer.size();
+
+        ssize_t n = recv(m_fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        m_buffer.append(chunk, static_cast<size_t>(n));
+    }
+#endif
+}
+
+void MessageChannel::shutdown() {
+#if !defined(_WIN32)
+    if (m_fd >= 0) {
+        ::shutdown(m_fd, SHUT_RDWR);
+    }
+#endif
+}
+
+int connectDaemonSocket(const std::string& socket_path) {
+#if defined(_WIN32)
+    (void)socket_path;
+    return -1;
+#else
+    sockaddr_un address{};
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+#endif
+}
+
+size_t completeUtf8Length(const std::string& text) {
+    // Look back at most three bytes for the start of an unfinished sequence
+    size_t size = text.size();
+    for (size_t back = 1; back <= 3 && back <= size; ++back) {
+        unsigned char c = static_cast<unsigned char>(text[size - back]);
+        if ((c & 0xC0) == 0x80) {
+            continue;  // Continuation byte, keep looking for the lead byte
+        }
+        size_t expected = 1;
+        if ((c & 0xE0) == 0xC0) expected = 2;
+        else if ((c & 0xF0) == 0xE0) expected = 3;
+        else if ((c & 0xF8) == 0xF0) expected = 4;
+        return back < expected ? size - back : size;
+    }
+    return size;
+}
+
+} // namespace Camus
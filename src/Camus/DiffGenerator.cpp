@@ -2,9 +2,109 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <unordered_map>
 
 namespace Camus {
 
+namespace {
+
+/**
+ * @brief Mark a longest common subsequence of a[a_begin, a_end) and b[b_begin, b_end)
+ *
+ * Myers' O(ND) diff in linear space: find the middle of a shortest edit
+ * script by searching from both ends at once, then solve the two halves.
+ */
+void markCommonLines(const std::vector<int>& a, const std::vector<int>& b,
+                     size_t a_begin, size_t a_end, size_t b_begin, size_t b_end,
+                     std::vector<bool>& kept_a, std::vector<bool>& kept_b) {
+    while (a_begin < a_end && b_begin < b_end && a[a_begin] == b[b_begin]) {
+        kept_a[a_begin++] = true;
+        kept_b[b_begin++] = true;
+    }
+    while (a_begin < a_end && b_begin < b_end && a[a_end - 1] == b[b_end - 1]) {
+        kept_a[--a_end] = true;
+        kept_b[--b_end] = true;
+    }
+    if (a_begin == a_end || b_begin == b_end) {
+        return;
+    }
+    
+    const long n = static_cast<long>(a_end - a_begin);
+    const long m = static_cast<long>(b_end - b_begin);
+    const long delta = n - m;
+    const bool odd = (delta & 1) != 0;
+    const long max_d = (n + m + 1) / 2;
+    // forward[k] is the furthest x on diagonal x - y = k from the start;
+    // backward[k] the same measured from the end
+    std::vector<long> forward(2 * max_d + 2, -1);
+    std::vector<long> backward(2 * max_d + 2, -1);
+    forward[max_d + 1] = 0;
+    backward[max_d + 1] = 0;
+    auto a_at = [&](long x) { return a[a_begin + static_cast<size_t>(x)]; };
+    auto b_at = [&](long y) { return b[b_begin + static_cast<size_t>(y)]; };
+    
+    long split_x = -1;
+    long split_y = -1;
+    long forward_start = 0, forward_end = 0, backward_start = 0, backward_end = 0;
+    for (long d = 0; d < max_d && split_x < 0; ++d) {
+        for (long k = -d + forward_start; k <= d - forward_end && split_x < 0; k += 2) {
+            long offset = max_d + k;
+            long x = (k == -d || (k != d && forward[offset - 1] < forward[offset + 1]))
+                         ? forward[offset + 1] : forward[offset - 1] + 1;
+            long y = x - k;
+            while (x < n && y < m && a_at(x) == b_at(y)) {
+                x++;
+                y++;
+            }
+            forward[offset] = x;
+            if (x > n) {
+                forward_end += 2;
+            } else if (y > m) {
+                forward_start += 2;
+            } else if (odd) {
+                long other = max_d + delta - k;
+                if (other >= 0 && other < 2 * max_d && backward[other] != -1 && x >= n - backward[other]) {
+                    split_x = x;
+                    split_y = y;
+                }
+            }
+        }
+        for (long k = -d + backward_start; k <= d - backward_end && split_x < 0; k += 2) {
+            long offset = max_d + k;
+            long x = (k == -d || (k != d && backward[offset - 1] < backward[offset + 1]))
+                         ? backward[offset + 1] : backward[offset - 1] + 1;
+            long y = x - k;
+            while (x < n && y < m && a_at(n - x - 1) == b_at(m - y - 1)) {
+                x++;
+                y++;
+            }
+            backward[offset] = x;
+            if (x > n) {
+                backward_end += 2;
+            } else if (y > m) {
+                backward_start += 2;
+            } else if (!odd) {
+                long other = max_d + delta - k;
+                if (other >= 0 && other < 2 * max_d && forward[other] != -1 && forward[other] >= n - x) {
+                    split_x = forward[other];
+                    split_y = split_x - (other - max_d);
+                }
+            }
+        }
+    }
+    
+    // No split strictly inside the box means nothing is shared
+    if (split_x < 0 || (split_x == 0 && split_y == 0) || (split_x == n && split_y == m)) {
+        return;
+    }
+    size_t a_split = a_begin + static_cast<size_t>(split_x);
+    size_t b_split = b_begin + static_cast<size_t>(split_y);
+    markCommonLines(a, b, a_begin, a_split, b_begin, b_split, kept_a, kept_b);
+    markCommonLines(a, b, a_split, a_end, b_split, b_end, kept_a, kept_b);
+}
+
+} // namespace
+
 DiffGenerator::DiffGenerator(const std::string& original, const std::string& modified)
 : m_original(original), m_modified(modified) {
 }
@@ -26,57 +126,41 @@ std::vector<std::string> DiffGenerator::splitIntoLines(const std::string& text)
 }
 
 std::vector<DiffLine> DiffGenerator::computeDiff() const {
-    std::vector<DiffLine> diff;
     auto original_lines = splitIntoLines(m_original);
     auto modified_lines = splitIntoLines(m_modified);
     
-    size_t i = 0, j = 0;
+    // Compare line numbers instead of strings
+    std::unordered_map<std::string, int> ids;
+    std::vector<int> a;
+    std::vector<int> b;
+    a.reserve(original_lines.size());
+    b.reserve(modified_lines.size());
+    for (const auto& line : original_lines) {
+        a.push_back(ids.emplace(line, static_cast<int>(ids.size())).first->second);
+    }
+    for (const auto& line : modified_lines) {
+        b.push_back(ids.emplace(line, static_cast<int>(ids.size())).first->second);
+    }
     
-    while (i < original_lines.size() || j < modified_lines.size()) {
-        if (i >= original_lines.size()) {
-            diff.push_back({modified_lines[j], DiffLineType::ADDED, 0, j + 1});
-            j++;
-        } else if (j >= modified_lines.size()) {
+    std::vector<bool> kept_a(a.size(), false);
+    std::vector<bool> kept_b(b.size(), false);
+    markCommonLines(a, b, 0, a.size(), 0, b.size(), kept_a, kept_b);
+    
+    // Kept lines pair up in order; everything between them was removed or added
+    std::vector<DiffLine> diff;
+    diff.reserve(std::max(a.size(), b.size()));
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (i < a.size() && !kept_a[i]) {
             diff.push_back({original_lines[i], DiffLineType::REMOVED, i + 1, 0});
             i++;
-        } else if (original_lines[i] == modified_lines[j]) {
+        } else if (j < b.size() && !kept_b[j]) {
+            diff.push_back({modified_lines[j], DiffLineType::ADDED, 0, j + 1});
+            j++;
+        } else {
             diff.push_back({original_lines[i], DiffLineType::UNCHANGED, i + 1, j + 1});
             i++;
             j++;
-        } else {
-            size_t look_ahead = 3;
-            bool found_match = false;
-            
-            for (size_t k = 1; k <= look_ahead && j + k < modified_lines.size(); k++) {
-                if (original_lines[i] == modified_lines[j + k]) {
-                    for (size_t l = 0; l < k; l++) {
-                        diff.push_back({modified_lines[j + l], DiffLineType::ADDED, 0, j + l + 1});
-                    }
-                    j += k;
-                    found_match = true;
-                    break;
-                }
-            }
-            
-            if (!found_match) {
-                for (size_t k = 1; k <= look_ahead && i + k < original_lines.size(); k++) {
-                    if (original_lines[i + k] == modified_lines[j]) {
-                        for (size_t l = 0; l < k; l++) {
-                            diff.push_back({original_lines[i + l], DiffLineType::REMOVED, i + l + 1, 0});
-                        }
-                        i += k;
-                        found_match = true;
-                        break;
-                    }
-                }
-            }
-            
-            if (!found_match) {
-                diff.push_back({original_lines[i], DiffLineType::REMOVED, i + 1, 0});
-                diff.push_back({modified_lines[j], DiffLineType::ADDED, 0, j + 1});
-                i++;
-                j++;
-            }
         }
     }
     
@@ -0,0 +1,452 @@
+// =================================================================
+// src/Camus/EditApplier.cpp
+// =================================================================
+// Implementation of hunk parsing and fuzzy application.
+
+#include "Camus/EditApplier.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Camus {
+
+namespace {
+
+std::vector<std::string> splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            lines.push_back(text.substr(start));
+            break;
+        }
+        lines.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return lines;
+}
+
+std::string joinLines(const std::vector<std::string>& lines, bool trailing_newline) {
+    std::string text;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        text += lines[i];
+        if (i + 1 < lines.size() || trailing_newline) {
+            text += '\n';
+        }
+    }
+    return text;
+}
+
+std::string trimRight(const std::string& s) {
+    size_t end = s.find_last_not_of(" \t\r");
+    return end == std::string::npos ? std::string() : s.substr(0, end + 1);
+}
+
+std::string trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t\r");
+    if (start == std::string::npos) {
+        return std::string();
+    }
+    return s.substr(start, s.find_last_not_of(" \t\r") - start + 1);
+}
+
+std::string leadingWhitespace(const std::string& s) {
+    return s.substr(0, s.find_first_not_of(" \t"));
+}
+
+bool isBlank(const std::string& s) {
+    return s.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+// "<<<<<<< SEARCH", ">>>>>>> REPLACE": five or more marker characters, then the keyword
+bool isFenceLine(const std::string& line, char marker, const char* keyword) {
+    size_t count = 0;
+    while (count < line.size() && line[count] == marker) {
+        count++;
+    }
+    return count >= 5 && line.find(keyword, count) != std::string::npos;
+}
+
+bool isDividerLine(const std::string& line) {
+    std::string trimmed = trimRight(line);
+    return trimmed.size() >= 5 && trimmed.find_first_not_of('=') == std::string::npos;
+}
+
+// Lines [0, count) in window order: from the cursor to the end, then from the top
+template <typename Visit>
+void forEachStart(size_t count, size_t cursor, Visit visit) {
+    cursor = std::min(cursor, count);
+    for (size_t i = cursor; i < count; ++i) {
+        if (visit(i)) {
+            return;
+        }
+    }
+    for (size_t i = 0; i < cursor; ++i) {
+        if (visit(i)) {
+            return;
+        }
+    }
+}
+
+// Occurrence of search that starts and ends on line boundaries; a match
+// inside a line would splice the replacement into unrelated code
+size_t findWholeLines(const std::string& text, const std::string& search, size_t from) {
+    size_t pos = text.find(search, from);
+    while (pos != std::string::npos) {
+        size_t end = pos + search.size();
+        bool starts_line = pos == 0 || text[pos - 1] == '\n';
+        bool ends_line = end == text.size() || text[end] == '\n' || search.back() == '\n';
+        if (starts_line && ends_line) {
+            return pos;
+        }
+        pos = text.find(search, pos + 1);
+    }
+    return std::string::npos;
+}
+
+} // namespace
+
+EditApplier::EditApplier(double min_similarity)
+    : m_min_similarity(min_similarity) {
+}
+
+std::vector<EditHunk> EditApplier::parseHunks(const std::string& block_text) {
+    enum class State { OUTSIDE, SEARCH, REPLACE, DIFF };
+
+    std::vector<EditHunk> hunks;
+    std::vector<std::string> search;
+    std::vector<std::string> replace;
+    State state = State::OUTSIDE;
+
+    auto flush = [&]() {
+        if (!search.empty() || !replace.empty()) {
+            hunks.push_back({joinLines(search, false), joinLines(replace, false)});
+        }
+        search.clear();
+        replace.clear();
+    };
+
+    for (const std::string& raw_line : splitLines(block_text)) {
+        std::string line = raw_line;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        switch (state) {
+        case State::SEARCH:
+            if (isDividerLine(line)) {
+                state = State::REPLACE;
+            } else {
+                search.push_back(line);
+            }
+            continue;
+        case State::REPLACE:
+            if (isFenceLine(line, '>', "REPLACE")) {
+                // An empty search with an empty replacement is still a hunk
+                hunks.push_back({joinLines(search, false), joinLines(replace, false)});
+                search.clear();
+                replace.clear();
+                state = State::OUTSIDE;
+            } else {
+                replace.push_back(line);
+            }
+            continue;
+        case State::OUTSIDE:
+        case State::DIFF:
+            break;
+        }
+
+        if (isFenceLine(line, '<', "SEARCH")) {
+            flush();
+            state = State::SEARCH;
+        } else if (line.rfind("@@", 0) == 0) {
+            flush();
+            state = State::DIFF;
+        } else if (state == State::DIFF) {
+            if (line.empty()) {
+                // Models often drop the space of an empty context line
+                search.emplace_back();
+                replace.emplace_back();
+            } else if (line.rfind("```", 0) == 0) {
+                flush();
+                state = State::OUTSIDE;
+            } else if (line[0] == '-') {
+                search.push_back(line.substr(1));
+            } else if (line[0] == '+') {
+                replace.push_back(line.substr(1));
+            } else if (line[0] == '\\') {
+                // "\ No newline at end of file"
+            } else {
+                std::string context = line[0] == ' ' ? line.substr(1) : line;
+                search.push_back(context);
+                replace.push_back(context);
+            }
+        }
+        // Outside a hunk: prose, fences and "--- a/" / "+++ b/" headers
+    }
+    if (state == State::DIFF) {
+        flush();
+    }
+    return hunks;
+}
+
+EditApplyResult EditApplier::apply(const std::string& original, const std::vector<EditHunk>& hunks) const {
+    EditApplyResult result;
+
+    std::string text;
+    text.reserve(original.size());
+    for (char ch : original) {
+        if (ch != '\r') {
+            text += ch;
+        }
+    }
+
+    size_t char_cursor = 0;
+    for (size_t h = 0; h < hunks.size(); ++h) {
+        const EditHunk& hunk = hunks[h];
+
+        if (isBlank(hunk.search)) {
+            if (!text.empty() && text.back() != '\n') {
+                text += '\n';
+            }
+            text += hunk.replace;
+            if (!hunk.replace.empty() && hunk.replace.back() != '\n') {
+                text += '\n';
+            }
+            char_cursor = text.size();
+            result.hunks_applied++;
+            continue;
+        }
+
+        // Exact match of whole lines, preferring one after the previous hunk
+        size_t pos = findWholeLines(text, hunk.search, char_cursor);
+        if (pos == std::string::npos) {
+            pos = findWholeLines(text, hunk.search, 0);
+        }
+        if (pos != std::string::npos) {
+            size_t length = hunk.search.size();
+            if (hunk.replace.empty() && hunk.search.back() != '\n' && pos + length < text.size() &&
+                text[pos + length] == '\n' && (pos == 0 || text[pos - 1] == '\n')) {
+                length++; // Deleting whole lines removes their newline too
+            }
+            text.replace(pos, length, hunk.replace);
+            char_cursor = pos + hunk.replace.size();
+            result.hunks_applied++;
+            continue;
+        }
+
+        bool trailing_newline = !text.empty() && text.back() == '\n';
+        std::vector<std::string> lines = splitLines(text);
+        size_t line_cursor = static_cast<size_t>(std::count(text.begin(), text.begin() + char_cursor, '\n'));
+        bool fuzzy = false;
+        if (!applyToLines(lines, line_cursor, hunk, fuzzy)) {
+            std::vector<std::string> search_lines = splitLines(hunk.search);
+            auto first = std::find_if(search_lines.begin(), search_lines.end(),
+                                      [](const std::string& line) { return !isBlank(line); });
+            result.errors.push_back("Hunk " + std::to_string(h + 1) + ": could not locate \"" +
+                                    (first != search_lines.end() ? trim(*first) : std::string()) + "\"");
+            continue;
+        }
+
+        text = joinLines(lines, trailing_newline || lines.empty());
+        char_cursor = 0;
+        for (size_t i = 0; i < line_cursor && i < lines.size(); ++i) {
+            char_cursor += lines[i].size() + 1;
+        }
+        char_cursor = std::min(char_cursor, text.size());
+        if (fuzzy) {
+            result.fuzzy_matches++;
+        }
+        result.hunks_applied++;
+    }
+
+    result.content = std::move(text);
+    result.success = result.errors.empty();
+    return result;
+}
+
+bool EditApplier::applyToLines(std::vector<std::string>& lines, size_t& cursor, const EditHunk& hunk,
+                               bool& fuzzy) const {
+    // Blank lines around the search text are usually padding by the model
+    std::vector<std::string> search = splitLines(hunk.search);
+    while (!search.empty() && isBlank(search.back())) {
+        search.pop_back();
+    }
+    size_t leading_blank = 0;
+    while (leading_blank < search.size() && isBlank(search[leading_blank])) {
+        leading_blank++;
+    }
+    search.erase(search.begin(), search.begin() + static_cast<std::ptrdiff_t>(leading_blank));
+
+    const size_t n = search.size();
+    if (n == 0 || n > lines.size()) {
+        return false;
+    }
+    const size_t windows = lines.size() - n + 1;
+
+    std::vector<std::string> search_right(n);
+    std::vector<std::string> search_trimmed(n);
+    for (size_t k = 0; k < n; ++k) {
+        search_right[k] = trimRight(search[k]);
+        search_trimmed[k] = trim(search[k]);
+    }
+
+    auto matches = [&](size_t start, bool ignore_indent) {
+        for (size_t k = 0; k < n; ++k) {
+            const std::string& line = lines[start + k];
+            if (ignore_indent ? trim(line) != search_trimmed[k] : trimRight(line) != search_right[k]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    size_t found = windows;
+    bool reindent = false;
+
+    // 1. Trailing whitespace ignored
+    forEachStart(windows, cursor, [&](size_t i) {
+        if (matches(i, false)) {
+            found = i;
+            return true;
+        }
+        return false;
+    });
+
+    // 2. Indentation ignored
+    if (found == windows) {
+        forEachStart(windows, cursor, [&](size_t i) {
+            if (matches(i, true)) {
+                found = i;
+                return true;
+            }
+            return false;
+        });
+        reindent = fuzzy = found != windows;
+    }
+
+    // 3. Most similar window, if unambiguous
+    if (found == windows) {
+        double best = 0.0;
+        double second = 0.0;
+        size_t best_start = windows;
+        const double needed = m_min_similarity * static_cast<double>(n);
+        for (size_t i = 0; i < windows; ++i) {
+            double total = 0.0;
+            for (size_t k = 0; k < n; ++k) {
+                total += lineSimilarity(lines[i + k], search_trimmed[k]);
+                // Every remaining line scores at most 1
+                if (total + static_cast<double>(n - k - 1) < needed) {
+                    total = -1.0;
+                    break;
+                }
+            }
+            if (total < 0.0) {
+                continue;
+            }
+            double score = total / static_cast<double>(n);
+            if (score > best) {
+                second = best;
+                best = score;
+                best_start = i;
+            } else if (score > second) {
+                second = score;
+            }
+        }
+        if (best_start != windows && best >= m_min_similarity && best - second > 1e-6) {
+            found = best_start;
+            reindent = fuzzy = true;
+        }
+    }
+
+    if (found == windows) {
+        return false;
+    }
+
+    std::vector<std::string> replacement = splitLines(hunk.replace);
+    if (reindent) {
+        // Lines kept from the search text take the indentation of the line
+        // they matched; new lines shift by the difference on the first line
+        std::unordered_map<std::string, std::string> kept_indent;
+        for (size_t k = 0; k < n; ++k) {
+            kept_indent.emplace(search_trimmed[k], leadingWhitespace(lines[found + k]));
+        }
+        std::string from = leadingWhitespace(search[0]);
+        std::string to = leadingWhitespace(lines[found]);
+        for (std::string& line : replacement) {
+            if (isBlank(line)) {
+                continue;
+            }
+            auto kept = kept_indent.find(trim(line));
+            if (kept != kept_indent.end()) {
+                line = kept->second + trim(line);
+            } else if (from != to && line.compare(0, from.size(), from) == 0) {
+                line = to + line.substr(from.size());
+            }
+        }
+    }
+
+    lines.erase(lines.begin() + static_cast<std::ptrdiff_t>(found),
+                lines.begin() + static_cast<std::ptrdiff_t>(found + n));
+    lines.insert(lines.begin() + static_cast<std::ptrdiff_t>(found), replacement.begin(), replacement.end());
+    cursor = found + replacement.size();
+    return true;
+}
+
+double EditApplier::lineSimilarity(const std::string& a, const std::string& b) {
+    std::string x = trim(a);
+    std::string y = trim(b);
+    if (x == y) {
+        return 1.0;
+    }
+    if (x.size() < 2 || y.size() < 2) {
+        return 0.0;
+    }
+
+    auto bigrams = [](const std::string& s) {
+        std::vector<uint16_t> grams;
+        grams.reserve(s.size() - 1);
+        for (size_t i = 0; i + 1 < s.size(); ++i) {
+            grams.push_back(static_cast<uint16_t>((static_cast<unsigned char>(s[i]) << 8) |
+                                                  static_cast<unsigned char>(s[i + 1])));
+        }
+        std::sort(grams.begin(), grams.end());
+        return grams;
+    };
+    std::vector<uint16_t> gx = bigrams(x);
+    std::vector<uint16_t> gy = bigrams(y);
+
+    size_t common = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < gx.size() && j < gy.size()) {
+        if (gx[i] == gy[j]) {
+            common++;
+            i++;
+            j++;
+        } else if (gx[i] < gy[j]) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return 2.0 * static_cast<double>(common) / static_cast<double>(gx.size() + gy.size());
+}
+
+EditFormat EditApplier::parseFormat(const std::string& name, EditFormat fallback) {
+    if (name == "whole_file" || name == "whole") {
+        return EditFormat::WHOLE_FILE;
+    }
+    if (name == "search_replace" || name == "diff" || name == "edit") {
+        return EditFormat::SEARCH_REPLACE;
+    }
+    return fallback;
+}
+
+std::string EditApplier::formatName(EditFormat format) {
+    return format == EditFormat::SEARCH_REPLACE ? "search_replace" : "whole_file";
+}
+
+} // namespace Camus
@@ -0,0 +1,336 @@
+// =================================================================
+// src/Camus/EmbeddingIndex.cpp
+// =================================================================
+// Implementation of source chunking and the persistent embedding index.
+
+#include "Camus/EmbeddingIndex.hpp"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Camus {
+
+namespace {
+
+const char* kGraphFile = "hnsw.bin";
+const char* kChunksFile = "chunks.json";
+
+bool isBlank(const std::string& line) {
+    return std::all_of(line.begin(), line.end(), [](unsigned char ch) { return std::isspace(ch); });
+}
+
+/**
+ * @brief Write a file through a temporary so a crash never leaves half an index
+ */
+void writeAtomically(const std::filesystem::path& path, const std::string& data) {
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+            throw std::runtime_error("Cannot write " + temp.string());
+        }
+    }
+    std::filesystem::rename(temp, path);
+}
+
+} // namespace
+
+std::vector<CodeChunk> CodeChunker::chunk(const std::string& file_path, const std::string& content,
+                                          const EmbeddingIndexConfig& config) {
+    std::vector<std::string> lines;
+    std::istringstream stream(content);
+    for (std::string line; std::getline(stream, line);) {
+        lines.push_back(line);
+    }
+
+    // Characters up to (excluding) each line, newlines included
+    std::vector<size_t> offsets(lines.size() + 1, 0);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        offsets[i + 1] = offsets[i] + lines[i].size() + 1;
+    }
+
+    size_t max_lines = std::max<size_t>(1, config.max_chunk_lines);
+    std::vector<CodeChunk> chunks;
+    auto emit = [&](size_t begin, size_t end) {
+        while (begin < end) {
+            size_t stop = begin + 1;
+            while (stop < end && stop - begin < max_lines && offsets[stop + 1] - offsets[begin] <= config.max_chunk_chars) {
+                ++stop;
+            }
+            if (stop < end) {
+                // Cut after a blank line in the second half of the window if there is one
+                for (size_t cut = stop; cut > begin + (stop - begin) / 2; --cut) {
+                    if (isBlank(lines[cut - 1])) {
+                        stop = cut;
+                        break;
+                    }
+                }
+            }
+
+            size_t first = begin;
+            size_t last = stop;
+            while (first < last && isBlank(lines[first])) ++first;
+            while (last > first && isBlank(lines[last - 1])) --last;
+            if (first < last) {
+                CodeChunk chunk;
+                chunk.file_path = file_path;
+                chunk.start_line = first + 1;
+                chunk.end_line = last;
+                chunk.text = content.substr(offsets[first], offsets[last] - offsets[first]);
+                chunks.push_back(std::move(chunk));
+            }
+            begin = stop;
+        }
+    };
+
+    // Declaration starts: unindented lines after a blank line or a closing brace
+    std::vector<size_t> starts;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const std::string& line = lines[i];
+        bool unindented = !line.empty() && !std::isspace(static_cast<unsigned char>(line[0])) &&
+                          line[0] != '}' && line[0] != ')' && line[0] != ']';
+        if (i == 0 || (unindented && (isBlank(lines[i - 1]) || lines[i - 1][0] == '}'))) {
+            starts.push_back(i);
+        }
+    }
+    starts.push_back(lines.size());
+
+    size_t current_begin = 0;
+    size_t current_end = 0;
+    for (size_t s = 0; s + 1 < starts.size(); ++s) {
+        size_t begin = starts[s];
+        size_t end = starts[s + 1];
+        if (current_end == current_begin) {
+            current_begin = begin;
+            current_end = end;
+            continue;
+        }
+        bool too_small = current_end - current_begin < config.min_chunk_lines;
+        bool fits = end - current_begin <= max_lines && offsets[end] - offsets[current_begin] <= config.max_chunk_chars;
+        if (too_small || fits) {
+            current_end = end;
+        } else {
+            emit(current_begin, current_end);
+            current_begin = begin;
+            current_end = end;
+        }
+    }
+    emit(current_begin, current_end);
+
+    return chunks;
+}
+
+EmbeddingIndex::EmbeddingIndex(const std::string& index_dir, TextEmbedder& embedder,
+                               const EmbeddingIndexConfig& config)
+    : m_index_dir(index_dir), m_embedder(embedder), m_config(config) {
+    reset();
+}
+
+bool EmbeddingIndex::load() {
+    std::filesystem::path dir(m_index_dir);
+    std::ifstream chunks_in(dir / kChunksFile);
+    std::ifstream graph_in(dir / kGraphFile, std::ios::binary);
+    if (!chunks_in || !graph_in) {
+        reset();
+        return false;
+    }
+
+    try {
+        nlohmann::json meta = nlohmann::json::parse(chunks_in);
+        if (meta.value("model_id", "") != m_embedder.modelId() ||
+            meta.value("dimensions", static_cast<size_t>(0)) != m_embedder.dimensions()) {
+            std::cout << "[INFO] Embedding model changed; rebuilding the retrieval index" << std::endl;
+            reset();
+            return false;
+        }
+
+        auto graph = std::make_unique<HnswIndex>(HnswIndex::load(graph_in));
+        if (graph->dimensions() != m_embedder.dimensions()) {
+            throw std::runtime_error("dimension mismatch");
+        }
+
+        std::unordered_map<uint32_t, CodeChunk> chunks;
+        std::unordered_map<std::string, std::vector<uint32_t>> file_chunks;
+        std::unordered_map<std::string, FileStamp> file_stamps;
+        for (const auto& file : meta.at("files").items()) {
+            const auto& entry = file.value();
+            FileStamp stamp;
+            stamp.size = entry.at("size").get<uintmax_t>();
+            stamp.modified = entry.at("modified").get<int64_t>();
+            file_stamps[file.key()] = stamp;
+
+            auto& ids = file_chunks[file.key()];
+            for (const auto& location : entry.at("chunks")) {
+                uint32_t id = location.at(0).get<uint32_t>();
+                if (id >= graph->size() + graph->deletedCount() || graph->isDeleted(id)) {
+                    throw std::runtime_error("chunk id out of range");
+                }
+                CodeChunk chunk;
+                chunk.file_path = file.key();
+                chunk.start_line = location.at(1).get<size_t>();
+                chunk.end_line = location.at(2).get<size_t>();
+                chunks[id] = std::move(chunk);
+                ids.push_back(id);
+            }
+        }
+
+        m_graph = std::move(graph);
+        m_chunks = std::move(chunks);
+        m_file_chunks = std::move(file_chunks);
+        m_file_stamps = std::move(file_stamps);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "[WARN] Discarding unreadable retrieval index in " << m_index_dir << ": " << e.what() << std::endl;
+        reset();
+        return false;
+    }
+}
+
+void EmbeddingIndex::save() const {
+    std::filesystem::path dir(m_index_dir);
+    std::filesystem::create_directories(dir);
+
+    nlohmann::json meta;
+    meta["model_id"] = m_embedder.modelId();
+    meta["dimensions"] = m_embedder.dimensions();
+    meta["files"] = nlohmann::json::object();
+    for (const auto& file : m_file_stamps) {
+        nlohmann::json entry;
+        entry["size"] = file.second.size;
+        entry["modified"] = file.second.modified;
+        entry["chunks"] = nlohmann::json::array();
+        auto ids = m_file_chunks.find(file.first);
+        if (ids != m_file_chunks.end()) {
+            for (uint32_t id : ids->second) {
+                const CodeChunk& chunk = m_chunks.at(id);
+                entry["chunks"].push_back({id, chunk.start_line, chunk.end_line});
+            }
+        }
+        meta["files"][file.first] = std::move(entry);
+    }
+
+    // Graph first: chunks.json only ever refers to a graph that is on disk
+    std::ostringstream graph_out(std::ios::binary);
+    m_graph->save(graph_out);
+    writeAtomically(dir / kGraphFile, graph_out.str());
+    writeAtomically(dir / kChunksFile, meta.dump());
+}
+
+IndexUpdateStats EmbeddingIndex::update(const ScanDelta& delta, const std::string& root_path) {
+    IndexUpdateStats stats;
+
+    for (const auto& file_path : delta.removed) {
+        removeFile(file_path, stats);
+        m_file_stamps.erase(file_path);
+        stats.files_removed++;
+    }
+
+    for (const auto& file_path : delta.changed) {
+        removeFile(file_path, stats);
+        m_file_stamps.erase(file_path);
+
+        std::ifstream in(std::filesystem::path(root_path) / file_path, std::ios::binary);
+        if (!in) {
+            continue;
+        }
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        // Ids are recorded as they are added, so a failure part-way through
+        // leaves nothing behind that removeFile() would miss; the file has
+        // no stamp yet and is embedded again on the next update
+        auto& ids = m_file_chunks[file_path];
+        for (auto& chunk : CodeChunker::chunk(file_path, content, m_config)) {
+            uint32_t id = m_graph->add(m_embedder.embed(embeddingText(chunk)));
+            chunk.text.clear();
+            m_chunks[id] = std::move(chunk);
+            ids.push_back(id);
+            stats.chunks_embedded++;
+        }
+
+        auto stamp = delta.stamps.find(file_path);
+        if (stamp != delta.stamps.end()) {
+            m_file_stamps[file_path] = stamp->second;
+        }
+        stats.files_embedded++;
+    }
+
+    if (m_graph->needsCompaction()) {
+        compact();
+        stats.compacted = true;
+    }
+    return stats;
+}
+
+std::vector<ChunkHit> EmbeddingIndex::query(const std::string& text, size_t k) {
+    std::vector<ChunkHit> hits;
+    if (chunkCount() == 0 || k == 0) {
+        return hits;
+    }
+    for (const auto& result : m_graph->search(m_embedder.embed(text), k)) {
+        auto chunk = m_chunks.find(result.first);
+        if (chunk != m_chunks.end()) {
+            hits.push_back({chunk->second, result.second});
+        }
+    }
+    return hits;
+}
+
+std::unordered_map<std::string, double> EmbeddingIndex::fileScores(const std::vector<ChunkHit>& hits) {
+    std::unordered_map<std::string, double> scores;
+    for (const auto& hit : hits) {
+        auto inserted = scores.emplace(hit.chunk.file_path, hit.score);
+        if (!inserted.second) {
+            inserted.first->second = std::max(inserted.first->second, static_cast<double>(hit.score));
+        }
+    }
+    return scores;
+}
+
+void EmbeddingIndex::reset() {
+    m_graph = std::make_unique<HnswIndex>(m_embedder.dimensions(), m_config.hnsw);
+    m_chunks.clear();
+    m_file_chunks.clear();
+    m_file_stamps.clear();
+}
+
+void EmbeddingIndex::removeFile(const std::string& file_path, IndexUpdateStats& stats) {
+    auto it = m_file_chunks.find(file_path);
+    if (it == m_file_chunks.end()) {
+        return;
+    }
+    for (uint32_t id : it->second) {
+        m_graph->remove(id);
+        m_chunks.erase(id);
+        stats.chunks_removed++;
+    }
+    m_file_chunks.erase(it);
+}
+
+void EmbeddingIndex::compact() {
+    std::vector<uint32_t> new_ids;
+    auto graph = std::make_unique<HnswIndex>(m_graph->compacted(new_ids));
+
+    std::unordered_map<uint32_t, CodeChunk> chunks;
+    for (auto& entry : m_chunks) {
+        chunks[new_ids[entry.first]] = std::move(entry.second);
+    }
+    for (auto& file : m_file_chunks) {
+        for (uint32_t& id : file.second) {
+            id = new_ids[id];
+        }
+    }
+    m_graph = std::move(graph);
+    m_chunks = std::move(chunks);
+}
+
+std::string EmbeddingIndex::embeddingText(const CodeChunk& chunk) {
+    return "File: " + chunk.file_path + "\n" + chunk.text;
+}
+
+} // namespace Camus
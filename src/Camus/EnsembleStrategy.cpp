@@ -5,6 +5,8 @@
 
 #include "Camus/EnsembleStrategy.hpp"
 #include "Camus/Logger.hpp"
+#include "Camus/RequestCoalescer.hpp"
+#include "Camus/AdaptiveConcurrencyLimiter.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -57,6 +59,10 @@ EnsembleResponse EnsembleStrategy::execute(const EnsembleRequest& request) {
         modified_request.target_models = valid_models;
         
         std::vector<ModelResponse> individual_responses = executeModels(modified_request);
+        response.early_stopped = !individual_responses.empty() &&
+                                 individual_responses.size() < valid_models.size() &&
+                                 individual_responses.back().token_confidence &&
+                                 individual_responses.back().confidence_score >= request.early_stopping_threshold;
         
         auto coordination_end = std::chrono::steady_clock::now();
         response.coordination_time = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -195,6 +201,18 @@ std::vector<ModelResponse> EnsembleStrategy::executeModels(const EnsembleRequest
             } catch (const std::exception& e) {
                 Logger::getInstance().warning("EnsembleStrategy", 
                     "Model execution failed: " + std::string(e.what()));
+                continue;
+            }
+            
+            // A model that is measurably sure of its answer makes the
+            // remaining calls unnecessary; heuristic confidence does not count
+            const ModelResponse& last = responses.back();
+            if (request.enable_early_stopping && last.execution_success && last.token_confidence &&
+                last.confidence_score >= request.early_stopping_threshold) {
+                Logger::getInstance().debug("EnsembleStrategy", 
+                    "Early stop after " + model_name + " (token confidence " + 
+                    std::to_string(last.confidence_score) + ")");
+                break;
             }
         }
     }
@@ -215,8 +233,23 @@ ModelResponse EnsembleStrategy::executeSingleModel(const std::string& model_name
             throw std::runtime_error("Model not available: " + model_name);
         }
         
-        // Execute the model
-        std::string model_response = model->getCompletion(request.prompt);
+        // Execute the model under its backend's concurrency limit; identical
+        // greedy requests share one generation and one permit
+        InferenceRequest inference;
+        inference.prompt = request.prompt;
+        inference.max_tokens = static_cast<size_t>(std::max(request.max_tokens, 1));
+        inference.temperature = request.temperature;
+        inference.timeout = request.timeout;
+        auto& limiter = AdaptiveConcurrencyLimiter::forBackend(model->getBackendEndpoint());
+        auto run_backend = [&](const InferenceRequest& call) {
+            return limiter.run([&]() {
+                return model->getCompletionWithMetadata(call);
+            }, request.timeout, request.timeout);
+        };
+        InferenceResponse inference_response = request.temperature <= 0.0
+            ? RequestCoalescer::getInstance().execute(model_name, inference, run_backend)
+            : run_backend(inference);
+        const std::string& model_response = inference_response.text;
         
         auto end_time = std::chrono::steady_clock::now();
         response.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -225,13 +258,23 @@ ModelResponse EnsembleStrategy::executeSingleModel(const std::string& model_name
         response.response_text = model_response;
         response.execution_success = true;
         
-        // Estimate tokens generated (rough approximation)
-        response.tokens_generated = model_response.length() / 4;
+        response.tokens_generated = inference_response.tokens_generated > 0
+            ? inference_response.tokens_generated
+            : model_response.length() / 4; // Rough estimate
         
-        // Calculate quality and confidence scores
+        // Calculate quality and confidence scores. Token log-probabilities,
+        // when the backend reports them, are the model's own confidence
         auto quality_analysis = analyzeQuality(request.prompt, model_response, request.task_type);
         response.quality_score = quality_analysis.overall_score;
-        response.confidence_score = std::min(1.0, quality_analysis.overall_score + 0.1);
+        if (inference_response.hasLogprobs()) {
+            response.confidence_score = inference_response.confidence_score;
+            response.token_confidence = true;
+            response.metrics["mean_logprob"] = inference_response.mean_logprob;
+            response.metrics["min_logprob"] = inference_response.min_logprob;
+            response.metrics["perplexity"] = inference_response.perplexity;
+        } else {
+            response.confidence_score = std::min(1.0, quality_analysis.overall_score + 0.1);
+        }
         
         // Add analysis tags based on quality analysis
         if (quality_analysis.coherence_score > 0.8) response.analysis_tags.push_back("coherent");
@@ -0,0 +1,126 @@
+// =================================================================
+// src/Camus/FileBlockFormat.cpp
+// =================================================================
+// Implementation of the constrained-decoding descriptions of the
+// "--- FILE: path ---" format.
+
+#include "Camus/FileBlockFormat.hpp"
+#include "nlohmann/json.hpp"
+#include <stdexcept>
+
+namespace Camus {
+
+namespace {
+const std::string MARKER_PREFIX = "--- FILE: ";
+const std::string MARKER_SUFFIX = " ---";
+}
+
+const std::string& FileBlockFormat::grammar() {
+    // Content lines are matched one character at a time while they could
+    // still turn into "--- FILE:"; any other first characters fall through
+    // to "rest". "-" stays last in each class so it is not read as a range.
+    static const std::string grammar = R"(root   ::= "NO CHANGES\n" | block+
+block  ::= "--- FILE: " path " ---\n" line*
+path   ::= [^ \t\r\n]+
+line   ::= "\n" | [^\n-] rest | "-" line1
+line1  ::= "\n" | [^\n-] rest | "-" line2
+line2  ::= "\n" | [^\n-] rest | "-" line3
+line3  ::= "\n" | [^\n ] rest | " " line4
+line4  ::= "\n" | [^\nF] rest | "F" line5
+line5  ::= "\n" | [^\nI] rest | "I" line6
+line6  ::= "\n" | [^\nL] rest | "L" line7
+line7  ::= "\n" | [^\nE] rest | "E" line8
+line8  ::= "\n" | [^\n:] rest
+rest   ::= [^\n]* "\n"
+)";
+    return grammar;
+}
+
+const std::string& FileBlockFormat::jsonSchema() {
+    static const std::string schema = nlohmann::json{
+        {"type", "object"},
+        {"properties", {
+            {"files", {
+                {"type", "array"},
+                {"minItems", 0},
+                {"items", {
+                    {"type", "object"},
+                    {"properties", {
+                        {"path", {{"type", "string"}}},
+                        {"content", {{"type", "string"}}}
+                    }},
+                    {"required", nlohmann::json::array({"path", "content"})}
+                }}
+            }}
+        }},
+        {"required", nlohmann::json::array({"files"})}
+    }.dump();
+    return schema;
+}
+
+std::string FileBlockFormat::fromJson(const std::string& json_text) {
+    nlohmann::json document;
+    try {
+        document = nlohmann::json::parse(json_text);
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Constrained response is not valid JSON: " + std::string(e.what()));
+    }
+    if (!document.is_object() || !document.contains("files") || !document["files"].is_array()) {
+        throw std::runtime_error("Constrained response has no \"files\" array");
+    }
+
+    std::string blocks;
+    for (const auto& file : document["files"]) {
+        if (!file.is_object() || !file.contains("path") || !file["path"].is_string() ||
+            !file.contains("content") || !file["content"].is_string()) {
+            continue;
+        }
+        std::string path = file["path"].get<std::string>();
+        if (path.empty() || path.find_first_of("\r\n") != std::string::npos) {
+            continue;
+        }
+        blocks += formatBlock(path, file["content"].get<std::string>());
+    }
+    return blocks;
+}
+
+std::string FileBlockFormat::formatBlock(const std::string& path, const std::string& content) {
+    std::string block;
+    block.reserve(MARKER_PREFIX.size() + path.size() + MARKER_SUFFIX.size() + content.size() + 2);
+    block += MARKER_PREFIX;
+    block += path;
+    block += MARKER_SUFFIX;
+    block += '\n';
+    block += content;
+    if (!content.empty() && content.back() != '\n') {
+        block += '\n';
+    }
+    return block;
+}
+
+bool FileBlockFormat::isNoChanges(const std::string& response) {
+    size_t begin = response.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return false;
+    }
+    size_t end = response.find_last_not_of(" \t\r\n");
+    return response.compare(begin, end - begin + 1, NO_CHANGES) == 0;
+}
+
+bool FileBlockFormat::parseMarker(const std::string& line, std::string* path) {
+    size_t length = line.size();
+    if (length > 0 && line[length - 1] == '\r') {
+        length--;
+    }
+    if (length <= MARKER_PREFIX.size() + MARKER_SUFFIX.size() ||
+        line.compare(0, MARKER_PREFIX.size(), MARKER_PREFIX) != 0 ||
+        line.compare(length - MARKER_SUFFIX.size(), MARKER_SUFFIX.size(), MARKER_SUFFIX) != 0) {
+        return false;
+    }
+    if (path) {
+        *path = line.substr(MARKER_PREFIX.size(), length - MARKER_PREFIX.size() - MARKER_SUFFIX.size());
+    }
+    return true;
+}
+
+} // namespace Camus
@@ -0,0 +1,344 @@
+// =================================================================
+// src/Camus/HnswIndex.cpp
+// =================================================================
+// Implementation of the HNSW nearest-neighbour index.
+
+#include "Camus/HnswIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <queue>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace Camus {
+
+namespace {
+
+const char kMagic[8] = {'C', 'H', 'N', 'S', 'W', '1', '\0', '\0'};
+
+void normalize(std::vector<float>& vector) {
+    double norm = 0.0;
+    for (float value : vector) {
+        norm += static_cast<double>(value) * value;
+    }
+    if (norm > 0.0) {
+        float scale = static_cast<float>(1.0 / std::sqrt(norm));
+        for (float& value : vector) {
+            value *= scale;
+        }
+    }
+}
+
+template <typename T>
+void writePod(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readPod(std::istream& in) {
+    T value{};
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::runtime_error("Truncated HNSW index");
+    }
+    return value;
+}
+
+} // namespace
+
+HnswIndex::HnswIndex(size_t dimensions, const HnswConfig& config)
+    : m_dimensions(dimensions), m_config(config) {
+    if (m_dimensions == 0) {
+        throw std::runtime_error("HNSW index needs at least one dimension");
+    }
+    m_config.max_links = std::max<size_t>(2, m_config.max_links);
+    m_config.ef_construction = std::max(m_config.ef_construction, m_config.max_links);
+    m_config.ef_search = std::max<size_t>(1, m_config.ef_search);
+}
+
+uint32_t HnswIndex::add(const std::vector<float>& vector) {
+    if (vector.size() != m_dimensions) {
+        throw std::runtime_error("Vector has " + std::to_string(vector.size()) + " dimensions, index expects " +
+                                 std::to_string(m_dimensions));
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_levels.size());
+    std::vector<float> unit = vector;
+    normalize(unit);
+    m_vectors.insert(m_vectors.end(), unit.begin(), unit.end());
+
+    int level = randomLevel();
+    m_levels.push_back(level);
+    m_links.emplace_back(static_cast<size_t>(level) + 1);
+    m_deleted.push_back(false);
+
+    if (m_max_level < 0) {
+        m_entry_point = id;
+        m_max_level = level;
+        return id;
+    }
+
+    const float* query = vectorAt(id);
+    uint32_t entry = m_entry_point;
+    for (int l = m_max_level; l > level; --l) {
+        entry = searchLayer(query, entry, 1, l).front().second;
+    }
+    for (int l = std::min(level, m_max_level); l >= 0; --l) {
+        auto candidates = searchLayer(query, entry, m_config.ef_construction, l);
+        m_links[id][l] = selectLinks(candidates, m_config.max_links);
+        for (uint32_t neighbour : m_links[id][l]) {
+            connect(neighbour, id, l);
+        }
+        entry = candidates.front().second;
+    }
+
+    if (level > m_max_level) {
+        m_max_level = level;
+        m_entry_point = id;
+    }
+    return id;
+}
+
+void HnswIndex::remove(uint32_t id) {
+    if (id < m_deleted.size() && !m_deleted[id]) {
+        m_deleted[id] = true;
+        m_deleted_count++;
+    }
+}
+
+std::vector<std::pair<uint32_t, float>> HnswIndex::search(const std::vector<float>& query, size_t k) const {
+    std::vector<std::pair<uint32_t, float>> results;
+    if (k == 0 || m_max_level < 0 || size() == 0 || query.size() != m_dimensions) {
+        return results;
+    }
+
+    std::vector<float> unit = query;
+    normalize(unit);
+
+    uint32_t entry = m_entry_point;
+    for (int l = m_max_level; l > 0; --l) {
+        entry = searchLayer(unit.data(), entry, 1, l).front().second;
+    }
+
+    // Deleted nodes take up candidate slots, so widen the search until
+    // enough live ones turn up or the whole graph has been seen
+    size_t ef = std::max(m_config.ef_search, k);
+    while (true) {
+        auto found = searchLayer(unit.data(), entry, ef, 0);
+        results.clear();
+        for (const auto& candidate : found) {
+            if (!m_deleted[candidate.second]) {
+                results.emplace_back(candidate.second, candidate.first);
+                if (results.size() == k) {
+                    break;
+                }
+            }
+        }
+        if (results.size() == k || results.size() == size() || ef >= m_levels.size()) {
+            break;
+        }
+        ef = std::min(ef * 2, m_levels.size());
+    }
+    return results;
+}
+
+HnswIndex HnswIndex::compacted(std::vector<uint32_t>& new_ids) const {
+    HnswIndex rebuilt(m_dimensions, m_config);
+    new_ids.assign(m_levels.size(), UINT32_MAX);
+    for (uint32_t id = 0; id < m_levels.size(); ++id) {
+        if (!m_deleted[id]) {
+            new_ids[id] = rebuilt.add(std::vector<float>(vectorAt(id), vectorAt(id) + m_dimensions));
+        }
+    }
+    return rebuilt;
+}
+
+void HnswIndex::save(std::ostream& out) const {
+    out.write(kMagic, sizeof(kMagic));
+    writePod<uint64_t>(out, m_dimensions);
+    writePod<uint64_t>(out, m_config.max_links);
+    writePod<uint64_t>(out, m_config.ef_construction);
+    writePod<uint64_t>(out, m_config.ef_search);
+    writePod<uint64_t>(out, m_levels.size());
+    writePod<uint32_t>(out, m_entry_point);
+    writePod<int32_t>(out, m_max_level);
+
+    for (uint32_t id = 0; id < m_levels.size(); ++id) {
+        writePod<int32_t>(out, m_levels[id]);
+        writePod<uint8_t>(out, m_deleted[id] ? 1 : 0);
+        out.write(reinterpret_cast<const char*>(vectorAt(id)), static_cast<std::streamsize>(m_dimensions * sizeof(float)));
+        for (const auto& links : m_links[id]) {
+            writePod<uint32_t>(out, static_cast<uint32_t>(links.size()));
+            out.write(reinterpret_cast<const char*>(links.data()),
+                      static_cast<std::streamsize>(links.size() * sizeof(uint32_t)));
+        }
+    }
+}
+
+HnswIndex HnswIndex::load(std::istream& in) {
+    char magic[sizeof(kMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not an HNSW index");
+    }
+
+    HnswConfig config;
+    size_t dimensions = readPod<uint64_t>(in);
+    config.max_links = readPod<uint64_t>(in);
+    config.ef_construction = readPod<uint64_t>(in);
+    config.ef_search = readPod<uint64_t>(in);
+    uint64_t count = readPod<uint64_t>(in);
+    if (dimensions == 0 || dimensions > 65536 || count > UINT32_MAX) {
+        throw std::runtime_error("Corrupt HNSW index header");
+    }
+
+    HnswIndex index(dimensions, config);
+    index.m_entry_point = readPod<uint32_t>(in);
+    index.m_max_level = readPod<int32_t>(in);
+    index.m_vectors.resize(static_cast<size_t>(count) * dimensions);
+    index.m_levels.reserve(count);
+    index.m_links.reserve(count);
+
+    for (uint64_t id = 0; id < count; ++id) {
+        int level = readPod<int32_t>(in);
+        if (level < 0 || level > index.m_max_level) {
+            throw std::runtime_error("Corrupt HNSW index node");
+        }
+        bool deleted = readPod<uint8_t>(in) != 0;
+        if (!in.read(reinterpret_cast<char*>(index.m_vectors.data() + id * dimensions),
+                     static_cast<std::streamsize>(dimensions * sizeof(float)))) {
+            throw std::runtime_error("Truncated HNSW index");
+        }
+        std::vector<std::vector<uint32_t>> node_links(static_cast<size_t>(level) + 1);
+        for (auto& links : node_links) {
+            uint32_t link_count = readPod<uint32_t>(in);
+            if (link_count > count) {
+                throw std::runtime_error("Corrupt HNSW index links");
+            }
+            links.resize(link_count);
+            if (!in.read(reinterpret_cast<char*>(links.data()), static_cast<std::streamsize>(link_count * sizeof(uint32_t)))) {
+                throw std::runtime_error("Truncated HNSW index");
+            }
+            for (uint32_t link : links) {
+                if (link >= count) {
+                    throw std::runtime_error("Corrupt HNSW index links");
+                }
+            }
+        }
+        index.m_levels.push_back(level);
+        index.m_links.push_back(std::move(node_links));
+        index.m_deleted.push_back(deleted);
+        index.m_deleted_count += deleted ? 1 : 0;
+    }
+
+    if (count > 0 && (index.m_entry_point >= count || index.m_levels[index.m_entry_point] != index.m_max_level)) {
+        throw std::runtime_error("Corrupt HNSW index entry point");
+    }
+    if (count == 0) {
+        index.m_max_level = -1;
+    }
+    index.m_rng.seed(static_cast<std::mt19937::result_type>(0x5eed + count));
+    return index;
+}
+
+float HnswIndex::similarity(const float* a, const float* b) const {
+    float sum = 0.0f;
+    for (size_t i = 0; i < m_dimensions; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+int HnswIndex::randomLevel() {
+    // P(level >= l) = max_links^-l, the distribution the HNSW paper recommends
+    std::uniform_real_distribution<double> uniform(std::numeric_limits<double>::min(), 1.0);
+    double level = -std::log(uniform(m_rng)) / std::log(static_cast<double>(m_config.max_links));
+    return std::min(static_cast<int>(level), 16);
+}
+
+std::vector<std::pair<float, uint32_t>> HnswIndex::searchLayer(const float* query, uint32_t entry,
+                                                               size_t ef, int level) const {
+    using Candidate = std::pair<float, uint32_t>;
+    std::priority_queue<Candidate> to_expand;                                               // Most similar on top
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> best;   // Least similar on top
+    std::unordered_set<uint32_t> visited;
+    visited.reserve(ef * 8);
+
+    float entry_similarity = similarity(query, vectorAt(entry));
+    to_expand.emplace(entry_similarity, entry);
+    best.emplace(entry_similarity, entry);
+    visited.insert(entry);
+
+    while (!to_expand.empty()) {
+        Candidate current = to_expand.top();
+        if (best.size() >= ef && current.first < best.top().first) {
+            break; // Nothing left to expand can improve the result set
+        }
+        to_expand.pop();
+
+        if (level > m_levels[current.second]) {
+            continue;
+        }
+        for (uint32_t neighbour : m_links[current.second][level]) {
+            if (!visited.insert(neighbour).second) {
+                continue;
+            }
+            float neighbour_similarity = similarity(query, vectorAt(neighbour));
+            if (best.size() < ef || neighbour_similarity > best.top().first) {
+                to_expand.emplace(neighbour_similarity, neighbour);
+                best.emplace(neighbour_similarity, neighbour);
+                if (best.size() > ef) {
+                    best.pop();
+                }
+            }
+        }
+    }
+
+    std::vector<Candidate> results;
+    results.reserve(best.size());
+    while (!best.empty()) {
+        results.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(results.begin(), results.end());
+    return results;
+}
+
+std::vector<uint32_t> HnswIndex::selectLinks(const std::vector<std::pair<float, uint32_t>>& candidates,
+                                             size_t max_count) const {
+    std::vector<uint32_t> selected;
+    for (const auto& candidate : candidates) {
+        if (selected.size() >= max_count) {
+            break;
+        }
+        const float* candidate_vector = vectorAt(candidate.second);
+        bool diverse = std::none_of(selected.begin(), selected.end(), [&](uint32_t kept) {
+            return similarity(candidate_vector, vectorAt(kept)) > candidate.first;
+        });
+        if (diverse) {
+            selected.push_back(candidate.second);
+        }
+    }
+    return selected;
+}
+
+void HnswIndex::connect(uint32_t from, uint32_t to, int level) {
+    auto& links = m_links[from][level];
+    links.push_back(to);
+    if (links.size() <= maxLinks(level)) {
+        return;
+    }
+
+    std::vector<std::pair<float, uint32_t>> candidates;
+    candidates.reserve(links.size());
+    for (uint32_t link : links) {
+        candidates.emplace_back(similarity(vectorAt(from), vectorAt(link)), link);
+    }
+    std::sort(candidates.begin(), candidates.end(), std::greater<std::pair<float, uint32_t>>());
+    links = selectLinks(candidates, maxLinks(level));
+}
+
+} // namespace Camus
@@ -0,0 +1,524 @@
+// =================================================================
+// src/Camus/HttpApiServer.cpp
+// =================================================================
+// Implementation of the OpenAI-compatible HTTP API server.
+
+#include "Camus/HttpApiServer.hpp"
+#include "Camus/Logger.hpp"
+#include "httplib.h"
+#include "nlohmann/json.hpp"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <csignal>
+#include <cctype>
+
+namespace Camus {
+
+namespace {
+
+volatile std::sig_atomic_t g_api_stop_requested = 0;
+
+void handleApiStopSignal(int) {
+    g_api_stop_requested = 1;
+}
+
+using json = nlohmann::json;
+
+const std::chrono::milliseconds WAIT_SLICE{200};
+
+std::string encode(const json& value) {
+    return value.dump(-1, ' ', false, json::error_handler_t::replace);
+}
+
+json errorObject(const std::string& message, const std::string& type, const std::string& code) {
+    json error = {{"message", message}, {"type", type}, {"param", nullptr}, {"code", nullptr}};
+    if (!code.empty()) {
+        error["code"] = code;
+    }
+    return {{"error", error}};
+}
+
+// Same heuristic as the rest of Camus: ~4 characters per token
+size_t estimateTokens(const std::string& text) {
+    return (text.size() + 3) / 4;
+}
+
+std::string contentText(const json& content) {
+    if (content.is_string()) {
+        return content.get<std::string>();
+    }
+    std::string text;
+    if (content.is_array()) {
+        for (const auto& part : content) {
+            if (part.is_object() && part.value("type", "") == "text") {
+                text += part.value("text", "");
+            }
+        }
+    }
+    return text;
+}
+
+// The orchestrator works on plain prompts; render the conversation as a transcript
+std::string renderChatPrompt(const json& messages) {
+    std::string prompt;
+    for (const auto& message : messages) {
+        std::string role = message.value("role", "user");
+        std::string content = contentText(message.contains("content") ? message["content"] : json());
+        if (role == "system" || role == "developer") {
+            prompt += content + "\n\n";
+        } else if (role == "assistant") {
+            prompt += "Assistant: " + content + "\n";
+        } else {
+            prompt += "User: " + content + "\n";
+        }
+    }
+    prompt += "Assistant:";
+    return prompt;
+}
+
+std::string finishReason(const PipelineResponse& response, int max_tokens) {
+    return (max_tokens > 0 && response.tokens_generated >= static_cast<size_t>(max_tokens)) ? "length" : "stop";
+}
+
+json textChoice(const std::string& text, const json& finish_reason) {
+    return {{"text", text}, {"index", 0}, {"logprobs", nullptr}, {"finish_reason", finish_reason}};
+}
+
+json chatChoice(const json& delta, const json& finish_reason) {
+    return {{"index", 0}, {"delta", delta}, {"finish_reason", finish_reason}};
+}
+
+std::string metricName(const std::string& key) {
+    std::string name;
+    for (char c : key) {
+        name += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::tolower(c)) : '_';
+    }
+    return name;
+}
+
+} // anonymous namespace
+
+HttpApiServer::HttpApiServer(ModelOrchestrator& orchestrator, ModelRegistry& registry,
+                             const ApiServerConfig& config)
+    : m_orchestrator(orchestrator), m_registry(registry), m_config(config) {
+    m_queue = std::make_unique<ApiRequestQueue>(
+        [this](const PipelineRequest& request) { return m_orchestrator.processRequest(request); },
+        m_config.queue);
+}
+
+HttpApiServer::~HttpApiServer() {
+    stop();
+    m_queue.reset();  // Joins the workers once queued requests finish
+}
+
+int HttpApiServer::start() {
+    if (m_server) {
+        return m_port;
+    }
+
+    m_server = std::make_unique<httplib::Server>();
+    size_t threads = std::max<size_t>(m_config.http_threads, 1);
+    m_server->new_task_queue = [threads] { return new httplib::ThreadPool(threads); };
+    m_server->set_payload_max_length(m_config.max_body_bytes);
+    setupRoutes();
+
+    if (m_config.port == 0) {
+        m_port = m_server->bind_to_any_port(m_config.host);
+    } else {
+        m_port = m_server->bind_to_port(m_config.host, m_config.port) ? m_config.port : -1;
+    }
+    if (m_port <= 0) {
+        m_server.reset();
+        throw std::runtime_error("Failed to bind HTTP API server to " + m_config.host + ":" +
+                                 std::to_string(m_config.port));
+    }
+
+    m_stopping = false;
+    m_listener = std::thread([this]() { m_server->listen_after_bind(); });
+
+    Logger::getInstance().info("HttpApiServer",
+        "Listening on " + m_config.host + ":" + std::to_string(m_port));
+    return m_port;
+}
+
+int HttpApiServer::run() {
+    g_api_stop_requested = 0;
+    auto old_int = std::signal(SIGINT, handleApiStopSignal);
+    auto old_term = std::signal(SIGTERM, handleApiStopSignal);
+
+    int port = start();
+    std::cout << "[INFO] Serving OpenAI-compatible API on http://" << m_config.host << ":" << port
+              << "/v1 (Ctrl+C to stop)" << std::endl;
+
+    while (!g_api_stop_requested && isRunning()) {
+        std::this_thread::sleep_for(WAIT_SLICE);
+    }
+    stop();
+
+    std::signal(SIGINT, old_int);
+    std::signal(SIGTERM, old_term);
+    std::cout << "[INFO] HTTP API server stopped" << std::endl;
+    return 0;
+}
+
+void HttpApiServer::stop() {
+    // Waiting handlers notice this within one wait slice and end their response
+    m_stopping = true;
+    if (m_server) {
+        m_server->stop();
+    }
+    if (m_listener.joinable()) {
+        m_listener.join();
+    }
+    m_server.reset();
+}
+
+bool HttpApiServer::isRunning() const {
+    return m_server && m_server->is_running();
+}
+
+ApiServerMetrics HttpApiServer::getMetrics() const {
+    std::lock_guard<std::mutex> lock(m_metrics_mutex);
+    ApiServerMetrics metrics = m_metrics;
+    metrics.queue = m_queue->getStats();
+    return metrics;
+}
+
+std::string HttpApiServer::renderMetrics() const {
+    ApiServerMetrics metrics = getMetrics();
+    std::ostringstream out;
+
+    out << "# HELP camus_api_responses_total HTTP responses by endpoint and status\n"
+        << "# TYPE camus_api_responses_total counter\n";
+    for (const auto& [key, count] : metrics.responses) {
+        size_t split = key.rfind(' ');
+        out << "camus_api_responses_total{endpoint=\"" << key.substr(0, split)
+            << "\",status=\"" << key.substr(split + 1) << "\"} " << count << "\n";
+    }
+
+    out << "# TYPE camus_api_streamed_responses_total counter\n"
+        << "camus_api_streamed_responses_total " << metrics.streamed_responses << "\n"
+        << "# TYPE camus_api_unauthorized_total counter\n"
+        << "camus_api_unauthorized_total " << metrics.unauthorized << "\n"
+        << "# TYPE camus_api_completions_total counter\n"
+        << "camus_api_completions_total " << metrics.completions << "\n"
+        << "# TYPE camus_api_completion_tokens_total counter\n"
+        << "camus_api_completion_tokens_total " << metrics.tokens_generated << "\n"
+        << "# TYPE camus_api_request_duration_ms_sum counter\n"
+        << "camus_api_request_duration_ms_sum " << metrics.total_latency.count() << "\n"
+        << "# HELP camus_api_queue_depth Requests waiting for a worker\n"
+        << "# TYPE camus_api_queue_depth gauge\n"
+        << "camus_api_queue_depth " << metrics.queue.queued << "\n"
+        << "# TYPE camus_api_running_requests gauge\n"
+        << "camus_api_running_requests " << metrics.queue.running << "\n"
+        << "# TYPE camus_api_executed_requests_total counter\n"
+        << "camus_api_executed_requests_total " << metrics.queue.completed << "\n"
+        << "# TYPE camus_api_cancelled_requests_total counter\n"
+        << "camus_api_cancelled_requests_total " << metrics.queue.cancelled << "\n"
+        << "# TYPE camus_api_rejected_requests_total counter\n"
+        << "camus_api_rejected_requests_total{reason=\"queue_full\"} " << metrics.queue.rejected_queue_full << "\n"
+        << "camus_api_rejected_requests_total{reason=\"client_limit\"} " << metrics.queue.rejected_client_limit << "\n"
+        << "# TYPE camus_api_queue_wait_ms_sum counter\n"
+        << "camus_api_queue_wait_ms_sum " << metrics.queue.total_queue_wait.count() << "\n";
+
+    PipelineStatistics pipeline = m_orchestrator.getStatistics();
+    out << "# TYPE camus_orchestrator_requests_total counter\n"
+        << "camus_orchestrator_requests_total " << pipeline.total_requests << "\n"
+        << "# TYPE camus_orchestrator_failed_requests_total counter\n"
+        << "camus_orchestrator_failed_requests_total " << pipeline.failed_requests << "\n"
+        << "# TYPE camus_orchestrator_cache_hits_total counter\n"
+        << "camus_orchestrator_cache_hits_total " << pipeline.cache_hits << "\n"
+        << "# TYPE camus_orchestrator_fallbacks_total counter\n"
+        << "camus_orchestrator_fallbacks_total " << pipeline.fallback_used << "\n";
+    for (const auto& [model, count] : pipeline.model_usage) {
+        out << "camus_orchestrator_model_requests_total{model=\"" << model << "\"} " << count << "\n";
+    }
+    for (const auto& [key, value] : m_orchestrator.getCacheStatistics()) {
+        out << "camus_orchestrator_cache_" << metricName(key) << " " << value << "\n";
+    }
+
+    return out.str();
+}
+
+void HttpApiServer::setupRoutes() {
+    m_server->Post("/v1/completions", [this](const httplib::Request& req, httplib::Response& res) {
+        handleCompletion(req, res, false);
+    });
+    m_server->Post("/v1/chat/completions", [this](const httplib::Request& req, httplib::Response& res) {
+        handleCompletion(req, res, true);
+    });
+    m_server->Get("/v1/models", [this](const httplib::Request& req, httplib::Response& res) {
+        std::string client_id;
+        if (authorize(req, res, client_id)) {
+            handleModels(res);
+        }
+        recordResponse("/v1/models", res.status);
+    });
+    m_server->Get("/health", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content("{\"status\":\"ok\"}", "application/json");
+    });
+    m_server->Get("/metrics", [this](const httplib::Request&, httplib::Response& res) {
+        res.set_content(renderMetrics(), "text/plain; version=0.0.4");
+    });
+}
+
+void HttpApiServer::handleCompletion(const httplib::Request& req, httplib::Response& res, bool chat) {
+    const std::string endpoint = chat ? "/v1/chat/completions" : "/v1/completions";
+    auto start_time = std::chrono::steady_clock::now();
+
+    auto fail = [&](int status, const std::string& message, const std::string& type, const std::string& code) {
+        res.status = status;
+        res.set_content(encode(errorObject(message, type, code)), "application/json");
+        recordResponse(endpoint, status);
+    };
+
+    std::string client_id;
+    if (!authorize(req, res, client_id)) {
+        recordResponse(endpoint, res.status);
+        return;
+    }
+
+    json body;
+    try {
+        body = json::parse(req.body);
+    } catch (const json::exception& e) {
+        fail(400, std::string("Invalid JSON body: ") + e.what(), "invalid_request_error", "");
+        return;
+    }
+    if (!body.is_object()) {
+        fail(400, "Request body must be a JSON object", "invalid_request_error", "");
+        return;
+    }
+
+    PipelineRequest request;
+    try {
+        if (chat) {
+            if (!body.contains("messages") || !body["messages"].is_array() || body["messages"].empty()) {
+                fail(400, "'messages' must be a non-empty array", "invalid_request_error", "");
+                return;
+            }
+            request.prompt = renderChatPrompt(body["messages"]);
+            request.max_tokens = body.value("max_completion_tokens", body.value("max_tokens", request.max_tokens));
+        } else {
+            const json prompt = body.contains("prompt") ? body["prompt"] : json();
+            if (prompt.is_string()) {
+                request.prompt = prompt.get<std::string>();
+            } else if (prompt.is_array() && prompt.size() == 1 && prompt[0].is_string()) {
+                request.prompt = prompt[0].get<std::string>();
+            } else {
+                fail(400, "'prompt' must be a string (batched prompts are not supported)",
+                     "invalid_request_error", "");
+                return;
+            }
+            request.max_tokens = body.value("max_tokens", request.max_tokens);
+        }
+        request.temperature = body.value("temperature", request.temperature);
+    } catch (const json::exception& e) {
+        fail(400, std::string("Invalid request field: ") + e.what(), "invalid_request_error", "");
+        return;
+    }
+    if (request.max_tokens <= 0) {
+        fail(400, "'max_tokens' must be positive", "invalid_request_error", "");
+        return;
+    }
+
+    // A configured model name is a preference; the served name lets the orchestrator pick
+    std::string model = body.value("model", std::string());
+    if (!model.empty() && model != m_config.served_model_name) {
+        auto configured = m_registry.getConfiguredModels();
+        bool known = std::any_of(configured.begin(), configured.end(),
+                                 [&model](const ModelConfig& config) { return config.name == model; });
+        if (!known) {
+            fail(404, "The model '" + model + "' does not exist", "invalid_request_error", "model_not_found");
+            return;
+        }
+        request.preferred_models.push_back(model);
+    }
+
+    bool stream = body.value("stream", false);
+    std::string id = (chat ? "chatcmpl-" : "cmpl-") + std::to_string(m_next_request_id++);
+    request.request_id = id;
+    request.timeout = m_config.request_timeout;
+    request.metadata["client_id"] = client_id;
+    request.metadata["endpoint"] = endpoint;
+
+    auto job = std::make_shared<ApiJob>(request, client_id);
+    switch (m_queue->submit(job)) {
+        case AdmissionResult::ACCEPTED:
+            break;
+        case AdmissionResult::QUEUE_FULL:
+            res.set_header("Retry-After", "1");
+            fail(429, "Server is at capacity; retry later", "rate_limit_error", "queue_full");
+            return;
+        case AdmissionResult::CLIENT_LIMIT:
+            res.set_header("Retry-After", "1");
+            fail(429, "Too many concurrent requests for this client", "rate_limit_error", "concurrency_limit");
+            return;
+        case AdmissionResult::SHUTTING_DOWN:
+            fail(503, "Server is shutting down", "server_error", "");
+            return;
+    }
+
+    const long long created = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::string reported_model = model.empty() ? m_config.served_model_name : model;
+    const auto deadline = start_time + m_config.request_timeout;
+    const int max_tokens = request.max_tokens;
+    const size_t prompt_tokens = estimateTokens(request.prompt);
+
+    if (!stream) {
+        bool finished = false;
+        while (!finished && !m_stopping && std::chrono::steady_clock::now() < deadline) {
+            finished = job->waitUntilDone(WAIT_SLICE);
+        }
+        if (!finished) {
+            job->cancel();
+            fail(504, "Timed out waiting for the model", "timeout_error", "timeout");
+            return;
+        }
+
+        PipelineResponse response = job->getResponse();
+        if (!response.success) {
+            fail(500, response.error_message.empty() ? "Request failed" : response.error_message,
+                 "server_error", "");
+            return;
+        }
+        recordCompletion(response, std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time));
+
+        std::string finish_reason = finishReason(response, max_tokens);
+        json choice = chat
+            ? json{{"index", 0},
+                   {"message", {{"role", "assistant"}, {"content", response.response_text}}},
+                   {"finish_reason", finish_reason}}
+            : textChoice(response.response_text, finish_reason);
+        json result = {
+            {"id", id},
+            {"object", chat ? "chat.completion" : "text_completion"},
+            {"created", created},
+            {"model", response.selected_model.empty() ? reported_model : response.selected_model},
+            {"choices", json::array({choice})},
+            {"usage", {
+                {"prompt_tokens", prompt_tokens},
+                {"completion_tokens", response.tokens_generated},
+                {"total_tokens", prompt_tokens + response.tokens_generated}
+            }}
+        };
+        res.set_content(encode(result), "application/json");
+        recordResponse(endpoint, 200);
+        return;
+    }
+
+    // Server-sent events: one chunk per piece of generated text
+    recordResponse(endpoint, 200);
+    {
+        std::lock_guard<std::mutex> lock(m_metrics_mutex);
+        m_metrics.streamed_responses++;
+    }
+    res.set_header("Cache-Control", "no-cache");
+    res.set_header("X-Accel-Buffering", "no");
+
+    auto sent_role = std::make_shared<bool>(false);
+    res.set_chunked_content_provider(
+        "text/event-stream",
+        [this, job, chat, id, created, reported_model, deadline, start_time, max_tokens, sent_role]
+        (size_t, httplib::DataSink& sink) {
+            const std::string object = chat ? "chat.completion.chunk" : "text_completion";
+            auto send = [&](const json& event) {
+                std::string frame = "data: " + encode(event) + "\n\n";
+                return sink.write(frame.data(), frame.size());
+            };
+            auto chunk = [&](const json& choice) {
+                return json{{"id", id}, {"object", object}, {"created", created},
+                            {"model", reported_model}, {"choices", json::array({choice})}};
+            };
+
+            if (chat && !*sent_role) {
+                *sent_role = true;
+                if (!send(chunk(chatChoice({{"role", "assistant"}, {"content", ""}}, nullptr)))) {
+                    return false;
+                }
+            }
+
+            std::string text;
+            ChunkStatus status = job->nextChunk(text, WAIT_SLICE);
+            if (status == ChunkStatus::DATA) {
+                return send(chunk(chat ? chatChoice({{"content", text}}, nullptr) : textChoice(text, nullptr)));
+            }
+            if (status == ChunkStatus::TIMEOUT) {
+                if (!m_stopping && std::chrono::steady_clock::now() < deadline) {
+                    return true;  // Keep waiting; called again immediately
+                }
+                job->cancel();
+                send(errorObject("Timed out waiting for the model", "timeout_error", "timeout"));
+            } else {
+                PipelineResponse response = job->getResponse();
+                if (response.success) {
+                    std::string finish_reason = finishReason(response, max_tokens);
+                    send(chunk(chat ? chatChoice(json::object(), finish_reason) : textChoice("", finish_reason)));
+                    recordCompletion(response, std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start_time));
+                } else {
+                    send(errorObject(response.error_message.empty() ? "Request failed" : response.error_message,
+                                     "server_error", ""));
+                }
+            }
+
+            static const std::string done_frame = "data: [DONE]\n\n";
+            sink.write(done_frame.data(), done_frame.size());
+            sink.done();
+            return true;
+        },
+        [job](bool success) {
+            // The client went away; don't spend model time on a queued request
+            if (!success) {
+                job->cancel();
+            }
+        });
+}
+
+void HttpApiServer::handleModels(httplib::Response& res) {
+    json data = json::array();
+    data.push_back({{"id", m_config.served_model_name}, {"object", "model"}, {"created", 0}, {"owned_by", "camus"}});
+    for (const auto& config : m_registry.getConfiguredModels()) {
+        data.push_back({{"id", config.name}, {"object", "model"}, {"created", 0}, {"owned_by", "camus"}});
+    }
+    res.set_content(encode({{"object", "list"}, {"data", data}}), "application/json");
+}
+
+bool HttpApiServer::authorize(const httplib::Request& req, httplib::Response& res, std::string& client_id) {
+    std::string token;
+    std::string authorization = req.get_header_value("Authorization");
+    if (authorization.rfind("Bearer ", 0) == 0) {
+        token = authorization.substr(7);
+    }
+
+    if (!m_config.api_keys.empty() &&
+        std::find(m_config.api_keys.begin(), m_config.api_keys.end(), token) == m_config.api_keys.end()) {
+        res.status = 401;
+        res.set_content(encode(errorObject("Invalid or missing API key", "invalid_request_error", "invalid_api_key")),
+                        "application/json");
+        std::lock_guard<std::mutex> lock(m_metrics_mutex);
+        m_metrics.unauthorized++;
+        return false;
+    }
+
+    client_id = token.empty() ? "addr:" + req.remote_addr : "key:" + token;
+    return true;
+}
+
+void HttpApiServer::recordResponse(const std::string& endpoint, int status) {
+    std::lock_guard<std::mutex> lock(m_metrics_mutex);
+    m_metrics.responses[endpoint + " " + std::to_string(status)]++;
+}
+
+void HttpApiServer::recordCompletion(const PipelineResponse& response, std::chrono::milliseconds latency) {
+    std::lock_guard<std::mutex> lock(m_metrics_mutex);
+    m_metrics.completions++;
+    m_metrics.tokens_generated += response.tokens_generated;
+    m_metrics.total_latency += latency;
+}
+
+} // namespace Camus
@@ -0,0 +1,112 @@
+// =================================================================
+// src/Camus/LazyLlmInteraction.cpp
+// =================================================================
+// Implementation of the deferred-construction backend handle.
+
+#include "Camus/LazyLlmInteraction.hpp"
+#include "Camus/ModelPrefetcher.hpp"
+#include <stdexcept>
+
+namespace Camus {
+
+LazyLlmInteraction::LazyLlmInteraction(Factory factory, std::string model_id, std::string prefetch_path,
+                                       std::string backend_endpoint)
+    : m_factory(std::move(factory)), m_model_id(std::move(model_id)), m_prefetch_path(std::move(prefetch_path)),
+      m_backend_endpoint(std::move(backend_endpoint)) {
+    if (!m_prefetch_path.empty()) {
+        ModelPrefetcher::getInstance().prefetch(m_prefetch_path);
+    }
+}
+
+LazyLlmInteraction::~LazyLlmInteraction() {
+    // A command that never needed the model should not keep reading it
+    if (!m_prefetch_path.empty()) {
+        ModelPrefetcher::getInstance().cancel(m_prefetch_path);
+    }
+}
+
+LlmInteraction& LazyLlmInteraction::backend() const {
+    std::lock_guard<std::mutex> lock(m_load_mutex);
+    if (!m_backend) {
+        if (m_load_failed) {
+            throw std::runtime_error("LLM backend unavailable: " + m_model_id);
+        }
+        m_backend = m_factory();
+        if (!m_backend) {
+            m_load_failed = true;
+            throw std::runtime_error("LLM backend failed to load: " + m_model_id);
+        }
+        m_loaded = true;
+    }
+    return *m_backend;
+}
+
+std::string LazyLlmInteraction::getCompletion(const std::string& prompt) {
+    return backend().getCompletion(prompt);
+}
+
+InferenceResponse LazyLlmInteraction::getCompletionWithMetadata(const InferenceRequest& request) {
+    return backend().getCompletionWithMetadata(request);
+}
+
+ModelMetadata LazyLlmInteraction::getModelMetadata() const {
+    return backend().getModelMetadata();
+}
+
+bool LazyLlmInteraction::isHealthy() const {
+    // Not loading is not a fault; report a failed load, though
+    if (!m_loaded.load()) {
+        std::lock_guard<std::mutex> lock(m_load_mutex);
+        return !m_load_failed;
+    }
+    return m_backend->isHealthy();
+}
+
+bool LazyLlmInteraction::performHealthCheck() {
+    try {
+        return backend().performHealthCheck();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+ModelPerformance LazyLlmInteraction::getCurrentPerformance() const {
+    if (!m_loaded.load()) {
+        return ModelPerformance();
+    }
+    return m_backend->getCurrentPerformance();
+}
+
+bool LazyLlmInteraction::warmUp() {
+    try {
+        return backend().warmUp();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void LazyLlmInteraction::cleanup() {
+    // Nothing to release if the backend was never loaded
+    if (m_loaded.load()) {
+        m_backend->cleanup();
+    }
+}
+
+std::string LazyLlmInteraction::getModelId() const {
+    if (!m_loaded.load()) {
+        return m_model_id;
+    }
+    return m_backend->getModelId();
+}
+
+std::string LazyLlmInteraction::getBackendEndpoint() const {
+    if (!m_backend_endpoint.empty()) {
+        return m_backend_endpoint;
+    }
+    if (!m_loaded.load()) {
+        return m_model_id;
+    }
+    return m_backend->getBackendEndpoint();
+}
+
+} // namespace Camus
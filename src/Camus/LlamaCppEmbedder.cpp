@@ -0,0 +1,112 @@
+// =================================================================
+// src/Camus/LlamaCppEmbedder.cpp
+// =================================================================
+// Implementation of the llama.cpp embedding backend.
+
+#include "Camus/LlamaCppEmbedder.hpp"
+#include "llama.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+namespace Camus {
+
+LlamaCppEmbedder::LlamaCppEmbedder(const std::string& model_path, size_t n_ctx)
+    : m_model_path(model_path), m_n_ctx(n_ctx) {
+    llama_backend_init();
+
+    auto mparams = llama_model_default_params();
+    mparams.n_gpu_layers = 99;
+
+    m_model = llama_load_model_from_file(m_model_path.c_str(), mparams);
+    if (m_model == nullptr) {
+        llama_backend_free();
+        throw std::runtime_error("Failed to load embedding model from path: " + m_model_path);
+    }
+
+    // Encoder models attend over the whole input, so it must fit one micro-batch
+    auto cparams = llama_context_default_params();
+    cparams.embeddings = true;
+    cparams.n_ctx = static_cast<uint32_t>(m_n_ctx);
+    cparams.n_batch = static_cast<uint32_t>(m_n_ctx);
+    cparams.n_ubatch = static_cast<uint32_t>(m_n_ctx);
+    cparams.n_threads = std::thread::hardware_concurrency();
+    cparams.n_threads_batch = std::thread::hardware_concurrency();
+
+    m_context = llama_new_context_with_model(m_model, cparams);
+    if (m_context == nullptr) {
+        llama_free_model(m_model);
+        llama_backend_free();
+        throw std::runtime_error("Failed to create llama embedding context.");
+    }
+    m_dimensions = static_cast<size_t>(llama_n_embd(m_model));
+
+    std::error_code ec;
+    auto size = std::filesystem::file_size(m_model_path, ec);
+    m_model_id = std::filesystem::path(m_model_path).filename().string() + ":" + std::to_string(ec ? 0 : size);
+}
+
+LlamaCppEmbedder::~LlamaCppEmbedder() {
+    if (m_context) llama_free(m_context);
+    if (m_model) llama_free_model(m_model);
+    llama_backend_free();
+}
+
+std::vector<float> LlamaCppEmbedder::embed(const std::string& text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<llama_token> tokens(text.size() + 8);
+    int n_tokens = llama_tokenize(m_model, text.c_str(), static_cast<int32_t>(text.size()),
+                                  tokens.data(), static_cast<int32_t>(tokens.size()), true, false);
+    if (n_tokens < 0) {
+        tokens.resize(static_cast<size_t>(-n_tokens));
+        n_tokens = llama_tokenize(m_model, text.c_str(), static_cast<int32_t>(text.size()),
+                                  tokens.data(), static_cast<int32_t>(tokens.size()), true, false);
+    }
+    n_tokens = std::min(n_tokens, static_cast<int>(m_n_ctx));
+
+    std::vector<float> embedding(m_dimensions, 0.0f);
+    if (n_tokens <= 0) {
+        return embedding;
+    }
+
+    llama_kv_cache_clear(m_context);
+    llama_batch batch = llama_batch_init(n_tokens, 0, 1);
+    for (int i = 0; i < n_tokens; ++i) {
+        batch.token[i] = tokens[static_cast<size_t>(i)];
+        batch.pos[i] = i;
+        batch.n_seq_id[i] = 1;
+        batch.seq_id[i][0] = 0;
+        batch.logits[i] = true;
+    }
+    batch.n_tokens = n_tokens;
+
+    if (llama_decode(m_context, batch)) {
+        llama_batch_free(batch);
+        throw std::runtime_error("llama_decode failed while embedding");
+    }
+
+    // Pooled models produce one vector per sequence; others only per token
+    const float* output = llama_get_embeddings_seq(m_context, 0);
+    if (output == nullptr) {
+        output = llama_get_embeddings_ith(m_context, n_tokens - 1);
+    }
+    llama_batch_free(batch);
+    if (output == nullptr) {
+        throw std::runtime_error("Embedding model returned no embeddings: " + m_model_path);
+    }
+
+    double norm = 0.0;
+    for (size_t i = 0; i < m_dimensions; ++i) {
+        norm += static_cast<double>(output[i]) * output[i];
+    }
+    float scale = norm > 0.0 ? static_cast<float>(1.0 / std::sqrt(norm)) : 0.0f;
+    for (size_t i = 0; i < m_dimensions; ++i) {
+        embedding[i] = output[i] * scale;
+    }
+    return embedding;
+}
+
+} // namespace Camus
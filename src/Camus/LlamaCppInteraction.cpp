@@ -2,7 +2,12 @@
 // src/Camus/LlamaCppInteraction.cpp
 // =================================================================
 #include "Camus/LlamaCppInteraction.hpp"
+#include "Camus/ModelPrefetcher.hpp"
+#include "Camus/MemoryGovernor.hpp"
+#include "Camus/PromptLookupDrafter.hpp"
+#include "Camus/FileBlockFormat.hpp"
 #include "llama.h"
+#include "grammar-parser.h"
 #include <stdexcept>
 #include <vector>
 #include <iostream>
@@ -10,7 +15,13 @@
 #include <string>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <cctype>
+#include <memory>
+#include <optional>
+#include <filesystem>
+#include <sys/stat.h>
 
 namespace Camus {
 
@@ -42,8 +53,45 @@ static void clean_llm_output(std::string& output) {
 }
 
 
-LlamaCppInteraction::LlamaCppInteraction(const std::string& model_path) : m_model_path(model_path) {
+LlamaCppInteraction::LlamaCppInteraction(const std::string& model_path)
+    : m_model_path(model_path), m_memory_key(model_path), m_n_ctx(4096) {
     llama_backend_init();
+    loadWeights();
+
+    // Initialize default metadata
+    initializeDefaultMetadata();
+    m_last_health_check = std::chrono::system_clock::now();
+    performHealthCheck();
+
+    std::cout << "[INFO] Successfully loaded model: " << model_path << std::endl;
+}
+
+LlamaCppInteraction::~LlamaCppInteraction() {
+    MemoryGovernor::getInstance().release(m_memory_key);
+    if (m_context) llama_free(m_context);
+    if (m_model) llama_free_model(m_model);
+    llama_backend_free();
+    std::cout << "[INFO] Cleaned up llama.cpp resources." << std::endl;
+}
+
+MemoryGovernor::Lease LlamaCppInteraction::loadWeights() {
+    // Expected footprint: the configured estimate or, failing that, the
+    // weights themselves; commit() replaces it with the measured figure
+    uint64_t file_bytes = 0;
+    struct stat st;
+    if (::stat(m_model_path.c_str(), &st) == 0) {
+        file_bytes = static_cast<uint64_t>(st.st_size);
+    }
+    uint64_t estimate = std::max(file_bytes, static_cast<uint64_t>(
+        m_metadata.performance.memory_usage_gb * 1024.0 * 1024.0 * 1024.0));
+
+    MemoryGovernor& governor = MemoryGovernor::getInstance();
+    if (!governor.admit(m_memory_key, estimate)) {
+        throw std::runtime_error("Memory budget exceeded; cannot load model: " + m_model_path);
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    uint64_t rss_before = MemoryGovernor::processRssBytes();
 
     auto mparams = llama_model_default_params();
 
@@ -52,37 +100,98 @@ LlamaCppInteraction::LlamaCppInteraction(const std::string& model_path) : m_mode
     mparams.n_gpu_layers = 99;
 
     auto cparams = llama_context_default_params();
-    cparams.n_ctx = 4096;
+    cparams.n_ctx = m_n_ctx;
     cparams.n_threads = std::thread::hardware_concurrency();
     cparams.n_threads_batch = std::thread::hardware_concurrency();
 
-    m_model = llama_load_model_from_file(model_path.c_str(), mparams);
+    m_model = llama_load_model_from_file(m_model_path.c_str(), mparams);
     if (m_model == nullptr) {
-        throw std::runtime_error("Failed to load model from path: " + model_path);
+        governor.abort(m_memory_key);
+        throw std::runtime_error("Failed to load model from path: " + m_model_path);
     }
 
     m_context = llama_new_context_with_model(m_model, cparams);
     if (m_context == nullptr) {
         llama_free_model(m_model);
+        m_model = nullptr;
+        governor.abort(m_memory_key);
         throw std::runtime_error("Failed to create llama context.");
     }
+    m_evicted = false;
+
+    // Mapped weights only count towards RSS once touched, so take the
+    // larger of the RSS growth and the estimate, plus the KV cache
+    uint64_t rss_after = MemoryGovernor::processRssBytes();
+    uint64_t rss_growth = rss_after > rss_before ? rss_after - rss_before : 0;
+    uint64_t kv_bytes = static_cast<uint64_t>(llama_state_get_size(m_context));
+    {
+        std::lock_guard<std::mutex> lock(m_metadata_mutex);
+        m_metadata.custom_attributes["kv_cache_bytes"] = std::to_string(kv_bytes);
+    }
 
-    // Initialize default metadata
-    initializeDefaultMetadata();
-    m_last_health_check = std::chrono::system_clock::now();
-    performHealthCheck();
+    // A reserved entry is never evicted, so leasing it before the commit
+    // leaves no window in which the new model is an idle victim
+    MemoryGovernor::Lease lease = governor.use(m_memory_key);
+    auto load_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    governor.commit(m_memory_key, std::max(rss_growth, estimate + kv_bytes), load_time,
+                    [this]() { unloadWeights(); });
+    return lease;
+}
 
-    std::cout << "[INFO] Successfully loaded model: " << model_path << std::endl;
+void LlamaCppInteraction::unloadWeights() {
+    std::lock_guard<std::mutex> lock(m_state_mutex);
+    if (m_context) {
+        llama_free(m_context);
+        m_context = nullptr;
+    }
+    if (m_model) {
+        llama_free_model(m_model);
+        m_model = nullptr;
+    }
+    m_cached_tokens.clear();
+    m_evicted = true;
+    std::cout << "[INFO] Unloaded idle model to free memory: " << m_model_path << std::endl;
 }
 
-LlamaCppInteraction::~LlamaCppInteraction() {
-    if (m_context) llama_free(m_context);
-    if (m_model) llama_free_model(m_model);
-    llama_backend_free();
-    std::cout << "[INFO] Cleaned up llama.cpp resources." << std::endl;
+// Compiles the grammar for a constraint; the GBNF text is parsed once
+static llama_grammar* create_grammar(ResponseConstraint constraint) {
+    if (constraint != ResponseConstraint::FILE_BLOCKS) {
+        return nullptr;
+    }
+    static const grammar_parser::parse_state parsed = grammar_parser::parse(FileBlockFormat::grammar().c_str());
+    auto root = parsed.symbol_ids.find("root");
+    if (parsed.rules.empty() || root == parsed.symbol_ids.end()) {
+        throw std::runtime_error("Failed to parse the FILE block grammar.");
+    }
+    std::vector<const llama_grammar_element*> rules = parsed.c_rules();
+    return llama_grammar_init(rules.data(), rules.size(), root->second);
 }
 
 std::string LlamaCppInteraction::getCompletion(const std::string& prompt) {
+    GenerationStats stats;
+    return generate(prompt, nullptr, stats);
+}
+
+std::string LlamaCppInteraction::generate(const std::string& prompt, const TokenCallback& on_token,
+                                          GenerationStats& stats, float temperature,
+                                          ResponseConstraint constraint, size_t max_new_tokens) {
+    // Lease before taking the state lock: the governor picks its victim
+    // before the eviction callback takes the state lock, so holding the lock
+    // first would let it choose this model and then block on us. An eviction
+    // that had already picked this model finishes before the state lock is
+    // granted, after which the weights are reloaded under a fresh lease
+    std::optional<MemoryGovernor::Lease> lease;
+    lease.emplace(MemoryGovernor::getInstance().use(m_memory_key));
+    std::lock_guard<std::mutex> state_lock(m_state_mutex);
+    if (m_model == nullptr) {
+        if (!m_evicted) {
+            throw std::runtime_error("Model has been cleaned up: " + m_model_path);
+        }
+        lease.reset();
+        lease.emplace(loadWeights());
+    }
+
     std::vector<llama_token> tokens_list;
     tokens_list.resize(prompt.size());
 
@@ -98,15 +207,39 @@ std::string LlamaCppInteraction::getCompletion(const std::string& prompt) {
         throw std::runtime_error("Prompt is too long for the model's context window.");
     }
 
-    llama_kv_cache_clear(m_context);
-    if (llama_decode(m_context, llama_batch_get_one(tokens_list.data(), n_tokens, 0, 0))) {
+    // Keep the KV entries of the prefix shared with the previous prompt and
+    // only decode the rest; batch prompts that share a project context cost
+    // one prefill plus a short suffix each
+    size_t n_past = 0;
+    while (n_past < m_cached_tokens.size() && n_past < tokens_list.size() &&
+           m_cached_tokens[n_past] == tokens_list[n_past]) {
+        n_past++;
+    }
+    if (n_past == tokens_list.size() && n_past > 0) {
+        n_past--; // The last prompt token must be decoded again to get its logits
+    }
+    if (!llama_kv_cache_seq_rm(m_context, 0, static_cast<llama_pos>(n_past), -1)) {
+        llama_kv_cache_clear(m_context);
+        n_past = 0;
+    }
+    m_cached_tokens.resize(n_past);
+    stats.reused_prompt_tokens = n_past;
+
+    if (llama_decode(m_context, llama_batch_get_one(tokens_list.data() + n_past,
+                                                    n_tokens - static_cast<int>(n_past),
+                                                    static_cast<llama_pos>(n_past), 0))) {
+        llama_kv_cache_clear(m_context);
+        m_cached_tokens.clear();
         throw std::runtime_error("Failed to decode prompt.");
     }
+    m_cached_tokens.assign(tokens_list.begin(), tokens_list.end());
 
     std::string result;
     int n_generated = 0;
-    const int max_new_tokens = 4096;
-    const long long timeout_seconds = 120;
+    // 120 s covered the default limit; longer answers get proportionally more
+    const int max_tokens = static_cast<int>(std::min<size_t>(max_new_tokens, std::numeric_limits<int>::max()));
+    const long long timeout_seconds = std::max<long long>(
+        120, static_cast<long long>(max_tokens) * 120 / static_cast<long long>(DEFAULT_MAX_NEW_TOKENS));
     auto start_time = std::chrono::steady_clock::now();
 
     std::vector<llama_token> last_n_tokens;
@@ -114,98 +247,241 @@ std::string LlamaCppInteraction::getCompletion(const std::string& prompt) {
     last_n_tokens.insert(last_n_tokens.end(), tokens_list.begin(), tokens_list.end());
 
     const llama_token eot_token = llama_token_eot(m_model);
-
-    while (n_generated < max_new_tokens) {
-        auto current_time = std::chrono::steady_clock::now();
-        auto elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(current_time - start_time).count();
-        if (elapsed_seconds > timeout_seconds) {
-            throw std::runtime_error("Model generation timed out after " + std::to_string(timeout_seconds) + " seconds.");
-        }
-
-        auto* logits  = llama_get_logits_ith(m_context, 0);
-        auto* candidates = new llama_token_data[llama_n_vocab(m_model)];
-        llama_token_data_array candidates_p = { candidates, static_cast<size_t>(llama_n_vocab(m_model)), false };
-
-        for (int token_id = 0; token_id < llama_n_vocab(m_model); token_id++) {
+    const int n_vocab = llama_n_vocab(m_model);
+    const int n_ctx = static_cast<int>(llama_n_ctx(m_context));
+
+    // Tokens that would leave the grammar are masked before sampling, so
+    // the output always parses
+    std::unique_ptr<llama_grammar, decltype(&llama_grammar_free)> grammar(
+        create_grammar(constraint), llama_grammar_free);
+
+    // Prompt lookup: continuations copied from the prompt are decoded in the
+    // same batch as the sampled token and kept while the model agrees
+    PromptLookupDrafter drafter(tokens_list, m_prompt_lookup);
+    std::vector<llama_token> history(tokens_list.begin(), tokens_list.end());
+    llama_batch batch = llama_batch_init(static_cast<int32_t>(m_prompt_lookup.max_draft + 1), 0, 1);
+    struct BatchRelease {
+        llama_batch& batch;
+        ~BatchRelease() { llama_batch_free(batch); }
+    } batch_release{batch};
+
+    std::vector<llama_token_data> candidates(static_cast<size_t>(n_vocab));
+    stats.logprobs.clear();
+    float sampled_logprob = 0.0f;
+    auto sample_at = [&](int32_t logits_index) {
+        auto* logits = llama_get_logits_ith(m_context, logits_index);
+        float max_logit = logits[0];
+        for (int token_id = 0; token_id < n_vocab; token_id++) {
             candidates[token_id].id = token_id;
             candidates[token_id].logit = logits[token_id];
             candidates[token_id].p = 0.0f;
+            max_logit = std::max(max_logit, logits[token_id]);
         }
+        llama_token_data_array candidates_p = { candidates.data(), candidates.size(), false };
 
         llama_sample_repetition_penalties(m_context, &candidates_p, last_n_tokens.data(), last_n_tokens.size(), 1.1f, 64, 1.0f);
-        llama_sample_top_k(m_context, &candidates_p, 40, 1);
-        llama_sample_top_p(m_context, &candidates_p, 0.95f, 1);
-        llama_sample_temp(m_context, &candidates_p, 0.4f);
-
-        llama_token new_token_id = llama_sample_token(m_context, &candidates_p);
+        if (grammar) {
+            llama_sample_grammar(m_context, &candidates_p, grammar.get());
+        }
 
-        delete[] candidates;
+        llama_token token;
+        if (temperature <= 0.0f) {
+            // Greedy decoding: the output depends only on the prompt
+            token = llama_sample_token_greedy(m_context, &candidates_p);
+        } else {
+            llama_sample_top_k(m_context, &candidates_p, 40, 1);
+            llama_sample_top_p(m_context, &candidates_p, 0.95f, 1);
+            llama_sample_temp(m_context, &candidates_p, temperature);
+            token = llama_sample_token(m_context, &candidates_p);
+        }
 
-        if (new_token_id == llama_token_eos(m_model) || new_token_id == eot_token) {
-            break;
+        // Log-probability under the model's own distribution (log-softmax
+        // of the raw logits), independent of the sampler settings
+        double sum_exp = 0.0;
+        for (int token_id = 0; token_id < n_vocab; token_id++) {
+            sum_exp += std::exp(static_cast<double>(logits[token_id] - max_logit));
+        }
+        sampled_logprob = static_cast<float>(logits[token] - max_logit - std::log(sum_exp));
+        return token;
+    };
+
+    auto emit = [&](llama_token token, float logprob) {
+        stats.logprobs.push_back(logprob);
+        if (grammar) {
+            llama_grammar_accept_token(m_context, grammar.get(), token);
         }
 
-        char piece[8] = {0};
-        // Corrected the function call to include the 'special' boolean argument.
-        llama_token_to_piece(m_model, new_token_id, piece, sizeof(piece), false);
+        // Pieces can be longer than a few bytes; the length is returned
+        char piece_buffer[64];
+        int piece_length = llama_token_to_piece(m_model, token, piece_buffer, sizeof(piece_buffer), false);
+        std::string piece(piece_buffer, piece_length > 0 ? static_cast<size_t>(piece_length) : 0);
         result += piece;
-        std::cout << piece << std::flush;
+        if (on_token) {
+            on_token(piece);
+        } else {
+            std::cout << piece << std::flush;
+        }
 
-        last_n_tokens.push_back(new_token_id);
+        last_n_tokens.push_back(token);
         if (last_n_tokens.size() > 64) {
             last_n_tokens.erase(last_n_tokens.begin());
         }
+        history.push_back(token);
+        n_generated++;
+    };
+
+    auto is_end = [&](llama_token token) {
+        return token == llama_token_eos(m_model) || token == eot_token;
+    };
+
+    int32_t logits_index = 0;
+    int n_pos = n_tokens; // Position of the next token in the sequence
+    bool has_pending = false;
+    llama_token pending = 0;
+    float pending_logprob = 0.0f;
+    while (n_generated < max_tokens) {
+        auto current_time = std::chrono::steady_clock::now();
+        auto elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(current_time - start_time).count();
+        if (elapsed_seconds > timeout_seconds) {
+            throw std::runtime_error("Model generation timed out after " + std::to_string(timeout_seconds) + " seconds.");
+        }
 
-        if (llama_decode(m_context, llama_batch_get_one(&new_token_id, 1, n_tokens + n_generated, 0))) {
+        // A token sampled while verifying the last draft is already chosen
+        llama_token new_token_id = has_pending ? pending : sample_at(logits_index);
+        float new_token_logprob = has_pending ? pending_logprob : sampled_logprob;
+        has_pending = false;
+        if (is_end(new_token_id)) {
+            break;
+        }
+        emit(new_token_id, new_token_logprob);
+        if (n_generated >= max_tokens || n_pos + 1 >= n_ctx) {
+            break;
+        }
+
+        size_t room = static_cast<size_t>(std::min(max_tokens - n_generated, n_ctx - n_pos - 1));
+        std::vector<int32_t> draft = drafter.propose(history, room);
+
+        batch.n_tokens = 0;
+        for (size_t i = 0; i <= draft.size(); ++i) {
+            batch.token[i] = i == 0 ? new_token_id : draft[i - 1];
+            batch.pos[i] = static_cast<llama_pos>(n_pos + static_cast<int>(i));
+            batch.n_seq_id[i] = 1;
+            batch.seq_id[i][0] = 0;
+            batch.logits[i] = true;
+            batch.n_tokens++;
+        }
+        if (llama_decode(m_context, batch)) {
+            llama_kv_cache_clear(m_context);
+            m_cached_tokens.clear();
             throw std::runtime_error("Failed to decode generated token.");
         }
-        n_generated++;
+        m_cached_tokens.push_back(new_token_id);
+        n_pos++;
+        logits_index = 0;
+
+        // Keep draft tokens while they are what the model samples itself;
+        // the first disagreement is a valid sample and becomes the next token
+        size_t accepted = 0;
+        while (accepted < draft.size() && n_generated < max_tokens) {
+            llama_token next = sample_at(static_cast<int32_t>(accepted));
+            if (next != draft[accepted] || is_end(next)) {
+                pending = next;
+                pending_logprob = sampled_logprob;
+                has_pending = true;
+                break;
+            }
+            emit(next, sampled_logprob);
+            m_cached_tokens.push_back(next);
+            n_pos++;
+            accepted++;
+            logits_index = static_cast<int32_t>(accepted);
+        }
+        if (!draft.empty()) {
+            drafter.accept(accepted);
+            if (accepted < draft.size()) {
+                // Rejected draft tokens must not stay in the KV cache
+                llama_kv_cache_seq_rm(m_context, 0, static_cast<llama_pos>(n_pos), -1);
+            }
+        }
     }
 
-    std::cout << std::endl;
+    stats.speculative = drafter.getStats();
+    m_speculative_stats += stats.speculative;
+
+    if (!on_token) {
+        std::cout << std::endl;
+    }
+    stats.tokens_generated = static_cast<size_t>(n_generated);
 
-    clean_llm_output(result);
+    // Fence stripping and trimming could cut into constrained content
+    if (!grammar) {
+        clean_llm_output(result);
+    }
 
     return result;
 }
 
 LlamaCppInteraction::LlamaCppInteraction(const std::string& model_path, const ModelMetadata& metadata) 
-    : m_metadata(metadata), m_model_path(model_path) {
+    : m_metadata(metadata), m_model_path(model_path),
+      m_memory_key(metadata.name.empty() ? model_path : metadata.name),
+      m_n_ctx(static_cast<uint32_t>(metadata.performance.max_context_tokens)) {
     llama_backend_init();
+    loadWeights();
 
-    auto mparams = llama_model_default_params();
-    mparams.n_gpu_layers = 99;
+    m_metadata.model_path = model_path;
+    configurePromptLookup();
+    m_last_health_check = std::chrono::system_clock::now();
+    performHealthCheck();
+}
 
-    auto cparams = llama_context_default_params();
-    cparams.n_ctx = metadata.performance.max_context_tokens;
-    cparams.n_threads = std::thread::hardware_concurrency();
-    cparams.n_threads_batch = std::thread::hardware_concurrency();
+SpeculativeStats LlamaCppInteraction::getSpeculativeStats() {
+    std::lock_guard<std::mutex> lock(m_state_mutex);
+    return m_speculative_stats;
+}
 
-    m_model = llama_load_model_from_file(model_path.c_str(), mparams);
-    if (m_model == nullptr) {
-        throw std::runtime_error("Failed to load model from path: " + model_path);
+void LlamaCppInteraction::configurePromptLookup() {
+    const auto& attributes = m_metadata.custom_attributes;
+    auto it = attributes.find("prompt_lookup");
+    if (it != attributes.end()) {
+        m_prompt_lookup.enabled = it->second != "false" && it->second != "0";
     }
-
-    m_context = llama_new_context_with_model(m_model, cparams);
-    if (m_context == nullptr) {
-        llama_free_model(m_model);
-        throw std::runtime_error("Failed to create llama context.");
+    try {
+        it = attributes.find("prompt_lookup_ngram");
+        if (it != attributes.end()) {
+            m_prompt_lookup.max_ngram = std::stoul(it->second);
+        }
+        it = attributes.find("prompt_lookup_max_draft");
+        if (it != attributes.end()) {
+            m_prompt_lookup.max_draft = std::stoul(it->second);
+        }
+    } catch (const std::exception&) {
+        std::cerr << "[WARN] Ignoring invalid prompt_lookup setting: " << it->second << std::endl;
     }
-
-    m_metadata.model_path = model_path;
-    m_last_health_check = std::chrono::system_clock::now();
-    performHealthCheck();
+    m_prompt_lookup.min_ngram = std::min(m_prompt_lookup.min_ngram, std::max<size_t>(1, m_prompt_lookup.max_ngram));
 }
 
 InferenceResponse LlamaCppInteraction::getCompletionWithMetadata(const InferenceRequest& request) {
     auto start_time = std::chrono::steady_clock::now();
     
     InferenceResponse response;
-    response.text = getCompletion(request.prompt);
+    GenerationStats stats;
+    response.text = generate(request.prompt, request.on_token, stats,
+                             static_cast<float>(request.temperature), request.constraint, request.max_tokens);
+    response.tokens_generated = stats.tokens_generated;
     
     auto end_time = std::chrono::steady_clock::now();
     response.response_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    response.finish_reason = "stop";
+    response.was_truncated = stats.tokens_generated >= request.max_tokens;
+    response.finish_reason = response.was_truncated ? "length" : "stop";
+    response.metadata["cached_prompt_tokens"] = std::to_string(stats.reused_prompt_tokens);
+    response.metadata["draft_tokens"] = std::to_string(stats.speculative.drafted_tokens);
+    response.metadata["accepted_draft_tokens"] = std::to_string(stats.speculative.accepted_tokens);
+    response.metadata["draft_acceptance_rate"] = std::to_string(stats.speculative.acceptanceRate());
+    response.token_logprobs = std::move(stats.logprobs);
+    response.summarizeLogprobs();
+    if (request.constraint == ResponseConstraint::FILE_BLOCKS) {
+        response.metadata["constraint"] = FileBlockFormat::CONSTRAINT_NAME;
+    }
     
     // Update performance metrics
     updatePerformanceMetrics(response);
@@ -214,17 +490,29 @@ InferenceResponse LlamaCppInteraction::getCompletionWithMetadata(const Inference
 }
 
 ModelMetadata LlamaCppInteraction::getModelMetadata() const {
-    return m_metadata;
+    ModelMetadata metadata;
+    {
+        std::lock_guard<std::mutex> lock(m_metadata_mutex);
+        metadata = m_metadata;
+    }
+    metadata.page_cache_residency = ModelPrefetcher::getInstance().residency(m_model_path);
+    return metadata;
 }
 
 bool LlamaCppInteraction::isHealthy() const {
-    return m_is_healthy && m_model != nullptr && m_context != nullptr;
+    // An evicted model reloads on its next request
+    return m_evicted || (m_is_healthy && m_model != nullptr && m_context != nullptr);
 }
 
 bool LlamaCppInteraction::performHealthCheck() {
     m_last_health_check = std::chrono::system_clock::now();
     
     try {
+        if (m_evicted) {
+            m_metadata.health_status_message = "Evicted to free memory; reloads on demand";
+            return true;
+        }
+        
         // Simple health check - verify model and context are valid
         if (m_model == nullptr || m_context == nullptr) {
             m_is_healthy = false;
@@ -271,6 +559,10 @@ bool LlamaCppInteraction::warmUp() {
 }
 
 void LlamaCppInteraction::cleanup() {
+    // Before taking the state lock: release() waits for a running eviction
+    MemoryGovernor::getInstance().release(m_memory_key);
+    std::lock_guard<std::mutex> lock(m_state_mutex);
+    m_evicted = false;
     if (m_context) {
         llama_free(m_context);
         m_context = nullptr;
@@ -279,6 +571,7 @@ void LlamaCppInteraction::cleanup() {
         llama_free_model(m_model);
         m_model = nullptr;
     }
+    m_cached_tokens.clear();
     m_is_healthy = false;
     m_metadata.is_healthy = false;
     m_metadata.is_available = false;
@@ -291,6 +584,14 @@ std::string LlamaCppInteraction::getModelId() const {
     return m_metadata.name + "_" + m_metadata.version;
 }
 
+std::string LlamaCppInteraction::getBackendEndpoint() const {
+    return endpointFor(m_model_path);
+}
+
+std::string LlamaCppInteraction::endpointFor(const std::string& model_path) {
+    return "llama_cpp:" + std::filesystem::path(model_path).lexically_normal().string();
+}
+
 void LlamaCppInteraction::initializeDefaultMetadata() {
     if (m_metadata.name.empty()) {
         m_metadata.name = "LlamaCpp_Model";
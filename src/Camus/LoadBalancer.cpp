@@ -5,6 +5,8 @@
 
 #include "Camus/LoadBalancer.hpp"
 #include "Camus/Logger.hpp"
+#include "Camus/AdaptiveConcurrencyLimiter.hpp"
+#include "Camus/MemoryGovernor.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -21,7 +23,7 @@ namespace Camus {
  */
 class LoadBalancer::RoundRobinStrategy : public BalancingStrategy {
 private:
-    std::unordered_map<std::string, size_t> m_counters; // model_name -> counter
+    std::vector<size_t> m_counters; // model id -> counter
     mutable std::mutex m_mutex;
     
 public:
@@ -29,21 +31,32 @@ public:
         const RequestContext& context,
         const std::vector<ModelInstance*>& instances
     ) override {
-        if (instances.empty()) return "";
+        auto* selected = pickInstance(context, instances);
+        return selected ? selected->instance_id : "";
+    }
+    
+    ModelInstance* pickInstance(
+        const RequestContext& context,
+        const std::vector<ModelInstance*>& instances
+    ) override {
+        if (instances.empty()) return nullptr;
         
         std::lock_guard<std::mutex> lock(m_mutex);
         
-        // Group instances by model name to maintain separate counters
-        std::string model_name;
-        if (!instances.empty()) {
-            model_name = instances[0]->model_name;
+        // Keep a separate counter per model
+        InternedId model_id = instances[0]->model_id;
+        if (model_id == INVALID_INTERNED_ID) {
+            model_id = 0;
+        }
+        if (model_id >= m_counters.size()) {
+            m_counters.resize(model_id + 1, 0);
         }
         
-        size_t& counter = m_counters[model_name];
+        size_t& counter = m_counters[model_id];
         size_t selected_index = counter % instances.size();
         counter++;
         
-        return instances[selected_index]->instance_id;
+        return instances[selected_index];
     }
     
     std::string getName() const override {
@@ -60,7 +73,15 @@ public:
         const RequestContext& context,
         const std::vector<ModelInstance*>& instances
     ) override {
-        if (instances.empty()) return "";
+        auto* selected = pickInstance(context, instances);
+        return selected ? selected->instance_id : "";
+    }
+    
+    ModelInstance* pickInstance(
+        const RequestContext& context,
+        const std::vector<ModelInstance*>& instances
+    ) override {
+        if (instances.empty()) return nullptr;
         
         // Find instance with minimum active requests
         auto min_it = std::min_element(instances.begin(), instances.end(),
@@ -68,7 +89,7 @@ public:
                 return a->active_requests.load() < b->active_requests.load();
             });
         
-        return (*min_it)->instance_id;
+        return *min_it;
     }
     
     std::string getName() const override {
@@ -85,7 +106,15 @@ public:
         const RequestContext& context,
         const std::vector<ModelInstance*>& instances
     ) override {
-        if (instances.empty()) return "";
+        auto* selected = pickInstance(context, instances);
+        return selected ? selected->instance_id : "";
+    }
+    
+    ModelInstance* pickInstance(
+        const RequestContext& context,
+        const std::vector<ModelInstance*>& instances
+    ) override {
+        if (instances.empty()) return nullptr;
         
         // Find instance with best average response time
         auto best_it = std::min_element(instances.begin(), instances.end(),
@@ -104,7 +133,7 @@ public:
                 return a_time < b_time;
             });
         
-        return (*best_it)->instance_id;
+        return *best_it;
     }
     
     std::string getName() const override {
@@ -121,7 +150,15 @@ public:
         const RequestContext& context,
         const std::vector<ModelInstance*>& instances
     ) override {
-        if (instances.empty()) return "";
+        auto* selected = pickInstance(context, instances);
+        return selected ? selected->instance_id : "";
+    }
+    
+    ModelInstance* pickInstance(
+        const RequestContext& context,
+        const std::vector<ModelInstance*>& instances
+    ) override {
+        if (instances.empty()) return nullptr;
         
         // Find instance with lowest resource usage
         auto best_it = std::min_element(instances.begin(), instances.end(),
@@ -132,7 +169,7 @@ public:
                 return a_load < b_load;
             });
         
-        return (*best_it)->instance_id;
+        return *best_it;
     }
     
     std::string getName() const override {
@@ -145,21 +182,36 @@ public:
  */
 class LoadBalancer::WeightedRoundRobinStrategy : public BalancingStrategy {
 private:
-    std::unordered_map<std::string, size_t> m_counters; // instance_id -> counter
-    std::unordered_map<std::string, double> m_weights; // instance_id -> weight
+    size_t m_fallback_counter = 0;
+    std::vector<double> m_weights; // instance id -> weight (negative = unset)
     mutable std::mutex m_mutex;
     
 public:
     void setWeights(const std::unordered_map<std::string, double>& weights) {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_weights = weights;
+        m_weights.clear();
+        for (const auto& [instance_id, weight] : weights) {
+            InternedId id = StringInterner::instances().intern(instance_id);
+            if (id >= m_weights.size()) {
+                m_weights.resize(id + 1, -1.0);
+            }
+            m_weights[id] = weight;
+        }
     }
     
     std::string selectInstance(
         const RequestContext& context,
         const std::vector<ModelInstance*>& instances
     ) override {
-        if (instances.empty()) return "";
+        auto* selected = pickInstance(context, instances);
+        return selected ? selected->instance_id : "";
+    }
+    
+    ModelInstance* pickInstance(
+        const RequestContext& context,
+        const std::vector<ModelInstance*>& instances
+    ) override {
+        if (instances.empty()) return nullptr;
         
         std::lock_guard<std::mutex> lock(m_mutex);
         
@@ -169,9 +221,8 @@ public:
         
         for (auto* instance : instances) {
             double weight = 1.0; // Default weight
-            auto weight_it = m_weights.find(instance->instance_id);
-            if (weight_it != m_weights.end()) {
-                weight = weight_it->second;
+            if (instance->id < m_weights.size() && m_weights[instance->id] >= 0.0) {
+                weight = m_weights[instance->id];
             }
             
             weighted_instances.push_back({instance, weight});
@@ -180,10 +231,9 @@ public:
         
         if (total_weight == 0.0) {
             // Fallback to round-robin if no weights
-            size_t& counter = m_counters["fallback"];
-            size_t selected_index = counter % instances.size();
-            counter++;
-            return instances[selected_index]->instance_id;
+            size_t selected_index = m_fallback_counter % instances.size();
+            m_fallback_counter++;
+            return instances[selected_index];
         }
         
         // Select based on weighted probability
@@ -197,12 +247,12 @@ public:
         for (const auto& [instance, weight] : weighted_instances) {
             cumulative_weight += weight;
             if (random_value <= cumulative_weight) {
-                return instance->instance_id;
+                return instance;
             }
         }
         
         // Fallback to last instance
-        return weighted_instances.back().first->instance_id;
+        return weighted_instances.back().first;
     }
     
     std::string getName() const override {
@@ -215,7 +265,8 @@ public:
 // =================================================================
 
 LoadBalancer::LoadBalancer(ModelRegistry& registry, const LoadBalancerConfig& config)
-    : m_registry(registry), m_config(config), m_current_strategy(config.default_strategy) {
+    : m_registry(registry), m_config(config), m_current_strategy(config.default_strategy),
+      m_monitor(config.resource_monitor ? config.resource_monitor : &ResourceMonitor::getInstance()) {
     
     // Register built-in strategies
     registerStrategy(LoadBalancingStrategy::ROUND_ROBIN, 
@@ -243,26 +294,47 @@ LoadBalancer::~LoadBalancer() {
 }
 
 LoadBalancingResult LoadBalancer::selectInstance(const std::string& model_name, const RequestContext& context) {
+    // Registry models are interned when it loads; looking up a name must
+    // not intern arbitrary caller input for the life of the process
+    InternedId model_id = StringInterner::models().find(model_name);
+    if (model_id == INVALID_INTERNED_ID) {
+        LoadBalancingResult result;
+        result.selection_reason = "Unknown model: " + model_name;
+        Logger::getInstance().error("LoadBalancer", result.selection_reason);
+        return result;
+    }
+    return selectInstance(model_id, context);
+}
+
+LoadBalancingResult LoadBalancer::selectInstance(InternedId model_id, const RequestContext& context) {
     auto start_time = std::chrono::steady_clock::now();
     LoadBalancingResult result;
+    const std::string& model_name = StringInterner::models().name(model_id);
     
     std::lock_guard<std::mutex> lock(m_instances_mutex);
     
     // Get instances for the model
-    auto instances = getInstancesForModel(model_name);
+    auto instances = instancesForModel(model_id);
     
-    // Filter out unhealthy instances
+    // Filter out unhealthy and saturated instances
+    size_t request_limit = requestLimit(instances);
     std::vector<ModelInstance*> healthy_instances;
+    std::vector<ModelInstance*> saturated_instances;
     for (auto* instance : instances) {
-        if (instance->is_healthy.load() && 
-            instance->active_requests.load() < m_config.max_requests_per_instance) {
+        if (!instance->is_healthy.load()) {
+            continue;
+        }
+        if (instance->active_requests.load() < request_limit) {
             healthy_instances.push_back(instance);
+        } else {
+            saturated_instances.push_back(instance);
         }
     }
     
     if (healthy_instances.empty()) {
         // Try to create new instance if auto-scaling is enabled
-        if (m_config.auto_scale && instances.size() < m_config.max_instances_per_model) {
+        if (m_config.auto_scale && instances.size() < m_config.max_instances_per_model &&
+            hasMemoryHeadroom()) {
             std::string new_instance_id = createInstance(model_name);
             if (!new_instance_id.empty()) {
                 auto* new_instance = getInstance(new_instance_id);
@@ -272,6 +344,12 @@ LoadBalancingResult LoadBalancer::selectInstance(const std::string& model_name,
             }
         }
         
+        // Over the adaptive limit the request still gets an instance; the
+        // backend's limiter queues it until a permit frees up
+        if (healthy_instances.empty() && m_config.adaptive_concurrency) {
+            healthy_instances = saturated_instances;
+        }
+        
         if (healthy_instances.empty()) {
             result.selection_reason = "No healthy instances available for model: " + model_name;
             Logger::getInstance().error("LoadBalancer", result.selection_reason);
@@ -287,28 +365,22 @@ LoadBalancingResult LoadBalancer::selectInstance(const std::string& model_name,
         return result;
     }
     
-    std::string selected_id = strategy_it->second->selectInstance(context, healthy_instances);
-    if (selected_id.empty()) {
-        result.selection_reason = "Strategy failed to select instance";
-        Logger::getInstance().error("LoadBalancer", result.selection_reason);
-        return result;
-    }
-    
-    auto* selected_instance = getInstance(selected_id);
+    auto* selected_instance = strategy_it->second->pickInstance(context, healthy_instances);
     if (!selected_instance) {
-        result.selection_reason = "Selected instance not found: " + selected_id;
+        result.selection_reason = "Strategy failed to select instance";
         Logger::getInstance().error("LoadBalancer", result.selection_reason);
         return result;
     }
     
     // Build result
-    result.selected_instance_id = selected_id;
+    result.selected_instance_id = selected_instance->instance_id;
+    result.selected_instance = selected_instance->id;
     result.model = selected_instance->model;
     result.selection_reason = "Selected by " + strategy_it->second->getName() + " strategy";
     
     // Add alternatives
     for (auto* instance : healthy_instances) {
-        if (instance->instance_id != selected_id) {
+        if (instance != selected_instance) {
             result.alternative_instances.push_back(instance->instance_id);
         }
     }
@@ -318,7 +390,7 @@ LoadBalancingResult LoadBalancer::selectInstance(const std::string& model_name,
         end_time - start_time);
     
     Logger::getInstance().debug("LoadBalancer", 
-        "Selected instance " + selected_id + " for model " + model_name);
+        "Selected instance " + result.selected_instance_id + " for model " + model_name);
     
     return result;
 }
@@ -334,7 +406,11 @@ std::string LoadBalancer::createInstance(const std::string& model_name) {
     std::lock_guard<std::mutex> lock(m_instances_mutex);
     
     // Check if we've reached the limit
-    auto& model_instances = m_model_instances[model_name];
+    InternedId model_id = StringInterner::models().intern(model_name);
+    if (model_id >= m_model_instances.size()) {
+        m_model_instances.resize(model_id + 1);
+    }
+    auto& model_instances = m_model_instances[model_id];
     if (model_instances.size() >= m_config.max_instances_per_model) {
         Logger::getInstance().warning("LoadBalancer", 
             "Maximum instances reached for model: " + model_name);
@@ -348,6 +424,8 @@ std::string LoadBalancer::createInstance(const std::string& model_name) {
     auto instance = std::make_unique<ModelInstance>();
     instance->instance_id = instance_id;
     instance->model_name = model_name;
+    instance->id = StringInterner::instances().intern(instance_id);
+    instance->model_id = model_id;
     instance->model = model;
     instance->is_healthy.store(true);
     instance->active_requests.store(0);
@@ -381,9 +459,20 @@ std::string LoadBalancer::createInstance(const std::string& model_name) {
         }
     }
     
+    // Prefer the footprint measured when the weights were loaded
+    uint64_t measured = MemoryGovernor::getInstance().getFootprint(model_name);
+    if (measured > 0) {
+        instance->current_memory_usage = static_cast<double>(measured) / (1024.0 * 1024.0 * 1024.0);
+    }
+    
     // Store instance
-    model_instances.push_back(instance_id);
-    m_instances[instance_id] = std::move(instance);
+    InternedId id = instance->id;
+    if (id >= m_instances.size()) {
+        m_instances.resize(id + 1);
+    }
+    model_instances.push_back(id);
+    m_instances[id] = std::move(instance);
+    m_instance_count++;
     
     Logger::getInstance().info("LoadBalancer", 
         "Created instance " + instance_id + " for model " + model_name);
@@ -394,21 +483,22 @@ std::string LoadBalancer::createInstance(const std::string& model_name) {
 bool LoadBalancer::removeInstance(const std::string& instance_id) {
     std::lock_guard<std::mutex> lock(m_instances_mutex);
     
-    auto instance_it = m_instances.find(instance_id);
-    if (instance_it == m_instances.end()) {
+    InternedId id = StringInterner::instances().find(instance_id);
+    if (id >= m_instances.size() || !m_instances[id]) {
         return false;
     }
     
-    std::string model_name = instance_it->second->model_name;
+    std::string model_name = m_instances[id]->model_name;
     
     // Remove from model instances list
-    auto& model_instances = m_model_instances[model_name];
+    auto& model_instances = m_model_instances[m_instances[id]->model_id];
     model_instances.erase(
-        std::remove(model_instances.begin(), model_instances.end(), instance_id),
+        std::remove(model_instances.begin(), model_instances.end(), id),
         model_instances.end());
     
     // Remove instance
-    m_instances.erase(instance_it);
+    m_instances[id].reset();
+    m_instance_count--;
     
     Logger::getInstance().info("LoadBalancer", 
         "Removed instance " + instance_id + " for model " + model_name);
@@ -417,14 +507,16 @@ bool LoadBalancer::removeInstance(const std::string& instance_id) {
 }
 
 std::vector<ModelInstance*> LoadBalancer::getInstancesForModel(const std::string& model_name) {
+    return instancesForModel(StringInterner::models().find(model_name));
+}
+
+std::vector<ModelInstance*> LoadBalancer::instancesForModel(InternedId model_id) const {
     std::vector<ModelInstance*> instances;
     
-    auto model_it = m_model_instances.find(model_name);
-    if (model_it != m_model_instances.end()) {
-        for (const auto& instance_id : model_it->second) {
-            auto instance_it = m_instances.find(instance_id);
-            if (instance_it != m_instances.end()) {
-                instances.push_back(instance_it->second.get());
+    if (model_id < m_model_instances.size()) {
+        for (InternedId instance_id : m_model_instances[model_id]) {
+            if (m_instances[instance_id]) {
+                instances.push_back(m_instances[instance_id].get());
             }
         }
     }
@@ -432,9 +524,35 @@ std::vector<ModelInstance*> LoadBalancer::getInstancesForModel(const std::string
     return instances;
 }
 
+bool LoadBalancer::hasMemoryHeadroom() const {
+    auto snapshot = m_monitor->getSnapshot();
+    if (snapshot.memory_limit_bytes == 0) {
+        return true; // Nothing measured; do not block scaling
+    }
+    if (snapshot.memory_usage_percent / 100.0 >= m_config.memory_usage_threshold) {
+        Logger::getInstance().debug("LoadBalancer", 
+            "Not adding instances: memory usage at " + std::to_string(snapshot.memory_usage_percent) + "%");
+        return false;
+    }
+    return true;
+}
+
+size_t LoadBalancer::requestLimit(const std::vector<ModelInstance*>& instances) const {
+    if (!m_config.adaptive_concurrency || instances.empty() || !instances.front()->model) {
+        return m_config.max_requests_per_instance;
+    }
+    // Instances of a model run on the same backend, which all its models share
+    const std::string endpoint = instances.front()->model->getBackendEndpoint();
+    return std::min(m_config.max_requests_per_instance,
+                    AdaptiveConcurrencyLimiter::forBackend(endpoint).getLimit());
+}
+
 ModelInstance* LoadBalancer::getInstance(const std::string& instance_id) {
-    auto it = m_instances.find(instance_id);
-    return (it != m_instances.end()) ? it->second.get() : nullptr;
+    return getInstance(StringInterner::instances().find(instance_id));
+}
+
+ModelInstance* LoadBalancer::getInstance(InternedId instance_id) {
+    return instance_id < m_instances.size() ? m_instances[instance_id].get() : nullptr;
 }
 
 void LoadBalancer::registerStrategy(LoadBalancingStrategy strategy, 
@@ -460,21 +578,27 @@ LoadBalancingStrategy LoadBalancer::getStrategy() const {
 }
 
 void LoadBalancer::recordRequestStart(const std::string& instance_id, const std::string& request_id) {
+    recordRequestStart(StringInterner::instances().find(instance_id), request_id);
+}
+
+void LoadBalancer::recordRequestStart(InternedId instance_id, const std::string& request_id) {
     auto* instance = getInstance(instance_id);
     if (instance) {
         instance->active_requests.fetch_add(1);
         instance->last_used = std::chrono::system_clock::now();
         
-        std::lock_guard<std::mutex> lock(m_requests_mutex);
-        m_active_requests[request_id] = instance_id;
-        
         Logger::getInstance().debug("LoadBalancer", 
-            "Started request " + request_id + " on instance " + instance_id);
+            "Started request " + request_id + " on instance " + instance->instance_id);
     }
 }
 
 void LoadBalancer::recordRequestEnd(const std::string& instance_id, const std::string& request_id,
                                   double response_time, bool success) {
+    recordRequestEnd(StringInterner::instances().find(instance_id), request_id, response_time, success);
+}
+
+void LoadBalancer::recordRequestEnd(InternedId instance_id, const std::string& request_id,
+                                  double response_time, bool success) {
     auto* instance = getInstance(instance_id);
     if (instance) {
         // Update active requests
@@ -498,20 +622,14 @@ void LoadBalancer::recordRequestEnd(const std::string& instance_id, const std::s
             instance->average_response_time.store(new_avg);
         }
         
-        // Remove from active requests
-        {
-            std::lock_guard<std::mutex> lock(m_requests_mutex);
-            m_active_requests.erase(request_id);
-        }
-        
         // Update strategy state
         auto strategy_it = m_strategies.find(m_current_strategy);
         if (strategy_it != m_strategies.end()) {
-            strategy_it->second->updateState(instance_id, response_time, success);
+            strategy_it->second->updateState(instance->instance_id, response_time, success);
         }
         
         Logger::getInstance().debug("LoadBalancer", 
-            "Completed request " + request_id + " on instance " + instance_id + 
+            "Completed request " + request_id + " on instance " + instance->instance_id + 
             " in " + std::to_string(response_time) + "ms");
     }
 }
@@ -522,7 +640,9 @@ size_t LoadBalancer::performHealthChecks() {
     size_t healthy_count = 0;
     auto now = std::chrono::system_clock::now();
     
-    for (auto& [instance_id, instance] : m_instances) {
+    for (auto& instance : m_instances) {
+        if (!instance) continue;
+        
         // Simple health check - verify model is still available
         bool is_healthy = (instance->model != nullptr);
         
@@ -550,7 +670,7 @@ size_t LoadBalancer::performHealthChecks() {
     
     Logger::getInstance().debug("LoadBalancer", 
         "Health check complete: " + std::to_string(healthy_count) + 
-        "/" + std::to_string(m_instances.size()) + " instances healthy");
+        "/" + std::to_string(m_instance_count) + " instances healthy");
     
     return healthy_count;
 }
@@ -563,12 +683,15 @@ std::string LoadBalancer::getStatistics() const {
     stats << "========================\n\n";
     
     stats << "Strategy: " << static_cast<int>(m_current_strategy) << "\n";
-    stats << "Total Instances: " << m_instances.size() << "\n";
+    stats << "Total Instances: " << m_instance_count << "\n";
     stats << "Healthy Instances: " << getHealthyInstances() << "\n\n";
     
     // Per-model statistics
-    for (const auto& [model_name, instance_ids] : m_model_instances) {
-        stats << "Model: " << model_name << "\n";
+    for (size_t model_id = 0; model_id < m_model_instances.size(); ++model_id) {
+        const auto& instance_ids = m_model_instances[model_id];
+        if (instance_ids.empty()) continue;
+        
+        stats << "Model: " << StringInterner::models().name(static_cast<InternedId>(model_id)) << "\n";
         stats << "  Instances: " << instance_ids.size() << "\n";
         
         size_t total_requests = 0;
@@ -576,10 +699,8 @@ std::string LoadBalancer::getStatistics() const {
         double avg_response_time = 0.0;
         size_t healthy_instances = 0;
         
-        for (const auto& instance_id : instance_ids) {
-            auto instance_it = m_instances.find(instance_id);
-            if (instance_it != m_instances.end()) {
-                const auto& instance = instance_it->second;
+        for (InternedId instance_id : instance_ids) {
+            if (const auto& instance = m_instances[instance_id]) {
                 total_requests += instance->total_requests.load();
                 active_requests += instance->active_requests.load();
                 avg_response_time += instance->average_response_time.load();
@@ -630,9 +751,11 @@ size_t LoadBalancer::autoScale(const std::string& model_name) {
         avg_response_time /= healthy_count;
     }
     
-    // Scale up conditions
-    if (instances.size() < m_config.max_instances_per_model) {
-        if (total_active > instances.size() * m_config.max_requests_per_instance * 0.8 ||
+    size_t request_limit = requestLimit(instances);
+    
+    // Scale up conditions (another instance must fit in memory)
+    if (instances.size() < m_config.max_instances_per_model && hasMemoryHeadroom()) {
+        if (total_active > instances.size() * request_limit * 0.8 ||
             avg_response_time > m_config.response_time_threshold * 0.8) {
             scale_up = true;
         }
@@ -640,7 +763,7 @@ size_t LoadBalancer::autoScale(const std::string& model_name) {
     
     // Scale down conditions  
     if (instances.size() > 1) {
-        if (total_active < instances.size() * m_config.max_requests_per_instance * 0.2 &&
+        if (total_active < instances.size() * request_limit * 0.2 &&
             avg_response_time < m_config.response_time_threshold * 0.5) {
             scale_down = true;
         }
@@ -678,13 +801,15 @@ size_t LoadBalancer::cleanupInactiveInstances() {
     
     std::vector<std::string> to_remove;
     
-    for (const auto& [instance_id, instance] : m_instances) {
+    for (const auto& instance : m_instances) {
+        if (!instance) continue;
+        
         auto inactive_time = std::chrono::duration_cast<std::chrono::seconds>(
             now - instance->last_used);
         
         if (inactive_time > m_config.instance_timeout && 
             instance->active_requests.load() == 0) {
-            to_remove.push_back(instance_id);
+            to_remove.push_back(instance->instance_id);
         }
     }
     
@@ -720,15 +845,15 @@ void LoadBalancer::setAutoScaling(bool enabled) {
 
 size_t LoadBalancer::getTotalInstances() const {
     std::lock_guard<std::mutex> lock(m_instances_mutex);
-    return m_instances.size();
+    return m_instance_count;
 }
 
 size_t LoadBalancer::getHealthyInstances() const {
     std::lock_guard<std::mutex> lock(m_instances_mutex);
     
     size_t healthy_count = 0;
-    for (const auto& [instance_id, instance] : m_instances) {
-        if (instance->is_healthy.load()) {
+    for (const auto& instance : m_instances) {
+        if (instance && instance->is_healthy.load()) {
             healthy_count++;
         }
     }
@@ -737,8 +862,13 @@ size_t LoadBalancer::getHealthyInstances() const {
 }
 
 std::string LoadBalancer::generateInstanceId(const std::string& model_name) {
-    size_t id = m_next_instance_id.fetch_add(1);
-    return model_name + "_instance_" + std::to_string(id);
+    for (size_t slot = 1;; ++slot) {
+        std::string instance_id = model_name + "_instance_" + std::to_string(slot);
+        InternedId id = StringInterner::instances().find(instance_id);
+        if (id >= m_instances.size() || !m_instances[id]) {
+            return instance_id;
+        }
+    }
 }
 
 bool LoadBalancer::needsScaling(const std::string& model_name) {
@@ -755,7 +885,7 @@ bool LoadBalancer::needsScaling(const std::string& model_name) {
     }
     
     double load_ratio = static_cast<double>(total_active) / 
-                       (instances.size() * m_config.max_requests_per_instance);
+                       (instances.size() * requestLimit(instances));
     
     return load_ratio > 0.8; // Scale if more than 80% loaded
 }
@@ -788,8 +918,10 @@ void LoadBalancer::healthCheckLoop() {
                 std::vector<std::string> model_names;
                 {
                     std::lock_guard<std::mutex> lock(m_instances_mutex);
-                    for (const auto& [model_name, _] : m_model_instances) {
-                        model_names.push_back(model_name);
+                    for (size_t model_id = 0; model_id < m_model_instances.size(); ++model_id) {
+                        if (!m_model_instances[model_id].empty()) {
+                            model_names.push_back(StringInterner::models().name(static_cast<InternedId>(model_id)));
+                        }
                     }
                 }
                 
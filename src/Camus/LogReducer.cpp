@@ -0,0 +1,876 @@
+// =================================================================
+// src/Camus/LogReducer.cpp
+// =================================================================
+// Implementation of the streaming build/test log reducer.
+
+#include "Camus/LogReducer.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <set>
+
+namespace Camus {
+
+namespace {
+
+const size_t NO_DIAGNOSTIC = static_cast<size_t>(-1);
+
+bool startsWith(const std::string& text, const char* prefix) {
+    return text.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+bool contains(const std::string& text, const char* needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+bool isNumber(const std::string& text) {
+    return !text.empty() && std::all_of(text.begin(), text.end(),
+        [](unsigned char c) { return std::isdigit(c); });
+}
+
+void stripAnsi(std::string& line) {
+    if (line.find('\x1b') == std::string::npos) {
+        return;
+    }
+    std::string clean;
+    clean.reserve(line.size());
+    for (size_t i = 0; i < line.size(); ++i) {
+        if (line[i] == '\x1b' && i + 1 < line.size() && line[i + 1] == '[') {
+            i += 2;
+            while (i < line.size() && (line[i] < 0x40 || line[i] > 0x7E)) {
+                ++i;
+            }
+            continue;
+        }
+        clean += line[i];
+    }
+    line.swap(clean);
+}
+
+/**
+ * @brief Parse "file:line:col", "file:line" or MSVC "file(line,col)"
+ * @return True if a line number was found
+ */
+bool parseLocation(const std::string& raw_prefix, std::string& file, size_t& line, size_t& column) {
+    std::string prefix = trim(raw_prefix);
+    file.clear();
+    line = 0;
+    column = 0;
+
+    if (!prefix.empty() && prefix.back() == ')') {
+        size_t open = prefix.rfind('(');
+        if (open == std::string::npos || open == 0) {
+            return false;
+        }
+        std::string inside = prefix.substr(open + 1, prefix.size() - open - 2);
+        std::string first = inside.substr(0, inside.find(','));
+        if (!isNumber(first)) {
+            return false;
+        }
+        line = std::stoul(first);
+        size_t comma = inside.find(',');
+        if (comma != std::string::npos && isNumber(inside.substr(comma + 1))) {
+            column = std::stoul(inside.substr(comma + 1));
+        }
+        file = prefix.substr(0, open);
+        return true;
+    }
+
+    std::vector<size_t> numbers;
+    size_t end = prefix.size();
+    while (numbers.size() < 2 && end > 0) {
+        size_t colon = prefix.rfind(':', end - 1);
+        if (colon == std::string::npos) {
+            break;
+        }
+        std::string segment = prefix.substr(colon + 1, end - colon - 1);
+        if (!isNumber(segment) || segment.size() > 9) {
+            break;
+        }
+        numbers.push_back(std::stoul(segment));
+        end = colon;
+    }
+
+    if (numbers.empty() || end == 0) {
+        return false;
+    }
+    file = prefix.substr(0, end);
+    if (numbers.size() == 2) {
+        line = numbers[1];
+        column = numbers[0];
+    } else {
+        line = numbers[0];
+    }
+    return true;
+}
+
+/**
+ * @brief Lines that introduce a diagnostic: include chains, instantiation
+ * context and function scope. In GCC output these precede the error.
+ */
+bool isPreambleNote(const std::string& line) {
+    std::string trimmed = trim(line);
+    return startsWith(trimmed, "In file included from") ||
+           (startsWith(trimmed, "from ") && (endsWith(trimmed, ",") || endsWith(trimmed, ":"))) ||
+           contains(line, "In instantiation of") ||
+           contains(line, "required from") ||
+           contains(line, "required by substitution of") ||
+           contains(line, ": In function") ||
+           contains(line, ": In member function") ||
+           contains(line, ": In constructor") ||
+           contains(line, ": In destructor") ||
+           contains(line, ": In static member function") ||
+           contains(line, ": In lambda function") ||
+           contains(line, ": At global scope:");
+}
+
+bool isTrailingNote(const std::string& line) {
+    return contains(line, ": note:") || startsWith(trim(line), "note:");
+}
+
+/**
+ * @brief Build-system chatter that carries no diagnostic information
+ */
+bool isBuildNoise(const std::string& line) {
+    std::string trimmed = trim(line);
+    if (trimmed.empty()) {
+        return true;
+    }
+    if (trimmed[0] == '[') {
+        size_t close = trimmed.find(']');
+        if (close != std::string::npos && close > 1) {
+            std::string inside = trimmed.substr(1, close - 1);
+            if (std::all_of(inside.begin(), inside.end(), [](unsigned char c) {
+                    return std::isdigit(c) || c == ' ' || c == '%' || c == '/';
+                })) {
+                return true;
+            }
+        }
+    }
+    return startsWith(trimmed, "make[") || startsWith(trimmed, "make:") ||
+           startsWith(trimmed, "gmake") || startsWith(trimmed, "ninja:") ||
+           startsWith(trimmed, "FAILED:") || startsWith(trimmed, "-- ") ||
+           startsWith(trimmed, "Scanning dependencies") ||
+           startsWith(trimmed, "Consolidate compiler") ||
+           startsWith(trimmed, "Building C") || startsWith(trimmed, "Linking C") ||
+           endsWith(trimmed, "error generated.") || endsWith(trimmed, "errors generated.") ||
+           endsWith(trimmed, "warning generated.") || endsWith(trimmed, "warnings generated.");
+}
+
+bool isPytestHeader(const std::string& line, std::string& name) {
+    if (line.size() < 8 || !startsWith(line, "___") || !endsWith(line, "___")) {
+        return false;
+    }
+    size_t first = line.find_first_not_of("_ ");
+    size_t last = line.find_last_not_of("_ ");
+    if (first == std::string::npos) {
+        return false;
+    }
+    name = line.substr(first, last - first + 1);
+    return name.find(' ') == std::string::npos;
+}
+
+} // anonymous namespace
+
+LogReducer::LogReducer(const LogReducerConfig& config)
+    : m_config(config), m_current_diagnostic(NO_DIAGNOSTIC) {
+}
+
+void LogReducer::feed(const char* data, size_t length, OutputStream stream) {
+    m_stats.input_bytes += length;
+    std::string& partial = m_partial[stream == OutputStream::STDERR ? 1 : 0];
+    const size_t line_limit = m_config.max_line_length + 16;
+
+    while (length > 0) {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', length));
+        size_t segment = newline ? static_cast<size_t>(newline - data) : length;
+
+        // Overlong lines are cut anyway, so don't buffer beyond the limit
+        if (partial.size() < line_limit) {
+            partial.append(data, std::min(segment, line_limit - partial.size()));
+        }
+
+        if (!newline) {
+            break;
+        }
+        processLine(std::move(partial));
+        partial.clear();
+        data += segment + 1;
+        length -= segment + 1;
+    }
+}
+
+void LogReducer::feed(const std::string& text) {
+    feed(text.data(), text.size());
+}
+
+std::string LogReducer::finish() {
+    for (auto& partial : m_partial) {
+        if (!partial.empty()) {
+            processLine(std::move(partial));
+            partial.clear();
+        }
+    }
+    // A test block still open at the end means the test never reported
+    // success - typically a crash.
+    closeBlock(true);
+
+    std::string result = render();
+    m_stats.output_bytes = result.size();
+    return result;
+}
+
+std::string LogReducer::reduce(const std::string& log, const LogReducerConfig& config) {
+    LogReducer reducer(config);
+    reducer.feed(log);
+    return reducer.finish();
+}
+
+void LogReducer::processLine(std::string line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    stripAnsi(line);
+    if (line.size() > m_config.max_line_length) {
+        line.resize(m_config.max_line_length);
+        line += " [...]";
+    }
+    m_stats.input_lines++;
+
+    if (m_config.tail_lines > 0) {
+        m_tail.push_back(line);
+        if (m_tail.size() > m_config.tail_lines) {
+            m_tail.pop_front();
+        }
+    }
+
+    if (handleTestLine(line)) {
+        return;
+    }
+    handleDiagnosticLine(line);
+}
+
+// =================================================================
+// Test failure extraction (gtest, ctest, pytest)
+// =================================================================
+
+bool LogReducer::handleTestLine(const std::string& line) {
+    // --- gtest ---
+    if (startsWith(line, "[ RUN      ]")) {
+        closeBlock(true);
+        startBlock(BlockKind::GTEST, trim(line.substr(12)));
+        return true;
+    }
+    if (m_block == BlockKind::GTEST) {
+        if (startsWith(line, "[       OK ]")) {
+            closeBlock(false);
+        } else if (startsWith(line, "[  FAILED  ]")) {
+            closeBlock(true);
+        } else {
+            appendBlockLine(line);
+        }
+        return true;
+    }
+    if (startsWith(line, "[  FAILED  ]")) {
+        // Summary list at the end of a gtest run
+        std::string name = trim(line.substr(12));
+        name = name.substr(0, name.find_first_of(" ,"));
+        if (!name.empty() && !std::isdigit(static_cast<unsigned char>(name[0]))) {
+            addFailure("gtest", name, line);
+        }
+        return true;
+    }
+
+    // --- pytest ---
+    std::string pytest_name;
+    if (isPytestHeader(line, pytest_name)) {
+        closeBlock(true);
+        startBlock(BlockKind::PYTEST, pytest_name);
+        return true;
+    }
+    if (m_block == BlockKind::PYTEST) {
+        if (startsWith(line, "====")) {
+            closeBlock(true);
+            return false;
+        }
+        appendBlockLine(line);
+        return true;
+    }
+    if (startsWith(line, "FAILED ") || startsWith(line, "ERROR ")) {
+        std::string rest = line.substr(line.find(' ') + 1);
+        std::string node_id = rest.substr(0, rest.find(" - "));
+        if (node_id.find("::") != std::string::npos) {
+            std::string short_name = node_id.substr(node_id.rfind("::") + 2);
+            if (!findFailure(short_name)) {
+                addFailure("pytest", node_id, line);
+            }
+            return true;
+        }
+    }
+
+    // --- ctest ---
+    size_t test_pos = line.find(" Test ");
+    if (test_pos != std::string::npos) {
+        size_t hash = line.find_first_not_of(' ', test_pos + 6);
+        if (hash != std::string::npos && line[hash] == '#') {
+            m_ctest_failure = 0;
+            if (contains(line, "***")) {
+                size_t colon = line.find(": ", hash);
+                std::string name;
+                if (colon != std::string::npos) {
+                    std::string rest = line.substr(colon + 2);
+                    name = rest.substr(0, rest.find(' '));
+                }
+                addFailure("ctest", name, trim(line));
+                if (TestFailureBlock* failure = findFailure(name)) {
+                    m_ctest_failure = static_cast<size_t>(failure - m_failures.data()) + 1;
+                }
+            }
+            return true;
+        }
+    }
+    if (contains(line, "The following tests FAILED:")) {
+        m_in_ctest_summary = true;
+        m_ctest_failure = 0;
+        return true;
+    }
+    if (m_in_ctest_summary) {
+        std::string trimmed = trim(line);
+        size_t dash = trimmed.find(" - ");
+        if (dash != std::string::npos && isNumber(trimmed.substr(0, dash))) {
+            std::string name = trimmed.substr(dash + 3);
+            name = name.substr(0, name.find(" ("));
+            addFailure("ctest", name, trimmed);
+            return true;
+        }
+        m_in_ctest_summary = false;
+    }
+    if (contains(line, "tests passed,") || startsWith(trim(line), "Start ")) {
+        m_ctest_failure = 0;
+        return true;
+    }
+    if (m_ctest_failure > 0) {
+        TestFailureBlock& failure = m_failures[m_ctest_failure - 1];
+        if (failure.lines.size() < m_config.max_failure_lines) {
+            failure.lines.push_back(line);
+        } else {
+            failure.omitted_lines++;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void LogReducer::startBlock(BlockKind kind, const std::string& name) {
+    m_block = kind;
+    m_block_name = name;
+    m_block_lines.clear();
+    m_block_tail.clear();
+    m_block_omitted = 0;
+}
+
+void LogReducer::appendBlockLine(const std::string& line) {
+    // Keep the start of the block and its most recent lines; the
+    // assertion and traceback summary are usually at the end.
+    size_t head_limit = std::max<size_t>(1, m_config.max_failure_lines / 2);
+    size_t tail_limit = m_config.max_failure_lines > head_limit ? m_config.max_failure_lines - head_limit : 0;
+
+    if (m_block_lines.size() < head_limit) {
+        m_block_lines.push_back(line);
+        return;
+    }
+    m_block_tail.push_back(line);
+    if (m_block_tail.size() > tail_limit) {
+        m_block_tail.pop_front();
+        m_block_omitted++;
+    }
+}
+
+void LogReducer::closeBlock(bool failed) {
+    if (m_block == BlockKind::NONE) {
+        return;
+    }
+    if (failed) {
+        TestFailureBlock block;
+        block.framework = m_block == BlockKind::GTEST ? "gtest"
+                        : m_block == BlockKind::PYTEST ? "pytest" : "ctest";
+        block.test_name = m_block_name;
+        block.lines = std::move(m_block_lines);
+        if (m_block_omitted > 0) {
+            block.lines.push_back("[... " + std::to_string(m_block_omitted) + " lines omitted ...]");
+        }
+        block.lines.insert(block.lines.end(), m_block_tail.begin(), m_block_tail.end());
+        block.omitted_lines = m_block_omitted;
+
+        TestFailureBlock* existing = findFailure(block.test_name);
+        if (existing) {
+            if (existing->lines.size() < block.lines.size()) {
+                *existing = std::move(block);
+            }
+        } else if (m_failures.size() < m_config.max_failures) {
+            m_failures.push_back(std::move(block));
+            m_stats.test_failures++;
+        } else {
+            m_stats.test_failures++;
+        }
+    }
+    m_block = BlockKind::NONE;
+    m_block_name.clear();
+    m_block_lines.clear();
+    m_block_tail.clear();
+    m_block_omitted = 0;
+}
+
+TestFailureBlock* LogReducer::findFailure(const std::string& name) {
+    if (name.empty()) {
+        return nullptr;
+    }
+    for (auto& failure : m_failures) {
+        if (failure.test_name == name ||
+            endsWith(failure.test_name, ("::" + name).c_str())) {
+            return &failure;
+        }
+    }
+    return nullptr;
+}
+
+void LogReducer::addFailure(const std::string& framework, const std::string& name, const std::string& line) {
+    if (findFailure(name)) {
+        return;
+    }
+    m_stats.test_failures++;
+    if (m_failures.size() >= m_config.max_failures) {
+        return;
+    }
+    TestFailureBlock block;
+    block.framework = framework;
+    block.test_name = name;
+    block.lines.push_back(line);
+    m_failures.push_back(std::move(block));
+}
+
+// =================================================================
+// Compiler diagnostic extraction
+// =================================================================
+
+bool LogReducer::handleDiagnosticLine(const std::string& line) {
+    if (isTrailingNote(line) || isPreambleNote(line)) {
+        addNote(line);
+        return true;
+    }
+
+    LogDiagnostic diagnostic;
+    if (parseDiagnostic(line, diagnostic)) {
+        addDiagnostic(std::move(diagnostic));
+        return true;
+    }
+
+    if (isBuildNoise(line)) {
+        m_current_diagnostic = NO_DIAGNOSTIC;
+        return true;
+    }
+
+    // Source excerpt and caret lines following a diagnostic
+    if (m_current_diagnostic != NO_DIAGNOSTIC) {
+        if (!m_skip_current) {
+            auto& context = m_diagnostics[m_current_diagnostic].context;
+            if (context.size() < m_config.max_context_lines) {
+                context.push_back(line);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool LogReducer::parseDiagnostic(const std::string& line, LogDiagnostic& diagnostic) const {
+    // CMake configure errors: "CMake Error at CMakeLists.txt:12 (add_library):"
+    if (startsWith(line, "CMake Error") || startsWith(line, "CMake Warning")) {
+        diagnostic.severity = startsWith(line, "CMake Error") ? DiagnosticSeverity::ERROR
+                                                              : DiagnosticSeverity::WARNING;
+        diagnostic.header = line;
+        size_t at = line.find(" at ");
+        if (at != std::string::npos) {
+            std::string location = line.substr(at + 4);
+            location = location.substr(0, location.find(' '));
+            if (!location.empty() && location.back() == ':') {
+                location.pop_back();
+            }
+            parseLocation(location, diagnostic.file, diagnostic.line, diagnostic.column);
+        }
+        return true;
+    }
+
+    // GCC/Clang "file:line:col: error: ..." and MSVC "file(line,col): error C2065: ..."
+    static const struct {
+        const char* marker;
+        DiagnosticSeverity severity;
+    } markers[] = {
+        {": fatal error", DiagnosticSeverity::FATAL},
+        {": error", DiagnosticSeverity::ERROR},
+        {": warning", DiagnosticSeverity::WARNING},
+    };
+
+    size_t best_pos = std::string::npos;
+    DiagnosticSeverity best_severity = DiagnosticSeverity::ERROR;
+    for (const auto& marker : markers) {
+        size_t pos = line.find(marker.marker);
+        while (pos != std::string::npos) {
+            size_t after = pos + std::strlen(marker.marker);
+            bool gcc_style = after < line.size() && line[after] == ':';
+            bool msvc_style = false;
+            if (after + 1 < line.size() && line[after] == ' ' &&
+                std::isupper(static_cast<unsigned char>(line[after + 1]))) {
+                size_t code_end = line.find(':', after + 1);
+                msvc_style = code_end != std::string::npos && code_end - after < 12 &&
+                             std::isdigit(static_cast<unsigned char>(line[code_end - 1]));
+            }
+            if (gcc_style || msvc_style) {
+                break;
+            }
+            pos = line.find(marker.marker, pos + 1);
+        }
+        if (pos != std::string::npos && pos < best_pos) {
+            best_pos = pos;
+            best_severity = marker.severity;
+        }
+    }
+
+    if (best_pos != std::string::npos) {
+        diagnostic.severity = best_severity;
+        diagnostic.header = line;
+        if (!parseLocation(line.substr(0, best_pos), diagnostic.file, diagnostic.line, diagnostic.column)) {
+            diagnostic.file.clear();  // Tool name such as "collect2" or "LINK"
+        }
+        return true;
+    }
+
+    // Unlocated failures from linkers, assertions and crashes
+    std::string trimmed = trim(line);
+    if (startsWith(trimmed, "error:") || startsWith(trimmed, "fatal error:") ||
+        contains(line, "undefined reference to") ||
+        contains(line, "multiple definition of") ||
+        (contains(line, "Undefined symbols for architecture")) ||
+        (contains(line, "Assertion") && contains(line, "failed")) ||
+        contains(line, "Segmentation fault") ||
+        startsWith(trimmed, "terminate called")) {
+        diagnostic.severity = DiagnosticSeverity::ERROR;
+        diagnostic.header = line;
+        return true;
+    }
+
+    return false;
+}
+
+void LogReducer::addNote(const std::string& line) {
+    auto push_note = [this](std::vector<std::string>& notes, size_t& suppressed, const std::string& note) {
+        // Keep the first notes and always the most recent one, which in
+        // an instantiation chain is the location in user code.
+        size_t limit = std::max<size_t>(1, m_config.max_notes_per_diagnostic);
+        if (notes.size() < limit) {
+            notes.push_back(note);
+        } else {
+            notes.back() = note;
+            suppressed++;
+            m_stats.notes_suppressed++;
+        }
+    };
+
+    if (isTrailingNote(line) && m_current_diagnostic != NO_DIAGNOSTIC) {
+        if (m_skip_current) {
+            m_stats.notes_suppressed++;
+            return;
+        }
+        auto& diagnostic = m_diagnostics[m_current_diagnostic];
+        if (diagnostic.context.size() < m_config.max_context_lines) {
+            diagnostic.context.push_back(line);
+        } else {
+            m_stats.notes_suppressed++;
+        }
+        return;
+    }
+
+    // Preamble for the next diagnostic
+    m_current_diagnostic = NO_DIAGNOSTIC;
+    push_note(m_pending_notes, m_pending_suppressed, line);
+}
+
+void LogReducer::addDiagnostic(LogDiagnostic diagnostic) {
+    diagnostic.notes = std::move(m_pending_notes);
+    diagnostic.suppressed_notes = m_pending_suppressed;
+    m_pending_notes.clear();
+    m_pending_suppressed = 0;
+
+    auto existing = m_diagnostic_index.find(diagnostic.header);
+    if (existing != m_diagnostic_index.end()) {
+        // Same header error reported from another translation unit
+        m_diagnostics[existing->second].occurrences++;
+        m_stats.duplicates_collapsed++;
+        m_stats.notes_suppressed += diagnostic.notes.size();
+        m_current_diagnostic = existing->second;
+        m_skip_current = true;
+        return;
+    }
+
+    bool is_warning = diagnostic.severity == DiagnosticSeverity::WARNING;
+    // Warnings may only take half the slots so they can't crowd out errors
+    bool full = m_diagnostics.size() >= m_config.max_diagnostics ||
+                (is_warning && m_stats.warnings >= m_config.max_diagnostics / 2);
+    if (full) {
+        m_stats.diagnostics_dropped++;
+        m_current_diagnostic = NO_DIAGNOSTIC;
+        return;
+    }
+
+    if (is_warning) {
+        m_stats.warnings++;
+    } else {
+        m_stats.errors++;
+    }
+    m_diagnostic_index[diagnostic.header] = m_diagnostics.size();
+    m_current_diagnostic = m_diagnostics.size();
+    m_skip_current = false;
+    m_diagnostics.push_back(std::move(diagnostic));
+}
+
+// =================================================================
+// Rendering
+// =================================================================
+
+std::string LogReducer::renderDiagnostic(const LogDiagnostic& diagnostic, bool compact) const {
+    std::ostringstream out;
+    if (!compact) {
+        for (const auto& note : diagnostic.notes) {
+            if (&note == &diagnostic.notes.back() && diagnostic.suppressed_notes > 0) {
+                out << "  [... " << diagnostic.suppressed_notes << " similar notes omitted ...]\n";
+            }
+            out << note << "\n";
+        }
+    }
+    out << diagnostic.header;
+    if (diagnostic.occurrences > 1) {
+        out << "  [reported " << diagnostic.occurrences << " times]";
+    }
+    out << "\n";
+    if (!compact) {
+        for (const auto& line : diagnostic.context) {
+            out << line << "\n";
+        }
+    }
+    return out.str();
+}
+
+std::string LogReducer::renderFailure(const TestFailureBlock& failure) const {
+    std::ostringstream out;
+    out << "[" << failure.framework << "] " << (failure.test_name.empty() ? "(unnamed)" : failure.test_name) << "\n";
+    for (const auto& line : failure.lines) {
+        out << "  " << line << "\n";
+    }
+    return out.str();
+}
+
+std::string LogReducer::renderSnippet(const std::string& file, size_t line) const {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path path(file);
+    if (path.is_relative()) {
+        path = fs::path(m_config.project_root) / path;
+    }
+    if (!fs::is_regular_file(path, ec) || fs::file_size(path, ec) > 4 * 1024 * 1024) {
+        return "";
+    }
+
+    std::ifstream input(path);
+    if (!input) {
+        return "";
+    }
+
+    size_t first = line > m_config.snippet_radius ? line - m_config.snippet_radius : 1;
+    size_t last = line + m_config.snippet_radius;
+    std::ostringstream out;
+    out << "--- " << file << ":" << line << " ---\n";
+
+    std::string text;
+    size_t current = 0;
+    bool found = false;
+    while (current < last && std::getline(input, text)) {
+        ++current;
+        if (current < first) {
+            continue;
+        }
+        if (text.size() > m_config.max_line_length) {
+            text.resize(m_config.max_line_length);
+        }
+        out << (current == line ? ">" : " ") << std::string(6 - std::min<size_t>(6, std::to_string(current).size()), ' ')
+            << current << " | " << text << "\n";
+        found = found || current == line;
+    }
+    return found ? out.str() : "";
+}
+
+std::string LogReducer::render() {
+    const size_t budget = m_config.max_output_bytes;
+    std::string result;
+    auto fits = [&](size_t length) { return result.size() + length <= budget; };
+    auto append = [&](const std::string& text) {
+        if (!fits(text.size())) {
+            return false;
+        }
+        result += text;
+        return true;
+    };
+
+    {
+        std::ostringstream summary;
+        summary << "[Log reduced from " << m_stats.input_lines << " lines: "
+                << m_stats.errors << " errors, " << m_stats.warnings << " warnings, "
+                << m_stats.test_failures << " failing tests";
+        if (m_stats.duplicates_collapsed > 0) {
+            summary << "; " << m_stats.duplicates_collapsed << " repeated diagnostics collapsed";
+        }
+        if (m_stats.notes_suppressed > 0) {
+            summary << "; " << m_stats.notes_suppressed << " template/include notes trimmed";
+        }
+        summary << "]\n";
+        append(summary.str());
+    }
+
+    auto render_diagnostics = [&](bool warnings) {
+        bool header_written = false;
+        size_t omitted = 0;
+        for (const auto& diagnostic : m_diagnostics) {
+            if ((diagnostic.severity == DiagnosticSeverity::WARNING) != warnings) {
+                continue;
+            }
+            if (!header_written) {
+                if (!append(warnings ? "\n== Warnings ==\n" : "\n== Errors ==\n")) {
+                    return;
+                }
+                header_written = true;
+            }
+            // Fall back to the bare header line once full blocks no longer fit
+            if (!append(renderDiagnostic(diagnostic, false)) &&
+                !append(renderDiagnostic(diagnostic, true))) {
+                omitted++;
+            }
+        }
+        if (omitted > 0) {
+            append("[... " + std::to_string(omitted) + " more diagnostics omitted ...]\n");
+        }
+    };
+
+    render_diagnostics(false);
+
+    if (!m_failures.empty() && append("\n== Test failures ==\n")) {
+        for (const auto& failure : m_failures) {
+            if (!append(renderFailure(failure))) {
+                append("[" + failure.framework + "] " + failure.test_name + "\n");
+            }
+        }
+    }
+
+    if (m_config.include_source_snippets && m_config.max_snippets > 0) {
+        std::vector<std::pair<std::string, size_t>> locations;
+        std::set<std::pair<std::string, size_t>> seen;
+        auto add_location = [&](const std::string& file, size_t line) {
+            if (!file.empty() && line > 0 && seen.insert({file, line}).second) {
+                locations.emplace_back(file, line);
+            }
+        };
+        for (const auto& diagnostic : m_diagnostics) {
+            if (diagnostic.severity != DiagnosticSeverity::WARNING) {
+                add_location(diagnostic.file, diagnostic.line);
+            }
+        }
+        for (const auto& failure : m_failures) {
+            for (const auto& line : failure.lines) {
+                size_t separator = line.find(": ");
+                std::string file;
+                size_t line_number = 0;
+                size_t column = 0;
+                if (separator != std::string::npos &&
+                    parseLocation(line.substr(0, separator), file, line_number, column) &&
+                    file.find('.') != std::string::npos) {
+                    add_location(file, line_number);
+                }
+            }
+        }
+
+        bool header_written = false;
+        for (const auto& location : locations) {
+            if (m_stats.snippets >= m_config.max_snippets) {
+                break;
+            }
+            std::string snippet = renderSnippet(location.first, location.second);
+            if (snippet.empty()) {
+                continue;
+            }
+            if (!header_written) {
+                if (!append("\n== Referenced source ==\n")) {
+                    break;
+                }
+                header_written = true;
+            }
+            if (append(snippet)) {
+                m_stats.snippets++;
+            }
+        }
+    }
+
+    if (m_config.include_warnings) {
+        render_diagnostics(true);
+    }
+
+    // Without recognised errors the end of the log is the best evidence;
+    // otherwise a few trailing lines show how the run ended.
+    bool found_anything = m_stats.errors > 0 || !m_failures.empty();
+    size_t tail_count = found_anything ? std::min<size_t>(10, m_tail.size()) : m_tail.size();
+    if (tail_count > 0) {
+        const std::string header = "\n== Last lines of output ==\n";
+        size_t available = budget > result.size() + header.size() ? budget - result.size() - header.size() : 0;
+        std::vector<std::string> lines;
+        size_t used = 0;
+        for (auto it = m_tail.rbegin(); it != m_tail.rend() && lines.size() < tail_count; ++it) {
+            if (found_anything && result.find(*it) != std::string::npos) {
+                continue;  // Already shown above
+            }
+            if (used + it->size() + 1 > available) {
+                break;
+            }
+            used += it->size() + 1;
+            lines.push_back(*it);
+        }
+        if (!lines.empty()) {
+            result += header;
+            for (auto it = lines.rbegin(); it != lines.rend(); ++it) {
+                result += *it;
+                result += "\n";
+            }
+        }
+    }
+
+    if (result.size() > budget) {
+        result.resize(budget);
+    }
+    return result;
+}
+
+} // namespace Camus
@@ -0,0 +1,246 @@
+// =================================================================
+// src/Camus/MemoryGovernor.cpp
+// =================================================================
+// Implementation of the resident-model memory budget.
+
+#include "Camus/MemoryGovernor.hpp"
+#include "Camus/ResourceMonitor.hpp"
+#include "Camus/Logger.hpp"
+#include <fstream>
+#include <limits>
+#include <unistd.h>
+
+namespace Camus {
+
+MemoryGovernor::Lease::~Lease() {
+    if (m_governor) {
+        m_governor->endUse(m_model);
+    }
+}
+
+MemoryGovernor::MemoryGovernor(const MemoryGovernorConfig& config)
+    : m_config(config),
+      m_monitor(config.resource_monitor) {
+}
+
+MemoryGovernor& MemoryGovernor::getInstance() {
+    static MemoryGovernor instance;
+    return instance;
+}
+
+bool MemoryGovernor::admit(const std::string& model, uint64_t estimated_bytes) {
+    return admit(model, estimated_bytes, m_config.admission_timeout);
+}
+
+bool MemoryGovernor::admit(const std::string& model, uint64_t estimated_bytes,
+                           std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // A reload racing the eviction of the same model must not mistake the
+    // entry about to be erased for a resident one
+    m_released.wait(lock, [&] {
+        auto it = m_models.find(model);
+        return it == m_models.end() || !it->second.evicting;
+    });
+    if (m_models.count(model)) {
+        return true; // Already resident or being loaded
+    }
+
+    uint64_t budget = budgetLocked();
+    if (estimated_bytes > budget) {
+        m_rejections++;
+        Logger::getInstance().warning("MemoryGovernor",
+            "Refusing to load " + model + ": needs " + std::to_string(estimated_bytes >> 20) +
+            "MB, budget is " + std::to_string(budget >> 20) + "MB");
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    m_queued++;
+    while (true) {
+        if (committedBytes() + estimated_bytes <= budget) {
+            ResidentModel& entry = m_models[model];
+            entry.bytes = estimated_bytes;
+            entry.last_used = std::chrono::steady_clock::now();
+            m_queued--;
+            return true;
+        }
+
+        std::string victim = pickVictim(std::chrono::steady_clock::now());
+        if (!victim.empty()) {
+            ResidentModel& entry = m_models[victim];
+            entry.evicting = true;
+            EvictCallback evict = std::move(entry.evict);
+            uint64_t freed = entry.bytes;
+
+            lock.unlock();
+            Logger::getInstance().info("MemoryGovernor",
+                "Evicting idle model " + victim + " (" + std::to_string(freed >> 20) +
+                "MB) to load " + model);
+            if (evict) {
+                evict();
+            }
+            lock.lock();
+
+            m_models.erase(victim);
+            m_evictions++;
+            m_released.notify_all();
+            continue;
+        }
+
+        // Nothing idle to evict: wait for a release, a finished request or
+        // a model crossing min_idle_time
+        auto wake = std::min(deadline, std::chrono::steady_clock::now() + std::chrono::seconds(1));
+        m_released.wait_until(lock, wake);
+        if (std::chrono::steady_clock::now() >= deadline &&
+            committedBytes() + estimated_bytes > budget && pickVictim(std::chrono::steady_clock::now()).empty()) {
+            m_queued--;
+            m_rejections++;
+            Logger::getInstance().warning("MemoryGovernor",
+                "Timed out waiting for memory to load " + model);
+            return false;
+        }
+    }
+}
+
+void MemoryGovernor::commit(const std::string& model, uint64_t actual_bytes,
+                            std::chrono::milliseconds load_time, EvictCallback evict) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ResidentModel& entry = m_models[model];
+        entry.bytes = actual_bytes;
+        entry.reserved = false;
+        entry.reload_cost = load_time;
+        entry.last_used = std::chrono::steady_clock::now();
+        entry.evict = std::move(evict);
+    }
+    // The measured footprint may be smaller than the estimate
+    m_released.notify_all();
+}
+
+void MemoryGovernor::abort(const std::string& model) {
+    release(model);
+}
+
+void MemoryGovernor::release(const std::string& model) {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // An owner about to be destroyed must not race its eviction callback
+        m_released.wait(lock, [&] {
+            auto it = m_models.find(model);
+            return it == m_models.end() || !it->second.evicting;
+        });
+        auto it = m_models.find(model);
+        if (it == m_models.end()) {
+            return;
+        }
+        m_models.erase(it);
+    }
+    m_released.notify_all();
+}
+
+MemoryGovernor::Lease MemoryGovernor::use(const std::string& model) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_models.find(model);
+    if (it != m_models.end()) {
+        it->second.in_use++;
+        it->second.last_used = std::chrono::steady_clock::now();
+    }
+    return Lease(this, model);
+}
+
+void MemoryGovernor::endUse(const std::string& model) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_models.find(model);
+        if (it == m_models.end() || it->second.in_use == 0) {
+            return;
+        }
+        it->second.in_use--;
+        it->second.last_used = std::chrono::steady_clock::now();
+    }
+    m_released.notify_all();
+}
+
+uint64_t MemoryGovernor::getFootprint(const std::string& model) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_models.find(model);
+    return it != m_models.end() && !it->second.reserved ? it->second.bytes : 0;
+}
+
+uint64_t MemoryGovernor::getBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return budgetLocked();
+}
+
+MemoryGovernorStats MemoryGovernor::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MemoryGovernorStats stats;
+    stats.budget_bytes = budgetLocked();
+    for (const auto& [name, entry] : m_models) {
+        if (entry.reserved) {
+            stats.reserved_bytes += entry.bytes;
+        } else {
+            stats.resident_bytes += entry.bytes;
+            stats.resident_models++;
+        }
+    }
+    stats.queued_loads = m_queued;
+    stats.evictions = m_evictions;
+    stats.rejected_loads = m_rejections;
+    return stats;
+}
+
+uint64_t MemoryGovernor::processRssBytes() {
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size_pages = 0;
+    uint64_t resident_pages = 0;
+    if (!(statm >> size_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+}
+
+uint64_t MemoryGovernor::committedBytes() const {
+    uint64_t total = 0;
+    for (const auto& [name, entry] : m_models) {
+        total += entry.bytes;
+    }
+    return total;
+}
+
+uint64_t MemoryGovernor::budgetLocked() const {
+    if (m_config.budget_bytes > 0) {
+        return m_config.budget_bytes;
+    }
+    ResourceMonitor& monitor = m_monitor ? *m_monitor : ResourceMonitor::getInstance();
+    uint64_t limit = monitor.getSnapshot().memory_limit_bytes;
+    if (limit == 0) {
+        return std::numeric_limits<uint64_t>::max(); // Nothing measured; do not block loads
+    }
+    return static_cast<uint64_t>(static_cast<double>(limit) * m_config.budget_fraction);
+}
+
+std::string MemoryGovernor::pickVictim(std::chrono::steady_clock::time_point now) const {
+    std::string victim;
+    double best_score = 0.0;
+    for (const auto& [name, entry] : m_models) {
+        if (entry.reserved || entry.evicting || entry.in_use > 0) {
+            continue;
+        }
+        auto idle = now - entry.last_used;
+        if (idle < m_config.min_idle_time) {
+            continue;
+        }
+        double idle_seconds = std::chrono::duration<double>(idle).count();
+        double gigabytes = static_cast<double>(entry.bytes) / (1024.0 * 1024.0 * 1024.0);
+        double reload_seconds = std::chrono::duration<double>(entry.reload_cost).count();
+        double score = (idle_seconds + 1.0) * gigabytes / (1.0 + reload_seconds);
+        if (victim.empty() || score > best_score) {
+            victim = name;
+            best_score = score;
+        }
+    }
+    return victim;
+}
+
+} // namespace Camus
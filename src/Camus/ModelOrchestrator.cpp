@@ -5,6 +5,8 @@
 
 #include "Camus/ModelOrchestrator.hpp"
 #include "Camus/Logger.hpp"
+#include "Camus/RequestCoalescer.hpp"
+#include "Camus/AdaptiveConcurrencyLimiter.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -60,9 +62,12 @@ ModelOrchestrator::~ModelOrchestrator() {
 PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& request) {
     auto start_time = std::chrono::steady_clock::now();
     
-    PipelineResponse response;
+    // Short-lived pipeline state lives in one arena released with the response
+    PipelineResponse response = m_config.request_arena_size > 0
+        ? PipelineResponse(std::make_shared<RequestArena>(m_config.request_arena_size))
+        : PipelineResponse();
     response.request_id = request.request_id;
-    response.pipeline_steps.push_back("pipeline_start");
+    response.pipeline_steps.emplace_back("pipeline_start");
     
     Logger::getInstance().debug("ModelOrchestrator", 
         "Processing request: " + request.request_id);
@@ -70,11 +75,11 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
     try {
         // Step 1: Check cache first
         if (m_config.enable_caching && request.enable_caching) {
-            response.pipeline_steps.push_back("cache_check");
+            response.pipeline_steps.emplace_back("cache_check");
             if (checkCache(request, response)) {
                 response.success = true;
                 response.cache_hit = true;
-                response.pipeline_steps.push_back("cache_hit");
+                response.pipeline_steps.emplace_back("cache_hit");
                 
                 auto end_time = std::chrono::steady_clock::now();
                 response.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -86,13 +91,13 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
                     "Cache hit for request: " + request.request_id);
                 return response;
             }
-            response.pipeline_steps.push_back("cache_miss");
+            response.pipeline_steps.emplace_back("cache_miss");
         }
         
         // Step 2: Task classification
-        ClassificationResult classification_result;
+        ClassificationResult classification_result(response.arena.resource());
         if (m_config.enable_classification && m_classifier) {
-            response.pipeline_steps.push_back("task_classification");
+            response.pipeline_steps.emplace_back("task_classification");
             classification_result = classifyTask(request, response);
             
             if (classification_result.confidence < m_config.min_classification_confidence) {
@@ -108,9 +113,9 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
         }
         
         // Step 3: Model selection
-        SelectionResult selection_result;
+        SelectionResult selection_result(response.arena.resource());
         if (m_config.enable_model_selection && m_selector) {
-            response.pipeline_steps.push_back("model_selection");
+            response.pipeline_steps.emplace_back("model_selection");
             selection_result = selectModel(request, classification_result, response);
             
             if (selection_result.selected_model.empty()) {
@@ -128,15 +133,19 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
                 throw std::runtime_error("No models available in registry");
             }
             selection_result.selected_model = models[0].name;
+            selection_result.selected_model_id = models[0].id;
             selection_result.confidence_score = 0.5;
             selection_result.selection_reason = "Default model selection";
+            response.selected_model = selection_result.selected_model;
+            response.selected_model_id = selection_result.selected_model_id;
         }
         
         // Step 4: Load balancing
         LoadBalancingResult lb_result;
         if (m_config.enable_load_balancing && m_load_balancer) {
-            response.pipeline_steps.push_back("load_balancing");
-            lb_result = selectInstance(request, selection_result.selected_model, response);
+            response.pipeline_steps.emplace_back("load_balancing");
+            lb_result = selectInstance(request, selection_result.selected_model,
+                                       selection_result.selected_model_id, response);
             
             if (lb_result.selected_instance_id.empty() || !lb_result.model) {
                 throw std::runtime_error("No healthy instances available for model: " + 
@@ -154,12 +163,12 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
         }
         
         // Step 5: Request execution
-        response.pipeline_steps.push_back("request_execution");
+        response.pipeline_steps.emplace_back("request_execution");
         bool execution_success = executeRequest(request, lb_result, response);
         
         if (!execution_success) {
             if (m_config.enable_fallback && request.require_fallback) {
-                response.pipeline_steps.push_back("fallback_handling");
+                response.pipeline_steps.emplace_back("fallback_handling");
                 execution_success = handleFallback(request, response);
                 if (execution_success) {
                     response.fallback_used = true;
@@ -173,7 +182,7 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
         
         // Step 6: Response validation and quality scoring
         if (m_config.enable_quality_checks) {
-            response.pipeline_steps.push_back("quality_validation");
+            response.pipeline_steps.emplace_back("quality_validation");
             response.quality_score = validateResponse(request, response);
             
             if (response.quality_score < m_config.min_quality_score) {
@@ -182,7 +191,7 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
                 
                 if (m_config.fallback_on_low_quality && request.require_fallback && 
                     !response.fallback_used) {
-                    response.pipeline_steps.push_back("quality_fallback");
+                    response.pipeline_steps.emplace_back("quality_fallback");
                     if (handleFallback(request, response)) {
                         response.fallback_used = true;
                         response.quality_score = validateResponse(request, response);
@@ -192,7 +201,7 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
         }
         
         response.success = true;
-        response.pipeline_steps.push_back("pipeline_complete");
+        response.pipeline_steps.emplace_back("pipeline_complete");
         
         // Step 7: Cache the response
         if (m_config.enable_caching && request.enable_caching && !response.cache_hit) {
@@ -202,7 +211,7 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
     } catch (const std::exception& e) {
         response.success = false;
         response.error_message = e.what();
-        response.pipeline_steps.push_back("pipeline_error");
+        response.pipeline_steps.emplace_back("pipeline_error");
         
         Logger::getInstance().error("ModelOrchestrator", 
             "Request processing failed: " + response.error_message + 
@@ -212,7 +221,7 @@ PipelineResponse ModelOrchestrator::processRequest(const PipelineRequest& reques
         if (m_config.enable_fallback && m_config.fallback_on_error && 
             request.require_fallback && !response.fallback_used) {
             try {
-                response.pipeline_steps.push_back("error_fallback");
+                response.pipeline_steps.emplace_back("error_fallback");
                 if (handleFallback(request, response)) {
                     response.success = true;
                     response.fallback_used = true;
@@ -273,7 +282,7 @@ ClassificationResult ModelOrchestrator::classifyTask(const PipelineRequest& requ
         text_to_classify += " " + request.context;
     }
     
-    auto result = m_classifier->classify(text_to_classify);
+    auto result = m_classifier->classify(text_to_classify, "", response.arena.resource());
     
     auto end_time = std::chrono::steady_clock::now();
     response.classification_time = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -298,6 +307,7 @@ SelectionResult ModelOrchestrator::selectModel(const PipelineRequest& request,
     criteria.task_type = task_result.primary_type;
     criteria.context_size = request.prompt.length() + request.context.length();
     criteria.expected_output_size = request.max_tokens;
+    criteria.memory_resource = response.arena.resource();
     
     // Apply user preferences
     if (!request.preferred_models.empty()) {
@@ -313,6 +323,7 @@ SelectionResult ModelOrchestrator::selectModel(const PipelineRequest& request,
         end_time - start_time);
     
     response.selected_model = result.selected_model;
+    response.selected_model_id = result.selected_model_id;
     response.selection_confidence = result.confidence_score;
     
     Logger::getInstance().debug("ModelOrchestrator", 
@@ -324,6 +335,7 @@ SelectionResult ModelOrchestrator::selectModel(const PipelineRequest& request,
 
 LoadBalancingResult ModelOrchestrator::selectInstance(const PipelineRequest& request,
                                                      const std::string& model_name,
+                                                     InternedId model_id,
                                                      PipelineResponse& response) {
     RequestContext lb_context;
     lb_context.request_id = request.request_id;
@@ -332,7 +344,9 @@ LoadBalancingResult ModelOrchestrator::selectInstance(const PipelineRequest& req
     lb_context.max_response_time = request.timeout;
     lb_context.priority = request.priority;
     
-    auto result = m_load_balancer->selectInstance(model_name, lb_context);
+    auto result = model_id != INVALID_INTERNED_ID
+        ? m_load_balancer->selectInstance(model_id, lb_context)
+        : m_load_balancer->selectInstance(model_name, lb_context);
     
     response.selected_instance = result.selected_instance_id;
     
@@ -349,23 +363,50 @@ bool ModelOrchestrator::executeRequest(const PipelineRequest& request,
     
     try {
         // Record request start for load balancing
-        if (m_load_balancer && !lb_result.selected_instance_id.empty()) {
-            m_load_balancer->recordRequestStart(lb_result.selected_instance_id, request.request_id);
+        if (m_load_balancer && lb_result.selected_instance != INVALID_INTERNED_ID) {
+            m_load_balancer->recordRequestStart(lb_result.selected_instance, request.request_id);
         }
         
-        // Execute the request
-        std::string model_response = lb_result.model->getCompletion(request.prompt);
+        // Execute the request. Only the generating call queues behind the
+        // backend's concurrency limit; coalesced requests wait on it instead.
+        // The metadata call also returns token counts and log-probabilities
+        bool coalesce = m_config.enable_request_coalescing && request.temperature <= 0.0;
+        auto& limiter = AdaptiveConcurrencyLimiter::forBackend(lb_result.model->getBackendEndpoint());
+        InferenceRequest inference;
+        inference.prompt = request.prompt;
+        inference.max_tokens = static_cast<size_t>(std::max(request.max_tokens, 1));
+        inference.temperature = request.temperature;
+        inference.timeout = request.timeout;
+        inference.on_token = request.on_token;
+        auto run_backend = [&](const InferenceRequest& call) {
+            return limiter.run([&]() {
+                return lb_result.model->getCompletionWithMetadata(call);
+            }, request.timeout, request.timeout);
+        };
+        auto inference_response = coalesce
+            ? RequestCoalescer::getInstance().execute(lb_result.model->getModelId(), inference, run_backend)
+            : run_backend(inference);
+        const std::string& model_response = inference_response.text;
+        size_t tokens_generated = inference_response.tokens_generated;
+        if (inference_response.metadata.count("coalesced")) {
+            response.pipeline_steps.emplace_back("request_coalesced");
+        }
+        response.has_token_confidence = inference_response.hasLogprobs();
+        response.token_confidence = inference_response.confidence_score;
+        response.perplexity = inference_response.perplexity;
         
         auto end_time = std::chrono::steady_clock::now();
         response.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(
             end_time - start_time);
         
         response.response_text = model_response;
-        response.tokens_generated = model_response.length() / 4; // Rough estimate
+        response.tokens_generated = tokens_generated > 0
+            ? tokens_generated
+            : model_response.length() / 4; // Rough estimate
         
         // Record request completion for load balancing
-        if (m_load_balancer && !lb_result.selected_instance_id.empty()) {
-            m_load_balancer->recordRequestEnd(lb_result.selected_instance_id, request.request_id, 
+        if (m_load_balancer && lb_result.selected_instance != INVALID_INTERNED_ID) {
+            m_load_balancer->recordRequestEnd(lb_result.selected_instance, request.request_id, 
                                             response.execution_time.count(), true);
         }
         
@@ -382,8 +423,8 @@ bool ModelOrchestrator::executeRequest(const PipelineRequest& request,
         response.error_message = "Execution failed: " + std::string(e.what());
         
         // Record request failure for load balancing
-        if (m_load_balancer && !lb_result.selected_instance_id.empty()) {
-            m_load_balancer->recordRequestEnd(lb_result.selected_instance_id, request.request_id, 
+        if (m_load_balancer && lb_result.selected_instance != INVALID_INTERNED_ID) {
+            m_load_balancer->recordRequestEnd(lb_result.selected_instance, request.request_id, 
                                             response.execution_time.count(), false);
         }
         
@@ -399,6 +440,13 @@ double ModelOrchestrator::validateResponse(const PipelineRequest& request, Pipel
     
     double quality_score = m_quality_scorer(request.prompt, response.response_text);
     
+    // The model's own token confidence is a direct signal the text
+    // heuristics can only approximate
+    if (response.has_token_confidence) {
+        double weight = std::clamp(m_config.token_confidence_weight, 0.0, 1.0);
+        quality_score = (1.0 - weight) * quality_score + weight * response.token_confidence;
+    }
+    
     Logger::getInstance().debug("ModelOrchestrator", 
         "Response quality score: " + std::to_string(quality_score));
     
@@ -408,6 +456,11 @@ double ModelOrchestrator::validateResponse(const PipelineRequest& request, Pipel
 bool ModelOrchestrator::handleFallback(const PipelineRequest& request, PipelineResponse& response) {
     Logger::getInstance().info("ModelOrchestrator", "Attempting fallback for request: " + request.request_id);
     
+    // The fallback's text replaces the response; the confidence was not its own
+    response.has_token_confidence = false;
+    response.token_confidence = 0.0;
+    response.perplexity = 0.0;
+    
     try {
         switch (m_fallback_strategy) {
             case FallbackStrategy::SIMPLE_MODEL: {
@@ -419,6 +472,7 @@ bool ModelOrchestrator::handleFallback(const PipelineRequest& request, PipelineR
                         if (fallback_model) {
                             response.response_text = fallback_model->getCompletion(request.prompt);
                             response.selected_model = model.name;
+                            response.selected_model_id = model.id;
                             response.selected_instance = model.name + "_fallback";
                             return true;
                         }
@@ -445,6 +499,7 @@ bool ModelOrchestrator::handleFallback(const PipelineRequest& request, PipelineR
                     if (fallback_model) {
                         response.response_text = fallback_model->getCompletion(request.prompt);
                         response.selected_model = fastest_model;
+                        response.selected_model_id = INVALID_INTERNED_ID;
                         response.selected_instance = fastest_model + "_fallback";
                         return true;
                     }
@@ -474,6 +529,7 @@ bool ModelOrchestrator::handleFallback(const PipelineRequest& request, PipelineR
                 if (!best_response.empty()) {
                     response.response_text = best_response;
                     response.selected_model = "cached_fallback";
+                    response.selected_model_id = INVALID_INTERNED_ID;
                     response.selected_instance = "cache";
                     return true;
                 }
@@ -483,6 +539,7 @@ bool ModelOrchestrator::handleFallback(const PipelineRequest& request, PipelineR
             case FallbackStrategy::DEFAULT_RESPONSE: {
                 response.response_text = "I apologize, but I'm unable to process your request at the moment. Please try again later.";
                 response.selected_model = "default_fallback";
+                response.selected_model_id = INVALID_INTERNED_ID;
                 response.selected_instance = "default";
                 return true;
             }
@@ -516,6 +573,7 @@ bool ModelOrchestrator::checkCache(const PipelineRequest& request, PipelineRespo
         if (age < m_config.cache_ttl) {
             response.response_text = entry.response_text;
             response.selected_model = entry.model_used;
+            response.selected_model_id = INVALID_INTERNED_ID;
             response.selected_instance = "cache";
             response.quality_score = entry.quality_score;
             
@@ -694,9 +752,15 @@ void ModelOrchestrator::updateStatistics(const PipelineRequest& request, const P
         }
     }
     
-    // Update model usage
+    // Update model usage; only fallback and cache paths need a name lookup
     if (!response.selected_model.empty()) {
-        m_statistics.model_usage[response.selected_model]++;
+        InternedId model_id = response.selected_model_id != INVALID_INTERNED_ID
+            ? response.selected_model_id
+            : StringInterner::models().intern(response.selected_model);
+        if (model_id >= m_model_usage.size()) {
+            m_model_usage.resize(model_id + 1, 0);
+        }
+        m_model_usage[model_id]++;
     }
     
     // Update task distribution
@@ -714,12 +778,20 @@ void ModelOrchestrator::setConfig(const OrchestratorConfig& config) {
 
 PipelineStatistics ModelOrchestrator::getStatistics() const {
     std::lock_guard<std::mutex> lock(m_stats_mutex);
-    return m_statistics;
+    PipelineStatistics stats = m_statistics;
+    for (size_t model_id = 0; model_id < m_model_usage.size(); ++model_id) {
+        if (m_model_usage[model_id] > 0) {
+            stats.model_usage[StringInterner::models().name(static_cast<InternedId>(model_id))] =
+                m_model_usage[model_id];
+        }
+    }
+    return stats;
 }
 
 void ModelOrchestrator::resetStatistics() {
     std::lock_guard<std::mutex> lock(m_stats_mutex);
     m_statistics = PipelineStatistics();
+    m_model_usage.clear();
     m_statistics.last_reset = std::chrono::system_clock::now();
     Logger::getInstance().info("ModelOrchestrator", "Statistics reset");
 }
@@ -815,7 +887,10 @@ std::string ModelOrchestrator::getPerformanceReport() const {
     report << "  Fallback Usage: " << m_statistics.fallback_used << " times\n\n";
     
     report << "Model Usage:\n";
-    for (const auto& [model, count] : m_statistics.model_usage) {
+    for (size_t model_id = 0; model_id < m_model_usage.size(); ++model_id) {
+        size_t count = m_model_usage[model_id];
+        if (count == 0) continue;
+        const std::string& model = StringInterner::models().name(static_cast<InternedId>(model_id));
         double percentage = (count * 100.0) / m_statistics.total_requests;
         report << "  " << model << ": " << count << " times (" 
                << std::fixed << std::setprecision(1) << percentage << "%)\n";
@@ -0,0 +1,234 @@
+// =================================================================
+// src/Camus/ModelPrefetcher.cpp
+// =================================================================
+// Implementation of parallel model-file read-ahead and mincore residency.
+
+#include "Camus/ModelPrefetcher.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+namespace Camus {
+
+ModelPrefetcher::PrefetchFile::~PrefetchFile() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+ModelPrefetcher::ModelPrefetcher(const ModelPrefetcherConfig& config)
+    : m_config(config) {
+    m_config.worker_threads = std::max<size_t>(1, m_config.worker_threads);
+    m_config.chunk_bytes = std::max<size_t>(1024 * 1024, m_config.chunk_bytes);
+}
+
+ModelPrefetcher::~ModelPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+    }
+    m_work.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+ModelPrefetcher& ModelPrefetcher::getInstance() {
+    static ModelPrefetcher instance;
+    return instance;
+}
+
+bool ModelPrefetcher::prefetch(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_active.find(path);
+        if (it != m_active.end() && !it->second->cancelled) {
+            return true;
+        }
+    }
+
+    auto file = std::make_shared<PrefetchFile>();
+    file->path = path;
+    file->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file->fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(file->fd, &st) != 0 || st.st_size <= 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_active.find(path);
+        if (m_stopping || (it != m_active.end() && !it->second->cancelled)) {
+            return !m_stopping;
+        }
+        // A cancelled entry's queued chunks keep draining as skipped; this
+        // request replaces it, re-reading anything already cached cheaply
+        off_t size = st.st_size;
+        off_t chunk = static_cast<off_t>(m_config.chunk_bytes);
+        for (off_t offset = 0; offset < size; offset += chunk) {
+            m_queue.push_back({file, offset, static_cast<size_t>(std::min(chunk, size - offset))});
+            file->pending_chunks++;
+        }
+        m_active[path] = file;
+        startWorkers();
+    }
+    m_work.notify_all();
+    return true;
+}
+
+void ModelPrefetcher::cancel(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_active.find(path);
+    if (it == m_active.end()) {
+        return;
+    }
+    // Queued chunks are skipped by the workers; in-flight ones finish
+    it->second->cancelled = true;
+}
+
+bool ModelPrefetcher::isPending(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_active.count(path) > 0;
+}
+
+void ModelPrefetcher::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && m_busy == 0; });
+}
+
+void ModelPrefetcher::startWorkers() {
+    while (m_workers.size() < m_config.worker_threads) {
+        m_workers.emplace_back(&ModelPrefetcher::workerLoop, this);
+    }
+}
+
+void ModelPrefetcher::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_work.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        if (m_stopping) {
+            return;
+        }
+        Chunk chunk = std::move(m_queue.front());
+        m_queue.pop_front();
+        bool skip = chunk.file->cancelled;
+        if (skip) {
+            m_stats.chunks_skipped++;
+        } else {
+            m_stats.chunks_issued++;
+        }
+        m_busy++;
+        lock.unlock();
+
+        if (!skip) {
+#ifdef __linux__
+            // Blocks until the chunk's I/O is queued; several workers keep
+            // the device busy with parallel requests
+            ::readahead(chunk.file->fd, chunk.offset, chunk.length);
+#elif defined(POSIX_FADV_WILLNEED)
+            ::posix_fadvise(chunk.file->fd, chunk.offset, static_cast<off_t>(chunk.length),
+                            POSIX_FADV_WILLNEED);
+#endif
+        }
+
+        finishChunk(chunk);
+        lock.lock();
+        m_busy--;
+        if (m_queue.empty() && m_busy == 0) {
+            m_idle.notify_all();
+        }
+    }
+}
+
+void ModelPrefetcher::finishChunk(const Chunk& chunk) {
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--chunk.file->pending_chunks == 0) {
+            // A newer prefetch of the same path may have replaced this entry
+            auto it = m_active.find(chunk.file->path);
+            if (it != m_active.end() && it->second == chunk.file) {
+                m_active.erase(it);
+            }
+            done = true;
+        }
+    }
+    if (done) {
+        // The cached measurement predates the read-ahead
+        std::lock_guard<std::mutex> lock(m_residency_mutex);
+        m_residency.erase(chunk.file->path);
+    }
+}
+
+ModelPrefetcherStats ModelPrefetcher::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+double ModelPrefetcher::residency(const std::string& path) {
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_residency_mutex);
+        auto it = m_residency.find(path);
+        if (it != m_residency.end() && now - it->second.measured < m_config.residency_ttl) {
+            return it->second.fraction;
+        }
+    }
+
+    double fraction = measureResidency(path);
+    std::lock_guard<std::mutex> lock(m_residency_mutex);
+    m_residency[path] = {fraction, now};
+    return fraction;
+}
+
+double ModelPrefetcher::measureResidency(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1.0;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return -1.0;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return -1.0;
+    }
+
+    // Query in windows so the vector stays small for very large files
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t window = page * 262144;
+    std::vector<unsigned char> pages;
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    bool ok = true;
+    for (size_t offset = 0; offset < size && ok; offset += window) {
+        size_t length = std::min(window, size - offset);
+        size_t count = (length + page - 1) / page;
+        pages.resize(count);
+        ok = ::mincore(static_cast<char*>(mapping) + offset, length, pages.data()) == 0;
+        if (ok) {
+            total_pages += count;
+            resident_pages += static_cast<size_t>(std::count_if(pages.begin(), pages.end(),
+                [](unsigned char flags) { return (flags & 1) != 0; }));
+        }
+    }
+    ::munmap(mapping, size);
+
+    if (!ok || total_pages == 0) {
+        return -1.0;
+    }
+    return static_cast<double>(resident_pages) / static_cast<double>(total_pages);
+}
+
+} // namespace Camus
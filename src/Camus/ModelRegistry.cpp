@@ -7,7 +7,10 @@
 #include "Camus/LlamaCppInteraction.hpp"
 #include "Camus/OllamaInteraction.hpp"
 #include "Camus/Logger.hpp"
+#include "Camus/ModelPrefetcher.hpp"
+#include "Camus/ResourceMonitor.hpp"
 #include <yaml-cpp/yaml.h>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <thread>
@@ -17,6 +20,44 @@
 
 namespace Camus {
 
+namespace {
+
+// Model file read from local disk, or empty for server-hosted models
+const std::string& localModelFile(const ModelConfig& config) {
+    static const std::string none;
+    return config.type == "llama_cpp" ? config.path : none;
+}
+
+// Where a configured model lives, in the form shareInstance() takes
+std::string configLocation(const ModelConfig& config) {
+    return config.type == "ollama" ? config.server_url + "|" + config.model_name : config.path;
+}
+
+// A caller's instance served under a configured name; cleanup is left to the caller
+class SharedInstance : public LlmInteraction {
+public:
+    SharedInstance(std::shared_ptr<LlmInteraction> instance, std::string model_id)
+        : m_instance(std::move(instance)), m_model_id(std::move(model_id)) {}
+
+    std::string getCompletion(const std::string& prompt) override { return m_instance->getCompletion(prompt); }
+    InferenceResponse getCompletionWithMetadata(const InferenceRequest& request) override {
+        return m_instance->getCompletionWithMetadata(request);
+    }
+    ModelMetadata getModelMetadata() const override { return m_instance->getModelMetadata(); }
+    bool isHealthy() const override { return m_instance->isHealthy(); }
+    bool performHealthCheck() override { return m_instance->performHealthCheck(); }
+    ModelPerformance getCurrentPerformance() const override { return m_instance->getCurrentPerformance(); }
+    bool warmUp() override { return m_instance->warmUp(); }
+    void cleanup() override {}
+    std::string getModelId() const override { return m_model_id; }
+
+private:
+    std::shared_ptr<LlmInteraction> m_instance;
+    std::string m_model_id;
+};
+
+} // anonymous namespace
+
 ModelRegistry::ModelRegistry(const RegistryConfig& config) 
     : m_config(config), m_model_pool(std::make_unique<ConcreteModelPool>()) {
     
@@ -62,7 +103,38 @@ RegistryStatus ModelRegistry::loadFromConfig(const std::string& config_path) {
         // Clear existing configs and reload
         m_model_configs.clear();
         
-        for (const auto& config : configs) {
+        // Models load one after another; reading files ahead in parallel
+        // means later loads mostly hit the page cache. Files are read in load
+        // order only while they fit in the memory available now; past that,
+        // later readaheads would evict the pages of models not yet loaded
+        if (m_config.prefetch_on_load) {
+            auto snapshot = ResourceMonitor::getInstance().getSnapshot();
+            uint64_t headroom = snapshot.memory_limit_bytes > snapshot.memory_used_bytes
+                ? snapshot.memory_limit_bytes - snapshot.memory_used_bytes : 0;
+            uint64_t planned = 0;
+            for (const auto& config : configs) {
+                const std::string& file = localModelFile(config);
+                if (file.empty() || m_shared_instances.count(modelLocation(config.type, configLocation(config)))) {
+                    continue;
+                }
+                std::error_code ec;
+                uint64_t size = std::filesystem::file_size(file, ec);
+                if (ec) {
+                    continue;
+                }
+                if (planned + size > headroom) {
+                    Logger::getInstance().info("ModelRegistry",
+                        "Not prefetching " + config.name + " and later models: their files exceed available memory");
+                    break;
+                }
+                planned += size;
+                ModelPrefetcher::getInstance().prefetch(file);
+            }
+        }
+        
+        for (auto& config : configs) {
+            // Assign the dense id that selection and load balancing index by
+            config.id = StringInterner::models().intern(config.name);
             m_model_configs[config.name] = config;
             
             // Validate configuration if enabled
@@ -205,6 +277,17 @@ ModelLoadResult ModelRegistry::loadModel(const ModelConfig& config) {
     
     Logger::getInstance().info("ModelRegistry", "Loading model: " + config.name);
     
+    // Already in memory: serve the caller's instance under the configured name
+    auto shared_it = m_shared_instances.find(modelLocation(config.type, configLocation(config)));
+    if (shared_it != m_shared_instances.end()) {
+        result.success = m_model_pool->addModel(
+            std::make_shared<SharedInstance>(shared_it->second, config.name + "_" + config.version));
+        if (!result.success) {
+            result.error_message = "Failed to add model to pool";
+        }
+        return result;
+    }
+    
     // Find appropriate factory
     auto factory_it = m_factories.find(config.type);
     if (factory_it == m_factories.end()) {
@@ -308,6 +391,32 @@ std::pair<bool, std::chrono::milliseconds> ModelRegistry::testModel(const std::s
     }
 }
 
+bool ModelRegistry::prefetchModel(const std::string& model_name) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_registry_mutex);
+        auto it = m_model_configs.find(model_name);
+        if (it == m_model_configs.end()) {
+            return false;
+        }
+        path = localModelFile(it->second);
+    }
+    return !path.empty() && ModelPrefetcher::getInstance().prefetch(path);
+}
+
+double ModelRegistry::getPageCacheResidency(const std::string& model_name) const {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_registry_mutex);
+        auto it = m_model_configs.find(model_name);
+        if (it == m_model_configs.end()) {
+            return -1.0;
+        }
+        path = localModelFile(it->second);
+    }
+    return path.empty() ? -1.0 : ModelPrefetcher::getInstance().residency(path);
+}
+
 std::string ModelRegistry::getModelInfo(const std::string& model_name) const {
     auto model = m_model_pool->getModel(model_name);
     if (!model) {
@@ -339,6 +448,9 @@ std::string ModelRegistry::getModelInfo(const std::string& model_name) const {
     ss << "    Avg Latency: " << performance.avg_latency.count() << "ms\n";
     ss << "    Tokens/sec: " << performance.tokens_per_second << "\n";
     ss << "    Memory: " << performance.memory_usage_gb << "GB\n";
+    if (metadata.page_cache_residency >= 0.0) {
+        ss << "    Page Cache: " << static_cast<int>(metadata.page_cache_residency * 100.0) << "% resident\n";
+    }
     
     return ss.str();
 }
@@ -369,6 +481,30 @@ std::string ModelRegistry::getAllModelsInfo() const {
     return ss.str();
 }
 
+void ModelRegistry::shareInstance(const std::string& model_type, const std::string& location,
+                                  std::shared_ptr<LlmInteraction> instance) {
+    std::lock_guard<std::mutex> lock(m_registry_mutex);
+    m_shared_instances[modelLocation(model_type, location)] = std::move(instance);
+}
+
+std::string ModelRegistry::modelLocation(const std::string& model_type, const std::string& location) {
+    std::string normalized = location;
+    if (model_type == "llama_cpp") {
+        std::error_code ec;
+        auto canonical = std::filesystem::weakly_canonical(location, ec);
+        if (!ec) {
+            normalized = canonical.string();
+        }
+    } else {
+        // "http://host:11434/|model" and "http://host:11434|model" are the same server
+        size_t separator = normalized.find('|');
+        while (separator != std::string::npos && separator > 0 && normalized[separator - 1] == '/') {
+            normalized.erase(--separator, 1);
+        }
+    }
+    return model_type + ":" + normalized;
+}
+
 void ModelRegistry::setConfig(const RegistryConfig& config) {
     std::lock_guard<std::mutex> lock(m_registry_mutex);
     
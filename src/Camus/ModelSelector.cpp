@@ -12,6 +12,50 @@
 
 namespace Camus {
 
+// =================================================================
+// ModelStatisticsTable Implementation
+// =================================================================
+
+const ModelStatistics* ModelStatisticsTable::find(InternedId model_id) const {
+    if (model_id < m_stats.size() && m_present[model_id]) {
+        return &m_stats[model_id];
+    }
+    return nullptr;
+}
+
+const ModelStatistics* ModelStatisticsTable::find(const ModelConfig& model) const {
+    InternedId model_id = model.id != INVALID_INTERNED_ID
+        ? model.id
+        : StringInterner::models().find(model.name);
+    return find(model_id);
+}
+
+ModelStatistics& ModelStatisticsTable::get(InternedId model_id) {
+    if (model_id >= m_stats.size()) {
+        m_stats.resize(model_id + 1);
+        m_present.resize(model_id + 1, false);
+    }
+    if (!m_present[model_id]) {
+        m_present[model_id] = true;
+        m_count++;
+    }
+    return m_stats[model_id];
+}
+
+void ModelStatisticsTable::erase(InternedId model_id) {
+    if (model_id < m_stats.size() && m_present[model_id]) {
+        m_stats[model_id] = ModelStatistics();
+        m_present[model_id] = false;
+        m_count--;
+    }
+}
+
+void ModelStatisticsTable::clear() {
+    m_stats.clear();
+    m_present.clear();
+    m_count = 0;
+}
+
 // =================================================================
 // Built-in Selection Strategies
 // =================================================================
@@ -24,10 +68,10 @@ public:
     SelectionResult selectModel(
         const SelectionCriteria& criteria,
         const std::vector<ModelConfig>& available_models,
-        const std::unordered_map<std::string, ModelStatistics>& model_stats
+        const ModelStatisticsTable& model_stats
     ) override {
         auto start_time = std::chrono::steady_clock::now();
-        SelectionResult result;
+        SelectionResult result(criteria.memory_resource);
         
         // Apply rules in order of priority
         for (const auto& model : available_models) {
@@ -68,15 +112,15 @@ public:
             
             // Rule 5: Latency requirements
             if (criteria.max_latency_ms > 0) {
-                auto stats_it = model_stats.find(model.name);
-                if (stats_it != model_stats.end() && 
-                    stats_it->second.average_latency_ms > criteria.max_latency_ms) {
+                const ModelStatistics* stats = model_stats.find(model);
+                if (stats && stats->average_latency_ms > criteria.max_latency_ms) {
                     matches = false;
                 }
             }
             
             if (matches) {
                 result.selected_model = model.name;
+                result.selected_model_id = model.id;
                 result.confidence_score = 0.85; // High confidence for rule-based
                 result.selection_reason = "Model matches all rule-based criteria";
                 break;
@@ -86,6 +130,7 @@ public:
         // If no perfect match, find best alternative
         if (result.selected_model.empty() && !available_models.empty()) {
             result.selected_model = available_models[0].name;
+            result.selected_model_id = available_models[0].id;
             result.confidence_score = 0.5;
             result.selection_reason = "Default fallback - no models matched all rules";
         }
@@ -110,12 +155,12 @@ public:
     SelectionResult selectModel(
         const SelectionCriteria& criteria,
         const std::vector<ModelConfig>& available_models,
-        const std::unordered_map<std::string, ModelStatistics>& model_stats
+        const ModelStatisticsTable& model_stats
     ) override {
         auto start_time = std::chrono::steady_clock::now();
-        SelectionResult result;
+        SelectionResult result(criteria.memory_resource);
         
-        std::vector<std::pair<std::string, double>> model_scores;
+        std::vector<std::pair<const ModelConfig*, double>> model_scores;
         
         for (const auto& model : available_models) {
             double score = 0.0;
@@ -148,9 +193,8 @@ public:
             
             // Performance score (0-20 points)
             double performance_score = 10.0; // Default neutral score
-            auto stats_it = model_stats.find(model.name);
-            if (stats_it != model_stats.end()) {
-                const auto& stats = stats_it->second;
+            if (const ModelStatistics* model_stat = model_stats.find(model)) {
+                const auto& stats = *model_stat;
                 if (stats.total_requests > 0) {
                     performance_score = stats.success_rate * 20.0;
                     
@@ -180,6 +224,14 @@ public:
             // Calculate total score
             score = capability_score + context_score + performance_score + quality_score;
             
+            // A model whose weights are already in the page cache starts
+            // generating without a disk-bound warm-up
+            if (const ModelStatistics* model_stat = model_stats.find(model)) {
+                if (model_stat->page_cache_residency >= 0.0) {
+                    score *= 0.9 + 0.1 * model_stat->page_cache_residency;
+                }
+            }
+            
             // Apply custom weights if provided
             if (!criteria.custom_weights.empty()) {
                 double weight_multiplier = 1.0;
@@ -194,7 +246,7 @@ public:
             // Normalize to 0-1 range
             score /= 100.0;
             
-            model_scores.push_back({model.name, score});
+            model_scores.push_back({&model, score});
         }
         
         // Sort by score descending
@@ -202,7 +254,8 @@ public:
             [](const auto& a, const auto& b) { return a.second > b.second; });
         
         if (!model_scores.empty()) {
-            result.selected_model = model_scores[0].first;
+            result.selected_model = model_scores[0].first->name;
+            result.selected_model_id = model_scores[0].first->id;
             result.confidence_score = model_scores[0].second;
             
             // Build selection reason
@@ -214,7 +267,7 @@ public:
             
             // Add alternatives
             for (size_t i = 1; i < std::min(size_t(3), model_scores.size()); ++i) {
-                result.alternatives.push_back(model_scores[i]);
+                result.alternatives.emplace_back(model_scores[i].first->name, model_scores[i].second);
             }
         }
         
@@ -238,12 +291,13 @@ public:
     SelectionResult selectModel(
         const SelectionCriteria& criteria,
         const std::vector<ModelConfig>& available_models,
-        const std::unordered_map<std::string, ModelStatistics>& model_stats
+        const ModelStatisticsTable& model_stats
     ) override {
         auto start_time = std::chrono::steady_clock::now();
-        SelectionResult result;
+        SelectionResult result(criteria.memory_resource);
         
-        std::vector<std::pair<std::string, double>> model_scores;
+        std::vector<std::pair<const ModelConfig*, double>> model_scores;
+        const std::string task_key = taskTypeToString(criteria.task_type);
         
         for (const auto& model : available_models) {
             double score = 0.0;
@@ -252,16 +306,14 @@ public:
             double base_score = 0.5;
             
             // Adjust based on historical performance
-            auto stats_it = model_stats.find(model.name);
-            if (stats_it != model_stats.end()) {
-                const auto& stats = stats_it->second;
+            if (const ModelStatistics* model_stat = model_stats.find(model)) {
+                const auto& stats = *model_stat;
                 
                 // Overall success rate weight
                 if (stats.total_requests > 0) {
                     base_score = stats.success_rate * 0.4;
                     
                     // Task-specific performance
-                    std::string task_key = taskTypeToString(criteria.task_type);
                     auto task_perf_it = stats.task_performance.find(task_key);
                     if (task_perf_it != stats.task_performance.end()) {
                         base_score += task_perf_it->second * 0.3;
@@ -279,6 +331,11 @@ public:
                         base_score *= 1.1;
                     }
                 }
+                
+                // Prefer models that are already hot in the page cache
+                if (stats.page_cache_residency >= 0.0) {
+                    base_score *= 0.9 + 0.1 * stats.page_cache_residency;
+                }
             }
             
             // Capability matching bonus
@@ -300,7 +357,7 @@ public:
             }
             
             score = std::min(1.0, base_score);
-            model_scores.push_back({model.name, score});
+            model_scores.push_back({&model, score});
         }
         
         // Sort by score descending
@@ -308,7 +365,8 @@ public:
             [](const auto& a, const auto& b) { return a.second > b.second; });
         
         if (!model_scores.empty()) {
-            result.selected_model = model_scores[0].first;
+            result.selected_model = model_scores[0].first->name;
+            result.selected_model_id = model_scores[0].first->id;
             result.confidence_score = model_scores[0].second;
             
             // Build selection reason
@@ -320,7 +378,7 @@ public:
             
             // Add alternatives
             for (size_t i = 1; i < std::min(size_t(3), model_scores.size()); ++i) {
-                result.alternatives.push_back(model_scores[i]);
+                result.alternatives.emplace_back(model_scores[i].first->name, model_scores[i].second);
             }
         }
         
@@ -370,7 +428,7 @@ SelectionResult ModelSelector::selectModel(const SelectionCriteria& criteria) {
     
     if (healthy_models.empty()) {
         Logger::getInstance().error("ModelSelector", "No healthy models available");
-        SelectionResult result;
+        SelectionResult result(criteria.memory_resource);
         result.selection_reason = "No healthy models available";
         return result;
     }
@@ -378,17 +436,36 @@ SelectionResult ModelSelector::selectModel(const SelectionCriteria& criteria) {
     // Get current statistics
     std::lock_guard<std::mutex> lock(m_stats_mutex);
     
+    // Residency comes from a cached mincore() measurement, so this stays cheap
+    if (m_config.prefer_resident_models) {
+        for (const auto& model : healthy_models) {
+            double residency = m_registry.getPageCacheResidency(model.name);
+            if (residency >= 0.0 && model.id != INVALID_INTERNED_ID) {
+                m_model_stats.get(model.id).page_cache_residency = residency;
+            }
+        }
+    }
+    
     // Use active strategy
     auto strategy_it = m_strategies.find(m_active_strategy);
     if (strategy_it == m_strategies.end()) {
         Logger::getInstance().error("ModelSelector", "Active strategy not found: " + m_active_strategy);
-        SelectionResult result;
+        SelectionResult result(criteria.memory_resource);
         result.selection_reason = "Selection strategy error";
         return result;
     }
     
     auto result = strategy_it->second->selectModel(criteria, healthy_models, m_model_stats);
     
+    // The selected model is about to run; if the kernel evicted its
+    // weights, start reading them back while the request is prepared
+    if (m_config.prefetch_predicted_models && !result.selected_model.empty()) {
+        double residency = m_registry.getPageCacheResidency(result.selected_model);
+        if (residency >= 0.0 && residency < 0.9) {
+            m_registry.prefetchModel(result.selected_model);
+        }
+    }
+    
     // Log selection decision
     Logger::getInstance().info("ModelSelector", 
         "Selected model: " + result.selected_model + 
@@ -429,7 +506,7 @@ void ModelSelector::recordPerformance(const std::string& model_name,
                                     double quality_score) {
     std::lock_guard<std::mutex> lock(m_stats_mutex);
     
-    auto& stats = m_model_stats[model_name];
+    auto& stats = m_model_stats.get(StringInterner::models().intern(model_name));
     updateStatistics(stats, success, latency_ms, quality_score);
     
     // Update task-specific performance
@@ -453,9 +530,8 @@ void ModelSelector::recordPerformance(const std::string& model_name,
 ModelStatistics ModelSelector::getModelStatistics(const std::string& model_name) const {
     std::lock_guard<std::mutex> lock(m_stats_mutex);
     
-    auto it = m_model_stats.find(model_name);
-    if (it != m_model_stats.end()) {
-        return it->second;
+    if (const ModelStatistics* stats = m_model_stats.find(StringInterner::models().find(model_name))) {
+        return *stats;
     }
     
     return ModelStatistics();
@@ -463,12 +539,16 @@ ModelStatistics ModelSelector::getModelStatistics(const std::string& model_name)
 
 std::unordered_map<std::string, ModelStatistics> ModelSelector::getAllStatistics() const {
     std::lock_guard<std::mutex> lock(m_stats_mutex);
-    return m_model_stats;
+    std::unordered_map<std::string, ModelStatistics> all_stats;
+    m_model_stats.forEach([&all_stats](const std::string& model_name, const ModelStatistics& stats) {
+        all_stats.emplace(model_name, stats);
+    });
+    return all_stats;
 }
 
 void ModelSelector::clearStatistics(const std::string& model_name) {
     std::lock_guard<std::mutex> lock(m_stats_mutex);
-    m_model_stats.erase(model_name);
+    m_model_stats.erase(StringInterner::models().find(model_name));
     Logger::getInstance().info("ModelSelector", "Cleared statistics for: " + model_name);
 }
 
@@ -541,7 +621,7 @@ std::string ModelSelector::analyzeSelectionPatterns() const {
     
     // Model performance summary
     analysis << "\nModel Performance Summary:\n";
-    for (const auto& [model, stats] : m_model_stats) {
+    m_model_stats.forEach([&analysis](const std::string& model, const ModelStatistics& stats) {
         analysis << "  " << model << ":\n";
         analysis << "    Total requests: " << stats.total_requests << "\n";
         analysis << "    Success rate: " 
@@ -555,7 +635,7 @@ std::string ModelSelector::analyzeSelectionPatterns() const {
                      << std::fixed << std::setprecision(2) 
                      << stats.average_quality_score << "\n";
         }
-    }
+    });
     
     return analysis.str();
 }
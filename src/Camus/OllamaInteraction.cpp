@@ -4,6 +4,7 @@
 // Revised implementation for Ollama API interaction with streaming.
 
 #include "Camus/OllamaInteraction.hpp"
+#include "Camus/FileBlockFormat.hpp"
 #include "httplib.h"
 #include "nlohmann/json.hpp"
 #include <iostream>
@@ -12,6 +13,8 @@
 #include <fstream>
 #include <chrono>
 #include <functional>
+#include <cctype>
+#include <limits>
 
 namespace Camus {
 
@@ -57,6 +60,82 @@ static void clean_llm_output(std::string& output) {
     trim_whitespace(output);
 }
 
+// Ollama reads a JSON number as seconds (negative = forever) and a string
+// as a Go duration, so "-1" or "600" from YAML must be sent as numbers
+static nlohmann::json keep_alive_value(const std::string& keep_alive) {
+    bool numeric = !keep_alive.empty();
+    for (size_t i = 0; i < keep_alive.size(); ++i) {
+        unsigned char ch = keep_alive[i];
+        if (!std::isdigit(ch) && !(i == 0 && ch == '-' && keep_alive.size() > 1)) {
+            numeric = false;
+            break;
+        }
+    }
+    if (numeric) {
+        return std::stoll(keep_alive);
+    }
+    return keep_alive;
+}
+
+// Adds keep_alive and the per-model runtime options to a request body
+static void apply_runtime_options(nlohmann::json& body, const OllamaRuntimeOptions& options) {
+    if (!options.keep_alive.empty()) {
+        body["keep_alive"] = keep_alive_value(options.keep_alive);
+    }
+    nlohmann::json& runtime = body["options"];
+    // The KV cache is sized by num_ctx, so the server default is kept unless
+    // the model asks for more
+    if (options.num_ctx > 0) {
+        runtime["num_ctx"] = options.num_ctx;
+    }
+    if (options.num_thread > 0) {
+        runtime["num_thread"] = options.num_thread;
+    }
+    if (options.num_batch > 0) {
+        runtime["num_batch"] = options.num_batch;
+    }
+    if (options.num_gpu >= 0) {
+        runtime["num_gpu"] = options.num_gpu;
+    }
+}
+
+OllamaRuntimeOptions OllamaRuntimeOptions::fromAttributes(
+    const std::unordered_map<std::string, std::string>& attributes) {
+    OllamaRuntimeOptions options;
+    
+    auto lookup = [&attributes](std::initializer_list<const char*> keys) -> const std::string* {
+        for (const char* key : keys) {
+            auto it = attributes.find(key);
+            if (it != attributes.end() && !it->second.empty()) {
+                return &it->second;
+            }
+        }
+        return nullptr;
+    };
+    auto read_int = [&lookup](std::initializer_list<const char*> keys, int& target) {
+        if (const std::string* value = lookup(keys)) {
+            try {
+                target = std::stoi(*value);
+            } catch (const std::exception&) {
+                std::cerr << "[WARN] Ignoring invalid Ollama option value: " << *value << std::endl;
+            }
+        }
+    };
+    
+    if (const std::string* keep_alive = lookup({"keep_alive"})) {
+        options.keep_alive = *keep_alive;
+    }
+    read_int({"num_ctx"}, options.num_ctx);
+    read_int({"num_thread", "threads"}, options.num_thread);
+    read_int({"num_batch", "batch_size"}, options.num_batch);
+    read_int({"num_gpu", "gpu_layers"}, options.num_gpu);
+    
+    int max_in_flight = 0;
+    read_int({"num_parallel"}, max_in_flight);
+    options.max_in_flight = max_in_flight > 0 ? static_cast<size_t>(max_in_flight) : 0;
+    
+    return options;
+}
 
 OllamaInteraction::OllamaInteraction(const std::string& server_url, const std::string& model_name)
     : m_server_url(server_url), m_model_name(model_name) {
@@ -70,7 +149,8 @@ OllamaInteraction::OllamaInteraction(const std::string& server_url, const std::s
 }
 
 OllamaInteraction::OllamaInteraction(const std::string& server_url, const std::string& model_name, const ModelMetadata& metadata)
-    : m_server_url(server_url), m_model_name(model_name), m_metadata(metadata) {
+    : m_server_url(server_url), m_model_name(model_name), m_metadata(metadata),
+      m_options(OllamaRuntimeOptions::fromAttributes(metadata.custom_attributes)) {
     std::cout << "[INFO] Configured Ollama client for server: " << server_url
               << " with model: " << model_name << std::endl;
               
@@ -81,6 +161,30 @@ OllamaInteraction::OllamaInteraction(const std::string& server_url, const std::s
 }
 
 std::string OllamaInteraction::getCompletion(const std::string& prompt) {
+    return generate(prompt, nullptr);
+}
+
+std::string OllamaInteraction::generate(const std::string& prompt, const InferenceRequest* request,
+                                        InferenceResponse* response) {
+    // Hold a flight slot for the duration of the request
+    {
+        std::unique_lock<std::mutex> lock(m_flight_mutex);
+        m_flight_cv.wait(lock, [this]() {
+            return m_options.max_in_flight == 0 || m_in_flight < m_options.max_in_flight;
+        });
+        m_in_flight++;
+    }
+    struct FlightRelease {
+        OllamaInteraction* self;
+        ~FlightRelease() {
+            {
+                std::lock_guard<std::mutex> lock(self->m_flight_mutex);
+                self->m_in_flight--;
+            }
+            self->m_flight_cv.notify_one();
+        }
+    } release{this};
+    
     try {
         // The httplib constructor handles URL parsing automatically.
         httplib::Client client(m_server_url.c_str());
@@ -93,6 +197,28 @@ std::string OllamaInteraction::getCompletion(const std::string& prompt) {
             {"prompt", prompt},
             {"stream", false} // Enable streaming
         };
+        if (request) {
+            request_body["options"] = {
+                {"temperature", request->temperature},
+                {"top_p", request->top_p},
+                // Ollama reads num_predict as a 32-bit int
+                {"num_predict", static_cast<int>(std::min<size_t>(request->max_tokens, std::numeric_limits<int>::max()))}
+            };
+            if (!request->stop_sequences.empty()) {
+                request_body["options"]["stop"] = request->stop_sequences;
+            }
+            // Servers without logprob support ignore the field
+            request_body["logprobs"] = true;
+            if (!request->context_tokens.empty()) {
+                request_body["context"] = request->context_tokens;
+            }
+        }
+        // Ollama constrains output with a JSON schema rather than a grammar
+        bool file_blocks = request && request->constraint == ResponseConstraint::FILE_BLOCKS;
+        if (file_blocks) {
+            request_body["format"] = nlohmann::json::parse(FileBlockFormat::jsonSchema());
+        }
+        apply_runtime_options(request_body, m_options);
 
         std::cout << "[INFO] Sending request to Ollama server (streaming mode off)..." << std::endl;
 
@@ -139,6 +265,31 @@ std::string OllamaInteraction::getCompletion(const std::string& prompt) {
                     std::cout << chunk_text << std::flush;
                     accumulated_response += chunk_text;
                 }
+                if (response && json_chunk.contains("logprobs") && json_chunk["logprobs"].is_array()) {
+                    for (const auto& entry : json_chunk["logprobs"]) {
+                        if (entry.is_object() && entry.contains("logprob") && entry["logprob"].is_number()) {
+                            response->token_logprobs.push_back(entry["logprob"].get<float>());
+                        }
+                    }
+                }
+                if (response && json_chunk.value("done", false)) {
+                    // Ollama's own timings, in nanoseconds, for capacity planning
+                    for (const char* field : {"total_duration", "load_duration", "prompt_eval_count",
+                                              "prompt_eval_duration", "eval_count", "eval_duration"}) {
+                        if (json_chunk.contains(field) && json_chunk[field].is_number()) {
+                            response->metadata[field] = std::to_string(json_chunk[field].get<long long>());
+                        }
+                    }
+                    if (json_chunk.contains("eval_count") && json_chunk["eval_count"].is_number()) {
+                        response->tokens_generated = json_chunk["eval_count"].get<size_t>();
+                    }
+                    if (json_chunk.contains("done_reason") && json_chunk["done_reason"].is_string()) {
+                        response->finish_reason = json_chunk["done_reason"].get<std::string>();
+                    }
+                    if (json_chunk.contains("context") && json_chunk["context"].is_array()) {
+                        response->context_tokens = json_chunk["context"].get<std::vector<int64_t>>();
+                    }
+                }
             } catch (const nlohmann::json::exception& e) {
                 // Ignore malformed JSON lines
             }
@@ -146,6 +297,14 @@ std::string OllamaInteraction::getCompletion(const std::string& prompt) {
         
         std::cout << std::endl;
         
+        if (file_blocks) {
+            // The schema-conforming JSON becomes blocks; no fence heuristics
+            if (response) {
+                response->metadata["constraint"] = FileBlockFormat::CONSTRAINT_NAME;
+            }
+            return FileBlockFormat::fromJson(accumulated_response);
+        }
+        
         // Clean the output
         clean_llm_output(accumulated_response);
         return accumulated_response;
@@ -160,11 +319,17 @@ InferenceResponse OllamaInteraction::getCompletionWithMetadata(const InferenceRe
     auto start_time = std::chrono::steady_clock::now();
     
     InferenceResponse response;
-    response.text = getCompletion(request.prompt);
+    response.finish_reason = "stop";
+    response.text = generate(request.prompt, &request, &response);
+    if (request.on_token) {
+        // Ollama is queried without streaming; deliver the text in one piece
+        request.on_token(response.text);
+    }
     
     auto end_time = std::chrono::steady_clock::now();
     response.response_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    response.finish_reason = "stop";
+    response.was_truncated = response.finish_reason == "length";
+    response.summarizeLogprobs();
     
     // Update performance metrics
     updatePerformanceMetrics(response);
@@ -248,9 +413,28 @@ ModelPerformance OllamaInteraction::getCurrentPerformance() const {
 }
 
 bool OllamaInteraction::warmUp() {
+    // Load the model with the options real requests will use, so the first
+    // request neither pays the load nor triggers a reload
+    return preload();
+}
+
+bool OllamaInteraction::preload() {
     try {
-        // Perform a small test inference to warm up the model
-        getCompletion("Hi");
+        httplib::Client client(m_server_url.c_str());
+        client.set_read_timeout(300); // Large models can take minutes to load
+        client.set_connection_timeout(30);
+        
+        // A generate request without a prompt only loads the model
+        nlohmann::json request_body = {{"model", m_model_name}};
+        apply_runtime_options(request_body, m_options);
+        
+        auto res = client.Post("/api/generate", request_body.dump(), "application/json");
+        if (!res || res->status != 200) {
+            std::cerr << "[WARN] Failed to preload Ollama model: " << m_model_name << std::endl;
+            return false;
+        }
+        std::cout << "[INFO] Preloaded Ollama model: " << m_model_name 
+                  << " (keep_alive " << m_options.keep_alive << ")" << std::endl;
         return true;
     } catch (const std::exception&) {
         return false;
@@ -258,12 +442,32 @@ bool OllamaInteraction::warmUp() {
 }
 
 void OllamaInteraction::cleanup() {
-    // For Ollama, cleanup mainly involves marking as unavailable
+    // For Ollama, cleanup mainly involves marking as unavailable. The server
+    // keeps the model resident for keep_alive, which other clients rely on
     m_is_healthy = false;
     m_metadata.is_healthy = false;
     m_metadata.is_available = false;
 }
 
+bool OllamaInteraction::unloadFromServer() {
+    try {
+        httplib::Client client(m_server_url.c_str());
+        client.set_connection_timeout(30);
+        
+        // keep_alive 0 without a prompt makes Ollama evict the model at once
+        nlohmann::json request_body = {{"model", m_model_name}, {"keep_alive", 0}};
+        auto res = client.Post("/api/generate", request_body.dump(), "application/json");
+        if (!res || res->status != 200) {
+            std::cerr << "[WARN] Failed to unload Ollama model: " << m_model_name << std::endl;
+            return false;
+        }
+        std::cout << "[INFO] Unloaded Ollama model: " << m_model_name << std::endl;
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
 std::string OllamaInteraction::getModelId() const {
     if (m_metadata.name.empty()) {
         return generateModelId();
@@ -271,6 +475,19 @@ std::string OllamaInteraction::getModelId() const {
     return m_metadata.name + "_" + m_metadata.version;
 }
 
+std::string OllamaInteraction::getBackendEndpoint() const {
+    return endpointFor(m_server_url);
+}
+
+std::string OllamaInteraction::endpointFor(const std::string& server_url) {
+    // Every model on one server shares its compute
+    std::string url = server_url;
+    while (!url.empty() && url.back() == '/') {
+        url.pop_back();
+    }
+    return "ollama:" + url;
+}
+
 void OllamaInteraction::initializeDefaultMetadata() {
     if (m_metadata.name.empty()) {
         m_metadata.name = "Ollama_" + m_model_name;
@@ -5,6 +5,8 @@
 
 #include "Camus/ParallelStrategy.hpp"
 #include "Camus/Logger.hpp"
+#include "Camus/RequestCoalescer.hpp"
+#include "Camus/AdaptiveConcurrencyLimiter.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -96,7 +98,8 @@ private:
 
 ParallelStrategy::ParallelStrategy(ModelRegistry& registry, 
                                  const ParallelStrategyConfig& config)
-    : m_registry(registry), m_config(config) {
+    : m_registry(registry), m_config(config),
+      m_monitor(config.resource_monitor ? config.resource_monitor : &ResourceMonitor::getInstance()) {
     
     // Initialize thread pool
     initializeThreadPool();
@@ -108,12 +111,6 @@ ParallelStrategy::ParallelStrategy(ModelRegistry& registry,
     // Initialize statistics
     m_statistics.last_reset = std::chrono::system_clock::now();
     
-    // Start resource monitoring thread
-    if (m_config.enable_resource_monitoring) {
-        std::thread monitor_thread(&ParallelStrategy::monitorResources, this);
-        monitor_thread.detach();
-    }
-    
     Logger::getInstance().info("ParallelStrategy", "Strategy initialized successfully");
 }
 
@@ -257,9 +254,7 @@ std::vector<SubtaskResult> ParallelStrategy::executeSubtasks(
             
             for (const auto& subtask : group) {
                 // Check concurrent execution limit
-                while (m_active_executions >= request.max_concurrent_tasks) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                }
+                waitForExecutionSlot(request.max_concurrent_tasks);
                 
                 m_active_executions++;
                 
@@ -267,6 +262,7 @@ std::vector<SubtaskResult> ParallelStrategy::executeSubtasks(
                     m_thread_pool->enqueue([this, &subtask, &request]() {
                         auto result = executeSubtask(subtask, request);
                         m_active_executions--;
+                        m_monitor->notifyWaiters();
                         return result;
                     })
                 );
@@ -291,9 +287,7 @@ std::vector<SubtaskResult> ParallelStrategy::executeSubtasks(
         
         for (const auto& subtask : subtasks) {
             // Check concurrent execution limit
-            while (m_active_executions >= request.max_concurrent_tasks) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            }
+            waitForExecutionSlot(request.max_concurrent_tasks);
             
             m_active_executions++;
             
@@ -301,6 +295,7 @@ std::vector<SubtaskResult> ParallelStrategy::executeSubtasks(
                 m_thread_pool->enqueue([this, &subtask, &request]() {
                     auto result = executeSubtask(subtask, request);
                     m_active_executions--;
+                    m_monitor->notifyWaiters();
                     return result;
                 })
             );
@@ -323,6 +318,19 @@ std::vector<SubtaskResult> ParallelStrategy::executeSubtasks(
     return results;
 }
 
+// Metadata request carrying the subtask's sampling, limit and output constraint
+static InferenceRequest makeInferenceRequest(const ParallelSubtask& subtask) {
+    InferenceRequest inference;
+    inference.prompt = subtask.prompt;
+    inference.temperature = subtask.temperature;
+    inference.timeout = subtask.timeout;
+    inference.constraint = subtask.constraint;
+    if (subtask.max_tokens > 0) {
+        inference.max_tokens = subtask.max_tokens;
+    }
+    return inference;
+}
+
 SubtaskResult ParallelStrategy::executeSubtask(const ParallelSubtask& subtask,
                                               const ParallelRequest& request) {
     auto start_time = std::chrono::steady_clock::now();
@@ -338,10 +346,28 @@ SubtaskResult ParallelStrategy::executeSubtask(const ParallelSubtask& subtask,
             throw std::runtime_error("Model not available: " + subtask.model_name);
         }
         
-        // Execute model with timeout
-        std::future<std::string> future = std::async(std::launch::async, 
+        // Execute model with timeout; the backend's limiter queues the call
+        // while the model is at its concurrency limit
+        std::future<InferenceResponse> future = std::async(std::launch::async, 
             [&model, &subtask]() {
-                return model->getCompletion(subtask.prompt);
+                auto& limiter = AdaptiveConcurrencyLimiter::forBackend(model->getBackendEndpoint());
+                if (subtask.temperature > 0.0 && subtask.constraint == ResponseConstraint::NONE) {
+                    InferenceResponse response;
+                    response.text = limiter.run([&]() {
+                        return model->getCompletion(subtask.prompt);
+                    }, subtask.timeout, subtask.timeout);
+                    return response;
+                }
+                InferenceRequest inference = makeInferenceRequest(subtask);
+                auto run_backend = [&](const InferenceRequest& call) {
+                    return limiter.run([&]() {
+                        return model->getCompletionWithMetadata(call);
+                    }, subtask.timeout, subtask.timeout);
+                };
+                // Identical greedy subtasks share one generation and one permit
+                return subtask.temperature > 0.0
+                    ? run_backend(inference)
+                    : RequestCoalescer::getInstance().execute(subtask.model_name, inference, run_backend);
             });
         
         if (future.wait_for(subtask.timeout) == std::future_status::timeout) {
@@ -349,7 +375,12 @@ SubtaskResult ParallelStrategy::executeSubtask(const ParallelSubtask& subtask,
                                    std::to_string(subtask.timeout.count()) + "ms");
         }
         
-        result.result_text = future.get();
+        InferenceResponse response = future.get();
+        result.result_text = response.text;
+        auto constraint = response.metadata.find("constraint");
+        if (constraint != response.metadata.end()) {
+            result.metadata["constraint"] = constraint->second;
+        }
         
         if (result.result_text.empty()) {
             throw std::runtime_error("Model returned empty response");
@@ -373,14 +404,29 @@ SubtaskResult ParallelStrategy::executeSubtask(const ParallelSubtask& subtask,
         // Retry if enabled and not critical
         if (m_config.enable_failure_recovery && !subtask.is_critical) {
             for (size_t attempt = 1; attempt <= m_config.max_retry_attempts; ++attempt) {
-                Logger::getInstance().warn("ParallelStrategy", 
+                Logger::getInstance().warning("ParallelStrategy", 
                     "Retrying subtask '" + subtask.subtask_id + "' attempt " + 
                     std::to_string(attempt));
                 
                 try {
                     auto model = m_registry.getModel(subtask.model_name);
                     if (model) {
-                        result.result_text = model->getCompletion(subtask.prompt);
+                        auto& limiter = AdaptiveConcurrencyLimiter::forBackend(model->getBackendEndpoint());
+                        if (subtask.constraint == ResponseConstraint::NONE) {
+                            result.result_text = limiter.run(
+                                [&]() { return model->getCompletion(subtask.prompt); },
+                                subtask.timeout, subtask.timeout);
+                        } else {
+                            InferenceRequest inference = makeInferenceRequest(subtask);
+                            InferenceResponse response = limiter.run(
+                                [&]() { return model->getCompletionWithMetadata(inference); },
+                                subtask.timeout, subtask.timeout);
+                            result.result_text = response.text;
+                            auto constraint = response.metadata.find("constraint");
+                            if (constraint != response.metadata.end()) {
+                                result.metadata["constraint"] = constraint->second;
+                            }
+                        }
                         result.success = true;
                         result.error_message.clear();
                         result.quality_score = 0.5;
@@ -708,48 +754,68 @@ bool ParallelStrategy::checkResourceAvailability() {
         return true;
     }
     
-    return m_current_cpu_usage < m_config.max_cpu_usage_percent &&
-           m_current_memory_usage < m_config.max_memory_usage_percent &&
-           m_active_executions < m_config.max_concurrent_executions;
+    updateResourceUsage(m_active_executions.load());
+    return admits(m_monitor->getSnapshot());
+}
+
+bool ParallelStrategy::admits(const SystemResourceSnapshot& snapshot) const {
+    if (m_active_executions >= m_config.max_concurrent_executions) {
+        return false;
+    }
+    if (!m_config.enable_resource_monitoring) {
+        return true;
+    }
+    
+    bool under_pressure = m_config.max_memory_pressure > 0.0 && snapshot.pressure_available &&
+                          snapshot.memory_pressure.some_avg10 >= m_config.max_memory_pressure;
+    return snapshot.cpu_usage_percent < m_config.max_cpu_usage_percent &&
+           snapshot.memory_usage_percent < m_config.max_memory_usage_percent &&
+           !under_pressure;
 }
 
 bool ParallelStrategy::waitForResources(std::chrono::milliseconds timeout) {
-    auto start_time = std::chrono::steady_clock::now();
+    if (checkResourceAvailability()) {
+        return true;
+    }
     
-    while (!checkResourceAvailability()) {
-        auto elapsed = std::chrono::steady_clock::now() - start_time;
-        if (elapsed >= timeout) {
-            return false;
-        }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        
-        // Adaptive throttling - reduce concurrent executions if resources are constrained
-        if (m_config.enable_adaptive_throttling) {
-            if (m_current_cpu_usage > m_config.max_cpu_usage_percent * 0.9 ||
-                m_current_memory_usage > m_config.max_memory_usage_percent * 0.9) {
-                
-                size_t new_limit = std::max(size_t(1), 
-                    m_config.max_concurrent_executions * 3 / 4);
-                
-                Logger::getInstance().warn("ParallelStrategy", 
-                    "Throttling concurrent executions to " + std::to_string(new_limit));
-                
-                m_config.max_concurrent_executions = new_limit;
-            }
+    // Adaptive throttling - reduce concurrent executions if resources are constrained
+    if (m_config.enable_adaptive_throttling) {
+        if (m_current_cpu_usage > m_config.max_cpu_usage_percent * 0.9 ||
+            m_current_memory_usage > m_config.max_memory_usage_percent * 0.9) {
+            
+            size_t new_limit = std::max(size_t(1), 
+                m_config.max_concurrent_executions * 3 / 4);
+            
+            Logger::getInstance().warning("ParallelStrategy", 
+                "Throttling concurrent executions to " + std::to_string(new_limit));
+            
+            m_config.max_concurrent_executions = new_limit;
         }
     }
     
-    return true;
+    // Re-evaluated on every monitor sample and every finished subtask
+    return m_monitor->waitUntil([this](const SystemResourceSnapshot& snapshot) {
+        m_current_cpu_usage = snapshot.cpu_usage_percent;
+        m_current_memory_usage = snapshot.memory_usage_percent;
+        return admits(snapshot);
+    }, timeout);
+}
+
+void ParallelStrategy::waitForExecutionSlot(size_t limit) {
+    auto slot_free = [this, limit](const SystemResourceSnapshot&) {
+        return m_active_executions < limit;
+    };
+    // Woken by notifyWaiters() when a subtask finishes; the bounded wait
+    // only keeps each call's deadline arithmetic finite
+    while (!m_monitor->waitUntil(slot_free, std::chrono::seconds(1))) {
+    }
 }
 
 void ParallelStrategy::updateResourceUsage(size_t subtask_count) {
-    // Simple resource estimation - in real implementation would use system APIs
-    m_current_cpu_usage = std::min(100.0, 
-        20.0 + (subtask_count * 15.0)); // Base + per-task estimate
-    
-    m_current_memory_usage = std::min(100.0, 
-        30.0 + (subtask_count * 10.0)); // Base + per-task estimate
+    (void)subtask_count; // Measured from the system rather than estimated per task
+    auto snapshot = m_monitor->getSnapshot();
+    m_current_cpu_usage = snapshot.cpu_usage_percent;
+    m_current_memory_usage = snapshot.memory_usage_percent;
 }
 
 double ParallelStrategy::calculateAggregatedQuality(const std::string& aggregated_result,
@@ -897,8 +963,9 @@ void ParallelStrategy::resetStatistics() {
 
 ResourceUsage ParallelStrategy::getCurrentResourceUsage() const {
     ResourceUsage usage;
-    usage.cpu_usage_percent = m_current_cpu_usage.load();
-    usage.memory_usage_percent = m_current_memory_usage.load();
+    auto snapshot = m_monitor->getSnapshot();
+    usage.cpu_usage_percent = snapshot.cpu_usage_percent;
+    usage.memory_usage_percent = snapshot.memory_usage_percent;
     usage.active_threads = m_active_executions.load();
     usage.queued_tasks = m_thread_pool ? m_thread_pool->queueSize() : 0;
     usage.timestamp = std::chrono::system_clock::now();
@@ -923,8 +990,9 @@ void ParallelStrategy::shutdown() {
     m_shutdown_requested = true;
     
     // Wait for active executions to complete
-    while (m_active_executions > 0) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    while (!m_monitor->waitUntil([this](const SystemResourceSnapshot&) {
+        return m_active_executions == 0;
+    }, std::chrono::seconds(1))) {
     }
 }
 
@@ -957,13 +1025,6 @@ void ParallelStrategy::initializeDefaultAggregators() {
     m_config.aggregation_functions[AggregationMethod::WEIGHTED_COMBINE] = weightedCombineAggregator;
 }
 
-void ParallelStrategy::monitorResources() {
-    while (!m_shutdown_requested) {
-        updateResourceUsage(m_active_executions.load());
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-    }
-}
-
 std::vector<std::vector<ParallelSubtask>> ParallelStrategy::resolveDependencies(
     const std::vector<ParallelSubtask>& subtasks) {
     
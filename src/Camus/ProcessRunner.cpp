@@ -0,0 +1,505 @@
+// =================================================================
+// src/Camus/ProcessRunner.cpp
+// =================================================================
+// Implementation of the native process runner.
+
+#include "Camus/ProcessRunner.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <cstdio>
+#include <cerrno>
+#include <thread>
+
+#if defined(_WIN32)
+#define popen _popen
+#define pclose _pclose
+#else
+#include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern char** environ;
+#endif
+
+namespace Camus {
+
+// =================================================================
+// OutputRingBuffer
+// =================================================================
+
+OutputRingBuffer::OutputRingBuffer(size_t capacity) : m_capacity(capacity) {
+}
+
+void OutputRingBuffer::append(const char* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    if (m_capacity == 0) {
+        m_dropped += length;
+        return;
+    }
+
+    // A single chunk larger than the buffer replaces everything
+    if (length >= m_capacity) {
+        m_dropped += m_size + (length - m_capacity);
+        m_buffer.assign(data + (length - m_capacity), data + length);
+        m_start = 0;
+        m_size = m_capacity;
+        return;
+    }
+
+    // Grow lazily so short-lived commands don't pay for the full capacity
+    if (m_buffer.size() < m_capacity) {
+        size_t take = std::min(m_capacity - m_buffer.size(), length);
+        m_buffer.insert(m_buffer.end(), data, data + take);
+        m_size += take;
+        data += take;
+        length -= take;
+        if (length == 0) {
+            return;
+        }
+    }
+
+    // Buffer is at full size: write circularly over the oldest data
+    size_t write_pos = (m_start + m_size) % m_capacity;
+    size_t first = std::min(length, m_capacity - write_pos);
+    std::memcpy(m_buffer.data() + write_pos, data, first);
+    std::memcpy(m_buffer.data(), data + first, length - first);
+
+    size_t new_size = m_size + length;
+    if (new_size > m_capacity) {
+        size_t overflow = new_size - m_capacity;
+        m_start = (m_start + overflow) % m_capacity;
+        m_dropped += overflow;
+        m_size = m_capacity;
+    } else {
+        m_size = new_size;
+    }
+}
+
+std::string OutputRingBuffer::str() const {
+    std::string result;
+    if (m_size == 0) {
+        return result;
+    }
+    result.reserve(m_size);
+    size_t first = std::min(m_size, m_buffer.size() - m_start);
+    result.append(m_buffer.data() + m_start, first);
+    result.append(m_buffer.data(), m_size - first);
+    return result;
+}
+
+// =================================================================
+// ProcessRunner
+// =================================================================
+
+namespace {
+
+/**
+ * @brief Collects child output into the capture buffers and forwards it
+ */
+class OutputSink {
+public:
+    explicit OutputSink(const ProcessOptions& options)
+        : m_options(options),
+          m_combined(options.max_capture_bytes),
+          m_errors(options.max_capture_bytes) {}
+
+    void consume(OutputStream stream, const char* data, size_t length) {
+        m_total += length;
+        if (stream == OutputStream::STDOUT || m_options.merge_stderr) {
+            m_combined.append(data, length);
+        }
+        if (stream == OutputStream::STDERR) {
+            m_errors.append(data, length);
+        }
+
+        if (m_options.tee_output) {
+            std::ostream& out = (stream == OutputStream::STDERR) ? std::cerr : std::cout;
+            out.write(data, static_cast<std::streamsize>(length));
+            out.flush();
+        }
+
+        if (m_options.output_callback) {
+            m_options.output_callback(stream, data, length);
+        }
+    }
+
+    void finish(ProcessResult& result) const {
+        result.output = m_combined.str();
+        result.error_output = m_errors.str();
+        result.output_truncated = m_combined.wrapped();
+        result.total_output_bytes = m_total;
+    }
+
+private:
+    const ProcessOptions& m_options;
+    OutputRingBuffer m_combined;
+    OutputRingBuffer m_errors;
+    size_t m_total = 0;
+};
+
+#if !defined(_WIN32)
+
+void closeFd(int& fd) {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+void makePipe(int fds[2]) {
+    if (pipe(fds) != 0) {
+        throw std::runtime_error("Failed to create pipe: " + std::string(std::strerror(errno)));
+    }
+    // Neither end may leak into the child; dup2 in the spawn actions
+    // clears close-on-exec on the descriptors the child actually uses.
+    for (int i = 0; i < 2; ++i) {
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+}
+
+// waitForChild() results that are not wait statuses
+constexpr int WAIT_FAILED = -1;     // waitpid() failed; errno says why
+constexpr int STILL_RUNNING = -2;   // WNOHANG and the child has not exited
+
+int waitForChild(pid_t pid, int options) {
+    int status = 0;
+    while (true) {
+        pid_t rc = waitpid(pid, &status, options);
+        if (rc == pid) {
+            return status;
+        }
+        if (rc == 0) {
+            return STILL_RUNNING;
+        }
+        if (errno != EINTR) {
+            return WAIT_FAILED;
+        }
+    }
+}
+
+int terminateProcessGroup(pid_t pid, std::chrono::milliseconds grace_period) {
+    kill(-pid, SIGTERM);
+
+    auto deadline = std::chrono::steady_clock::now() + grace_period;
+    while (std::chrono::steady_clock::now() < deadline) {
+        int status = waitForChild(pid, WNOHANG);
+        if (status != STILL_RUNNING) {
+            int wait_errno = errno;
+            kill(-pid, SIGKILL);  // Reap stragglers left in the group
+            errno = wait_errno;
+            return status;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    kill(-pid, SIGKILL);
+    return waitForChild(pid, 0);
+}
+
+#endif
+
+} // anonymous namespace
+
+ProcessResult ProcessRunner::run(const std::string& command,
+                                 const std::vector<std::string>& args,
+                                 const ProcessOptions& options) {
+    auto start_time = std::chrono::steady_clock::now();
+    ProcessResult result;
+    OutputSink sink(options);
+    std::vector<char> buffer(std::max<size_t>(options.read_buffer_size, 4096));
+
+#if defined(_WIN32)
+    // No posix_spawn on Windows: fall back to a shell pipe with merged streams.
+    std::string full_command = command;
+    for (const auto& arg : args) {
+        if (arg.find(' ') != std::string::npos) {
+            full_command += " \"" + arg + "\"";
+        } else {
+            full_command += " " + arg;
+        }
+    }
+    full_command += " 2>&1";
+
+    FILE* pipe = popen(full_command.c_str(), "r");
+    if (!pipe) {
+        throw std::runtime_error("Failed to execute command: " + full_command);
+    }
+
+    size_t n = 0;
+    while ((n = fread(buffer.data(), 1, buffer.size(), pipe)) > 0) {
+        sink.consume(OutputStream::STDOUT, buffer.data(), n);
+    }
+    result.exit_code = pclose(pipe);
+#else
+    int out_pipe[2] = {-1, -1};
+    int err_pipe[2] = {-1, -1};
+    makePipe(out_pipe);
+    try {
+        makePipe(err_pipe);
+    } catch (...) {
+        closeFd(out_pipe[0]);
+        closeFd(out_pipe[1]);
+        throw;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, out_pipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, err_pipe[1], STDERR_FILENO);
+
+    // Put the child in its own process group so a timeout can kill
+    // everything it started, and give it default signal handling.
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t default_signals;
+    sigemptyset(&default_signals);
+    sigaddset(&default_signals, SIGPIPE);
+    sigset_t empty_mask;
+    sigemptyset(&empty_mask);
+    posix_spawnattr_setsigdefault(&attr, &default_signals);
+    posix_spawnattr_setsigmask(&attr, &empty_mask);
+    posix_spawnattr_setpgroup(&attr, 0);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK);
+
+    std::vector<char*> argv;
+    argv.reserve(args.size() + 2);
+    argv.push_back(const_cast<char*>(command.c_str()));
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = 0;
+    int spawn_rc = posix_spawnp(&pid, command.c_str(), &actions, &attr, argv.data(), environ);
+
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    closeFd(out_pipe[1]);
+    closeFd(err_pipe[1]);
+
+    if (spawn_rc != 0) {
+        closeFd(out_pipe[0]);
+        closeFd(err_pipe[0]);
+        throw std::runtime_error("Failed to execute command: " + command +
+                                 " (" + std::strerror(spawn_rc) + ")");
+    }
+
+    pollfd fds[2] = {
+        {out_pipe[0], POLLIN, 0},
+        {err_pipe[0], POLLIN, 0}
+    };
+    const OutputStream streams[2] = {OutputStream::STDOUT, OutputStream::STDERR};
+    int open_fds = 2;
+    auto deadline = start_time + options.timeout;
+
+    while (open_fds > 0) {
+        int wait_ms = -1;
+        if (options.timeout.count() > 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                result.timed_out = true;
+                break;
+            }
+            wait_ms = static_cast<int>(std::min<long long>(remaining.count() + 1, 60000));
+        }
+
+        int ready = poll(fds, 2, wait_ms);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (ready == 0) {
+            continue;  // Loop re-checks the deadline
+        }
+
+        // One read per ready stream per wakeup keeps a chatty stream
+        // from starving the other.
+        for (int i = 0; i < 2; ++i) {
+            if (fds[i].fd < 0 || (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0) {
+                continue;
+            }
+            ssize_t n = read(fds[i].fd, buffer.data(), buffer.size());
+            if (n > 0) {
+                sink.consume(streams[i], buffer.data(), static_cast<size_t>(n));
+            } else if (n == 0 || (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                closeFd(fds[i].fd);
+                open_fds--;
+            }
+        }
+    }
+
+    closeFd(fds[0].fd);
+    closeFd(fds[1].fd);
+
+    // The child may close its pipes and keep running, so the deadline
+    // still applies while waiting for it to exit.
+    int status = STILL_RUNNING;
+    if (!result.timed_out) {
+        if (options.timeout.count() > 0) {
+            while ((status = waitForChild(pid, WNOHANG)) == STILL_RUNNING) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    result.timed_out = true;
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        } else {
+            status = waitForChild(pid, 0);
+        }
+    }
+    if (result.timed_out) {
+        status = terminateProcessGroup(pid, options.kill_grace_period);
+    }
+
+    if (status == WAIT_FAILED) {
+        // The exit status is lost (e.g. SIGCHLD is ignored); never report success
+        std::cerr << "[WARN] Could not get the exit status of " << command << ": "
+                  << std::strerror(errno) << std::endl;
+        result.exit_code = -1;
+    } else if (WIFEXITED(status)) {
+        result.exit_code = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        result.exit_code = -1;
+        result.term_signal = WTERMSIG(status);
+    }
+#endif
+
+    sink.finish(result);
+    result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    return result;
+}
+
+// Unwrap a YAML-style quoted scalar such as 'cmake --build ./build'
+static std::string unwrapQuotedLine(const std::string& command_line) {
+    std::string line = command_line;
+    size_t first = line.find_first_not_of(" \t");
+    size_t last = line.find_last_not_of(" \t");
+    if (first != std::string::npos && last > first &&
+        (line[first] == '\'' || line[first] == '"') && line[last] == line[first] &&
+        line.find(line[first], first + 1) == last) {
+        line = line.substr(first + 1, last - first - 1);
+    }
+    return line;
+}
+
+std::vector<std::string> ProcessRunner::splitCommandLine(const std::string& command_line) {
+    std::vector<std::string> parts;
+    std::string current_part;
+    bool has_part = false;
+    char quote = '\0';
+
+    std::string line = unwrapQuotedLine(command_line);
+
+    for (char c : line) {
+        if (quote != '\0') {
+            if (c == quote) {
+                quote = '\0';
+            } else {
+                current_part += c;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+            has_part = true;
+        } else if (c == ' ' || c == '\t') {
+            if (has_part) {
+                parts.push_back(current_part);
+                current_part.clear();
+                has_part = false;
+            }
+        } else {
+            current_part += c;
+            has_part = true;
+        }
+    }
+    if (has_part) {
+        parts.push_back(current_part);
+    }
+
+    return parts;
+}
+
+bool ProcessRunner::needsShell(const std::string& command_line) {
+    std::string line = unwrapQuotedLine(command_line);
+    char quote = '\0';
+    bool word_start = true;
+    bool first_word = true;
+    std::string word;
+
+    for (char c : line) {
+        if (quote == '\'') {
+            if (c == quote) quote = '\0';
+            continue;
+        }
+        if (quote == '"') {
+            // Double quotes still expand variables and substitutions
+            if (c == '$' || c == '`' || c == '\\') return true;
+            if (c == quote) quote = '\0';
+            continue;
+        }
+        if (c == '\'' || c == '"') {
+            quote = c;
+            word_start = false;
+            continue;
+        }
+        if (c == ' ' || c == '\t') {
+            if (!word_start) first_word = false;
+            word_start = true;
+            continue;
+        }
+        if (c != '\0' && std::strchr("|&;<>()$`\\*?[\n", c) != nullptr) {
+            return true;
+        }
+        if (word_start && (c == '~' || c == '#')) {
+            return true;
+        }
+        // VAR=value before the command sets the environment
+        if (c == '=' && first_word && !word.empty() &&
+            !std::isdigit(static_cast<unsigned char>(word[0]))) {
+            return true;
+        }
+        if (first_word) {
+            if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+                word += c;
+            } else {
+                first_word = false;
+            }
+        }
+        word_start = false;
+    }
+    return false;
+}
+
+std::vector<std::string> ProcessRunner::commandArgv(const std::string& command_line,
+                                                    const std::vector<std::string>& extra_args) {
+    std::vector<std::string> argv;
+    if (!needsShell(command_line)) {
+        argv = splitCommandLine(command_line);
+        if (!argv.empty()) {
+            argv.insert(argv.end(), extra_args.begin(), extra_args.end());
+        }
+        return argv;
+    }
+
+    std::string script = unwrapQuotedLine(command_line);
+    argv = {"/bin/sh", "-c", script};
+    if (!extra_args.empty()) {
+        // "$@" expands to the extra arguments, each quoted; "camus" is $0
+        argv[2] += " \"$@\"";
+        argv.push_back("camus");
+        argv.insert(argv.end(), extra_args.begin(), extra_args.end());
+    }
+    return argv;
+}
+
+} // namespace Camus
@@ -26,7 +26,18 @@ std::vector<std::string> ProjectScanner::scanFiles() {
     
     try {
         // Use recursive directory iterator to walk the file tree
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(m_root_path)) {
+        std::filesystem::recursive_directory_iterator end;
+        for (auto it = std::filesystem::recursive_directory_iterator(m_root_path); it != end; ++it) {
+            const auto& entry = *it;
+            
+            // Directory patterns such as ".camus/" only match the directory
+            // itself, so prune ignored directories instead of testing their files
+            if (entry.is_directory()) {
+                if (m_ignore_patterns.shouldIgnore(getRelativePath(entry.path()), true)) {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
             if (!entry.is_regular_file()) {
                 continue;
             }
@@ -34,8 +45,7 @@ std::vector<std::string> ProjectScanner::scanFiles() {
             std::string relative_path = getRelativePath(entry.path());
             
             // Apply ignore patterns
-            bool is_directory = entry.is_directory();
-            if (m_ignore_patterns.shouldIgnore(relative_path, is_directory)) {
+            if (m_ignore_patterns.shouldIgnore(relative_path, false)) {
                 continue;
             }
             
@@ -70,6 +80,37 @@ std::vector<std::string> ProjectScanner::scanFiles() {
     return discovered_files;
 }
 
+ScanDelta ProjectScanner::scanChanges(const std::unordered_map<std::string, FileStamp>& known) {
+    ScanDelta delta;
+    delta.files = scanFiles();
+    
+    for (const auto& relative_path : delta.files) {
+        std::filesystem::path path = std::filesystem::path(m_root_path) / relative_path;
+        std::error_code ec;
+        FileStamp stamp;
+        stamp.size = std::filesystem::file_size(path, ec);
+        auto modified = std::filesystem::last_write_time(path, ec);
+        if (!ec) {
+            stamp.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+        }
+        
+        auto it = known.find(relative_path);
+        if (it == known.end() || it->second != stamp) {
+            delta.changed.push_back(relative_path);
+        }
+        delta.stamps.emplace(relative_path, stamp);
+    }
+    
+    for (const auto& entry : known) {
+        if (delta.stamps.find(entry.first) == delta.stamps.end()) {
+            delta.removed.push_back(entry.first);
+        }
+    }
+    std::sort(delta.removed.begin(), delta.removed.end());
+    
+    return delta;
+}
+
 void ProjectScanner::addIgnorePattern(const std::string& pattern) {
     m_ignore_patterns.addPattern(pattern);
 }
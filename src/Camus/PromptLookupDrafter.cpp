@@ -0,0 +1,75 @@
+// =================================================================
+// src/Camus/PromptLookupDrafter.cpp
+// =================================================================
+// Implementation of prompt-lookup draft proposals.
+
+#include "Camus/PromptLookupDrafter.hpp"
+#include <algorithm>
+
+namespace Camus {
+
+PromptLookupDrafter::PromptLookupDrafter(const std::vector<int32_t>& source, const PromptLookupConfig& config)
+    : m_source(source), m_config(config) {
+    m_config.min_ngram = std::max<size_t>(1, m_config.min_ngram);
+    m_config.max_ngram = std::max(m_config.min_ngram, m_config.max_ngram);
+}
+
+std::vector<int32_t> PromptLookupDrafter::propose(const std::vector<int32_t>& history, size_t max_tokens) {
+    m_draft_length = 0;
+    max_tokens = std::min(max_tokens, m_config.max_draft);
+    if (!m_config.enabled || max_tokens == 0 || history.size() < m_config.min_ngram || m_source.size() < 2) {
+        return {};
+    }
+
+    // Follow the run the previous draft came from. The model has usually
+    // sampled one more token since, which the source must also agree with.
+    size_t start = 0;
+    for (size_t end : {m_continue_at + 1, m_continue_at}) {
+        if (m_continue_at > 0 && end < m_source.size() && suffixMatches(history, end, m_config.min_ngram)) {
+            start = end;
+            break;
+        }
+    }
+
+    // Otherwise the most recent occurrence of the longest suffix. The final
+    // source position is skipped: nothing follows it to propose.
+    for (size_t n = std::min(m_config.max_ngram, history.size()); start == 0 && n >= m_config.min_ngram; --n) {
+        for (size_t end = m_source.size() - 1; end >= n; --end) {
+            if (suffixMatches(history, end, n)) {
+                start = end;
+                break;
+            }
+        }
+    }
+    if (start == 0) {
+        m_continue_at = 0;
+        return {};
+    }
+
+    size_t length = std::min(max_tokens, m_source.size() - start);
+    m_draft_start = start;
+    m_draft_length = length;
+    m_stats.draft_rounds++;
+    m_stats.drafted_tokens += length;
+    return std::vector<int32_t>(m_source.begin() + static_cast<std::ptrdiff_t>(start),
+                                m_source.begin() + static_cast<std::ptrdiff_t>(start + length));
+}
+
+void PromptLookupDrafter::accept(size_t accepted) {
+    accepted = std::min(accepted, m_draft_length);
+    m_stats.accepted_tokens += accepted;
+    // A fully accepted draft is most likely followed by more of the same
+    // source text; after a rejection the output has diverged from it
+    m_continue_at = accepted == m_draft_length && m_draft_length > 0 ? m_draft_start + accepted : 0;
+    m_draft_length = 0;
+}
+
+bool PromptLookupDrafter::suffixMatches(const std::vector<int32_t>& history, size_t end, size_t n) const {
+    if (n == 0 || n > end || n > history.size() || end > m_source.size()) {
+        return false;
+    }
+    return std::equal(history.end() - static_cast<std::ptrdiff_t>(n), history.end(),
+                      m_source.begin() + static_cast<std::ptrdiff_t>(end - n));
+}
+
+} // namespace Camus
@@ -0,0 +1,15 @@
+// =================================================================
+// src/Camus/RequestArena.cpp
+// =================================================================
+// Implementation of the per-request monotonic arena.
+
+#include "Camus/RequestArena.hpp"
+
+namespace Camus {
+
+RequestArena::RequestArena(size_t initial_size)
+    : m_initial_size(initial_size > 0 ? initial_size : DEFAULT_INITIAL_SIZE),
+      m_resource(m_initial_size, std::pmr::new_delete_resource()) {
+}
+
+} // namespace Camus
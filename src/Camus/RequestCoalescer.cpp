@@ -0,0 +1,161 @@
+// =================================================================
+// src/Camus/RequestCoalescer.cpp
+// =================================================================
+// Implementation of single-flight request coalescing.
+
+#include "Camus/RequestCoalescer.hpp"
+#include "Camus/Logger.hpp"
+#include <sstream>
+#include <iomanip>
+
+namespace Camus {
+
+RequestCoalescer& RequestCoalescer::getInstance() {
+    static RequestCoalescer instance;
+    return instance;
+}
+
+bool RequestCoalescer::isDeterministic(const InferenceRequest& request) {
+    return request.temperature <= 0.0;
+}
+
+std::string RequestCoalescer::makeKey(const std::string& model_id, const InferenceRequest& request) {
+    // The prompt is hashed here and compared in full on a hit
+    std::ostringstream key;
+    key << model_id << '|' << std::hex << std::hash<std::string>{}(request.prompt) << std::dec
+        << '|' << request.max_tokens
+        << '|' << std::fixed << std::setprecision(3) << request.temperature << '|' << request.top_p
+        << '|' << static_cast<int>(request.constraint);
+    for (const auto& stop : request.stop_sequences) {
+        key << '|' << std::hash<std::string>{}(stop);
+    }
+    // Conversation state is compared in full on a hit, like the prompt
+    if (!request.context_tokens.empty()) {
+        size_t context_hash = request.context_tokens.size();
+        for (int64_t token : request.context_tokens) {
+            context_hash = context_hash * 1000003u ^ std::hash<int64_t>{}(token);
+        }
+        key << "|c" << std::hex << context_hash;
+    }
+    return key.str();
+}
+
+InferenceResponse RequestCoalescer::execute(const std::string& model_id, LlmInteraction& model,
+                                            const InferenceRequest& request) {
+    return execute(model_id, request, [&model](const InferenceRequest& call) {
+        return model.getCompletionWithMetadata(call);
+    });
+}
+
+InferenceResponse RequestCoalescer::execute(const std::string& model_id, const InferenceRequest& request,
+                                            const BackendCall& backend) {
+    if (!isDeterministic(request)) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.bypassed++;
+        }
+        return backend(request);
+    }
+
+    const std::string key = makeKey(model_id, request);
+    std::shared_ptr<Flight> flight;
+    bool leader = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_flights.find(key);
+        if (it == m_flights.end()) {
+            flight = std::make_shared<Flight>();
+            flight->prompt = request.prompt;
+            flight->context_tokens = request.context_tokens;
+            m_flights.emplace(key, flight);
+            leader = true;
+            m_stats.executed++;
+        } else if (it->second->prompt == request.prompt &&
+                   it->second->context_tokens == request.context_tokens) {
+            flight = it->second;
+            m_stats.coalesced++;
+        } else {
+            m_stats.executed++;  // Hash collision: run independently
+        }
+    }
+
+    if (!flight) {
+        return backend(request);
+    }
+    if (!leader) {
+        Logger::getInstance().debug("RequestCoalescer", "Attached to in-flight generation on " + model_id);
+        return follow(*flight, request);
+    }
+
+    // Leader: run once and fan the output out to everyone attached
+    if (request.on_token) {
+        std::lock_guard<std::mutex> lock(flight->mutex);
+        flight->subscribers.push_back(request.on_token);
+    }
+    InferenceRequest shared = request;
+    Flight* raw_flight = flight.get();
+    shared.on_token = [raw_flight](const std::string& piece) {
+        std::lock_guard<std::mutex> lock(raw_flight->mutex);
+        raw_flight->text += piece;
+        for (const auto& subscriber : raw_flight->subscribers) {
+            subscriber(piece);
+        }
+    };
+
+    InferenceResponse response;
+    std::exception_ptr error;
+    try {
+        response = backend(shared);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // Later identical requests start a new generation (or hit the response cache)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_flights.erase(key);
+    }
+    {
+        std::lock_guard<std::mutex> lock(flight->mutex);
+        flight->response = response;
+        flight->error = error;
+        flight->done = true;
+    }
+    flight->cv.notify_all();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return response;
+}
+
+InferenceResponse RequestCoalescer::follow(Flight& flight, const InferenceRequest& request) {
+    std::unique_lock<std::mutex> lock(flight.mutex);
+    if (request.on_token) {
+        // Catch up on what the leader already produced, then stream live
+        if (!flight.text.empty()) {
+            request.on_token(flight.text);
+        }
+        flight.subscribers.push_back(request.on_token);
+    }
+    flight.cv.wait(lock, [&flight]() { return flight.done; });
+
+    if (flight.error) {
+        std::rethrow_exception(flight.error);
+    }
+    InferenceResponse response = flight.response;
+    response.metadata["coalesced"] = "true";
+    return response;
+}
+
+size_t RequestCoalescer::getInFlightCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_flights.size();
+}
+
+CoalescingStats RequestCoalescer::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+} // namespace Camus
@@ -0,0 +1,323 @@
+// =================================================================
+// src/Camus/ResourceMonitor.cpp
+// =================================================================
+// Implementation of the /proc, cgroup v2 and PSI resource monitor.
+
+#include "Camus/ResourceMonitor.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+
+namespace Camus {
+
+namespace {
+
+// Reads a small pseudo-file with a single read(); procfs and cgroupfs
+// files are generated on read, so this avoids any stream machinery
+bool readSmallFile(const std::string& path, std::string& out) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    char buffer[4096];
+    ssize_t n = ::read(fd, buffer, sizeof(buffer) - 1);
+    ::close(fd);
+    if (n <= 0) {
+        return false;
+    }
+    out.assign(buffer, static_cast<size_t>(n));
+    return true;
+}
+
+// Value following "key" at the start of a line, e.g. "usage_usec 123"
+bool findKeyValue(const std::string& text, const char* key, uint64_t& value) {
+    size_t key_len = std::strlen(key);
+    size_t pos = 0;
+    while (pos < text.size()) {
+        if (text.compare(pos, key_len, key) == 0 &&
+            pos + key_len < text.size() &&
+            (text[pos + key_len] == ' ' || text[pos + key_len] == ':' || text[pos + key_len] == '\t')) {
+            const char* start = text.c_str() + pos + key_len + 1;
+            while (*start == ' ' || *start == '\t') {
+                start++;
+            }
+            value = std::strtoull(start, nullptr, 10);
+            return true;
+        }
+        size_t next = text.find('\n', pos);
+        if (next == std::string::npos) {
+            break;
+        }
+        pos = next + 1;
+    }
+    return false;
+}
+
+// Parses "some avg10=1.23 ..." / "full avg10=..." lines of a PSI file
+bool parsePressure(const std::string& text, PressureStall& stall) {
+    bool found = false;
+    for (const char* kind : {"some", "full"}) {
+        size_t line = text.find(kind);
+        if (line == std::string::npos) {
+            continue;
+        }
+        size_t avg = text.find("avg10=", line);
+        if (avg == std::string::npos) {
+            continue;
+        }
+        double value = std::strtod(text.c_str() + avg + 6, nullptr);
+        if (kind[0] == 's') {
+            stall.some_avg10 = value;
+        } else {
+            stall.full_avg10 = value;
+        }
+        found = true;
+    }
+    return found;
+}
+
+double onlineCpus() {
+    unsigned int cpus = std::thread::hardware_concurrency();
+    return cpus > 0 ? static_cast<double>(cpus) : 1.0;
+}
+
+} // anonymous namespace
+
+ResourceMonitor::ResourceMonitor(const ResourceMonitorConfig& config)
+    : m_config(config) {
+    m_cgroup_dir = resolveCgroupDir();
+}
+
+ResourceMonitor::~ResourceMonitor() {
+    stop();
+}
+
+ResourceMonitor& ResourceMonitor::getInstance() {
+    static ResourceMonitor instance;
+    static std::once_flag started;
+    std::call_once(started, [] { instance.start(); });
+    return instance;
+}
+
+void ResourceMonitor::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    sample();
+    m_sampler = std::thread(&ResourceMonitor::samplerLoop, this);
+}
+
+void ResourceMonitor::stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sampler_mutex);
+    }
+    m_sampler_cv.notify_all();
+    if (m_sampler.joinable()) {
+        m_sampler.join();
+    }
+    notifyWaiters();
+}
+
+void ResourceMonitor::samplerLoop() {
+    while (m_running.load()) {
+        {
+            std::unique_lock<std::mutex> lock(m_sampler_mutex);
+            m_sampler_cv.wait_for(lock, m_config.sample_interval, [this] { return !m_running.load(); });
+        }
+        if (!m_running.load()) {
+            break;
+        }
+        sample();
+    }
+}
+
+SystemResourceSnapshot ResourceMonitor::sample() {
+    std::lock_guard<std::mutex> sample_lock(m_sample_mutex);
+    SystemResourceSnapshot snapshot;
+    auto now = std::chrono::steady_clock::now();
+    snapshot.timestamp = now;
+
+    readCpu(snapshot, now);
+    readMemory(snapshot);
+    readPressure(snapshot);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_snapshot = snapshot;
+    }
+    m_changed.notify_all();
+    return snapshot;
+}
+
+SystemResourceSnapshot ResourceMonitor::getSnapshot() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_snapshot;
+}
+
+bool ResourceMonitor::waitUntil(const AdmissionPredicate& admit, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_changed.wait_for(lock, timeout, [this, &admit] { return admit(m_snapshot); });
+}
+
+void ResourceMonitor::notifyWaiters() {
+    {
+        // Taking the lock orders the caller's state change before any
+        // waiter's next predicate check, so the wakeup cannot be lost
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_changed.notify_all();
+}
+
+std::string ResourceMonitor::resolveCgroupDir() const {
+    std::string relative = m_config.cgroup_path;
+    if (relative.empty()) {
+        std::string self;
+        if (!readSmallFile(m_config.proc_root + "/self/cgroup", self)) {
+            return "";
+        }
+        // cgroup v2 entries have the form "0::/path"
+        std::istringstream lines(self);
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (line.compare(0, 3, "0::") == 0) {
+                relative = line.substr(3);
+                break;
+            }
+        }
+        if (relative.empty()) {
+            return "";
+        }
+    }
+
+    std::string dir = m_config.cgroup_root + (relative == "/" ? "" : relative);
+    std::error_code ec;
+    if (!std::filesystem::is_directory(dir, ec)) {
+        return "";
+    }
+    return dir;
+}
+
+void ResourceMonitor::readCpu(SystemResourceSnapshot& snapshot, std::chrono::steady_clock::time_point now) {
+    std::string text;
+    snapshot.cpu_limit_cores = onlineCpus();
+
+    // A cgroup CPU quota caps what we may use; measure our own usage against it
+    double quota_cores = 0.0;
+    if (!m_cgroup_dir.empty() && readSmallFile(m_cgroup_dir + "/cpu.max", text) &&
+        text.compare(0, 3, "max") != 0) {
+        char* end = nullptr;
+        double quota = std::strtod(text.c_str(), &end);
+        double period = std::strtod(end, nullptr);
+        if (quota > 0 && period > 0) {
+            quota_cores = quota / period;
+        }
+    }
+
+    uint64_t usage_usec = 0;
+    if (quota_cores > 0.0 && readSmallFile(m_cgroup_dir + "/cpu.stat", text) &&
+        findKeyValue(text, "usage_usec", usage_usec)) {
+        snapshot.cpu_limit_cores = quota_cores;
+        snapshot.cgroup_limited = true;
+        if (m_has_prev_sample && usage_usec >= m_prev_cgroup_usage_usec) {
+            double elapsed_usec = std::chrono::duration<double, std::micro>(now - m_prev_sample_time).count();
+            if (elapsed_usec > 0) {
+                double used = static_cast<double>(usage_usec - m_prev_cgroup_usage_usec);
+                snapshot.cpu_usage_percent = std::min(100.0, 100.0 * used / (elapsed_usec * quota_cores));
+            }
+        }
+        m_prev_cgroup_usage_usec = usage_usec;
+    } else if (readSmallFile(m_config.proc_root + "/stat", text) && text.compare(0, 4, "cpu ") == 0) {
+        // cpu  user nice system idle iowait irq softirq steal (guest is included in user)
+        const char* cursor = text.c_str() + 4;
+        uint64_t fields[8] = {0};
+        for (uint64_t& field : fields) {
+            char* end = nullptr;
+            field = std::strtoull(cursor, &end, 10);
+            cursor = end;
+        }
+        uint64_t total = 0;
+        for (uint64_t field : fields) {
+            total += field;
+        }
+        uint64_t busy = total - fields[3] - fields[4];
+        if (m_has_prev_sample && total > m_prev_cpu_total) {
+            double delta_busy = static_cast<double>(busy - std::min(busy, m_prev_cpu_busy));
+            double delta_total = static_cast<double>(total - m_prev_cpu_total);
+            snapshot.cpu_usage_percent = std::min(100.0, 100.0 * delta_busy / delta_total);
+        }
+        m_prev_cpu_busy = busy;
+        m_prev_cpu_total = total;
+    }
+
+    m_prev_sample_time = now;
+    m_has_prev_sample = true;
+}
+
+void ResourceMonitor::readMemory(SystemResourceSnapshot& snapshot) const {
+    std::string text;
+
+    // cgroup memory.max, when set, is the limit that gets us OOM-killed
+    if (!m_cgroup_dir.empty() && readSmallFile(m_cgroup_dir + "/memory.max", text) &&
+        text.compare(0, 3, "max") != 0) {
+        uint64_t limit = std::strtoull(text.c_str(), nullptr, 10);
+        std::string current;
+        if (limit > 0 && readSmallFile(m_cgroup_dir + "/memory.current", current)) {
+            uint64_t used = std::strtoull(current.c_str(), nullptr, 10);
+            // Reclaimable page cache is not pressure; report the working set
+            std::string stat;
+            uint64_t inactive_file = 0;
+            if (readSmallFile(m_cgroup_dir + "/memory.stat", stat) &&
+                findKeyValue(stat, "inactive_file", inactive_file)) {
+                used -= std::min(used, inactive_file);
+            }
+            snapshot.memory_used_bytes = used;
+            snapshot.memory_limit_bytes = limit;
+            snapshot.memory_usage_percent = std::min(100.0, 100.0 * used / limit);
+            snapshot.cgroup_limited = true;
+            return;
+        }
+    }
+
+    uint64_t total_kb = 0;
+    uint64_t available_kb = 0;
+    if (readSmallFile(m_config.proc_root + "/meminfo", text) &&
+        findKeyValue(text, "MemTotal", total_kb) && total_kb > 0 &&
+        findKeyValue(text, "MemAvailable", available_kb)) {
+        uint64_t used_kb = total_kb - std::min(total_kb, available_kb);
+        snapshot.memory_used_bytes = used_kb * 1024;
+        snapshot.memory_limit_bytes = total_kb * 1024;
+        snapshot.memory_usage_percent = 100.0 * used_kb / total_kb;
+    }
+}
+
+void ResourceMonitor::readPressure(SystemResourceSnapshot& snapshot) const {
+    struct Source {
+        const char* name;
+        PressureStall* target;
+    };
+    const Source sources[] = {
+        {"cpu", &snapshot.cpu_pressure},
+        {"memory", &snapshot.memory_pressure},
+        {"io", &snapshot.io_pressure}
+    };
+
+    std::string text;
+    for (const auto& source : sources) {
+        // Host-wide PSI first; fall back to our cgroup's view
+        if ((readSmallFile(m_config.proc_root + "/pressure/" + source.name, text) ||
+             (!m_cgroup_dir.empty() &&
+              readSmallFile(m_cgroup_dir + "/" + source.name + ".pressure", text))) &&
+            parsePressure(text, *source.target)) {
+            snapshot.pressure_available = true;
+        }
+    }
+}
+
+} // namespace Camus
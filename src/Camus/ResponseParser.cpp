@@ -4,6 +4,8 @@
 // Implementation for parsing structured LLM responses into file modifications.
 
 #include "Camus/ResponseParser.hpp"
+#include "Camus/FileBlockFormat.hpp"
+#include "Camus/EditApplier.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -18,7 +20,8 @@ ResponseParser::ResponseParser(const std::string& project_root)
     : m_project_root(std::filesystem::absolute(project_root).string()),
       m_allow_new_files(true),
       m_max_file_size(1024 * 1024), // 1MB default
-      m_strict_validation(true) {
+      m_strict_validation(true),
+      m_constrained_format(false) {
     initializeDefaultExtensions();
 }
 
@@ -28,15 +31,28 @@ std::vector<FileModification> ResponseParser::parseResponse(const std::string& l
     
     std::cout << "[INFO] Parsing LLM response for file modifications..." << std::endl;
     
+    // Declining to change anything is a valid answer, not a format error
+    if (FileBlockFormat::isNoChanges(llm_response)) {
+        return {};
+    }
+    
+    // A constrained response is well formed by construction
+    size_t first_line_end = llm_response.find('\n');
+    bool constrained = m_constrained_format && first_line_end != std::string::npos &&
+                       FileBlockFormat::parseMarker(llm_response.substr(0, first_line_end), nullptr);
+    
     // Validate response format first
-    if (!validateResponseFormat(llm_response)) {
+    if (!constrained && !validateResponseFormat(llm_response)) {
         addError("Invalid response format - no valid file markers found");
         return {};
     }
     
-    // Extract file blocks from response
-    auto file_blocks = extractFileBlocks(llm_response);
-    m_last_stats.total_files_found = file_blocks.size();
+    // Extract file blocks from response; EDIT blocks become full content
+    std::unordered_map<std::string, std::string> edit_blocks;
+    auto file_blocks = constrained ? extractConstrainedBlocks(llm_response)
+                                   : extractFileBlocks(llm_response, &edit_blocks);
+    m_last_stats.total_files_found = file_blocks.size() + edit_blocks.size();
+    applyEditBlocks(edit_blocks, file_blocks);
     
     std::vector<FileModification> modifications;
     modifications.reserve(file_blocks.size());
@@ -53,6 +69,9 @@ std::vector<FileModification> ResponseParser::parseResponse(const std::string& l
             
             // Clean and validate content
             std::string cleaned_content = cleanFileContent(content);
+            if (m_minified_sources.count(normalized_path) && !restoreMinified(normalized_path, cleaned_content)) {
+                continue;
+            }
             
             if (!isValidFileContent(cleaned_content, normalized_path)) {
                 addError("Invalid content for file: " + normalized_path);
@@ -153,22 +172,32 @@ void ResponseParser::setAllowedExtensions(const std::unordered_set<std::string>&
     m_allowed_extensions = extensions;
 }
 
+void ResponseParser::setConstrainedFormat(bool constrained) {
+    m_constrained_format = constrained;
+}
+
+void ResponseParser::setMinifiedSources(const std::unordered_map<std::string, MinifiedSource>& sources) {
+    m_minified_sources = sources;
+}
+
 void ResponseParser::setStrictValidation(bool strict_validation) {
     m_strict_validation = strict_validation;
 }
 
-std::unordered_map<std::string, std::string> ResponseParser::extractFileBlocks(const std::string& response) {
+std::unordered_map<std::string, std::string> ResponseParser::extractFileBlocks(
+    const std::string& response, std::unordered_map<std::string, std::string>* edit_blocks) {
     std::unordered_map<std::string, std::string> file_blocks;
     
-    // Regex to match file markers: --- FILE: path ---
-    std::regex file_marker_regex(R"(^---\s*FILE:\s*(.+?)\s*---\s*$)", std::regex_constants::multiline);
+    // Regex to match file markers: --- FILE: path --- or --- EDIT: path ---
+    std::regex file_marker_regex(R"(^---\s*(FILE|EDIT):\s*(.+?)\s*---\s*$)", std::regex_constants::multiline);
     
     std::sregex_iterator iter(response.begin(), response.end(), file_marker_regex);
     std::sregex_iterator end;
     
     while (iter != end) {
         std::smatch match = *iter;
-        std::string file_path = match[1].str();
+        bool is_edit = match[1].str() == "EDIT";
+        std::string file_path = match[2].str();
         
         // Find the start of content (after the marker line)
         size_t content_start = match.suffix().first - response.begin();
@@ -194,7 +223,11 @@ std::unordered_map<std::string, std::string> ResponseParser::extractFileBlocks(c
                 content = content.substr(0, last_marker);
             }
             
-            file_blocks[file_path] = content;
+            if (!is_edit) {
+                file_blocks[file_path] = content;
+            } else if (edit_blocks) {
+                (*edit_blocks)[file_path] = content;
+            }
         }
         
         ++iter;
@@ -434,6 +467,111 @@ void ResponseParser::initializeDefaultExtensions() {
     };
 }
 
+void ResponseParser::applyEditBlocks(const std::unordered_map<std::string, std::string>& edit_blocks,
+                                     std::unordered_map<std::string, std::string>& file_blocks) {
+    EditApplier applier;
+    for (const auto& [raw_path, body] : edit_blocks) {
+        if (file_blocks.count(raw_path)) {
+            addError("File has both FILE and EDIT blocks: " + raw_path);
+            continue;
+        }
+        
+        std::string normalized_path = normalizeFilePath(raw_path);
+        if (!isValidFilePath(normalized_path)) {
+            addError("Invalid file path: " + raw_path);
+            continue;
+        }
+        
+        auto hunks = EditApplier::parseHunks(body);
+        if (hunks.empty()) {
+            addError("No search/replace or diff hunks for: " + normalized_path);
+            continue;
+        }
+        
+        // A missing file can only be created by hunks with an empty search;
+        // a minified file is edited as the model saw it and restored later
+        std::string original;
+        auto minified = m_minified_sources.find(normalized_path);
+        if (minified != m_minified_sources.end()) {
+            original = minified->second.content;
+        } else if (fileExists(normalized_path)) {
+            original = readProjectFile(normalized_path);
+        }
+        
+        EditApplyResult result = applier.apply(original, hunks);
+        if (!result.success) {
+            for (const auto& error : result.errors) {
+                addError("Edit to " + normalized_path + " not applied: " + error);
+            }
+            continue;
+        }
+        
+        m_last_stats.edit_blocks_applied++;
+        m_last_stats.fuzzy_hunks += result.fuzzy_matches;
+        file_blocks[raw_path] = std::move(result.content);
+    }
+}
+
+bool ResponseParser::restoreMinified(const std::string& file_path, std::string& content) {
+    const MinifiedSource& minified = m_minified_sources.at(file_path);
+    std::string original = readProjectFile(file_path);
+    
+    // The line map is only valid for the content that was minified
+    if (SourceMinifier::minify(file_path, original).content != minified.content) {
+        addError("File changed since it was sent to the model: " + file_path);
+        m_last_stats.changed_since_sent.push_back(file_path);
+        return false;
+    }
+    
+    content = SourceMinifier::restore(original, minified, content);
+    m_last_stats.minified_restored++;
+    return true;
+}
+
+std::string ResponseParser::readProjectFile(const std::string& file_path) const {
+    std::ifstream file(std::filesystem::path(m_project_root) / file_path, std::ios::binary);
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+std::unordered_map<std::string, std::string> ResponseParser::extractConstrainedBlocks(
+    const std::string& response) const {
+    std::unordered_map<std::string, std::string> file_blocks;
+    std::string current_path;
+    size_t content_start = 0;
+    bool in_block = false;
+    
+    size_t line_start = 0;
+    std::string line;
+    std::string path;
+    while (line_start < response.size()) {
+        size_t line_end = response.find('\n', line_start);
+        if (line_end == std::string::npos) {
+            line_end = response.size();
+        }
+        
+        // Only lines starting with '-' can be markers
+        if (response[line_start] == '-') {
+            line.assign(response, line_start, line_end - line_start);
+            if (FileBlockFormat::parseMarker(line, &path)) {
+                if (in_block) {
+                    file_blocks[current_path] = response.substr(content_start, line_start - content_start);
+                }
+                current_path = path;
+                content_start = std::min(line_end + 1, response.size());
+                in_block = true;
+            }
+        }
+        line_start = line_end + 1;
+    }
+    if (in_block) {
+        file_blocks[current_path] = response.substr(content_start);
+    }
+    
+    return file_blocks;
+}
+
 bool ResponseParser::validateResponseFormat(const std::string& llm_response) const {
     // Check for minimum response length
     if (llm_response.length() < 20) {
@@ -441,7 +579,7 @@ bool ResponseParser::validateResponseFormat(const std::string& llm_response) con
     }
     
     // Check for file markers
-    std::regex file_marker_regex(R"(---\s*FILE:\s*.+?\s*---)");
+    std::regex file_marker_regex(R"(---\s*(FILE|EDIT):\s*.+?\s*---)");
     std::sregex_iterator iter(llm_response.begin(), llm_response.end(), file_marker_regex);
     std::sregex_iterator end;
     
@@ -6,6 +6,7 @@
 #include "Camus/SafetyChecker.hpp"
 #include "Camus/ResponseParser.hpp"
 #include "Camus/AmodifyConfig.hpp"
+#include "Camus/ProcessRunner.hpp"
 #include <iostream>
 #include <filesystem>
 #include <fstream>
@@ -103,7 +104,7 @@ SafetyReport SafetyChecker::performSafetyChecks(
 }
 
 SafetyCheck SafetyChecker::checkGitStatus() {
-    auto [output, exit_code] = executeCommand("git status --porcelain");
+    auto [output, exit_code] = executeCommand("git", {"-C", m_project_root, "status", "--porcelain"});
     
     if (exit_code != 0) {
         return SafetyCheck("Git Status", SafetyLevel::WARNING,
@@ -367,21 +368,18 @@ std::string SafetyChecker::getSafetyLevelColor(SafetyLevel level) {
     }
 }
 
-std::pair<std::string, int> SafetyChecker::executeCommand(const std::string& command) {
-    std::string result;
-    std::array<char, 128> buffer;
+std::pair<std::string, int> SafetyChecker::executeCommand(const std::string& command,
+                                                          const std::vector<std::string>& args) {
+    ProcessOptions options;
+    options.merge_stderr = false; // Porcelain output must not contain warnings
+    options.timeout = std::chrono::seconds(30);
     
-    std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(command.c_str(), "r"), pclose);
-    if (!pipe) {
+    try {
+        auto result = ProcessRunner::run(command, args, options);
+        return {result.output, result.exit_code};
+    } catch (const std::exception&) {
         return {"", -1};
     }
-    
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-        result += buffer.data();
-    }
-    
-    int exit_code = pclose(pipe.release());
-    return {result, exit_code};
 }
 
 bool SafetyChecker::isWritable(const std::string& path) {
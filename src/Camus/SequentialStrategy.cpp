@@ -8,7 +8,6 @@
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
-#include <regex>
 #include <numeric>
 #include <chrono>
 #include <future>
@@ -283,7 +282,7 @@ bool SequentialStrategy::executeStep(const PipelineStep& step, PipelineState& st
         if (!model) {
             // Try fallback model if specified
             if (!step.fallback_model.empty()) {
-                Logger::getInstance().warn("SequentialStrategy", 
+                Logger::getInstance().warning("SequentialStrategy", 
                     "Primary model '" + step.model_name + "' unavailable, trying fallback: " + 
                     step.fallback_model);
                 model = m_registry.getModel(step.fallback_model);
@@ -339,7 +338,7 @@ bool SequentialStrategy::validateStepOutput(const PipelineStep& step,
     // Check quality threshold
     double quality = state.quality_scores[step.step_id];
     if (quality < step.min_quality_threshold) {
-        Logger::getInstance().warn("SequentialStrategy", 
+        Logger::getInstance().warning("SequentialStrategy", 
             "Step '" + step.step_id + "' quality " + std::to_string(quality) + 
             " below threshold " + std::to_string(step.min_quality_threshold));
         return false;
@@ -372,7 +371,7 @@ bool SequentialStrategy::validateStepOutput(const PipelineStep& step,
         }
         
         if (!rule_passed) {
-            Logger::getInstance().warn("SequentialStrategy", 
+            Logger::getInstance().warning("SequentialStrategy", 
                 "Step '" + step.step_id + "' failed validation rule: " + rule);
             return false;
         }
@@ -384,7 +383,7 @@ bool SequentialStrategy::validateStepOutput(const PipelineStep& step,
 bool SequentialStrategy::handleStepFailure(const PipelineStep& step, 
                                           PipelineState& state, 
                                           const std::string& error_message) {
-    Logger::getInstance().warn("SequentialStrategy", 
+    Logger::getInstance().warning("SequentialStrategy", 
         "Handling failure for step '" + step.step_id + "': " + error_message);
     
     // Try rollback to previous successful state
@@ -642,43 +641,38 @@ std::vector<PipelineStep> SequentialStrategy::convertBackendListToSteps(
 
 std::string SequentialStrategy::buildStepPrompt(const PipelineStep& step, 
                                                const PipelineState& state) {
-    // Create variable map for template substitution
-    std::unordered_map<std::string, std::string> variables;
-    
-    // Add state variables
-    variables["original_input"] = state.original_input;
-    variables["current_output"] = state.current_output;
-    variables["request_id"] = state.request_id;
-    
-    // Add all context variables
-    for (const auto& [key, value] : state.context_variables) {
-        variables[key] = value;
-    }
-    
-    // Add step outputs
-    for (const auto& [step_id, output] : state.step_outputs) {
-        variables["output_" + step_id] = output;
-    }
-    
-    // Add step parameters
-    for (const auto& [key, value] : step.step_parameters) {
-        variables[key] = value;
-    }
-    
-    // Apply template substitution
-    std::string prompt = step.prompt_template;
-    if (!prompt.empty()) {
-        prompt = applyTemplate(prompt, variables);
-    } else {
+    if (step.prompt_template.empty()) {
         // Use default prompt if no template specified
         if (state.current_step_index == 0) {
-            prompt = state.original_input;
-        } else {
-            prompt = "Continue processing:\n\n" + state.current_output;
+            return state.original_input;
         }
+        return "Continue processing:\n\n" + state.current_output;
     }
     
-    return prompt;
+    // Resolve variables in place instead of copying them into a map.
+    // Precedence: step parameters, step outputs, context variables, state.
+    auto resolve = [&step, &state](const std::string& name) -> const std::string* {
+        auto param_it = step.step_parameters.find(name);
+        if (param_it != step.step_parameters.end()) {
+            return &param_it->second;
+        }
+        if (name.compare(0, 7, "output_") == 0) {
+            auto output_it = state.step_outputs.find(name.substr(7));
+            if (output_it != state.step_outputs.end()) {
+                return &output_it->second;
+            }
+        }
+        auto context_it = state.context_variables.find(name);
+        if (context_it != state.context_variables.end()) {
+            return &context_it->second;
+        }
+        if (name == "original_input") return &state.original_input;
+        if (name == "current_output") return &state.current_output;
+        if (name == "request_id") return &state.request_id;
+        return nullptr;
+    };
+    
+    return getCompiledTemplate(step.prompt_template)->render(resolve);
 }
 
 bool SequentialStrategy::checkCache(const SequentialRequest& request, 
@@ -965,25 +959,20 @@ void SequentialStrategy::cleanupCache() {
 
 std::string SequentialStrategy::applyTemplate(const std::string& template_str, 
                                              const std::unordered_map<std::string, std::string>& variables) {
-    std::string result = template_str;
-    
-    // Replace all {{{variable}}} placeholders
-    std::regex var_regex(R"(\{\{\{(\w+)\}\}\})");
-    std::smatch match;
-    
-    while (std::regex_search(result, match, var_regex)) {
-        std::string var_name = match[1];
-        auto it = variables.find(var_name);
-        
-        if (it != variables.end()) {
-            result.replace(match.position(), match.length(), it->second);
-        } else {
-            // Leave placeholder if variable not found
-            result.replace(match.position(), match.length(), "");
-        }
+    // Replace all {{{variable}}} placeholders; unknown variables render empty
+    return getCompiledTemplate(template_str)->render(variables);
+}
+
+std::shared_ptr<const CompiledTemplate> SequentialStrategy::getCompiledTemplate(const std::string& template_str) {
+    std::lock_guard<std::mutex> lock(m_template_mutex);
+    auto it = m_compiled_templates.find(template_str);
+    if (it != m_compiled_templates.end()) {
+        return it->second;
     }
     
-    return result;
+    auto compiled = std::make_shared<const CompiledTemplate>(template_str, PlaceholderSyntax::TRIPLE_BRACE);
+    m_compiled_templates.emplace(template_str, compiled);
+    return compiled;
 }
 
 double SequentialStrategy::calculateOverallQuality(const PipelineState& state) {
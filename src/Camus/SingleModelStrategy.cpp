@@ -14,11 +14,25 @@
 
 namespace Camus {
 
+CompiledPromptTemplate::CompiledPromptTemplate(const PromptTemplate& source)
+    : template_name(source.template_name),
+      user_format(source.user_prompt_format, PlaceholderSyntax::SINGLE_BRACE),
+      context_format(source.context_format, PlaceholderSyntax::SINGLE_BRACE) {
+    if (!source.system_prompt.empty()) {
+        system_prefix = source.system_prompt + "\n\n";
+    }
+}
+
 SingleModelStrategy::SingleModelStrategy(ModelRegistry& registry, 
                                        const SingleModelStrategyConfig& config)
     : m_registry(registry), m_config(config) {
     
     // Initialize default templates and parameters
+    PromptTemplate default_template;
+    default_template.template_name = "default";
+    default_template.user_prompt_format = "{prompt}";
+    default_template.context_format = "\n\n{context}";
+    m_default_template = CompiledPromptTemplate(default_template);
     initializeDefaultTemplates();
     initializeDefaultParameters();
     
@@ -82,16 +96,30 @@ StrategyResponse SingleModelStrategy::execute(const StrategyRequest& request) {
         // Step 4: Execute the request
         auto execution_start = std::chrono::steady_clock::now();
         
-        // Set up model parameters (this would typically be done through model interface)
-        // For now, we'll use the optimized prompt directly
-        std::string model_response = model->getCompletion(optimized_prompt);
+        InferenceRequest inference;
+        inference.prompt = optimized_prompt;
+        inference.max_tokens = static_cast<size_t>(std::max(tuned_request.max_tokens, 1));
+        inference.temperature = tuned_request.temperature;
+        inference.top_p = tuned_request.top_p;
+        inference.timeout = tuned_request.timeout;
+        InferenceResponse inference_response = model->getCompletionWithMetadata(inference);
+        const std::string& model_response = inference_response.text;
         
         auto execution_end = std::chrono::steady_clock::now();
         response.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(
             execution_end - execution_start);
         
         response.response_text = model_response;
-        response.tokens_generated = estimateTokenCount(model_response);
+        response.tokens_generated = inference_response.tokens_generated > 0
+            ? inference_response.tokens_generated
+            : estimateTokenCount(model_response);
+        double token_confidence = -1.0;
+        if (inference_response.hasLogprobs()) {
+            token_confidence = inference_response.confidence_score;
+            response.confidence_score = inference_response.confidence_score;
+            response.perplexity = inference_response.perplexity;
+            response.debug_info["perplexity"] = std::to_string(inference_response.perplexity);
+        }
         response.context_tokens_used = estimateTokenCount(optimized_prompt);
         
         // Calculate context utilization
@@ -104,7 +132,8 @@ StrategyResponse SingleModelStrategy::execute(const StrategyRequest& request) {
         auto validation_start = std::chrono::steady_clock::now();
         
         if (m_config.enable_response_validation && request.enable_validation) {
-            response.quality_score = validateResponse(tuned_request, model_response, model_metadata);
+            response.quality_score = validateResponse(tuned_request, model_response, model_metadata,
+                                                      token_confidence);
             response.optimization_steps.push_back("response_validation");
         } else {
             response.quality_score = 0.8; // Default quality score
@@ -156,8 +185,8 @@ std::string SingleModelStrategy::optimizePrompt(const StrategyRequest& request,
     
     std::string optimized = request.prompt;
     
-    // Get appropriate prompt template
-    PromptTemplate template_obj = getPromptTemplate(model_metadata, request.task_type);
+    // Get appropriate prompt template (compiled when registered)
+    const CompiledPromptTemplate& template_obj = getPromptTemplate(model_metadata, request.task_type);
     
     // Apply template formatting
     optimized = applyPromptTemplate(template_obj, request.prompt, request.context);
@@ -259,7 +288,8 @@ StrategyRequest SingleModelStrategy::tuneParameters(const StrategyRequest& reque
 
 double SingleModelStrategy::validateResponse(const StrategyRequest& request,
                                             const std::string& response,
-                                            const ModelMetadata& model_metadata) {
+                                            const ModelMetadata& model_metadata,
+                                            double token_confidence) {
     
     double quality_score = m_quality_scorer(request.prompt, response);
     
@@ -290,6 +320,13 @@ double SingleModelStrategy::validateResponse(const StrategyRequest& request,
     // Ensure score is in valid range
     quality_score = std::max(0.0, std::min(1.0, quality_score));
     
+    // The model's own token confidence, when reported, outweighs what the
+    // text heuristics can infer
+    if (token_confidence >= 0.0) {
+        double weight = std::max(0.0, std::min(1.0, m_config.token_confidence_weight));
+        quality_score = (1.0 - weight) * quality_score + weight * std::min(1.0, token_confidence);
+    }
+    
     Logger::getInstance().debug("SingleModelStrategy", 
         "Response validated with quality score: " + std::to_string(quality_score));
     
@@ -548,7 +585,7 @@ void SingleModelStrategy::resetStatistics() {
 
 void SingleModelStrategy::registerPromptTemplate(const std::string& model_name, 
                                                 const PromptTemplate& template_obj) {
-    m_model_templates[model_name] = template_obj;
+    m_model_templates[model_name] = CompiledPromptTemplate(template_obj);
     Logger::getInstance().info("SingleModelStrategy", 
         "Registered prompt template for: " + model_name);
 }
@@ -574,7 +611,7 @@ void SingleModelStrategy::initializeDefaultTemplates() {
     code_template.target_capabilities = {ModelCapability::CODE_SPECIALIZED};
     code_template.temperature_adjustment = -0.1; // Slightly more deterministic for code
     
-    m_model_templates["code_specialized"] = code_template;
+    m_model_templates["code_specialized"] = CompiledPromptTemplate(code_template);
     
     // Analysis model template
     PromptTemplate analysis_template;
@@ -588,7 +625,7 @@ void SingleModelStrategy::initializeDefaultTemplates() {
         "\n\nFocus on security vulnerabilities and provide specific mitigation strategies.";
     analysis_template.target_capabilities = {ModelCapability::REASONING, ModelCapability::SECURITY_FOCUSED};
     
-    m_model_templates["analysis_focused"] = analysis_template;
+    m_model_templates["analysis_focused"] = CompiledPromptTemplate(analysis_template);
     
     // Fast model template
     PromptTemplate fast_template;
@@ -602,7 +639,7 @@ void SingleModelStrategy::initializeDefaultTemplates() {
     fast_template.temperature_adjustment = 0.1; // Slightly more creative for quick responses
     fast_template.max_tokens_adjustment = -256; // Shorter responses
     
-    m_model_templates["fast_inference"] = fast_template;
+    m_model_templates["fast_inference"] = CompiledPromptTemplate(fast_template);
     
     Logger::getInstance().info("SingleModelStrategy", "Initialized default prompt templates");
 }
@@ -630,8 +667,8 @@ void SingleModelStrategy::initializeDefaultParameters() {
     Logger::getInstance().info("SingleModelStrategy", "Initialized default parameter configurations");
 }
 
-PromptTemplate SingleModelStrategy::getPromptTemplate(const ModelMetadata& model_metadata, 
-                                                     TaskType task_type) {
+const CompiledPromptTemplate& SingleModelStrategy::getPromptTemplate(const ModelMetadata& model_metadata, 
+                                                                     TaskType task_type) {
     
     // First check for exact model name match
     auto model_it = m_model_templates.find(model_metadata.name);
@@ -660,34 +697,33 @@ PromptTemplate SingleModelStrategy::getPromptTemplate(const ModelMetadata& model
     }
     
     // Return default template
-    PromptTemplate default_template;
-    default_template.template_name = "default";
-    default_template.user_prompt_format = "{prompt}";
-    default_template.context_format = "\n\n{context}";
-    return default_template;
+    return m_default_template;
 }
 
-std::string SingleModelStrategy::applyPromptTemplate(const PromptTemplate& template_obj,
+std::string SingleModelStrategy::applyPromptTemplate(const CompiledPromptTemplate& template_obj,
                                                     const std::string& prompt,
                                                     const std::string& context) {
     
-    std::string result;
-    
-    // Add system prompt if present
-    if (!template_obj.system_prompt.empty()) {
-        result = template_obj.system_prompt + "\n\n";
-    }
-    
-    // Apply user prompt format
-    std::string user_part = template_obj.user_prompt_format;
-    user_part = std::regex_replace(user_part, std::regex("\\{prompt\\}"), prompt);
-    result += user_part;
+    // The user format takes only {prompt} and the context format only
+    // {context}; any other placeholder is left as written
+    auto resolve_prompt = [&prompt](const std::string& name) -> const std::string* {
+        return name == "prompt" ? &prompt : nullptr;
+    };
+    auto resolve_context = [&context](const std::string& name) -> const std::string* {
+        return name == "context" ? &context : nullptr;
+    };
+    bool include_context = !context.empty() && !template_obj.context_format.empty();
     
-    // Add context if present
-    if (!context.empty() && !template_obj.context_format.empty()) {
-        std::string context_part = template_obj.context_format;
-        context_part = std::regex_replace(context_part, std::regex("\\{context\\}"), context);
-        result += context_part;
+    // Size the result once: system prompt, user prompt format, then context
+    std::string result;
+    result.reserve(template_obj.system_prefix.size() +
+                   template_obj.user_format.renderedLength(resolve_prompt) +
+                   (include_context ? template_obj.context_format.renderedLength(resolve_context) : 0));
+    
+    result += template_obj.system_prefix;
+    template_obj.user_format.appendTo(result, resolve_prompt);
+    if (include_context) {
+        template_obj.context_format.appendTo(result, resolve_context);
     }
     
     return result;
@@ -0,0 +1,394 @@
+// =================================================================
+// src/Camus/SourceMinifier.cpp
+// =================================================================
+// Implementation of prompt minification and edit restoration.
+
+#include "Camus/SourceMinifier.hpp"
+#include "Camus/DiffGenerator.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <unordered_set>
+
+namespace Camus {
+
+namespace {
+
+enum class CommentStyle {
+    C_LIKE,     ///< "//" lines and "/* */" blocks
+    HASH,       ///< "#" lines
+    NONE        ///< Comments are not recognised; only whitespace is normalised
+};
+
+struct Language {
+    CommentStyle comments = CommentStyle::NONE;
+    bool significant_indentation = true;
+};
+
+Language detectLanguage(const std::string& file_path) {
+    static const std::unordered_set<std::string> c_like = {
+        ".c", ".h", ".cc", ".cpp", ".cxx", ".hh", ".hpp", ".hxx", ".ipp", ".inl", ".m", ".mm",
+        ".java", ".kt", ".kts", ".scala", ".groovy", ".gradle", ".cs", ".go", ".rs", ".swift",
+        ".dart", ".js", ".jsx", ".mjs", ".ts", ".tsx", ".php", ".proto", ".css", ".scss", ".less"
+    };
+    static const std::unordered_set<std::string> hash = {
+        ".sh", ".bash", ".zsh", ".rb", ".pl", ".pm", ".r", ".cmake", ".toml"
+    };
+    // Indentation is part of the syntax here, so it is left alone
+    static const std::unordered_set<std::string> hash_indented = {
+        ".py", ".yml", ".yaml", ".mk"
+    };
+
+    std::filesystem::path path(file_path);
+    std::string name = path.filename().string();
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    Language language;
+    if (c_like.count(extension)) {
+        language.comments = CommentStyle::C_LIKE;
+        language.significant_indentation = false;
+    } else if (hash.count(extension) || name == "CMakeLists.txt" || name == "Dockerfile") {
+        language.comments = CommentStyle::HASH;
+        language.significant_indentation = false;
+    } else if (hash_indented.count(extension) || name == "Makefile") {
+        language.comments = CommentStyle::HASH;
+    }
+    return language;
+}
+
+std::string trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t");
+    if (start == std::string::npos) {
+        return std::string();
+    }
+    return s.substr(start, s.find_last_not_of(" \t") - start + 1);
+}
+
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+std::vector<std::string> splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            lines.push_back(text.substr(start));
+            break;
+        }
+        lines.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return lines;
+}
+
+/**
+ * @brief How a line relates to comments, and the comment's text without markers
+ */
+struct CommentLine {
+    bool is_comment = false;
+    bool opens_or_closes = false;   ///< Contains "/*" or "*/"; dropping it alone would unbalance the block
+    bool self_contained = false;    ///< Opens and closes its own block
+    std::string text;
+};
+
+CommentLine classify(const std::string& trimmed, CommentStyle style, bool& in_block) {
+    CommentLine line;
+    if (style == CommentStyle::HASH) {
+        if (!trimmed.empty() && trimmed[0] == '#' && trimmed.compare(0, 2, "#!") != 0) {
+            size_t start = trimmed.find_first_not_of('#');
+            line.is_comment = true;
+            line.text = start == std::string::npos ? std::string() : trim(trimmed.substr(start));
+        }
+        return line;
+    }
+    if (style != CommentStyle::C_LIKE) {
+        return line;
+    }
+
+    std::string body = trimmed;
+    if (in_block) {
+        line.is_comment = true;
+        size_t close = body.find("*/");
+        if (close != std::string::npos) {
+            in_block = false;
+            line.opens_or_closes = true;
+            body = body.substr(0, close);
+        }
+    } else if (body.compare(0, 2, "//") == 0) {
+        line.is_comment = true;
+    } else if (body.compare(0, 2, "/*") == 0) {
+        line.is_comment = true;
+        line.opens_or_closes = true;
+        size_t close = body.find("*/", 2);
+        if (close == std::string::npos) {
+            in_block = true;
+        } else if (trim(body.substr(close + 2)).empty()) {
+            line.self_contained = true;
+            body = body.substr(0, close);
+        } else {
+            // Code follows the comment on the same line
+            line.is_comment = false;
+        }
+    }
+    if (line.is_comment) {
+        size_t start = body.find_first_not_of("/*!<");
+        line.text = start == std::string::npos ? std::string() : trim(body.substr(start));
+    }
+    return line;
+}
+
+bool isDivider(const std::string& text) {
+    return text.size() >= 4 && text.find_first_not_of("=-*/#~_+<>.") == std::string::npos;
+}
+
+bool isLicenseText(const std::string& lower) {
+    static const char* markers[] = {
+        "copyright", "license", "licence", "spdx-license-identifier",
+        "all rights reserved", "permission is hereby granted"
+    };
+    for (const char* marker : markers) {
+        if (lower.find(marker) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Indentation one level stands for, if every indented line agrees
+ *
+ * Tabs, or the largest of 8, 4, 3 and 2 spaces that nine in ten indented
+ * lines are a multiple of. Files mixing tabs and spaces are left alone.
+ */
+std::string detectIndentUnit(const std::vector<std::string>& lines, const std::vector<bool>& keep,
+                             const std::vector<bool>& continuation) {
+    size_t tab_lines = 0;
+    std::vector<size_t> widths;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (!keep[i] || continuation[i]) {
+            continue;
+        }
+        const std::string& line = lines[i];
+        size_t width = line.find_first_not_of(" \t");
+        if (width == 0 || width == std::string::npos) {
+            continue;
+        }
+        std::string indent = line.substr(0, width);
+        if (indent.find_first_not_of('\t') == std::string::npos) {
+            tab_lines++;
+        } else if (indent.find_first_not_of(' ') == std::string::npos) {
+            widths.push_back(width);
+        } else {
+            return std::string();
+        }
+    }
+    if (tab_lines > 0) {
+        return widths.empty() ? std::string("\t") : std::string();
+    }
+    if (widths.empty()) {
+        return std::string();
+    }
+    for (size_t unit : {8, 4, 3, 2}) {
+        size_t aligned = static_cast<size_t>(std::count_if(widths.begin(), widths.end(),
+                                                           [unit](size_t width) { return width % unit == 0; }));
+        if (aligned * 10 >= widths.size() * 9) {
+            return std::string(unit, ' ');
+        }
+    }
+    return std::string();
+}
+
+} // namespace
+
+MinifiedSource SourceMinifier::minify(const std::string& file_path, const std::string& content) {
+    MinifiedSource result;
+    Language language = detectLanguage(file_path);
+
+    std::vector<std::string> lines = splitLines(content);
+    for (auto& line : lines) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+            result.crlf = true;
+        }
+    }
+
+    std::string path_lower = toLower(file_path);
+    std::string name_lower = toLower(std::filesystem::path(file_path).filename().string());
+
+    std::vector<bool> keep(lines.size(), true);
+    std::vector<bool> continuation(lines.size(), false); // Inside a block comment; not indentation evidence
+    std::vector<CommentLine> comments(lines.size());
+    bool in_block = false;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        continuation[i] = in_block;
+        comments[i] = classify(trim(lines[i]), language.comments, in_block);
+    }
+
+    // License header: the first comment block, after a shebang and blank lines
+    size_t first = 0;
+    while (first < lines.size() && (trim(lines[first]).empty() || lines[first].compare(0, 2, "#!") == 0)) {
+        first++;
+    }
+    if (first < lines.size() && comments[first].is_comment) {
+        size_t last = first + 1;
+        if (comments[first].opens_or_closes && !comments[first].self_contained) {
+            // A block comment: up to and including the line that closes it
+            while (last < lines.size() && !comments[last].opens_or_closes) {
+                ++last;
+            }
+            last = last < lines.size() ? last + 1 : first;
+        } else {
+            while (last < lines.size() && comments[last].is_comment &&
+                   (!comments[last].opens_or_closes || comments[last].self_contained)) {
+                ++last;
+            }
+        }
+        std::string header;
+        for (size_t i = first; i < last; ++i) {
+            header += toLower(lines[i]) + "\n";
+        }
+        if (isLicenseText(header)) {
+            std::fill(keep.begin() + static_cast<std::ptrdiff_t>(first),
+                      keep.begin() + static_cast<std::ptrdiff_t>(last), false);
+        }
+    }
+
+    // Boilerplate comment lines: dividers, empty comments, the file's own path
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const CommentLine& comment = comments[i];
+        if (!keep[i] || !comment.is_comment || (comment.opens_or_closes && !comment.self_contained)) {
+            continue;
+        }
+        std::string lower = toLower(comment.text);
+        if (isDivider(comment.text) || (comment.text.empty() && !comment.self_contained) ||
+            lower == path_lower || lower == name_lower) {
+            keep[i] = false;
+        }
+    }
+
+    std::string unit = language.significant_indentation ? std::string()
+                                                         : detectIndentUnit(lines, keep, continuation);
+    result.indent_unit = unit.size() > 1 || unit == "\t" ? unit : std::string();
+
+    bool previous_blank = true; // Drops leading blank lines too
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (!keep[i]) {
+            continue;
+        }
+        std::string line = lines[i];
+        line.erase(line.find_last_not_of(" \t") + 1);
+        if (line.empty()) {
+            if (previous_blank) {
+                continue;
+            }
+            previous_blank = true;
+        } else {
+            previous_blank = false;
+        }
+
+        if (!result.indent_unit.empty() && !line.empty()) {
+            size_t width = line.find_first_not_of(result.indent_unit[0]);
+            size_t levels = width / result.indent_unit.size();
+            line = std::string(levels, ' ') + line.substr(width);
+        }
+        result.content += line;
+        result.content += '\n';
+        result.line_map.push_back(i + 1);
+    }
+    if (previous_blank && !result.line_map.empty()) {
+        result.content.pop_back();
+        result.line_map.pop_back();
+    }
+    if (!content.empty() && content.back() != '\n' && !result.content.empty()) {
+        result.content.pop_back();
+    }
+    return result;
+}
+
+std::string SourceMinifier::restore(const std::string& original, const MinifiedSource& minified,
+                                    const std::string& edited) {
+    if (edited == minified.content) {
+        return original;
+    }
+
+    std::vector<std::string> original_lines = splitLines(original);
+    std::vector<std::string> output;
+    output.reserve(original_lines.size());
+    size_t next = 0;
+    auto copy_until = [&](size_t end) {
+        for (; next < end && next < original_lines.size(); ++next) {
+            output.push_back(original_lines[next]);
+        }
+    };
+
+    auto diff = DiffGenerator(minified.content, edited).getDiff();
+    
+    // New lines are normally indented like the text the model saw; if they
+    // are nested deeper than anything it saw, in multiples of the original
+    // unit, the model wrote the original indentation and they are kept as is
+    bool expand = !minified.indent_unit.empty();
+    if (expand) {
+        size_t deepest = 0;
+        for (const auto& line : splitLines(minified.content)) {
+            deepest = std::max(deepest, line.find_first_not_of(' ') == std::string::npos ? 0 : line.find_first_not_of(' '));
+        }
+        bool all_multiples = true;
+        bool deeper = false;
+        for (const auto& line : diff) {
+            size_t width = line.text.find_first_not_of(' ');
+            if (line.type != DiffLineType::ADDED || width == std::string::npos) {
+                continue;
+            }
+            if (line.text[width] == '\t') {
+                all_multiples = minified.indent_unit == "\t";
+                deeper = true;
+            }
+            all_multiples = all_multiples && width % minified.indent_unit.size() == 0;
+            deeper = deeper || width > deepest + 1;
+        }
+        expand = !(all_multiples && deeper);
+    }
+    
+    for (const auto& line : diff) {
+        if (line.type == DiffLineType::ADDED) {
+            size_t width = line.text.find_first_not_of(' ');
+            std::string restored = line.text;
+            if (expand && width != std::string::npos) {
+                restored.clear();
+                for (size_t level = 0; level < width; ++level) {
+                    restored += minified.indent_unit;
+                }
+                restored += line.text.substr(width);
+            }
+            if (minified.crlf) {
+                restored += '\r';
+            }
+            output.push_back(std::move(restored));
+            continue;
+        }
+
+        size_t source = minified.line_map.at(line.original_line_num - 1) - 1;
+        // Lines minification dropped before this one stay in place
+        copy_until(source);
+        if (line.type == DiffLineType::UNCHANGED) {
+            output.push_back(original_lines[source]);
+        }
+        next = source + 1;
+    }
+    copy_until(original_lines.size());
+
+    std::string result;
+    for (size_t i = 0; i < output.size(); ++i) {
+        result += output[i];
+        if (i + 1 < output.size() || original.empty() || original.back() == '\n') {
+            result += '\n';
+        }
+    }
+    return result;
+}
+
+} // namespace Camus
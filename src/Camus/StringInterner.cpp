@@ -0,0 +1,63 @@
+// =================================================================
+// src/Camus/StringInterner.cpp
+// =================================================================
+// Implementation of the model and instance name interner.
+
+#include "Camus/StringInterner.hpp"
+#include <mutex>
+#include <stdexcept>
+
+namespace Camus {
+
+StringInterner& StringInterner::models() {
+    static StringInterner instance;
+    return instance;
+}
+
+StringInterner& StringInterner::instances() {
+    static StringInterner instance;
+    return instance;
+}
+
+InternedId StringInterner::intern(const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_ids.find(name);
+        if (it != m_ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(name);
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+    if (m_names.size() >= INVALID_INTERNED_ID) {
+        throw std::runtime_error("String interner exhausted");
+    }
+
+    InternedId id = static_cast<InternedId>(m_names.size());
+    m_names.push_back(name);
+    m_ids.emplace(name, id);
+    return id;
+}
+
+InternedId StringInterner::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(name);
+    return it != m_ids.end() ? it->second : INVALID_INTERNED_ID;
+}
+
+const std::string& StringInterner::name(InternedId id) const {
+    static const std::string empty;
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return id < m_names.size() ? m_names[id] : empty;
+}
+
+size_t StringInterner::size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_names.size();
+}
+
+} // namespace Camus
@@ -17,10 +17,11 @@ TaskClassifier::TaskClassifier(const ClassificationConfig& config)
     initializeDefaultRules();
 }
 
-ClassificationResult TaskClassifier::classify(const std::string& prompt, const std::string& context) {
+ClassificationResult TaskClassifier::classify(const std::string& prompt, const std::string& context,
+                                              std::pmr::memory_resource* resource) {
     auto start_time = std::chrono::steady_clock::now();
     
-    ClassificationResult result;
+    ClassificationResult result(resource);
     
     if (prompt.empty()) {
         result.primary_type = TaskType::UNKNOWN;
@@ -46,7 +47,7 @@ ClassificationResult TaskClassifier::classify(const std::string& prompt, const s
     }
     
     // Combine analysis results
-    result = combineAnalysis(keyword_scores, pattern_scores, context_scores);
+    result = combineAnalysis(keyword_scores, pattern_scores, context_scores, resource);
     
     // Calculate timing
     auto end_time = std::chrono::steady_clock::now();
@@ -61,10 +62,11 @@ ClassificationResult TaskClassifier::classify(const std::string& prompt, const s
 
 ClassificationResult TaskClassifier::classifyWithContext(const std::string& prompt,
                                                         const std::vector<std::string>& file_paths,
-                                                        const std::vector<std::string>& file_extensions) {
+                                                        const std::vector<std::string>& file_extensions,
+                                                        std::pmr::memory_resource* resource) {
     auto start_time = std::chrono::steady_clock::now();
     
-    ClassificationResult result;
+    ClassificationResult result(resource);
     
     if (prompt.empty()) {
         result.primary_type = TaskType::UNKNOWN;
@@ -90,7 +92,7 @@ ClassificationResult TaskClassifier::classifyWithContext(const std::string& prom
     }
     
     // Combine analysis results
-    result = combineAnalysis(keyword_scores, pattern_scores, context_scores);
+    result = combineAnalysis(keyword_scores, pattern_scores, context_scores, resource);
     
     // Calculate timing
     auto end_time = std::chrono::steady_clock::now();
@@ -376,8 +378,9 @@ std::unordered_map<TaskType, double> TaskClassifier::analyzeContext(const std::s
 
 ClassificationResult TaskClassifier::combineAnalysis(const std::unordered_map<TaskType, double>& keyword_scores,
                                                     const std::unordered_map<TaskType, double>& pattern_scores,
-                                                    const std::unordered_map<TaskType, double>& context_scores) {
-    ClassificationResult result;
+                                                    const std::unordered_map<TaskType, double>& context_scores,
+                                                    std::pmr::memory_resource* resource) {
+    ClassificationResult result(resource);
     std::unordered_map<TaskType, double> combined_scores;
     
     // Combine scores with weights
@@ -425,7 +428,8 @@ ClassificationResult TaskClassifier::combineAnalysis(const std::unordered_map<Ta
     if (max_element != combined_scores.end() && max_element->second > 0.0) {
         result.primary_type = max_element->first;
         result.confidence = calculateConfidence(combined_scores, max_element->second);
-        result.alternatives = getAlternatives(combined_scores, result.primary_type);
+        auto alternatives = getAlternatives(combined_scores, result.primary_type);
+        result.alternatives.assign(alternatives.begin(), alternatives.end());
         
         // Store keyword scores for debugging
         result.keyword_scores["keyword_score"] = keyword_scores.count(result.primary_type) ? 
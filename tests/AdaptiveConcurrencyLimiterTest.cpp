@@ -0,0 +1,237 @@
+// =================================================================
+// tests/AdaptiveConcurrencyLimiterTest.cpp
+// =================================================================
+// Unit tests for the gradient/AIMD per-backend concurrency limiter.
+
+#include "Camus/AdaptiveConcurrencyLimiter.hpp"
+#include "Camus/OllamaInteraction.hpp"
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+class AdaptiveConcurrencyLimiterTest {
+private:
+    Camus::AdaptiveLimiterConfig testConfig() {
+        Camus::AdaptiveLimiterConfig config;
+        config.initial_limit = 4.0;
+        config.min_limit = 1.0;
+        config.max_limit = 32.0;
+        config.smoothing = 0.5;
+        return config;
+    }
+
+public:
+    void testGrowsWhileLatencyIsFlat() {
+        std::cout << "Testing limit growth at steady latency..." << std::endl;
+
+        Camus::AdaptiveConcurrencyLimiter limiter(testConfig());
+        for (int i = 0; i < 20; ++i) {
+            size_t limit = limiter.getLimit();
+            limiter.recordSample(10ms, limit, false);
+        }
+        assert(limiter.getLimit() > 4 && "Saturated samples at baseline latency should raise the limit");
+        assert(limiter.getLimit() <= 32 && "Never above max_limit");
+
+        // Samples far below the limit carry no capacity information
+        Camus::AdaptiveConcurrencyLimiter idle(testConfig());
+        for (int i = 0; i < 20; ++i) {
+            idle.recordSample(10ms, 1, false);
+        }
+        assert(idle.getLimit() == 4 && "Low utilisation must not grow the limit");
+
+        std::cout << "✓ Limit growth test passed" << std::endl;
+    }
+
+    void testShrinksWhenLatencyRises() {
+        std::cout << "Testing limit reduction under queueing latency..." << std::endl;
+
+        Camus::AdaptiveConcurrencyLimiter limiter(testConfig());
+        for (int i = 0; i < 30; ++i) {
+            limiter.recordSample(10ms, limiter.getLimit(), false);
+        }
+        size_t knee = limiter.getLimit();
+
+        // Latency quadruples: the backend is queueing internally
+        for (int i = 0; i < 10; ++i) {
+            limiter.recordSample(40ms, limiter.getLimit(), false);
+        }
+        assert(limiter.getLimit() < knee && "Rising latency should lower the limit");
+
+        auto stats = limiter.getStats();
+        assert(stats.successes == 40);
+        assert(stats.short_rtt_ms > stats.long_rtt_ms);
+
+        std::cout << "✓ Limit reduction test passed" << std::endl;
+    }
+
+    void testMultiplicativeDecreaseOnDrops() {
+        std::cout << "Testing AIMD backoff on errors and timeouts..." << std::endl;
+
+        auto config = testConfig();
+        config.initial_limit = 20.0;
+        config.backoff_ratio = 0.5;
+        Camus::AdaptiveConcurrencyLimiter limiter(config);
+
+        limiter.recordSample(10ms, 20, true);
+        assert(limiter.getLimit() == 10);
+        limiter.recordSample(10ms, 10, true);
+        limiter.recordSample(10ms, 5, true);
+        limiter.recordSample(10ms, 2, true);
+        limiter.recordSample(10ms, 1, true);
+        assert(limiter.getLimit() == 1 && "Never below min_limit");
+        assert(limiter.getStats().drops == 5);
+
+        // A call that overruns its request timeout is a drop too
+        Camus::AdaptiveConcurrencyLimiter timed(config);
+        int value = timed.run([]() {
+            std::this_thread::sleep_for(5ms);
+            return 7;
+        }, 100ms, 1ms);
+        assert(value == 7);
+        assert(timed.getStats().drops == 1);
+
+        // Exceptions release the permit and are rethrown
+        bool threw = false;
+        try {
+            timed.run([]() -> int { throw std::runtime_error("backend down"); }, 100ms);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        assert(timed.getStats().drops == 2);
+        assert(timed.getStats().in_flight == 0);
+
+        std::cout << "✓ Backoff test passed" << std::endl;
+    }
+
+    void testQueuesExcessRequests() {
+        std::cout << "Testing queueing beyond the limit..." << std::endl;
+
+        auto config = testConfig();
+        config.initial_limit = 2.0;
+        Camus::AdaptiveConcurrencyLimiter limiter(config);
+
+        auto first = limiter.acquire(0ms);
+        auto second = limiter.acquire(0ms);
+        assert(first && second);
+        assert(limiter.getStats().in_flight == 2);
+
+        // At the limit: a short wait times out instead of overloading
+        auto rejected = limiter.acquire(10ms);
+        assert(!rejected);
+        assert(limiter.getStats().rejections == 1);
+
+        // A queued request is admitted as soon as a permit is returned
+        std::atomic<bool> admitted{false};
+        std::thread waiter([&]() {
+            auto permit = limiter.acquire(10s);
+            admitted = static_cast<bool>(permit);
+        });
+        while (limiter.getStats().queued == 0) {
+            std::this_thread::sleep_for(1ms);
+        }
+        assert(!admitted.load());
+        first.success();
+        waiter.join();
+        assert(admitted.load());
+
+        second = Camus::AdaptiveConcurrencyLimiter::Permit();
+        assert(limiter.getStats().in_flight == 0 && "Dropping a permit releases its slot");
+
+        // Bounded queue rejects immediately
+        config.initial_limit = 1.0;
+        config.max_queue = 1;
+        Camus::AdaptiveConcurrencyLimiter bounded(config);
+        auto held = bounded.acquire(0ms);
+        std::thread queued([&]() { auto permit = bounded.acquire(10s); });
+        while (bounded.getStats().queued == 0) {
+            std::this_thread::sleep_for(1ms);
+        }
+        auto overflow = bounded.acquire(10s);
+        assert(!overflow && "A full queue rejects without waiting");
+        held.success();
+        queued.join();
+
+        std::cout << "✓ Queueing test passed" << std::endl;
+    }
+
+    void testSharedPerBackend() {
+        std::cout << "Testing per-backend registry..." << std::endl;
+
+        auto& a = Camus::AdaptiveConcurrencyLimiter::forBackend("limiter_test_a");
+        auto& again = Camus::AdaptiveConcurrencyLimiter::forBackend("limiter_test_a");
+        auto& b = Camus::AdaptiveConcurrencyLimiter::forBackend("limiter_test_b");
+        assert(&a == &again);
+        assert(&a != &b);
+
+        auto config = testConfig();
+        config.initial_limit = 9.0;
+        Camus::AdaptiveConcurrencyLimiter::configureBackend("limiter_test_a", config);
+        assert(a.getLimit() == 9);
+        assert(b.getLimit() == 4);
+
+        std::cout << "✓ Registry test passed" << std::endl;
+    }
+
+    void testModelsShareTheirServer() {
+        std::cout << "Testing one limit for every model on a server..." << std::endl;
+
+        // Nothing listens on these ports; no request is made
+        Camus::OllamaInteraction coder("http://127.0.0.1:9", "coder:7b");
+        Camus::OllamaInteraction chat("http://127.0.0.1:9/", "chat:8b");
+        Camus::OllamaInteraction remote("http://127.0.0.2:9", "coder:7b");
+        assert(coder.getBackendEndpoint() == chat.getBackendEndpoint());
+        assert(coder.getBackendEndpoint() != remote.getBackendEndpoint());
+
+        auto config = testConfig();
+        config.initial_limit = 1.0;
+        config.min_limit = 1.0;
+        Camus::AdaptiveConcurrencyLimiter::configureBackend(coder.getBackendEndpoint(), config);
+
+        auto& coder_limiter = Camus::AdaptiveConcurrencyLimiter::forBackend(coder.getBackendEndpoint());
+        auto& chat_limiter = Camus::AdaptiveConcurrencyLimiter::forBackend(chat.getBackendEndpoint());
+        assert(&coder_limiter == &chat_limiter && "Models on one server share its limit");
+
+        auto held = coder_limiter.acquire(0ms);
+        assert(held);
+        auto blocked = chat_limiter.acquire(0ms);
+        assert(!blocked && "The other model must wait for the server's only slot");
+        auto other = Camus::AdaptiveConcurrencyLimiter::forBackend(remote.getBackendEndpoint()).acquire(0ms);
+        assert(other && "Another server has its own limit");
+        held.success();
+
+        std::cout << "✓ Shared server limit test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running adaptive concurrency limiter unit tests..." << std::endl;
+
+        testGrowsWhileLatencyIsFlat();
+        testShrinksWhenLatencyRises();
+        testMultiplicativeDecreaseOnDrops();
+        testQueuesExcessRequests();
+        testSharedPerBackend();
+        testModelsShareTheirServer();
+
+        std::cout << "All adaptive concurrency limiter tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        AdaptiveConcurrencyLimiterTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All adaptive concurrency limiter component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
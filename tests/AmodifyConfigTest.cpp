@@ -0,0 +1,291 @@
+// =================================================================
+// tests/AmodifyConfigTest.cpp
+// =================================================================
+// Unit tests for reading config.yml, as written by `camus init`.
+
+#include "Camus/ConfigParser.hpp"
+#include "Camus/AmodifyConfig.hpp"
+#include "Camus/CliParser.hpp"
+#include "Camus/EditApplier.hpp"
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <cassert>
+
+namespace fs = std::filesystem;
+
+class AmodifyConfigTest {
+private:
+    std::string test_dir = "test_amodify_config";
+
+    /**
+     * @brief Write the init template with one setting edited in place, as a user would
+     */
+    Camus::ConfigParser loadEdited(const std::string& key, const std::string& value) {
+        std::string content = Camus::ConfigParser::defaultConfig();
+        if (!key.empty()) {
+            std::regex line("(^|\n) *" + key + ": ([^#\n]*?)( *#|\n)");
+            std::smatch match;
+            assert(std::regex_search(content, match, line) && "Setting must be in the template");
+            content.replace(match.position(2), match.length(2), value);
+        }
+        fs::create_directories(test_dir);
+        std::ofstream(test_dir + "/config.yml") << content;
+        return Camus::ConfigParser(test_dir + "/config.yml");
+    }
+
+public:
+    void testInitTemplate() {
+        std::cout << "Testing the configuration written by init..." << std::endl;
+
+        Camus::ConfigParser config = loadEdited("", "");
+        assert(config.getStringValue("backend") == "direct");
+        assert(config.getStringValue("ollama_url") == "http://localhost:11434");
+        assert(config.getStringValue("build_command") == "cmake --build ./build" && "Quotes are not part of the value");
+        assert(config.getStringValue("build_timeout") == "0" && "Inline comments are not part of the value");
+        assert(config.getStringValue("amodify.max_files") == "100" && "Section keys carry the section prefix");
+        assert(config.getStringValue("max_files").empty());
+        assert(config.getStringValue("amodify.fanout_models").empty());
+        assert(config.getStringValue("amodify.missing").empty());
+
+        // Every amodify setting in the template matches the built-in default
+        Camus::AmodifyConfig defaults;
+        Camus::AmodifyConfig loaded;
+        loaded.loadFromConfig(config);
+        assert(loaded.validate());
+        assert(loaded.max_files == defaults.max_files && loaded.max_tokens == defaults.max_tokens);
+        assert(loaded.backup_dir == defaults.backup_dir);
+        assert(loaded.interactive_threshold == defaults.interactive_threshold);
+        assert(loaded.git_check == defaults.git_check && loaded.create_backups == defaults.create_backups);
+        assert(loaded.minify_context == defaults.minify_context);
+        assert(loaded.max_output_tokens == defaults.max_output_tokens);
+
+        // A missing file leaves every key unset
+        Camus::ConfigParser missing(test_dir + "/absent.yml");
+        assert(missing.getStringValue("backend").empty());
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Init template test passed" << std::endl;
+    }
+
+    void testMinifyContext() {
+        std::cout << "Testing enabling prompt minification..." << std::endl;
+
+        Camus::AmodifyConfig loaded;
+        loaded.loadFromConfig(loadEdited("minify_context", "true"));
+        assert(loaded.minify_context);
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Minify context test passed" << std::endl;
+    }
+
+    void testContextSession() {
+        std::cout << "Testing session settings..." << std::endl;
+
+        Camus::AmodifyConfig defaults;
+        defaults.loadFromConfig(loadEdited("", ""));
+        assert(!defaults.context_session && defaults.session_ttl_minutes == 60);
+
+        Camus::AmodifyConfig enabled;
+        enabled.loadFromConfig(loadEdited("context_session", "true"));
+        assert(enabled.context_session && enabled.validate());
+
+        Camus::AmodifyConfig ttl;
+        ttl.loadFromConfig(loadEdited("session_ttl_minutes", "15"));
+        assert(ttl.session_ttl_minutes == 15);
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Context session test passed" << std::endl;
+    }
+
+    void testRetrieval() {
+        std::cout << "Testing retrieval settings..." << std::endl;
+
+        Camus::AmodifyConfig defaults;
+        defaults.loadFromConfig(loadEdited("", ""));
+        assert(!defaults.retrieval && defaults.embedding_model_path.empty() && defaults.retrieval_top_k == 40);
+
+        // Retrieval without an embedding model is rejected
+        Camus::AmodifyConfig no_model;
+        no_model.loadFromConfig(loadEdited("retrieval", "true"));
+        assert(no_model.retrieval && !no_model.validate());
+
+        Camus::AmodifyConfig index_dir;
+        index_dir.loadFromConfig(loadEdited("retrieval_index_dir", "'.cache/index'"));
+        assert(index_dir.retrieval_index_dir == ".cache/index");
+
+        Camus::AmodifyConfig top_k;
+        top_k.loadFromConfig(loadEdited("retrieval_top_k", "12"));
+        assert(top_k.retrieval_top_k == 12);
+
+        Camus::AmodifyConfig max_files;
+        max_files.loadFromConfig(loadEdited("retrieval_max_files", "8"));
+        assert(max_files.retrieval_max_files == 8);
+
+        Camus::AmodifyConfig model;
+        model.loadFromConfig(loadEdited("embedding_model_path", "/models/bge-small.gguf"));
+        assert(model.embedding_model_path == "/models/bge-small.gguf");
+
+        // --embedding-model turns retrieval on from the command line
+        Camus::Commands commands;
+        commands.embedding_model_path = "/models/nomic-embed.gguf";
+        Camus::AmodifyConfig from_cli;
+        from_cli.loadFromConfig(loadEdited("", ""));
+        from_cli.applyCommandOverrides(commands);
+        assert(from_cli.retrieval && from_cli.embedding_model_path == "/models/nomic-embed.gguf" && from_cli.validate());
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Retrieval test passed" << std::endl;
+    }
+
+    void testConstrainedOutput() {
+        std::cout << "Testing constrained output settings..." << std::endl;
+
+        Camus::AmodifyConfig defaults;
+        defaults.loadFromConfig(loadEdited("", ""));
+        assert(!defaults.constrained_output);
+
+        Camus::AmodifyConfig enabled;
+        enabled.loadFromConfig(loadEdited("constrained_output", "true"));
+        assert(enabled.constrained_output);
+
+        // The answer has its own budget; the context budget is not an output limit
+        assert(defaults.max_output_tokens == 8000 && defaults.validate());
+        Camus::AmodifyConfig output;
+        output.loadFromConfig(loadEdited("max_output_tokens", "16000"));
+        assert(output.max_output_tokens == 16000 && output.validate());
+        output.max_output_tokens = output.max_tokens;
+        assert(!output.validate() && "The answer must leave room for the prompt");
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Constrained output test passed" << std::endl;
+    }
+
+    void testFanout() {
+        std::cout << "Testing fan-out settings..." << std::endl;
+
+        Camus::AmodifyConfig defaults;
+        defaults.loadFromConfig(loadEdited("", ""));
+        assert(defaults.execution_mode == "single" && defaults.fanout_models.empty());
+
+        Camus::AmodifyConfig mode;
+        mode.loadFromConfig(loadEdited("execution_mode", "fanout"));
+        assert(mode.execution_mode == "fanout" && mode.validate());
+
+        const std::pair<const char*, size_t Camus::AmodifyConfig::*> limits[] = {
+            {"fanout_files_per_task", &Camus::AmodifyConfig::fanout_files_per_task},
+            {"fanout_task_tokens", &Camus::AmodifyConfig::fanout_task_tokens},
+            {"fanout_concurrency", &Camus::AmodifyConfig::fanout_concurrency},
+            {"fanout_timeout_seconds", &Camus::AmodifyConfig::fanout_timeout_seconds},
+        };
+        for (const auto& limit : limits) {
+            Camus::AmodifyConfig loaded;
+            loaded.loadFromConfig(loadEdited(limit.first, "7"));
+            assert(loaded.*limit.second == 7);
+        }
+
+        Camus::AmodifyConfig models;
+        models.loadFromConfig(loadEdited("fanout_models", "'fast, large'"));
+        assert(models.fanout_models == "fast, large");
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Fan-out test passed" << std::endl;
+    }
+
+    void testPrefetchModel() {
+        std::cout << "Testing top-level settings with inline comments..." << std::endl;
+
+        assert(loadEdited("", "").getStringValue("prefetch_model") == "false");
+        assert(loadEdited("prefetch_model", "true").getStringValue("prefetch_model") == "true" &&
+               "Editing the value keeps the comment out of it");
+        assert(loadEdited("build_timeout", "120").getStringValue("build_timeout") == "120");
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Prefetch model test passed" << std::endl;
+    }
+
+    void testEditFormat() {
+        std::cout << "Testing edit format settings..." << std::endl;
+
+        Camus::AmodifyConfig defaults;
+        defaults.loadFromConfig(loadEdited("", ""));
+        assert(defaults.edit_format == "auto");
+
+        Camus::AmodifyConfig forced;
+        forced.loadFromConfig(loadEdited("edit_format", "search_replace"));
+        assert(forced.edit_format == "search_replace");
+        assert(Camus::EditApplier::parseFormat(forced.edit_format) == Camus::EditFormat::SEARCH_REPLACE);
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Edit format test passed" << std::endl;
+    }
+
+    void testDeduplication() {
+        std::cout << "Testing deduplication settings..." << std::endl;
+
+        Camus::AmodifyConfig defaults;
+        defaults.loadFromConfig(loadEdited("", ""));
+        assert(defaults.deduplicate_files && defaults.near_duplicate_threshold == 0.0);
+
+        Camus::AmodifyConfig disabled;
+        disabled.loadFromConfig(loadEdited("deduplicate_files", "false"));
+        assert(!disabled.deduplicate_files);
+
+        Camus::AmodifyConfig near;
+        near.loadFromConfig(loadEdited("near_duplicate_threshold", "0.8"));
+        assert(near.near_duplicate_threshold == 0.8 && near.validate());
+
+        Camus::AmodifyConfig out_of_range;
+        out_of_range.loadFromConfig(loadEdited("near_duplicate_threshold", "1.5"));
+        assert(!out_of_range.validate());
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Deduplication test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running AmodifyConfig tests..." << std::endl;
+        std::cout << "===============================================" << std::endl << std::endl;
+
+        testInitTemplate();
+        std::cout << std::endl;
+
+        testMinifyContext();
+        std::cout << std::endl;
+
+        testContextSession();
+        std::cout << std::endl;
+
+        testRetrieval();
+        std::cout << std::endl;
+
+        testConstrainedOutput();
+        std::cout << std::endl;
+
+        testFanout();
+        std::cout << std::endl;
+
+        testPrefetchModel();
+        std::cout << std::endl;
+
+        testEditFormat();
+        std::cout << std::endl;
+
+        testDeduplication();
+        std::cout << std::endl;
+    }
+};
+
+int main() {
+    try {
+        AmodifyConfigTest tests;
+        tests.runAllTests();
+
+        std::cout << "🎉 All AmodifyConfig tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
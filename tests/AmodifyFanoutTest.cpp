@@ -0,0 +1,272 @@
+// =================================================================
+// tests/AmodifyFanoutTest.cpp
+// =================================================================
+// Unit tests for amodify fan-out planning, prompts and merging.
+
+#include "Camus/AmodifyFanout.hpp"
+#include "Camus/ContextBuilder.hpp"
+#include "Camus/FileBlockFormat.hpp"
+#include "Camus/ModelRegistry.hpp"
+#include "Camus/ParallelStrategy.hpp"
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Backend that enforces the FILE block format when asked to
+ */
+class ConstrainingMockModel : public Camus::LlmInteraction {
+public:
+    std::string getCompletion(const std::string& prompt) override {
+        Camus::InferenceRequest request;
+        request.prompt = prompt;
+        return getCompletionWithMetadata(request).text;
+    }
+
+    Camus::InferenceResponse getCompletionWithMetadata(const Camus::InferenceRequest& request) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_constraints.push_back(request.constraint);
+        m_max_tokens.push_back(request.max_tokens);
+        Camus::InferenceResponse response;
+        response.text = "--- FILE: a.cpp ---\nint a;\n";
+        if (request.constraint == Camus::ResponseConstraint::FILE_BLOCKS) {
+            response.metadata["constraint"] = Camus::FileBlockFormat::CONSTRAINT_NAME;
+        }
+        return response;
+    }
+
+    Camus::ModelMetadata getModelMetadata() const override { return Camus::ModelMetadata(); }
+    bool isHealthy() const override { return true; }
+    bool performHealthCheck() override { return true; }
+    Camus::ModelPerformance getCurrentPerformance() const override { return Camus::ModelPerformance(); }
+    std::string getModelId() const override { return "constraining"; }
+
+    std::mutex m_mutex;
+    std::vector<Camus::ResponseConstraint> m_constraints;
+    std::vector<size_t> m_max_tokens;
+};
+
+class AmodifyFanoutTest {
+private:
+    std::string test_dir = "test_fanout_project";
+
+    static bool owns(const Camus::EditTask& task, const std::string& path) {
+        return std::find(task.files.begin(), task.files.end(), path) != task.files.end();
+    }
+
+public:
+    void testClusterKey() {
+        std::cout << "Testing cluster keys..." << std::endl;
+
+        assert(Camus::AmodifyFanout::clusterKey("include/Camus/Foo.hpp") == "Foo");
+        assert(Camus::AmodifyFanout::clusterKey("src/Camus/Foo.cpp") == "Foo");
+        assert(Camus::AmodifyFanout::clusterKey("web/app.test.ts") == "app");
+        assert(Camus::AmodifyFanout::clusterKey(".env") == ".env");
+        assert(Camus::AmodifyFanout::clusterKey("Makefile") == "Makefile");
+        std::cout << "✓ Cluster key test passed" << std::endl;
+    }
+
+    void testPlanTasks() {
+        std::cout << "Testing task planning..." << std::endl;
+
+        std::vector<std::pair<std::string, size_t>> files = {
+            {"include/Foo.hpp", 100}, {"src/Bar.cpp", 100}, {"src/Foo.cpp", 100},
+            {"src/Baz.cpp", 100}, {"src/Big.cpp", 5000}, {"include/Bar.hpp", 100},
+        };
+        auto tasks = Camus::AmodifyFanout::planTasks(files, 3, 1000);
+
+        // Foo and Bar pairs fill the first task only up to the limit
+        assert(tasks.size() == 3);
+        assert(tasks[0].task_id == "task-1");
+        assert(owns(tasks[0], "include/Foo.hpp") && owns(tasks[0], "src/Foo.cpp"));
+        assert(tasks[0].files.size() == 2 && "Bar's pair would exceed three files");
+        assert(owns(tasks[1], "src/Bar.cpp") && owns(tasks[1], "include/Bar.hpp"));
+        assert(owns(tasks[1], "src/Baz.cpp"));
+        assert(tasks[2].files == std::vector<std::string>{"src/Big.cpp"} && "Oversized cluster alone");
+        assert(tasks[2].estimated_tokens == 5000);
+
+        // Every file is owned by exactly one task
+        size_t owned = 0;
+        for (const auto& task : tasks) {
+            owned += task.files.size();
+        }
+        assert(owned == files.size());
+
+        assert(Camus::AmodifyFanout::planTasks({}, 3, 1000).empty());
+        assert(Camus::AmodifyFanout::planTasks(files, 0, 0).size() == 1 && "No limits, one task");
+        std::cout << "✓ Task planning test passed" << std::endl;
+    }
+
+    void testMergeResults() {
+        std::cout << "Testing result merging..." << std::endl;
+
+        std::vector<Camus::EditTask> tasks(2);
+        tasks[0].task_id = "task-1";
+        tasks[0].files = {"src/a.cpp", "include/a.hpp"};
+        tasks[1].task_id = "task-2";
+        tasks[1].files = {"src/b.cpp"};
+
+        std::vector<std::vector<Camus::FileModification>> results(2);
+        results[0].emplace_back("src/a.cpp", "a1");
+        results[0].emplace_back("src/b.cpp", "stray");          // Owned by task-2
+        results[0].emplace_back("src/new.cpp", "new1", true);
+        results[1].emplace_back("src/b.cpp", "b1");
+        results[1].emplace_back("src/new.cpp", "new2", true);   // Created twice
+        results[1].emplace_back("src/b.cpp", "b2");             // Duplicate in one task
+
+        std::vector<std::string> conflicts;
+        auto merged = Camus::AmodifyFanout::mergeResults(tasks, results, conflicts);
+
+        assert(merged.size() == 3);
+        assert(merged[0].file_path == "src/a.cpp" && merged[0].new_content == "a1");
+        assert(merged[1].file_path == "src/new.cpp" && merged[1].new_content == "new1");
+        assert(merged[2].file_path == "src/b.cpp" && merged[2].new_content == "b1");
+        assert(conflicts.size() == 3);
+        assert(conflicts[0].find("belongs to task-2") != std::string::npos);
+
+        // Files nobody owns may only be created, never overwritten
+        fs::create_directories(test_dir + "/src");
+        std::ofstream(test_dir + "/src/outlined.cpp") << "int outlined;\n";
+        std::vector<std::vector<Camus::FileModification>> unowned(2);
+        unowned[0].emplace_back("src/outlined.cpp", "overwritten");        // Existing, seen in the outline
+        unowned[0].emplace_back("src/claimed.cpp", "claimed", true);       // Claims to be new...
+        unowned[1].emplace_back("src/outlined.cpp", "created", true);      // ...but exists
+        unowned[1].emplace_back("src/created.cpp", "created", true);
+        conflicts.clear();
+        merged = Camus::AmodifyFanout::mergeResults(tasks, unowned, conflicts, test_dir);
+
+        assert(merged.size() == 2);
+        assert(merged[0].file_path == "src/claimed.cpp" && merged[1].file_path == "src/created.cpp");
+        assert(conflicts.size() == 2 && "Writes to existing unowned files are conflicts");
+        assert(conflicts[0].find("src/outlined.cpp, which no task was given to edit") != std::string::npos);
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Result merging test passed" << std::endl;
+    }
+
+    void testFanoutContext() {
+        std::cout << "Testing fan-out prompts..." << std::endl;
+
+        fs::create_directories(test_dir + "/src");
+        fs::create_directories(test_dir + "/include");
+        std::ofstream(test_dir + "/include/Cache.hpp") << "class Cache {\npublic:\n    int lookup(int key);\n};\n";
+        std::ofstream(test_dir + "/src/Cache.cpp") << "#include \"Cache.hpp\"\nint Cache::lookup(int key) {\n    return key;\n}\n";
+        std::ofstream(test_dir + "/src/Main.cpp") << "int main() {\n    return 0;\n}\n";
+        std::vector<std::string> paths = {"include/Cache.hpp", "src/Cache.cpp", "src/Main.cpp"};
+
+        Camus::ContextBuilder builder(16000);
+        builder.setGitPrioritization(false);
+        auto context = builder.buildFanoutContext(paths, "Make the cache lookup faster", 4, test_dir);
+
+        // Only the files mentioning the request get a task; all are outlined
+        assert(context.tasks.size() == 1);
+        assert(context.tasks[0].files.size() == 2);
+        assert(!owns(context.tasks[0], "src/Main.cpp"));
+        assert(context.shared_prefix.find("Make the cache lookup faster") != std::string::npos);
+        assert(context.shared_prefix.find("src/Main.cpp\n    int main() {") != std::string::npos);
+        assert(context.shared_prefix.find("    return 0;") == std::string::npos && "Bodies are not outlined");
+        assert(context.suffixes.size() == 1);
+        std::string prompt = context.prompt(0);
+        assert(prompt.find("int Cache::lookup(int key) {\n    return key;") != std::string::npos);
+        assert(prompt.find("(include/Cache.hpp, src/Cache.cpp)") != std::string::npos);
+        assert(builder.getLastBuildStats()["tasks"] == 1);
+
+        // A one-file limit splits unrelated clusters but never a pair
+        auto split = builder.buildFanoutContext(paths, "main and cache", 1, test_dir);
+        assert(split.tasks.size() == 2 && "Cache pair stays together despite the limit");
+        for (size_t i = 0; i < split.tasks.size(); ++i) {
+            assert(split.prompt(i).compare(0, split.shared_prefix.size(), split.shared_prefix) == 0);
+        }
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Fan-out prompt test passed" << std::endl;
+    }
+
+    void testSubtaskConstraint() {
+        std::cout << "Testing the response constraint on fan-out subtasks..." << std::endl;
+
+        auto model = std::make_shared<ConstrainingMockModel>();
+        Camus::RegistryConfig config;
+        config.auto_discover = false;
+        config.enable_health_checks = false;
+        Camus::ModelRegistry registry(config);
+        registry.shareInstance("llama_cpp", "/models/fanout.gguf", model);
+        Camus::ModelConfig model_config;
+        model_config.name = "fanout";
+        model_config.version = "1";
+        model_config.type = "llama_cpp";
+        model_config.path = "/models/fanout.gguf";
+        assert(registry.loadModel(model_config).success);
+
+        Camus::ParallelStrategyConfig strategy_config;
+        strategy_config.enable_resource_monitoring = false;
+        strategy_config.enable_adaptive_throttling = false;
+        strategy_config.enable_dependency_resolution = false;
+        Camus::ParallelStrategy strategy(registry, strategy_config);
+
+        Camus::ParallelRequest request;
+        request.request_id = "fanout";
+        request.pattern = Camus::ParallelPattern::FILE_ANALYSIS;
+        request.aggregation_method = Camus::AggregationMethod::CONCATENATE;
+        request.min_success_ratio = 0.0;
+        for (std::string id : {"constrained", "free"}) {
+            Camus::ParallelSubtask subtask;
+            subtask.subtask_id = id;
+            subtask.model_name = registry.getLoadedModels().at(0);
+            subtask.prompt = "edit a.cpp for " + id;
+            if (id == "constrained") {
+                subtask.constraint = Camus::ResponseConstraint::FILE_BLOCKS;
+                subtask.max_tokens = 6000;
+            }
+            request.subtasks.push_back(subtask);
+        }
+
+        auto parallel = strategy.execute(request);
+        assert(parallel.subtask_results.size() == 2);
+        for (const auto& result : parallel.subtask_results) {
+            assert(result.success);
+            bool enforced = result.metadata.count("constraint") > 0 &&
+                            result.metadata.at("constraint") == Camus::FileBlockFormat::CONSTRAINT_NAME;
+            assert(enforced == (result.subtask_id == "constrained") &&
+                   "Only the constrained subtask reports an enforced format");
+        }
+        auto constrained = std::find(model->m_constraints.begin(), model->m_constraints.end(),
+                                     Camus::ResponseConstraint::FILE_BLOCKS);
+        assert(constrained != model->m_constraints.end() && "The backend must receive the constraint");
+        assert(model->m_max_tokens[constrained - model->m_constraints.begin()] == 6000);
+
+        std::cout << "✓ Subtask constraint test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running amodify fan-out unit tests..." << std::endl;
+
+        testClusterKey();
+        testPlanTasks();
+        testMergeResults();
+        testFanoutContext();
+        testSubtaskConstraint();
+
+        std::cout << "All amodify fan-out tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        AmodifyFanoutTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All amodify fan-out component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
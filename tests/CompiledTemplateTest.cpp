@@ -0,0 +1,127 @@
+// =================================================================
+// tests/CompiledTemplateTest.cpp
+// =================================================================
+// Unit tests for compiled prompt templates.
+
+#include "Camus/CompiledTemplate.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <unordered_map>
+
+class CompiledTemplateTest {
+public:
+    void testTripleBraceRendering() {
+        std::cout << "Testing {{{name}}} templates..." << std::endl;
+
+        Camus::CompiledTemplate tmpl("Refine and improve the following:\n\n{{{current_output}}}");
+        assert(tmpl.getSegments().size() == 2);
+        assert(tmpl.hasVariables());
+
+        std::unordered_map<std::string, std::string> variables = {{"current_output", "int x;"}};
+        assert(tmpl.render(variables) == "Refine and improve the following:\n\nint x;");
+
+        std::cout << "✓ Triple brace rendering test passed" << std::endl;
+    }
+
+    void testMissingAndRepeatedVariables() {
+        std::cout << "Testing missing and repeated variables..." << std::endl;
+
+        Camus::CompiledTemplate tmpl("{{{a}}}-{{{missing}}}-{{{a}}}");
+        std::unordered_map<std::string, std::string> variables = {{"a", "x"}};
+        assert(tmpl.render(variables) == "x--x" && "Unknown variables render empty");
+
+        // Prompt formats keep placeholders they do not define
+        Camus::CompiledTemplate format("{prompt} as {language}: {}", Camus::PlaceholderSyntax::SINGLE_BRACE);
+        std::unordered_map<std::string, std::string> prompt = {{"prompt", "Sort"}};
+        assert(format.render(prompt) == "Sort as {language}: {}" && "Unknown placeholders stay literal");
+        auto resolve = [&prompt](const std::string& name) -> const std::string* {
+            auto it = prompt.find(name);
+            return it == prompt.end() ? nullptr : &it->second;
+        };
+        assert(format.renderedLength(resolve) == format.render(prompt).size());
+
+        std::cout << "✓ Missing variable test passed" << std::endl;
+    }
+
+    void testValuesAreNotRescanned() {
+        std::cout << "Testing that substituted values are inserted verbatim..." << std::endl;
+
+        Camus::CompiledTemplate tmpl("{{{input}}} / {{{other}}}");
+        std::unordered_map<std::string, std::string> variables = {
+            {"input", "literal {{{other}}} and $1"},
+            {"other", "o"}
+        };
+        assert(tmpl.render(variables) == "literal {{{other}}} and $1 / o");
+
+        std::cout << "✓ Verbatim substitution test passed" << std::endl;
+    }
+
+    void testLiteralBraces() {
+        std::cout << "Testing braces that are not placeholders..." << std::endl;
+
+        Camus::CompiledTemplate code("int main() { return {prompt}; }", Camus::PlaceholderSyntax::SINGLE_BRACE);
+        std::unordered_map<std::string, std::string> variables = {{"prompt", "0"}};
+        assert(code.render(variables) == "int main() { return 0; }");
+        assert(code.getSegments().size() == 3 && "Adjacent literal text should be merged");
+
+        Camus::CompiledTemplate nested("{{{{x}}}}");
+        assert(nested.render({{"x", "v"}}) == "{v}");
+
+        Camus::CompiledTemplate plain("no placeholders {here");
+        assert(!plain.hasVariables());
+        std::unordered_map<std::string, std::string> none;
+        assert(plain.render(none) == "no placeholders {here");
+
+        std::cout << "✓ Literal brace test passed" << std::endl;
+    }
+
+    void testLengthAndTokenEstimates() {
+        std::cout << "Testing precomputed lengths and token estimates..." << std::endl;
+
+        Camus::CompiledTemplate tmpl("Context:\n{context}\nEnd", Camus::PlaceholderSyntax::SINGLE_BRACE);
+        assert(tmpl.getStaticLength() == 13);
+        assert(tmpl.getStaticTokens() == Camus::CompiledTemplate::estimateTokenCount(9) +
+                                         Camus::CompiledTemplate::estimateTokenCount(4));
+
+        std::string context(400, 'c');
+        auto resolve = [&context](const std::string& name) -> const std::string* {
+            return name == "context" ? &context : nullptr;
+        };
+        assert(tmpl.renderedLength(resolve) == 413);
+        assert(tmpl.render(resolve).size() == 413);
+        assert(tmpl.estimateTokens(resolve) == tmpl.getStaticTokens() + 100);
+
+        std::string appended = "prefix:";
+        tmpl.appendTo(appended, resolve);
+        assert(appended.size() == 7 + 413);
+
+        std::cout << "✓ Length and token estimate test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running compiled template unit tests..." << std::endl;
+
+        testTripleBraceRendering();
+        testMissingAndRepeatedVariables();
+        testValuesAreNotRescanned();
+        testLiteralBraces();
+        testLengthAndTokenEstimates();
+
+        std::cout << "All compiled template tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        CompiledTemplateTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All compiled template component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
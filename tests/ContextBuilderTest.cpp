@@ -10,6 +10,7 @@
 #include <cassert>
 #include <vector>
 #include <algorithm>
+#include <sstream>
 
 namespace fs = std::filesystem;
 
@@ -220,6 +221,161 @@ void debugPrint(const std::string& info) {
         std::cout << "✓ Very low token limit test passed" << std::endl;
     }
     
+    void testBatchContext() {
+        std::cout << "Testing shared context for a batch of requests..." << std::endl;
+        
+        setupTestFiles();
+        std::ofstream(test_dir + "/logger.cpp") << "void writeLog() { /* prepends timestamps */ }\n";
+        std::ofstream(test_dir + "/parser.cpp") << "void parseConfig() { /* parser, keeps timestamps */ }\n";
+        
+        std::vector<std::string> files = {"small.cpp", "logger.cpp", "parser.cpp"};
+        std::vector<std::string> requests = {
+            "Add timestamps to every line",
+            "Make the parser strict"
+        };
+        
+        Camus::ContextBuilder builder(20000);
+        auto batch = builder.buildBatchContext(files, requests, test_dir);
+        
+        assert(batch.suffixes.size() == 2 && "Should produce one suffix per request");
+        assert(batch.file_order.size() == 3 && "Should include every file");
+        assert(batch.file_order[0] == "parser.cpp" && "File relevant to both requests should lead");
+        assert(batch.file_order[1] == "logger.cpp");
+        assert(batch.file_order[2] == "small.cpp" && "Unreferenced file should come last");
+        
+        assert(batch.shared_prefix.find("Add timestamps") == std::string::npos &&
+               "Requests must not leak into the shared prefix");
+        for (size_t i = 0; i < requests.size(); ++i) {
+            std::string prompt = batch.prompt(i);
+            assert(prompt.compare(0, batch.shared_prefix.size(), batch.shared_prefix) == 0);
+            assert(prompt.find(requests[i]) != std::string::npos);
+        }
+        
+        auto stats = builder.getLastBuildStats();
+        assert(stats["requests"] == 2);
+        assert(stats["files_included"] == 3);
+        assert(stats["shared_prefix_tokens"] > 0 && stats["tokens_used"] <= 20000);
+        
+        cleanupTestFiles();
+        std::cout << "✓ Batch context test passed" << std::endl;
+    }
+    
+    void testBudgetPacking() {
+        std::cout << "Testing knapsack packing of the token budget..." << std::endl;
+        
+        fs::create_directories(test_dir);
+        // A large source file, a header too large to fit, and small files
+        std::ofstream big(test_dir + "/big.cpp");
+        for (int i = 0; i < 1000; i++) {
+            big << "int big_function_" << i << "() { return " << i << "; }\n";
+        }
+        big.close();
+        std::ofstream header(test_dir + "/huge.hpp");
+        for (int i = 0; i < 2000; i++) {
+            header << "int declaration_" << i << "();\n";
+        }
+        header.close();
+        std::vector<std::string> files = {"big.cpp", "huge.hpp"};
+        for (int i = 0; i < 5; i++) {
+            std::string name = "small" + std::to_string(i) + ".cpp";
+            std::ofstream(test_dir + "/" + name) << "int small" << i << "() { return " << i << "; }\n";
+            files.push_back(name);
+        }
+        
+        Camus::ContextBuilder builder(6000);
+        builder.setReservedTokens(0);
+        std::string context = builder.buildContext(files, "Tidy up", test_dir);
+        auto stats = builder.getLastBuildStats();
+        
+        for (int i = 0; i < 5; i++) {
+            assert(context.find("small" + std::to_string(i) + ".cpp") != std::string::npos &&
+                   "Small files must not be crowded out by a large one");
+        }
+        assert(context.find("--- FILE: huge.hpp") == std::string::npos && "Header too large to fit is left out, not truncated");
+        assert(context.find("--- FILE: big.cpp") != std::string::npos && stats["files_truncated"] == 1 &&
+               "Large source file fills the rest, truncated");
+        assert(stats["files_included"] == 6 && stats["files_skipped"] == 1);
+        assert(stats["packed_tokens"] <= stats["budget_tokens"] && "Packing must stay within the budget");
+        assert(stats["budget_utilization_pct"] >= 98 && "Packing should use almost all of the budget");
+        assert(stats["tokens_used"] <= 6000);
+        
+        cleanupTestFiles();
+        std::cout << "✓ Budget packing test passed" << std::endl;
+    }
+    
+    void testDeduplication() {
+        std::cout << "Testing duplicate and near-duplicate folding..." << std::endl;
+        
+        fs::create_directories(test_dir + "/linux");
+        fs::create_directories(test_dir + "/mac");
+        fs::create_directories(test_dir + "/win");
+        std::ostringstream platform;
+        for (int i = 0; i < 60; i++) {
+            platform << "int platform_call_" << i << "(int value) { return value + " << i << "; }\n";
+        }
+        std::string linux_source = platform.str();
+        std::string windows_source = linux_source;
+        windows_source.replace(windows_source.find("value + 30"), 10, "value - 30");
+        std::ofstream(test_dir + "/linux/platform.cpp") << linux_source;
+        std::ofstream(test_dir + "/mac/platform.cpp") << linux_source;
+        std::ofstream(test_dir + "/win/platform.cpp") << windows_source;
+        std::ofstream(test_dir + "/main.cpp") << "int main() { return platform_call_0(1); }\n";
+        std::vector<std::string> files = {"linux/platform.cpp", "mac/platform.cpp", "win/platform.cpp", "main.cpp"};
+        
+        Camus::ContextBuilder plain(100000);
+        plain.setDeduplication(false);
+        std::string undeduplicated = plain.buildContext(files, "Port the platform layer", test_dir);
+        
+        Camus::ContextBuilder builder(100000);
+        builder.setNearDuplicateThreshold(0.5);
+        std::string context = builder.buildContext(files, "Port the platform layer", test_dir);
+        auto stats = builder.getLastBuildStats();
+        
+        assert(stats["duplicates_collapsed"] == 1 && stats["near_duplicates"] == 1);
+        assert(context.size() * 2 < undeduplicated.size() && "Folding should shrink the prompt");
+        assert(context.find("--- FILE: mac/platform.cpp") == std::string::npos &&
+               context.find("mac/platform.cpp") != std::string::npos && "Identical copy is named, not repeated");
+        assert(context.find("--- FILE: win/platform.cpp") != std::string::npos &&
+               context.find("-int platform_call_30(int value) { return value + 30; }") != std::string::npos &&
+               context.find("+int platform_call_30(int value) { return value - 30; }") != std::string::npos &&
+               "Near duplicate is sent as its diff");
+        assert(context.find("main.cpp") != std::string::npos);
+        
+        // Without a threshold only exact copies are folded
+        Camus::ContextBuilder exact_only(100000);
+        exact_only.buildContext(files, "Port the platform layer", test_dir);
+        auto exact_stats = exact_only.getLastBuildStats();
+        assert(exact_stats["duplicates_collapsed"] == 1 && exact_stats["near_duplicates"] == 0);
+        
+        // A truncated base cannot carry the diff; the near duplicate is then
+        // counted as skipped rather than silently dropped
+        Camus::ContextBuilder tight(900);
+        tight.setReservedTokens(0);
+        tight.setNearDuplicateThreshold(0.5);
+        std::string tight_context = tight.buildContext(files, "Port the platform layer", test_dir);
+        auto tight_stats = tight.getLastBuildStats();
+        assert(tight_stats["near_duplicates"] == 1 && tight_stats["files_truncated"] == 1);
+        assert(tight_context.find("--- FILE: win/platform.cpp") == std::string::npos &&
+               tight_stats["files_skipped"] == 1 && "Near duplicate of a truncated file is skipped");
+        
+        // Fan-out tasks fold them as well; the task holding the kept copy owns every copy
+        Camus::ContextBuilder fanout_builder(100000);
+        fanout_builder.setNearDuplicateThreshold(0.5);
+        auto fanout = fanout_builder.buildFanoutContext(files, "Port the platform layer", 0, test_dir);
+        auto fanout_stats = fanout_builder.getLastBuildStats();
+        assert(fanout_stats["duplicates_collapsed"] == 1 && fanout_stats["near_duplicates"] == 1);
+        assert(fanout.tasks.size() == 1);
+        const auto& owned = fanout.tasks[0].files;
+        for (const auto& path : files) {
+            assert(std::find(owned.begin(), owned.end(), path) != owned.end() && "Every copy stays owned");
+        }
+        assert(fanout.prompt(0).find("--- FILE: mac/platform.cpp") == std::string::npos &&
+               "Identical copy is not repeated in the task");
+        
+        cleanupTestFiles();
+        std::cout << "✓ Deduplication test passed" << std::endl;
+    }
+    
     void runAllTests() {
         std::cout << "Running ContextBuilder unit tests..." << std::endl;
         
@@ -229,6 +385,9 @@ void debugPrint(const std::string& info) {
         testRelevanceKeywords();
         testEmptyFileList();
         testVeryLowTokenLimit();
+        testBatchContext();
+        testBudgetPacking();
+        testDeduplication();
         
         std::cout << "All ContextBuilder tests passed!" << std::endl;
     }
@@ -0,0 +1,161 @@
+// =================================================================
+// tests/ContextSessionTest.cpp
+// =================================================================
+// Unit tests for amodify sessions and follow-up (delta) contexts.
+
+#include "Camus/ContextSession.hpp"
+#include "Camus/ContextBuilder.hpp"
+#include "nlohmann/json.hpp"
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cassert>
+
+namespace fs = std::filesystem;
+
+class ContextSessionTest {
+private:
+    std::string test_dir = "test_context_session";
+
+    void writeFile(const std::string& path, const std::string& content) {
+        fs::create_directories(fs::path(test_dir + "/" + path).parent_path());
+        std::ofstream(test_dir + "/" + path) << content;
+    }
+
+    static bool contains(const std::vector<std::string>& list, const std::string& value) {
+        return std::find(list.begin(), list.end(), value) != list.end();
+    }
+
+public:
+    void testDeltaContext() {
+        std::cout << "Testing follow-up contexts..." << std::endl;
+
+        fs::remove_all(test_dir);
+        writeFile("src/a.cpp", "int a() { return 1; }\n");
+        writeFile("src/b.cpp", "int b() { return 2; }\n");
+        writeFile("src/c.cpp", "int c() { return 3; }\n");
+        std::vector<std::string> files = {"src/a.cpp", "src/b.cpp", "src/c.cpp"};
+
+        Camus::ContextBuilder builder(100000);
+        std::string first = builder.buildContext(files, "Add logging", test_dir);
+        Camus::ContextSnapshot snapshot = builder.getLastSnapshot();
+        assert(snapshot.sent.size() == 3 && snapshot.withheld.empty());
+
+        // Nothing changed: the turn is just the request
+        auto unchanged = builder.buildDeltaContext(files, "Now add tests", snapshot, 1000, test_dir);
+        assert(unchanged.fits && unchanged.changed.empty() && unchanged.removed.empty());
+        assert(unchanged.turn.find("int a()") == std::string::npos);
+        assert(unchanged.turn.find("No project files changed") != std::string::npos);
+        assert(unchanged.turn.find("Now add tests") != std::string::npos);
+        assert(builder.getLastSnapshot().sent.size() == 3);
+
+        // One edited, one new and one deleted file
+        writeFile("src/a.cpp", "int a() { return 10; }\n");
+        writeFile("src/d.cpp", "int d() { return 4; }\n");
+        fs::remove(test_dir + "/src/c.cpp");
+        std::vector<std::string> now = {"src/a.cpp", "src/b.cpp", "src/d.cpp"};
+        auto delta = builder.buildDeltaContext(now, "Rename a", snapshot, 1000, test_dir);
+        assert(delta.fits);
+        assert(delta.changed.size() == 2 && contains(delta.changed, "src/a.cpp") && contains(delta.changed, "src/d.cpp"));
+        assert(delta.removed.size() == 1 && delta.removed[0] == "src/c.cpp");
+        assert(delta.turn.find("return 10;") != std::string::npos);
+        assert(delta.turn.find("int b()") == std::string::npos && "Unchanged files are not resent");
+        assert(delta.turn.find("src/c.cpp") != std::string::npos && "Removed files are listed");
+        assert(delta.turn.size() < first.size());
+        const auto& after = builder.getLastSnapshot();
+        assert(after.sent.size() == 3 && !after.sent.count("src/c.cpp") && after.sent.count("src/d.cpp"));
+
+        // The model's own applied edit is not resent; a declined one is
+        Camus::ContextSnapshot turn_snapshot = builder.getLastSnapshot();
+        writeFile("src/a.cpp", "int a() { return 20; }\n");
+        auto seen = builder.snapshotAfterEdits(turn_snapshot, {{"src/a.cpp", "int a() { return 20; }\n"},
+                                                               {"src/b.cpp", "int b() { return 30; }\n"}}, test_dir);
+        assert(seen.sent.count("src/a.cpp") && !seen.sent.count("src/b.cpp"));
+        auto after_edit = builder.buildDeltaContext(now, "Keep going", seen, 1000, test_dir);
+        assert(after_edit.changed.size() == 1 && after_edit.changed[0] == "src/b.cpp");
+        assert(after_edit.turn.find("return 20;") == std::string::npos);
+
+        // A history that fills the window leaves no room for changes
+        auto full = builder.buildDeltaContext(now, "Rename a", snapshot, 100000, test_dir);
+        assert(!full.fits);
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Follow-up context test passed" << std::endl;
+    }
+
+    void testSessionPersistence() {
+        std::cout << "Testing session persistence..." << std::endl;
+
+        fs::remove_all(test_dir);
+        std::string dir = test_dir + "/sessions";
+        Camus::ContextSnapshot snapshot;
+        snapshot.sent["src/a.cpp"] = 42;
+        snapshot.withheld["src/big.cpp"] = 7;
+
+        Camus::ContextSession session(dir, "ollama:codellama:local");
+        assert(!session.load(std::chrono::minutes(60)) && !session.active());
+        session.recordTurn("<turn 1>", "<answer 1>", snapshot, {1, 2, 3});
+        session.save();
+
+        Camus::ContextSession loaded(dir, "ollama:codellama:local");
+        assert(loaded.load(std::chrono::minutes(60)));
+        assert(loaded.turns() == 1 && loaded.history() == "<turn 1><answer 1>");
+        assert(loaded.historyTokens() == (loaded.history().size() + 3) / 4);
+        assert(loaded.snapshot().sent.at("src/a.cpp") == 42 && loaded.snapshot().withheld.at("src/big.cpp") == 7);
+        assert((loaded.backendContext() == std::vector<int64_t>{1, 2, 3}));
+
+        loaded.recordTurn("<turn 2>", "<answer 2>", snapshot, {});
+        assert(loaded.turns() == 2 && loaded.history() == "<turn 1><answer 1><turn 2><answer 2>");
+        assert(loaded.backendContext().empty());
+
+        // Another model does not pick the conversation up
+        Camus::ContextSession other(dir, "llama_cpp:/models/other.gguf:other");
+        assert(!other.load(std::chrono::minutes(60)));
+
+        // An idle session expires and is removed
+        std::string file;
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            file = entry.path().string();
+        }
+        nlohmann::json data = nlohmann::json::parse(std::ifstream(file));
+        data["updated"] = data["updated"].get<int64_t>() - 2 * 3600;
+        std::ofstream(file, std::ios::trunc) << data.dump();
+        Camus::ContextSession expired(dir, "ollama:codellama:local");
+        assert(!expired.load(std::chrono::minutes(60)) && !expired.active());
+        assert(!fs::exists(file));
+
+        // A corrupt file is discarded rather than trusted
+        session.save();
+        std::ofstream(file, std::ios::trunc) << "{not json";
+        Camus::ContextSession corrupt(dir, "ollama:codellama:local");
+        assert(!corrupt.load(std::chrono::minutes(60)) && !fs::exists(file));
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Session persistence test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running ContextSession tests..." << std::endl;
+        std::cout << "===============================================" << std::endl << std::endl;
+
+        testDeltaContext();
+        std::cout << std::endl;
+
+        testSessionPersistence();
+        std::cout << std::endl;
+    }
+};
+
+int main() {
+    try {
+        ContextSessionTest tests;
+        tests.runAllTests();
+
+        std::cout << "🎉 All ContextSession tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
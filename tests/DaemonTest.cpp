@@ -0,0 +1,395 @@
+// =================================================================
+// tests/DaemonTest.cpp
+// =================================================================
+// Unit tests for the camus daemon and its client.
+
+#include "Camus/CamusDaemon.hpp"
+#include "Camus/DaemonClient.hpp"
+#include "Camus/ModelRegistry.hpp"
+#include "Camus/ParallelStrategy.hpp"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+
+/**
+ * @brief Backend that streams a fixed reply piece by piece
+ */
+class StreamingMockModel : public Camus::LlmInteraction {
+public:
+    explicit StreamingMockModel(std::vector<std::string> pieces) : m_pieces(std::move(pieces)) {}
+
+    std::string getCompletion(const std::string& prompt) override {
+        Camus::InferenceRequest request;
+        request.prompt = prompt;
+        return getCompletionWithMetadata(request).text;
+    }
+
+    Camus::InferenceResponse getCompletionWithMetadata(const Camus::InferenceRequest& request) override {
+        m_calls++;
+        m_last_prompt = request.prompt;
+        m_last_constraint = request.constraint;
+        Camus::InferenceResponse response;
+        for (const auto& piece : m_pieces) {
+            if (request.on_token) {
+                request.on_token(piece);
+            }
+            response.text += piece;
+        }
+        response.tokens_generated = m_pieces.size();
+        response.finish_reason = "stop";
+        response.metadata["backend"] = "mock";
+        return response;
+    }
+
+    Camus::ModelMetadata getModelMetadata() const override {
+        Camus::ModelMetadata metadata;
+        metadata.name = "mock";
+        metadata.provider = "test";
+        metadata.performance.max_context_tokens = 8192;
+        return metadata;
+    }
+
+    bool isHealthy() const override { return true; }
+    bool performHealthCheck() override { return true; }
+    Camus::ModelPerformance getCurrentPerformance() const override { return Camus::ModelPerformance(); }
+    std::string getModelId() const override { return "mock_model"; }
+
+    std::atomic<int> m_calls{0};
+    std::string m_last_prompt;
+    Camus::ResponseConstraint m_last_constraint = Camus::ResponseConstraint::NONE;
+
+private:
+    std::vector<std::string> m_pieces;
+};
+
+/**
+ * @brief Backend that echoes the prompt back slowly, a few bytes per piece
+ */
+class EchoMockModel : public StreamingMockModel {
+public:
+    EchoMockModel() : StreamingMockModel({}) {}
+
+    Camus::InferenceResponse getCompletionWithMetadata(const Camus::InferenceRequest& request) override {
+        Camus::InferenceResponse response;
+        std::string reply = "reply:" + request.prompt;
+        for (size_t i = 0; i < reply.size(); i += 4) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (request.on_token) {
+                request.on_token(reply.substr(i, 4));
+            }
+        }
+        response.text = reply;
+        response.finish_reason = "stop";
+        return response;
+    }
+};
+
+class DaemonTest {
+private:
+    std::string test_dir;
+    std::string socket_path;
+
+    void setupTestEnvironment() {
+        test_dir = "test_daemon_tmp";
+        std::filesystem::create_directories(test_dir);
+        socket_path = test_dir + "/camus.sock";
+    }
+
+    void cleanupTestEnvironment() {
+        std::filesystem::remove_all(test_dir);
+    }
+
+    Camus::DaemonConfig makeConfig() const {
+        Camus::DaemonConfig config;
+        config.socket_path = socket_path;
+        config.poll_interval = std::chrono::milliseconds(20);
+        return config;
+    }
+
+public:
+    void testNoDaemonFallsBack() {
+        std::cout << "Testing connection without a daemon..." << std::endl;
+
+        assert(Camus::DaemonClient::connect(socket_path) == nullptr &&
+               "Client should report that no daemon is running");
+
+        std::cout << "✓ No daemon test passed" << std::endl;
+    }
+
+    void testStreamingCompletion() {
+        std::cout << "Testing streamed completion through the daemon..." << std::endl;
+
+        StreamingMockModel model({"int ", "main() ", "{ return 0; }"});
+        Camus::CamusDaemon daemon(model, makeConfig());
+        daemon.start();
+        std::thread server([&daemon]() { daemon.run(); });
+
+        auto client = Camus::DaemonClient::connect(socket_path);
+        assert(client && "Client should connect to the running daemon");
+        assert(client->getModelId() == "mock_model" && "Handshake should carry the model id");
+        assert(client->getModelMetadata().performance.max_context_tokens == 8192);
+        assert(client->performHealthCheck() && "Ping should succeed");
+
+        std::vector<std::string> streamed;
+        Camus::InferenceRequest request;
+        request.prompt = "write main";
+        request.on_token = [&streamed](const std::string& piece) { streamed.push_back(piece); };
+        auto response = client->getCompletionWithMetadata(request);
+
+        assert(response.text == "int main() { return 0; }" && "Final text should be complete");
+        assert(streamed.size() == 3 && "Each piece should be streamed");
+        assert(response.tokens_generated == 3);
+        assert(response.metadata["backend"] == "mock" && "Backend metadata should be forwarded");
+        assert(model.m_last_prompt == "write main");
+
+        // The same connection serves further requests against the resident model
+        client->getCompletionWithMetadata(request);
+        assert(model.m_calls == 2);
+
+        assert(client->requestShutdown() && "Daemon should acknowledge shutdown");
+        server.join();
+
+        auto stats = daemon.getStats();
+        assert(stats.completions == 2 && stats.tokens_generated == 6);
+        assert(!std::filesystem::exists(socket_path) && "Socket should be removed on exit");
+
+        std::cout << "✓ Streaming completion test passed" << std::endl;
+    }
+
+    void testConstraintReachesBackend() {
+        std::cout << "Testing that the response constraint reaches the backend..." << std::endl;
+
+        StreamingMockModel model({"--- FILE: a.cpp ---\n", "int a;\n"});
+        Camus::CamusDaemon daemon(model, makeConfig());
+        daemon.start();
+        std::thread server([&daemon]() { daemon.run(); });
+
+        auto client = Camus::DaemonClient::connect(socket_path);
+        assert(client);
+
+        Camus::InferenceRequest request;
+        request.prompt = "edit a.cpp";
+        request.on_token = [](const std::string&) {};
+        request.constraint = Camus::ResponseConstraint::FILE_BLOCKS;
+        client->getCompletionWithMetadata(request);
+        assert(model.m_last_constraint == Camus::ResponseConstraint::FILE_BLOCKS &&
+               "The daemon's backend must apply the requested grammar");
+
+        request.constraint = Camus::ResponseConstraint::NONE;
+        client->getCompletionWithMetadata(request);
+        assert(model.m_last_constraint == Camus::ResponseConstraint::NONE);
+
+        assert(client->requestShutdown());
+        server.join();
+
+        std::cout << "✓ Constraint forwarding test passed" << std::endl;
+    }
+
+    void testConcurrentFanoutSubtasks() {
+        std::cout << "Testing concurrent fan-out subtasks sharing one daemon client..." << std::endl;
+
+        EchoMockModel model;
+        Camus::CamusDaemon daemon(model, makeConfig());
+        daemon.start();
+        std::thread server([&daemon]() { daemon.run(); });
+
+        std::shared_ptr<Camus::DaemonClient> client = Camus::DaemonClient::connect(socket_path);
+        assert(client);
+        {
+            // As amodify fan-out does: the configured backend serves the models.yml entry
+            Camus::RegistryConfig config;
+            config.auto_discover = false;
+            config.enable_health_checks = false;
+            Camus::ModelRegistry registry(config);
+            registry.shareInstance("llama_cpp", "/models/daemon.gguf", client);
+            Camus::ModelConfig model_config;
+            model_config.name = "daemon";
+            model_config.version = "1";
+            model_config.type = "llama_cpp";
+            model_config.path = "/models/daemon.gguf";
+            assert(registry.loadModel(model_config).success);
+            std::string model_name = registry.getLoadedModels().at(0);
+
+            Camus::ParallelStrategyConfig strategy_config;
+            strategy_config.max_concurrent_executions = 4;
+            strategy_config.thread_pool_size = 4;
+            strategy_config.enable_resource_monitoring = false;
+            strategy_config.enable_adaptive_throttling = false;
+            strategy_config.enable_dependency_resolution = false;
+            Camus::ParallelStrategy strategy(registry, strategy_config);
+
+            Camus::ParallelRequest request;
+            request.request_id = "fanout";
+            request.pattern = Camus::ParallelPattern::FILE_ANALYSIS;
+            request.aggregation_method = Camus::AggregationMethod::CONCATENATE;
+            request.max_concurrent_tasks = 4;
+            request.min_success_ratio = 0.0;
+            for (std::string id : {"task_a", "task_b", "task_c", "task_d"}) {
+                Camus::ParallelSubtask subtask;
+                subtask.subtask_id = id;
+                subtask.model_name = model_name;
+                subtask.prompt = "edit the files of " + id + std::string(200, '.');
+                request.subtasks.push_back(subtask);
+            }
+
+            auto parallel = strategy.execute(request);
+            assert(parallel.subtask_results.size() == 4);
+            for (const auto& result : parallel.subtask_results) {
+                assert(result.success && "A shared client must not corrupt concurrent requests");
+                assert(result.result_text == "reply:edit the files of " + result.subtask_id + std::string(200, '.') &&
+                       "Each subtask must get its own reply");
+            }
+        }
+
+        assert(client->requestShutdown());
+        server.join();
+        assert(daemon.getStats().completions == 4 && daemon.getStats().errors == 0);
+
+        std::cout << "✓ Concurrent fan-out test passed" << std::endl;
+    }
+
+    void testUtf8PiecesAreNotSplit() {
+        std::cout << "Testing UTF-8 boundaries in streamed pieces..." << std::endl;
+
+        assert(Camus::completeUtf8Length("abc") == 3);
+        assert(Camus::completeUtf8Length("a\xC3") == 1 && "Lone lead byte should be held back");
+        assert(Camus::completeUtf8Length("a\xC3\xA9") == 3);
+        assert(Camus::completeUtf8Length("\xE2\x82") == 0);
+
+        // "é" split across two generated pieces
+        StreamingMockModel model({"caf", "\xC3", "\xA9", "!"});
+        Camus::CamusDaemon daemon(model, makeConfig());
+        daemon.start();
+        std::thread server([&daemon]() { daemon.run(); });
+
+        auto client = Camus::DaemonClient::connect(socket_path);
+        assert(client);
+
+        std::vector<std::string> streamed;
+        Camus::InferenceRequest request;
+        request.on_token = [&streamed](const std::string& piece) { streamed.push_back(piece); };
+        auto response = client->getCompletionWithMetadata(request);
+
+        assert(response.text == "caf\xC3\xA9!");
+        std::string joined;
+        for (const auto& piece : streamed) {
+            assert(Camus::completeUtf8Length(piece) == piece.size() && "No piece may end mid-character");
+            joined += piece;
+        }
+        assert(joined == response.text && "Streamed pieces should add up to the text");
+
+        daemon.stop();
+        server.join();
+
+        std::cout << "✓ UTF-8 streaming test passed" << std::endl;
+    }
+
+    void testSocketOwnership() {
+        std::cout << "Testing stale and live socket handling..." << std::endl;
+
+        // A socket file left behind by a crashed daemon
+        int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+        int bound = bind(stale, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        close(stale);
+        assert(bound == 0);
+        assert(std::filesystem::exists(socket_path));
+
+        StreamingMockModel model({"ok"});
+        Camus::CamusDaemon daemon(model, makeConfig());
+        mode_t old_mask = umask(0);
+        daemon.start();  // Must replace the stale socket
+        assert(umask(old_mask) == 0 && "The caller's umask is restored");
+        struct stat info{};
+        assert(stat(socket_path.c_str(), &info) == 0);
+        assert((info.st_mode & 0777) == (S_IRUSR | S_IWUSR) && "Only the owner may connect");
+
+        Camus::CamusDaemon second(model, makeConfig());
+        bool threw = false;
+        try {
+            second.start();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw && "A second daemon must not steal a live socket");
+
+        std::thread server([&daemon]() { daemon.run(); });
+        auto client = Camus::DaemonClient::connect(socket_path);
+        assert(client && client->getStatus().find("mock_model") != std::string::npos);
+        daemon.stop();
+        server.join();
+
+        std::cout << "✓ Socket ownership test passed" << std::endl;
+    }
+
+    void testLostConnection() {
+        std::cout << "Testing client behaviour when the daemon goes away..." << std::endl;
+
+        StreamingMockModel model({"ok"});
+        auto daemon = std::make_unique<Camus::CamusDaemon>(model, makeConfig());
+        daemon->start();
+        std::thread server([&daemon]() { daemon->run(); });
+
+        auto client = Camus::DaemonClient::connect(socket_path);
+        assert(client);
+        daemon->stop();
+        server.join();
+        daemon.reset();
+
+        bool threw = false;
+        try {
+            client->getCompletion("hello");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw && "Completion should fail once the daemon is gone");
+        assert(!client->isHealthy());
+
+        std::cout << "✓ Lost connection test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running daemon unit tests..." << std::endl;
+
+        setupTestEnvironment();
+
+        testNoDaemonFallsBack();
+        testStreamingCompletion();
+        testConstraintReachesBackend();
+        testConcurrentFanoutSubtasks();
+        testUtf8PiecesAreNotSplit();
+        testSocketOwnership();
+        testLostConnection();
+
+        cleanupTestEnvironment();
+
+        std::cout << "All daemon tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        DaemonTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All daemon component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,223 @@
+// =================================================================
+// tests/EditApplierTest.cpp
+// =================================================================
+// Unit tests for search/replace and unified-diff edit application.
+
+#include "Camus/EditApplier.hpp"
+#include "Camus/ResponseParser.hpp"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+class EditApplierTest {
+private:
+    std::string test_dir = "test_edit_project";
+
+    const std::string source =
+        "#include <iostream>\n"
+        "\n"
+        "int add(int a, int b) {\n"
+        "    return a + b;\n"
+        "}\n"
+        "\n"
+        "int main() {\n"
+        "    std::cout << add(1, 2) << std::endl;\n"
+        "    return 0;\n"
+        "}\n";
+
+public:
+    void testParseHunks() {
+        std::cout << "Testing hunk parsing..." << std::endl;
+
+        auto hunks = Camus::EditApplier::parseHunks(
+            "Some prose the model added\n"
+            "<<<<<<< SEARCH\n"
+            "    return a + b;\n"
+            "=======\n"
+            "    return a - b;\n"
+            ">>>>>>> REPLACE\n"
+            "<<<<<<< SEARCH\n"
+            "=======\n"
+            "// appended\n"
+            ">>>>>>> REPLACE\n");
+        assert(hunks.size() == 2);
+        assert(hunks[0].search == "    return a + b;");
+        assert(hunks[0].replace == "    return a - b;");
+        assert(hunks[1].search.empty());
+
+        auto diff = Camus::EditApplier::parseHunks(
+            "--- a/main.cpp\n"
+            "+++ b/main.cpp\n"
+            "@@ -3,3 +3,3 @@\n"
+            " int add(int a, int b) {\n"
+            "-    return a + b;\n"
+            "+    return b + a;\n"
+            " }\n"
+            "@@ -9,1 +9,1 @@\n"
+            "-    return 0;\n"
+            "+    return 1;\n");
+        assert(diff.size() == 2);
+        assert(diff[0].search == "int add(int a, int b) {\n    return a + b;\n}");
+        assert(diff[0].replace == "int add(int a, int b) {\n    return b + a;\n}");
+        assert(diff[1].search == "    return 0;");
+        std::cout << "✓ Hunk parsing test passed" << std::endl;
+    }
+
+    void testExactAndWhitespaceMatches() {
+        std::cout << "Testing exact and whitespace-tolerant matches..." << std::endl;
+
+        Camus::EditApplier applier;
+        auto result = applier.apply(source, {{"    return a + b;", "    return a * b;"}});
+        assert(result.success && result.fuzzy_matches == 0);
+        assert(result.content.find("return a * b;") != std::string::npos);
+        assert(result.content.size() == source.size());
+
+        // Trailing whitespace in the search text is not an error
+        result = applier.apply(source, {{"    std::cout << add(1, 2) << std::endl;  \n    return 0;  ",
+                                         "    return 3;"}});
+        assert(result.success);
+        assert(result.content.find("std::cout") == std::string::npos);
+        assert(result.content.find("    return 3;\n}") != std::string::npos);
+
+        // Whole-line deletion removes the newline as well
+        result = applier.apply(source, {{"#include <iostream>\n", ""}});
+        assert(result.success);
+        assert(result.content.rfind("\nint add", 0) == 0);
+        std::cout << "✓ Exact match test passed" << std::endl;
+    }
+
+    void testReindentAndSimilarity() {
+        std::cout << "Testing indentation and similarity matching..." << std::endl;
+
+        Camus::EditApplier applier;
+        // The model dropped the indentation; the replacement is re-indented
+        auto result = applier.apply(source, {{"return a + b;\n}", "int sum = a + b;\nreturn sum;\n}"}});
+        assert(result.success && result.fuzzy_matches == 1);
+        assert(result.content.find("    int sum = a + b;\n    return sum;\n}") != std::string::npos);
+
+        // A misremembered line still lands on the most similar window
+        result = applier.apply(source, {{"int add(int a, int b) {\n    return a+b;\n}",
+                                         "int add(int a, int b) {\n    return a + b + 0;\n}"}});
+        assert(result.success && result.fuzzy_matches == 1);
+        assert(result.content.find("return a + b + 0;") != std::string::npos);
+
+        // Nothing similar enough
+        result = applier.apply(source, {{"double divide(double x) {\n    throw 1;\n}", "x"}});
+        assert(!result.success && result.errors.size() == 1);
+        assert(result.content == source && "Failed hunks leave the content unchanged");
+        std::cout << "✓ Fuzzy matching test passed" << std::endl;
+    }
+
+    void testAmbiguousAndOrderedHunks() {
+        std::cout << "Testing hunk ordering..." << std::endl;
+
+        std::string repeated = "a();\nb();\na();\nb();\n";
+        Camus::EditApplier applier;
+        // The second hunk searches after the first, so each "a();" is hit once
+        auto result = applier.apply(repeated, {{"a();", "x();"}, {"a();", "y();"}});
+        assert(result.success);
+        assert(result.content == "x();\nb();\ny();\nb();\n");
+
+        // Appending and creating
+        result = applier.apply("", {{"", "new file"}});
+        assert(result.success && result.content == "new file\n");
+        result = applier.apply("line", {{"", "more"}});
+        assert(result.content == "line\nmore\n");
+        std::cout << "✓ Ordering test passed" << std::endl;
+    }
+
+    void testResponseParserIntegration() {
+        std::cout << "Testing EDIT blocks in ResponseParser..." << std::endl;
+
+        fs::create_directories(test_dir + "/src");
+        {
+            std::ofstream file(test_dir + "/src/main.cpp");
+            file << source;
+        }
+
+        std::string response =
+            "--- EDIT: src/main.cpp ---\n"
+            "<<<<<<< SEARCH\n"
+            "    return a + b;\n"
+            "=======\n"
+            "    return a + b + 1;\n"
+            ">>>>>>> REPLACE\n"
+            "--- FILE: src/extra.cpp ---\n"
+            "int extra() { return 1; }\n";
+
+        Camus::ResponseParser parser(test_dir);
+        auto modifications = parser.parseResponse(response);
+        assert(modifications.size() == 2);
+        for (const auto& modification : modifications) {
+            if (modification.file_path == "src/main.cpp") {
+                assert(!modification.is_new_file);
+                assert(modification.new_content.find("return a + b + 1;") != std::string::npos);
+                assert(modification.new_content.find("int main()") != std::string::npos);
+            } else {
+                assert(modification.file_path == "src/extra.cpp" && modification.is_new_file);
+            }
+        }
+        assert(parser.getLastParseStats().edit_blocks_applied == 1);
+
+        // One changed line in a long file costs a few lines of output
+        std::string long_source;
+        for (int i = 0; i < 1000; ++i) {
+            long_source += "int value" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+        }
+        {
+            std::ofstream file(test_dir + "/src/values.cpp");
+            file << long_source;
+        }
+        std::string edit_response =
+            "--- EDIT: src/values.cpp ---\n"
+            "<<<<<<< SEARCH\n"
+            "int value500 = 500;\n"
+            "=======\n"
+            "int value500 = -500;\n"
+            ">>>>>>> REPLACE\n";
+        Camus::ResponseParser long_parser(test_dir);
+        auto long_modifications = long_parser.parseResponse(edit_response);
+        assert(long_modifications.size() == 1);
+        assert(long_modifications[0].new_content.find("int value500 = -500;\nint value501") != std::string::npos);
+        assert(long_modifications[0].new_content.size() > 10 * edit_response.size());
+
+        Camus::ResponseParser failing(test_dir);
+        auto none = failing.parseResponse(
+            "--- EDIT: src/main.cpp ---\n<<<<<<< SEARCH\nnot in the file at all\n=======\nx\n>>>>>>> REPLACE\n");
+        assert(none.empty());
+        assert(failing.getLastParseStats().parsing_errors >= 1);
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ ResponseParser integration test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running edit applier unit tests..." << std::endl;
+
+        testParseHunks();
+        testExactAndWhitespaceMatches();
+        testReindentAndSimilarity();
+        testAmbiguousAndOrderedHunks();
+        testResponseParserIntegration();
+
+        std::cout << "All edit applier tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        EditApplierTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All edit applier component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
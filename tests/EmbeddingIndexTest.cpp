@@ -0,0 +1,300 @@
+// =================================================================
+// tests/EmbeddingIndexTest.cpp
+// =================================================================
+// Unit tests for code chunking, the HNSW index and the embedding index.
+
+#include "Camus/EmbeddingIndex.hpp"
+#include "Camus/HnswIndex.hpp"
+#include "Camus/ProjectScanner.hpp"
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Deterministic bag-of-words embedder: each word adds to a hashed dimension
+ */
+class HashingEmbedder : public Camus::TextEmbedder {
+public:
+    explicit HashingEmbedder(std::string id = "hashing-64") : m_id(std::move(id)) {}
+
+    std::vector<float> embed(const std::string& text) override {
+        calls++;
+        std::vector<float> vector(64, 0.0f);
+        std::string word;
+        for (char ch : text + " ") {
+            if (std::isalnum(static_cast<unsigned char>(ch))) {
+                word += static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+            } else if (!word.empty()) {
+                vector[std::hash<std::string>()(word) % vector.size()] += 1.0f;
+                word.clear();
+            }
+        }
+        return vector;
+    }
+
+    size_t dimensions() const override { return 64; }
+    std::string modelId() const override { return m_id; }
+
+    size_t calls = 0;
+
+private:
+    std::string m_id;
+};
+
+class EmbeddingIndexTest {
+private:
+    std::string test_dir = "test_embedding_index";
+
+    void writeFile(const std::string& relative_path, const std::string& content) {
+        fs::create_directories((fs::path(test_dir) / relative_path).parent_path());
+        std::ofstream(fs::path(test_dir) / relative_path) << content;
+    }
+
+    void setupProject() {
+        fs::remove_all(test_dir);
+        writeFile("src/storage.cpp",
+                  "// Persists records\n"
+                  "void openDatabaseConnection() {\n    connect(database, pool);\n}\n\n"
+                  "void closeDatabaseConnection() {\n    disconnect(database, pool);\n}\n");
+        writeFile("src/render.cpp",
+                  "// Draws frames\n"
+                  "void drawSprite() {\n    blit(texture, screen);\n}\n");
+        writeFile("src/parse.cpp",
+                  "// Reads arguments\n"
+                  "void parseArguments() {\n    tokenize(argv, options);\n}\n");
+    }
+
+public:
+    void testChunking() {
+        std::cout << "Testing structural chunking..." << std::endl;
+
+        std::ostringstream source;
+        source << "#include <vector>\n\n";
+        source << "// First function\nint first() {\n    return 1;\n}\n\n";
+        source << "int second() {\n";
+        for (int i = 0; i < 30; ++i) {
+            source << "    call(" << i << ");\n";
+        }
+        source << "}\n";
+
+        Camus::EmbeddingIndexConfig config;
+        config.min_chunk_lines = 3;
+        config.max_chunk_lines = 12;
+        auto chunks = Camus::CodeChunker::chunk("a.cpp", source.str(), config);
+
+        assert(chunks.size() >= 4 && "Long function should be split");
+        assert(chunks.front().start_line == 1 && "First chunk starts at line 1");
+        assert(chunks.front().text.find("int first()") != std::string::npos &&
+               "Short include block should merge with the next declaration");
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            assert(chunks[i].end_line - chunks[i].start_line + 1 <= config.max_chunk_lines &&
+                   "Chunks respect the line limit");
+            assert(chunks[i].file_path == "a.cpp");
+            if (i > 0) {
+                assert(chunks[i].start_line > chunks[i - 1].end_line && "Chunks do not overlap");
+            }
+        }
+        assert(chunks.back().text.find("}") != std::string::npos && "Last chunk closes the function");
+
+        assert(Camus::CodeChunker::chunk("empty.cpp", "\n\n").empty() && "Blank files produce no chunks");
+
+        std::cout << "✓ Structural chunking test passed" << std::endl;
+    }
+
+    void testHnswRecall() {
+        std::cout << "Testing HNSW recall against brute force..." << std::endl;
+
+        const size_t dimensions = 24;
+        const size_t count = 1500;
+        std::mt19937 rng(42);
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        auto random_vector = [&]() {
+            std::vector<float> vector(dimensions);
+            for (auto& value : vector) value = normal(rng);
+            return vector;
+        };
+        auto cosine = [&](const std::vector<float>& a, const std::vector<float>& b) {
+            double dot = 0, na = 0, nb = 0;
+            for (size_t i = 0; i < dimensions; ++i) {
+                dot += a[i] * b[i];
+                na += a[i] * a[i];
+                nb += b[i] * b[i];
+            }
+            return dot / std::sqrt(na * nb);
+        };
+
+        Camus::HnswIndex index(dimensions);
+        std::vector<std::vector<float>> vectors;
+        for (size_t i = 0; i < count; ++i) {
+            vectors.push_back(random_vector());
+            assert(index.add(vectors.back()) == i && "Ids are consecutive");
+        }
+
+        size_t found = 0;
+        const size_t queries = 50, k = 10;
+        for (size_t q = 0; q < queries; ++q) {
+            auto query = random_vector();
+            std::vector<std::pair<double, uint32_t>> exact;
+            for (uint32_t i = 0; i < count; ++i) {
+                exact.emplace_back(cosine(query, vectors[i]), i);
+            }
+            std::partial_sort(exact.begin(), exact.begin() + k, exact.end(), std::greater<>());
+            std::unordered_set<uint32_t> truth;
+            for (size_t i = 0; i < k; ++i) truth.insert(exact[i].second);
+
+            auto results = index.search(query, k);
+            assert(results.size() == k);
+            for (const auto& result : results) {
+                found += truth.count(result.first);
+            }
+        }
+        double recall = static_cast<double>(found) / (queries * k);
+        std::cout << "  recall@10 = " << recall << std::endl;
+        assert(recall >= 0.9 && "HNSW recall should be close to exact search");
+
+        // Deleted nodes are never returned, and compaction keeps the live ones
+        auto before = index.search(vectors[7], 1);
+        assert(before.front().first == 7 && "A stored vector is its own nearest neighbour");
+        index.remove(7);
+        auto after = index.search(vectors[7], 5);
+        for (const auto& result : after) {
+            assert(result.first != 7 && "Deleted node must not be returned");
+        }
+
+        std::vector<uint32_t> new_ids;
+        auto compacted = index.compacted(new_ids);
+        assert(compacted.size() == count - 1 && compacted.deletedCount() == 0);
+        assert(new_ids[7] == UINT32_MAX && new_ids[8] == 7 && "Ids after the deleted node shift down");
+        assert(compacted.search(vectors[8], 1).front().first == 7);
+
+        // Save and load round trip
+        std::stringstream buffer;
+        index.save(buffer);
+        auto loaded = Camus::HnswIndex::load(buffer);
+        assert(loaded.size() == index.size() && loaded.isDeleted(7));
+        auto query = random_vector();
+        auto original_results = index.search(query, k);
+        auto loaded_results = loaded.search(query, k);
+        assert(original_results == loaded_results && "Loaded index answers identically");
+
+        std::stringstream garbage("not an index");
+        bool threw = false;
+        try {
+            Camus::HnswIndex::load(garbage);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw && "Loading garbage should throw");
+
+        std::cout << "✓ HNSW recall test passed" << std::endl;
+    }
+
+    void testIncrementalIndex() {
+        std::cout << "Testing incremental embedding index..." << std::endl;
+
+        setupProject();
+        std::string index_dir = test_dir + "/.camus/embeddings";
+        HashingEmbedder embedder;
+        Camus::EmbeddingIndexConfig config;
+        config.min_chunk_lines = 1;
+        config.max_chunk_lines = 4;
+
+        {
+            Camus::EmbeddingIndex index(index_dir, embedder, config);
+            assert(!index.load() && "No index on disk yet");
+
+            Camus::ProjectScanner scanner(test_dir);
+            scanner.addIgnorePattern(".camus/");
+            auto delta = scanner.scanChanges(index.knownFiles());
+            assert(delta.changed.size() == 3 && delta.removed.empty());
+
+            auto stats = index.update(delta, test_dir);
+            assert(stats.files_embedded == 3 && stats.chunks_embedded >= 4);
+            assert(index.chunkCount() == stats.chunks_embedded);
+
+            auto hits = index.query("database connection", 3);
+            assert(!hits.empty() && hits.front().chunk.file_path == "src/storage.cpp" &&
+                   "Query should retrieve the storage code");
+            assert(hits.front().chunk.start_line >= 1 && hits.front().chunk.text.empty());
+            auto scores = Camus::EmbeddingIndex::fileScores(hits);
+            assert(scores.count("src/storage.cpp") == 1);
+            index.save();
+        }
+
+        // A reloaded index only embeds what changed
+        {
+            Camus::EmbeddingIndex index(index_dir, embedder, config);
+            assert(index.load() && "Saved index should load");
+            size_t chunks_before = index.chunkCount();
+
+            Camus::ProjectScanner scanner(test_dir);
+            scanner.addIgnorePattern(".camus/");
+            auto unchanged = scanner.scanChanges(index.knownFiles());
+            assert(unchanged.changed.empty() && unchanged.removed.empty() && "Nothing changed yet");
+
+            fs::remove(fs::path(test_dir) / "src/parse.cpp");
+            writeFile("src/render.cpp", "// Draws frames\nvoid drawSprite() {\n    blit(texture, screen, shader);\n}\n");
+            auto delta = scanner.scanChanges(index.knownFiles());
+            assert(delta.changed.size() == 1 && delta.changed[0] == "src/render.cpp");
+            assert(delta.removed.size() == 1 && delta.removed[0] == "src/parse.cpp");
+
+            size_t calls_before = embedder.calls;
+            auto stats = index.update(delta, test_dir);
+            assert(stats.files_embedded == 1 && stats.files_removed == 1);
+            assert(embedder.calls - calls_before == stats.chunks_embedded && "Only the changed file is embedded");
+            assert(index.chunkCount() == chunks_before - stats.chunks_removed + stats.chunks_embedded);
+            assert(index.knownFiles().count("src/parse.cpp") == 0);
+
+            for (const auto& hit : index.query("parse arguments tokenize", 10)) {
+                assert(hit.chunk.file_path != "src/parse.cpp" && "Removed file must not be retrieved");
+            }
+            index.save();
+        }
+
+        // An index built by another model is discarded
+        {
+            HashingEmbedder other("hashing-64-v2");
+            Camus::EmbeddingIndex index(index_dir, other, config);
+            assert(!index.load() && index.chunkCount() == 0 && index.knownFiles().empty());
+        }
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Incremental embedding index test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running EmbeddingIndex tests..." << std::endl;
+        std::cout << "===============================================" << std::endl << std::endl;
+
+        testChunking();
+        std::cout << std::endl;
+
+        testHnswRecall();
+        std::cout << std::endl;
+
+        testIncrementalIndex();
+        std::cout << std::endl;
+    }
+};
+
+int main() {
+    try {
+        EmbeddingIndexTest tests;
+        tests.runAllTests();
+
+        std::cout << "🎉 All EmbeddingIndex tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
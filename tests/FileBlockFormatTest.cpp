@@ -0,0 +1,162 @@
+// =================================================================
+// tests/FileBlockFormatTest.cpp
+// =================================================================
+// Unit tests for the constrained FILE block format and its strict parser.
+
+#include "Camus/FileBlockFormat.hpp"
+#include "Camus/ResponseParser.hpp"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+class FileBlockFormatTest {
+private:
+    std::string test_dir = "test_file_block_project";
+
+public:
+    void testGrammar() {
+        std::cout << "Testing GBNF grammar text..." << std::endl;
+
+        const std::string& grammar = Camus::FileBlockFormat::grammar();
+        assert(grammar.rfind("root ", 0) == 0 && "The start rule comes first");
+        assert(grammar.find("root   ::= \"NO CHANGES\\n\" | block+") != std::string::npos);
+        assert(grammar.find("\"--- FILE: \" path \" ---\\n\"") != std::string::npos);
+        // A '-' before the closing bracket is a literal, not a range
+        assert(grammar.find("[^-") == std::string::npos);
+
+        const std::string& schema = Camus::FileBlockFormat::jsonSchema();
+        assert(schema.find("\"files\"") != std::string::npos);
+        assert(schema.find("\"required\":[\"path\",\"content\"]") != std::string::npos);
+        assert(schema.find("\"minItems\":0") != std::string::npos && "An empty change set is allowed");
+        std::cout << "✓ Grammar test passed" << std::endl;
+    }
+
+    void testJsonConversion() {
+        std::cout << "Testing JSON schema output conversion..." << std::endl;
+
+        std::string blocks = Camus::FileBlockFormat::fromJson(R"({"files": [
+            {"path": "src/a.cpp", "content": "int a = 1;"},
+            {"path": "", "content": "dropped"},
+            {"path": "bad\npath", "content": "dropped"},
+            {"path": "README.md", "content": "```\ncode\n```\n"}
+        ]})");
+        assert(blocks == "--- FILE: src/a.cpp ---\nint a = 1;\n"
+                         "--- FILE: README.md ---\n```\ncode\n```\n");
+
+        assert(Camus::FileBlockFormat::fromJson(R"({"files": []})").empty());
+
+        bool threw = false;
+        try {
+            Camus::FileBlockFormat::fromJson("{\"text\": \"no files\"}");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+
+        threw = false;
+        try {
+            Camus::FileBlockFormat::fromJson("not json");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        std::cout << "✓ JSON conversion test passed" << std::endl;
+    }
+
+    void testMarkerParsing() {
+        std::cout << "Testing marker recognition..." << std::endl;
+
+        std::string path;
+        assert(Camus::FileBlockFormat::parseMarker("--- FILE: src/main.cpp ---", &path));
+        assert(path == "src/main.cpp");
+        assert(Camus::FileBlockFormat::parseMarker("--- FILE: a.h ---\r", &path));
+        assert(path == "a.h");
+        assert(!Camus::FileBlockFormat::parseMarker("--- FILE:  ---", nullptr));
+        assert(!Camus::FileBlockFormat::parseMarker("--- FILE: ---", nullptr));
+        assert(!Camus::FileBlockFormat::parseMarker("// --- FILE: a.h ---", nullptr));
+        assert(!Camus::FileBlockFormat::parseMarker("--- END ---", nullptr));
+        std::cout << "✓ Marker parsing test passed" << std::endl;
+    }
+
+    void testConstrainedParsing() {
+        std::cout << "Testing the constrained parser path..." << std::endl;
+
+        fs::create_directories(test_dir + "/src");
+        std::string response =
+            "--- FILE: src/errors.cpp ---\n"
+            "#include <stdexcept>\n"
+            "// Error: reported below\n"
+            "void fail() {\n"
+            "    throw std::runtime_error(\"Failed to open\");\n"
+            "}\n"
+            "--- FILE: src/notes.txt ---\n"
+            "--- not a marker\n"
+            "done\n";
+
+        // The heuristic parser treats "Error:" and "Failed to" as a refusal
+        Camus::ResponseParser heuristic(test_dir);
+        auto rejected = heuristic.parseResponse(response);
+        assert(rejected.empty());
+
+        Camus::ResponseParser parser(test_dir);
+        parser.setAllowedExtensions({".cpp", ".txt"});
+        parser.setConstrainedFormat(true);
+        auto modifications = parser.parseResponse(response);
+        assert(modifications.size() == 2);
+        for (const auto& modification : modifications) {
+            if (modification.file_path == "src/errors.cpp") {
+                assert(modification.new_content.find("Failed to open") != std::string::npos);
+            } else {
+                assert(modification.file_path == "src/notes.txt");
+                assert(modification.new_content.find("--- not a marker") != std::string::npos);
+            }
+        }
+
+        // Output that does not start with a marker takes the heuristic path
+        Camus::ResponseParser fallback(test_dir);
+        fallback.setConstrainedFormat(true);
+        fallback.setAllowedExtensions({".cpp"});
+        auto recovered = fallback.parseResponse("Here you go:\n--- FILE: src/ok.cpp ---\nint ok() { return 1; }\n");
+        assert(recovered.size() == 1);
+
+        // The grammar's empty alternative is an answer, not a format error
+        Camus::ResponseParser unchanged(test_dir);
+        unchanged.setConstrainedFormat(true);
+        assert(unchanged.parseResponse("NO CHANGES\n").empty());
+        assert(unchanged.getLastParseStats().error_messages.empty());
+        assert(Camus::FileBlockFormat::isNoChanges("  NO CHANGES \r\n"));
+        assert(!Camus::FileBlockFormat::isNoChanges("NO CHANGES to src/a.cpp"));
+        assert(!Camus::FileBlockFormat::isNoChanges(""));
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Constrained parsing test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running FILE block format unit tests..." << std::endl;
+
+        testGrammar();
+        testJsonConversion();
+        testMarkerParsing();
+        testConstrainedParsing();
+
+        std::cout << "All FILE block format tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        FileBlockFormatTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All FILE block format component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,355 @@
+// =================================================================
+// tests/HttpApiServerTest.cpp
+// =================================================================
+// Unit tests for the API request queue and the OpenAI-compatible
+// HTTP server.
+
+#include "Camus/ApiRequestQueue.hpp"
+#include "Camus/HttpApiServer.hpp"
+#include "Camus/ModelOrchestrator.hpp"
+#include "Camus/ModelRegistry.hpp"
+#include "httplib.h"
+#include "nlohmann/json.hpp"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+/**
+ * @brief Backend that streams a fixed reply piece by piece
+ */
+class StreamingMockModel : public Camus::LlmInteraction {
+public:
+    explicit StreamingMockModel(std::string name) : m_name(std::move(name)) {}
+
+    std::string getCompletion(const std::string& prompt) override {
+        Camus::InferenceRequest request;
+        request.prompt = prompt;
+        return getCompletionWithMetadata(request).text;
+    }
+
+    Camus::InferenceResponse getCompletionWithMetadata(const Camus::InferenceRequest& request) override {
+        Camus::InferenceResponse response;
+        for (const std::string piece : {"Hello", " from ", m_name.c_str()}) {
+            if (request.on_token) {
+                request.on_token(piece);
+            }
+            response.text += piece;
+        }
+        response.tokens_generated = 3;
+        return response;
+    }
+
+    Camus::ModelMetadata getModelMetadata() const override {
+        Camus::ModelMetadata metadata;
+        metadata.name = m_name;
+        metadata.provider = "mock";
+        metadata.capabilities = {Camus::ModelCapability::FAST_INFERENCE};
+        metadata.performance.max_context_tokens = 4096;
+        metadata.performance.max_output_tokens = 2048;
+        metadata.is_available = true;
+        metadata.is_healthy = true;
+        return metadata;
+    }
+
+    bool isHealthy() const override { return true; }
+    bool performHealthCheck() override { return true; }
+    Camus::ModelPerformance getCurrentPerformance() const override { return Camus::ModelPerformance(); }
+    std::string getModelId() const override { return m_name; }
+
+private:
+    std::string m_name;
+};
+
+class HttpApiServerTest {
+private:
+    std::string test_config_path = "test_api_models.yml";
+
+    // Executor whose requests block until released
+    struct Gate {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool open = false;
+        std::atomic<int> started{0};
+
+        Camus::PipelineResponse run(const Camus::PipelineRequest& request) {
+            started++;
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this]() { return open; });
+            Camus::PipelineResponse response;
+            response.request_id = request.request_id;
+            response.response_text = "done";
+            response.success = true;
+            return response;
+        }
+
+        void release() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                open = true;
+            }
+            cv.notify_all();
+        }
+    };
+
+    std::shared_ptr<Camus::ApiJob> makeJob(const std::string& client, const std::string& id = "req") {
+        Camus::PipelineRequest request;
+        request.request_id = id;
+        request.prompt = "prompt";
+        return std::make_shared<Camus::ApiJob>(request, client);
+    }
+
+    static void waitFor(const std::function<bool()>& condition) {
+        auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!condition() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(5ms);
+        }
+        assert(condition() && "Condition not reached in time");
+    }
+
+    void createTestConfig() {
+        std::ofstream config(test_config_path);
+        config << R"(
+models:
+  fast_model:
+    type: "test_type"
+    path: "/test/fast_model.gguf"
+    name: "Fast Test Model"
+    capabilities:
+      - "FAST_INFERENCE"
+    performance:
+      max_context_tokens: 4096
+      max_output_tokens: 2048
+)";
+    }
+
+public:
+    void testAdmissionLimits() {
+        std::cout << "Testing queue admission limits..." << std::endl;
+
+        Gate gate;
+        Camus::ApiQueueConfig config;
+        config.worker_threads = 1;
+        config.max_queue_size = 2;
+        config.max_requests_per_client = 2;
+        Camus::ApiRequestQueue queue([&gate](const Camus::PipelineRequest& r) { return gate.run(r); }, config);
+
+        auto running = makeJob("a");
+        Camus::AdmissionResult first = queue.submit(running);
+        assert(first == Camus::AdmissionResult::ACCEPTED);
+        waitFor([&gate]() { return gate.started == 1; });
+
+        Camus::AdmissionResult second = queue.submit(makeJob("a"));
+        Camus::AdmissionResult third = queue.submit(makeJob("a"));
+        assert(second == Camus::AdmissionResult::ACCEPTED);
+        assert(third == Camus::AdmissionResult::CLIENT_LIMIT &&
+               "Third request from one client should be refused");
+        assert(queue.getClientLoad("a") == 2);
+
+        Camus::AdmissionResult other = queue.submit(makeJob("b"));
+        Camus::AdmissionResult overflow = queue.submit(makeJob("c"));
+        assert(other == Camus::AdmissionResult::ACCEPTED);
+        assert(overflow == Camus::AdmissionResult::QUEUE_FULL &&
+               "Queue holds at most two waiting requests");
+
+        gate.release();
+        assert(running->waitUntilDone(5000ms));
+        assert(running->getResponse().success);
+        waitFor([&queue]() { return queue.getStats().completed == 3; });
+
+        auto stats = queue.getStats();
+        assert(stats.rejected_client_limit == 1 && stats.rejected_queue_full == 1);
+        assert(queue.getClientLoad("a") == 0 && "Load should be released after completion");
+
+        queue.shutdown();
+        Camus::AdmissionResult late = queue.submit(makeJob("a"));
+        assert(late == Camus::AdmissionResult::SHUTTING_DOWN);
+
+        std::cout << "✓ Admission limits test passed" << std::endl;
+    }
+
+    void testStreamingChunks() {
+        std::cout << "Testing streamed output through a job..." << std::endl;
+
+        Camus::ApiRequestQueue queue([](const Camus::PipelineRequest& request) {
+            Camus::PipelineResponse response;
+            for (const std::string piece : {"a", "b", "c"}) {
+                request.on_token(piece);
+                response.response_text += piece;
+                std::this_thread::sleep_for(10ms);
+            }
+            response.success = true;
+            return response;
+        });
+
+        auto job = makeJob("client");
+        Camus::AdmissionResult admitted = queue.submit(job);
+        assert(admitted == Camus::AdmissionResult::ACCEPTED);
+
+        std::string streamed;
+        std::string text;
+        Camus::ChunkStatus status;
+        while ((status = job->nextChunk(text, 1000ms)) != Camus::ChunkStatus::FINISHED) {
+            if (status == Camus::ChunkStatus::DATA) {
+                streamed += text;
+            }
+        }
+        assert(streamed == "abc" && "Streamed text should match the response");
+        assert(job->getResponse().response_text == "abc");
+
+        std::cout << "✓ Streaming chunks test passed" << std::endl;
+    }
+
+    void testUnstreamedResponseIsOneChunk() {
+        std::cout << "Testing delivery of a response that was not streamed..." << std::endl;
+
+        // A cache hit never calls on_token
+        Camus::ApiRequestQueue queue([](const Camus::PipelineRequest&) {
+            Camus::PipelineResponse response;
+            response.response_text = "cached";
+            response.success = true;
+            return response;
+        });
+
+        auto job = makeJob("client");
+        queue.submit(job);
+        std::string text;
+        while (job->nextChunk(text, 1000ms) == Camus::ChunkStatus::TIMEOUT) {
+        }
+        assert(text == "cached" && "Whole response should arrive as a single chunk");
+        assert(job->nextChunk(text, 10ms) == Camus::ChunkStatus::FINISHED);
+
+        std::cout << "✓ Unstreamed response test passed" << std::endl;
+    }
+
+    void testCancellation() {
+        std::cout << "Testing cancellation of queued requests..." << std::endl;
+
+        Gate gate;
+        Camus::ApiQueueConfig config;
+        config.worker_threads = 1;
+        Camus::ApiRequestQueue queue([&gate](const Camus::PipelineRequest& r) { return gate.run(r); }, config);
+
+        auto first = makeJob("a", "first");
+        auto second = makeJob("a", "second");
+        queue.submit(first);
+        waitFor([&gate]() { return gate.started == 1; });
+        queue.submit(second);
+        second->cancel();
+
+        gate.release();
+        assert(second->waitUntilDone(5000ms));
+        assert(!second->getResponse().success && "Cancelled request should not run");
+        assert(gate.started == 1 && "Executor should not see the cancelled request");
+        assert(queue.getStats().cancelled == 1);
+
+        std::cout << "✓ Cancellation test passed" << std::endl;
+    }
+
+    void testHttpEndpoints() {
+        std::cout << "Testing HTTP endpoints..." << std::endl;
+
+        createTestConfig();
+        Camus::RegistryConfig registry_config;
+        registry_config.auto_discover = false;
+        registry_config.enable_health_checks = false;
+        Camus::ModelRegistry registry(registry_config);
+        registry.registerModelFactory("test_type",
+            [](const Camus::ModelConfig& cfg) -> std::shared_ptr<Camus::LlmInteraction> {
+                return std::make_shared<StreamingMockModel>(cfg.name);
+            });
+        registry.loadFromConfig(test_config_path);
+
+        Camus::OrchestratorConfig orchestrator_config;
+        orchestrator_config.enable_caching = false;
+        Camus::ModelOrchestrator orchestrator(registry, orchestrator_config);
+
+        Camus::ApiServerConfig config;
+        config.port = 0;
+        config.api_keys = {"secret"};
+        Camus::HttpApiServer server(orchestrator, registry, config);
+        int port = server.start();
+        assert(port > 0 && server.isRunning());
+
+        httplib::Client client("127.0.0.1", port);
+        httplib::Headers auth = {{"Authorization", "Bearer secret"}};
+
+        auto health = client.Get("/health");
+        assert(health && health->status == 200);
+
+        auto denied = client.Post("/v1/completions", R"({"prompt":"hi"})", "application/json");
+        assert(denied && denied->status == 401 && "Missing key should be rejected");
+
+        auto models = client.Get("/v1/models", auth);
+        assert(models && models->status == 200);
+        auto model_list = nlohmann::json::parse(models->body);
+        assert(model_list["data"].size() == 2 && "Served name plus the configured model");
+
+        auto unknown = client.Post("/v1/completions", auth, R"({"model":"nope","prompt":"hi"})", "application/json");
+        assert(unknown && unknown->status == 404);
+
+        auto completion = client.Post("/v1/completions", auth,
+            R"({"model":"fast_model","prompt":"say hello","max_tokens":16})", "application/json");
+        assert(completion && completion->status == 200);
+        auto body = nlohmann::json::parse(completion->body);
+        assert(body["object"] == "text_completion");
+        assert(body["choices"][0]["text"].get<std::string>().find("Hello") == 0);
+        assert(body["usage"]["completion_tokens"] == 3);
+
+        auto stream = client.Post("/v1/chat/completions", auth,
+            R"({"messages":[{"role":"user","content":"say hello"}],"stream":true})", "application/json");
+        assert(stream && stream->status == 200);
+        assert(stream->get_header_value("Content-Type") == "text/event-stream");
+        assert(stream->body.find("\"role\":\"assistant\"") != std::string::npos);
+        assert(stream->body.find("\"finish_reason\":\"stop\"") != std::string::npos);
+        assert(stream->body.rfind("data: [DONE]\n\n") == stream->body.size() - 14 &&
+               "Stream should end with the [DONE] sentinel");
+
+        auto metrics = client.Get("/metrics");
+        assert(metrics && metrics->body.find("camus_api_completions_total 2") != std::string::npos);
+        assert(server.getMetrics().unauthorized == 1);
+        assert(server.getMetrics().streamed_responses == 1);
+
+        server.stop();
+        assert(!server.isRunning());
+        fs::remove(test_config_path);
+
+        std::cout << "✓ HTTP endpoints test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running HTTP API unit tests..." << std::endl;
+
+        testAdmissionLimits();
+        testStreamingChunks();
+        testUnstreamedResponseIsOneChunk();
+        testCancellation();
+        testHttpEndpoints();
+
+        std::cout << "All HTTP API tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        HttpApiServerTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All HTTP API component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,165 @@
+// =================================================================
+// tests/LazyLlmInteractionTest.cpp
+// =================================================================
+// Unit tests for deferred backend construction.
+
+#include "Camus/LazyLlmInteraction.hpp"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+#include <atomic>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Backend that echoes prompts and counts constructions
+ */
+class EchoModel : public Camus::LlmInteraction {
+public:
+    explicit EchoModel(std::atomic<int>& constructed) { constructed++; }
+
+    std::string getCompletion(const std::string& prompt) override { return "echo:" + prompt; }
+    Camus::ModelMetadata getModelMetadata() const override {
+        Camus::ModelMetadata metadata;
+        metadata.name = "echo";
+        return metadata;
+    }
+    bool isHealthy() const override { return true; }
+    bool performHealthCheck() override { return true; }
+    Camus::ModelPerformance getCurrentPerformance() const override { return Camus::ModelPerformance(); }
+    std::string getModelId() const override { return "echo-loaded"; }
+    std::string getBackendEndpoint() const override { return "echo:server"; }
+};
+
+class LazyLlmInteractionTest {
+public:
+    void testDefersConstruction() {
+        std::cout << "Testing construction on first use..." << std::endl;
+
+        std::atomic<int> constructed{0};
+        Camus::LazyLlmInteraction lazy([&constructed]() {
+            return std::make_unique<EchoModel>(constructed);
+        }, "echo.gguf");
+
+        // Cheap queries never load the backend
+        assert(!lazy.isLoaded());
+        assert(lazy.getModelId() == "echo.gguf");
+        assert(lazy.isHealthy());
+        lazy.cleanup();
+        assert(constructed == 0);
+
+        std::string first = lazy.getCompletion("a");
+        assert(first == "echo:a");
+        assert(lazy.isLoaded());
+        assert(lazy.getModelId() == "echo-loaded");
+
+        std::string second = lazy.getCompletion("b");
+        assert(second == "echo:b");
+        assert(lazy.getModelMetadata().name == "echo");
+        assert(constructed == 1 && "The backend is built exactly once");
+
+        std::cout << "✓ Deferred construction test passed" << std::endl;
+    }
+
+    void testFailedFactory() {
+        std::cout << "Testing a backend that fails to load..." << std::endl;
+
+        int attempts = 0;
+        Camus::LazyLlmInteraction lazy([&attempts]() -> std::unique_ptr<Camus::LlmInteraction> {
+            attempts++;
+            return nullptr;
+        }, "missing.gguf");
+
+        bool threw = false;
+        try {
+            lazy.getCompletion("a");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        assert(!lazy.isHealthy() && "A failed load is reported as unhealthy");
+        assert(!lazy.performHealthCheck());
+        assert(attempts == 1 && "A failed load is not retried on every call");
+
+        std::cout << "✓ Failed factory test passed" << std::endl;
+    }
+
+    void testPrefetchDoesNotBlock() {
+        std::cout << "Testing background model-file prefetch..." << std::endl;
+
+        std::string path = "test_lazy_model.gguf";
+        {
+            std::ofstream file(path, std::ios::binary);
+            std::string block(1 << 20, 'x');
+            for (int i = 0; i < 4; ++i) {
+                file << block;
+            }
+        }
+
+        std::atomic<int> constructed{0};
+        {
+            Camus::LazyLlmInteraction lazy([&constructed]() {
+                return std::make_unique<EchoModel>(constructed);
+            }, "prefetched.gguf", path);
+            assert(!lazy.isLoaded());
+            std::string response = lazy.getCompletion("warm");
+            assert(response == "echo:warm");
+        }
+        assert(constructed == 1);
+
+        // Prefetching a missing file is harmless
+        {
+            Camus::LazyLlmInteraction lazy([&constructed]() {
+                return std::make_unique<EchoModel>(constructed);
+            }, "absent.gguf", "does_not_exist.gguf");
+        }
+        assert(constructed == 1);
+
+        fs::remove(path);
+        std::cout << "✓ Prefetch test passed" << std::endl;
+    }
+
+    void testBackendEndpointIsStable() {
+        std::cout << "Testing the backend endpoint across the load..." << std::endl;
+
+        std::atomic<int> constructed{0};
+        Camus::LazyLlmInteraction lazy([&constructed]() {
+            return std::make_unique<EchoModel>(constructed);
+        }, "echo.gguf", "", "echo:server");
+
+        // The limiter key must not change when the backend loads
+        assert(lazy.getBackendEndpoint() == "echo:server");
+        assert(constructed == 0 && "Reporting the endpoint should not load the backend");
+        lazy.getCompletion("a");
+        assert(lazy.getBackendEndpoint() == "echo:server");
+
+        std::cout << "✓ Backend endpoint test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running lazy backend unit tests..." << std::endl;
+
+        testDefersConstruction();
+        testFailedFactory();
+        testPrefetchDoesNotBlock();
+        testBackendEndpointIsStable();
+
+        std::cout << "All lazy backend tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        LazyLlmInteractionTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All lazy backend component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -5,6 +5,7 @@
 
 #include "Camus/LoadBalancer.hpp"
 #include "Camus/ModelRegistry.hpp"
+#include "Camus/StringInterner.hpp"
 #include <iostream>
 #include <cassert>
 #include <fstream>
@@ -343,6 +344,15 @@ public:
         instance = m_load_balancer->getInstance(instance_id);
         assert(instance == nullptr && "Should not find removed instance");
         
+        // Churn reuses the freed slot instead of interning a new id each time
+        size_t interned = Camus::StringInterner::instances().size();
+        for (int i = 0; i < 10; ++i) {
+            std::string replacement = m_load_balancer->createInstance("test_model_a");
+            assert(replacement == instance_id && "Replacement should take the freed slot");
+            assert(m_load_balancer->removeInstance(replacement));
+        }
+        assert(Camus::StringInterner::instances().size() == interned && "Churn should not grow the interner");
+        
         std::cout << "✓ Instance removal test passed" << std::endl;
     }
     
@@ -442,6 +452,8 @@ public:
         auto result = m_load_balancer->selectInstance("non_existent_model", context);
         assert(result.selected_instance_id.empty() && "Should fail for non-existent model");
         assert(!result.selection_reason.empty() && "Should provide error reason");
+        assert(Camus::StringInterner::models().find("non_existent_model") == Camus::INVALID_INTERNED_ID &&
+               "Lookups should not intern unknown names");
         
         // Try to get non-existent instance
         auto* instance = m_load_balancer->getInstance("non_existent_instance");
@@ -0,0 +1,251 @@
+// =================================================================
+// tests/LogReducerTest.cpp
+// =================================================================
+// Unit tests for LogReducer component.
+
+#include "Camus/LogReducer.hpp"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+#include <string>
+
+class LogReducerTest {
+private:
+    std::string test_dir;
+
+    void setupTestEnvironment() {
+        test_dir = "test_log_reducer_tmp";
+        std::filesystem::create_directories(test_dir + "/src");
+        std::ofstream source(test_dir + "/src/widget.cpp");
+        for (int i = 1; i <= 20; ++i) {
+            source << (i == 12 ? "    int value = missing_symbol;" : "// line " + std::to_string(i)) << "\n";
+        }
+    }
+
+    void cleanupTestEnvironment() {
+        std::filesystem::remove_all(test_dir);
+    }
+
+public:
+    void testGccDiagnosticsAndDeduplication() {
+        std::cout << "Testing GCC diagnostics and deduplication..." << std::endl;
+
+        std::string log;
+        for (int i = 0; i < 5000; ++i) {
+            log += "[ " + std::to_string(i % 100) + "%] Building CXX object CMakeFiles/foo.dir/file" +
+                   std::to_string(i) + ".cpp.o\n";
+        }
+        // The same header error from three translation units
+        for (int i = 0; i < 3; ++i) {
+            log += "In file included from src/a.cpp:1:\n";
+            log += "include/widget.hpp:7:5: error: 'Foo' does not name a type\n";
+            log += "    7 |     Foo bar;\n";
+            log += "      |     ^~~\n";
+        }
+        log += "src/widget.cpp:12:17: error: 'missing_symbol' was not declared in this scope\n";
+        log += "make[2]: *** [CMakeFiles/foo.dir/build.make:76: foo.o] Error 1\n";
+
+        Camus::LogReducerConfig config;
+        config.project_root = test_dir;
+        Camus::LogReducer reducer(config);
+        reducer.feed(log);
+        std::string reduced = reducer.finish();
+        auto stats = reducer.getStats();
+
+        assert(stats.errors == 2 && "Should find two unique errors");
+        assert(stats.duplicates_collapsed == 2 && "Should collapse repeated header errors");
+        assert(reduced.size() <= config.max_output_bytes && "Output must respect the budget");
+        assert(reduced.find("[reported 3 times]") != std::string::npos && "Should report repeat count");
+        assert(reduced.find("Building CXX object") == std::string::npos ||
+               reduced.find("== Last lines") != std::string::npos);
+        assert(reduced.find("    7 |     Foo bar;") != std::string::npos && "Should keep the source excerpt");
+
+        const auto& diagnostics = reducer.getDiagnostics();
+        assert(diagnostics[0].file == "include/widget.hpp" && diagnostics[0].line == 7 &&
+               diagnostics[0].column == 5 && "Should parse GCC locations");
+
+        assert(stats.snippets == 1 && "Should include the one source file that exists");
+        assert(reduced.find(">    12 |     int value = missing_symbol;") != std::string::npos &&
+               "Should pull in the referenced source line");
+
+        std::cout << "✓ GCC diagnostics test passed" << std::endl;
+    }
+
+    void testTemplateNoiseTrimming() {
+        std::cout << "Testing template instantiation noise trimming..." << std::endl;
+
+        std::string log = "src/a.cpp: In instantiation of 'void f(T) [with T = int]':\n";
+        for (int i = 0; i < 50; ++i) {
+            log += "src/a.cpp:" + std::to_string(100 + i) + ":5:   required from 'void g" +
+                   std::to_string(i) + "()'\n";
+        }
+        log += "src/a.cpp:200:5:   required from here\n";
+        log += "src/a.cpp:10:7: error: no match for 'operator+'\n";
+        for (int i = 0; i < 30; ++i) {
+            log += "src/a.cpp:10:7: note: candidate " + std::to_string(i) + "\n";
+        }
+
+        Camus::LogReducerConfig config;
+        config.max_notes_per_diagnostic = 4;
+        Camus::LogReducer reducer(config);
+        reducer.feed(log);
+        std::string reduced = reducer.finish();
+
+        const auto& diagnostic = reducer.getDiagnostics().at(0);
+        assert(diagnostic.notes.size() == 4 && "Preamble notes should be capped");
+        assert(diagnostic.notes.back().find("required from here") != std::string::npos &&
+               "The last instantiation note (user code) should be kept");
+        assert(reducer.getStats().notes_suppressed >= 70 && "Excess notes should be counted");
+        assert(diagnostic.context.size() == config.max_context_lines && "Trailing notes should be capped");
+        assert(reduced.find("[... 48 similar notes omitted ...]") != std::string::npos);
+
+        std::cout << "✓ Template noise trimming test passed" << std::endl;
+    }
+
+    void testMsvcDiagnostics() {
+        std::cout << "Testing MSVC diagnostics..." << std::endl;
+
+        std::string log =
+            "C:\\src\\widget.cpp(42,10): error C2065: 'x': undeclared identifier\n"
+            "C:\\src\\widget.cpp(50): warning C4996: 'strcpy': This function may be unsafe\n"
+            "LINK : fatal error LNK1120: 1 unresolved externals\n";
+
+        Camus::LogReducer reducer;
+        reducer.feed(log);
+        reducer.finish();
+
+        const auto& diagnostics = reducer.getDiagnostics();
+        assert(diagnostics.size() == 3 && "Should find all MSVC diagnostics");
+        assert(diagnostics[0].file == "C:\\src\\widget.cpp" && diagnostics[0].line == 42 &&
+               diagnostics[0].column == 10);
+        assert(diagnostics[1].severity == Camus::DiagnosticSeverity::WARNING && diagnostics[1].line == 50);
+        assert(diagnostics[2].severity == Camus::DiagnosticSeverity::FATAL && diagnostics[2].file.empty());
+
+        std::cout << "✓ MSVC diagnostics test passed" << std::endl;
+    }
+
+    void testTestFrameworkFailures() {
+        std::cout << "Testing gtest, ctest and pytest failure extraction..." << std::endl;
+
+        std::string log =
+            "[ RUN      ] Math.Adds\n"
+            "[       OK ] Math.Adds (0 ms)\n"
+            "[ RUN      ] Math.Divides\n"
+            "tests/math_test.cc:42: Failure\n"
+            "Expected equality of these values:\n"
+            "  divide(4, 2)\n"
+            "[  FAILED  ] Math.Divides (1 ms)\n"
+            "[  FAILED  ] 1 test, listed below:\n"
+            "[  FAILED  ] Math.Divides\n"
+            "1/2 Test  #1: ParserTest .......................   Passed    0.01 sec\n"
+            "2/2 Test  #2: ScannerTest ......................***Failed    0.02 sec\n"
+            "Assertion `files.size() == 3' failed.\n"
+            "50% tests passed, 1 tests failed out of 2\n"
+            "The following tests FAILED:\n"
+            "\t  2 - ScannerTest (Failed)\n"
+            "________________________ test_parse_empty ________________________\n"
+            "    def test_parse_empty():\n"
+            ">       assert parse('') == []\n"
+            "E       AssertionError: assert None == []\n"
+            "tests/test_parser.py:12: AssertionError\n"
+            "=========================== short test summary info ============================\n"
+            "FAILED tests/test_parser.py::test_parse_empty - AssertionError: assert None == []\n";
+
+        Camus::LogReducer reducer;
+        reducer.feed(log);
+        std::string reduced = reducer.finish();
+
+        const auto& failures = reducer.getTestFailures();
+        assert(failures.size() == 3 && "Should find one failure per framework");
+        assert(failures[0].framework == "gtest" && failures[0].test_name == "Math.Divides");
+        assert(failures[0].lines.size() == 3 && "gtest block should contain the failure output");
+        assert(failures[1].framework == "ctest" && failures[1].test_name == "ScannerTest");
+        assert(failures[1].lines.size() == 2 && "ctest failure should capture the test output");
+        assert(failures[2].framework == "pytest" && failures[2].test_name == "test_parse_empty");
+        assert(reduced.find("E       AssertionError") != std::string::npos);
+        assert(reduced.find("Math.Adds") == std::string::npos && "Passing tests should be dropped");
+
+        std::cout << "✓ Test framework failure test passed" << std::endl;
+    }
+
+    void testStreamingAndBudget() {
+        std::cout << "Testing chunked streaming input and output budget..." << std::endl;
+
+        std::string log;
+        for (int i = 0; i < 500; ++i) {
+            log += "src/file" + std::to_string(i) + ".cpp:" + std::to_string(i + 1) +
+                   ":1: error: something went wrong in a fairly long diagnostic message number " +
+                   std::to_string(i) + "\n";
+        }
+
+        Camus::LogReducerConfig config;
+        config.max_output_bytes = 2048;
+        config.max_diagnostics = 1000;
+        Camus::LogReducer reducer(config);
+
+        // Feed in awkward chunk sizes, splitting lines across calls and streams
+        for (size_t offset = 0; offset < log.size(); offset += 37) {
+            reducer.feed(log.data() + offset, std::min<size_t>(37, log.size() - offset));
+        }
+        reducer.feed("unterminated stderr line: error: tail", 37, Camus::OutputStream::STDERR);
+        std::string reduced = reducer.finish();
+
+        assert(reducer.getStats().errors == 501 && "Every split line should be reassembled");
+        assert(reduced.size() <= 2048 && "Output must respect the budget");
+        assert(reduced.find("more diagnostics omitted") != std::string::npos &&
+               "Should note what did not fit");
+
+        std::cout << "✓ Streaming and budget test passed" << std::endl;
+    }
+
+    void testFallbackToTail() {
+        std::cout << "Testing fallback to the log tail..." << std::endl;
+
+        std::string log;
+        for (int i = 0; i < 100; ++i) {
+            log += "something happened " + std::to_string(i) + "\n";
+        }
+
+        Camus::LogReducerConfig config;
+        config.tail_lines = 5;
+        std::string reduced = Camus::LogReducer::reduce(log, config);
+
+        assert(reduced.find("== Last lines of output ==") != std::string::npos);
+        assert(reduced.find("something happened 99") != std::string::npos);
+        assert(reduced.find("something happened 94") == std::string::npos);
+
+        std::cout << "✓ Tail fallback test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running LogReducer unit tests..." << std::endl;
+
+        setupTestEnvironment();
+
+        testGccDiagnosticsAndDeduplication();
+        testTemplateNoiseTrimming();
+        testMsvcDiagnostics();
+        testTestFrameworkFailures();
+        testStreamingAndBudget();
+        testFallbackToTail();
+
+        cleanupTestEnvironment();
+
+        std::cout << "All LogReducer tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        LogReducerTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All LogReducer component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,204 @@
+// =================================================================
+// tests/MemoryGovernorTest.cpp
+// =================================================================
+// Unit tests for the resident-model memory budget.
+
+#include "Camus/MemoryGovernor.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <thread>
+#include <future>
+
+using namespace std::chrono_literals;
+
+namespace {
+constexpr uint64_t GiB = 1024ull * 1024 * 1024;
+}
+
+class MemoryGovernorTest {
+private:
+    Camus::MemoryGovernorConfig makeConfig(uint64_t budget) {
+        Camus::MemoryGovernorConfig config;
+        config.budget_bytes = budget;
+        config.min_idle_time = 0s;
+        config.admission_timeout = 200ms;
+        return config;
+    }
+
+    void load(Camus::MemoryGovernor& governor, const std::string& model, uint64_t bytes,
+              std::chrono::milliseconds load_time, std::atomic<int>* evictions = nullptr) {
+        bool admitted = governor.admit(model, bytes);
+        assert(admitted);
+        governor.commit(model, bytes, load_time, [evictions]() {
+            if (evictions) {
+                (*evictions)++;
+            }
+        });
+    }
+
+public:
+    void testAdmitWithinBudget() {
+        std::cout << "Testing admission within budget..." << std::endl;
+
+        Camus::MemoryGovernor governor(makeConfig(4 * GiB));
+        load(governor, "a", 1 * GiB, 100ms);
+        load(governor, "b", 2 * GiB, 100ms);
+
+        auto stats = governor.getStats();
+        assert(stats.resident_models == 2);
+        assert(stats.resident_bytes == 3 * GiB);
+        assert(stats.evictions == 0);
+        assert(governor.getFootprint("b") == 2 * GiB);
+
+        bool again = governor.admit("a", 1 * GiB);
+        assert(again && "A resident model is admitted without a second reservation");
+        assert(governor.getStats().resident_bytes == 3 * GiB);
+
+        governor.release("a");
+        assert(governor.getFootprint("a") == 0);
+        std::cout << "✓ Admission test passed" << std::endl;
+    }
+
+    void testCostAwareEviction() {
+        std::cout << "Testing cost-aware eviction..." << std::endl;
+
+        Camus::MemoryGovernor governor(makeConfig(4 * GiB));
+        std::atomic<int> slow_evictions{0};
+        std::atomic<int> fast_evictions{0};
+        load(governor, "slow_reload", 2 * GiB, 20000ms, &slow_evictions);
+        load(governor, "fast_reload", 2 * GiB, 100ms, &fast_evictions);
+
+        // Same size and idle time: the model that reloads quickly goes first
+        load(governor, "incoming", 2 * GiB, 100ms);
+        assert(fast_evictions == 1);
+        assert(slow_evictions == 0);
+        assert(governor.getFootprint("fast_reload") == 0);
+        assert(governor.getFootprint("slow_reload") == 2 * GiB);
+        assert(governor.getStats().evictions == 1);
+        std::cout << "✓ Eviction test passed" << std::endl;
+    }
+
+    void testBusyModelsStayResident() {
+        std::cout << "Testing that busy and recent models are kept..." << std::endl;
+
+        Camus::MemoryGovernor governor(makeConfig(2 * GiB));
+        std::atomic<int> evictions{0};
+        load(governor, "busy", 2 * GiB, 100ms, &evictions);
+        {
+            auto lease = governor.use("busy");
+            bool admitted = governor.admit("other", 1 * GiB, 50ms);
+            assert(!admitted && "A model serving a request is never evicted");
+        }
+        assert(evictions == 0);
+
+        auto config = makeConfig(2 * GiB);
+        config.min_idle_time = 1h;
+        Camus::MemoryGovernor strict(config);
+        load(strict, "recent", 2 * GiB, 100ms, &evictions);
+        bool admitted = strict.admit("other", 1 * GiB, 50ms);
+        assert(!admitted && "A recently used model is kept");
+        assert(evictions == 0);
+        assert(strict.getStats().rejected_loads == 1);
+        std::cout << "✓ Busy model test passed" << std::endl;
+    }
+
+    void testQueuedLoadProceedsAfterRelease() {
+        std::cout << "Testing queued admission..." << std::endl;
+
+        auto config = makeConfig(2 * GiB);
+        config.admission_timeout = 5000ms;
+        Camus::MemoryGovernor governor(config);
+        load(governor, "resident", 2 * GiB, 100ms);
+        auto lease = std::make_unique<Camus::MemoryGovernor::Lease>(governor.use("resident"));
+
+        auto waiter = std::async(std::launch::async, [&governor]() {
+            return governor.admit("queued", 2 * GiB);
+        });
+        std::this_thread::sleep_for(50ms);
+        assert(governor.getStats().queued_loads == 1);
+
+        lease.reset();
+        governor.release("resident");
+        bool admitted = waiter.get();
+        assert(admitted);
+        assert(governor.getStats().reserved_bytes == 2 * GiB);
+        governor.abort("queued");
+        assert(governor.getStats().reserved_bytes == 0);
+        std::cout << "✓ Queued admission test passed" << std::endl;
+    }
+
+    void testReloadWaitsForEviction() {
+        std::cout << "Testing a reload racing its own eviction..." << std::endl;
+
+        Camus::MemoryGovernor governor(makeConfig(3 * GiB));
+        std::promise<void> evicting;
+        std::promise<void> unblock;
+        std::shared_future<void> unblocked = unblock.get_future().share();
+        bool admitted = governor.admit("model", 2 * GiB);
+        assert(admitted);
+        governor.commit("model", 2 * GiB, 100ms, [&evicting, unblocked]() {
+            // An owner's unload waits on its own lock, held by a request
+            evicting.set_value();
+            unblocked.wait();
+        });
+
+        auto incoming = std::async(std::launch::async, [&governor]() {
+            return governor.admit("incoming", 2 * GiB);
+        });
+        evicting.get_future().wait();
+
+        auto reload = std::async(std::launch::async, [&governor]() {
+            return governor.admit("model", 1 * GiB);
+        });
+        assert(reload.wait_for(50ms) == std::future_status::timeout &&
+               "The entry being evicted is not taken for a resident model");
+
+        unblock.set_value();
+        assert(incoming.get());
+        assert(reload.get());
+        assert(governor.getStats().reserved_bytes == 3 * GiB && "The reload holds its own reservation");
+        std::cout << "✓ Reload during eviction test passed" << std::endl;
+    }
+
+    void testOversizeLoadRejected() {
+        std::cout << "Testing oversize rejection..." << std::endl;
+
+        Camus::MemoryGovernor governor(makeConfig(1 * GiB));
+        auto start = std::chrono::steady_clock::now();
+        bool admitted = governor.admit("huge", 2 * GiB);
+        assert(!admitted);
+        assert(std::chrono::steady_clock::now() - start < 100ms && "Refused without queueing");
+        assert(governor.getStats().rejected_loads == 1);
+
+        assert(Camus::MemoryGovernor::processRssBytes() > 0);
+        std::cout << "✓ Oversize rejection test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running memory governor unit tests..." << std::endl;
+
+        testAdmitWithinBudget();
+        testCostAwareEviction();
+        testBusyModelsStayResident();
+        testQueuedLoadProceedsAfterRelease();
+        testReloadWaitsForEviction();
+        testOversizeLoadRejected();
+
+        std::cout << "All memory governor tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        MemoryGovernorTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All memory governor component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
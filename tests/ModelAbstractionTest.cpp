@@ -10,6 +10,7 @@
 #include <cassert>
 #include <memory>
 #include <vector>
+#include <cmath>
 
 // Mock LLM implementation for testing
 class MockLlmInteraction : public Camus::LlmInteraction {
@@ -342,6 +343,28 @@ public:
         std::cout << "✓ Warmup and cleanup test passed" << std::endl;
     }
 
+    void testLogprobSummary() {
+        std::cout << "Testing token logprob summary..." << std::endl;
+
+        Camus::InferenceResponse empty;
+        empty.confidence_score = 0.7;
+        empty.summarizeLogprobs();
+        assert(!empty.hasLogprobs() && "Empty response should have no logprobs");
+        assert(empty.confidence_score == 0.7 && "Summary should leave confidence alone without logprobs");
+
+        Camus::InferenceResponse response;
+        response.token_logprobs = {-0.1f, -0.5f, -0.3f};
+        response.summarizeLogprobs();
+        assert(response.hasLogprobs() && "Response should report logprobs");
+        assert(std::abs(response.mean_logprob - (-0.3)) < 1e-6 && "Mean logprob should be averaged");
+        assert(std::abs(response.min_logprob - (-0.5)) < 1e-6 && "Min logprob should be the least likely token");
+        assert(std::abs(response.perplexity - std::exp(0.3)) < 1e-6 && "Perplexity should be exp(-mean)");
+        assert(std::abs(response.confidence_score - std::exp(-0.3)) < 1e-6 &&
+               "Confidence should be the geometric-mean token probability");
+
+        std::cout << "✓ Token logprob summary test passed" << std::endl;
+    }
+
     void runAllTests() {
         std::cout << "Running Model Abstraction Layer tests..." << std::endl;
         std::cout << "===============================================" << std::endl << std::endl;
@@ -364,6 +387,9 @@ public:
         testWarmUpAndCleanup();
         std::cout << std::endl;
 
+        testLogprobSummary();
+        std::cout << std::endl;
+
         std::cout << "All Model Abstraction Layer tests passed!" << std::endl;
     }
 };
@@ -13,6 +13,22 @@
 
 namespace fs = std::filesystem;
 
+/**
+ * @brief Minimal model that records cleanup
+ */
+class CountingModel : public Camus::LlmInteraction {
+public:
+    std::string getCompletion(const std::string& prompt) override { return "echo:" + prompt; }
+    Camus::ModelMetadata getModelMetadata() const override { return Camus::ModelMetadata(); }
+    bool isHealthy() const override { return true; }
+    bool performHealthCheck() override { return true; }
+    Camus::ModelPerformance getCurrentPerformance() const override { return Camus::ModelPerformance(); }
+    void cleanup() override { cleanups++; }
+    std::string getModelId() const override { return "counting"; }
+
+    int cleanups = 0;
+};
+
 class ModelRegistryTest {
 private:
     std::string test_config_path = "test_models.yml";
@@ -165,6 +181,44 @@ models:
         std::cout << "✓ Model factory registration test passed" << std::endl;
     }
     
+    void testSharedInstance() {
+        std::cout << "Testing shared model instances..." << std::endl;
+        
+        auto held = std::make_shared<CountingModel>();
+        int created = 0;
+        {
+            Camus::RegistryConfig config;
+            config.auto_discover = false;
+            config.enable_health_checks = false;
+            Camus::ModelRegistry registry(config);
+            registry.registerModelFactory("llama_cpp", [&created](const Camus::ModelConfig&) {
+                created++;
+                return std::make_shared<CountingModel>();
+            });
+            registry.shareInstance("llama_cpp", "/models/./default.gguf", held);
+            
+            // The same file, spelled differently, reuses the held instance
+            Camus::ModelConfig same;
+            same.name = "default";
+            same.version = "1";
+            same.type = "llama_cpp";
+            same.path = "/models/default.gguf";
+            assert(registry.loadModel(same).success);
+            assert(created == 0 && "A loaded model must not be loaded again");
+            auto served = registry.getModel("default_1");
+            assert(served && served->getCompletion("hi") == "echo:hi");
+            
+            // Other models still come from their factory
+            Camus::ModelConfig other = same;
+            other.name = "other";
+            other.path = "/models/other.gguf";
+            assert(registry.loadModel(other).success && created == 1);
+        }
+        assert(held->cleanups == 0 && "The registry must not clean up an instance it does not own");
+        
+        std::cout << "✓ Shared instance test passed" << std::endl;
+    }
+    
     void testRegistryStatus() {
         std::cout << "Testing registry status tracking..." << std::endl;
         
@@ -295,6 +349,9 @@ models:
         testModelFactoryRegistration();
         std::cout << std::endl;
         
+        testSharedInstance();
+        std::cout << std::endl;
+        
         testRegistryStatus();
         std::cout << std::endl;
         
@@ -0,0 +1,232 @@
+// =================================================================
+// tests/OllamaInteractionTest.cpp
+// =================================================================
+// Unit tests for the Ollama backend against a mock Ollama server.
+
+#include "Camus/OllamaInteraction.hpp"
+#include "httplib.h"
+#include "nlohmann/json.hpp"
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Minimal /api/tags and /api/generate server that records request bodies
+ */
+class MockOllamaServer {
+public:
+    MockOllamaServer() {
+        m_server.Get("/api/tags", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content(R"({"models":[{"name":"test:latest"}]})", "application/json");
+        });
+        m_server.Post("/api/generate", [this](const httplib::Request& req, httplib::Response& res) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_bodies.push_back(nlohmann::json::parse(req.body));
+            }
+            nlohmann::json reply = {
+                {"model", "test:latest"},
+                {"response", "int x = 1;"},
+                {"done", true},
+                {"done_reason", "stop"},
+                {"total_duration", 5000000},
+                {"load_duration", 1000000},
+                {"prompt_eval_count", 12},
+                {"prompt_eval_duration", 2000000},
+                {"eval_count", 4},
+                {"eval_duration", 1500000}
+            };
+            res.set_content(reply.dump(), "application/json");
+        });
+        m_port = m_server.bind_to_any_port("127.0.0.1");
+        m_thread = std::thread([this]() { m_server.listen_after_bind(); });
+        while (!m_server.is_running()) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    ~MockOllamaServer() {
+        m_server.stop();
+        m_thread.join();
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(m_port); }
+
+    std::vector<nlohmann::json> bodies() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bodies;
+    }
+
+private:
+    httplib::Server m_server;
+    std::thread m_thread;
+    int m_port = 0;
+    std::mutex m_mutex;
+    std::vector<nlohmann::json> m_bodies;
+};
+
+class OllamaInteractionTest {
+public:
+    void testRuntimeOptionsFromAttributes() {
+        std::cout << "Testing runtime options from model attributes..." << std::endl;
+
+        auto defaults = Camus::OllamaRuntimeOptions::fromAttributes({});
+        assert(defaults.keep_alive == "30m");
+        assert(defaults.num_ctx == 0 && defaults.num_thread == 0 && defaults.num_gpu == -1);
+        assert(defaults.max_in_flight == 0);
+
+        auto options = Camus::OllamaRuntimeOptions::fromAttributes({
+            {"keep_alive", "-1"},
+            {"num_ctx", "16384"},
+            {"threads", "8"},
+            {"batch_size", "512"},
+            {"gpu_layers", "33"},
+            {"num_parallel", "2"}
+        });
+        assert(options.keep_alive == "-1");
+        assert(options.num_ctx == 16384);
+        assert(options.num_thread == 8 && "llama.cpp attribute names are aliases");
+        assert(options.num_batch == 512);
+        assert(options.num_gpu == 33);
+        assert(options.max_in_flight == 2);
+
+        auto invalid = Camus::OllamaRuntimeOptions::fromAttributes({{"num_ctx", "large"}});
+        assert(invalid.num_ctx == 0 && "Invalid values keep the default");
+
+        std::cout << "✓ Runtime options test passed" << std::endl;
+    }
+
+    void testRequestsCarryResidencyOptions() {
+        std::cout << "Testing keep_alive and options on requests..." << std::endl;
+
+        MockOllamaServer server;
+        Camus::ModelMetadata metadata;
+        metadata.performance.max_context_tokens = 8192;
+        metadata.custom_attributes = {{"keep_alive", "-1"}, {"num_thread", "6"}};
+        Camus::OllamaInteraction ollama(server.url(), "test:latest", metadata);
+
+        bool warmed = ollama.warmUp();
+        assert(warmed && "Preload should succeed");
+
+        Camus::InferenceRequest request;
+        request.prompt = "Write x";
+        request.temperature = 0.2;
+        auto response = ollama.getCompletionWithMetadata(request);
+        assert(response.text == "int x = 1;");
+
+        auto bodies = server.bodies();
+        assert(bodies.size() == 2);
+
+        const auto& preload = bodies[0];
+        assert(!preload.contains("prompt") && "Preload must not generate");
+        assert(preload["keep_alive"].is_number() && preload["keep_alive"] == -1);
+
+        const auto& generate = bodies[1];
+        assert(generate["keep_alive"] == -1);
+        assert(!generate["options"].contains("num_ctx") && "num_ctx is left to the server by default");
+        assert(!preload["options"].contains("num_ctx"));
+        assert(generate["options"]["num_thread"] == 6);
+        assert(generate["options"]["temperature"] == 0.2);
+        assert(preload["options"]["num_thread"] == generate["options"]["num_thread"] &&
+               "Preload must use the same options or Ollama reloads the model");
+
+        std::cout << "✓ Residency options test passed" << std::endl;
+    }
+
+    void testExplicitContextWindow() {
+        std::cout << "Testing an explicit num_ctx..." << std::endl;
+
+        MockOllamaServer server;
+        Camus::ModelMetadata metadata;
+        metadata.performance.max_context_tokens = 131072;
+        metadata.custom_attributes = {{"num_ctx", "16384"}};
+        Camus::OllamaInteraction ollama(server.url(), "test:latest", metadata);
+
+        ollama.warmUp();
+        Camus::InferenceRequest request;
+        request.prompt = "Write x";
+        ollama.getCompletionWithMetadata(request);
+
+        auto bodies = server.bodies();
+        assert(bodies.size() == 2);
+        assert(bodies[0]["options"]["num_ctx"] == 16384);
+        assert(bodies[1]["options"]["num_ctx"] == 16384 && "The declared context size is not sent");
+
+        std::cout << "✓ Explicit context window test passed" << std::endl;
+    }
+
+    void testTimingMetadata() {
+        std::cout << "Testing Ollama timing metadata..." << std::endl;
+
+        MockOllamaServer server;
+        Camus::OllamaInteraction ollama(server.url(), "test:latest");
+
+        Camus::InferenceRequest request;
+        request.prompt = "Write x";
+        auto response = ollama.getCompletionWithMetadata(request);
+
+        assert(response.metadata["load_duration"] == "1000000");
+        assert(response.metadata["prompt_eval_duration"] == "2000000");
+        assert(response.metadata["eval_duration"] == "1500000");
+        assert(response.metadata["prompt_eval_count"] == "12");
+        assert(response.tokens_generated == 4 && "eval_count is the generated token count");
+        assert(response.finish_reason == "stop");
+
+        std::cout << "✓ Timing metadata test passed" << std::endl;
+    }
+
+    void testCleanupLeavesModelResident() {
+        std::cout << "Testing that cleanup does not unload the server model..." << std::endl;
+
+        MockOllamaServer server;
+        {
+            Camus::OllamaInteraction ollama(server.url(), "test:latest");
+            ollama.cleanup();
+            assert(!ollama.isHealthy());
+        }
+        assert(server.bodies().empty() && "Other clients may still be using the model");
+
+        Camus::OllamaInteraction ollama(server.url(), "test:latest");
+        bool unloaded = ollama.unloadFromServer();
+        assert(unloaded);
+
+        auto bodies = server.bodies();
+        assert(bodies.size() == 1);
+        assert(bodies[0]["model"] == "test:latest");
+        assert(bodies[0]["keep_alive"] == 0 && !bodies[0].contains("prompt"));
+
+        std::cout << "✓ Cleanup residency test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running Ollama interaction unit tests..." << std::endl;
+
+        testRuntimeOptionsFromAttributes();
+        testRequestsCarryResidencyOptions();
+        testExplicitContextWindow();
+        testTimingMetadata();
+        testCleanupLeavesModelResident();
+
+        std::cout << "All Ollama interaction tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        OllamaInteractionTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All Ollama interaction component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
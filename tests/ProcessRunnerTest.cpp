@@ -0,0 +1,263 @@
+// =================================================================
+// tests/ProcessRunnerTest.cpp
+// =================================================================
+// Unit tests for ProcessRunner component.
+
+#include "Camus/ProcessRunner.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <csignal>
+
+class ProcessRunnerTest {
+public:
+    void testCapturesOutputAndExitCode() {
+        std::cout << "Testing output capture and exit code..." << std::endl;
+
+        auto result = Camus::ProcessRunner::run("sh", {"-c", "echo hello; echo oops 1>&2; exit 3"});
+
+        assert(result.exit_code == 3 && "Should report the child's exit code");
+        assert(!result.timed_out && "Should not time out");
+        assert(result.output.find("hello") != std::string::npos && "Should capture stdout");
+        assert(result.output.find("oops") != std::string::npos && "Should merge stderr by default");
+        assert(result.error_output == "oops\n" && "Should capture stderr separately");
+
+        std::cout << "✓ Output capture test passed" << std::endl;
+    }
+
+    void testSeparateStreams() {
+        std::cout << "Testing unmerged stderr..." << std::endl;
+
+        Camus::ProcessOptions options;
+        options.merge_stderr = false;
+        auto result = Camus::ProcessRunner::run("sh", {"-c", "echo out; echo err 1>&2"}, options);
+
+        assert(result.exit_code == 0 && "Should succeed");
+        assert(result.output == "out\n" && "Output should contain stdout only");
+        assert(result.error_output == "err\n" && "Stderr should be captured separately");
+
+        std::cout << "✓ Separate streams test passed" << std::endl;
+    }
+
+    void testArgumentsAreNotShellInterpreted() {
+        std::cout << "Testing verbatim argument passing..." << std::endl;
+
+        auto result = Camus::ProcessRunner::run("printf", {"%s|", "a b", "$HOME", "'q'"});
+
+        assert(result.exit_code == 0 && "printf should succeed");
+        assert(result.output == "a b|$HOME|'q'|" && "Arguments should reach the child verbatim");
+
+        std::cout << "✓ Verbatim argument test passed" << std::endl;
+    }
+
+    void testBoundedCapture() {
+        std::cout << "Testing bounded ring-buffer capture..." << std::endl;
+
+        Camus::ProcessOptions options;
+        options.max_capture_bytes = 1024;
+        options.read_buffer_size = 4096;
+        auto result = Camus::ProcessRunner::run(
+            "sh", {"-c", "i=0; while [ $i -lt 2000 ]; do echo line$i; i=$((i+1)); done"}, options);
+
+        assert(result.exit_code == 0 && "Should succeed");
+        assert(result.output.size() == 1024 && "Capture should be bounded");
+        assert(result.output_truncated && "Should report truncation");
+        assert(result.total_output_bytes > 1024 && "Should count all produced bytes");
+        assert(result.output.find("line1999\n") != std::string::npos && "Should keep the most recent output");
+
+        std::cout << "✓ Bounded capture test passed" << std::endl;
+    }
+
+    void testRingBuffer() {
+        std::cout << "Testing ring buffer wrap-around..." << std::endl;
+
+        Camus::OutputRingBuffer buffer(8);
+        buffer.append("abcde", 5);
+        assert(buffer.str() == "abcde" && !buffer.wrapped());
+        buffer.append("fghij", 5);
+        assert(buffer.str() == "cdefghij" && buffer.wrapped() && buffer.dropped() == 2);
+        buffer.append("0123456789", 10);
+        assert(buffer.str() == "23456789" && buffer.size() == 8);
+
+        std::cout << "✓ Ring buffer test passed" << std::endl;
+    }
+
+    void testTimeoutKillsProcessGroup() {
+        std::cout << "Testing timeout and process-group kill..." << std::endl;
+
+        Camus::ProcessOptions options;
+        options.timeout = std::chrono::milliseconds(300);
+        options.kill_grace_period = std::chrono::milliseconds(200);
+
+        // The grandchild holds the pipes open; it must die with the group
+        auto result = Camus::ProcessRunner::run("sh", {"-c", "sleep 30 & sleep 30"}, options);
+
+        assert(result.timed_out && "Should time out");
+        assert(result.exit_code != 0 && "Killed process should not report success");
+        assert(result.duration < std::chrono::seconds(5) && "Should not wait for the grandchild");
+
+        std::cout << "✓ Timeout test passed" << std::endl;
+    }
+
+    void testTimeoutAfterPipesClose() {
+        std::cout << "Testing timeout after the child closes its pipes..." << std::endl;
+
+        Camus::ProcessOptions options;
+        options.timeout = std::chrono::milliseconds(300);
+        options.kill_grace_period = std::chrono::milliseconds(200);
+
+        // Output hits EOF immediately; the timeout must still hold
+        auto result = Camus::ProcessRunner::run("sh", {"-c", "exec >/dev/null 2>&1; sleep 30"}, options);
+
+        assert(result.timed_out && "Should time out");
+        assert(result.exit_code != 0 && "Killed process should not report success");
+        assert(result.duration < std::chrono::seconds(5) && "Should not wait for the child to exit");
+
+        std::cout << "✓ Timeout after pipes close test passed" << std::endl;
+    }
+
+    void testStreamingCallback() {
+        std::cout << "Testing streaming output callback..." << std::endl;
+
+        Camus::ProcessOptions options;
+        std::string streamed;
+        options.output_callback = [&streamed](Camus::OutputStream, const char* data, size_t length) {
+            streamed.append(data, length);
+        };
+        auto result = Camus::ProcessRunner::run("sh", {"-c", "echo one; echo two"}, options);
+
+        assert(streamed == result.output && "Callback should see every chunk");
+
+        std::cout << "✓ Streaming callback test passed" << std::endl;
+    }
+
+    void testMissingExecutable() {
+        std::cout << "Testing missing executable..." << std::endl;
+
+        bool threw = false;
+        try {
+            Camus::ProcessRunner::run("camus-no-such-command-xyz", {});
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw && "Should throw when the command cannot be started");
+
+        std::cout << "✓ Missing executable test passed" << std::endl;
+    }
+
+    void testLostExitStatus() {
+        std::cout << "Testing an exit status that cannot be collected..." << std::endl;
+
+        // With SIGCHLD ignored the kernel reaps children and waitpid fails
+        auto previous = std::signal(SIGCHLD, SIG_IGN);
+        auto result = Camus::ProcessRunner::run("sh", {"-c", "echo done"});
+        std::signal(SIGCHLD, previous);
+
+        assert(result.output == "done\n" && "Output is still captured");
+        assert(result.exit_code == -1 && "A lost exit status must not read as success");
+        assert(result.term_signal == 0);
+
+        std::cout << "✓ Lost exit status test passed" << std::endl;
+    }
+
+    void testSplitCommandLine() {
+        std::cout << "Testing command line splitting..." << std::endl;
+
+        auto parts = Camus::ProcessRunner::splitCommandLine("'cmake --build ./build'");
+        assert(parts.size() == 3 && parts[0] == "cmake" && parts[2] == "./build" &&
+               "Whole-value YAML quotes should be unwrapped");
+
+        parts = Camus::ProcessRunner::splitCommandLine("make -C \"my dir\" ''");
+        assert(parts.size() == 4 && parts[2] == "my dir" && parts[3].empty() &&
+               "Quotes should group words and allow empty arguments");
+
+        assert(Camus::ProcessRunner::splitCommandLine("   ").empty());
+
+        std::cout << "✓ Command line splitting test passed" << std::endl;
+    }
+
+    void testNeedsShell() {
+        std::cout << "Testing shell syntax detection..." << std::endl;
+
+        using Camus::ProcessRunner;
+        assert(!ProcessRunner::needsShell("'cmake --build ./build'"));
+        assert(!ProcessRunner::needsShell("make -C \"my dir\" V=1 --jobs=4"));
+        assert(!ProcessRunner::needsShell("ctest --test-dir ./build -R 'a|b'") && "Quoted operators are literal");
+        assert(ProcessRunner::needsShell("cmake -B build && cmake --build build"));
+        assert(ProcessRunner::needsShell("make 2>&1 | tee build.log"));
+        assert(ProcessRunner::needsShell("make > build.log"));
+        assert(ProcessRunner::needsShell("pytest tests/*.py"));
+        assert(ProcessRunner::needsShell("CC=clang make"));
+        assert(ProcessRunner::needsShell("make -C \"$HOME/src\"") && "Double quotes still expand");
+        assert(ProcessRunner::needsShell("cd build; ctest"));
+
+        std::cout << "✓ Shell syntax detection test passed" << std::endl;
+    }
+
+    void testCommandArgv() {
+        std::cout << "Testing configured command lines..." << std::endl;
+
+        auto run = [](const std::string& line, const std::vector<std::string>& extra) {
+            auto argv = Camus::ProcessRunner::commandArgv(line, extra);
+            assert(!argv.empty());
+            return Camus::ProcessRunner::run(argv[0], std::vector<std::string>(argv.begin() + 1, argv.end()));
+        };
+
+        // Plain commands are started directly, extra arguments appended verbatim
+        auto argv = Camus::ProcessRunner::commandArgv("'printf %s,'", {"a b", "$HOME"});
+        assert(argv.size() == 4 && argv[0] == "printf" && argv[3] == "$HOME");
+        auto result = run("'printf %s,'", {"a b", "$HOME"});
+        assert(result.output == "a b,$HOME," && "Extra arguments are not shell interpreted");
+
+        // Shell syntax runs under /bin/sh
+        result = run("'echo one && echo two | tr a-z A-Z'", {});
+        assert(result.exit_code == 0 && result.output == "one\nTWO\n");
+        result = run("GREETING=hi sh -c 'echo $GREETING'", {});
+        assert(result.output == "hi\n" && "Leading assignments set the environment");
+        result = run("false && echo never", {});
+        assert(result.exit_code == 1 && result.output.empty());
+
+        // Extra arguments reach the script as "$@", still verbatim
+        result = run("echo start; printf %s,", {"a b", "$HOME"});
+        assert(result.output == "start\na b,$HOME," && "Extra arguments follow the last command");
+
+        assert(Camus::ProcessRunner::commandArgv("   ").empty());
+
+        std::cout << "✓ Configured command line test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running ProcessRunner unit tests..." << std::endl;
+
+        testCapturesOutputAndExitCode();
+        testSeparateStreams();
+        testArgumentsAreNotShellInterpreted();
+        testBoundedCapture();
+        testRingBuffer();
+        testTimeoutKillsProcessGroup();
+        testTimeoutAfterPipesClose();
+        testStreamingCallback();
+        testMissingExecutable();
+        testLostExitStatus();
+        testSplitCommandLine();
+        testNeedsShell();
+        testCommandArgv();
+
+        std::cout << "All ProcessRunner tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        ProcessRunnerTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All ProcessRunner component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
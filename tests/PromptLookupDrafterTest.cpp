@@ -0,0 +1,139 @@
+// =================================================================
+// tests/PromptLookupDrafterTest.cpp
+// =================================================================
+// Unit tests for prompt-lookup draft proposals.
+
+#include "Camus/PromptLookupDrafter.hpp"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+class PromptLookupDrafterTest {
+private:
+    // Runs the verification loop LlamaCppInteraction uses against a "model"
+    // that deterministically produces target, one token per forward pass
+    size_t simulate(const std::vector<int32_t>& prompt, const std::vector<int32_t>& target,
+                    Camus::PromptLookupDrafter& drafter, std::vector<int32_t>& output) {
+        std::vector<int32_t> history = prompt;
+        size_t passes = 0;
+        while (output.size() < target.size()) {
+            int32_t token = target[output.size()];
+            output.push_back(token);
+            history.push_back(token);
+            passes++;
+
+            auto draft = drafter.propose(history, target.size() - output.size());
+            size_t accepted = 0;
+            while (accepted < draft.size() && target[output.size()] == draft[accepted]) {
+                output.push_back(draft[accepted]);
+                history.push_back(draft[accepted]);
+                accepted++;
+            }
+            if (!draft.empty()) {
+                drafter.accept(accepted);
+            }
+        }
+        return passes;
+    }
+
+public:
+    void testVerbatimCopy() {
+        std::cout << "Testing a verbatim copy of the prompt..." << std::endl;
+
+        std::vector<int32_t> prompt;
+        for (int32_t i = 0; i < 400; ++i) {
+            prompt.push_back(1000 + i);
+        }
+        // Rewrite the "file": the first 300 tokens unchanged
+        std::vector<int32_t> target(prompt.begin() + 100, prompt.begin() + 400);
+
+        Camus::PromptLookupDrafter drafter(prompt);
+        std::vector<int32_t> output;
+        size_t passes = simulate(prompt, target, drafter, output);
+
+        assert(output == target && "Drafts never change the output");
+        const auto& stats = drafter.getStats();
+        assert(stats.accepted_tokens > 0);
+        assert(stats.acceptanceRate() > 0.9);
+        assert(passes * 5 < target.size() && "Most tokens come from accepted drafts");
+        std::cout << "  " << target.size() << " tokens in " << passes << " passes, acceptance "
+                  << stats.acceptanceRate() << std::endl;
+        std::cout << "✓ Verbatim copy test passed" << std::endl;
+    }
+
+    void testEditedCopy() {
+        std::cout << "Testing a copy with edits..." << std::endl;
+
+        std::vector<int32_t> prompt;
+        for (int32_t i = 0; i < 200; ++i) {
+            prompt.push_back(i % 50 == 0 ? 7 : 500 + i); // Repeated token 7 has several occurrences
+        }
+        std::vector<int32_t> target(prompt.begin(), prompt.begin() + 80);
+        target.insert(target.begin() + 40, {9001, 9002, 9003}); // Inserted lines
+        target[60] = 9004;                                       // Changed line
+
+        Camus::PromptLookupDrafter drafter(prompt);
+        std::vector<int32_t> output;
+        size_t passes = simulate(prompt, target, drafter, output);
+
+        assert(output == target);
+        assert(passes < target.size() / 2);
+        assert(drafter.getStats().drafted_tokens > drafter.getStats().accepted_tokens &&
+               "Edits reject part of a draft");
+        std::cout << "✓ Edited copy test passed" << std::endl;
+    }
+
+    void testNoMatchAndLimits() {
+        std::cout << "Testing misses and limits..." << std::endl;
+
+        std::vector<int32_t> prompt = {1, 2, 3, 4, 5, 6, 7, 8};
+        Camus::PromptLookupConfig config;
+        config.max_draft = 3;
+        Camus::PromptLookupDrafter drafter(prompt, config);
+
+        std::vector<int32_t> history = prompt;
+        history.push_back(42);
+        assert(drafter.propose(history, 10).empty() && "Unseen text has no draft");
+
+        history = prompt;
+        history.push_back(2);
+        history.push_back(3);
+        auto draft = drafter.propose(history, 10);
+        assert((draft == std::vector<int32_t>{4, 5, 6}) && "Capped at max_draft");
+        drafter.accept(3);
+
+        // The run continues after a fully accepted draft and one sampled token
+        history.insert(history.end(), {4, 5, 6, 7});
+        draft = drafter.propose(history, 1);
+        assert((draft == std::vector<int32_t>{8}) && "Capped by the caller's room");
+
+        config.enabled = false;
+        Camus::PromptLookupDrafter disabled(prompt, config);
+        assert(disabled.propose(history, 10).empty());
+        std::cout << "✓ Limits test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running prompt lookup unit tests..." << std::endl;
+
+        testVerbatimCopy();
+        testEditedCopy();
+        testNoMatchAndLimits();
+
+        std::cout << "All prompt lookup tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        PromptLookupDrafterTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All prompt lookup component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,195 @@
+// =================================================================
+// tests/RequestArenaTest.cpp
+// =================================================================
+// Unit tests and allocation benchmark for per-request arenas.
+
+#include "Camus/RequestArena.hpp"
+#include "Camus/ModelOrchestrator.hpp"
+#include "Camus/TaskClassifier.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <chrono>
+
+// Count every global allocation so the benchmark can compare strategies
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations++;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned overloads
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_allocations++;
+    size_t align = static_cast<size_t>(alignment);
+    size_t rounded = ((size ? size : 1) + align - 1) / align * align;
+    if (void* ptr = std::aligned_alloc(align, rounded)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+class RequestArenaTest {
+private:
+    // Roughly the state one orchestrated request accumulates
+    static void buildPipelineState(Camus::PipelineResponse& response) {
+        static const char* steps[] = {
+            "pipeline_start", "cache_check", "cache_miss", "task_classification",
+            "model_selection", "load_balancing", "request_execution",
+            "quality_validation", "pipeline_complete"
+        };
+        for (const char* step : steps) {
+            response.pipeline_steps.emplace_back(step);
+        }
+        response.debug_info.emplace("classification_confidence", "0.870000");
+        response.debug_info.emplace("selection_strategy", "score_based_selection");
+        response.debug_info.emplace("selected_instance", "deepseek-coder-6.7b-instruct_direct");
+
+        Camus::ClassificationResult classification(response.arena.resource());
+        classification.alternatives.push_back(Camus::TaskType::REFACTORING);
+        classification.alternatives.push_back(Camus::TaskType::CODE_ANALYSIS);
+        classification.keyword_scores.emplace("keyword_score", 0.6);
+        classification.keyword_scores.emplace("pattern_score", 0.4);
+        classification.keyword_scores.emplace("context_score", 0.1);
+        classification.keyword_scores.emplace("combined_score", 0.44);
+
+        Camus::SelectionResult selection(response.arena.resource());
+        selection.alternatives.emplace_back("codellama-13b-instruct-q4_k_m", 0.71);
+        selection.alternatives.emplace_back("mistral-7b-instruct-v0.2-q5", 0.65);
+    }
+
+public:
+    void testResponseOwnsArena() {
+        std::cout << "Testing arena lifetime across moves and copies..." << std::endl;
+
+        auto arena = std::make_shared<Camus::RequestArena>(1024);
+        Camus::PipelineResponse response(arena);
+        response.pipeline_steps.emplace_back("a step name longer than the small string buffer");
+        assert(response.pipeline_steps.get_allocator().resource() == arena->resource());
+
+        std::weak_ptr<Camus::RequestArena> weak = arena;
+        arena.reset();
+        assert(!weak.expired() && "The response keeps its arena alive");
+
+        Camus::PipelineResponse copy = response;
+        assert(copy.pipeline_steps.get_allocator().resource() == std::pmr::get_default_resource());
+        assert(!copy.arena.get() && "Copies do not hold the arena");
+
+        Camus::PipelineResponse assigned;
+        {
+            Camus::PipelineResponse moved = std::move(response);
+            assert(moved.arena.get() == weak.lock());
+
+            assigned = moved;
+            assert(assigned.pipeline_steps.get_allocator().resource() == std::pmr::get_default_resource());
+            assert(!assigned.arena.get());
+
+            // Assignment keeps the target's arena, which its containers still use
+            moved = Camus::PipelineResponse();
+            assert(!weak.expired());
+        }
+        assert(weak.expired() && "Arena is released with the last response using it");
+        assert(copy.pipeline_steps.front() == "a step name longer than the small string buffer");
+        assert(assigned.pipeline_steps.front() == copy.pipeline_steps.front());
+
+        std::cout << "✓ Arena lifetime test passed" << std::endl;
+    }
+
+    void testClassifierUsesResource() {
+        std::cout << "Testing classification results built in an arena..." << std::endl;
+
+        Camus::RequestArena arena;
+        Camus::TaskClassifier classifier;
+        auto result = classifier.classify("Refactor this function to improve readability", "", arena.resource());
+        assert(result.keyword_scores.get_allocator().resource() == arena.resource());
+        assert(result.alternatives.get_allocator().resource() == arena.resource());
+
+        auto heap_result = classifier.classify("Refactor this function to improve readability");
+        assert(heap_result.primary_type == result.primary_type);
+        assert(heap_result.keyword_scores.get_allocator().resource() == std::pmr::get_default_resource());
+
+        std::cout << "✓ Classifier resource test passed" << std::endl;
+    }
+
+    void benchmarkAllocations() {
+        std::cout << "Benchmarking allocations per request..." << std::endl;
+
+        const size_t iterations = 2000;
+
+        size_t before = g_allocations;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            Camus::PipelineResponse response;
+            buildPipelineState(response);
+        }
+        auto heap_time = std::chrono::steady_clock::now() - start;
+        size_t heap_allocations = g_allocations - before;
+
+        before = g_allocations;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            Camus::PipelineResponse response(std::make_shared<Camus::RequestArena>());
+            buildPipelineState(response);
+        }
+        auto arena_time = std::chrono::steady_clock::now() - start;
+        size_t arena_allocations = g_allocations - before;
+
+        double heap_per_request = static_cast<double>(heap_allocations) / iterations;
+        double arena_per_request = static_cast<double>(arena_allocations) / iterations;
+        std::cout << "  heap:  " << heap_per_request << " allocations/request, "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(heap_time).count() << "us" << std::endl;
+        std::cout << "  arena: " << arena_per_request << " allocations/request, "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(arena_time).count() << "us" << std::endl;
+
+        assert(arena_per_request <= 2.0 && "Arena state should need only the arena and its first block");
+        assert(arena_per_request * 5 < heap_per_request && "Arena should remove most allocations");
+
+        std::cout << "✓ Allocation benchmark passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running request arena unit tests..." << std::endl;
+
+        testResponseOwnsArena();
+        testClassifierUsesResource();
+        benchmarkAllocations();
+
+        std::cout << "All request arena tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        RequestArenaTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All request arena component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,305 @@
+// =================================================================
+// tests/RequestCoalescerTest.cpp
+// =================================================================
+// Unit tests for single-flight request coalescing.
+
+#include "Camus/RequestCoalescer.hpp"
+#include "Camus/AdaptiveConcurrencyLimiter.hpp"
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Backend that emits one piece, then blocks until released
+ */
+class GatedMockModel : public Camus::LlmInteraction {
+public:
+    std::string getCompletion(const std::string& prompt) override {
+        Camus::InferenceRequest request;
+        request.prompt = prompt;
+        return getCompletionWithMetadata(request).text;
+    }
+
+    Camus::InferenceResponse getCompletionWithMetadata(const Camus::InferenceRequest& request) override {
+        m_calls++;
+        if (request.on_token) {
+            request.on_token("first ");
+        }
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_started++;
+            m_cv.notify_all();
+            m_cv.wait(lock, [this]() { return m_open; });
+        }
+        if (m_fail) {
+            throw std::runtime_error("backend failure");
+        }
+        if (request.on_token) {
+            request.on_token("second");
+        }
+        Camus::InferenceResponse response;
+        response.text = "first second:" + request.prompt;
+        response.tokens_generated = 2;
+        return response;
+    }
+
+    Camus::ModelMetadata getModelMetadata() const override { return Camus::ModelMetadata(); }
+    bool isHealthy() const override { return true; }
+    bool performHealthCheck() override { return true; }
+    Camus::ModelPerformance getCurrentPerformance() const override { return Camus::ModelPerformance(); }
+    std::string getModelId() const override { return "gated"; }
+
+    void waitForStarted(int count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this, count]() { return m_started >= count; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = true;
+        m_cv.notify_all();
+    }
+
+    std::atomic<int> m_calls{0};
+    bool m_fail = false;
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    int m_started = 0;
+    bool m_open = false;
+};
+
+class RequestCoalescerTest {
+private:
+    static Camus::InferenceRequest greedy(const std::string& prompt) {
+        Camus::InferenceRequest request;
+        request.prompt = prompt;
+        request.temperature = 0.0;
+        return request;
+    }
+
+    // Wait until the coalescer has attached `count` followers
+    static void waitForFollowers(Camus::RequestCoalescer& coalescer, size_t count) {
+        auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (coalescer.getStats().coalesced < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(2ms);
+        }
+        assert(coalescer.getStats().coalesced == count);
+    }
+
+public:
+    void testKeying() {
+        std::cout << "Testing request keys..." << std::endl;
+
+        auto a = greedy("prompt");
+        auto b = greedy("prompt");
+        assert(Camus::RequestCoalescer::makeKey("m", a) == Camus::RequestCoalescer::makeKey("m", b));
+        assert(Camus::RequestCoalescer::makeKey("m", a) != Camus::RequestCoalescer::makeKey("other", b) &&
+               "Different models must not share a generation");
+        b.max_tokens = 16;
+        assert(Camus::RequestCoalescer::makeKey("m", a) != Camus::RequestCoalescer::makeKey("m", b) &&
+               "Sampling parameters are part of the key");
+        b = greedy("prompt");
+        b.constraint = Camus::ResponseConstraint::FILE_BLOCKS;
+        assert(Camus::RequestCoalescer::makeKey("m", a) != Camus::RequestCoalescer::makeKey("m", b) &&
+               "A constrained request must not receive unconstrained text");
+        b = greedy("prompt");
+        b.context_tokens = {1, 2, 3};
+        assert(Camus::RequestCoalescer::makeKey("m", a) != Camus::RequestCoalescer::makeKey("m", b) &&
+               "Requests continuing different conversations must not share a generation");
+        a.context_tokens = {1, 2, 4};
+        assert(Camus::RequestCoalescer::makeKey("m", a) != Camus::RequestCoalescer::makeKey("m", b));
+        a.context_tokens = {1, 2, 3};
+        assert(Camus::RequestCoalescer::makeKey("m", a) == Camus::RequestCoalescer::makeKey("m", b));
+
+        assert(Camus::RequestCoalescer::isDeterministic(a));
+        a.temperature = 0.7;
+        assert(!Camus::RequestCoalescer::isDeterministic(a));
+
+        std::cout << "✓ Keying test passed" << std::endl;
+    }
+
+    void testIdenticalRequestsShareGeneration() {
+        std::cout << "Testing coalescing of identical greedy requests..." << std::endl;
+
+        Camus::RequestCoalescer coalescer;
+        GatedMockModel model;
+
+        std::string leader_stream;
+        Camus::InferenceResponse leader_response;
+        std::thread leader([&]() {
+            auto request = greedy("same");
+            request.on_token = [&leader_stream](const std::string& piece) { leader_stream += piece; };
+            leader_response = coalescer.execute("gated", model, request);
+        });
+        model.waitForStarted(1);
+        assert(coalescer.getInFlightCount() == 1);
+
+        const int followers = 3;
+        std::vector<std::string> streams(followers);
+        std::vector<Camus::InferenceResponse> responses(followers);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < followers; ++i) {
+            threads.emplace_back([&, i]() {
+                auto request = greedy("same");
+                request.on_token = [&streams, i](const std::string& piece) { streams[i] += piece; };
+                responses[i] = coalescer.execute("gated", model, request);
+            });
+        }
+        waitForFollowers(coalescer, followers);
+
+        model.release();
+        leader.join();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        assert(model.m_calls == 1 && "Backend should run once for identical requests");
+        assert(leader_response.text == "first second:same");
+        assert(leader_stream == "first second");
+        for (int i = 0; i < followers; ++i) {
+            assert(responses[i].text == leader_response.text);
+            assert(responses[i].metadata["coalesced"] == "true");
+            assert(streams[i] == "first second" && "Followers should see earlier output replayed");
+        }
+        assert(coalescer.getInFlightCount() == 0);
+
+        // Once finished, an identical request runs again
+        coalescer.execute("gated", model, greedy("same"));
+        assert(model.m_calls == 2);
+
+        auto stats = coalescer.getStats();
+        assert(stats.executed == 2 && stats.coalesced == 3);
+
+        std::cout << "✓ Shared generation test passed" << std::endl;
+    }
+
+    void testSampledRequestsRunIndependently() {
+        std::cout << "Testing that sampled requests are not coalesced..." << std::endl;
+
+        Camus::RequestCoalescer coalescer;
+        GatedMockModel model;
+        model.release();
+
+        auto request = greedy("same");
+        request.temperature = 0.8;
+        std::thread first([&]() { coalescer.execute("gated", model, request); });
+        std::thread second([&]() { coalescer.execute("gated", model, request); });
+        first.join();
+        second.join();
+
+        assert(model.m_calls == 2 && "Each sampled request should generate");
+        assert(coalescer.getStats().bypassed == 2);
+
+        std::cout << "✓ Sampled request test passed" << std::endl;
+    }
+
+    void testFailureReachesAllCallers() {
+        std::cout << "Testing failure propagation to attached requests..." << std::endl;
+
+        Camus::RequestCoalescer coalescer;
+        GatedMockModel model;
+        model.m_fail = true;
+
+        std::atomic<int> failures{0};
+        auto run = [&]() {
+            try {
+                coalescer.execute("gated", model, greedy("boom"));
+            } catch (const std::runtime_error&) {
+                failures++;
+            }
+        };
+
+        std::thread leader(run);
+        model.waitForStarted(1);
+        std::thread follower(run);
+        waitForFollowers(coalescer, 1);
+        model.release();
+        leader.join();
+        follower.join();
+
+        assert(failures == 2 && "Both callers should see the backend error");
+        assert(model.m_calls == 1);
+        assert(coalescer.getInFlightCount() == 0);
+
+        std::cout << "✓ Failure propagation test passed" << std::endl;
+    }
+
+    void testLimitedBackendRunsOnce() {
+        std::cout << "Testing coalescing in front of a concurrency limit..." << std::endl;
+
+        Camus::RequestCoalescer coalescer;
+        GatedMockModel model;
+        Camus::AdaptiveLimiterConfig config;
+        config.initial_limit = 1.0;
+        config.max_limit = 1.0;
+        Camus::AdaptiveConcurrencyLimiter limiter(config);
+
+        // Only the generating request takes a permit
+        auto backend = [&](const Camus::InferenceRequest& call) {
+            return limiter.run([&]() { return model.getCompletionWithMetadata(call); }, 5000ms);
+        };
+
+        const int requests = 4;
+        std::vector<Camus::InferenceResponse> responses(requests);
+        std::vector<std::thread> threads;
+        threads.emplace_back([&]() { responses[0] = coalescer.execute("gated", greedy("same"), backend); });
+        model.waitForStarted(1);
+        for (int i = 1; i < requests; ++i) {
+            threads.emplace_back([&, i]() { responses[i] = coalescer.execute("gated", greedy("same"), backend); });
+        }
+        waitForFollowers(coalescer, requests - 1);
+
+        auto stats = limiter.getStats();
+        assert(stats.in_flight == 1 && stats.queued == 0 && "Attached requests must not hold or wait for permits");
+
+        model.release();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        assert(model.m_calls == 1 && "Backend should run once for identical requests");
+        for (const auto& response : responses) {
+            assert(response.text == "first second:same");
+        }
+        stats = limiter.getStats();
+        assert(stats.successes == 1 && stats.in_flight == 0 && "Only the leader's call is a latency sample");
+
+        std::cout << "✓ Limited backend test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running request coalescer unit tests..." << std::endl;
+
+        testKeying();
+        testIdenticalRequestsShareGeneration();
+        testSampledRequestsRunIndependently();
+        testFailureReachesAllCallers();
+        testLimitedBackendRunsOnce();
+
+        std::cout << "All request coalescer tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        RequestCoalescerTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All request coalescer component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
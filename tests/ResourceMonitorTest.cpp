@@ -0,0 +1,183 @@
+// =================================================================
+// tests/ResourceMonitorTest.cpp
+// =================================================================
+// Unit tests for the resource monitor against fake /proc and cgroup trees.
+
+#include "Camus/ResourceMonitor.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+class ResourceMonitorTest {
+private:
+    std::string test_dir = "test_resource_monitor";
+
+    void writeFile(const std::string& relative, const std::string& content) {
+        fs::path path = fs::path(test_dir) / relative;
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << content;
+    }
+
+    void setupHost() {
+        fs::remove_all(test_dir);
+        writeFile("proc/stat", "cpu  100 0 100 800 0 0 0 0 0 0\ncpu0 100 0 100 800 0 0 0 0 0 0\n");
+        writeFile("proc/meminfo", "MemTotal:       1000 kB\nMemFree:         100 kB\nMemAvailable:    250 kB\n");
+        writeFile("proc/pressure/cpu", "some avg10=1.50 avg60=1.00 avg300=0.50 total=100\n");
+        writeFile("proc/pressure/memory",
+                  "some avg10=12.25 avg60=5.00 avg300=1.00 total=200\n"
+                  "full avg10=3.75 avg60=1.00 avg300=0.10 total=50\n");
+        writeFile("proc/self/cgroup", "0::/\n");
+    }
+
+    Camus::ResourceMonitorConfig hostConfig() {
+        Camus::ResourceMonitorConfig config;
+        config.proc_root = test_dir + "/proc";
+        config.cgroup_root = test_dir + "/cgroup";
+        return config;
+    }
+
+public:
+    void testHostSampling() {
+        std::cout << "Testing /proc/stat, /proc/meminfo and PSI sampling..." << std::endl;
+
+        setupHost();
+        Camus::ResourceMonitor monitor(hostConfig());
+
+        auto first = monitor.sample();
+        assert(first.cpu_usage_percent == 0.0 && "No CPU rate without a previous sample");
+        assert(std::fabs(first.memory_usage_percent - 75.0) < 1e-9);
+        assert(first.memory_limit_bytes == 1000 * 1024);
+        assert(!first.cgroup_limited);
+        assert(first.pressure_available);
+        assert(std::fabs(first.memory_pressure.some_avg10 - 12.25) < 1e-9);
+        assert(std::fabs(first.memory_pressure.full_avg10 - 3.75) < 1e-9);
+        assert(std::fabs(first.cpu_pressure.some_avg10 - 1.5) < 1e-9);
+
+        // 300 busy jiffies out of 400 since the last sample
+        writeFile("proc/stat", "cpu  250 0 250 900 0 0 0 0 0 0\n");
+        auto second = monitor.sample();
+        assert(std::fabs(second.cpu_usage_percent - 75.0) < 1e-9);
+        assert(std::fabs(monitor.getSnapshot().cpu_usage_percent - 75.0) < 1e-9);
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Host sampling test passed" << std::endl;
+    }
+
+    void testCgroupLimits() {
+        std::cout << "Testing cgroup v2 limits..." << std::endl;
+
+        setupHost();
+        writeFile("proc/self/cgroup", "0::/camus.slice\n");
+        writeFile("cgroup/camus.slice/cpu.max", "50000 100000\n");
+        writeFile("cgroup/camus.slice/cpu.stat", "usage_usec 1000000\nuser_usec 800000\n");
+        writeFile("cgroup/camus.slice/memory.max", "1048576\n");
+        writeFile("cgroup/camus.slice/memory.current", "786432\n");
+        writeFile("cgroup/camus.slice/memory.stat", "anon 500000\ninactive_file 262144\n");
+
+        Camus::ResourceMonitor monitor(hostConfig());
+        auto snapshot = monitor.sample();
+
+        assert(snapshot.cgroup_limited);
+        assert(std::fabs(snapshot.cpu_limit_cores - 0.5) < 1e-9 && "Quota of half a CPU");
+        assert(snapshot.memory_limit_bytes == 1048576 && "memory.max wins over MemTotal");
+        assert(snapshot.memory_used_bytes == 524288 && "Inactive page cache is not counted");
+        assert(std::fabs(snapshot.memory_usage_percent - 50.0) < 1e-9);
+
+        writeFile("cgroup/camus.slice/memory.max", "max\n");
+        writeFile("cgroup/camus.slice/cpu.max", "max 100000\n");
+        snapshot = monitor.sample();
+        assert(snapshot.memory_limit_bytes == 1000 * 1024 && "Unlimited cgroup falls back to meminfo");
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Cgroup limits test passed" << std::endl;
+    }
+
+    void testAdmissionGate() {
+        std::cout << "Testing event-driven admission..." << std::endl;
+
+        setupHost();
+        Camus::ResourceMonitor monitor(hostConfig());
+        monitor.sample();
+
+        // Predicate already satisfied: no waiting
+        bool admitted = monitor.waitUntil([](const Camus::SystemResourceSnapshot& s) {
+            return s.memory_usage_percent < 80.0;
+        }, 0ms);
+        assert(admitted);
+
+        // Times out when nothing changes
+        admitted = monitor.waitUntil([](const Camus::SystemResourceSnapshot&) { return false; }, 20ms);
+        assert(!admitted);
+
+        // Woken by notifyWaiters() once capacity is released, well before the timeout
+        std::atomic<int> active{1};
+        std::thread releaser([&]() {
+            std::this_thread::sleep_for(20ms);
+            active = 0;
+            monitor.notifyWaiters();
+        });
+        auto start = std::chrono::steady_clock::now();
+        admitted = monitor.waitUntil([&](const Camus::SystemResourceSnapshot&) {
+            return active.load() == 0;
+        }, 10s);
+        auto waited = std::chrono::steady_clock::now() - start;
+        releaser.join();
+        assert(admitted);
+        assert(waited < 5s);
+
+        // Woken by a new sample once memory drops below the limit
+        writeFile("proc/meminfo", "MemTotal:       1000 kB\nMemAvailable:    900 kB\n");
+        Camus::ResourceMonitorConfig config = hostConfig();
+        config.sample_interval = 10ms;
+        Camus::ResourceMonitor sampled(config);
+        writeFile("proc/meminfo", "MemTotal:       1000 kB\nMemAvailable:    100 kB\n");
+        sampled.start();
+        assert(sampled.isRunning());
+        std::thread freer([&]() {
+            std::this_thread::sleep_for(30ms);
+            writeFile("proc/meminfo", "MemTotal:       1000 kB\nMemAvailable:    900 kB\n");
+        });
+        admitted = sampled.waitUntil([](const Camus::SystemResourceSnapshot& s) {
+            return s.memory_usage_percent < 50.0;
+        }, 10s);
+        freer.join();
+        assert(admitted);
+        sampled.stop();
+        assert(!sampled.isRunning());
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Admission gate test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running resource monitor unit tests..." << std::endl;
+
+        testHostSampling();
+        testCgroupLimits();
+        testAdmissionGate();
+
+        std::cout << "All resource monitor tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        ResourceMonitorTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All resource monitor component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
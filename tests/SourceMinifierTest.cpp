@@ -0,0 +1,264 @@
+// =================================================================
+// tests/SourceMinifierTest.cpp
+// =================================================================
+// Unit tests for prompt minification and mapping edits back.
+
+#include "Camus/SourceMinifier.hpp"
+#include "Camus/ContextBuilder.hpp"
+#include "Camus/ResponseParser.hpp"
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cassert>
+
+namespace fs = std::filesystem;
+
+static const char* kSource =
+    "/*\n"
+    " * Copyright (c) 2024 Example Corp.\n"
+    " * Licensed under the MIT License.\n"
+    " */\n"
+    "\n"
+    "// =================================================================\n"
+    "// src/widget.cpp\n"
+    "// =================================================================\n"
+    "// Widget implementation.\n"
+    "\n"
+    "#include \"widget.hpp\"   \n"
+    "\n"
+    "\n"
+    "\n"
+    "namespace demo {\n"
+    "\n"
+    "int Widget::size() const {\n"
+    "    // Cached on first use\n"
+    "    if (m_size == 0) {\n"
+    "        m_size = compute();\n"
+    "    }\n"
+    "    return m_size;\n"
+    "}\n"
+    "\n"
+    "} // namespace demo\n";
+
+class SourceMinifierTest {
+private:
+    std::string test_dir = "test_source_minifier";
+
+public:
+    void testMinify() {
+        std::cout << "Testing minification of a C++ file..." << std::endl;
+
+        auto minified = Camus::SourceMinifier::minify("src/widget.cpp", kSource);
+        const std::string& text = minified.content;
+
+        assert(text.find("Copyright") == std::string::npos && "License header is dropped");
+        assert(text.find("=====") == std::string::npos && "Banner rules are dropped");
+        assert(text.find("src/widget.cpp") == std::string::npos && "Banner path line is dropped");
+        assert(text.find("// Widget implementation.") != std::string::npos && "Descriptive comments stay");
+        assert(text.find("// Cached on first use") != std::string::npos);
+        assert(text.find("\n\n\n") == std::string::npos && "Blank line runs collapse");
+        assert(text.find("#include \"widget.hpp\"\n") != std::string::npos && "Trailing whitespace is removed");
+        assert(minified.indent_unit == "    ");
+        assert(text.find("\n  m_size = compute();\n") != std::string::npos && "Each level becomes one space");
+        assert(text.compare(0, 9, "// Widget") == 0 && "No leading blank lines");
+
+        // Every minified line points at the original line it came from
+        std::vector<std::string> original_lines;
+        std::istringstream original_stream(kSource);
+        for (std::string line; std::getline(original_stream, line);) {
+            original_lines.push_back(line);
+        }
+        std::istringstream minified_stream(text);
+        size_t index = 0;
+        for (std::string line; std::getline(minified_stream, line); ++index) {
+            size_t source = minified.line_map.at(index);
+            std::string expected = original_lines.at(source - 1);
+            expected.erase(expected.find_last_not_of(" \t") + 1);
+            expected.erase(0, expected.find_first_not_of(' '));
+            line.erase(0, line.find_first_not_of(' '));
+            assert(line == expected && "Line map must point at the source line");
+        }
+        assert(index == minified.line_map.size());
+
+        // Indentation-sensitive languages keep their indentation
+        auto python = Camus::SourceMinifier::minify(
+            "tool.py", "# SPDX-License-Identifier: MIT\n\ndef run():\n    if ready:   \n        go()\n");
+        assert(python.content == "def run():\n    if ready:\n        go()\n");
+        assert(python.indent_unit.empty());
+
+        std::cout << "✓ Minification test passed" << std::endl;
+    }
+
+    void testRestore() {
+        std::cout << "Testing restoring edits to the original file..." << std::endl;
+
+        auto minified = Camus::SourceMinifier::minify("src/widget.cpp", kSource);
+        assert(Camus::SourceMinifier::restore(kSource, minified, minified.content) == kSource &&
+               "An unchanged file restores to itself");
+
+        // Change one line and add a nested one, written as the model saw the file
+        std::string edited = minified.content;
+        edited.replace(edited.find("  m_size = compute();\n"), 22,
+                       "  m_size = compute();\n  log(m_size);\n");
+        edited.replace(edited.find(" return m_size;"), 15, " return m_size + 1;");
+        std::string restored = Camus::SourceMinifier::restore(kSource, minified, edited);
+
+        std::string expected = kSource;
+        expected.replace(expected.find("        m_size = compute();\n"), 28,
+                         "        m_size = compute();\n        log(m_size);\n");
+        expected.replace(expected.find("    return m_size;"), 18, "    return m_size + 1;");
+        assert(restored == expected && "Header, banner and formatting survive; new lines are re-indented");
+
+        // A model that wrote the original indentation is not indented twice
+        std::string verbatim = minified.content;
+        verbatim.replace(verbatim.find("  m_size = compute();\n"), 22,
+                         "  m_size = compute();\n        log(m_size);\n");
+        verbatim.replace(verbatim.find(" return m_size;"), 15, "    return m_size + 1;");
+        assert(Camus::SourceMinifier::restore(kSource, minified, verbatim) == expected);
+
+        // Lines after a long inserted block still come from the original
+        std::string inserted = minified.content;
+        inserted.insert(inserted.find("// Widget implementation.\n") + 26,
+                        "// Sizes are cached:\n// - on first use\n// - until reset()\n// - per widget\n");
+        expected = kSource;
+        expected.insert(expected.find("// Widget implementation.\n") + 26,
+                        "// Sizes are cached:\n// - on first use\n// - until reset()\n// - per widget\n");
+        assert(Camus::SourceMinifier::restore(kSource, minified, inserted) == expected);
+
+        std::cout << "✓ Restore test passed" << std::endl;
+    }
+
+    void testRoundTrip() {
+        std::cout << "Testing the context builder and response parser round trip..." << std::endl;
+
+        fs::remove_all(test_dir);
+        fs::create_directories(test_dir + "/src");
+        std::ofstream(test_dir + "/src/widget.cpp") << kSource;
+        std::ofstream(test_dir + "/src/other.cpp") << kSource;
+
+        Camus::ContextBuilder builder(100000);
+        builder.setMinification(true);
+        builder.setDeduplication(false);
+        std::string context = builder.buildContext({"src/widget.cpp", "src/other.cpp"}, "Log the size", test_dir);
+        auto stats = builder.getLastBuildStats();
+        const auto& minified = builder.getMinifiedFiles();
+        assert(minified.size() == 2 && stats["files_minified"] == 2);
+        const auto& widget = minified.at("src/widget.cpp");
+        assert(widget.minified_tokens < widget.original_tokens);
+        const auto& other = minified.at("src/other.cpp");
+        assert(other.content.find("// src/widget.cpp") != std::string::npos && "Only a file's own path is boilerplate");
+        assert(stats["minify_tokens_saved"] == widget.original_tokens - widget.minified_tokens +
+                                               other.original_tokens - other.minified_tokens);
+        assert(context.find("Copyright") == std::string::npos && context.find(widget.content) != std::string::npos);
+
+        // A whole-file answer and an edit answer, both against the minified text
+        std::string file_answer = widget.content;
+        file_answer.replace(file_answer.find(" return m_size;"), 15, " return m_size * 2;");
+        std::string response = "--- FILE: src/widget.cpp ---\n" + file_answer +
+                               "--- EDIT: src/other.cpp ---\n"
+                               "<<<<<<< SEARCH\n"
+                               "  m_size = compute();\n"
+                               "=======\n"
+                               "  m_size = compute();\n"
+                               "  log(m_size);\n"
+                               ">>>>>>> REPLACE\n";
+
+        Camus::ResponseParser parser(test_dir);
+        parser.setMinifiedSources(minified);
+        auto modifications = parser.parseResponse(response);
+        assert(modifications.size() == 2 && parser.getLastParseStats().minified_restored == 2);
+        for (const auto& modification : modifications) {
+            assert(modification.new_content.find("Copyright (c) 2024") != std::string::npos &&
+                   "Dropped header is still in the file");
+            if (modification.file_path == "src/widget.cpp") {
+                assert(modification.new_content.find("\n    return m_size * 2;\n") != std::string::npos);
+            } else {
+                assert(modification.new_content.find("\n        log(m_size);\n") != std::string::npos);
+            }
+        }
+
+        // A file edited on disk since the prompt was built is not guessed at
+        std::ofstream(test_dir + "/src/widget.cpp") << "int changed();\n";
+        Camus::ResponseParser stale(test_dir);
+        stale.setMinifiedSources(minified);
+        auto rejected = stale.parseResponse("--- FILE: src/widget.cpp ---\n" + file_answer);
+        assert(rejected.empty() && stale.getLastParseStats().minified_restored == 0);
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Round trip test passed" << std::endl;
+    }
+
+    void testBatchChangedFile() {
+        std::cout << "Testing minified batch edits to a file an earlier request changed..." << std::endl;
+
+        fs::remove_all(test_dir);
+        fs::create_directories(test_dir + "/src");
+        std::ofstream(test_dir + "/src/widget.cpp") << kSource;
+        std::ofstream(test_dir + "/src/other.cpp") << kSource;
+
+        Camus::ContextBuilder builder(100000);
+        builder.setMinification(true);
+        builder.setDeduplication(false);
+        builder.buildBatchContext({"src/widget.cpp", "src/other.cpp"},
+                                  {"Cache the widget size", "Log the size"}, test_dir);
+        const auto minified = builder.getMinifiedFiles();
+        assert(minified.size() == 2);
+
+        // The first request of the batch rewrote widget.cpp
+        std::string first_edit = kSource;
+        first_edit.replace(first_edit.find("return m_size;"), 14, "return cached();");
+        std::ofstream(test_dir + "/src/widget.cpp") << first_edit;
+
+        // The second request still answers against the shared snapshot
+        std::string response = "--- EDIT: src/widget.cpp ---\n"
+                               "<<<<<<< SEARCH\n"
+                               "  m_size = compute();\n"
+                               "=======\n"
+                               "  m_size = compute();\n"
+                               "  log(m_size);\n"
+                               ">>>>>>> REPLACE\n"
+                               "--- FILE: src/other.cpp ---\n" + minified.at("src/other.cpp").content;
+
+        Camus::ResponseParser parser(test_dir);
+        parser.setMinifiedSources(minified);
+        auto modifications = parser.parseResponse(response);
+        const auto& stats = parser.getLastParseStats();
+        assert(modifications.size() == 1 && modifications[0].file_path == "src/other.cpp");
+        assert(stats.changed_since_sent.size() == 1 && stats.changed_since_sent[0] == "src/widget.cpp" &&
+               "The rejected file is reported so the batch can re-run the request");
+
+        fs::remove_all(test_dir);
+        std::cout << "✓ Batch changed file test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running SourceMinifier tests..." << std::endl;
+        std::cout << "===============================================" << std::endl << std::endl;
+
+        testMinify();
+        std::cout << std::endl;
+
+        testRestore();
+        std::cout << std::endl;
+
+        testRoundTrip();
+        std::cout << std::endl;
+
+        testBatchChangedFile();
+        std::cout << std::endl;
+    }
+};
+
+int main() {
+    try {
+        SourceMinifierTest tests;
+        tests.runAllTests();
+
+        std::cout << "🎉 All SourceMinifier tests passed!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
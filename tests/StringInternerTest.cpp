@@ -0,0 +1,128 @@
+// =================================================================
+// tests/StringInternerTest.cpp
+// =================================================================
+// Unit tests for interned model/instance ids and id-indexed statistics.
+
+#include "Camus/StringInterner.hpp"
+#include "Camus/ModelSelector.hpp"
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <vector>
+#include <string>
+
+class StringInternerTest {
+public:
+    void testDenseIds() {
+        std::cout << "Testing dense id assignment..." << std::endl;
+
+        Camus::StringInterner interner;
+        Camus::InternedId a = interner.intern("model_a");
+        Camus::InternedId b = interner.intern("model_b");
+        Camus::InternedId a_again = interner.intern("model_a");
+
+        assert(a == 0 && b == 1 && "Ids should be dense in first-seen order");
+        assert(a_again == a);
+        assert(interner.size() == 2);
+        assert(interner.name(b) == "model_b");
+        assert(interner.find("model_b") == b);
+        assert(interner.find("unknown") == Camus::INVALID_INTERNED_ID);
+        assert(interner.name(Camus::INVALID_INTERNED_ID).empty());
+
+        std::cout << "✓ Dense id test passed" << std::endl;
+    }
+
+    void testStableNames() {
+        std::cout << "Testing that names stay valid as the interner grows..." << std::endl;
+
+        Camus::StringInterner interner;
+        const std::string& first = interner.name(interner.intern("first_model_with_a_long_name"));
+        for (int i = 0; i < 1000; ++i) {
+            interner.intern("model_" + std::to_string(i));
+        }
+        assert(first == "first_model_with_a_long_name");
+
+        std::cout << "✓ Stable name test passed" << std::endl;
+    }
+
+    void testConcurrentInterning() {
+        std::cout << "Testing concurrent interning..." << std::endl;
+
+        Camus::StringInterner interner;
+        const int threads = 8;
+        const int names = 200;
+        std::vector<std::vector<Camus::InternedId>> seen(threads);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&interner, &seen, t]() {
+                for (int i = 0; i < names; ++i) {
+                    seen[t].push_back(interner.intern("instance_" + std::to_string(i)));
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        assert(interner.size() == static_cast<size_t>(names));
+        for (int t = 1; t < threads; ++t) {
+            assert(seen[t] == seen[0] && "Every thread should see the same id per name");
+        }
+
+        std::cout << "✓ Concurrent interning test passed" << std::endl;
+    }
+
+    void testStatisticsTable() {
+        std::cout << "Testing id-indexed model statistics..." << std::endl;
+
+        Camus::ModelStatisticsTable table;
+        Camus::InternedId id = Camus::StringInterner::models().intern("interner_test_model");
+        assert(table.find(id) == nullptr);
+
+        table.get(id).total_requests = 3;
+        assert(table.size() == 1);
+        assert(table.find(id) && table.find(id)->total_requests == 3);
+
+        // Configs built outside the registry have no id and are found by name
+        Camus::ModelConfig config;
+        config.name = "interner_test_model";
+        assert(table.find(config) == table.find(id));
+
+        size_t visited = 0;
+        table.forEach([&visited](const std::string& name, const Camus::ModelStatistics& stats) {
+            assert(name == "interner_test_model" && stats.total_requests == 3);
+            visited++;
+        });
+        assert(visited == 1);
+
+        table.erase(id);
+        assert(table.find(id) == nullptr && table.size() == 0);
+
+        std::cout << "✓ Statistics table test passed" << std::endl;
+    }
+
+    void runAllTests() {
+        std::cout << "Running string interner unit tests..." << std::endl;
+
+        testDenseIds();
+        testStableNames();
+        testConcurrentInterning();
+        testStatisticsTable();
+
+        std::cout << "All string interner tests passed!" << std::endl;
+    }
+};
+
+int main() {
+    try {
+        StringInternerTest tests;
+        tests.runAllTests();
+
+        std::cout << "\n🎉 All string interner component tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}